@@ -22,6 +22,7 @@
 #include "ace/OS_NS_ctype.h"
 #include "ace/OS_NS_fcntl.h"
 #include "ace/OS_TLI.h"
+#include "ace/OS_NS_sys_mman.h"
 #include "ace/Truncate.h"
 
 #if !defined (__ACE_INLINE__)
@@ -32,6 +33,10 @@
 #  include "ace/OS_NS_poll.h"
 #endif /* ACE_HAS_POLL */
 
+#if defined (ACE_HAS_MBIND)
+#  include /**/ <linux/mempolicy.h>
+#endif /* ACE_HAS_MBIND */
+
 // Open versioned namespace, if enabled by the user.
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -2478,6 +2483,39 @@ ACE::round_to_allocation_granularity (size_t len)
   return (len + (ACE::allocation_granularity_ - 1)) & ~(ACE::allocation_granularity_ - 1);
 }
 
+int
+ACE::bind_to_numa_node (void *addr, size_t len, int node)
+{
+  ACE_TRACE ("ACE::bind_to_numa_node");
+
+#if defined (ACE_HAS_MBIND)
+  unsigned long const bits = 8 * sizeof (unsigned long);
+  unsigned long nodemask[1024 / (8 * sizeof (unsigned long))];
+
+  if (node < 0 || static_cast<size_t> (node) >= sizeof nodemask * 8)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ACE_OS::memset (nodemask, 0, sizeof nodemask);
+  nodemask[node / bits] = 1UL << (node % bits);
+
+  // The kernel reads one bit less than maxnode.
+  return ACE_OS::mbind (addr,
+                        len,
+                        MPOL_BIND,
+                        nodemask,
+                        sizeof nodemask * 8 + 1,
+                        MPOL_MF_MOVE);
+#else
+  ACE_UNUSED_ARG (addr);
+  ACE_UNUSED_ARG (len);
+  ACE_UNUSED_ARG (node);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_MBIND */
+}
+
 ACE_HANDLE
 ACE::handle_timed_complete (ACE_HANDLE h,
                             const ACE_Time_Value *timeout,
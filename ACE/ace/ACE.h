@@ -550,6 +550,13 @@ namespace ACE
   /// Rounds the request to a multiple of the allocation granularity.
   extern ACE_Export size_t round_to_allocation_granularity (size_t len);
 
+  /**
+   * Bind the pages of the @a len bytes at @a addr to NUMA node
+   * @a node, moving those already in memory.  Returns -1 with @c errno
+   * set to @c ENOTSUP on platforms without mbind().
+   */
+  extern ACE_Export int bind_to_numa_node (void *addr, size_t len, int node);
+
   // @@ UNICODE what about buffer?
   /// Format buffer into printable format.  This is useful for
   /// debugging.
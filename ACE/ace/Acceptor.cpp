@@ -383,6 +383,11 @@ ACE_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::handle_input (ACE_HANDLE listener)
   // ignore any errors from this loop, hence the return 0 following it.
   ACE_Errno_Guard error (errno);
 
+  // A connection storm must not keep this thread from the other
+  // handlers of the reactor, so stop after a bounded number of
+  // connections; the reactor calls back again for the rest.
+  int accepted = 0;
+
   // @@ What should we do if any of the substrategies fail?  Right
   // now, we just print out a diagnostic message if <ACE::debug>
   // returns > 0 and return 0 (which means that the Acceptor remains
@@ -443,6 +448,7 @@ ACE_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::handle_input (ACE_HANDLE listener)
       // Now, check to see if there is another connection pending and
       // break out of the loop if there is none.
     } while (this->use_select_ &&
+             ++accepted < ACE_DEFAULT_ACCEPTOR_MAX_ACCEPTS &&
              ACE::handle_read_ready (listener, &timeout) == 1);
   return 0;
 }
@@ -82,6 +82,11 @@ public:
    * interval, the client can shutdown the connection, in which case,
    * the @c accept() call can hang.
    *
+   * Several acceptors, each registered with the reactor of its own
+   * thread, can share one endpoint when SO_REUSEPORT is requested
+   * through @c acceptor().reuse_port() before @c open() is called;
+   * the kernel then spreads the incoming connections over them.
+   *
    * @param local_addr The address to listen at.
    * @param reactor    Pointer to the ACE_Reactor instance to register
    *                   this object with. The default is the singleton.
@@ -96,7 +101,8 @@ public:
    *                   this object will accept all pending connections,
    *                   instead of just the one that triggered the reactor
    *                   callback.  Uses ACE_OS::select() internally to
-   *                   detect any remaining acceptable connections.
+   *                   detect any remaining acceptable connections, up to
+   *                   ACE_DEFAULT_ACCEPTOR_MAX_ACCEPTS per callback.
    *                   The default is 1.
    * @param reuse_addr Passed to the @c PEER_ACCEPTOR::open() method with
    *                   @p local_addr.  Generally used to request that the
@@ -135,7 +141,8 @@ public:
    *                   this object will accept all pending connections,
    *                   instead of just the one that triggered the reactor
    *                   callback.  Uses ACE_OS::select() internally to
-   *                   detect any remaining acceptable connections.
+   *                   detect any remaining acceptable connections, up to
+   *                   ACE_DEFAULT_ACCEPTOR_MAX_ACCEPTS per callback.
    *                   The default is 1.
    * @param reuse_addr Passed to the @c PEER_ACCEPTOR::open() method with
    *                   @p local_addr.  Generally used to request that the
@@ -345,7 +352,8 @@ public:
    *                     this object will accept all pending connections,
    *                     instead of just the one that triggered the reactor
    *                     callback.  Uses ACE_OS::select() internally to
-   *                     detect any remaining acceptable connections.
+   *                     detect any remaining acceptable connections, up to
+   *                     ACE_DEFAULT_ACCEPTOR_MAX_ACCEPTS per callback.
    *                     The default is 1.
    * @param reuse_addr   Passed to the @c PEER_ACCEPTOR::open() method with
    *                     @p local_addr.  Generally used to request that the
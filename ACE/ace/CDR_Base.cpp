@@ -19,6 +19,13 @@
 #include <limits>
 #include <algorithm>
 
+#if defined (ACE_HAS_SSE2)
+# include <emmintrin.h>
+# if defined (ACE_HAS_SIMD_DISPATCH)
+#  include <immintrin.h>
+# endif /* ACE_HAS_SIMD_DISPATCH */
+#endif /* ACE_HAS_SSE2 */
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 #if defined (NONNATIVE_LONGDOUBLE)
@@ -26,6 +33,157 @@ static const ACE_INT16 max_eleven_bit = 0x3ff;
 static const ACE_INT16 max_fifteen_bit = 0x3fff;
 #endif /* NONNATIVE_LONGDOUBLE */
 
+#if defined (ACE_HAS_SSE2)
+
+//
+// The vector kernels swap the elements of an array 16 or 32 bytes at
+// a time, with unaligned loads and stores.  They return the number of
+// bytes they swapped, always a multiple of 16, and leave the rest of
+// the array to the scalar code of the swap_XX_array functions.
+//
+
+// Swap the bytes of each 16 bit lane of <v>.
+static inline __m128i
+ace_cdr_swap_lanes (__m128i v)
+{
+  return _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+}
+
+static size_t
+ace_cdr_swap_sse2 (char const *orig, char *target, size_t bytes, size_t size)
+{
+  size_t const end = bytes & ~static_cast<size_t> (15);
+  for (size_t i = 0; i < end; i += 16)
+    {
+      __m128i v =
+        ace_cdr_swap_lanes (_mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig + i)));
+
+      // Then reverse the order of the 16 bit lanes in each element.
+      switch (size)
+        {
+        case 4:
+          v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+          v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+          break;
+        case 8:
+          v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+          v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+          break;
+        case 16:
+          v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+          v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+          v = _mm_shuffle_epi32 (v, _MM_SHUFFLE (1, 0, 3, 2));
+          break;
+        }
+
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (target + i), v);
+    }
+  return end;
+}
+
+# if defined (ACE_HAS_SIMD_DISPATCH)
+
+// Byte shuffles that reverse each 2, 4, 8 and 16 byte element.
+static char const ace_cdr_swap_masks[4][16] =
+{
+  { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+  { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+  { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 },
+  { 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 }
+};
+
+static __attribute__ ((target ("ssse3"))) size_t
+ace_cdr_swap_ssse3 (char const *orig, char *target, size_t bytes,
+                    char const *mask)
+{
+  __m128i const m = _mm_loadu_si128 (reinterpret_cast<__m128i const *> (mask));
+  size_t const end = bytes & ~static_cast<size_t> (15);
+  for (size_t i = 0; i < end; i += 16)
+    {
+      __m128i const v =
+        _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig + i));
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (target + i),
+                        _mm_shuffle_epi8 (v, m));
+    }
+  return end;
+}
+
+static __attribute__ ((target ("avx2"))) size_t
+ace_cdr_swap_avx2 (char const *orig, char *target, size_t bytes,
+                   char const *mask)
+{
+  // The AVX2 shuffle works on each 16 byte half on its own, which is
+  // all the elements need.
+  __m128i const m = _mm_loadu_si128 (reinterpret_cast<__m128i const *> (mask));
+  __m256i const m2 = _mm256_inserti128_si256 (_mm256_castsi128_si256 (m), m, 1);
+  size_t const end = bytes & ~static_cast<size_t> (31);
+  size_t i = 0;
+  for (; i < end; i += 32)
+    {
+      __m256i const v =
+        _mm256_loadu_si256 (reinterpret_cast<__m256i const *> (orig + i));
+      _mm256_storeu_si256 (reinterpret_cast<__m256i *> (target + i),
+                           _mm256_shuffle_epi8 (v, m2));
+    }
+  if (bytes - i >= 16)
+    {
+      __m128i const v =
+        _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig + i));
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (target + i),
+                        _mm_shuffle_epi8 (v, m));
+      i += 16;
+    }
+  return i;
+}
+
+enum
+{
+  ACE_CDR_SWAP_SSE2,
+  ACE_CDR_SWAP_SSSE3,
+  ACE_CDR_SWAP_AVX2
+};
+
+static int
+ace_cdr_swap_kernel (void)
+{
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx2"))
+    return ACE_CDR_SWAP_AVX2;
+  if (__builtin_cpu_supports ("ssse3"))
+    return ACE_CDR_SWAP_SSSE3;
+  return ACE_CDR_SWAP_SSE2;
+}
+
+# endif /* ACE_HAS_SIMD_DISPATCH */
+
+// Swap the bulk of an array of <bytes> made of <size> byte elements
+// with the widest kernel the processor runs.  Returns the number of
+// bytes swapped.
+static size_t
+ace_cdr_swap_vector (char const *orig, char *target, size_t bytes, size_t size)
+{
+  if (bytes < 16)
+    return 0;
+
+# if defined (ACE_HAS_SIMD_DISPATCH)
+  static int const kernel = ace_cdr_swap_kernel ();
+
+  char const *const mask =
+    ace_cdr_swap_masks[size == 2 ? 0 : size == 4 ? 1 : size == 8 ? 2 : 3];
+  switch (kernel)
+    {
+    case ACE_CDR_SWAP_AVX2:
+      return ace_cdr_swap_avx2 (orig, target, bytes, mask);
+    case ACE_CDR_SWAP_SSSE3:
+      return ace_cdr_swap_ssse3 (orig, target, bytes, mask);
+    }
+# endif /* ACE_HAS_SIMD_DISPATCH */
+
+  return ace_cdr_swap_sse2 (orig, target, bytes, size);
+}
+
+#endif /* ACE_HAS_SSE2 */
+
 //
 // See comments in CDR_Base.inl about optimization cases for swap_XX_array.
 //
@@ -35,6 +193,15 @@ ACE_CDR::swap_2_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_HAS_SSE2)
+  size_t const done = ace_cdr_swap_vector (orig, target, 2 * n, 2);
+  orig += done;
+  target += done;
+  n -= done / 2;
+  if (n == 0)
+    return;
+#endif /* ACE_HAS_SSE2 */
+
   // We pretend that AMD64/GNU G++ systems have a Pentium CPU to
   // take advantage of the inline assembly implementation.
 
@@ -258,6 +425,15 @@ ACE_CDR::swap_4_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT (n > 0); The caller checks that n > 0
 
+#if defined (ACE_HAS_SSE2)
+  size_t const done = ace_cdr_swap_vector (orig, target, 4 * n, 4);
+  orig += done;
+  target += done;
+  n -= done / 4;
+  if (n == 0)
+    return;
+#endif /* ACE_HAS_SSE2 */
+
 #if ACE_SIZEOF_LONG == 8
   // Later, we read from *orig in 64 bit chunks,
   // so make sure we don't generate unaligned readings.
@@ -456,6 +632,15 @@ ACE_CDR::swap_8_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_HAS_SSE2)
+  size_t const done = ace_cdr_swap_vector (orig, target, 8 * n, 8);
+  orig += done;
+  target += done;
+  n -= done / 8;
+  if (n == 0)
+    return;
+#endif /* ACE_HAS_SSE2 */
+
   char const * const end = orig + 8*n;
   while (orig < end)
     {
@@ -470,6 +655,15 @@ ACE_CDR::swap_16_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_HAS_SSE2)
+  size_t const done = ace_cdr_swap_vector (orig, target, 16 * n, 16);
+  orig += done;
+  target += done;
+  n -= done / 16;
+  if (n == 0)
+    return;
+#endif /* ACE_HAS_SSE2 */
+
   char const * const end = orig + 16*n;
   while (orig < end)
     {
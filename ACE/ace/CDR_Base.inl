@@ -37,6 +37,11 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 //   (none of the above)
 //   => shift/masks using 32bit words.
 //
+// Where ACE_HAS_SSE2 is defined the swap_X_array routines first run
+// a vector kernel over the bulk of the array, and the cases above
+// only handle what is left.  With ACE_HAS_SIMD_DISPATCH the kernel
+// uses the SSSE3 or AVX2 byte shuffles when the processor has them.
+//
 // Some things you could find useful to know if you intend to mess
 // with this optimizations for swaps:
 //
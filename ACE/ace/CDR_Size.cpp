@@ -231,6 +231,17 @@ ACE_SizeCDR::write_boolean_array (const ACE_CDR::Boolean*,
   return true;
 }
 
+ACE_CDR::Boolean
+ACE_SizeCDR::write_octet_array_mb (const ACE_Message_Block* mb)
+{
+  for (const ACE_Message_Block* i = mb;
+       i != 0;
+       i = i->cont ())
+    this->adjust (i->length (), ACE_CDR::OCTET_ALIGN);
+
+  return true;
+}
+
 void
 ACE_SizeCDR::adjust (size_t size)
 {
@@ -115,6 +115,11 @@ public:
   ACE_CDR::Boolean write_longdouble_array (const ACE_CDR::LongDouble* x,
                                            ACE_CDR::ULong length);
 
+  /// Count the octets of the message block chain @a mb, see
+  /// ACE_OutputCDR::write_octet_array_mb().
+  ACE_CDR::Boolean write_octet_array_mb (const ACE_Message_Block* mb);
+  //@}
+
   ///
   /// Adjust to @a size and count @a size octets.
   void adjust (size_t size);
@@ -175,28 +175,59 @@ int
 ACE_OutputCDR::grow_and_adjust (size_t size,
                                 size_t align,
                                 char*& buf)
+{
+  if (this->grow_chain (size, false) != 0)
+    return -1;
+
+  return this->adjust (size, align, buf);
+}
+
+int
+ACE_OutputCDR::reserve (size_t size)
+{
+  size_t room = size;
+
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  room += ACE_CDR::MAX_ALIGNMENT;
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+  if (size == 0
+      || (this->current_is_writable_ && this->current_->space () >= room))
+    return 0;
+
+  return this->grow_chain (size, true);
+}
+
+int
+ACE_OutputCDR::grow_chain (size_t size, bool exact)
 {
   if (!this->current_is_writable_
       || this->current_->cont () == 0
       || this->current_->cont ()->size () < size + ACE_CDR::MAX_ALIGNMENT)
     {
-      // Calculate the new buffer's length; if growing for encode, we
-      // don't grow in "small" chunks because of the cost.
-      size_t cursize = this->current_->size ();
-      if (this->current_->cont () != 0)
-        cursize = this->current_->cont ()->size ();
       size_t minsize = size;
 
 #if !defined (ACE_LACKS_CDR_ALIGNMENT)
       minsize += ACE_CDR::MAX_ALIGNMENT;
 #endif /* ACE_LACKS_CDR_ALIGNMENT */
 
-      // Make sure that there is enough room for <minsize> bytes, but
-      // also make it bigger than whatever our current size is.
-      if (minsize < cursize)
-        minsize = cursize;
+      size_t newsize = minsize;
 
-      size_t const newsize = ACE_CDR::next_size (minsize);
+      if (!exact)
+        {
+          // Calculate the new buffer's length; if growing for encode,
+          // we don't grow in "small" chunks because of the cost.
+          size_t cursize = this->current_->size ();
+          if (this->current_->cont () != 0)
+            cursize = this->current_->cont ()->size ();
+
+          // Make sure that there is enough room for <minsize> bytes,
+          // but also make it bigger than whatever our current size is.
+          if (minsize < cursize)
+            minsize = cursize;
+
+          newsize = ACE_CDR::next_size (minsize);
+        }
 
       this->good_bit_ = false;
       ACE_Message_Block* tmp = 0;
@@ -246,7 +277,7 @@ ACE_OutputCDR::grow_and_adjust (size_t size,
   this->current_ = this->current_->cont ();
   this->current_is_writable_ = true;
 
-  return this->adjust (size, align, buf);
+  return 0;
 }
 
 ACE_CDR::Boolean
@@ -1068,6 +1099,8 @@ ACE_InputCDR::ACE_InputCDR (const char *buf,
                             ACE_CDR::Octet major_version,
                             ACE_CDR::Octet minor_version)
   : start_ (buf, bufsiz),
+    cont_length_ (0),
+    gather_ (0),
     do_byte_swap_ (byte_order != ACE_CDR_BYTE_ORDER),
     good_bit_ (true),
     major_version_ (major_version),
@@ -1089,6 +1122,8 @@ ACE_InputCDR::ACE_InputCDR (size_t bufsiz,
                             ACE_CDR::Octet major_version,
                             ACE_CDR::Octet minor_version)
   : start_ (bufsiz),
+    cont_length_ (0),
+    gather_ (0),
     do_byte_swap_ (byte_order != ACE_CDR_BYTE_ORDER),
     good_bit_ (true),
     major_version_ (major_version),
@@ -1109,6 +1144,8 @@ ACE_InputCDR::ACE_InputCDR (const ACE_Message_Block *data,
                             ACE_CDR::Octet minor_version,
                             ACE_Lock* lock)
   : start_ (0, ACE_Message_Block::MB_DATA, 0, 0, 0, lock),
+    cont_length_ (0),
+    gather_ (0),
     good_bit_ (true),
     major_version_ (major_version),
     minor_version_ (minor_version),
@@ -1130,6 +1167,8 @@ ACE_InputCDR::ACE_InputCDR (ACE_Data_Block *data,
                             ACE_CDR::Octet major_version,
                             ACE_CDR::Octet minor_version)
   : start_ (data, flag),
+    cont_length_ (0),
+    gather_ (0),
     do_byte_swap_ (byte_order != ACE_CDR_BYTE_ORDER),
     good_bit_ (true),
     major_version_ (major_version),
@@ -1152,6 +1191,8 @@ ACE_InputCDR::ACE_InputCDR (ACE_Data_Block *data,
                             ACE_CDR::Octet major_version,
                             ACE_CDR::Octet minor_version)
   : start_ (data, flag),
+    cont_length_ (0),
+    gather_ (0),
     do_byte_swap_ (byte_order != ACE_CDR_BYTE_ORDER),
     good_bit_ (true),
     major_version_ (major_version),
@@ -1182,6 +1223,8 @@ ACE_InputCDR::ACE_InputCDR (const ACE_InputCDR& rhs,
                             ACE_CDR::Long offset)
   : start_ (rhs.start_,
             ACE_CDR::MAX_ALIGNMENT),
+    cont_length_ (0),
+    gather_ (0),
     do_byte_swap_ (rhs.do_byte_swap_),
     good_bit_ (true),
     major_version_ (rhs.major_version_),
@@ -1223,6 +1266,8 @@ ACE_InputCDR::ACE_InputCDR (const ACE_InputCDR& rhs,
                             size_t size)
   : start_ (rhs.start_,
             ACE_CDR::MAX_ALIGNMENT),
+    cont_length_ (0),
+    gather_ (0),
     do_byte_swap_ (rhs.do_byte_swap_),
     good_bit_ (true),
     major_version_ (rhs.major_version_),
@@ -1242,23 +1287,56 @@ ACE_InputCDR::ACE_InputCDR (const ACE_InputCDR& rhs,
   const size_t newpos =
     rhs.start_.rd_ptr() - incoming_start;
 
-  if (newpos <= this->start_.space ()
-      && newpos + size <= this->start_.space ())
+  if (rhs.start_.cont () != 0 && size > rhs.start_.length ())
+    {
+      // The encapsulation continues in the chain of rhs, copy it to a
+      // buffer of its own.
+      ACE_Data_Block *db =
+        rhs.start_.data_block ()->clone_nocopy (
+          0,
+          size + 2 * ACE_CDR::MAX_ALIGNMENT);
+      ACE_InputCDR tmp (rhs);
+
+      if (db != 0)
+        {
+          this->start_.data_block (db);
+          ACE_CDR::mb_align (&this->start_);
+          this->start_.rd_ptr (newpos % ACE_CDR::MAX_ALIGNMENT);
+          this->start_.wr_ptr (this->start_.rd_ptr ());
+
+          if (tmp.read_array (this->start_.wr_ptr (),
+                              ACE_CDR::OCTET_SIZE,
+                              ACE_CDR::OCTET_ALIGN,
+                              static_cast<ACE_CDR::ULong> (size)))
+            this->start_.wr_ptr (size);
+          else
+            this->good_bit_ = false;
+        }
+      else
+        {
+          this->good_bit_ = false;
+        }
+    }
+  else if (newpos <= this->start_.space ()
+           && newpos + size <= this->start_.space ())
     {
       // Notice that ACE_Message_Block::duplicate may leave the
       // wr_ptr() with a higher value than what we actually want.
       this->start_.rd_ptr (newpos);
       this->start_.wr_ptr (newpos + size);
-
-      ACE_CDR::Octet byte_order = 0;
-      (void) this->read_octet (byte_order);
-      this->do_byte_swap_ = (byte_order != ACE_CDR_BYTE_ORDER);
     }
   else
     {
       this->good_bit_ = false;
     }
 
+  if (this->good_bit_)
+    {
+      ACE_CDR::Octet byte_order = 0;
+      (void) this->read_octet (byte_order);
+      this->do_byte_swap_ = (byte_order != ACE_CDR_BYTE_ORDER);
+    }
+
 #if defined (ACE_HAS_MONITOR_POINTS) && (ACE_HAS_MONITOR_POINTS == 1)
   ACE_NEW (this->monitor_,
            ACE::Monitor_Control::Size_Monitor);
@@ -1269,6 +1347,8 @@ ACE_InputCDR::ACE_InputCDR (const ACE_InputCDR& rhs,
 ACE_InputCDR::ACE_InputCDR (const ACE_InputCDR& rhs)
   : start_ (rhs.start_,
             ACE_CDR::MAX_ALIGNMENT),
+    cont_length_ (0),
+    gather_ (0),
     do_byte_swap_ (rhs.do_byte_swap_),
     good_bit_ (true),
     major_version_ (rhs.major_version_),
@@ -1288,6 +1368,12 @@ ACE_InputCDR::ACE_InputCDR (const ACE_InputCDR& rhs)
   this->start_.rd_ptr (rd_offset);
   this->start_.wr_ptr (wr_offset);
 
+  if (rhs.start_.cont () != 0)
+    {
+      this->start_.cont (rhs.start_.cont ()->duplicate ());
+      this->cont_length_ = rhs.cont_length_;
+    }
+
 #if defined (ACE_HAS_MONITOR_POINTS) && (ACE_HAS_MONITOR_POINTS == 1)
   ACE_NEW (this->monitor_,
            ACE::Monitor_Control::Size_Monitor);
@@ -1297,6 +1383,8 @@ ACE_InputCDR::ACE_InputCDR (const ACE_InputCDR& rhs)
 
 ACE_InputCDR::ACE_InputCDR (ACE_InputCDR::Transfer_Contents x)
   : start_ (x.rhs_.start_.data_block ()),
+    cont_length_ (0),
+    gather_ (0),
     do_byte_swap_ (x.rhs_.do_byte_swap_),
     good_bit_ (true),
     major_version_ (x.rhs_.major_version_),
@@ -1310,6 +1398,11 @@ ACE_InputCDR::ACE_InputCDR (ACE_InputCDR::Transfer_Contents x)
   ACE_Data_Block* db = this->start_.data_block ()->clone_nocopy ();
   (void) x.rhs_.start_.replace_data_block (db);
 
+  this->start_.cont (x.rhs_.start_.cont ());
+  this->cont_length_ = x.rhs_.cont_length_;
+  x.rhs_.start_.cont (0);
+  x.rhs_.cont_length_ = 0;
+
 #if defined (ACE_HAS_MONITOR_POINTS) && (ACE_HAS_MONITOR_POINTS == 1)
   ACE_NEW (this->monitor_,
            ACE::Monitor_Control::Size_Monitor);
@@ -1322,9 +1415,15 @@ ACE_InputCDR::operator= (const ACE_InputCDR& rhs)
 {
   if (this != &rhs)
     {
+      this->release_chain ();
       this->start_.data_block (rhs.start_.data_block ()->duplicate ());
       this->start_.rd_ptr (rhs.start_.rd_ptr ());
       this->start_.wr_ptr (rhs.start_.wr_ptr ());
+      if (rhs.start_.cont () != 0)
+        {
+          this->start_.cont (rhs.start_.cont ()->duplicate ());
+          this->cont_length_ = rhs.cont_length_;
+        }
       this->do_byte_swap_ = rhs.do_byte_swap_;
       this->good_bit_ = true;
       this->char_translator_ = rhs.char_translator_;
@@ -1354,6 +1453,8 @@ ACE_InputCDR::ACE_InputCDR (const ACE_OutputCDR& rhs,
             ACE_Time_Value::max_time,
             data_block_allocator,
             message_block_allocator),
+    cont_length_ (0),
+    gather_ (0),
     do_byte_swap_ (rhs.do_byte_swap_),
     good_bit_ (true),
     major_version_ (rhs.major_version_),
@@ -1832,42 +1933,102 @@ ACE_InputCDR::read_array (void* x,
 {
   if (length == 0)
     return true;
+
+  // Don't gather the whole array if it doesn't fit in the current
+  // block, copy it piecewise instead.
+  if (this->start_.cont () != 0)
+    return this->read_array_chain (x, size, align, length);
+
   char* buf = 0;
 
   if (this->adjust (size * length, align, buf) == 0)
-    {
+    return this->read_array_i (x, buf, size, length);
+  return false;
+}
+
+ACE_CDR::Boolean
+ACE_InputCDR::read_array_i (void* x,
+                            const char* buf,
+                            size_t size,
+                            ACE_CDR::ULong length)
+{
 #if defined (ACE_DISABLE_SWAP_ON_READ)
-      ACE_OS::memcpy (x, buf, size*length);
+  ACE_UNUSED_ARG (size);
+  ACE_OS::memcpy (x, buf, size*length);
 #else
-      if (!this->do_byte_swap_ || size == 1)
-        ACE_OS::memcpy (x, buf, size*length);
-      else
+  if (!this->do_byte_swap_ || size == 1)
+    ACE_OS::memcpy (x, buf, size*length);
+  else
+    {
+      char *target = reinterpret_cast<char*> (x);
+      switch (size)
         {
-          char *target = reinterpret_cast<char*> (x);
-          switch (size)
-            {
-            case 2:
-              ACE_CDR::swap_2_array (buf, target, length);
-              break;
-            case 4:
-              ACE_CDR::swap_4_array (buf, target, length);
-              break;
-            case 8:
-              ACE_CDR::swap_8_array (buf, target, length);
-              break;
-            case 16:
-              ACE_CDR::swap_16_array (buf, target, length);
-              break;
-            default:
-              // TODO: print something?
-              this->good_bit_ = false;
-              return false;
-            }
+        case 2:
+          ACE_CDR::swap_2_array (buf, target, length);
+          break;
+        case 4:
+          ACE_CDR::swap_4_array (buf, target, length);
+          break;
+        case 8:
+          ACE_CDR::swap_8_array (buf, target, length);
+          break;
+        case 16:
+          ACE_CDR::swap_16_array (buf, target, length);
+          break;
+        default:
+          // TODO: print something?
+          this->good_bit_ = false;
+          return false;
         }
+    }
 #endif /* ACE_DISABLE_SWAP_ON_READ */
-      return this->good_bit_;
+  return this->good_bit_;
+}
+
+ACE_CDR::Boolean
+ACE_InputCDR::read_array_chain (void* x,
+                                size_t size,
+                                size_t align,
+                                ACE_CDR::ULong length)
+{
+  char* buf = 0;
+
+  // Skip the padding, which may end the current block.
+  if (this->adjust (0, align, buf) != 0)
+    return false;
+
+  char *target = reinterpret_cast<char*> (x);
+  while (length > 0)
+    {
+      size_t const whole = this->start_.length () / size;
+      if (whole > 0)
+        {
+          // Elements are packed, so everything that fits in the
+          // current block is read in place.
+          ACE_CDR::ULong const n =
+            whole < length ? static_cast<ACE_CDR::ULong> (whole) : length;
+          if (!this->read_array_i (target, this->rd_ptr (), size, n))
+            return false;
+          this->rd_ptr (n * size);
+          target += n * size;
+          length -= n;
+        }
+      else if (this->adjust_chain (size, 1, buf) == 0)
+        {
+          // This element straddles two blocks, adjust_chain() gathered
+          // it.
+          if (!this->read_array_i (target, buf, size, 1))
+            return false;
+          target += size;
+          --length;
+        }
+      else
+        {
+          return false;
+        }
     }
-  return false;
+
+  return this->good_bit_;
 }
 
 ACE_CDR::Boolean
@@ -1944,6 +2105,14 @@ ACE_InputCDR::read_1 (ACE_CDR::Octet *x)
       return true;
     }
 
+  char *buf = 0;
+  if (this->start_.cont () != 0
+      && this->adjust_chain (ACE_CDR::OCTET_SIZE, ACE_CDR::OCTET_ALIGN, buf) == 0)
+    {
+      *x = *reinterpret_cast<ACE_CDR::Octet*> (buf);
+      return true;
+    }
+
   this->good_bit_ = false;
   return false;
 }
@@ -2049,9 +2218,8 @@ ACE_InputCDR::skip_string (void)
               return true;
             }
         }
-      else if (this->rd_ptr () + len <= this->wr_ptr ())
+      else if (this->skip_bytes (len))
         {
-          this->rd_ptr (len);
           return true;
         }
       this->good_bit_ = false;
@@ -2085,13 +2253,241 @@ ACE_InputCDR::skip_bytes (size_t len)
       this->rd_ptr (len);
       return true;
     }
+  if (this->start_.cont () != 0)
+    return this->skip_chain (len);
   this->good_bit_ = false;
   return false;
 }
 
+void
+ACE_InputCDR::append (const ACE_Message_Block *data)
+{
+  if (data == 0)
+    return;
+
+  ACE_Message_Block *chain = data->duplicate ();
+  if (chain == 0)
+    {
+      this->good_bit_ = false;
+      return;
+    }
+
+  ACE_Message_Block *tail = &this->start_;
+  while (tail->cont () != 0)
+    tail = tail->cont ();
+  tail->cont (chain);
+  this->cont_length_ += chain->total_length ();
+
+  // An empty stream has no position to continue from, start at the
+  // first block instead.
+  if (this->start_.length () == 0 && this->start_.cont () == chain)
+    (void) this->next_block (false);
+}
+
+int
+ACE_InputCDR::consolidate (void)
+{
+  if (this->start_.cont () == 0)
+    return 0;
+
+  // Keep the bytes already read from the current block, negative
+  // offsets from rd_ptr() must stay valid.
+  char * const base = this->start_.base ();
+  size_t const head = this->start_.wr_ptr () - base;
+  size_t const rd_pos = this->start_.rd_ptr () - base;
+
+  ACE_Data_Block *db =
+    this->start_.data_block ()->clone_nocopy (
+      0,
+      head + this->cont_length_ + 2 * ACE_CDR::MAX_ALIGNMENT);
+  if (db == 0)
+    {
+      this->good_bit_ = false;
+      return -1;
+    }
+
+  ACE_Message_Block mb (db);
+  ACE_CDR::mb_align (&mb);
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  mb.wr_ptr (ptrdiff_t (base) % ACE_CDR::MAX_ALIGNMENT);
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+  char * const newbase = mb.wr_ptr ();
+
+  mb.copy (base, head);
+  for (const ACE_Message_Block *i = this->start_.cont ();
+       i != 0;
+       i = i->cont ())
+    mb.copy (i->rd_ptr (), i->length ());
+
+  char * const wr_ptr = mb.wr_ptr ();
+  this->release_chain ();
+  this->start_.data_block (db->duplicate ());
+  this->start_.clr_self_flags (ACE_Message_Block::DONT_DELETE);
+  this->start_.rd_ptr (newbase + rd_pos);
+  this->start_.wr_ptr (wr_ptr);
+
+  return 0;
+}
+
+int
+ACE_InputCDR::adjust_chain (size_t size,
+                            size_t align,
+                            char *&buf)
+{
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  // The padding may end the current block too.
+  size_t const pad =
+    ACE_ptr_align_binary (this->rd_ptr (), align) - this->rd_ptr ();
+  if (!this->skip_chain (pad))
+    return -1;
+#else
+  ACE_UNUSED_ARG (align);
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+  if (size > this->length ())
+    {
+      this->good_bit_ = false;
+      return -1;
+    }
+
+  while (this->rd_ptr () + size > this->wr_ptr ()
+         && this->start_.length () == 0)
+    if (this->next_block () != 0)
+      return -1;
+
+  buf = this->rd_ptr ();
+  if (buf + size <= this->wr_ptr ())
+    {
+      this->rd_ptr (size);
+      return 0;
+    }
+
+  // The data straddles two or more blocks, gather it.
+  if (this->gather_ == 0
+      || this->gather_->size () < size + ACE_CDR::MAX_ALIGNMENT)
+    {
+      ACE_Message_Block::release (this->gather_);
+      this->gather_ = 0;
+      ACE_NEW_NORETURN (this->gather_,
+                        ACE_Message_Block (size + ACE_CDR::MAX_ALIGNMENT));
+      if (this->gather_ == 0 || this->gather_->base () == 0)
+        {
+          this->good_bit_ = false;
+          return -1;
+        }
+    }
+
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  buf = ACE_ptr_align_binary (this->gather_->base (),
+                              ACE_CDR::MAX_ALIGNMENT);
+#else
+  buf = this->gather_->base ();
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+  for (char *dst = buf; size > 0; )
+    {
+      size_t const n =
+        this->start_.length () < size ? this->start_.length () : size;
+      ACE_OS::memcpy (dst, this->rd_ptr (), n);
+      this->rd_ptr (n);
+      dst += n;
+      size -= n;
+      if (size > 0 && this->next_block () != 0)
+        return -1;
+    }
+
+  return 0;
+}
+
+bool
+ACE_InputCDR::skip_chain (size_t n)
+{
+  while (n > this->start_.length ())
+    {
+      n -= this->start_.length ();
+      this->start_.rd_ptr (this->start_.wr_ptr ());
+      if (this->next_block () != 0)
+        return false;
+    }
+
+  this->rd_ptr (n);
+  return true;
+}
+
+int
+ACE_InputCDR::next_block (bool realign)
+{
+  ACE_Message_Block * const next = this->start_.cont ();
+  if (next == 0)
+    {
+      this->good_bit_ = false;
+      return -1;
+    }
+
+  this->start_.cont (next->cont ());
+  next->cont (0);
+  this->cont_length_ -= next->length ();
+
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  // Alignment is computed from the address of rd_ptr(), so the next
+  // block must start where the current one ends modulo
+  // MAX_ALIGNMENT.  Otherwise copy it to a block that does.
+  ptrdiff_t const offset =
+    ptrdiff_t (this->start_.wr_ptr ()) % ACE_CDR::MAX_ALIGNMENT;
+  if (realign
+      && offset != ptrdiff_t (next->rd_ptr ()) % ACE_CDR::MAX_ALIGNMENT)
+    {
+      ACE_Data_Block *db =
+        next->data_block ()->clone_nocopy (0,
+                                           next->length ()
+                                           + 2 * ACE_CDR::MAX_ALIGNMENT);
+      if (db == 0)
+        {
+          next->release ();
+          this->good_bit_ = false;
+          return -1;
+        }
+
+      this->start_.data_block (db);
+      this->start_.clr_self_flags (ACE_Message_Block::DONT_DELETE);
+      ACE_CDR::mb_align (&this->start_);
+      this->start_.rd_ptr (static_cast<size_t> (offset));
+      this->start_.wr_ptr (this->start_.rd_ptr ());
+      this->start_.copy (next->rd_ptr (), next->length ());
+      next->release ();
+      return 0;
+    }
+#else
+  ACE_UNUSED_ARG (realign);
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+  this->start_.data_block (next->data_block ()->duplicate ());
+  this->start_.clr_self_flags (ACE_Message_Block::DONT_DELETE);
+  this->start_.rd_ptr (next->rd_ptr ());
+  this->start_.wr_ptr (next->wr_ptr ());
+  next->release ();
+  return 0;
+}
+
+void
+ACE_InputCDR::release_chain (void)
+{
+  if (this->start_.cont () != 0)
+    {
+      ACE_Message_Block::release (this->start_.cont ());
+      this->start_.cont (0);
+      this->cont_length_ = 0;
+    }
+
+  ACE_Message_Block::release (this->gather_);
+  this->gather_ = 0;
+}
+
 int
 ACE_InputCDR::grow (size_t newsize)
 {
+  this->release_chain ();
+
   if (ACE_CDR::grow (&this->start_, newsize) == -1)
     return -1;
 
@@ -2113,6 +2509,7 @@ ACE_InputCDR::reset (const ACE_Message_Block* data,
                      int byte_order)
 {
   this->reset_byte_order (byte_order);
+  this->release_chain ();
   ACE_CDR::consolidate (&this->start_, data);
 
 #if defined (ACE_HAS_MONITOR_POINTS) && (ACE_HAS_MONITOR_POINTS == 1)
@@ -2133,6 +2530,13 @@ ACE_InputCDR::steal_from (ACE_InputCDR &cdr)
   this->start_.wr_ptr (cdr.start_.wr_ptr ());
   this->major_version_ = cdr.major_version_;
   this->minor_version_ = cdr.minor_version_;
+
+  this->release_chain ();
+  this->start_.cont (cdr.start_.cont ());
+  this->cont_length_ = cdr.cont_length_;
+  cdr.start_.cont (0);
+  cdr.cont_length_ = 0;
+
   cdr.reset_contents ();
 
 #if defined (ACE_HAS_MONITOR_POINTS) && (ACE_HAS_MONITOR_POINTS == 1)
@@ -2175,6 +2579,15 @@ ACE_InputCDR::exchange_data_blocks (ACE_InputCDR &cdr)
   cdr.start_.set_self_flags (sf);
   this->start_.set_self_flags (df);
 
+  // Exchange the chains
+  ACE_Message_Block * const dcont = cdr.start_.cont ();
+  cdr.start_.cont (this->start_.cont ());
+  this->start_.cont (dcont);
+
+  size_t const dcont_length = cdr.cont_length_;
+  cdr.cont_length_ = this->cont_length_;
+  this->cont_length_ = dcont_length;
+
   // Reset the <cdr> pointers to zero before it is set again.
   cdr.start_.reset ();
   this->start_.reset ();
@@ -2257,19 +2670,24 @@ ACE_InputCDR::clone_from (ACE_InputCDR &cdr)
   size_t rd_bytes = rd_ptr - nrd_ptr;
   size_t wr_bytes = wr_ptr - nwr_ptr;
 
+  // The chain of <cdr> is copied after its current block.
+  size_t const cont_bytes = cdr.cont_length_;
+
+  this->release_chain ();
   ACE_CDR::mb_align (&this->start_);
 
   ACE_Data_Block *db = this->start_.data_block ();
 
   // If the size of the data that needs to be copied are higher than
   // what is available, then do a reallocation.
-  if (wr_bytes > (this->start_.size () - ACE_CDR::MAX_ALIGNMENT))
+  if (wr_bytes + cont_bytes
+      > (this->start_.size () - ACE_CDR::MAX_ALIGNMENT))
     {
       // @@NOTE: We need to probably add another method to the message
       // block interface to simplify this
       db = cdr.start_.data_block ()->clone_nocopy ();
 
-      if (db == 0 || db->size ((wr_bytes) +
+      if (db == 0 || db->size ((wr_bytes + cont_bytes) +
                                ACE_CDR::MAX_ALIGNMENT) == -1)
         return 0;
 
@@ -2288,10 +2706,19 @@ ACE_InputCDR::clone_from (ACE_InputCDR &cdr)
                          cdr.start_.rd_ptr (),
                          wr_bytes);
 
+  char *cont_ptr = this->start_.wr_ptr () + wr_bytes;
+  for (const ACE_Message_Block *i = cdr.start_.cont ();
+       i != 0;
+       i = i->cont ())
+    {
+      (void) ACE_OS::memcpy (cont_ptr, i->rd_ptr (), i->length ());
+      cont_ptr += i->length ();
+    }
+
   // Set the read pointer position to the same point as that was in
   // <incoming> cdr.
   this->start_.rd_ptr (rd_bytes);
-  this->start_.wr_ptr (wr_bytes);
+  this->start_.wr_ptr (wr_bytes + cont_bytes);
 
   // We have changed the read & write pointers for the incoming
   // stream. Set them back to the positions that they were before..
@@ -2315,7 +2742,13 @@ ACE_InputCDR::clone_from (ACE_InputCDR &cdr)
 ACE_Message_Block*
 ACE_InputCDR::steal_contents (void)
 {
+  // Hand the chain over as it is, only the current block is copied.
+  ACE_Message_Block * const cont = this->start_.cont ();
+  this->start_.cont (0);
+  this->cont_length_ = 0;
+
   ACE_Message_Block* block = this->start_.clone ();
+  block->cont (cont);
   this->start_.data_block (block->data_block ()->clone ());
 
   // If at all our message had a DONT_DELETE flag set, just clear it
@@ -2334,6 +2767,7 @@ ACE_InputCDR::steal_contents (void)
 void
 ACE_InputCDR::reset_contents (void)
 {
+  this->release_chain ();
   this->start_.data_block (this->start_.data_block ()->clone_nocopy ());
 
   // Reset the flags...
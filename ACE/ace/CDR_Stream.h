@@ -433,6 +433,17 @@ public:
    */
   int consolidate (void);
 
+  /// Make room for @a size more bytes in a single block.
+  /**
+   * If the current block cannot take @a size more bytes, a block of
+   * that size is added to the chain and becomes the current one.
+   * Use it when the size of what is written next is known, e.g. from
+   * an ACE_SizeCDR, to avoid growing the stream in several steps.
+   *
+   * @note The only expected error is to run out of memory.
+   */
+  int reserve (size_t size);
+
   /**
    * Access the underlying buffer (read only).  @note This
    * method only returns a pointer to the first block in the
@@ -570,6 +581,13 @@ private:
                        size_t align,
                        char *&buf);
 
+  /**
+   * Make the next block of the chain the current one, allocating it
+   * if it has no room for @a size bytes.  A new block is just big
+   * enough if @a exact, else it grows with ACE_CDR::next_size().
+   */
+  int grow_chain (size_t size, bool exact);
+
 private:
   /// The start of the chain of message blocks.
   ACE_Message_Block start_;
@@ -731,7 +749,8 @@ public:
   ACE_InputCDR& operator= (const ACE_InputCDR& rhs);
 
   /// When interpreting indirected TypeCodes it is useful to make a
-  /// "copy" of the stream starting in the new position.
+  /// "copy" of the stream starting in the new position.  The new
+  /// stream must lie within the current block of @a rhs.
   ACE_InputCDR (const ACE_InputCDR& rhs,
                 size_t size,
                 ACE_CDR::Long offset);
@@ -941,11 +960,38 @@ public:
    * @return The start of the message block chain for this CDR
    *         stream.
    *
-   * @note In the current implementation the chain has length 1, but
-   *       we are planning to change that.
+   * @note The stream reads the block returned here and then the
+   *       blocks chained through its cont() field, see append().
+   *       Blocks are dropped from the chain once they have been read.
    */
   const ACE_Message_Block* start (void) const;
 
+  /**
+   * Append the chain of message blocks starting at @a data to the
+   * end of the stream, without copying the data.  The blocks are
+   * duplicated, so the caller keeps ownership of @a data.
+   *
+   * Reads that do not fit in the current block continue in the
+   * next one, including primitives that straddle the boundary.  The
+   * stream behaves as the concatenation of the blocks; a block whose
+   * rd_ptr() does not continue the alignment of the previous one is
+   * copied when the stream reaches it.  If the stream is empty the
+   * first block of @a data becomes the current block and keeps its
+   * own alignment.
+   */
+  void append (const ACE_Message_Block *data);
+
+  /**
+   * Copy the current block and the rest of the chain into a single
+   * buffer.  The bytes already read from the current block are kept
+   * and rd_ptr() keeps its alignment, so code computing offsets from
+   * rd_ptr() can call this first.  Does nothing if the stream has no
+   * chain.
+   *
+   * @return 0 on success and -1 on failure.
+   */
+  int consolidate (void);
+
   // = The following functions are useful to read the contents of the
   //   CDR stream from a socket or file.
 
@@ -976,10 +1022,7 @@ public:
   void steal_from (ACE_InputCDR &cdr);
 
   /// Exchange data blocks with the caller of this method. The read
-  /// and write pointers are also exchanged.
-  /**
-   * @note We now do only with the start_ message block.
-   */
+  /// and write pointers and the chains are also exchanged.
   void exchange_data_blocks (ACE_InputCDR &cdr);
 
   /// Copy the data portion from the @a cdr to this cdr and return the
@@ -999,9 +1042,14 @@ public:
   char* rd_ptr (void);
 
   /// Returns the current position for the @c wr_ptr.
+  /**
+   * @note If the stream has a chain this is the end of the current
+   *       block, not the end of the stream.
+   */
   char* wr_ptr (void);
 
-  /// Return how many bytes are left in the stream.
+  /// Return how many bytes are left in the stream, including the
+  /// chained blocks.
   size_t length (void) const;
 
   /**
@@ -1058,10 +1106,17 @@ public:
 
 protected:
 
-  /// The start of the chain of message blocks, even though in the
-  /// current version the chain always has length 1.
+  /// The block being read; the blocks still to be read are chained
+  /// through its cont() field and owned by the stream.
   ACE_Message_Block start_;
 
+  /// The number of bytes in the blocks chained after start_.
+  size_t cont_length_;
+
+  /// Scratch space for reads that straddle two blocks, allocated on
+  /// first use.
+  ACE_Message_Block *gather_;
+
   /// The CDR stream byte order does not match the one on the machine,
   /// swapping is needed while reading.
   bool do_byte_swap_;
@@ -1112,6 +1167,38 @@ private:
                                size_t align,
                                ACE_CDR::ULong length);
 
+  /// Copy @a length elements of @a size bytes from @a buf to @a x,
+  /// swapping them if needed.
+  ACE_CDR::Boolean read_array_i (void* x,
+                                 const char* buf,
+                                 size_t size,
+                                 ACE_CDR::ULong length);
+
+  /// read_array() for streams with a chain: copies the elements
+  /// block by block and gathers those that straddle two blocks.
+  ACE_CDR::Boolean read_array_chain (void* x,
+                                     size_t size,
+                                     size_t align,
+                                     ACE_CDR::ULong length);
+
+  /// Slow path of adjust(), used when @a size bytes do not fit in the
+  /// current block and there are more blocks in the chain.  If the
+  /// data straddles blocks it is copied to gather_.
+  int adjust_chain (size_t size,
+                    size_t align,
+                    char *&buf);
+
+  /// Skip @a n bytes, moving into the chained blocks as needed.
+  bool skip_chain (size_t n);
+
+  /// Make the next block in the chain the current one.  If @a realign
+  /// is true and the block does not continue the alignment of the
+  /// current one its data is copied to a new, properly aligned block.
+  int next_block (bool realign = true);
+
+  /// Release the chain and the gather buffer.
+  void release_chain (void);
+
   /**
    * On those occasions when the native codeset for wchar is smaller than
    * the size of a wchar_t, such as using UTF-16 with a 4-byte wchar_t, a
@@ -677,6 +677,8 @@ ACE_OutputCDR::wchar_translator (ACE_WChar_Codeset_Translator * wctran)
 ACE_INLINE
 ACE_InputCDR::~ACE_InputCDR (void)
 {
+  this->release_chain ();
+
 #if defined (ACE_HAS_MONITOR_POINTS) && (ACE_HAS_MONITOR_POINTS == 1)
   this->monitor_->remove_ref ();
 #endif /* ACE_HAS_MONITOR_POINTS==1 */
@@ -794,7 +796,7 @@ ACE_InputCDR::read_fixed (ACE_CDR::Fixed &x)
 ACE_INLINE size_t
 ACE_InputCDR::length (void) const
 {
-  return this->start_.length ();
+  return this->start_.length () + this->cont_length_;
 }
 
 ACE_INLINE ACE_CDR::Boolean
@@ -1155,6 +1157,9 @@ ACE_InputCDR::adjust (size_t size,
       return 0;
     }
 
+  if (this->start_.cont () != 0)
+    return this->adjust_chain (size, align, buf);
+
   this->good_bit_ = false;
   return -1;
 #if defined (ACE_LACKS_CDR_ALIGNMENT)
@@ -1702,6 +1707,10 @@ ACE_InputCDR::align_read_ptr (size_t alignment)
       return 0;
     }
 
+  // The padding continues in the next block.
+  if (this->start_.cont () != 0)
+    return this->adjust_chain (0, alignment, buf);
+
   this->good_bit_ = false;
   return -1;
 }
@@ -0,0 +1,415 @@
+#ifndef ACE_CONCURRENT_HASH_MAP_T_CPP
+#define ACE_CONCURRENT_HASH_MAP_T_CPP
+
+#include "ace/Concurrent_Hash_Map_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+
+#if !defined (__ACE_INLINE__)
+# include "ace/Concurrent_Hash_Map_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Malloc_Base.h"
+#include "ace/Malloc.h"
+#include "ace/OS_NS_string.h"
+#include "ace/os_include/os_errno.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Concurrent_Hash_Map)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Concurrent_Hash_Map_Iterator)
+
+template <class EXT_ID, class INT_ID>
+ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID>::ACE_Concurrent_Hash_Map_Entry (const EXT_ID &ext_id,
+                                                                              const INT_ID &int_id,
+                                                                              size_t hash,
+                                                                              ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID> *next)
+  : ext_id_ (ext_id),
+    int_id_ (int_id),
+    hash_ (hash),
+    next_ (next)
+{
+}
+
+template <class EXT_ID, class INT_ID>
+ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID>::~ACE_Concurrent_Hash_Map_Entry (void)
+{
+}
+
+template <class EXT_ID, class INT_ID> const EXT_ID &
+ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID>::key () const
+{
+  return ext_id_;
+}
+
+template <class EXT_ID, class INT_ID> const INT_ID &
+ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID>::item () const
+{
+  return int_id_;
+}
+
+template <class EXT_ID, class INT_ID> void
+ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("next_ = %@\n"), this->next_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("total_size = %B\n"), this->total_size ()));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("current_size = %B\n"), this->current_size ()));
+  this->epoch_manager_.dump ();
+  if (this->table_allocator_ != 0)
+    this->table_allocator_->dump ();
+  if (this->entry_allocator_ != 0)
+    this->entry_allocator_->dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::open (size_t size,
+                                                                                 ACE_Allocator *table_alloc,
+                                                                                 ACE_Allocator *entry_alloc)
+{
+  // Calling this->close () to ensure we release previous allocated
+  // memory before allocating new one.
+  this->close ();
+
+  if (table_alloc == 0)
+    table_alloc = ACE_Allocator::instance ();
+
+  this->table_allocator_ = table_alloc;
+
+  if (entry_alloc == 0)
+    entry_alloc = table_alloc;
+
+  this->entry_allocator_ = entry_alloc;
+
+  // There are never fewer buckets than writer locks, see stripe ().
+  size_t buckets = STRIPES;
+  while (buckets < size)
+    buckets *= 2;
+
+  Table *const table = this->allocate_table (buckets);
+  if (table == 0)
+    return -1;
+
+  __atomic_store_n (&this->table_, table, __ATOMIC_RELEASE);
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::close (void)
+{
+  // The map is not shared any more, reclaim what the readers might
+  // have been looking at first.
+  this->epoch_manager_.reclaim_all ();
+
+  Table *const table = this->table_;
+  if (table != 0)
+    {
+      this->table_ = 0;
+      this->cur_size_ = 0;
+      ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::cleanup_table (table, this);
+    }
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_all (void)
+{
+  this->acquire_all ();
+
+  // Readers may still be on the entries, so swap in an empty table
+  // and retire the old one, which owns the entries linked in it.
+  Table *const table = this->table_;
+  Table *const empty = table == 0 ? 0 : this->allocate_table (table->mask_ + 1);
+  if (empty != 0)
+    {
+      __atomic_store_n (&this->table_, empty, __ATOMIC_RELEASE);
+      __atomic_store_n (&this->cur_size_, 0, __ATOMIC_RELAXED);
+    }
+
+  this->release_all ();
+
+  if (empty == 0)
+    return table == 0 ? 0 : -1;
+
+  this->epoch_manager_.retire (table,
+                               &ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::cleanup_table);
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+typename ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::ENTRY **
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::link_i (Table *table,
+                                                                                   const EXT_ID &ext_id,
+                                                                                   size_t hash)
+{
+  // Only the writers that hold the lock of the bucket change its
+  // links, the loads don't need to be ordered.
+  ENTRY **link = &table->buckets_[hash & table->mask_];
+  for (ENTRY *entry = __atomic_load_n (link, __ATOMIC_RELAXED);
+       entry != 0;
+       entry = __atomic_load_n (link, __ATOMIC_RELAXED))
+    {
+      if (this->equal (entry, ext_id, hash))
+        break;
+      link = &entry->next_;
+    }
+
+  return link;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bind_i (const EXT_ID &ext_id,
+                                                                                   const INT_ID &int_id,
+                                                                                   INT_ID *old_int_id,
+                                                                                   bool replace)
+{
+  size_t const hash = this->hash (ext_id);
+  ENTRY *old_entry = 0;
+  Table *table = 0;
+  size_t size = 0;
+  size_t buckets = 0;
+
+  {
+    ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->stripe (hash), -1);
+
+    // The table only changes while all the locks are held.
+    table = this->table_;
+    if (table == 0)
+      return -1;
+
+    ENTRY **const link = this->link_i (table, ext_id, hash);
+    old_entry = *link;
+
+    if (old_entry != 0)
+      {
+        if (old_int_id != 0)
+          *old_int_id = old_entry->int_id_;
+        if (!replace)
+          return 1;
+      }
+
+    void *ptr = 0;
+    ACE_ALLOCATOR_RETURN (ptr,
+                          this->entry_allocator_->malloc (sizeof (ENTRY)),
+                          -1);
+    ENTRY *const entry =
+      new (ptr) ENTRY (ext_id,
+                       int_id,
+                       hash,
+                       old_entry == 0 ? 0 : old_entry->next_);
+
+    // Publish the entry, readers see it complete.
+    __atomic_store_n (link, entry, __ATOMIC_RELEASE);
+
+    if (old_entry == 0)
+      size = __atomic_add_fetch (&this->cur_size_, 1, __ATOMIC_RELAXED);
+
+    // Once the lock is released another writer may grow the map and
+    // retire the table, which is then only compared by grow_i.
+    buckets = table->mask_ + 1;
+  }
+
+  if (old_entry != 0)
+    {
+      this->retire_entry (old_entry);
+      return 1;
+    }
+
+  if (size > buckets)
+    this->grow_i (table);
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_i (const EXT_ID &ext_id,
+                                                                                     INT_ID *int_id)
+{
+  size_t const hash = this->hash (ext_id);
+  ENTRY *entry = 0;
+
+  {
+    ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->stripe (hash), -1);
+
+    Table *const table = this->table_;
+    if (table == 0)
+      return -1;
+
+    ENTRY **const link = this->link_i (table, ext_id, hash);
+    entry = *link;
+    if (entry == 0)
+      {
+        errno = ENOENT;
+        return -1;
+      }
+
+    if (int_id != 0)
+      *int_id = entry->int_id_;
+
+    // Readers already on the entry still find the rest of the bucket
+    // through its next_.
+    __atomic_store_n (link, entry->next_, __ATOMIC_RELEASE);
+    __atomic_sub_fetch (&this->cur_size_, 1, __ATOMIC_RELAXED);
+  }
+
+  this->retire_entry (entry);
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+typename ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::Table *
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::allocate_table (size_t size)
+{
+  size_t const header = ACE_MALLOC_ROUNDUP (sizeof (Table), ACE_MALLOC_ALIGN);
+  void *ptr = 0;
+
+  ACE_ALLOCATOR_RETURN (ptr,
+                        this->table_allocator_->malloc (header + size * sizeof (ENTRY *)),
+                        0);
+
+  Table *const table = new (ptr) Table;
+  table->mask_ = size - 1;
+  table->buckets_ = reinterpret_cast<ENTRY **> (static_cast<char *> (ptr) + header);
+  ACE_OS::memset (table->buckets_, 0, size * sizeof (ENTRY *));
+  return table;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::grow_i (Table *table)
+{
+  this->acquire_all ();
+
+  Table *bigger = 0;
+
+  // Another writer may have grown the table in the meantime.
+  if (this->table_ == table && this->cur_size_ > table->mask_ + 1)
+    {
+      bigger = this->allocate_table ((table->mask_ + 1) * 2);
+
+      // Readers may be on the entries of the old table, and follow
+      // their next_ to the rest of the old bucket, so the new table
+      // gets copies of them.
+      for (size_t i = 0; bigger != 0 && i <= table->mask_; ++i)
+        for (ENTRY *entry = table->buckets_[i];
+             entry != 0;
+             entry = entry->next_)
+          {
+            ENTRY **const bucket = &bigger->buckets_[entry->hash_ & bigger->mask_];
+            void *ptr = this->entry_allocator_->malloc (sizeof (ENTRY));
+            if (ptr == 0)
+              {
+                // Stay with the old table.
+                ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::cleanup_table (bigger, this);
+                bigger = 0;
+                break;
+              }
+
+            *bucket = new (ptr) ENTRY (entry->ext_id_,
+                                       entry->int_id_,
+                                       entry->hash_,
+                                       *bucket);
+          }
+
+      if (bigger != 0)
+        __atomic_store_n (&this->table_, bigger, __ATOMIC_RELEASE);
+    }
+
+  this->release_all ();
+
+  // The old table owns the entries still linked in it.
+  if (bigger != 0)
+    this->epoch_manager_.retire (table,
+                                 &ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::cleanup_table);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::acquire_all (void)
+{
+  for (int i = 0; i < STRIPES; ++i)
+    this->stripes_[i].acquire ();
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::release_all (void)
+{
+  for (int i = STRIPES - 1; i >= 0; --i)
+    this->stripes_[i].release ();
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::retire_entry (ENTRY *entry)
+{
+  this->epoch_manager_.retire (entry,
+                               &ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::cleanup_entry);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::cleanup_entry (void *node,
+                                                                                          void *map)
+{
+  ENTRY *const entry =
+    static_cast<ENTRY *> (static_cast<ACE_Epoch_Node *> (node));
+  ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> *const self =
+    static_cast<ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> *> (map);
+
+  ACE_DES_FREE_TEMPLATE2 (entry, self->entry_allocator_->free,
+                          ACE_Concurrent_Hash_Map_Entry, EXT_ID, INT_ID);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::cleanup_table (void *node,
+                                                                                          void *map)
+{
+  Table *const table =
+    static_cast<Table *> (static_cast<ACE_Epoch_Node *> (node));
+  ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> *const self =
+    static_cast<ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> *> (map);
+
+  for (size_t i = 0; i <= table->mask_; ++i)
+    for (ENTRY *entry = table->buckets_[i]; entry != 0; )
+      {
+        ENTRY *const next = entry->next_;
+        ACE_DES_FREE_TEMPLATE2 (entry, self->entry_allocator_->free,
+                                ACE_Concurrent_Hash_Map_Entry, EXT_ID, INT_ID);
+        entry = next;
+      }
+
+  table->~Table ();
+  self->table_allocator_->free (table);
+}
+
+// ---------------------------------------------------------------------
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Concurrent_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("index_ = %B "), this->index_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("entry_ = %@"), this->entry_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+
+#endif /* ACE_CONCURRENT_HASH_MAP_T_CPP */
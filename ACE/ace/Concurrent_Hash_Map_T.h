@@ -0,0 +1,484 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Concurrent_Hash_Map_T.h
+ *
+ *  Hash map whose readers don't take any lock, for tables that are
+ *  read far more often than they are written.
+ */
+//=============================================================================
+
+#ifndef ACE_CONCURRENT_HASH_MAP_T_H
+#define ACE_CONCURRENT_HASH_MAP_T_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Epoch_Manager.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+
+#include "ace/Default_Constants.h"
+#include "ace/Functor_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Basic_Types.h"
+#include <iterator>
+
+/// Number of locks the writers of an ACE_Concurrent_Hash_Map are
+/// spread over, a power of two.
+#if !defined (ACE_CONCURRENT_HASH_MAP_STRIPES)
+# define ACE_CONCURRENT_HASH_MAP_STRIPES 16
+#endif /* ACE_CONCURRENT_HASH_MAP_STRIPES */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Allocator;
+
+/**
+ * @class ACE_Concurrent_Hash_Map_Entry
+ *
+ * @brief Define an entry in the concurrent hash table.
+ *
+ * The key and item of an entry never change once it is in the table,
+ * a rebind replaces the entry.
+ */
+template <class EXT_ID, class INT_ID>
+class ACE_Concurrent_Hash_Map_Entry : public ACE_Epoch_Node
+{
+public:
+  /// Constructor.
+  ACE_Concurrent_Hash_Map_Entry (const EXT_ID &ext_id,
+                                 const INT_ID &int_id,
+                                 size_t hash,
+                                 ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID> *next);
+
+  /// Destructor.
+  ~ACE_Concurrent_Hash_Map_Entry (void);
+
+  /// Read-only key accessor.
+  const EXT_ID& key (void) const;
+
+  /// Read-only item accessor.
+  const INT_ID& item (void) const;
+
+  /// Key used to look up an entry.
+  EXT_ID ext_id_;
+
+  /// The contents of the entry itself.
+  INT_ID int_id_;
+
+  /// Mixed hash value of the key.
+  size_t hash_;
+
+  /// Next entry of the bucket, changed by the writers while readers
+  /// follow it.
+  ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID> *next_;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+private:
+  ACE_UNIMPLEMENTED_FUNC (ACE_Concurrent_Hash_Map_Entry (const ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID> &))
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID> &))
+};
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Concurrent_Hash_Map_Iterator;
+
+/**
+ * @class ACE_Concurrent_Hash_Map
+ *
+ * @brief Define a map abstraction that associates @c EXT_ID type
+ * objects with @c INT_ID type objects, for many concurrent readers
+ * and few writers.
+ *
+ * The readers of an ACE_Hash_Map_Manager_Ex take its lock, which
+ * makes every lookup of a table shared by many threads bounce the
+ * cache line of the lock between their CPUs, even when the lock is
+ * a readers/writer lock.  The readers of this map don't take any
+ * lock.  They follow the bucket chains with acquire loads, within an
+ * ACE_Epoch_Guard of the map's ACE_Epoch_Manager, and never wait.
+ * The entries are immutable: a rebind links a new entry in place of
+ * the old one, and the writers retire the entries they unlink to the
+ * epoch manager, which reclaims them once no reader can still be
+ * looking at them.
+ *
+ * The writers serialize on one of ACE_CONCURRENT_HASH_MAP_STRIPES
+ * locks of type @c ACE_LOCK, picked from the hash of the key, so
+ * writers of different keys mostly proceed in parallel.  With
+ * ACE_Null_Mutex there must be a single writer at a time, readers
+ * still being free to run concurrently.  The table doubles once it
+ * holds more entries than buckets.  The growing writer takes all the
+ * locks, links copies of the entries into the new table, publishes
+ * it and retires the old table along with its entries, so that the
+ * readers still on it keep a consistent view.
+ *
+ * find() copies the item out, since an entry may be reclaimed as
+ * soon as the reader leaves the guard.  The iterators hold a guard
+ * for as long as they live, and are weakly consistent: they see each
+ * entry that stays in the map during the iteration once, and may or
+ * may not see the entries bound or unbound meanwhile.  The entries
+ * they return must not be changed.
+ *
+ * The HASH_KEY and COMPARE_KEYS functors are the ones of
+ * ACE_Hash_Map_Manager_Ex.  The hash value is mixed before use, so a
+ * weak hash function such as the identity for integers is fine.
+ * The key and item types must be copy constructible.
+ *
+ * The map is only available where ACE_HAS_GCC_ATOMIC_MEMORY_MODEL is
+ * defined.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Concurrent_Hash_Map
+{
+public:
+  friend class ACE_Concurrent_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+
+  typedef EXT_ID
+          KEY;
+  typedef INT_ID
+          VALUE;
+  typedef ACE_LOCK lock_type;
+  typedef ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID>
+          ENTRY;
+
+  // = ACE-style iterator typedefs.
+  typedef ACE_Concurrent_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          ITERATOR;
+
+  // = STL-style iterator typedefs.
+  typedef ACE_Concurrent_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          iterator;
+
+  // = STL-style typedefs/traits.
+  typedef EXT_ID                                        key_type;
+  typedef INT_ID                                        data_type;
+  typedef ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID> value_type;
+  typedef value_type const &                            const_reference;
+  typedef value_type const *                            const_pointer;
+  typedef ptrdiff_t                                     difference_type;
+  typedef size_t                                        size_type;
+
+  enum
+  {
+    /// Number of writer locks.
+    STRIPES = ACE_CONCURRENT_HASH_MAP_STRIPES
+  };
+
+  /**
+   * Initialize an ACE_Concurrent_Hash_Map with the default number of
+   * buckets.
+   *
+   * @param table_alloc is a pointer to a memory allocator used for
+   *        the tables.  If @a table_alloc is 0 it defaults to
+   *        ACE_Allocator::instance().
+   * @param entry_alloc is a pointer to an additional allocator for
+   *        the entries, so it should be able to allocate chunks of
+   *        sizeof(ENTRY) bytes each.  If @a entry_alloc is
+   *        0 it defaults to the @a table_alloc.  Both must be thread
+   *        safe, the entries are reclaimed from any thread.
+   */
+  ACE_Concurrent_Hash_Map (ACE_Allocator *table_alloc = 0,
+                           ACE_Allocator *entry_alloc = 0);
+
+  /**
+   * Initialize an ACE_Concurrent_Hash_Map with at least @a size
+   * buckets.  See the default constructor for the allocators.
+   */
+  explicit ACE_Concurrent_Hash_Map (size_t size,
+                                    ACE_Allocator *table_alloc = 0,
+                                    ACE_Allocator *entry_alloc = 0);
+
+  /**
+   * Initialize the map with at least @a size buckets, after closing
+   * it.  Like close(), it must not race with any other operation.
+   * Returns 0 on success, -1 on failure.
+   */
+  int open (size_t size = ACE_DEFAULT_MAP_SIZE,
+            ACE_Allocator *table_alloc = 0,
+            ACE_Allocator *entry_alloc = 0);
+
+  /// Close down the map and release all its memory, including the
+  /// retired entries.  It must not race with any other operation.
+  int close (void);
+
+  /// Removes all the entries in the map.
+  int unbind_all (void);
+
+  /// Cleanup the map.
+  ~ACE_Concurrent_Hash_Map (void);
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is already in
+   * the map then the map is not changed.  Returns 0 if a new entry
+   * is bound successfully, returns 1 if an attempt is made to bind
+   * an existing entry, and returns -1 if failures occur.
+   */
+  int bind (const EXT_ID &ext_id,
+            const INT_ID &int_id);
+
+  /**
+   * Associate @a ext_id with @a int_id if and only if @a ext_id is
+   * not in the map.  If @a ext_id is already in the map then the
+   * @a int_id parameter is assigned the existing value in the map.
+   * Returns 0 if a new entry is bound successfully, returns 1 if an
+   * attempt is made to bind an existing entry, and returns -1 if
+   * failures occur.
+   */
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id);
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is not in the
+   * map then behaves just like bind().  Otherwise, the entry of
+   * @a ext_id is replaced by a new one.  Returns 0 if a new entry is
+   * bound successfully, returns 1 if an existing entry was rebound,
+   * and returns -1 if failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id);
+
+  /**
+   * Same as the other rebind(), except that the previous value of
+   * the item is copied into @a old_int_id when @a ext_id was bound.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id);
+
+  /// Locate @a ext_id and pass out a copy of its item in @a int_id.
+  /// Returns 0 if found, returns -1 if not found.
+  int find (const EXT_ID &ext_id,
+            INT_ID &int_id) const;
+
+  /// Returns 0 if the @a ext_id is in the mapping, otherwise -1.
+  int find (const EXT_ID &ext_id) const;
+
+  /// Unbind (remove) the @a ext_id from the map.  Returns 0 if
+  /// successful, -1 if @a ext_id was not bound.
+  int unbind (const EXT_ID &ext_id);
+
+  /// Same as the other unbind(), except that the item is copied into
+  /// @a int_id.
+  int unbind (const EXT_ID &ext_id,
+              INT_ID &int_id);
+
+  /// Returns the current number of entries in the map.
+  size_t current_size (void) const;
+
+  /// Returns the current number of buckets of the map.
+  size_t total_size (void) const;
+
+  /// Epoch manager of the map's readers, which is also handed the
+  /// entries unlinked by the writers.
+  ACE_Epoch_Manager &epoch_manager (void);
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  // = STL styled iterator factory functions.
+
+  /// Return forward iterator.
+  ACE_Concurrent_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> begin (void);
+  ACE_Concurrent_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> end (void);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// A table of buckets, allocated in one block with its buckets.
+  struct Table : public ACE_Epoch_Node
+  {
+    /// Number of buckets minus one.
+    size_t mask_;
+
+    /// First entry of each bucket.
+    ENTRY **buckets_;
+  };
+
+  /// Mixed hash value of @a ext_id.
+  size_t hash (const EXT_ID &ext_id) const;
+
+  /// Returns 1 when @a entry holds @a ext_id, of hash value @a hash.
+  int equal (const ENTRY *entry, const EXT_ID &ext_id, size_t hash) const;
+
+  /// Entry of @a ext_id in @a table, or 0.  The caller is in a
+  /// critical section of the epoch manager, or holds a writer lock.
+  ENTRY *find_i (Table *table, const EXT_ID &ext_id, size_t hash) const;
+
+  /// Link to the entry of @a ext_id in @a table, or to the null link
+  /// that ends its bucket.  The caller holds the lock of the bucket.
+  ENTRY **link_i (Table *table, const EXT_ID &ext_id, size_t hash);
+
+  /// Shared by bind(), trybind() and the rebind()s: binds @a ext_id
+  /// to @a int_id and, when @a replace is set, replaces an existing
+  /// entry after copying its item in @a old_int_id.
+  int bind_i (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID *old_int_id,
+              bool replace);
+
+  /// Shared by the unbind()s: unbinds @a ext_id and copies its item
+  /// in @a int_id, unless it is 0.
+  int unbind_i (const EXT_ID &ext_id, INT_ID *int_id);
+
+  /// Allocate a table of @a size buckets, a power of two.
+  Table *allocate_table (size_t size);
+
+  /// Double the number of buckets of @a table, unless another writer
+  /// already replaced it.
+  void grow_i (Table *table);
+
+  /// Lock or unlock all the writer locks, in order.
+  void acquire_all (void);
+  void release_all (void);
+
+  /// Writer lock of the keys of hash value @a hash.
+  ACE_LOCK &stripe (size_t hash);
+
+  /// Retire @a entry to the epoch manager.
+  void retire_entry (ENTRY *entry);
+
+  /// Cleanup hooks of the entries and tables, called by the epoch
+  /// manager.
+  static void cleanup_entry (void *node, void *map);
+  static void cleanup_table (void *node, void *map);
+
+  /// Pointer to a memory allocator used for the tables.
+  ACE_Allocator *table_allocator_;
+
+  /// Pointer to a memory allocator used for the entries.
+  ACE_Allocator *entry_allocator_;
+
+  /// Current table, replaced as a whole when it grows.
+  Table *table_;
+
+  /// Current number of entries in the map.
+  size_t cur_size_;
+
+  /// Writer locks, picked by hash value.
+  ACE_LOCK stripes_[STRIPES];
+
+  /// Function object used for hashing keys.
+  HASH_KEY hash_key_;
+
+  /// Function object used for comparing keys.
+  COMPARE_KEYS compare_keys_;
+
+  /// Keeps the unlinked entries and tables until no reader can see
+  /// them.  Declared last, so that it is destroyed first and reclaims
+  /// them while the rest of the map is still there.
+  ACE_Epoch_Manager epoch_manager_;
+
+private:
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Concurrent_Hash_Map (const ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &))
+};
+
+/**
+ * @class ACE_Concurrent_Hash_Map_Iterator
+ *
+ * @brief Forward iterator for the ACE_Concurrent_Hash_Map.
+ *
+ * The iterator stays in a read-side critical section of the map's
+ * epoch manager for as long as it lives, which holds back the
+ * reclamation of the entries unlinked meanwhile.  Don't keep it
+ * around longer than needed.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Concurrent_Hash_Map_Iterator
+{
+public:
+  // = STL-style traits.
+  typedef std::forward_iterator_tag iterator_category;
+  typedef typename ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::value_type value_type;
+  typedef typename ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::const_reference reference;
+  typedef typename ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::const_pointer pointer;
+  typedef typename ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::difference_type difference_type;
+
+  typedef ACE_Concurrent_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> container_type;
+  typedef ACE_Concurrent_Hash_Map_Entry<EXT_ID, INT_ID> ENTRY;
+
+  /// Iterator at the first entry of @a mm, or at its end when
+  /// @a tail is set.
+  ACE_Concurrent_Hash_Map_Iterator (container_type &mm, int tail = 0);
+
+  /// Pass back the @a next_entry that hasn't been seen in the map.
+  /// Returns 0 when all items have been seen, else 1.
+  int next (const ENTRY *&next_entry) const;
+
+  /// Returns 1 when all items have been seen, else 0.
+  int done (void) const;
+
+  /// Move forward by one element in the map.  Returns 0 when all the
+  /// items in the map have been seen, else 1.
+  int advance (void);
+
+  // = STL styled iteration, compare, and reference functions.
+
+  /// Returns a reference to the interal element @c this is pointing to.
+  const ENTRY& operator* (void) const;
+
+  /// Returns a pointer to the interal element @c this is pointing to.
+  const ENTRY* operator-> (void) const;
+
+  /// Prefix advance.
+  ACE_Concurrent_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ (void);
+
+  /// Postfix advance.
+  ACE_Concurrent_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Check if two iterators point to the same position.
+  bool operator== (const ACE_Concurrent_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+  bool operator!= (const ACE_Concurrent_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  typedef typename container_type::Table Table;
+
+  /// Move to the first entry of the first non-empty bucket from
+  /// @c index_ on.
+  void skip_empty_i (void);
+
+  /// Keeps the entries and the table from being reclaimed.
+  ACE_Epoch_Guard guard_;
+
+  /// Table we are iterating over, 0 at the end.
+  Table *table_;
+
+  /// Bucket of the current entry.
+  size_t index_;
+
+  /// Current entry, 0 at the end.
+  ENTRY *entry_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+# include "ace/Concurrent_Hash_Map_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Concurrent_Hash_Map_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Concurrent_Hash_Map_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_CONCURRENT_HASH_MAP_T_H */
@@ -71,6 +71,28 @@
 #define ACE_REACTOR_NOTIFICATION_ARRAY_SIZE 1024
 #endif /* ACE_REACTOR_NOTIFICATION_ARRAY_SIZE */
 
+// Maximum number of events the ACE_Dev_Poll_Reactor retrieves with a
+// single epoll_wait() call.
+#if !defined (ACE_DEFAULT_DEV_POLL_EVENT_BATCH)
+#define ACE_DEFAULT_DEV_POLL_EVENT_BATCH 1
+#endif
+
+// Number of submission queue entries of the ACE_Uring_Reactor's ring.
+#if !defined (ACE_DEFAULT_URING_REACTOR_ENTRIES)
+#define ACE_DEFAULT_URING_REACTOR_ENTRIES 1024
+#endif /* ACE_DEFAULT_URING_REACTOR_ENTRIES */
+
+// Number of submission queue entries of the ACE_Uring_Proactor's ring.
+#if !defined (ACE_DEFAULT_URING_PROACTOR_ENTRIES)
+#define ACE_DEFAULT_URING_PROACTOR_ENTRIES 1024
+#endif /* ACE_DEFAULT_URING_PROACTOR_ENTRIES */
+
+// Maximum number of completions an ACE_Uring_Proactor event loop
+// thread reaps at a time.
+#if !defined (ACE_URING_PROACTOR_COMPLETION_BATCH)
+#define ACE_URING_PROACTOR_COMPLETION_BATCH 16
+#endif /* ACE_URING_PROACTOR_COMPLETION_BATCH */
+
 # if !defined (ACE_DEFAULT_TIMEOUT)
 #   define ACE_DEFAULT_TIMEOUT 5
 # endif /* ACE_DEFAULT_TIMEOUT */
@@ -324,6 +346,11 @@
 #   define ACE_DEFAULT_TIMER_WHEEL_RESOLUTION 100
 # endif /* ACE_DEFAULT_TIMER_WHEEL_RESOLUTION */
 
+// Default tick (in microseconds) of the ACE Timer Hierarchical Wheel
+# if !defined (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK)
+#   define ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK 1000
+# endif /* ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK */
+
 // Default size for ACE Timer Hash table
 # if !defined (ACE_DEFAULT_TIMER_HASH_TABLE_SIZE)
 #   define ACE_DEFAULT_TIMER_HASH_TABLE_SIZE 1024
@@ -346,6 +373,29 @@
 #   define ACE_DEFAULT_FREE_LIST_INC 100
 # endif /* ACE_DEFAULT_FREE_LIST_INC */
 
+// Number of chunks a thread caches in each of the two magazines of an
+// ACE_TSS_Cached_Allocator, and moves to or from the shared depot at once
+# if !defined (ACE_DEFAULT_TSS_CACHED_ALLOCATOR_MAGAZINE)
+#   define ACE_DEFAULT_TSS_CACHED_ALLOCATOR_MAGAZINE 32
+# endif /* ACE_DEFAULT_TSS_CACHED_ALLOCATOR_MAGAZINE */
+
+// Largest size class of an ACE_Slab_Allocator, larger requests go to
+// the heap
+# if !defined (ACE_DEFAULT_SLAB_ALLOCATOR_MAX_CHUNK)
+#   define ACE_DEFAULT_SLAB_ALLOCATOR_MAX_CHUNK (64 * 1024)
+# endif /* ACE_DEFAULT_SLAB_ALLOCATOR_MAX_CHUNK */
+
+// Bytes an ACE_Slab_Allocator allocates at once to refill a size class
+# if !defined (ACE_DEFAULT_SLAB_ALLOCATOR_SLAB_SIZE)
+#   define ACE_DEFAULT_SLAB_ALLOCATOR_SLAB_SIZE (64 * 1024)
+# endif /* ACE_DEFAULT_SLAB_ALLOCATOR_SLAB_SIZE */
+
+// Size of the huge pages the memory pools use when asked to map
+// theirs with MAP_HUGETLB
+# if !defined (ACE_DEFAULT_HUGE_PAGE_SIZE)
+#   define ACE_DEFAULT_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+# endif /* ACE_DEFAULT_HUGE_PAGE_SIZE */
+
 # if !defined (ACE_UNIQUE_NAME_LEN)
 #   define ACE_UNIQUE_NAME_LEN 100
 # endif /* ACE_UNIQUE_NAME_LEN */
@@ -356,6 +406,11 @@
 #   define ACE_MAX_DGRAM_SIZE 8192
 # endif /* ACE_MAX_DGRAM_SIZE */
 
+# if !defined (ACE_DEFAULT_DGRAM_BATCH_SIZE)
+   // Number of datagrams an ACE_Dgram_Batch holds by default.
+#   define ACE_DEFAULT_DGRAM_BATCH_SIZE 16
+# endif /* ACE_DEFAULT_DGRAM_BATCH_SIZE */
+
 # if !defined (ACE_DEFAULT_ARGV_BUFSIZ)
 #   define ACE_DEFAULT_ARGV_BUFSIZ 1024 * 4
 # endif /* ACE_DEFAULT_ARGV_BUFSIZ */
@@ -588,5 +643,11 @@
 # define ACE_DEFAULT_ACCEPTOR_USE_SELECT 1
 #endif /* ACE_DEFAULT_ACCEPTOR_USE_SELECT */
 
+// Maximum number of connections an ACE_Acceptor using select accepts
+// per upcall before it returns to the reactor.
+#if !defined (ACE_DEFAULT_ACCEPTOR_MAX_ACCEPTS)
+# define ACE_DEFAULT_ACCEPTOR_MAX_ACCEPTS 64
+#endif /* ACE_DEFAULT_ACCEPTOR_MAX_ACCEPTS */
+
 #include /**/ "ace/post.h"
 #endif /*ACE_DEFAULT_CONSTANTS_H*/
@@ -20,6 +20,10 @@
 #    endif  /* ACE_LINUX */
 # endif  /* ACE_HAS_DEV_POLL */
 
+# if defined (ACE_HAS_EVENT_POLL) && defined (ACE_HAS_TIMERFD)
+#   include /**/ <sys/timerfd.h>
+# endif  /* ACE_HAS_EVENT_POLL && ACE_HAS_TIMERFD */
+
 #if !defined (__ACE_INLINE__)
 # include "ace/Dev_Poll_Reactor.inl"
 #endif /* __ACE_INLINE__ */
@@ -595,6 +599,14 @@ ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (ACE_Sig_Handler *sh,
   , dp_fds_ (0)
   , start_pfds_ (0)
   , end_pfds_ (0)
+#else
+  , events_ (0)
+  , event_batch_ (ACE_DEFAULT_DEV_POLL_EVENT_BATCH)
+  , start_events_ (0)
+  , end_events_ (0)
+  , timer_fd_ (ACE_INVALID_HANDLE)
+  , timer_fd_deadline_ (ACE_Time_Value::zero)
+  , timers_due_ (false)
 #endif  /* ACE_HAS_DEV_POLL */
   , token_ (*this, s_queue)
   , lock_adapter_ (token_)
@@ -630,7 +642,8 @@ ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (size_t size,
                                             int disable_notify_pipe,
                                             ACE_Reactor_Notify *notify,
                                             int mask_signals,
-                                            int s_queue)
+                                            int s_queue,
+                                            int event_batch)
   : initialized_ (false)
   , poll_fd_ (ACE_INVALID_HANDLE)
   // , ready_set_ ()
@@ -638,6 +651,14 @@ ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (size_t size,
   , dp_fds_ (0)
   , start_pfds_ (0)
   , end_pfds_ (0)
+#else
+  , events_ (0)
+  , event_batch_ (event_batch < 1 ? 1 : event_batch)
+  , start_events_ (0)
+  , end_events_ (0)
+  , timer_fd_ (ACE_INVALID_HANDLE)
+  , timer_fd_deadline_ (ACE_Time_Value::zero)
+  , timers_due_ (false)
 #endif  /* ACE_HAS_DEV_POLL */
   , token_ (*this, s_queue)
   , lock_adapter_ (token_)
@@ -663,6 +684,44 @@ ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (size_t size,
                 ACE_TEXT ("failed inside ACE_Dev_Poll_Reactor::CTOR")));
 }
 
+ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (Deferred_Open,
+                                            int mask_signals,
+                                            int s_queue,
+                                            int event_batch)
+  : initialized_ (false)
+  , poll_fd_ (ACE_INVALID_HANDLE)
+#if defined (ACE_HAS_DEV_POLL)
+  , dp_fds_ (0)
+  , start_pfds_ (0)
+  , end_pfds_ (0)
+#else
+  , events_ (0)
+  , event_batch_ (event_batch < 1 ? 1 : event_batch)
+  , start_events_ (0)
+  , end_events_ (0)
+  , timer_fd_ (ACE_INVALID_HANDLE)
+  , timer_fd_deadline_ (ACE_Time_Value::zero)
+  , timers_due_ (false)
+#endif  /* ACE_HAS_DEV_POLL */
+  , token_ (*this, s_queue)
+  , lock_adapter_ (token_)
+  , deactivated_ (0)
+  , timer_queue_ (0)
+  , delete_timer_queue_ (false)
+  , signal_handler_ (0)
+  , delete_signal_handler_ (false)
+  , notify_handler_ (0)
+  , delete_notify_handler_ (false)
+  , mask_signals_ (mask_signals)
+  , restart_ (0)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor");
+
+  // The derived class constructor calls open () once it is fully
+  // constructed, so that its overrides of the poll_*_i () hooks are
+  // the ones used to create and populate the interest set.
+}
+
 ACE_Dev_Poll_Reactor::~ACE_Dev_Poll_Reactor (void)
 {
   ACE_TRACE ("ACE_Dev_Poll_Reactor::~ACE_Dev_Poll_Reactor");
@@ -686,11 +745,6 @@ ACE_Dev_Poll_Reactor::open (size_t size,
   if (this->initialized_)
     return -1;
 
-#ifdef ACE_HAS_EVENT_POLL
-  ACE_OS::memset (&this->event_, 0, sizeof (this->event_));
-  this->event_.data.fd = ACE_INVALID_HANDLE;
-#endif /* ACE_HAS_EVENT_POLL */
-
   this->restart_ = restart;
   this->signal_handler_ = sh;
   this->timer_queue_ = tq;
@@ -739,9 +793,16 @@ ACE_Dev_Poll_Reactor::open (size_t size,
 
 #if defined (ACE_HAS_EVENT_POLL)
 
+  // Allocate the ready list before initializing epoll to avoid a
+  // potential resource leak if allocation fails.
+  ACE_NEW_RETURN (this->events_,
+                  epoll_event[this->event_batch_],
+                  -1);
+  this->start_events_ = this->end_events_ = this->events_;
+
   // Initialize epoll:
-  this->poll_fd_ = ::epoll_create (size);
-  if (this->poll_fd_ == -1)
+  this->poll_fd_ = this->poll_open_i (size);
+  if (this->poll_fd_ == ACE_INVALID_HANDLE)
     result = -1;
 
 #else
@@ -832,6 +893,10 @@ ACE_Dev_Poll_Reactor::close (void)
 
   int result = 0;
 
+#if defined (ACE_HAS_EVENT_POLL)
+  this->close_timer_fd_i ();
+#endif /* ACE_HAS_EVENT_POLL */
+
   if (this->poll_fd_ != ACE_INVALID_HANDLE)
     {
       result = ACE_OS::close (this->poll_fd_);
@@ -839,8 +904,10 @@ ACE_Dev_Poll_Reactor::close (void)
 
 #if defined (ACE_HAS_EVENT_POLL)
 
-  ACE_OS::memset (&this->event_, 0, sizeof (this->event_));
-  this->event_.data.fd = ACE_INVALID_HANDLE;
+  delete [] this->events_;
+  this->events_ = 0;
+  this->start_events_ = 0;
+  this->end_events_ = 0;
 
 #else
 
@@ -923,7 +990,7 @@ ACE_Dev_Poll_Reactor::work_pending_i (ACE_Time_Value * max_wait_time)
     return 0;
 
 #if defined (ACE_HAS_EVENT_POLL)
-  if (this->event_.data.fd != ACE_INVALID_HANDLE)
+  if (this->start_events_ != this->end_events_)
 #else
   if (this->start_pfds_ != this->end_pfds_)
 #endif /* ACE_HAS_EVENT_POLL */
@@ -931,14 +998,35 @@ ACE_Dev_Poll_Reactor::work_pending_i (ACE_Time_Value * max_wait_time)
                // additional events.
 
   ACE_Time_Value timer_buf (0);
-  ACE_Time_Value *this_timeout =
-    this->timer_queue_->calculate_timeout (max_wait_time, &timer_buf);
+  ACE_Time_Value *this_timeout = 0;
+  int timers_pending = 0;
 
-  // Check if we have timers to fire.
-  int const timers_pending =
-    ((this_timeout != 0 && max_wait_time == 0)
-     || (this_timeout != 0 && max_wait_time != 0
-         && *this_timeout != *max_wait_time) ? 1 : 0);
+#if defined (ACE_HAS_EVENT_POLL)
+  if (this->timer_fd_ != ACE_INVALID_HANDLE)
+    {
+      // The timers that are due are expired before waiting again.
+      if (this->timers_due_)
+        return 1;
+
+      // Timer expirations arrive through the timerfd, only the caller's
+      // limit bounds the wait.
+      if (this->arm_timer_fd_i () == -1)
+        return -1;
+
+      this_timeout = max_wait_time;
+    }
+  else
+#endif /* ACE_HAS_EVENT_POLL */
+    {
+      this_timeout =
+        this->timer_queue_->calculate_timeout (max_wait_time, &timer_buf);
+
+      // Check if we have timers to fire.
+      timers_pending =
+        ((this_timeout != 0 && max_wait_time == 0)
+         || (this_timeout != 0 && max_wait_time != 0
+             && *this_timeout != *max_wait_time) ? 1 : 0);
+    }
 
   long const timeout =
     (this_timeout == 0
@@ -947,11 +1035,20 @@ ACE_Dev_Poll_Reactor::work_pending_i (ACE_Time_Value * max_wait_time)
 
 #if defined (ACE_HAS_EVENT_POLL)
 
-  // Wait for an event.
-  int const nfds = ::epoll_wait (this->poll_fd_,
-                                 &this->event_,
-                                 1,
-                                 static_cast<int> (timeout));
+  // Wait for up to event_batch_ events.
+  int const nfds = this->poll_wait_i (this->events_,
+                                      this->event_batch_,
+                                      static_cast<int> (timeout));
+
+  // The ready list is empty while waiting, so nobody looks at the
+  // array while it is being filled.  Publish the new events under the
+  // repository lock, which purge_ready_events_i() relies on.
+  if (nfds > 0)
+    {
+      ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->repo_lock_, -1);
+      this->start_events_ = this->events_;
+      this->end_events_ = this->events_ + nfds;
+    }
 
 #else
 
@@ -1069,8 +1166,19 @@ ACE_Dev_Poll_Reactor::dispatch (Token_Guard &guard)
   // Handle timers early since they may have higher latency
   // constraints than I/O handlers.  Ideally, the order of
   // dispatching should be a strategy...
+#if defined (ACE_HAS_EVENT_POLL)
+  // With a timerfd, the timer queue is only looked at after the timerfd
+  // expired, until no more timers are due.
+  if (this->timer_fd_ == ACE_INVALID_HANDLE || this->timers_due_)
+    {
+      if ((result = this->dispatch_timer_handler (guard)) != 0)
+        return result;
+      this->timers_due_ = false;
+    }
+#else
   if ((result = this->dispatch_timer_handler (guard)) != 0)
     return result;
+#endif /* ACE_HAS_EVENT_POLL */
 
   // If no timer dispatched, check for an I/O event.
   result = this->dispatch_io_event (guard);
@@ -1134,13 +1242,35 @@ ACE_Dev_Poll_Reactor::dispatch_io_event (Token_Guard &guard)
 #endif /* ACE_HAS_EVENT_POLL */
 
 #if defined (ACE_HAS_EVENT_POLL)
-  // epoll_wait() pulls one event which is stored in event_. If the handle
-  // is invalid, there's no event there. Else process it. In any event, we
-  // have the event, so clear event_ for the next thread.
-  const ACE_HANDLE handle = this->event_.data.fd;
-  __uint32_t revents      = this->event_.events;
-  this->event_.data.fd = ACE_INVALID_HANDLE;
-  this->event_.events = 0;
+  // epoll_wait() stores up to event_batch_ events in the ready list.
+  // Take the next one that hasn't been purged off the list; the
+  // remaining ones are left for the followers, which dispatch them
+  // without waiting again. Since the handles are registered with
+  // EPOLLONESHOT, the list holds at most one event per handle.
+  ACE_HANDLE handle = ACE_INVALID_HANDLE;
+  __uint32_t revents = 0;
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->repo_lock_, -1);
+    while (handle == ACE_INVALID_HANDLE
+           && this->start_events_ != this->end_events_)
+      {
+        handle = this->start_events_->data.fd;
+        revents = this->start_events_->events;
+        ++this->start_events_;
+      }
+  }
+
+  // The timerfd isn't in the handler repository.  When it expires,
+  // dispatch the timers that are due instead.
+  if (handle != ACE_INVALID_HANDLE && handle == this->timer_fd_)
+    {
+      this->timer_fd_expired_i ();
+      int const result = this->dispatch_timer_handler (guard);
+      if (result == 0)
+        this->timers_due_ = false;
+      return result;
+    }
+
   if (handle != ACE_INVALID_HANDLE)
 
 #else
@@ -1444,19 +1574,14 @@ ACE_Dev_Poll_Reactor::register_handler_i (ACE_HANDLE handle,
 
      Event_Tuple *info = this->handler_rep_.find (handle);
 
-     struct epoll_event epev;
-     ACE_OS::memset (&epev, 0, sizeof (epev));
-     static const int op = EPOLL_CTL_ADD;
-
-     epev.data.fd = handle;
-     epev.events  = this->reactor_mask_to_poll_event (mask);
+     __uint32_t events = this->reactor_mask_to_poll_event (mask);
      // All but the notify handler get registered with oneshot to facilitate
      // auto suspend before the upcall. See dispatch_io_event for more
      // information.
      if (event_handler != this->notify_handler_)
-       epev.events |= EPOLLONESHOT;
+       events |= EPOLLONESHOT;
 
-     if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+     if (this->poll_ctl_i (EPOLL_CTL_ADD, handle, events) == -1)
        {
          ACELIB_ERROR ((LM_ERROR, ACE_TEXT("%p\n"), ACE_TEXT("epoll_ctl")));
          (void) this->handler_rep_.unbind (handle);
@@ -1641,7 +1766,14 @@ ACE_Dev_Poll_Reactor::remove_handler_i (ACE_HANDLE handle,
   // If there are no longer any outstanding events on the given handle
   // then remove it from the handler repository.
   if (!handle_reg_changed && info->mask == ACE_Event_Handler::NULL_MASK)
-    this->handler_rep_.unbind (handle, requires_reference_counting);
+    {
+#if defined (ACE_HAS_EVENT_POLL)
+      // Events retrieved for the handle but not yet dispatched would
+      // otherwise go to whatever handler is registered for it next.
+      this->purge_ready_events_i (handle);
+#endif /* ACE_HAS_EVENT_POLL */
+      this->handler_rep_.unbind (handle, requires_reference_counting);
+    }
 
   return 0;
 }
@@ -1784,14 +1916,7 @@ ACE_Dev_Poll_Reactor::suspend_handler_i (ACE_HANDLE handle)
 
 #if defined (ACE_HAS_EVENT_POLL)
 
-  struct epoll_event epev;
-  ACE_OS::memset (&epev, 0, sizeof (epev));
-  static const int op = EPOLL_CTL_DEL;
-
-  epev.events  = 0;
-  epev.data.fd = handle;
-
-  if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+  if (this->poll_ctl_i (EPOLL_CTL_DEL, handle, 0) == -1)
     return -1;
   info->controlled = false;
 #else
@@ -1901,15 +2026,13 @@ ACE_Dev_Poll_Reactor::resume_handler_i (ACE_HANDLE handle)
 
 #if defined (ACE_HAS_EVENT_POLL)
 
-  struct epoll_event epev;
-  ACE_OS::memset (&epev, 0, sizeof (epev));
   int op = EPOLL_CTL_ADD;
   if (info->controlled)
     op = EPOLL_CTL_MOD;
-  epev.events  = this->reactor_mask_to_poll_event (mask) | EPOLLONESHOT;
-  epev.data.fd = handle;
+  __uint32_t const events =
+    this->reactor_mask_to_poll_event (mask) | EPOLLONESHOT;
 
-  if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+  if (this->poll_ctl_i (op, handle, events) == -1)
     return -1;
   info->controlled = true;
 
@@ -2013,6 +2136,64 @@ ACE_Dev_Poll_Reactor::cancel_timer (long timer_id,
                                         dont_call_handle_close));
 }
 
+int
+ACE_Dev_Poll_Reactor::use_timer_fd (bool enable)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::use_timer_fd");
+
+#if defined (ACE_HAS_EVENT_POLL) && defined (ACE_HAS_TIMERFD)
+  ACE_MT (ACE_GUARD_RETURN (ACE_Dev_Poll_Reactor_Token, mon, this->token_, -1));
+
+  if (!this->initialized_)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  if (!enable)
+    {
+      this->close_timer_fd_i ();
+      return 0;
+    }
+
+  if (this->timer_fd_ != ACE_INVALID_HANDLE)
+    return 0;
+
+  // Use the monotonic clock, the timerfd is always armed with a delay.
+  ACE_HANDLE const fd =
+    ::timerfd_create (CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (fd == ACE_INVALID_HANDLE)
+    return -1;
+
+  // Like the notification handle, the timerfd stays armed in the
+  // interest set; reading it resets it.
+  if (this->poll_ctl_i (EPOLL_CTL_ADD, fd, EPOLLIN) == -1)
+    {
+      ACE_OS::close (fd);
+      return -1;
+    }
+
+  this->timer_fd_ = fd;
+  this->timer_fd_deadline_ = ACE_Time_Value::zero;
+  this->timers_due_ = false;
+
+  return 0;
+#else
+  ACE_UNUSED_ARG (enable);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_EVENT_POLL && ACE_HAS_TIMERFD */
+}
+
+bool
+ACE_Dev_Poll_Reactor::uses_timer_fd (void) const
+{
+#if defined (ACE_HAS_EVENT_POLL)
+  return this->timer_fd_ != ACE_INVALID_HANDLE;
+#else
+  return false;
+#endif /* ACE_HAS_EVENT_POLL */
+}
+
 int
 ACE_Dev_Poll_Reactor::schedule_wakeup (ACE_Event_Handler *eh,
                                        ACE_Reactor_Mask mask)
@@ -2358,32 +2539,29 @@ ACE_Dev_Poll_Reactor::mask_ops_i (ACE_HANDLE handle,
         return -1;
 #elif defined (ACE_HAS_EVENT_POLL)
 
-      struct epoll_event epev;
-      ACE_OS::memset (&epev, 0, sizeof (epev));
       int op;
+      __uint32_t poll_events;
 
       // ACE_Event_Handler::NULL_MASK ???
       if (new_mask == 0)
         {
           op          = EPOLL_CTL_DEL;
-          epev.events = 0;
+          poll_events = 0;
         }
       else
         {
           op          = EPOLL_CTL_MOD;
-          epev.events = events | EPOLLONESHOT;
+          poll_events = events | EPOLLONESHOT;
         }
 
-      epev.data.fd = handle;
-
-      if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+      if (this->poll_ctl_i (op, handle, poll_events) == -1)
         {
           // If a handle is closed, epoll removes it from the poll set
           // automatically - we may not know about it yet. If that's the
           // case, a mod operation will fail with ENOENT. Retry it as
           // an add. If it's any other failure, just fail outright.
           if (op != EPOLL_CTL_MOD || errno != ENOENT ||
-              ::epoll_ctl (this->poll_fd_, EPOLL_CTL_ADD, handle, &epev) == -1)
+              this->poll_ctl_i (EPOLL_CTL_ADD, handle, poll_events) == -1)
             return -1;
         }
       info->controlled = (op != EPOLL_CTL_DEL);
@@ -2447,10 +2625,140 @@ ACE_Dev_Poll_Reactor::dump (void) const
   ACELIB_DEBUG ((LM_DEBUG,
               ACE_TEXT ("deactivated_ = %d"),
               this->deactivated_));
+#if defined (ACE_HAS_EVENT_POLL)
+  ACELIB_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("event_batch_ = %d"),
+              this->event_batch_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("timer_fd_ = %d"), this->timer_fd_));
+#endif /* ACE_HAS_EVENT_POLL */
   ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
 #endif /* ACE_HAS_DUMP */
 }
 
+#if defined (ACE_HAS_EVENT_POLL)
+ACE_HANDLE
+ACE_Dev_Poll_Reactor::poll_open_i (size_t size)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::poll_open_i");
+
+  return ::epoll_create (size);
+}
+
+int
+ACE_Dev_Poll_Reactor::poll_ctl_i (int op,
+                                  ACE_HANDLE handle,
+                                  __uint32_t events)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::poll_ctl_i");
+
+  struct epoll_event epev;
+  ACE_OS::memset (&epev, 0, sizeof (epev));
+
+  epev.events  = events;
+  epev.data.fd = handle;
+
+  return ::epoll_ctl (this->poll_fd_, op, handle, &epev);
+}
+
+int
+ACE_Dev_Poll_Reactor::poll_wait_i (struct epoll_event *events,
+                                   int max_events,
+                                   int timeout)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::poll_wait_i");
+
+  return ::epoll_wait (this->poll_fd_, events, max_events, timeout);
+}
+
+void
+ACE_Dev_Poll_Reactor::purge_ready_events_i (ACE_HANDLE handle)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::purge_ready_events_i");
+
+  for (struct epoll_event *e = this->start_events_;
+       e != this->end_events_;
+       ++e)
+    if (e->data.fd == handle)
+      e->data.fd = ACE_INVALID_HANDLE;
+}
+
+int
+ACE_Dev_Poll_Reactor::arm_timer_fd_i (void)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::arm_timer_fd_i");
+
+#if defined (ACE_HAS_TIMERFD)
+  ACE_Time_Value const deadline =
+    this->timer_queue_->is_empty ()
+    ? ACE_Time_Value::zero
+    : this->timer_queue_->earliest_time ();
+
+  // Timers scheduled after the earliest one, or that left it the
+  // earliest, don't need a system call.
+  if (deadline == this->timer_fd_deadline_)
+    return 0;
+
+  struct itimerspec its;
+  ACE_OS::memset (&its, 0, sizeof its);
+
+  if (deadline != ACE_Time_Value::zero)
+    {
+      ACE_Time_Value const delay =
+        deadline - this->timer_queue_->gettimeofday ();
+
+      // A zero value would disarm the timerfd, so make a timer that is
+      // already due expire right away.
+      if (delay > ACE_Time_Value::zero)
+        its.it_value = delay;
+      else
+        its.it_value.tv_nsec = 1;
+    }
+
+  if (::timerfd_settime (this->timer_fd_, 0, &its, 0) == -1)
+    return -1;
+
+  this->timer_fd_deadline_ = deadline;
+#endif /* ACE_HAS_TIMERFD */
+
+  return 0;
+}
+
+void
+ACE_Dev_Poll_Reactor::timer_fd_expired_i (void)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::timer_fd_expired_i");
+
+  // Reset the timerfd so that it isn't reported again; the count of
+  // expirations doesn't matter.
+  ACE_UINT64 expirations = 0;
+  (void) ACE_OS::read (this->timer_fd_, &expirations, sizeof expirations);
+
+  this->timer_fd_deadline_ = ACE_Time_Value::zero;
+  this->timers_due_ = true;
+}
+
+void
+ACE_Dev_Poll_Reactor::close_timer_fd_i (void)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::close_timer_fd_i");
+
+  if (this->timer_fd_ == ACE_INVALID_HANDLE)
+    return;
+
+  (void) this->poll_ctl_i (EPOLL_CTL_DEL, this->timer_fd_, 0);
+
+  {
+    ACE_GUARD (ACE_SYNCH_MUTEX, grd, this->repo_lock_);
+    this->purge_ready_events_i (this->timer_fd_);
+  }
+
+  (void) ACE_OS::close (this->timer_fd_);
+  this->timer_fd_ = ACE_INVALID_HANDLE;
+  this->timer_fd_deadline_ = ACE_Time_Value::zero;
+  this->timers_due_ = false;
+}
+#endif /* ACE_HAS_EVENT_POLL */
+
 short
 ACE_Dev_Poll_Reactor::reactor_mask_to_poll_event (ACE_Reactor_Mask mask)
 {
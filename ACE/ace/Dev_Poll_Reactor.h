@@ -425,6 +425,13 @@ public:
    *       parameter is less than the process maximum, the process
    *       maximum will be decreased in order to prevent potential
    *       access violations.
+   *
+   * @a event_batch is the maximum number of events retrieved by a
+   * single @c epoll_wait() call.  They are kept in a ready list from
+   * which the leader thread and its followers take one event each to
+   * dispatch, without waiting again until the list is drained.  The
+   * default of 1 retrieves a single event per wait.  It has no effect
+   * with @c /dev/poll, which always retrieves all ready events.
    */
   ACE_Dev_Poll_Reactor (size_t size,
                         bool restart = false,
@@ -433,7 +440,8 @@ public:
                         int disable_notify_pipe = 0,
                         ACE_Reactor_Notify *notify = 0,
                         int mask_signals = 1,
-                        int s_queue = ACE_DEV_POLL_TOKEN::FIFO);
+                        int s_queue = ACE_DEV_POLL_TOKEN::FIFO,
+                        int event_batch = ACE_DEFAULT_DEV_POLL_EVENT_BATCH);
 
   /// Close down and release all resources.
   virtual ~ACE_Dev_Poll_Reactor (void);
@@ -715,6 +723,31 @@ public:
                             const void **arg = 0,
                             int dont_call_handle_close = 1);
 
+  /// Enable or disable timer expiry through a timerfd.
+  /**
+   * When enabled, a timerfd is registered in the interest set and
+   * programmed to the earliest deadline in the timer queue, so that
+   * timer expirations arrive as ordinary I/O events.  The wait for
+   * events then no longer computes its timeout from the timer queue
+   * and the current time on every iteration; the timerfd is only
+   * re-armed before waiting if the earliest deadline has changed, so
+   * timers scheduled together (e.g., during one upcall) are armed
+   * with a single system call.  Timers also get the nanosecond
+   * resolution of the timerfd instead of the millisecond resolution
+   * of the wait.
+   *
+   * @note The timerfd is armed with the delay to the earliest deadline
+   *       as read from the timer queue, so it doesn't follow changes
+   *       of the system time any more than the wait timeout does.
+   *
+   * @return 0 on success, -1 on failure or if timerfd is not
+   *         supported (ENOTSUP).
+   */
+  int use_timer_fd (bool enable = true);
+
+  /// True if timers expire through a timerfd.
+  bool uses_timer_fd (void) const;
+
   // = High-level event handler scheduling operations
 
   /// Add @a masks_to_be_added to the @a event_handler's entry.
@@ -914,6 +947,21 @@ public:
 
 protected:
 
+  /// Tag type selecting the constructor that does not open the reactor.
+  enum Deferred_Open { DEFERRED_OPEN };
+
+  /// Constructor for derived classes that replace the event
+  /// demultiplexing mechanism.
+  /**
+   * The reactor is not opened; the derived class constructor must call
+   * open() itself so that its overrides of poll_open_i(), poll_ctl_i()
+   * and poll_wait_i() are the ones in effect.
+   */
+  ACE_Dev_Poll_Reactor (Deferred_Open,
+                        int mask_signals,
+                        int s_queue,
+                        int event_batch = ACE_DEFAULT_DEV_POLL_EVENT_BATCH);
+
   class Token_Guard;
 
   /// Non-locking version of wait_pending().
@@ -997,6 +1045,51 @@ protected:
   /// Convert a reactor mask to its corresponding poll() event mask.
   short reactor_mask_to_poll_event (ACE_Reactor_Mask mask);
 
+#if defined (ACE_HAS_EVENT_POLL)
+  /**
+   * @name Interest set hooks
+   *
+   * All interaction with the kernel event demultiplexer goes through
+   * these methods, which allows a derived class to substitute another
+   * mechanism with epoll semantics (one-shot registrations, up to a
+   * given number of events returned per wait).
+   */
+  //@{
+
+  /// Create the interest set able to hold @a size handles.
+  /// Returns the handle of the interest set, or ACE_INVALID_HANDLE.
+  virtual ACE_HANDLE poll_open_i (size_t size);
+
+  /// Perform the @c epoll_ctl() operation @a op (EPOLL_CTL_ADD,
+  /// EPOLL_CTL_MOD or EPOLL_CTL_DEL) for @a handle with the given
+  /// epoll @a events.  Returns 0 on success, -1 on failure.
+  virtual int poll_ctl_i (int op, ACE_HANDLE handle, __uint32_t events);
+
+  /// Wait up to @a timeout milliseconds (-1 is infinite) for events
+  /// and store at most @a max_events of them in @a events.  Returns
+  /// the number of events stored, 0 on timeout, -1 on error.
+  virtual int poll_wait_i (struct epoll_event *events,
+                           int max_events,
+                           int timeout);
+
+  //@}
+
+  /// Drop the events for @a handle that are still on the ready list,
+  /// so that they aren't dispatched to a handler registered for the
+  /// same handle later on.  The repository lock must be held.
+  void purge_ready_events_i (ACE_HANDLE handle);
+
+  /// Program the timerfd to the earliest deadline in the timer queue
+  /// if it isn't already.  The token must be held.
+  int arm_timer_fd_i (void);
+
+  /// Consume an expiration of the timerfd.  The token must be held.
+  void timer_fd_expired_i (void);
+
+  /// Remove the timerfd from the interest set and close it.
+  void close_timer_fd_i (void);
+#endif /* ACE_HAS_EVENT_POLL */
+
 protected:
   /// Has the reactor been initialized.
   bool initialized_;
@@ -1010,12 +1103,38 @@ protected:
   ACE_HANDLE poll_fd_;
 
 #if defined (ACE_HAS_EVENT_POLL)
-  /// Event structure to be filled by epoll_wait. epoll_wait() only gets
-  /// one event at a time and we rely on it's internals for fairness.
-  /// If this struct's fd is ACE_INVALID_HANDLE, the rest is indeterminate.
-  /// If the fd is good, the event is one that's been retrieved by
-  /// epoll_wait() but not yet processed.
-  struct epoll_event event_;
+  /// The ready list: the array epoll_wait() stores up to
+  /// @c event_batch_ events in.  We rely on epoll's internals for
+  /// fairness between the handles.
+  struct epoll_event *events_;
+
+  /// Size of the @c events_ array.
+  int event_batch_;
+
+  /// Pointer to the next ready list element to be dispatched.  An
+  /// element whose fd is ACE_INVALID_HANDLE has been purged and is
+  /// skipped.
+  /**
+   * Both pointers are only changed while holding the token and the
+   * repository lock, so either one is enough to read them.
+   */
+  struct epoll_event *start_events_;
+
+  /// The last element of the ready list plus one.  There is no work
+  /// pending when this->start_events_ == this->end_events_.
+  struct epoll_event *end_events_;
+
+  /// The timerfd timers expire through, or ACE_INVALID_HANDLE if the
+  /// wait timeout is computed from the timer queue instead.
+  ACE_HANDLE timer_fd_;
+
+  /// The deadline the timerfd is armed for, ACE_Time_Value::zero if
+  /// it is disarmed.
+  ACE_Time_Value timer_fd_deadline_;
+
+  /// Set when the timerfd has expired, until the timer queue has no
+  /// more timers due.  Timers are only expired while it is set.
+  bool timers_due_;
 
 #else
   /// The pollfd array that `/dev/poll' will feed its results to.
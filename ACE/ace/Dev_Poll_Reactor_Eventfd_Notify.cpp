@@ -0,0 +1,310 @@
+#include "ace/Dev_Poll_Reactor_Eventfd_Notify.h"
+
+#if defined (ACE_HAS_EVENT_POLL) && defined (ACE_HAS_EVENTFD)
+
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_unistd.h"
+
+#include /**/ <sys/eventfd.h>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Dev_Poll_Reactor_Eventfd_Notify)
+
+ACE_Dev_Poll_Reactor_Eventfd_Notify::ACE_Dev_Poll_Reactor_Eventfd_Notify (void)
+  : eventfd_ (ACE_INVALID_HANDLE)
+  , wakeup_pending_ (0)
+  , head_ (&stub_)
+  , tail_ (&stub_)
+  , purged_head_ (0)
+{
+  this->stub_.next_ = 0;
+}
+
+ACE_Dev_Poll_Reactor_Eventfd_Notify::~ACE_Dev_Poll_Reactor_Eventfd_Notify (void)
+{
+  this->close ();
+}
+
+int
+ACE_Dev_Poll_Reactor_Eventfd_Notify::open (ACE_Reactor_Impl *r,
+                                           ACE_Timer_Queue * /* timer_queue */,
+                                           int disable_notify_pipe)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor_Eventfd_Notify::open");
+
+  if (disable_notify_pipe == 0)
+    {
+      this->dp_reactor_ = dynamic_cast<ACE_Dev_Poll_Reactor *> (r);
+
+      if (this->dp_reactor_ == 0)
+        {
+          errno = EINVAL;
+          return -1;
+        }
+
+      // Non-blocking, since the reactor reads it to find out whether
+      // the wake-up is still pending.
+      this->eventfd_ = ::eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (this->eventfd_ == ACE_INVALID_HANDLE)
+        return -1;
+
+      this->wakeup_pending_ = 0;
+    }
+
+  return 0;
+}
+
+int
+ACE_Dev_Poll_Reactor_Eventfd_Notify::close (void)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor_Eventfd_Notify::close");
+
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->consumer_lock_, -1);
+
+    // All the event handlers still queued had their reference counts
+    // increased, so release them.
+    for (Node *node = this->pop (); node != 0; node = this->pop ())
+      {
+        if (node->buffer_.eh_ != 0)
+          node->buffer_.eh_->remove_reference ();
+        delete node;
+      }
+  }
+
+  int result = 0;
+  if (this->eventfd_ != ACE_INVALID_HANDLE)
+    {
+      result = ACE_OS::close (this->eventfd_);
+      this->eventfd_ = ACE_INVALID_HANDLE;
+    }
+
+  return result;
+}
+
+int
+ACE_Dev_Poll_Reactor_Eventfd_Notify::notify (ACE_Event_Handler *eh,
+                                             ACE_Reactor_Mask mask,
+                                             ACE_Time_Value * /* timeout */)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor_Eventfd_Notify::notify");
+
+  // Just consider this method a "no-op" if there's no
+  // ACE_Dev_Poll_Reactor configured.
+  if (this->dp_reactor_ == 0)
+    return 0;
+
+  ACE_Dev_Poll_Handler_Guard eh_guard (eh);
+
+  Node *node = 0;
+  ACE_NEW_RETURN (node, Node, -1);   // Also decrement eh's reference count
+  node->buffer_.eh_ = eh;
+  node->buffer_.mask_ = mask;
+
+  this->push (node);
+
+  // The notification has been queued, so it will be delivered at some
+  // point (and may have been already); release the refcnt guard.
+  eh_guard.release ();
+
+  return this->wakeup ();
+}
+
+ACE_HANDLE
+ACE_Dev_Poll_Reactor_Eventfd_Notify::notify_handle (void)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor_Eventfd_Notify::notify_handle");
+
+  return this->eventfd_;
+}
+
+int
+ACE_Dev_Poll_Reactor_Eventfd_Notify::read_notify_pipe (
+  ACE_HANDLE /* handle */,
+  ACE_Notification_Buffer &buffer)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor_Eventfd_Notify::read_notify_pipe");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->consumer_lock_, -1);
+
+  Node *node = this->pop ();
+  if (node != 0)
+    {
+      // The eventfd is left readable, so the reactor comes back for
+      // the next one.
+      buffer = node->buffer_;
+      delete node;
+      return 1;
+    }
+
+  // Nothing to dispatch.  Reset the eventfd, then let the next notify()
+  // write to it again.  A notify() that queued its notification after
+  // the pop() above but saw the wake-up still pending has not written
+  // to the eventfd, so check once more and wake ourselves up if so.
+  ACE_UINT64 count = 0;
+  if (ACE_OS::read (this->eventfd_, &count, sizeof count) == -1
+      && errno != EWOULDBLOCK && errno != EAGAIN)
+    return -1;
+
+  __atomic_store_n (&this->wakeup_pending_, 0, __ATOMIC_SEQ_CST);
+
+  if (!this->empty () && this->wakeup () == -1)
+    return -1;
+
+  return 0;
+}
+
+int
+ACE_Dev_Poll_Reactor_Eventfd_Notify::purge_pending_notifications (
+  ACE_Event_Handler *eh,
+  ACE_Reactor_Mask mask)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor_Eventfd_Notify::purge_pending_notifications");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->consumer_lock_, -1);
+
+  // The queue can only be unlinked from its head, so move everything
+  // queued so far to the purged list and edit that instead.
+  Node *queued = 0;
+  while (this->purged_head_ != 0 || !this->empty ())
+    {
+      Node *node = this->pop ();
+      if (node == 0)
+        break;  // A producer is still linking its node.
+      node->next_ = queued;
+      queued = node;
+    }
+
+  // Nodes were popped oldest first, so queued is newest first.
+  Node *kept = 0;
+  int number_purged = 0;
+  while (queued != 0)
+    {
+      Node *node = queued;
+      queued = node->next_;
+
+      ACE_Notification_Buffer &b = node->buffer_;
+      if (b.eh_ != 0 && (eh == 0 || eh == b.eh_))
+        {
+          if (ACE_BIT_DISABLED (b.mask_, ~mask))
+            {
+              ++number_purged;
+              b.eh_->remove_reference ();
+              delete node;
+              continue;
+            }
+
+          ACE_CLR_BITS (b.mask_, mask);
+        }
+
+      node->next_ = kept;
+      kept = node;
+    }
+
+  this->purged_head_ = kept;
+
+  return number_purged;
+}
+
+void
+ACE_Dev_Poll_Reactor_Eventfd_Notify::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Dev_Poll_Reactor_Eventfd_Notify::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("dp_reactor_ = %@"),
+              this->dp_reactor_));
+  ACELIB_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("eventfd_ = %d"),
+              this->eventfd_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+void
+ACE_Dev_Poll_Reactor_Eventfd_Notify::push (Node *node)
+{
+  // Publish the node by swapping it in as the tail, then link the
+  // previous tail to it.  Between the two, the consumer sees the queue
+  // end at the previous tail.
+  __atomic_store_n (&node->next_, static_cast<Node *> (0), __ATOMIC_RELAXED);
+  Node * const prev = __atomic_exchange_n (&this->tail_, node, __ATOMIC_ACQ_REL);
+  __atomic_store_n (&prev->next_, node, __ATOMIC_RELEASE);
+}
+
+ACE_Dev_Poll_Reactor_Eventfd_Notify::Node *
+ACE_Dev_Poll_Reactor_Eventfd_Notify::pop (void)
+{
+  if (this->purged_head_ != 0)
+    {
+      Node * const node = this->purged_head_;
+      this->purged_head_ = node->next_;
+      return node;
+    }
+
+  Node *head = this->head_;
+  Node *next = __atomic_load_n (&head->next_, __ATOMIC_ACQUIRE);
+
+  // Skip the stub.
+  if (head == &this->stub_)
+    {
+      if (next == 0)
+        return 0;
+      this->head_ = next;
+      head = next;
+      next = __atomic_load_n (&head->next_, __ATOMIC_ACQUIRE);
+    }
+
+  if (next != 0)
+    {
+      this->head_ = next;
+      return head;
+    }
+
+  // head is the last node linked.  If another one is being pushed it
+  // can't be unlinked yet; otherwise push the stub behind it so that
+  // the queue never becomes empty.
+  if (head != __atomic_load_n (&this->tail_, __ATOMIC_ACQUIRE))
+    return 0;
+
+  this->push (&this->stub_);
+
+  next = __atomic_load_n (&head->next_, __ATOMIC_ACQUIRE);
+  if (next != 0)
+    {
+      this->head_ = next;
+      return head;
+    }
+
+  return 0;
+}
+
+bool
+ACE_Dev_Poll_Reactor_Eventfd_Notify::empty (void) const
+{
+  return this->purged_head_ == 0
+    && this->head_ == &this->stub_
+    && __atomic_load_n (&this->tail_, __ATOMIC_SEQ_CST) == &this->stub_;
+}
+
+int
+ACE_Dev_Poll_Reactor_Eventfd_Notify::wakeup (void)
+{
+  if (__atomic_exchange_n (&this->wakeup_pending_, 1, __ATOMIC_SEQ_CST) != 0)
+    return 0;
+
+  ACE_UINT64 const one = 1;
+  if (ACE_OS::write (this->eventfd_, &one, sizeof one) == -1)
+    return -1;
+
+  return 0;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* ACE_HAS_EVENT_POLL && ACE_HAS_EVENTFD */
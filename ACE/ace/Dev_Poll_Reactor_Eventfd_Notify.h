@@ -0,0 +1,158 @@
+// -*- C++ -*-
+
+// =========================================================================
+/**
+ *  @file    Dev_Poll_Reactor_Eventfd_Notify.h
+ *
+ *  @c eventfd based notification strategy for the ACE_Dev_Poll_Reactor.
+ */
+// =========================================================================
+
+#ifndef ACE_DEV_POLL_REACTOR_EVENTFD_NOTIFY_H
+#define ACE_DEV_POLL_REACTOR_EVENTFD_NOTIFY_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+
+#if defined (ACE_HAS_EVENT_POLL) && defined (ACE_HAS_EVENTFD)
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Dev_Poll_Reactor_Eventfd_Notify
+ *
+ * @brief Notification strategy for the ACE_Dev_Poll_Reactor that
+ *        queues notifications in user space and wakes the reactor
+ *        through an @c eventfd.
+ *
+ * The default ACE_Dev_Poll_Reactor_Notify writes every notification
+ * to a pipe (or pushes it onto a locked ACE_Notification_Queue).
+ * This strategy instead links each notification onto an intrusive
+ * multi-producer, single-consumer queue with one atomic exchange, so
+ * notify() takes no lock.  Wake-ups are coalesced: only the first
+ * notification queued after the reactor found the queue empty writes
+ * to the @c eventfd; the others find the reactor already woken.
+ *
+ * The strategy is selected per reactor by passing an instance as the
+ * @c notify argument of the ACE_Dev_Poll_Reactor (or a derived
+ * reactor) constructor.  It is not owned by the reactor and must
+ * outlive it.
+ *
+ * Dequeuing and purge_pending_notifications() are serialized by a
+ * lock that notify() never takes.
+ */
+class ACE_Export ACE_Dev_Poll_Reactor_Eventfd_Notify
+  : public ACE_Dev_Poll_Reactor_Notify
+{
+public:
+  /// Constructor
+  ACE_Dev_Poll_Reactor_Eventfd_Notify (void);
+
+  /// Destructor
+  virtual ~ACE_Dev_Poll_Reactor_Eventfd_Notify (void);
+
+  virtual int open (ACE_Reactor_Impl *,
+                    ACE_Timer_Queue *timer_queue = 0,
+                    int disable_notify = 0);
+  virtual int close (void);
+
+  /// Queue a notification and wake up the reactor if it may have
+  /// seen the queue empty.  @a timeout is ignored since this never
+  /// blocks.
+  virtual int notify (ACE_Event_Handler *eh = 0,
+                      ACE_Reactor_Mask mask = ACE_Event_Handler::EXCEPT_MASK,
+                      ACE_Time_Value *timeout = 0);
+
+  /// Returns the @c eventfd the reactor waits on.
+  virtual ACE_HANDLE notify_handle (void);
+
+  /// Dequeue one notification into @a buffer.  Returns 1 if one was
+  /// dequeued, 0 if the queue is empty (in which case the @c eventfd
+  /// is reset) and -1 on error.
+  virtual int read_notify_pipe (ACE_HANDLE handle,
+                                ACE_Notification_Buffer &buffer);
+
+  /**
+   * Purge any notifications pending in this reactor for the specified
+   * ACE_Event_Handler object. Returns the number of notifications
+   * purged. Returns -1 on error.
+   */
+  virtual int purge_pending_notifications (
+    ACE_Event_Handler * = 0,
+    ACE_Reactor_Mask    = ACE_Event_Handler::ALL_EVENTS_MASK);
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// A queued notification.
+  struct Node
+  {
+    ACE_Notification_Buffer buffer_;
+    Node *next_;
+  };
+
+  /// Link @a node at the tail of the queue.  May be called by any
+  /// number of threads at a time.
+  void push (Node *node);
+
+  /// Unlink the node at the head of the queue, or return 0 if there
+  /// is none or the producer that linked it hasn't finished yet.
+  /// Must be called with @c consumer_lock_ held.
+  Node *pop (void);
+
+  /// Return true if no node has been pushed since the last pop().
+  /// Must be called with @c consumer_lock_ held.
+  bool empty (void) const;
+
+  /// Write to the @c eventfd unless another thread already did since
+  /// the reactor last found the queue empty.
+  int wakeup (void);
+
+private:
+  /// The @c eventfd the reactor waits on.
+  ACE_HANDLE eventfd_;
+
+  /// Nonzero while the @c eventfd has been written to and the queue
+  /// hasn't been found empty since.
+  long wakeup_pending_;
+
+  /// Node kept in the queue so that head and tail never are null.
+  Node stub_;
+
+  /// Next node to be dequeued; only used by the consumer.
+  Node *head_;
+
+  /// Last node queued; exchanged by the producers.
+  Node *tail_;
+
+  /// Notifications moved off the queue by purge_pending_notifications()
+  /// that still have to be dispatched, oldest first.
+  Node *purged_head_;
+
+  /// Serializes the consumers.
+  ACE_SYNCH_MUTEX consumer_lock_;
+
+  // = Disallow copying and assignment.
+  ACE_UNIMPLEMENTED_FUNC (ACE_Dev_Poll_Reactor_Eventfd_Notify (const ACE_Dev_Poll_Reactor_Eventfd_Notify &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Dev_Poll_Reactor_Eventfd_Notify &operator= (const ACE_Dev_Poll_Reactor_Eventfd_Notify &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* ACE_HAS_EVENT_POLL && ACE_HAS_EVENTFD */
+
+#include /**/ "ace/post.h"
+
+#endif  /* ACE_DEV_POLL_REACTOR_EVENTFD_NOTIFY_H */
@@ -0,0 +1,288 @@
+#include "ace/Dgram_Batch.h"
+#include "ace/OS_NS_sys_socket.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_Memory.h"
+#include "ace/Malloc.h"
+#include "ace/Log_Category.h"
+
+#if defined (ACE_HAS_UDP_GRO)
+#  include /**/ <netinet/udp.h>
+#endif /* ACE_HAS_UDP_GRO */
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Dgram_Batch.inl"
+#endif /* __ACE_INLINE__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE (ACE_Dgram_Batch)
+
+ACE_Dgram_Batch::ACE_Dgram_Batch (size_t capacity, size_t buffer_size)
+  : capacity_ (0),
+    size_ (0),
+    msgs_ (0),
+    iov_ (0),
+    buffers_ (0),
+    addrs_ (0),
+    buffer_space_ (0)
+#if defined (ACE_HAS_UDP_GRO)
+  , controls_ (0)
+#endif /* ACE_HAS_UDP_GRO */
+{
+  ACE_TRACE ("ACE_Dgram_Batch::ACE_Dgram_Batch");
+
+  ACE_NEW (this->msgs_, ACE_mmsghdr[capacity]);
+  ACE_NEW (this->iov_, iovec[capacity]);
+  ACE_NEW (this->buffers_, iovec[capacity]);
+  ACE_NEW (this->addrs_, Dgram_Addr[capacity]);
+#if defined (ACE_HAS_UDP_GRO)
+  ACE_NEW (this->controls_, Dgram_Control[capacity]);
+#endif /* ACE_HAS_UDP_GRO */
+
+  // Keep every buffer aligned like the first one.
+  size_t const stride = ACE_MALLOC_ROUNDUP (buffer_size, ACE_MALLOC_ALIGN);
+  if (stride > 0)
+    ACE_NEW (this->buffer_space_, char[capacity * stride]);
+
+  for (size_t i = 0; i < capacity; ++i)
+    this->buffer (i,
+                  this->buffer_space_ ? this->buffer_space_ + i * stride : 0,
+                  this->buffer_space_ ? buffer_size : 0);
+
+  this->capacity_ = capacity;
+}
+
+ACE_Dgram_Batch::~ACE_Dgram_Batch (void)
+{
+  ACE_TRACE ("ACE_Dgram_Batch::~ACE_Dgram_Batch");
+
+#if defined (ACE_HAS_UDP_GRO)
+  delete [] this->controls_;
+#endif /* ACE_HAS_UDP_GRO */
+  delete [] this->buffer_space_;
+  delete [] this->addrs_;
+  delete [] this->buffers_;
+  delete [] this->iov_;
+  delete [] this->msgs_;
+}
+
+void
+ACE_Dgram_Batch::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Dgram_Batch::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("capacity_ = %B\n"), this->capacity_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("size_ = %B\n"), this->size_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+void
+ACE_Dgram_Batch::init_msg (size_t i, iovec *iov, int iovcnt, int namelen)
+{
+#if defined (ACE_HAS_MSG)
+  msghdr &msg = this->msgs_[i].msg_hdr;
+
+  msg.msg_iov = iov;
+  msg.msg_iovlen = iovcnt;
+# if defined (ACE_HAS_SOCKADDR_MSG_NAME)
+  msg.msg_name = namelen ? (struct sockaddr *) &this->addrs_[i] : 0;
+# else
+  msg.msg_name = namelen ? (char *) &this->addrs_[i] : 0;
+# endif /* ACE_HAS_SOCKADDR_MSG_NAME */
+  msg.msg_namelen = namelen;
+
+# if defined (ACE_HAS_4_4BSD_SENDMSG_RECVMSG)
+  msg.msg_control = 0;
+  msg.msg_controllen = 0;
+  msg.msg_flags = 0;
+# elif defined (ACE_WIN32)
+  msg.msg_control = 0;
+  msg.msg_controllen = 0;
+# elif !defined ACE_LACKS_SENDMSG
+  msg.msg_accrights = 0;
+  msg.msg_accrightslen = 0;
+# endif /* ACE_HAS_4_4BSD_SENDMSG_RECVMSG */
+#else
+  ACE_UNUSED_ARG (iov);
+  ACE_UNUSED_ARG (iovcnt);
+  ACE_UNUSED_ARG (namelen);
+#endif /* ACE_HAS_MSG */
+
+  this->msgs_[i].msg_len = 0;
+}
+
+size_t
+ACE_Dgram_Batch::segment_size (size_t i) const
+{
+#if defined (ACE_HAS_UDP_GRO)
+  msghdr *msg = const_cast<msghdr *> (&this->msgs_[i].msg_hdr);
+  if (msg->msg_control != 0)
+    for (cmsghdr *cmsg = ACE_CMSG_FIRSTHDR (msg);
+         cmsg != 0;
+         cmsg = ACE_CMSG_NXTHDR (msg, cmsg))
+      if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+        {
+          int gso_size = 0;
+          ACE_OS::memcpy (&gso_size, ACE_CMSG_DATA (cmsg), sizeof gso_size);
+          return static_cast<size_t> (gso_size);
+        }
+#endif /* ACE_HAS_UDP_GRO */
+
+  return this->length (i);
+}
+
+int
+ACE_Dgram_Batch::add (const void *buf, size_t n, const ACE_Addr &addr)
+{
+  if (this->size_ == this->capacity_)
+    {
+      errno = ENOSPC;
+      return -1;
+    }
+
+  iovec &iov = this->iov_[this->size_];
+  iov.iov_base = (char *) buf;
+  iov.iov_len = n;
+  return this->add (&iov, 1, addr);
+}
+
+int
+ACE_Dgram_Batch::add (const iovec iov[], int n, const ACE_Addr &addr)
+{
+  ACE_TRACE ("ACE_Dgram_Batch::add");
+
+  if (this->size_ == this->capacity_)
+    {
+      errno = ENOSPC;
+      return -1;
+    }
+
+  int namelen = 0;
+  if (addr != ACE_Addr::sap_any)
+    {
+      namelen = addr.get_size ();
+      if (namelen < 0 || static_cast<size_t> (namelen) > sizeof (Dgram_Addr))
+        {
+          errno = EINVAL;
+          return -1;
+        }
+      ACE_OS::memcpy (&this->addrs_[this->size_], addr.get_addr (), namelen);
+    }
+
+  this->init_msg (this->size_, const_cast<iovec *> (iov), n, namelen);
+  ++this->size_;
+  return 0;
+}
+
+ssize_t
+ACE_Dgram_Batch::recv (ACE_HANDLE handle, int flags)
+{
+  ACE_TRACE ("ACE_Dgram_Batch::recv");
+
+#if defined (ACE_HAS_MSG)
+  this->size_ = 0;
+  for (size_t i = 0; i < this->capacity_; ++i)
+    {
+      this->iov_[i] = this->buffers_[i];
+      this->init_msg (i, &this->iov_[i], 1, sizeof (Dgram_Addr));
+# if defined (ACE_HAS_UDP_GRO)
+      this->msgs_[i].msg_hdr.msg_control = &this->controls_[i];
+      this->msgs_[i].msg_hdr.msg_controllen = sizeof (Dgram_Control);
+# endif /* ACE_HAS_UDP_GRO */
+    }
+
+# if defined (ACE_HAS_RECVMMSG)
+  int const received =
+    ACE_OS::recvmmsg (handle,
+                      this->msgs_,
+                      static_cast<unsigned int> (this->capacity_),
+                      flags | MSG_WAITFORONE);
+  if (received != -1 || errno != ENOSYS)
+    {
+      if (received > 0)
+        this->size_ = received;
+      return received;
+    }
+# endif /* ACE_HAS_RECVMMSG */
+
+  // One datagram per system call; after the first, only take those
+  // that are already queued.
+  while (this->size_ < this->capacity_)
+    {
+      ACE_mmsghdr &msg = this->msgs_[this->size_];
+# if defined (MSG_DONTWAIT)
+      int const next_flags = this->size_ == 0 ? flags : flags | MSG_DONTWAIT;
+# else
+      int const next_flags = flags;
+# endif /* MSG_DONTWAIT */
+      ssize_t const n = ACE_OS::recvmsg (handle, &msg.msg_hdr, next_flags);
+      if (n == -1)
+        return this->size_ == 0 ? -1 : static_cast<ssize_t> (this->size_);
+
+      msg.msg_len = static_cast<unsigned int> (n);
+      ++this->size_;
+# if !defined (MSG_DONTWAIT)
+      break;
+# endif /* !MSG_DONTWAIT */
+    }
+
+  return static_cast<ssize_t> (this->size_);
+#else
+  ACE_UNUSED_ARG (handle);
+  ACE_UNUSED_ARG (flags);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_MSG */
+}
+
+ssize_t
+ACE_Dgram_Batch::send (ACE_HANDLE handle, int flags, const ACE_Addr *to)
+{
+  ACE_TRACE ("ACE_Dgram_Batch::send");
+
+#if defined (ACE_HAS_MSG)
+  if (to != 0)
+    for (size_t i = 0; i < this->size_; ++i)
+      {
+        msghdr &msg = this->msgs_[i].msg_hdr;
+# if defined (ACE_HAS_SOCKADDR_MSG_NAME)
+        msg.msg_name = (struct sockaddr *) to->get_addr ();
+# else
+        msg.msg_name = (char *) to->get_addr ();
+# endif /* ACE_HAS_SOCKADDR_MSG_NAME */
+        msg.msg_namelen = to->get_size ();
+      }
+
+# if defined (ACE_HAS_SENDMMSG)
+  int const sent =
+    ACE_OS::sendmmsg (handle,
+                      this->msgs_,
+                      static_cast<unsigned int> (this->size_),
+                      flags);
+  if (sent != -1 || errno != ENOSYS)
+    return sent;
+# endif /* ACE_HAS_SENDMMSG */
+
+  for (size_t i = 0; i < this->size_; ++i)
+    {
+      ssize_t const n =
+        ACE_OS::sendmsg (handle, &this->msgs_[i].msg_hdr, flags);
+      if (n == -1)
+        return i == 0 ? -1 : static_cast<ssize_t> (i);
+
+      this->msgs_[i].msg_len = static_cast<unsigned int> (n);
+    }
+
+  return static_cast<ssize_t> (this->size_);
+#else
+  ACE_UNUSED_ARG (handle);
+  ACE_UNUSED_ARG (flags);
+  ACE_UNUSED_ARG (to);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_MSG */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,171 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Dgram_Batch.h
+ */
+//=============================================================================
+
+#ifndef ACE_DGRAM_BATCH_H
+#define ACE_DGRAM_BATCH_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/INET_Addr.h"
+#include "ace/Default_Constants.h"
+#include "ace/os_include/sys/os_socket.h"
+#include "ace/os_include/sys/os_uio.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Dgram_Batch
+ *
+ * @brief A reusable vector of datagrams that ACE_SOCK_Dgram and
+ * ACE_SOCK_CODgram receive or send with one system call, using
+ * @c recvmmsg and @c sendmmsg where the platform has them.
+ *
+ * For receiving, every datagram of the batch has a buffer: either one
+ * of @a buffer_size bytes allocated with the batch, aligned on
+ * ACE_MALLOC_ALIGN, or one set with buffer().  A receive fills the
+ * batch from the front; size() tells how many datagrams it holds and
+ * data(), length() and addr() give access to them.
+ *
+ * For sending, reset() empties the batch and add() appends datagrams.
+ * Their data isn't copied and must stay valid until they are sent.
+ */
+class ACE_Export ACE_Dgram_Batch
+{
+public:
+  /// Create a batch of @a capacity datagrams.  A @a buffer_size of 0
+  /// allocates no receive buffers.
+  explicit ACE_Dgram_Batch (size_t capacity = ACE_DEFAULT_DGRAM_BATCH_SIZE,
+                            size_t buffer_size = ACE_MAX_DGRAM_SIZE);
+
+  ~ACE_Dgram_Batch (void);
+
+  /// Number of datagrams the batch can hold; 0 if it couldn't be
+  /// allocated.
+  size_t capacity (void) const;
+
+  /// Number of datagrams received by the last receive or added since
+  /// the last reset().
+  size_t size (void) const;
+
+  /// Receive datagram @a i into the @a n bytes at @a buf.
+  void buffer (size_t i, void *buf, size_t n);
+
+  /// Start of received datagram @a i.
+  char *data (size_t i) const;
+
+  /// Length of received datagram @a i.
+  size_t length (size_t i) const;
+
+  /// Size of the datagrams coalesced into received datagram @a i, the
+  /// last one possibly shorter, once ACE_SOCK_Dgram::enable_gro() was
+  /// called; length() if it holds a single datagram.
+  size_t segment_size (size_t i) const;
+
+  /// Set @a addr to the address datagram @a i was received from.
+  void addr (size_t i, ACE_INET_Addr &addr) const;
+
+  /// Empty the batch before adding datagrams to send.
+  void reset (void);
+
+  /**
+   * Add a datagram of the @a n bytes at @a buf to be sent to @a addr,
+   * which may be ACE_Addr::sap_any for connected sockets.  Returns -1
+   * with @c ENOSPC if the batch is full.
+   */
+  int add (const void *buf, size_t n, const ACE_Addr &addr);
+
+  /// Add a datagram gathered from the @a n buffers of @a iov, which
+  /// must stay valid until it's sent.
+  int add (const iovec iov[], int n, const ACE_Addr &addr);
+
+  /**
+   * Receive datagrams from @a handle into the batch.  Blocks, unless
+   * @a handle is non-blocking, until one datagram arrives and then
+   * takes those already queued, up to capacity().  Returns the number
+   * of datagrams received or -1 on error.
+   */
+  ssize_t recv (ACE_HANDLE handle, int flags = 0);
+
+  /**
+   * Send the datagrams of the batch through @a handle, to @a to if it
+   * isn't 0 or else to the address each was added with.  Returns the
+   * number of datagrams sent, which is less than size() if sending the
+   * next one failed, or -1 if none was sent.
+   */
+  ssize_t send (ACE_HANDLE handle, int flags = 0, const ACE_Addr *to = 0);
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  /// Point datagram @a i at @a iov and its address.
+  void init_msg (size_t i, iovec *iov, int iovcnt, int namelen);
+
+  ACE_Dgram_Batch (const ACE_Dgram_Batch &);
+  ACE_Dgram_Batch &operator= (const ACE_Dgram_Batch &);
+
+  /// Source or destination address of a datagram.
+  union Dgram_Addr
+  {
+    sockaddr_in in4_;
+#if defined (ACE_HAS_IPV6)
+    sockaddr_in6 in6_;
+#endif /* ACE_HAS_IPV6 */
+  };
+
+  /// Number of datagrams the batch can hold.
+  size_t capacity_;
+
+  /// Number of datagrams in the batch.
+  size_t size_;
+
+  /// The message vector passed to the system.
+  ACE_mmsghdr *msgs_;
+
+  /// The data of each datagram added by the single buffer add(), and
+  /// the receive buffer of each datagram during a receive.
+  iovec *iov_;
+
+  /// Receive buffer of each datagram.
+  iovec *buffers_;
+
+  /// Address of each datagram.
+  Dgram_Addr *addrs_;
+
+  /// Receive buffers allocated with the batch.
+  char *buffer_space_;
+
+#if defined (ACE_HAS_UDP_GRO)
+  /// Ancillary data of a received datagram, carrying its segment size.
+  union Dgram_Control
+  {
+    cmsghdr header_;
+    u_char space_[ACE_CMSG_SPACE (sizeof (int))];
+  };
+
+  /// Ancillary data of each datagram.
+  Dgram_Control *controls_;
+#endif /* ACE_HAS_UDP_GRO */
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Dgram_Batch.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_DGRAM_BATCH_H */
@@ -0,0 +1,48 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE size_t
+ACE_Dgram_Batch::capacity (void) const
+{
+  return this->capacity_;
+}
+
+ACE_INLINE size_t
+ACE_Dgram_Batch::size (void) const
+{
+  return this->size_;
+}
+
+ACE_INLINE void
+ACE_Dgram_Batch::buffer (size_t i, void *buf, size_t n)
+{
+  this->buffers_[i].iov_base = static_cast<char *> (buf);
+  this->buffers_[i].iov_len = n;
+}
+
+ACE_INLINE char *
+ACE_Dgram_Batch::data (size_t i) const
+{
+  return static_cast<char *> (this->buffers_[i].iov_base);
+}
+
+ACE_INLINE size_t
+ACE_Dgram_Batch::length (size_t i) const
+{
+  return this->msgs_[i].msg_len;
+}
+
+ACE_INLINE void
+ACE_Dgram_Batch::addr (size_t i, ACE_INET_Addr &addr) const
+{
+  addr.set_addr (&this->addrs_[i],
+                 static_cast<int> (this->msgs_[i].msg_hdr.msg_namelen));
+}
+
+ACE_INLINE void
+ACE_Dgram_Batch::reset (void)
+{
+  this->size_ = 0;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
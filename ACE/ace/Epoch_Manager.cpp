@@ -0,0 +1,139 @@
+#include "ace/Epoch_Manager.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_string.h"
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Epoch_Manager.inl"
+#endif /* __ACE_INLINE__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Epoch_Manager)
+
+ACE_Epoch_Manager::ACE_Epoch_Manager (void *cleanup_param)
+  : epoch_ (0),
+    retired_ (0),
+    reclaimed_ (0),
+    cleanup_param_ (cleanup_param)
+{
+  ACE_OS::memset (this->slots_, 0, sizeof (this->slots_));
+  for (int i = 0; i < EPOCHS; ++i)
+    this->limbo_[i] = 0;
+}
+
+ACE_Epoch_Manager::~ACE_Epoch_Manager (void)
+{
+  this->reclaim_all ();
+}
+
+void
+ACE_Epoch_Manager::retire (ACE_Epoch_Node *node, ACE_CLEANUP_FUNC cleanup)
+{
+  node->epoch_cleanup_ = cleanup;
+
+  // The node was unlinked before this point, so a reader that enters
+  // in a later epoch than the one read here can't see it.
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+  ACE_UINT64 const epoch = __atomic_load_n (&this->epoch_, __ATOMIC_SEQ_CST);
+
+  // Only whole lists are ever taken off, so pushing doesn't suffer
+  // from ABA.  A node pushed late, after its list was taken for a
+  // newer epoch, is just reclaimed later than it could have been.
+  ACE_Epoch_Node **const head = &this->limbo_[epoch % EPOCHS];
+  ACE_Epoch_Node *next = __atomic_load_n (head, __ATOMIC_RELAXED);
+  do
+    node->epoch_next_ = next;
+  while (!__atomic_compare_exchange_n (head,
+                                       &next,
+                                       node,
+                                       true,
+                                       __ATOMIC_RELEASE,
+                                       __ATOMIC_RELAXED));
+
+  if (__atomic_add_fetch (&this->retired_, 1, __ATOMIC_RELAXED)
+      % ACE_EPOCH_MANAGER_RECLAIM_INTERVAL == 0)
+    this->reclaim ();
+}
+
+size_t
+ACE_Epoch_Manager::reclaim (void)
+{
+  // Don't wait for another thread that is advancing the epoch.
+  ACE_Guard<ACE_Thread_Mutex> guard (this->reclaim_lock_, 0);
+  if (!guard.locked ())
+    return 0;
+
+  // Only this thread changes the epoch while it holds the lock.
+  ACE_UINT64 const epoch = __atomic_load_n (&this->epoch_, __ATOMIC_RELAXED);
+  u_long const previous = static_cast<u_long> ((epoch + EPOCHS - 1) % EPOCHS);
+
+  for (int i = 0; i < ACE_EPOCH_MANAGER_SLOTS; ++i)
+    if (__atomic_load_n (&this->slots_[i].count_[previous],
+                         __ATOMIC_SEQ_CST) != 0)
+      return 0;
+
+  __atomic_store_n (&this->epoch_, epoch + 1, __ATOMIC_SEQ_CST);
+
+  // The readers that could reach the nodes retired in epoch - 1 have
+  // all left, and the ones to come won't find them.
+  ACE_Epoch_Node *const list =
+    __atomic_exchange_n (&this->limbo_[previous],
+                         static_cast<ACE_Epoch_Node *> (0),
+                         __ATOMIC_ACQUIRE);
+  return this->reclaim_i (list);
+}
+
+size_t
+ACE_Epoch_Manager::reclaim_all (void)
+{
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->reclaim_lock_, 0);
+
+  size_t count = 0;
+  for (int i = 0; i < EPOCHS; ++i)
+    count +=
+      this->reclaim_i (__atomic_exchange_n (&this->limbo_[i],
+                                            static_cast<ACE_Epoch_Node *> (0),
+                                            __ATOMIC_ACQUIRE));
+  return count;
+}
+
+size_t
+ACE_Epoch_Manager::reclaim_i (ACE_Epoch_Node *list)
+{
+  size_t count = 0;
+  while (list != 0)
+    {
+      ACE_Epoch_Node *const node = list;
+      list = node->epoch_next_;
+      (*node->epoch_cleanup_) (node, this->cleanup_param_);
+      ++count;
+    }
+
+  __atomic_add_fetch (&this->reclaimed_, count, __ATOMIC_RELAXED);
+  return count;
+}
+
+void
+ACE_Epoch_Manager::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Epoch_Manager::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("epoch_ = %Q\n"),
+                 this->epoch ()));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("pending = %B\n"),
+                 this->pending ()));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
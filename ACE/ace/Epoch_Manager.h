@@ -0,0 +1,241 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Epoch_Manager.h
+ *
+ *  Epoch based reclamation of the memory that lock-free readers may
+ *  still be looking at.
+ */
+//=============================================================================
+
+#ifndef ACE_EPOCH_MANAGER_H
+#define ACE_EPOCH_MANAGER_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Basic_Types.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Thread_Mutex.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+
+/// Number of reader counters of an ACE_Epoch_Manager, a power of two.
+/// The readers are spread over them by thread id.
+#if !defined (ACE_EPOCH_MANAGER_SLOTS)
+# define ACE_EPOCH_MANAGER_SLOTS 64
+#endif /* ACE_EPOCH_MANAGER_SLOTS */
+
+/// Number of nodes retired to an ACE_Epoch_Manager between two
+/// attempts to advance the epoch.
+#if !defined (ACE_EPOCH_MANAGER_RECLAIM_INTERVAL)
+# define ACE_EPOCH_MANAGER_RECLAIM_INTERVAL 64
+#endif /* ACE_EPOCH_MANAGER_RECLAIM_INTERVAL */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Epoch_Node
+ *
+ * @brief Base of the objects that are retired to an ACE_Epoch_Manager.
+ *
+ * The node links the object on the list of the epoch it was retired
+ * in, and remembers the hook that reclaims it.
+ */
+class ACE_Export ACE_Epoch_Node
+{
+public:
+  /// Constructor.
+  ACE_Epoch_Node (void);
+
+private:
+  friend class ACE_Epoch_Manager;
+
+  /// Next node retired in the same epoch.
+  ACE_Epoch_Node *epoch_next_;
+
+  /// Hook that reclaims the node.
+  ACE_CLEANUP_FUNC epoch_cleanup_;
+};
+
+/**
+ * @class ACE_Epoch_Manager
+ *
+ * @brief Defers the reclamation of shared objects until no reader can
+ *        reach them any more.
+ *
+ * Readers bracket their accesses with enter() and exit(), usually
+ * through an ACE_Epoch_Guard, and follow the pointers to the shared
+ * objects without taking any lock.  A writer that unlinks an object
+ * hands it to retire() instead of deleting it.  The manager keeps a
+ * global epoch and a count of the readers that entered in each of the
+ * last three epochs.  The epoch only advances once the readers of the
+ * previous one have all left, so an object retired in epoch @c e is
+ * out of reach of every reader once the epoch reaches @c e+2, and its
+ * cleanup hook is called then.
+ *
+ * Entering and leaving costs each reader an atomic increment and
+ * decrement of a counter, and never waits.  The counters are spread
+ * over ACE_EPOCH_MANAGER_SLOTS cache lines by thread id, so readers on
+ * different threads rarely share one.  Readers may nest, and a thread
+ * may leave from another thread than the one it entered from.
+ *
+ * The epoch advances every ACE_EPOCH_MANAGER_RECLAIM_INTERVAL
+ * retirements, or when reclaim() is called; a reader that stays in
+ * for long only holds back the reclamation, not the writers.
+ */
+class ACE_Export ACE_Epoch_Manager
+{
+public:
+  /// The cleanup hooks of the retired nodes are called with
+  /// @a cleanup_param as their second argument.
+  explicit ACE_Epoch_Manager (void *cleanup_param = 0);
+
+  /// Reclaims all the retired nodes.  No reader may still be in.
+  ~ACE_Epoch_Manager (void);
+
+  /// Enter a read-side critical section, returns the ticket to pass
+  /// to exit().
+  u_long enter (void);
+
+  /// Enter the read-side critical section of @a ticket again, for
+  /// instance to hand a copy of a guard to another object.  The
+  /// critical section must not have been left yet.
+  u_long join (u_long ticket);
+
+  /// Leave the read-side critical section entered as @a ticket.
+  void exit (u_long ticket);
+
+  /**
+   * Retire @a node, which has been unlinked from every shared
+   * structure.  @a cleanup is called with @a node and the cleanup
+   * parameter of the manager once no reader can reach @a node any
+   * more, possibly from another thread.
+   */
+  void retire (ACE_Epoch_Node *node, ACE_CLEANUP_FUNC cleanup);
+
+  /**
+   * Advance the epoch if all the readers of the previous one have
+   * left, and reclaim the nodes that are now out of reach.  Returns
+   * the number of nodes reclaimed.  Never blocks; returns 0 when
+   * another thread is reclaiming.
+   */
+  size_t reclaim (void);
+
+  /// Reclaim all the retired nodes at once.  No reader may be in.
+  size_t reclaim_all (void);
+
+  /// Current epoch.
+  ACE_UINT64 epoch (void) const;
+
+  /// Number of retired nodes not reclaimed yet.
+  size_t pending (void) const;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  enum
+  {
+    /// Number of epochs that may have readers or retired nodes.
+    EPOCHS = 3,
+    /// Assumed size of a cache line.
+    CACHE_LINE = 64
+  };
+
+  /// Reader counts of the threads that hash to the same slot, in a
+  /// cache line of their own.
+  struct Slot
+  {
+    long count_[EPOCHS];
+    char pad_[CACHE_LINE - EPOCHS * sizeof (long)];
+  };
+
+  /// Slot of the calling thread.
+  static u_long slot_i (void);
+
+  /// Reclaim the nodes of @a list, returns their number.
+  size_t reclaim_i (ACE_Epoch_Node *list);
+
+  /// Reader counts per slot and epoch.
+  Slot slots_[ACE_EPOCH_MANAGER_SLOTS];
+
+  /// Global epoch.
+  ACE_UINT64 epoch_;
+
+  /// Nodes retired in each of the last three epochs, indexed by
+  /// epoch modulo 3.
+  ACE_Epoch_Node *limbo_[EPOCHS];
+
+  /// Number of nodes retired.
+  u_long retired_;
+
+  /// Number of nodes reclaimed.
+  u_long reclaimed_;
+
+  /// Second argument of the cleanup hooks.
+  void *cleanup_param_;
+
+  /// Serializes the advances of the epoch.
+  ACE_Thread_Mutex reclaim_lock_;
+
+  ACE_UNIMPLEMENTED_FUNC (ACE_Epoch_Manager (const ACE_Epoch_Manager &))
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Epoch_Manager &))
+};
+
+/**
+ * @class ACE_Epoch_Guard
+ *
+ * @brief Scoped read-side critical section of an ACE_Epoch_Manager.
+ *
+ * A copy of a guard stays in the critical section of the original,
+ * so the pointers read under the original remain valid as long as
+ * either of them lives.
+ */
+class ACE_Export ACE_Epoch_Guard
+{
+public:
+  /// Enter the read-side critical section of @a manager.
+  explicit ACE_Epoch_Guard (ACE_Epoch_Manager &manager);
+
+  /// Guard that doesn't protect anything.
+  ACE_Epoch_Guard (void);
+
+  /// Join the critical section of @a guard.
+  ACE_Epoch_Guard (const ACE_Epoch_Guard &guard);
+
+  /// Leave the current critical section and join the one of @a guard.
+  ACE_Epoch_Guard &operator= (const ACE_Epoch_Guard &guard);
+
+  /// Leave the critical section.
+  ~ACE_Epoch_Guard (void);
+
+private:
+  /// Manager of the critical section, 0 when there is none.
+  ACE_Epoch_Manager *manager_;
+
+  /// Ticket of the critical section.
+  u_long ticket_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Epoch_Manager.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_EPOCH_MANAGER_H */
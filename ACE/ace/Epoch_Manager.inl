@@ -0,0 +1,128 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE
+ACE_Epoch_Node::ACE_Epoch_Node (void)
+  : epoch_next_ (0),
+    epoch_cleanup_ (0)
+{
+}
+
+ACE_INLINE u_long
+ACE_Epoch_Manager::slot_i (void)
+{
+  ACE_thread_t const self = ACE_OS::thr_self ();
+  ACE_UINT64 id = 0;
+  ACE_OS::memcpy (&id,
+                  &self,
+                  sizeof (self) < sizeof (id) ? sizeof (self) : sizeof (id));
+
+  // The thread ids are often aligned addresses, keep the high bits of
+  // the product, which depend on all of them.
+  id *= ACE_UINT64_LITERAL (0x9E3779B97F4A7C15);
+  return static_cast<u_long> (id >> 40) & (ACE_EPOCH_MANAGER_SLOTS - 1);
+}
+
+ACE_INLINE u_long
+ACE_Epoch_Manager::enter (void)
+{
+  u_long const slot = ACE_Epoch_Manager::slot_i ();
+
+  for (;;)
+    {
+      ACE_UINT64 const epoch =
+        __atomic_load_n (&this->epoch_, __ATOMIC_SEQ_CST);
+      u_long const index = static_cast<u_long> (epoch % EPOCHS);
+
+      __atomic_fetch_add (&this->slots_[slot].count_[index],
+                          1,
+                          __ATOMIC_SEQ_CST);
+
+      // The count only holds the epoch back if it was made while the
+      // epoch was still the one counted in.  Once it moved on, reclaim()
+      // may already have checked this counter for the advance past
+      // epoch + 1, and would free what this reader is about to see.
+      if (__atomic_load_n (&this->epoch_, __ATOMIC_SEQ_CST) == epoch)
+        return slot * EPOCHS + index;
+
+      __atomic_fetch_sub (&this->slots_[slot].count_[index],
+                          1,
+                          __ATOMIC_RELEASE);
+    }
+}
+
+ACE_INLINE u_long
+ACE_Epoch_Manager::join (u_long ticket)
+{
+  __atomic_fetch_add (&this->slots_[ticket / EPOCHS].count_[ticket % EPOCHS],
+                      1,
+                      __ATOMIC_SEQ_CST);
+  return ticket;
+}
+
+ACE_INLINE void
+ACE_Epoch_Manager::exit (u_long ticket)
+{
+  __atomic_fetch_sub (&this->slots_[ticket / EPOCHS].count_[ticket % EPOCHS],
+                      1,
+                      __ATOMIC_RELEASE);
+}
+
+ACE_INLINE ACE_UINT64
+ACE_Epoch_Manager::epoch (void) const
+{
+  return __atomic_load_n (&this->epoch_, __ATOMIC_ACQUIRE);
+}
+
+ACE_INLINE size_t
+ACE_Epoch_Manager::pending (void) const
+{
+  return __atomic_load_n (&this->retired_, __ATOMIC_RELAXED)
+    - __atomic_load_n (&this->reclaimed_, __ATOMIC_RELAXED);
+}
+
+ACE_INLINE
+ACE_Epoch_Guard::ACE_Epoch_Guard (ACE_Epoch_Manager &manager)
+  : manager_ (&manager),
+    ticket_ (manager.enter ())
+{
+}
+
+ACE_INLINE
+ACE_Epoch_Guard::ACE_Epoch_Guard (void)
+  : manager_ (0),
+    ticket_ (0)
+{
+}
+
+ACE_INLINE
+ACE_Epoch_Guard::ACE_Epoch_Guard (const ACE_Epoch_Guard &guard)
+  : manager_ (guard.manager_),
+    ticket_ (guard.manager_ == 0 ? 0 : guard.manager_->join (guard.ticket_))
+{
+}
+
+ACE_INLINE ACE_Epoch_Guard &
+ACE_Epoch_Guard::operator= (const ACE_Epoch_Guard &guard)
+{
+  if (this != &guard)
+    {
+      // Join first, the critical sections may be the same.
+      if (guard.manager_ != 0)
+        guard.manager_->join (guard.ticket_);
+      if (this->manager_ != 0)
+        this->manager_->exit (this->ticket_);
+      this->manager_ = guard.manager_;
+      this->ticket_ = guard.ticket_;
+    }
+  return *this;
+}
+
+ACE_INLINE
+ACE_Epoch_Guard::~ACE_Epoch_Guard (void)
+{
+  if (this->manager_ != 0)
+    this->manager_->exit (this->ticket_);
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
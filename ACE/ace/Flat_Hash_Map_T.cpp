@@ -0,0 +1,408 @@
+#ifndef ACE_FLAT_HASH_MAP_T_CPP
+#define ACE_FLAT_HASH_MAP_T_CPP
+
+#include "ace/Flat_Hash_Map_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if !defined (__ACE_INLINE__)
+# include "ace/Flat_Hash_Map_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Malloc_Base.h"
+#include "ace/Malloc.h"
+#include "ace/OS_NS_string.h"
+#include "ace/os_include/os_errno.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Flat_Hash_Map)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Flat_Hash_Map_Iterator)
+ACE_ALLOC_HOOK_DEFINE_Tc5(ACE_Flat_Hash_Map_Const_Iterator)
+
+template <class EXT_ID, class INT_ID>
+ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>::ACE_Flat_Hash_Map_Entry (const EXT_ID &ext_id,
+                                                                  const INT_ID &int_id)
+  : ext_id_ (ext_id),
+    int_id_ (int_id)
+{
+}
+
+template <class EXT_ID, class INT_ID>
+ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>::~ACE_Flat_Hash_Map_Entry (void)
+{
+}
+
+template <class EXT_ID, class INT_ID> EXT_ID &
+ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>::key ()
+{
+  return ext_id_;
+}
+
+template <class EXT_ID, class INT_ID> const EXT_ID &
+ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>::key () const
+{
+  return ext_id_;
+}
+
+template <class EXT_ID, class INT_ID> INT_ID &
+ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>::item ()
+{
+  return int_id_;
+}
+
+template <class EXT_ID, class INT_ID> const INT_ID &
+ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>::item () const
+{
+  return int_id_;
+}
+
+template <class EXT_ID, class INT_ID> void
+ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("capacity_ = %B\n"), this->capacity_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("cur_size_ = %B\n"), this->cur_size_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("growth_left_ = %B\n"), this->growth_left_));
+  if (this->table_allocator_ != 0)
+    this->table_allocator_->dump ();
+  this->lock_.dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> size_t
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::capacity_for (size_t size)
+{
+  size_t capacity = ACE_Flat_Hash_Map_Group::WIDTH;
+  while (capacity - capacity / 8 < size)
+    capacity *= 2;
+  return capacity;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::open (size_t size,
+                                                                           ACE_Allocator *table_alloc,
+                                                                           ACE_Allocator *entry_alloc)
+{
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  // Calling this->close_i () to ensure we release previous allocated
+  // memory before allocating new one.
+  this->close_i ();
+
+  if (table_alloc == 0)
+    table_alloc = ACE_Allocator::instance ();
+
+  this->table_allocator_ = table_alloc;
+
+  // The entries live in the table.
+  ACE_UNUSED_ARG (entry_alloc);
+
+  return this->resize_i (ACE_Flat_Hash_Map::capacity_for (size));
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::close_i (void)
+{
+  // Protect against "double-deletion" in case the destructor also
+  // gets called.
+  if (this->ctrl_ != 0)
+    {
+      this->unbind_all_i ();
+
+      this->table_allocator_->free (this->ctrl_);
+      this->ctrl_ = 0;
+      this->slots_ = 0;
+      this->capacity_ = 0;
+      this->growth_left_ = 0;
+    }
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_all_i (void)
+{
+  if (this->ctrl_ == 0)
+    return 0;
+
+  if (this->cur_size_ != 0)
+    for (size_t i = 0; i < this->capacity_; ++i)
+      if (this->ctrl_[i] >= 0)
+        {
+          ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *const entry = &this->slots_[i];
+          entry->~ENTRY ();
+        }
+
+  ACE_OS::memset (this->ctrl_,
+                  ACE_Flat_Hash_Map_Group::EMPTY,
+                  this->capacity_ + ACE_Flat_Hash_Map_Group::WIDTH);
+  this->cur_size_ = 0;
+  this->growth_left_ = this->capacity_ - this->capacity_ / 8;
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::resize_i (size_t capacity)
+{
+  size_t const ctrl_bytes =
+    ACE_MALLOC_ROUNDUP (capacity + ACE_Flat_Hash_Map_Group::WIDTH,
+                        ACE_MALLOC_ALIGN);
+  size_t const bytes =
+    ctrl_bytes + capacity * sizeof (ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>);
+  void *ptr = 0;
+
+  ACE_ALLOCATOR_RETURN (ptr,
+                        this->table_allocator_->malloc (bytes),
+                        -1);
+
+  signed char *const old_ctrl = this->ctrl_;
+  ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *const old_slots = this->slots_;
+  size_t const old_capacity = this->capacity_;
+
+  this->ctrl_ = static_cast<signed char *> (ptr);
+  this->slots_ =
+    reinterpret_cast<ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *> (this->ctrl_ + ctrl_bytes);
+  this->capacity_ = capacity;
+  ACE_OS::memset (this->ctrl_,
+                  ACE_Flat_Hash_Map_Group::EMPTY,
+                  capacity + ACE_Flat_Hash_Map_Group::WIDTH);
+  this->growth_left_ = capacity - capacity / 8 - this->cur_size_;
+
+  if (old_ctrl == 0)
+    return 0;
+
+  // Move the entries over, their slot in the new table is the first
+  // free one of their probe sequence.
+  for (size_t i = 0; i < old_capacity; ++i)
+    if (old_ctrl[i] >= 0)
+      {
+        ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *const old_entry = &old_slots[i];
+        ACE_UINT64 const hash = this->hash_i (old_entry->ext_id_);
+        size_t const index = this->find_free_i (hash);
+
+        new (&this->slots_[index]) ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> (old_entry->ext_id_,
+                                                                             old_entry->int_id_);
+        this->set_ctrl (index, static_cast<signed char> (hash & 0x7F));
+        old_entry->~ENTRY ();
+      }
+
+  this->table_allocator_->free (old_ctrl);
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ssize_t
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::insert_i (const EXT_ID &ext_id,
+                                                                               const INT_ID &int_id,
+                                                                               ACE_UINT64 hash)
+{
+  size_t index = this->ctrl_ == 0 ? 0 : this->find_free_i (hash);
+
+  // Reusing a tombstone never makes a probe longer, only an EMPTY
+  // slot uses up the room left.
+  if (this->ctrl_ == 0
+      || (this->growth_left_ == 0
+          && this->ctrl_[index] == ACE_Flat_Hash_Map_Group::EMPTY))
+    {
+      size_t capacity = this->capacity_;
+      if (capacity == 0)
+        capacity = ACE_Flat_Hash_Map_Group::WIDTH;
+      else if (this->cur_size_ * 16 > capacity * 7)
+        capacity *= 2;
+      // Otherwise over half the room taken is tombstones, which a
+      // rehash at the same capacity drops.
+
+      if (this->resize_i (capacity) == -1)
+        return -1;
+
+      index = this->find_free_i (hash);
+    }
+
+  if (this->ctrl_[index] == ACE_Flat_Hash_Map_Group::EMPTY)
+    --this->growth_left_;
+
+  new (&this->slots_[index]) ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> (ext_id, int_id);
+  this->set_ctrl (index, static_cast<signed char> (hash & 0x7F));
+  ++this->cur_size_;
+
+  return static_cast<ssize_t> (index);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::erase_i (size_t index)
+{
+  ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *const entry = &this->slots_[index];
+  entry->~ENTRY ();
+  --this->cur_size_;
+
+  // A probe only goes past a group without an EMPTY slot.  If the
+  // slots around this one that hold entries or tombstones don't span
+  // a whole group, no probe has gone past it and it can be EMPTY
+  // again rather than a tombstone.
+  size_t const mask = this->capacity_ - 1;
+  size_t const before = (index - ACE_Flat_Hash_Map_Group::WIDTH) & mask;
+  ACE_Flat_Hash_Map_Group::Mask const empty_after =
+    ACE_Flat_Hash_Map_Group (this->ctrl_ + index).match_empty ();
+  ACE_Flat_Hash_Map_Group::Mask const empty_before =
+    ACE_Flat_Hash_Map_Group (this->ctrl_ + before).match_empty ();
+
+  if (empty_after != 0
+      && empty_before != 0
+      && ACE_Flat_Hash_Map_Group::lowest (empty_after)
+         + ACE_Flat_Hash_Map_Group::trailing (empty_before)
+         < static_cast<unsigned int> (ACE_Flat_Hash_Map_Group::WIDTH))
+    {
+      this->set_ctrl (index, ACE_Flat_Hash_Map_Group::EMPTY);
+      ++this->growth_left_;
+    }
+  else
+    this->set_ctrl (index, ACE_Flat_Hash_Map_Group::DELETED);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bind_i (const EXT_ID &ext_id,
+                                                                             const INT_ID &int_id,
+                                                                             ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ACE_UINT64 const hash = this->hash_i (ext_id);
+  ssize_t index = this->lookup_i (ext_id, hash);
+
+  if (index != -1)
+    {
+      entry = &this->slots_[index];
+      return 1;
+    }
+
+  index = this->insert_i (ext_id, int_id, hash);
+  if (index == -1)
+    return -1;
+
+  entry = &this->slots_[index];
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::trybind_i (const EXT_ID &ext_id,
+                                                                                INT_ID &int_id,
+                                                                                ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  int const result = this->bind_i (ext_id, int_id, entry);
+
+  if (result == 1)
+    int_id = entry->int_id_;
+
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rebind_i (const EXT_ID &ext_id,
+                                                                               const INT_ID &int_id,
+                                                                               ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  int const result = this->bind_i (ext_id, int_id, entry);
+
+  if (result == 1)
+    entry->int_id_ = int_id;
+
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &ext_id,
+                                                                             const INT_ID &int_id,
+                                                                             INT_ID &old_int_id,
+                                                                             ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  int const result = this->bind_i (ext_id, int_id, entry);
+
+  if (result == 1)
+    {
+      old_int_id = entry->int_id_;
+      entry->int_id_ = int_id;
+    }
+
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rebind (const EXT_ID &ext_id,
+                                                                             const INT_ID &int_id,
+                                                                             EXT_ID &old_ext_id,
+                                                                             INT_ID &old_int_id,
+                                                                             ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  int const result = this->bind_i (ext_id, int_id, entry);
+
+  if (result == 1)
+    {
+      old_ext_id = entry->ext_id_;
+      old_int_id = entry->int_id_;
+      entry->ext_id_ = ext_id;
+      entry->int_id_ = int_id;
+    }
+
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_i (const EXT_ID &ext_id,
+                                                                               INT_ID &int_id)
+{
+  ssize_t const index = this->lookup_i (ext_id, this->hash_i (ext_id));
+
+  if (index == -1)
+    {
+      errno = ENOENT;
+      return -1;
+    }
+
+  int_id = this->slots_[index].int_id_;
+  this->erase_i (static_cast<size_t> (index));
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("index_ = %B\n"), this->index_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Flat_Hash_Map_Const_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Flat_Hash_Map_Const_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("index_ = %B\n"), this->index_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_FLAT_HASH_MAP_T_CPP */
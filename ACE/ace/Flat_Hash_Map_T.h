@@ -0,0 +1,824 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Flat_Hash_Map_T.h
+ *
+ *  Open addressing hash map with the interface of
+ *  ACE_Hash_Map_Manager_Ex.
+ */
+//=============================================================================
+
+#ifndef ACE_FLAT_HASH_MAP_T_H
+#define ACE_FLAT_HASH_MAP_T_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Default_Constants.h"
+#include "ace/Functor_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Basic_Types.h"
+#include <iterator>
+
+#if defined (ACE_HAS_SSE2)
+# include <emmintrin.h>
+#endif /* ACE_HAS_SSE2 */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Flat_Hash_Map_Entry
+ *
+ * @brief Define an entry in the flat hash table.
+ */
+template <class EXT_ID, class INT_ID>
+class ACE_Flat_Hash_Map_Entry
+{
+public:
+  /// Constructor.
+  ACE_Flat_Hash_Map_Entry (const EXT_ID &ext_id,
+                           const INT_ID &int_id);
+
+  /// Destructor.
+  ~ACE_Flat_Hash_Map_Entry (void);
+
+  /// Key accessor.
+  EXT_ID& key (void);
+
+  /// Read-only key accessor.
+  const EXT_ID& key (void) const;
+
+  /// Item accessor.
+  INT_ID& item (void);
+
+  /// Read-only item accessor.
+  const INT_ID& item (void) const;
+
+  /// Key used to look up an entry.
+  EXT_ID ext_id_;
+
+  /// The contents of the entry itself.
+  INT_ID int_id_;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Group
+ *
+ * @brief The control bytes of a group of consecutive slots of an
+ * ACE_Flat_Hash_Map, matched all at once.
+ *
+ * A control byte is EMPTY, DELETED, or holds the 7 low bits of the
+ * hash of the key in its slot.  With SSE2 a group is 16 slots wide
+ * and is matched with a single compare, otherwise it is 8 slots wide
+ * and matched with 64-bit arithmetic.  The matches are returned as a
+ * mask with one bit per matching slot, to be walked with lowest() and
+ * clear_lowest().
+ */
+class ACE_Flat_Hash_Map_Group
+{
+public:
+#if defined (ACE_HAS_SSE2)
+  typedef ACE_UINT32 Mask;
+  enum { WIDTH = 16 };
+#else
+  typedef ACE_UINT64 Mask;
+  enum { WIDTH = 8 };
+#endif /* ACE_HAS_SSE2 */
+
+  /// Values of the control bytes of the slots without an entry.
+  enum
+  {
+    EMPTY = -128,
+    DELETED = -2
+  };
+
+  /// Load the WIDTH control bytes starting at @a ctrl.
+  explicit ACE_Flat_Hash_Map_Group (const signed char *ctrl)
+  {
+#if defined (ACE_HAS_SSE2)
+    this->ctrl_ = _mm_loadu_si128 (reinterpret_cast<const __m128i *> (ctrl));
+#else
+    this->ctrl_ = 0;
+    for (int i = 0; i < WIDTH; ++i)
+      this->ctrl_ |=
+        static_cast<ACE_UINT64> (static_cast<unsigned char> (ctrl[i])) << (8 * i);
+#endif /* ACE_HAS_SSE2 */
+  }
+
+  /// The slots whose control byte is @a h2.  Without SSE2 a slot
+  /// following a match may show up as a false positive, the keys are
+  /// compared anyway.
+  Mask match (signed char h2) const
+  {
+#if defined (ACE_HAS_SSE2)
+    return static_cast<Mask> (
+      _mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_set1_epi8 (h2), this->ctrl_)));
+#else
+    ACE_UINT64 const x =
+      this->ctrl_ ^ (LSBS * static_cast<unsigned char> (h2));
+    return (x - LSBS) & ~x & MSBS;
+#endif /* ACE_HAS_SSE2 */
+  }
+
+  /// The EMPTY slots.
+  Mask match_empty (void) const
+  {
+#if defined (ACE_HAS_SSE2)
+    return this->match (static_cast<signed char> (EMPTY));
+#else
+    // EMPTY is the only value with bit 7 set and bit 1 clear.
+    return this->ctrl_ & (~this->ctrl_ << 6) & MSBS;
+#endif /* ACE_HAS_SSE2 */
+  }
+
+  /// The EMPTY and DELETED slots, the only ones with bit 7 set.
+  Mask match_free (void) const
+  {
+#if defined (ACE_HAS_SSE2)
+    return static_cast<Mask> (_mm_movemask_epi8 (this->ctrl_));
+#else
+    return this->ctrl_ & MSBS;
+#endif /* ACE_HAS_SSE2 */
+  }
+
+  /// Offset of the first slot of @a mask, which must not be 0.
+  static unsigned int lowest (Mask mask)
+  {
+#if defined (__GNUC__)
+# if defined (ACE_HAS_SSE2)
+    return static_cast<unsigned int> (__builtin_ctz (mask));
+# else
+    return static_cast<unsigned int> (__builtin_ctzll (mask)) >> 3;
+# endif /* ACE_HAS_SSE2 */
+#else
+    unsigned int n = 0;
+    for (; (mask & FIRST) == 0; mask >>= SHIFT)
+      ++n;
+    return n;
+#endif /* __GNUC__ */
+  }
+
+  /// Number of slots following the last slot of @a mask, which must
+  /// not be 0.
+  static unsigned int trailing (Mask mask)
+  {
+#if defined (__GNUC__)
+# if defined (ACE_HAS_SSE2)
+    return static_cast<unsigned int> (__builtin_clz (mask)) - 16;
+# else
+    return static_cast<unsigned int> (__builtin_clzll (mask)) >> 3;
+# endif /* ACE_HAS_SSE2 */
+#else
+    unsigned int n = 0;
+    for (; (mask & LAST) == 0; mask <<= SHIFT)
+      ++n;
+    return n;
+#endif /* __GNUC__ */
+  }
+
+  /// @a mask without its first slot.
+  static Mask clear_lowest (Mask mask)
+  {
+    return mask & (mask - 1);
+  }
+
+private:
+#if defined (ACE_HAS_SSE2)
+  static const Mask FIRST = 0x1u;
+  static const Mask LAST = 0x8000u;
+  static const unsigned int SHIFT = 1;
+
+  __m128i ctrl_;
+#else
+  static const Mask FIRST = ACE_UINT64_LITERAL (0x80);
+  static const Mask LAST = ACE_UINT64_LITERAL (0x8000000000000000);
+  static const unsigned int SHIFT = 8;
+  static const ACE_UINT64 LSBS = ACE_UINT64_LITERAL (0x0101010101010101);
+  static const ACE_UINT64 MSBS = ACE_UINT64_LITERAL (0x8080808080808080);
+
+  ACE_UINT64 ctrl_;
+#endif /* ACE_HAS_SSE2 */
+};
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Iterator;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Const_Iterator;
+
+// Forward decl.
+class ACE_Allocator;
+
+/**
+ * @class ACE_Flat_Hash_Map
+ *
+ * @brief Define a map abstraction that efficiently associates
+ * @c EXT_ID type objects with @c INT_ID type objects, using open
+ * addressing.
+ *
+ * ACE_Hash_Map_Manager_Ex allocates a node per entry and chains the
+ * nodes of each bucket, so a lookup follows at least one pointer per
+ * candidate.  This map keeps its entries in a single array of slots
+ * instead, next to an array of one control byte per slot.  A lookup
+ * hashes the key, then matches the 7 low bits of the hash against
+ * the control bytes of a whole group of slots at a time (see
+ * ACE_Flat_Hash_Map_Group), and only compares the keys of the slots
+ * that match.  Probing moves on to the next group, following a
+ * triangular sequence, until a group with an empty slot is found.
+ * Unbinding an entry leaves a tombstone unless no probe can have gone
+ * past its slot.  The table grows to keep it at most 7/8 full,
+ * tombstones included, doubling when it has to and dropping the
+ * tombstones otherwise.
+ *
+ * The interface is the one of ACE_Hash_Map_Manager_Ex, minus the
+ * reverse iterators, so that switching from one to the other only
+ * takes changing a typedef, with one caveat: the entries move when
+ * the table grows.  The entries and iterators got from a map are only
+ * valid until the next bind, trybind or rebind of a new key, so users
+ * that keep a pointer to their entry can't switch.  The key and item
+ * types must be copy constructible and assignable.  The table is
+ * allocated from @a table_alloc, with the alignment of ACE_MALLOC_ALIGN.
+ *
+ * The HASH_KEY and COMPARE_KEYS functors are the ones of
+ * ACE_Hash_Map_Manager_Ex.  The hash value is mixed before use, so a
+ * weak hash function such as the identity for integers is fine.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map
+{
+public:
+  friend class ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_Flat_Hash_Map_Const_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+
+  typedef EXT_ID
+          KEY;
+  typedef INT_ID
+          VALUE;
+  typedef ACE_LOCK lock_type;
+  typedef ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>
+          ENTRY;
+
+  // = ACE-style iterator typedefs.
+  typedef ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          ITERATOR;
+  typedef ACE_Flat_Hash_Map_Const_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          CONST_ITERATOR;
+
+  // = STL-style iterator typedefs.
+  typedef ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          iterator;
+  typedef ACE_Flat_Hash_Map_Const_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          const_iterator;
+
+  // = STL-style typedefs/traits.
+  typedef EXT_ID                                  key_type;
+  typedef INT_ID                                  data_type;
+  typedef ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> value_type;
+  typedef value_type &                            reference;
+  typedef value_type const &                      const_reference;
+  typedef value_type *                            pointer;
+  typedef value_type const *                      const_pointer;
+  typedef ptrdiff_t                               difference_type;
+  typedef size_t                                  size_type;
+
+  /**
+   * Initialize an ACE_Flat_Hash_Map with the smallest table, which
+   * grows as entries are bound.
+   *
+   * @param table_alloc is a pointer to a memory allocator used for
+   *        the table.  If @a table_alloc is 0 it defaults to
+   *        ACE_Allocator::instance().
+   * @param entry_alloc is ignored, the entries live in the table.  It
+   *        is only there for compatibility with
+   *        ACE_Hash_Map_Manager_Ex.
+   */
+  ACE_Flat_Hash_Map (ACE_Allocator *table_alloc = 0,
+                     ACE_Allocator *entry_alloc = 0);
+
+  /**
+   * Initialize an ACE_Flat_Hash_Map with a table that holds @a size
+   * entries without growing.
+   *
+   * @param table_alloc is a pointer to a memory allocator used for
+   *        the table.  If @a table_alloc is 0 it defaults to
+   *        ACE_Allocator::instance().
+   * @param entry_alloc is ignored, the entries live in the table.
+   */
+  ACE_Flat_Hash_Map (size_t size,
+                     ACE_Allocator *table_alloc = 0,
+                     ACE_Allocator *entry_alloc = 0);
+
+  /**
+   * Initialize an ACE_Flat_Hash_Map with a table that holds @a size
+   * entries without growing.
+   *
+   * @param table_alloc is a pointer to a memory allocator used for
+   *        the table.  If @a table_alloc is 0 it defaults to
+   *        ACE_Allocator::instance().
+   * @param entry_alloc is ignored, the entries live in the table.
+   * @return -1 on failure, 0 on success
+   */
+  int open (size_t size = ACE_DEFAULT_MAP_SIZE,
+            ACE_Allocator *table_alloc = 0,
+            ACE_Allocator *entry_alloc = 0);
+
+  /// Close down the ACE_Flat_Hash_Map and release dynamically allocated
+  /// resources.
+  int close (void);
+
+  /// Removes all the entries in the ACE_Flat_Hash_Map, keeping its
+  /// table.
+  int unbind_all (void);
+
+  /// Cleanup the ACE_Flat_Hash_Map.
+  ~ACE_Flat_Hash_Map (void);
+
+  /**
+   * Associate @a item with @a int_id.  If @a item is already in the
+   * map then the map is not changed.
+   *
+   * @retval 0 if a new entry is bound successfully.
+   * @retval 1 if an attempt is made to bind an existing entry.
+   * @retval -1 if a failure occurs; check @c errno for more information.
+   */
+  int bind (const EXT_ID &item,
+            const INT_ID &int_id);
+
+  /**
+   * Same as a normal bind, except the map entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int bind (const EXT_ID &ext_id,
+            const INT_ID &int_id,
+            ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id if and only if @a ext_id is not
+   * in the map.  If @a ext_id is already in the map then the @a int_id
+   * parameter is assigned the existing value in the map.  Returns 0
+   * if a new entry is bound successfully, returns 1 if an attempt is
+   * made to bind an existing entry, and returns -1 if failures occur.
+   */
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id);
+
+  /**
+   * Same as a normal trybind, except the map entry is also passed
+   * back to the caller.  The entry in this case will either be the
+   * newly created entry, or the existing one.
+   */
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id,
+               ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Reassociate @a ext_id with @a int_id.  If @a ext_id is not in the
+   * map then behaves just like <bind>.  Returns 0 if a new entry is
+   * bound successfully, returns 1 if an existing entry was rebound,
+   * and returns -1 if failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id);
+
+  /**
+   * Same as a normal rebind, except the map entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is not in the map
+   * then behaves just like <bind>.  Otherwise, store the old value of
+   * @a int_id into the "out" parameter and rebind the new parameters.
+   * Returns 0 if a new entry is bound successfully, returns 1 if an
+   * existing entry was rebound, and returns -1 if failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id);
+
+  /**
+   * Same as a normal rebind, except the map entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id,
+              ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is not in the map
+   * then behaves just like <bind>.  Otherwise, store the old values
+   * of @a ext_id and @a int_id into the "out" parameters and rebind the
+   * new parameters.  Returns 0 if a new entry is bound successfully,
+   * returns 1 if an existing entry was rebound, and returns -1 if
+   * failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              EXT_ID &old_ext_id,
+              INT_ID &old_int_id);
+
+  /**
+   * Same as a normal rebind, except the map entry is also passed back
+   * to the caller.  The entry in this case will either be the newly
+   * created entry, or the existing one.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              EXT_ID &old_ext_id,
+              INT_ID &old_int_id,
+              ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Locate @a ext_id and pass out parameter via @a int_id.
+  /// Return 0 if found, returns -1 if not found.
+  int find (const EXT_ID &ext_id,
+            INT_ID &int_id) const;
+
+  /// Returns 0 if the @a ext_id is in the mapping, otherwise -1.
+  int find (const EXT_ID &ext_id) const;
+
+  /// Locate @a ext_id and pass out parameter via @a entry.  If found,
+  /// return 0, returns -1 if not found.
+  int find (const EXT_ID &ext_id,
+            ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry) const;
+
+  /// Locate @a ext_id and pass out an iterator that points to its
+  /// corresponding value.
+  /**
+   * @param pos @a pos will be set to @c end() if not found.
+   */
+  void find (EXT_ID const & ext_id, iterator & pos) const;
+
+  /**
+   * Unbind (remove) the @a ext_id from the map.  Don't return the
+   * @a int_id to the caller (this is useful for collections where the
+   * @a int_ids are *not* dynamically allocated...)
+   */
+  int unbind (const EXT_ID &ext_id);
+
+  /// Break any association of @a ext_id.  Returns the value of @a int_id
+  /// in case the caller needs to deallocate memory. Return 0 if the
+  /// unbind was successful, and returns -1 if failures occur.
+  int unbind (const EXT_ID &ext_id,
+              INT_ID &int_id);
+
+  /// Remove entry from map.
+  /**
+   * No lookup is performed, the slot of @a entry is freed directly.
+   *
+   * @return 0 if the unbind was successful, and -1 if failures
+   *         occur.
+   */
+  int unbind (ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *entry);
+
+  /// Remove entry from map pointed to by @c iterator @a pos.
+  /**
+   * No lookup is performed, and the other iterators of the map stay
+   * valid, so @a pos can be advanced afterwards.
+   *
+   * @return 0 if the unbind was successful, and -1 if failures
+   *         occur.
+   */
+  int unbind (iterator pos);
+
+  /// Returns the current number of entries in the hash table.
+  size_t current_size (void) const;
+
+  /// Return the number of slots of the hash table.
+  size_t total_size (void) const;
+
+  /**
+   * Returns a reference to the underlying <ACE_LOCK>.  This makes it
+   * possible to acquire the lock explicitly, which can be useful in
+   * some cases if you instantiate the ACE_Atomic_Op with an
+   * ACE_Recursive_Mutex or ACE_Process_Mutex, or if you need to
+   * guard the state of an iterator.
+   */
+  ACE_LOCK &mutex (void);
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  // = STL styled iterator factory functions.
+
+  /// Return forward iterator.
+  iterator begin (void);
+  iterator end (void);
+  const_iterator begin (void) const;
+  const_iterator end (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  // = The following methods do the actual work.
+
+  /// Returns 1 if <id1> == <id2>, else 0.  This is defined as a
+  /// separate method to facilitate template specialization.
+  int equal (const EXT_ID &id1, const EXT_ID &id2);
+
+  /// Compute the hash value of the @a ext_id.  This is defined as a
+  /// separate method to facilitate template specialization.
+  u_long hash (const EXT_ID &ext_id);
+
+  // = These methods assume locks are held by private methods.
+
+  /// Performs bind.  Must be called with locks held.
+  int bind_i (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs trybind.  Must be called with locks held.
+  int trybind_i (const EXT_ID &ext_id,
+                 INT_ID &int_id,
+                 ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id,
+                ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs find.  Must be called with locks held.
+  int find_i (const EXT_ID &ext_id,
+              ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs unbind.  Must be called with locks held.
+  int unbind_i (const EXT_ID &ext_id,
+                INT_ID &int_id);
+
+  /// Performs unbind.  Must be called with locks held.
+  int unbind_i (const EXT_ID &ext_id);
+
+  /// Close down a <Map_Manager_Ex>.  Must be called with
+  /// locks held.
+  int close_i (void);
+
+  /// Removes all the entries in <Map_Manager_Ex>.  Must be called with
+  /// locks held.
+  int unbind_all_i (void);
+
+  /// Pointer to a memory allocator used for the table.
+  ACE_Allocator *table_allocator_;
+
+  /// Synchronization variable for the MT_SAFE
+  /// @c ACE_Flat_Hash_Map.
+  mutable ACE_LOCK lock_;
+
+  /// Function object used for hashing keys.
+  HASH_KEY hash_key_;
+
+  /// Function object used for comparing keys.
+  COMPARE_KEYS compare_keys_;
+
+private:
+  /// Mixed hash of @a ext_id, the 7 low bits of which go into the
+  /// control byte of its slot and the others select the first group
+  /// probed.
+  ACE_UINT64 hash_i (const EXT_ID &ext_id);
+
+  /// Index of the slot of @a ext_id, whose mixed hash is @a hash, or
+  /// -1 if it is not in the map.
+  ssize_t lookup_i (const EXT_ID &ext_id, ACE_UINT64 hash);
+
+  /// Index of the first EMPTY or DELETED slot in the probe sequence
+  /// of @a hash.
+  size_t find_free_i (ACE_UINT64 hash) const;
+
+  /// Bind @a ext_id, which must not be in the map, growing the table
+  /// if needed.  Returns the index of its slot, or -1 if out of memory.
+  ssize_t insert_i (const EXT_ID &ext_id,
+                    const INT_ID &int_id,
+                    ACE_UINT64 hash);
+
+  /// Destroy the entry of slot @a index and free the slot.
+  void erase_i (size_t index);
+
+  /// Set the control byte of slot @a index, and its copy past the
+  /// end of the table.
+  void set_ctrl (size_t index, signed char ctrl);
+
+  /// Move the entries to a new table of @a capacity slots.
+  int resize_i (size_t capacity);
+
+  /// Smallest capacity holding @a size entries without growing.
+  static size_t capacity_for (size_t size);
+
+  /// Index of the first slot at or after @a index holding an entry,
+  /// capacity_ if there is none.
+  size_t skip_free_i (size_t index) const;
+
+  /// One control byte per slot, followed by a copy of the control
+  /// bytes of the first group, so that the group starting at any slot
+  /// can be loaded at once.  This is also the start of the memory of
+  /// the table.
+  signed char *ctrl_;
+
+  /// The slots, following the control bytes in the same allocation.
+  ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *slots_;
+
+  /// Number of slots, a power of two no smaller than the width of a
+  /// group.
+  size_t capacity_;
+
+  /// Current number of entries in the table.
+  size_t cur_size_;
+
+  /// Number of EMPTY slots that can still be used before the table
+  /// has to grow.
+  size_t growth_left_;
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Flat_Hash_Map (const ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &))
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Iterator
+ *
+ * @brief Forward iterator for the ACE_Flat_Hash_Map.
+ *
+ * This class does not perform any internal locking of the
+ * ACE_Flat_Hash_Map it is iterating upon since locking is
+ * inherently inefficient and/or error-prone within an STL-style
+ * iterator.  If you require locking, you can explicitly use an
+ * ACE_GUARD or ACE_READ_GUARD on the ACE_Flat_Hash_Map's
+ * internal lock, which is accessible via its <mutex> method.  The
+ * iterator is invalidated when the table grows, but stays valid when
+ * entries are unbound.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Iterator
+{
+public:
+  friend class ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+
+  // = STL-style traits/typedefs.
+  typedef ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+  container_type;
+
+  // = std::iterator_traits typedefs/traits.
+  typedef std::forward_iterator_tag                iterator_category;
+  typedef typename container_type::value_type      value_type;
+  typedef typename container_type::reference       reference;
+  typedef typename container_type::pointer         pointer;
+  typedef typename container_type::difference_type difference_type;
+
+  /// Contructor.  If @a tail != false, the iterator starts at the end
+  /// of the map.
+  ACE_Flat_Hash_Map_Iterator (container_type &mm,
+                              bool tail = false);
+
+  /// Pass back the @a next_entry that hasn't been seen in the Set.
+  /// Returns 0 when all items have been seen, else 1.
+  int next (ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&next_entry) const;
+
+  /// Returns 1 when all items have been seen, else 0.
+  int done (void) const;
+
+  /// Move forward by one element in the set.  Returns 0 when all the
+  /// items in the set have been seen, else 1.
+  int advance (void);
+
+  /// Returns a reference to the interal element @c this is pointing to.
+  ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>& operator* (void) const;
+
+  /// Returns a pointer to the interal element @c this is pointing to.
+  ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>* operator-> (void) const;
+
+  /// Prefix advance.
+  ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ (void);
+
+  /// Postfix advance.
+  ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Returns a reference to the hash map we are iterating over.
+  container_type &map (void);
+
+  /// Check if two iterators point to the same position
+  bool operator== (const ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+  bool operator!= (const ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Map we are iterating over.
+  container_type *map_man_;
+
+  /// Slot of the current entry, the capacity of the map once all the
+  /// entries have been seen.
+  size_t index_;
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Const_Iterator
+ *
+ * @brief Const forward iterator for the ACE_Flat_Hash_Map.
+ *
+ * This class does not perform any internal locking of the
+ * ACE_Flat_Hash_Map it is iterating upon since locking is
+ * inherently inefficient and/or error-prone within an STL-style
+ * iterator.  If you require locking, you can explicitly use an
+ * ACE_GUARD or ACE_READ_GUARD on the ACE_Flat_Hash_Map's
+ * internal lock, which is accessible via its <mutex> method.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Const_Iterator
+{
+public:
+  // = STL-style traits/typedefs.
+  typedef ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+  container_type;
+
+  // = std::iterator_traits typedefs/traits.
+  typedef std::forward_iterator_tag                iterator_category;
+  typedef typename container_type::value_type      value_type;
+  typedef typename container_type::const_reference reference;
+  typedef typename container_type::const_pointer   pointer;
+  typedef typename container_type::difference_type difference_type;
+
+  /// Contructor.  If @a tail != false, the iterator starts at the end
+  /// of the map.
+  ACE_Flat_Hash_Map_Const_Iterator (const container_type &mm,
+                                    bool tail = false);
+
+  /// Pass back the @a next_entry that hasn't been seen in the Set.
+  /// Returns 0 when all items have been seen, else 1.
+  int next (const ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&next_entry) const;
+
+  /// Returns 1 when all items have been seen, else 0.
+  int done (void) const;
+
+  /// Move forward by one element in the set.  Returns 0 when all the
+  /// items in the set have been seen, else 1.
+  int advance (void);
+
+  /// Returns a reference to the interal element @c this is pointing to.
+  const ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>& operator* (void) const;
+
+  /// Returns a pointer to the interal element @c this is pointing to.
+  const ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>* operator-> (void) const;
+
+  /// Prefix advance.
+  ACE_Flat_Hash_Map_Const_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ (void);
+
+  /// Postfix advance.
+  ACE_Flat_Hash_Map_Const_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Returns a reference to the hash map we are iterating over.
+  const container_type &map (void);
+
+  /// Check if two iterators point to the same position
+  bool operator== (const ACE_Flat_Hash_Map_Const_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+  bool operator!= (const ACE_Flat_Hash_Map_Const_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Map we are iterating over.
+  const container_type *map_man_;
+
+  /// Slot of the current entry, the capacity of the map once all the
+  /// entries have been seen.
+  size_t index_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+# include "ace/Flat_Hash_Map_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Flat_Hash_Map_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Flat_Hash_Map_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_FLAT_HASH_MAP_T_H */
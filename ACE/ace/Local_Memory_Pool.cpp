@@ -3,6 +3,7 @@
 #include "ace/Auto_Ptr.h"
 #include "ace/OS_Memory.h"
 #include "ace/Log_Category.h"
+#include "ace/OS_NS_sys_mman.h"
 
 
 
@@ -18,10 +19,44 @@ ACE_Local_Memory_Pool::dump (void) const
 #endif /* ACE_HAS_DUMP */
 }
 
+ACE_Local_Memory_Pool_Options::ACE_Local_Memory_Pool_Options (
+  int huge_pages,
+  bool populate,
+  int numa_node,
+  size_t huge_page_size)
+  : huge_pages_ (huge_pages),
+    populate_ (populate),
+    numa_node_ (numa_node),
+    huge_page_size_ (huge_page_size)
+{
+  ACE_TRACE ("ACE_Local_Memory_Pool_Options::ACE_Local_Memory_Pool_Options");
+}
+
 ACE_Local_Memory_Pool::ACE_Local_Memory_Pool (const ACE_TCHAR *,
-                                              const OPTIONS *)
+                                              const OPTIONS *options)
+  : huge_pages_ (ACE_Local_Memory_Pool_Options::NO_HUGE_PAGES),
+    populate_ (false),
+    numa_node_ (-1),
+    huge_page_size_ (ACE_DEFAULT_HUGE_PAGE_SIZE),
+    map_chunks_ (false)
 {
   ACE_TRACE ("ACE_Local_Memory_Pool::ACE_Local_Memory_Pool");
+
+  if (options)
+    {
+      this->huge_pages_ = options->huge_pages_;
+      this->populate_ = options->populate_;
+      this->numa_node_ = options->numa_node_;
+      if (options->huge_page_size_ != 0)
+        this->huge_page_size_ = options->huge_page_size_;
+
+#if defined (MAP_ANONYMOUS)
+      this->map_chunks_ =
+        this->huge_pages_ != ACE_Local_Memory_Pool_Options::NO_HUGE_PAGES
+        || this->populate_
+        || this->numa_node_ >= 0;
+#endif /* MAP_ANONYMOUS */
+    }
 }
 
 ACE_Local_Memory_Pool::~ACE_Local_Memory_Pool (void)
@@ -52,6 +87,9 @@ ACE_Local_Memory_Pool::acquire (size_t nbytes,
   ACE_TRACE ("ACE_Local_Memory_Pool::acquire");
   rounded_bytes = this->round_up (nbytes);
 
+  if (this->map_chunks_)
+    return this->map_chunk (rounded_bytes);
+
   char *temp = 0;
 #if defined (ACE_HAS_ALLOC_HOOKS)
   ACE_ALLOCATOR_RETURN (temp,
@@ -73,6 +111,85 @@ ACE_Local_Memory_Pool::acquire (size_t nbytes,
   return cp.release ();
 }
 
+void *
+ACE_Local_Memory_Pool::map_chunk (size_t rounded_bytes)
+{
+  ACE_TRACE ("ACE_Local_Memory_Pool::map_chunk");
+
+#if defined (MAP_ANONYMOUS)
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+# if defined (MAP_HUGETLB)
+  if (this->huge_pages_ == ACE_Local_Memory_Pool_Options::HUGETLB_PAGES)
+    ACE_SET_BITS (flags, MAP_HUGETLB);
+# endif /* MAP_HUGETLB */
+# if defined (MAP_POPULATE)
+  bool const map_populate =
+    this->populate_
+    && this->numa_node_ < 0
+    && this->huge_pages_ != ACE_Local_Memory_Pool_Options::TRANSPARENT_HUGE_PAGES;
+  if (map_populate)
+    ACE_SET_BITS (flags, MAP_POPULATE);
+# else
+  bool const map_populate = false;
+# endif /* MAP_POPULATE */
+
+  char *addr = static_cast<char *> (ACE_OS::mmap (0,
+                                                  rounded_bytes,
+                                                  PROT_RDWR,
+                                                  flags,
+                                                  ACE_INVALID_HANDLE));
+  // Like new, leave it to the caller to report running out of memory.
+  if (addr == MAP_FAILED)
+    return 0;
+
+  // Advice and placement are best effort, the pool works without them.
+# if defined (MADV_HUGEPAGE)
+  if (this->huge_pages_ == ACE_Local_Memory_Pool_Options::TRANSPARENT_HUGE_PAGES
+      && ACE_OS::madvise (addr, rounded_bytes, MADV_HUGEPAGE) == -1
+      && ACE::debug ())
+    ACELIB_DEBUG ((LM_DEBUG,
+                   ACE_TEXT ("(%P|%t) ACE_Local_Memory_Pool::map_chunk, %p\n"),
+                   ACE_TEXT ("madvise")));
+# endif /* MADV_HUGEPAGE */
+
+  if (this->numa_node_ >= 0
+      && ACE::bind_to_numa_node (addr, rounded_bytes, this->numa_node_) == -1
+      && ACE::debug ())
+    ACELIB_DEBUG ((LM_DEBUG,
+                   ACE_TEXT ("(%P|%t) ACE_Local_Memory_Pool::map_chunk, %p\n"),
+                   ACE_TEXT ("mbind")));
+
+  if (this->populate_ && !map_populate)
+    {
+      // Reading would map the zero page, so write to each page.
+      size_t const page_size =
+        this->huge_pages_ == ACE_Local_Memory_Pool_Options::HUGETLB_PAGES
+          ? this->huge_page_size_
+          : ACE::round_to_pagesize (1);
+      char volatile *page = addr;
+      for (size_t offset = 0; offset < rounded_bytes; offset += page_size)
+        page[offset] = 0;
+    }
+
+  Mapped_Chunk chunk;
+  chunk.addr_ = addr;
+  chunk.size_ = rounded_bytes;
+
+  if (this->mapped_chunks_.enqueue_tail (chunk) != 0)
+    {
+      ACE_OS::munmap (addr, rounded_bytes);
+      ACELIB_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("(%P|%t) insertion into queue failed\n")),
+                        0);
+    }
+
+  return addr;
+#else
+  ACE_UNUSED_ARG (rounded_bytes);
+  ACE_NOTSUP_RETURN (0);
+#endif /* MAP_ANONYMOUS */
+}
+
 int
 ACE_Local_Memory_Pool::release (int)
 {
@@ -89,6 +206,11 @@ ACE_Local_Memory_Pool::release (int)
 #endif /* ACE_HAS_ALLOC_HOOKS */
 
   this->allocated_chunks_.reset ();
+
+  Mapped_Chunk chunk;
+  while (this->mapped_chunks_.dequeue_head (chunk) == 0)
+    ACE_OS::munmap (chunk.addr_, chunk.size_);
+
   return 0;
 }
 
@@ -147,6 +269,12 @@ size_t
 ACE_Local_Memory_Pool::round_up (size_t nbytes)
 {
   ACE_TRACE ("ACE_Local_Memory_Pool::round_up");
+
+  if (this->huge_pages_ == ACE_Local_Memory_Pool_Options::HUGETLB_PAGES
+      && this->map_chunks_)
+    return (nbytes + this->huge_page_size_ - 1)
+      / this->huge_page_size_ * this->huge_page_size_;
+
   return ACE::round_to_pagesize (nbytes);
 }
 
@@ -21,6 +21,8 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "ace/Unbounded_Set.h"
+#include "ace/Unbounded_Queue.h"
+#include "ace/Default_Constants.h"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -30,10 +32,48 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
  * @brief Helper class for Local Memory Pool constructor options.
  *
  * This should be a nested class, but that breaks too many
- * compilers.
+ * compilers.  By default the pool allocates its memory with new;
+ * asking for huge pages, pre-faulting or a NUMA node has it map
+ * anonymous memory instead, where the platform supports it.
  */
 class ACE_Export ACE_Local_Memory_Pool_Options
 {
+public:
+  enum
+  {
+    /// The pages of the pool have the base page size.
+    NO_HUGE_PAGES = 0,
+
+    /// Advise the kernel to back the pool with transparent huge pages.
+    TRANSPARENT_HUGE_PAGES = 1,
+
+    /**
+     * Map the pool with @c MAP_HUGETLB, from the huge pages the system
+     * has reserved.  The pool grows by whole huge pages and fails to
+     * grow when none are left.
+     */
+    HUGETLB_PAGES = 2
+  };
+
+  /// Constructor
+  ACE_Local_Memory_Pool_Options (int huge_pages = NO_HUGE_PAGES,
+                                 bool populate = false,
+                                 int numa_node = -1,
+                                 size_t huge_page_size = ACE_DEFAULT_HUGE_PAGE_SIZE);
+
+  /// Whether the pool uses huge pages, and which kind.
+  int huge_pages_;
+
+  /// Fault the pages of each chunk in when it is acquired, so that the
+  /// first access to them doesn't take a page fault.
+  bool populate_;
+
+  /// NUMA node to place the pages of the pool on, with mbind(2), or
+  /// -1 to leave them to the memory policy of the process.
+  int numa_node_;
+
+  /// Size of the pages of a pool with @c HUGETLB_PAGES.
+  size_t huge_page_size_;
 };
 
 /**
@@ -116,13 +156,40 @@ public:
   ACE_ALLOC_HOOK_DECLARE;
 
 protected:
+  /// A chunk of anonymous memory, which is unmapped with its size.
+  struct Mapped_Chunk
+  {
+    char *addr_;
+    size_t size_;
+  };
+
+  /// Map, place and fault in a chunk of @a rounded_bytes.
+  void *map_chunk (size_t rounded_bytes);
+
   /// List of memory that we have allocated.
   ACE_Unbounded_Set<char *> allocated_chunks_;
 
+  /// List of memory that we have mapped.
+  ACE_Unbounded_Queue<Mapped_Chunk> mapped_chunks_;
+
   /// Implement the algorithm for rounding up the request to an
   /// appropriate chunksize.
   virtual size_t round_up (size_t nbytes);
 
+  /// Whether the pool uses huge pages, and which kind.
+  int huge_pages_;
+
+  /// Should the pages be faulted in when they are acquired?
+  bool populate_;
+
+  /// NUMA node the pages are placed on, or -1.
+  int numa_node_;
+
+  /// Size of the pages when @c huge_pages_ is @c HUGETLB_PAGES.
+  size_t huge_page_size_;
+
+  /// Map anonymous memory rather than allocate it with new?
+  bool map_chunks_;
 };
 
 ACE_END_VERSIONED_NAMESPACE_DECL
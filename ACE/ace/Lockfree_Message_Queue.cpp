@@ -0,0 +1,551 @@
+#include "ace/Lockfree_Message_Queue.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL) && defined (ACE_HAS_THREADS)
+
+#include "ace/Log_Category.h"
+#include "ace/Message_Block.h"
+#include "ace/Notification_Strategy.h"
+#include "ace/Numeric_Limits.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/Time_Value.h"
+
+#if defined (ACE_HAS_FUTEX)
+# include /**/ <linux/futex.h>
+# include /**/ <sys/syscall.h>
+# include /**/ <unistd.h>
+#else
+# include "ace/Guard_T.h"
+# include "ace/OS_NS_sys_time.h"
+#endif /* ACE_HAS_FUTEX */
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Lockfree_Message_Queue.inl"
+#endif /* __ACE_INLINE__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Lockfree_Message_Queue)
+
+#if defined (ACE_HAS_FUTEX)
+// The futex words are only shared between the threads of this
+// process.
+# if defined (FUTEX_PRIVATE_FLAG)
+static int const ace_lockfree_futex_wait = FUTEX_WAIT | FUTEX_PRIVATE_FLAG;
+static int const ace_lockfree_futex_wake = FUTEX_WAKE | FUTEX_PRIVATE_FLAG;
+# else
+static int const ace_lockfree_futex_wait = FUTEX_WAIT;
+static int const ace_lockfree_futex_wake = FUTEX_WAKE;
+# endif /* FUTEX_PRIVATE_FLAG */
+
+static inline long
+ace_lockfree_futex (ACE_UINT32 *word,
+                    int op,
+                    ACE_UINT32 value,
+                    const timespec *timeout)
+{
+  return ::syscall (SYS_futex, word, op, value, timeout, 0, 0);
+}
+#endif /* ACE_HAS_FUTEX */
+
+/// Number of blocks <flush> takes out of the ring at a time.
+static size_t const ace_lockfree_flush_batch = 64;
+
+ACE_Lockfree_Message_Queue::ACE_Lockfree_Message_Queue (size_t capacity,
+                                                        ACE_Notification_Strategy *ns)
+  : slots_ (0),
+    mask_ (0),
+    cur_bytes_ (0),
+    cur_length_ (0),
+    not_empty_ (0),
+    not_full_ (0),
+#if !defined (ACE_HAS_FUTEX)
+    wait_cond_ (wait_lock_),
+#endif /* !ACE_HAS_FUTEX */
+    notification_strategy_ (ns)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::ACE_Lockfree_Message_Queue");
+
+  // With a single slot a filled slot would look free to the producer
+  // of the next round.
+  size_t size = 2;
+  while (size < capacity)
+    size <<= 1;
+
+  this->state_ = ACE_Message_Queue_Base::ACTIVATED;
+  this->tail_.value_ = 0;
+  this->head_.value_ = 0;
+
+  ACE_NEW (this->slots_, Slot[size]);
+
+  for (size_t i = 0; i < size; ++i)
+    {
+      this->slots_[i].sequence_ = i;
+      this->slots_[i].item_ = 0;
+    }
+  this->mask_ = size - 1;
+}
+
+ACE_Lockfree_Message_Queue::~ACE_Lockfree_Message_Queue (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::~ACE_Lockfree_Message_Queue");
+  if (this->slots_ != 0)
+    this->flush ();
+  delete [] this->slots_;
+}
+
+int
+ACE_Lockfree_Message_Queue::close (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::close");
+  this->deactivate ();
+  return this->flush ();
+}
+
+int
+ACE_Lockfree_Message_Queue::flush (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::flush");
+  ACE_Message_Block *items[ace_lockfree_flush_batch];
+  int released = 0;
+
+  for (size_t n;
+       (n = this->pop_i (items, ace_lockfree_flush_batch)) > 0;
+       )
+    {
+      for (size_t i = 0; i < n; ++i)
+        items[i]->release ();
+      released += static_cast<int> (n);
+      this->wake_i (true);
+    }
+
+  return released;
+}
+
+void
+ACE_Lockfree_Message_Queue::wait_slot_i (Slot &slot, size_t sequence)
+{
+  int spins = 0;
+  while (__atomic_load_n (&slot.sequence_, __ATOMIC_ACQUIRE) != sequence)
+    if (++spins >= ACE_LOCKFREE_MESSAGE_QUEUE_SPIN_COUNT)
+      {
+        spins = 0;
+        ACE_OS::thr_yield ();
+      }
+}
+
+size_t
+ACE_Lockfree_Message_Queue::push_i (ACE_Message_Block *items[], size_t count)
+{
+  size_t const capacity = this->mask_ + 1;
+  size_t tail = __atomic_load_n (&this->tail_.value_, __ATOMIC_RELAXED);
+  size_t claimed = 0;
+
+  for (;;)
+    {
+      size_t const head = __atomic_load_n (&this->head_.value_, __ATOMIC_ACQUIRE);
+      size_t const used = tail - head;
+      if (used > capacity)
+        {
+          // The consumers went past the tail we read, read it again.
+          tail = __atomic_load_n (&this->tail_.value_, __ATOMIC_RELAXED);
+          continue;
+        }
+
+      claimed = capacity - used < count ? capacity - used : count;
+      if (claimed == 0)
+        return 0;
+
+      if (__atomic_compare_exchange_n (&this->tail_.value_,
+                                       &tail,
+                                       tail + claimed,
+                                       true,
+                                       __ATOMIC_RELAXED,
+                                       __ATOMIC_RELAXED))
+        break;
+    }
+
+  // Account for the blocks before they are published, a consumer may
+  // release them right after.
+  size_t bytes = 0;
+  size_t length = 0;
+  for (size_t i = 0; i < claimed; ++i)
+    {
+      size_t mb_bytes = 0;
+      size_t mb_length = 0;
+      items[i]->total_size_and_length (mb_bytes, mb_length);
+      bytes += mb_bytes;
+      length += mb_length;
+    }
+  __atomic_fetch_add (&this->cur_bytes_, bytes, __ATOMIC_RELAXED);
+  __atomic_fetch_add (&this->cur_length_, length, __ATOMIC_RELAXED);
+
+  for (size_t i = 0; i < claimed; ++i)
+    {
+      // The consumer of the previous round may still be emptying the
+      // slot.
+      Slot &slot = this->slots_[(tail + i) & this->mask_];
+      this->wait_slot_i (slot, tail + i);
+      slot.item_ = items[i];
+      __atomic_store_n (&slot.sequence_, tail + i + 1, __ATOMIC_RELEASE);
+    }
+
+  return claimed;
+}
+
+size_t
+ACE_Lockfree_Message_Queue::pop_i (ACE_Message_Block *items[], size_t count)
+{
+  size_t const capacity = this->mask_ + 1;
+  size_t head = __atomic_load_n (&this->head_.value_, __ATOMIC_RELAXED);
+  size_t claimed = 0;
+
+  for (;;)
+    {
+      size_t const tail = __atomic_load_n (&this->tail_.value_, __ATOMIC_ACQUIRE);
+      size_t const available = tail - head;
+      if (available > capacity)
+        {
+          // Other consumers moved the head since we read it.
+          head = __atomic_load_n (&this->head_.value_, __ATOMIC_RELAXED);
+          continue;
+        }
+
+      claimed = available < count ? available : count;
+      if (claimed == 0)
+        return 0;
+
+      if (__atomic_compare_exchange_n (&this->head_.value_,
+                                       &head,
+                                       head + claimed,
+                                       true,
+                                       __ATOMIC_RELAXED,
+                                       __ATOMIC_RELAXED))
+        break;
+    }
+
+  size_t bytes = 0;
+  size_t length = 0;
+  for (size_t i = 0; i < claimed; ++i)
+    {
+      // The producer may still be filling the slot.
+      Slot &slot = this->slots_[(head + i) & this->mask_];
+      this->wait_slot_i (slot, head + i + 1);
+      items[i] = slot.item_;
+      __atomic_store_n (&slot.sequence_, head + i + capacity, __ATOMIC_RELEASE);
+
+      size_t mb_bytes = 0;
+      size_t mb_length = 0;
+      items[i]->total_size_and_length (mb_bytes, mb_length);
+      bytes += mb_bytes;
+      length += mb_length;
+    }
+  __atomic_fetch_sub (&this->cur_bytes_, bytes, __ATOMIC_RELAXED);
+  __atomic_fetch_sub (&this->cur_length_, length, __ATOMIC_RELAXED);
+
+  return claimed;
+}
+
+int
+ACE_Lockfree_Message_Queue::wait_i (bool producer, ACE_Time_Value *timeout)
+{
+  ACE_UINT32 *const word = producer ? &this->not_full_ : &this->not_empty_;
+
+  // Set the sleeper flag in the low bit of the word, unless another
+  // thread already did, then look at the ring again: either the other
+  // side sees the flag after it moved, or we see it moved.
+  ACE_UINT32 value = __atomic_load_n (word, __ATOMIC_RELAXED);
+  while ((value & 1U) == 0
+         && !__atomic_compare_exchange_n (word,
+                                          &value,
+                                          value | 1U,
+                                          true,
+                                          __ATOMIC_SEQ_CST,
+                                          __ATOMIC_RELAXED))
+    ;
+  value |= 1U;
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+
+  if (this->state () == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  if (!(producer ? this->is_full () : this->is_empty ()))
+    return 0;
+
+  ACE_Time_Value remaining;
+  if (timeout != 0)
+    {
+      remaining = timeout->to_relative_time ();
+      if (remaining <= ACE_Time_Value::zero)
+        {
+          errno = EWOULDBLOCK;
+          return -1;
+        }
+    }
+
+#if defined (ACE_HAS_FUTEX)
+  timespec_t ts;
+  if (timeout != 0)
+    ts = remaining;
+  if (ace_lockfree_futex (word,
+                          ace_lockfree_futex_wait,
+                          value,
+                          timeout == 0 ? 0 : &ts) == -1
+      && errno == ETIMEDOUT)
+    {
+      errno = EWOULDBLOCK;
+      return -1;
+    }
+#else
+  ACE_Time_Value deadline;
+  if (timeout != 0)
+    deadline = ACE_OS::gettimeofday () + remaining;
+
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->wait_lock_, -1);
+    while (__atomic_load_n (word, __ATOMIC_RELAXED) == value)
+      if (this->wait_cond_.wait (timeout == 0 ? 0 : &deadline) == -1
+          && errno == ETIME)
+        {
+          errno = EWOULDBLOCK;
+          return -1;
+        }
+  }
+#endif /* ACE_HAS_FUTEX */
+
+  // Like ACE_Message_Queue, a thread that was woken up gives up when
+  // the queue was deactivated or pulsed meanwhile.
+  if (this->state () != ACE_Message_Queue_Base::ACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  return 0;
+}
+
+void
+ACE_Lockfree_Message_Queue::wake_i (bool producers)
+{
+  ACE_UINT32 *const word = producers ? &this->not_full_ : &this->not_empty_;
+
+  // Pairs with the fence in <wait_i>.
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+  ACE_UINT32 value = __atomic_load_n (word, __ATOMIC_RELAXED);
+  if ((value & 1U) == 0)
+    return;
+
+  // Clearing the flag moves the word on, so a thread about to sleep
+  // doesn't.  If that fails another thread cleared it and woke the
+  // sleepers.  All of them are woken up, as the flag doesn't tell how
+  // many there are.
+  if (!__atomic_compare_exchange_n (word,
+                                    &value,
+                                    value + 1U,
+                                    false,
+                                    __ATOMIC_SEQ_CST,
+                                    __ATOMIC_RELAXED))
+    return;
+
+#if defined (ACE_HAS_FUTEX)
+  ace_lockfree_futex (word,
+                      ace_lockfree_futex_wake,
+                      static_cast<ACE_UINT32> (ACE_Numeric_Limits<int>::max ()),
+                      0);
+#else
+  ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->wait_lock_);
+  this->wait_cond_.broadcast ();
+#endif /* ACE_HAS_FUTEX */
+}
+
+int
+ACE_Lockfree_Message_Queue::enqueue_tail (ACE_Message_Block *new_item,
+                                          ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::enqueue_tail");
+
+  if (new_item == 0)
+    return -1;
+
+  if (this->enqueue_tail_n (&new_item, 1, timeout) == -1)
+    return -1;
+
+  return static_cast<int> (this->count_i ());
+}
+
+int
+ACE_Lockfree_Message_Queue::enqueue_tail_n (ACE_Message_Block *new_items[],
+                                            size_t count,
+                                            ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::enqueue_tail_n");
+
+  if (this->state () == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  size_t done = 0;
+  while (done < count)
+    {
+      size_t const pushed = this->push_i (new_items + done, count - done);
+      if (pushed > 0)
+        {
+          done += pushed;
+          this->wake_i (false);
+        }
+      else if (this->wait_i (true, timeout) == -1)
+        break;
+    }
+
+  if (done == 0)
+    return count == 0 ? 0 : -1;
+
+  if (this->notification_strategy_ != 0)
+    this->notification_strategy_->notify ();
+
+  return static_cast<int> (done);
+}
+
+int
+ACE_Lockfree_Message_Queue::dequeue_head (ACE_Message_Block *&first_item,
+                                          ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::dequeue_head");
+
+  if (this->dequeue_head_n (&first_item, 1, timeout) == -1)
+    return -1;
+
+  return static_cast<int> (this->count_i ());
+}
+
+int
+ACE_Lockfree_Message_Queue::dequeue_head_n (ACE_Message_Block *items[],
+                                            size_t count,
+                                            ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::dequeue_head_n");
+
+  if (this->state () == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  if (count == 0)
+    return 0;
+
+  for (;;)
+    {
+      size_t const popped = this->pop_i (items, count);
+      if (popped > 0)
+        {
+          this->wake_i (true);
+          return static_cast<int> (popped);
+        }
+
+      if (this->wait_i (false, timeout) == -1)
+        return -1;
+    }
+}
+
+int
+ACE_Lockfree_Message_Queue::deactivate (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::deactivate");
+  return this->deactivate_i (false);
+}
+
+int
+ACE_Lockfree_Message_Queue::pulse (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::pulse");
+  return this->deactivate_i (true);
+}
+
+int
+ACE_Lockfree_Message_Queue::deactivate_i (bool pulse)
+{
+  int previous_state = this->state ();
+  int const new_state = pulse
+    ? ACE_Message_Queue_Base::PULSED
+    : ACE_Message_Queue_Base::DEACTIVATED;
+
+  // A pulse leaves a deactivated queue alone.
+  while (previous_state != ACE_Message_Queue_Base::DEACTIVATED
+         && !__atomic_compare_exchange_n (&this->state_,
+                                          &previous_state,
+                                          new_state,
+                                          false,
+                                          __ATOMIC_SEQ_CST,
+                                          __ATOMIC_SEQ_CST))
+    ;
+
+  if (previous_state != ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      // Wake up all waiters.
+      this->wake_i (false);
+      this->wake_i (true);
+    }
+
+  return previous_state;
+}
+
+int
+ACE_Lockfree_Message_Queue::activate (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::activate");
+  return __atomic_exchange_n (&this->state_,
+                              static_cast<int> (ACE_Message_Queue_Base::ACTIVATED),
+                              __ATOMIC_SEQ_CST);
+}
+
+void
+ACE_Lockfree_Message_Queue::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  switch (this->state_)
+    {
+    case ACE_Message_Queue_Base::ACTIVATED:
+      ACELIB_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("state = ACTIVATED\n")));
+      break;
+    case ACE_Message_Queue_Base::DEACTIVATED:
+      ACELIB_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("state = DEACTIVATED\n")));
+      break;
+    case ACE_Message_Queue_Base::PULSED:
+      ACELIB_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("state = PULSED\n")));
+      break;
+    }
+
+  ACELIB_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("capacity = %B\n")
+              ACE_TEXT ("head_ = %B\n")
+              ACE_TEXT ("tail_ = %B\n")
+              ACE_TEXT ("cur_bytes_ = %B\n")
+              ACE_TEXT ("cur_length_ = %B\n")
+              ACE_TEXT ("not_empty_ = %u\n")
+              ACE_TEXT ("not_full_ = %u\n"),
+              this->mask_ + 1,
+              this->head_.value_,
+              this->tail_.value_,
+              this->cur_bytes_,
+              this->cur_length_,
+              this->not_empty_,
+              this->not_full_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL && ACE_HAS_THREADS */
@@ -0,0 +1,274 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Lockfree_Message_Queue.h
+ *
+ *  Bounded multi-producer/multi-consumer message queue that doesn't
+ *  take a lock to enqueue or dequeue.
+ */
+//=============================================================================
+
+#ifndef ACE_LOCKFREE_MESSAGE_QUEUE_H
+#define ACE_LOCKFREE_MESSAGE_QUEUE_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/Message_Queue.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL) && defined (ACE_HAS_THREADS)
+
+#include "ace/Basic_Types.h"
+
+#if !defined (ACE_HAS_FUTEX)
+# include "ace/Thread_Mutex.h"
+# include "ace/Condition_Thread_Mutex.h"
+#endif /* !ACE_HAS_FUTEX */
+
+/// Default number of messages an ACE_Lockfree_Message_Queue holds.
+#if !defined (ACE_LOCKFREE_MESSAGE_QUEUE_CAPACITY)
+# define ACE_LOCKFREE_MESSAGE_QUEUE_CAPACITY 1024
+#endif /* ACE_LOCKFREE_MESSAGE_QUEUE_CAPACITY */
+
+/// Number of times a thread polls a slot that another thread has
+/// claimed but not filled or emptied yet before it yields the
+/// processor.
+#if !defined (ACE_LOCKFREE_MESSAGE_QUEUE_SPIN_COUNT)
+# define ACE_LOCKFREE_MESSAGE_QUEUE_SPIN_COUNT 100
+#endif /* ACE_LOCKFREE_MESSAGE_QUEUE_SPIN_COUNT */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Lockfree_Message_Queue
+ *
+ * @brief Message queue on a bounded ring that producers and consumers
+ * share without a lock.
+ *
+ * The queue holds up to <capacity> message blocks, rounded up to a
+ * power of two, in a ring of slots that carry a sequence number each.
+ * An enqueue claims slots by moving the tail position with a single
+ * compare and swap, fills them and publishes each one through its
+ * sequence number; a dequeue does the same on the head position.  The
+ * batch calls <enqueue_tail_n> and <dequeue_head_n> claim several
+ * slots at once, so the shared positions are only touched once per
+ * batch.
+ *
+ * Threads only block when the queue is empty or full.  They then
+ * sleep on a futex, or on a condition variable where futexes aren't
+ * available, and the other side only makes the wake up call when it
+ * sees a sleeper.
+ *
+ * @note Being a plain FIFO ring, the queue lacks some of the features
+ * of ACE_Message_Queue:
+ * * The flow control is on the number of messages, the water marks
+ *   are not used.
+ * * <enqueue_prio> and <enqueue_deadline> enqueue at the tail,
+ *   <dequeue_prio> and <dequeue_deadline> dequeue at the head.
+ * * <enqueue_head>, <dequeue_tail> and <peek_dequeue_head> are not
+ *   supported.
+ * * Each message block takes a slot, the blocks chained through
+ *   <next> are not enqueued as separate messages.
+ * * The queue can't be iterated.
+ */
+class ACE_Export ACE_Lockfree_Message_Queue : public ACE_Message_Queue_Base
+{
+public:
+  /// Create a queue that holds up to @a capacity message blocks.
+  ACE_Lockfree_Message_Queue (size_t capacity = ACE_LOCKFREE_MESSAGE_QUEUE_CAPACITY,
+                              ACE_Notification_Strategy *ns = 0);
+
+  /// Releases the messages left in the queue.
+  virtual ~ACE_Lockfree_Message_Queue (void);
+
+  /// Deactivate the queue and release the messages in it.
+  /// @retval The number of messages released.
+  virtual int close (void);
+
+  /// Release the messages in the queue, without deactivating it.
+  /// @retval The number of messages released.
+  virtual int flush (void);
+
+  // = Enqueue and dequeue methods.
+
+  /// Not supported, a message can only be looked at once it has been
+  /// dequeued.
+  virtual int peek_dequeue_head (ACE_Message_Block *&first_item,
+                                 ACE_Time_Value *timeout = 0);
+
+  /**
+   * Enqueue @a new_item at the tail of the queue, waiting until the
+   * absolute time in @a timeout for a free slot.  Returns the number
+   * of messages in the queue, or -1 with @c errno @c ESHUTDOWN if the
+   * queue is deactivated or @c EWOULDBLOCK if the time elapsed.
+   */
+  virtual int enqueue_tail (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+  virtual int enqueue (ACE_Message_Block *new_item,
+                       ACE_Time_Value *timeout = 0);
+
+  /**
+   * Enqueue the @a count blocks of @a new_items in order at the tail
+   * of the queue, waiting until the absolute time in @a timeout for
+   * free slots.  Returns the number of blocks enqueued, which is less
+   * than @a count if the time elapsed or the queue was deactivated
+   * half way through, or -1 if none was.
+   */
+  int enqueue_tail_n (ACE_Message_Block *new_items[],
+                      size_t count,
+                      ACE_Time_Value *timeout = 0);
+
+  /**
+   * Dequeue the message block at the head of the queue, waiting
+   * until the absolute time in @a timeout for one.  Returns the
+   * number of messages left in the queue, or -1 with @c errno
+   * @c ESHUTDOWN if the queue is deactivated or @c EWOULDBLOCK if
+   * the time elapsed.
+   */
+  virtual int dequeue_head (ACE_Message_Block *&first_item,
+                            ACE_Time_Value *timeout = 0);
+  virtual int dequeue (ACE_Message_Block *&first_item,
+                       ACE_Time_Value *timeout = 0);
+
+  /**
+   * Dequeue up to @a count message blocks from the head of the queue
+   * into @a items, waiting until the absolute time in @a timeout for
+   * the first one.  Returns the number of blocks dequeued, or -1 if
+   * none was.
+   */
+  int dequeue_head_n (ACE_Message_Block *items[],
+                      size_t count,
+                      ACE_Time_Value *timeout = 0);
+
+  // = Check if queue is full/empty.
+  /// True if all the slots of the queue are taken, else false.
+  virtual bool is_full (void);
+
+  /// True if queue is empty, else false.
+  virtual bool is_empty (void);
+
+  // = Queue statistic methods.
+  virtual size_t message_bytes (void);
+  virtual size_t message_length (void);
+  virtual size_t message_count (void);
+  virtual void message_bytes (size_t new_size);
+  virtual void message_length (size_t new_length);
+
+  /// Number of message blocks the queue holds.
+  size_t capacity (void) const;
+
+  // = Activation control methods.
+  virtual int deactivate (void);
+  virtual int activate (void);
+  virtual int pulse (void);
+  virtual int state (void);
+  virtual int deactivated (void);
+
+  // = Notification hook.
+  virtual ACE_Notification_Strategy *notification_strategy (void);
+  virtual void notification_strategy (ACE_Notification_Strategy *s);
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  enum
+  {
+    CACHE_LINE = 64
+  };
+
+  struct Slot
+  {
+    /// Position the slot can be filled at, or that position plus one
+    /// once it is filled.
+    size_t sequence_;
+    ACE_Message_Block *item_;
+  };
+
+  /// A counter alone on its cache line.
+  struct Position
+  {
+    size_t value_;
+    char pad_[CACHE_LINE - sizeof (size_t)];
+  };
+
+  /// Claim up to @a count slots at the tail and fill them with
+  /// @a items.  Returns the number of blocks enqueued.
+  size_t push_i (ACE_Message_Block *items[], size_t count);
+
+  /// Claim up to @a count slots at the head and empty them into
+  /// @a items.  Returns the number of blocks dequeued.
+  size_t pop_i (ACE_Message_Block *items[], size_t count);
+
+  /// Wait for @a slot to reach @a sequence, which another thread that
+  /// claimed it is about to publish.
+  void wait_slot_i (Slot &slot, size_t sequence);
+
+  /// Sleep until the other side moved or the absolute time in
+  /// @a timeout elapsed.  @a producer tells whether the caller waits
+  /// for a free slot or for a message.  Returns -1 with @c errno set
+  /// on timeout or when the queue isn't active any more.
+  int wait_i (bool producer, ACE_Time_Value *timeout);
+
+  /// Wake the threads that sleep in <wait_i> as producers or as
+  /// consumers, if there are any.
+  void wake_i (bool producers);
+
+  /// Move the queue to the PULSED (@a pulse is true) or DEACTIVATED
+  /// state and wake all the waiting threads.  Returns the previous
+  /// state.
+  int deactivate_i (bool pulse);
+
+  /// Number of messages between the claimed head and tail positions.
+  size_t count_i (void) const;
+
+  /// The ring and the mask of its index.
+  Slot *slots_;
+  size_t mask_;
+
+  /// Claimed positions of the producers and of the consumers.
+  Position tail_;
+  Position head_;
+
+  /// Accounting of the messages in the queue.
+  size_t cur_bytes_;
+  size_t cur_length_;
+
+  /// Futex words of the consumers that wait for a message and of the
+  /// producers that wait for a free slot.  The low bit is set while a
+  /// thread sleeps on the word, the rest counts the wake ups.
+  ACE_UINT32 not_empty_;
+  ACE_UINT32 not_full_;
+
+#if !defined (ACE_HAS_FUTEX)
+  /// Where the waiting threads sleep without futexes.
+  ACE_Thread_Mutex wait_lock_;
+  ACE_Condition_Thread_Mutex wait_cond_;
+#endif /* !ACE_HAS_FUTEX */
+
+  /// The notification strategy used when a new message is enqueued.
+  ACE_Notification_Strategy *notification_strategy_;
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Lockfree_Message_Queue &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Lockfree_Message_Queue (const ACE_Lockfree_Message_Queue &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Lockfree_Message_Queue.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL && ACE_HAS_THREADS */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_LOCKFREE_MESSAGE_QUEUE_H */
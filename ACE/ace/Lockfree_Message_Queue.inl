@@ -0,0 +1,124 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE size_t
+ACE_Lockfree_Message_Queue::count_i (void) const
+{
+  // The head never passes the tail, so reading it first keeps the
+  // difference from going negative.  Dequeues that raced with the
+  // two reads can make it exceed the capacity though.
+  size_t const head = __atomic_load_n (&this->head_.value_, __ATOMIC_ACQUIRE);
+  size_t const tail = __atomic_load_n (&this->tail_.value_, __ATOMIC_ACQUIRE);
+  size_t const count = tail - head;
+  return count > this->mask_ ? this->mask_ + 1 : count;
+}
+
+ACE_INLINE size_t
+ACE_Lockfree_Message_Queue::capacity (void) const
+{
+  return this->mask_ + 1;
+}
+
+ACE_INLINE bool
+ACE_Lockfree_Message_Queue::is_full (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::is_full");
+  return this->count_i () > this->mask_;
+}
+
+ACE_INLINE bool
+ACE_Lockfree_Message_Queue::is_empty (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::is_empty");
+  return this->count_i () == 0;
+}
+
+ACE_INLINE size_t
+ACE_Lockfree_Message_Queue::message_bytes (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::message_bytes");
+  return __atomic_load_n (&this->cur_bytes_, __ATOMIC_RELAXED);
+}
+
+ACE_INLINE size_t
+ACE_Lockfree_Message_Queue::message_length (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::message_length");
+  return __atomic_load_n (&this->cur_length_, __ATOMIC_RELAXED);
+}
+
+ACE_INLINE size_t
+ACE_Lockfree_Message_Queue::message_count (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::message_count");
+  return this->count_i ();
+}
+
+ACE_INLINE void
+ACE_Lockfree_Message_Queue::message_bytes (size_t new_value)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::message_bytes");
+  __atomic_store_n (&this->cur_bytes_, new_value, __ATOMIC_RELAXED);
+}
+
+ACE_INLINE void
+ACE_Lockfree_Message_Queue::message_length (size_t new_value)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::message_length");
+  __atomic_store_n (&this->cur_length_, new_value, __ATOMIC_RELAXED);
+}
+
+ACE_INLINE int
+ACE_Lockfree_Message_Queue::enqueue (ACE_Message_Block *new_item,
+                                     ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::enqueue");
+  return this->enqueue_tail (new_item, timeout);
+}
+
+ACE_INLINE int
+ACE_Lockfree_Message_Queue::dequeue (ACE_Message_Block *&first_item,
+                                     ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::dequeue");
+  return this->dequeue_head (first_item, timeout);
+}
+
+ACE_INLINE int
+ACE_Lockfree_Message_Queue::peek_dequeue_head (ACE_Message_Block *&first_item,
+                                               ACE_Time_Value *timeout)
+{
+  ACE_UNUSED_ARG (first_item);
+  ACE_UNUSED_ARG (timeout);
+  ACE_NOTSUP_RETURN (-1);
+}
+
+ACE_INLINE int
+ACE_Lockfree_Message_Queue::state (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::state");
+  return __atomic_load_n (&this->state_, __ATOMIC_ACQUIRE);
+}
+
+ACE_INLINE int
+ACE_Lockfree_Message_Queue::deactivated (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::deactivated");
+  return this->state () == ACE_Message_Queue_Base::DEACTIVATED;
+}
+
+ACE_INLINE ACE_Notification_Strategy *
+ACE_Lockfree_Message_Queue::notification_strategy (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::notification_strategy");
+  return this->notification_strategy_;
+}
+
+ACE_INLINE void
+ACE_Lockfree_Message_Queue::notification_strategy (ACE_Notification_Strategy *s)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue::notification_strategy");
+  this->notification_strategy_ = s;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
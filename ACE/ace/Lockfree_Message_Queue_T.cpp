@@ -0,0 +1,345 @@
+#ifndef ACE_LOCKFREE_MESSAGE_QUEUE_T_CPP
+#define ACE_LOCKFREE_MESSAGE_QUEUE_T_CPP
+
+#include "ace/Lockfree_Message_Queue_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL) && defined (ACE_HAS_THREADS)
+
+#include "ace/Log_Category.h"
+#include "ace/Notification_Strategy.h"
+#include "ace/OS_NS_errno.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tyc(ACE_Lockfree_Message_Queue_T)
+ACE_ALLOC_HOOK_DEFINE_Tyc(ACE_Lockfree_Task)
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::ACE_Lockfree_Message_Queue_T (size_t capacity,
+                                                                                       ACE_Notification_Strategy *ns)
+  : ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY> (ACE_Message_Queue_Base::DEFAULT_HWM,
+                                                   ACE_Message_Queue_Base::DEFAULT_LWM,
+                                                   0),
+    queue_ (capacity, ns)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::ACE_Lockfree_Message_Queue_T");
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::~ACE_Lockfree_Message_Queue_T (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::~ACE_Lockfree_Message_Queue_T");
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::open (size_t hwm,
+                                                               size_t lwm,
+                                                               ACE_Notification_Strategy *ns)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::open");
+  this->high_water_mark_ = hwm;
+  this->low_water_mark_ = lwm;
+  this->queue_.notification_strategy (ns);
+  this->queue_.activate ();
+  return 0;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::close (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::close");
+  return this->queue_.close ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::flush (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::flush");
+  return this->queue_.flush ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::flush_i (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::flush_i");
+  return this->queue_.flush ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::peek_dequeue_head (ACE_Message_Block *&first_item,
+                                                                            ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::peek_dequeue_head");
+  return this->queue_.peek_dequeue_head (first_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue_prio (ACE_Message_Block *new_item,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue_prio");
+  return this->queue_.enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue_deadline (ACE_Message_Block *new_item,
+                                                                           ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue_deadline");
+  return this->queue_.enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue (ACE_Message_Block *new_item,
+                                                                  ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue");
+  return this->queue_.enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail (ACE_Message_Block *new_item,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail");
+  return this->queue_.enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue_head (ACE_Message_Block *new_item,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_UNUSED_ARG (new_item);
+  ACE_UNUSED_ARG (timeout);
+  ACE_NOTSUP_RETURN (-1);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue (ACE_Message_Block *&first_item,
+                                                                  ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue");
+  return this->queue_.dequeue_head (first_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head (ACE_Message_Block *&first_item,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head");
+  return this->queue_.dequeue_head (first_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue_prio (ACE_Message_Block *&first_item,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue_prio");
+  return this->queue_.dequeue_head (first_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue_tail (ACE_Message_Block *&dequeued,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_UNUSED_ARG (dequeued);
+  ACE_UNUSED_ARG (timeout);
+  ACE_NOTSUP_RETURN (-1);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue_deadline (ACE_Message_Block *&dequeued,
+                                                                           ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue_deadline");
+  return this->queue_.dequeue_head (dequeued, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail_n (ACE_Message_Block *new_items[],
+                                                                         size_t count,
+                                                                         ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail_n");
+  return this->queue_.enqueue_tail_n (new_items, count, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head_n (ACE_Message_Block *items[],
+                                                                         size_t count,
+                                                                         ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head_n");
+  return this->queue_.dequeue_head_n (items, count, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::is_full (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::is_full");
+  return this->queue_.is_full ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::is_empty (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::is_empty");
+  return this->queue_.is_empty ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::message_bytes (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::message_bytes");
+  return this->queue_.message_bytes ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::message_length (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::message_length");
+  return this->queue_.message_length ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::message_count (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::message_count");
+  return this->queue_.message_count ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::message_bytes (size_t new_size)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::message_bytes");
+  this->queue_.message_bytes (new_size);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::message_length (size_t new_length)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::message_length");
+  this->queue_.message_length (new_length);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::deactivate (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::deactivate");
+  return this->queue_.deactivate ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::activate (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::activate");
+  return this->queue_.activate ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::pulse (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::pulse");
+  return this->queue_.pulse ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::state (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::state");
+  return this->queue_.state ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::deactivated (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::deactivated");
+  return this->queue_.deactivated ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::notify (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::notify");
+  ACE_Notification_Strategy *const ns = this->queue_.notification_strategy ();
+  return ns == 0 ? 0 : ns->notify ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> ACE_Notification_Strategy *
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::notification_strategy (void)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::notification_strategy");
+  return this->queue_.notification_strategy ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::notification_strategy (ACE_Notification_Strategy *s)
+{
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::notification_strategy");
+  this->queue_.notification_strategy (s);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> ACE_Lockfree_Message_Queue &
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::queue (void)
+{
+  return this->queue_;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY>::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("high_water_mark = %B\n")
+              ACE_TEXT ("low_water_mark = %B\n"),
+              this->high_water_mark_,
+              this->low_water_mark_));
+  this->queue_.dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Lockfree_Task<ACE_SYNCH_USE, TIME_POLICY>::ACE_Lockfree_Task (ACE_Thread_Manager *thr_mgr,
+                                                                 size_t capacity)
+  : ACE_Task<ACE_SYNCH_USE, TIME_POLICY> (thr_mgr, make_queue (capacity)),
+    lockfree_queue_ (0)
+{
+  ACE_TRACE ("ACE_Lockfree_Task<ACE_SYNCH_USE, TIME_POLICY>::ACE_Lockfree_Task");
+
+  // If the queue couldn't be allocated ACE_Task made one of its own,
+  // which it already deletes.
+  if (!this->delete_msg_queue_)
+    {
+      this->lockfree_queue_ = static_cast<QUEUE *> (this->msg_queue_);
+      this->delete_msg_queue_ = true;
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+typename ACE_Lockfree_Task<ACE_SYNCH_USE, TIME_POLICY>::QUEUE *
+ACE_Lockfree_Task<ACE_SYNCH_USE, TIME_POLICY>::make_queue (size_t capacity)
+{
+  QUEUE *queue = 0;
+  ACE_NEW_NORETURN (queue, QUEUE (capacity));
+  return queue;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+typename ACE_Lockfree_Task<ACE_SYNCH_USE, TIME_POLICY>::QUEUE *
+ACE_Lockfree_Task<ACE_SYNCH_USE, TIME_POLICY>::lockfree_queue (void)
+{
+  return this->msg_queue_ == this->lockfree_queue_ ? this->lockfree_queue_ : 0;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL && ACE_HAS_THREADS */
+
+#endif /* ACE_LOCKFREE_MESSAGE_QUEUE_T_CPP */
@@ -0,0 +1,192 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Lockfree_Message_Queue_T.h
+ *
+ *  Lets an ACE_Task queue its messages in an ACE_Lockfree_Message_Queue.
+ */
+//=============================================================================
+
+#ifndef ACE_LOCKFREE_MESSAGE_QUEUE_T_H
+#define ACE_LOCKFREE_MESSAGE_QUEUE_T_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/Lockfree_Message_Queue.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL) && defined (ACE_HAS_THREADS)
+
+#include "ace/Task_T.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Lockfree_Message_Queue_T
+ *
+ * @brief An ACE_Message_Queue that keeps its messages in an
+ * ACE_Lockfree_Message_Queue.
+ *
+ * All the enqueue and dequeue methods are redirected to the lock-free
+ * queue, so the queue can be handed to anything that takes an
+ * ACE_Message_Queue, such as ACE_Task, ACE_Module or ACE_Stream.  The
+ * queue is thread safe whatever the synchronization strategy is, it
+ * only takes the strategy so that it fits the tasks built on it.
+ *
+ * The limits of ACE_Lockfree_Message_Queue apply: the water marks are
+ * kept but the flow control is on the <capacity> given to the
+ * constructor, and the queue can't be iterated.  In particular
+ * ACE_Task::ungetq() isn't supported.
+ */
+template <ACE_SYNCH_DECL, class TIME_POLICY = ACE_System_Time_Policy>
+class ACE_Lockfree_Message_Queue_T
+  : public ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>
+{
+public:
+  /// Create a queue that holds up to @a capacity message blocks.
+  ACE_Lockfree_Message_Queue_T (size_t capacity = ACE_LOCKFREE_MESSAGE_QUEUE_CAPACITY,
+                                ACE_Notification_Strategy *ns = 0);
+
+  /// Release the messages left in the queue.
+  virtual ~ACE_Lockfree_Message_Queue_T (void);
+
+  /// Record the water marks and the notification strategy and
+  /// activate the queue.  The capacity doesn't change.
+  virtual int open (size_t hwm = ACE_Message_Queue_Base::DEFAULT_HWM,
+                    size_t lwm = ACE_Message_Queue_Base::DEFAULT_LWM,
+                    ACE_Notification_Strategy *ns = 0);
+
+  virtual int close (void);
+  virtual int flush (void);
+  virtual int flush_i (void);
+
+  // = Enqueue and dequeue methods.
+  virtual int peek_dequeue_head (ACE_Message_Block *&first_item,
+                                 ACE_Time_Value *timeout = 0);
+  virtual int enqueue_prio (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+  virtual int enqueue_deadline (ACE_Message_Block *new_item,
+                                ACE_Time_Value *timeout = 0);
+  virtual int enqueue (ACE_Message_Block *new_item,
+                       ACE_Time_Value *timeout = 0);
+  virtual int enqueue_tail (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+  virtual int enqueue_head (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+  virtual int dequeue (ACE_Message_Block *&first_item,
+                       ACE_Time_Value *timeout = 0);
+  virtual int dequeue_head (ACE_Message_Block *&first_item,
+                            ACE_Time_Value *timeout = 0);
+  virtual int dequeue_prio (ACE_Message_Block *&first_item,
+                            ACE_Time_Value *timeout = 0);
+  virtual int dequeue_tail (ACE_Message_Block *&dequeued,
+                            ACE_Time_Value *timeout = 0);
+  virtual int dequeue_deadline (ACE_Message_Block *&dequeued,
+                                ACE_Time_Value *timeout = 0);
+
+  /// Enqueue @a count blocks at once.
+  /// @sa ACE_Lockfree_Message_Queue::enqueue_tail_n()
+  int enqueue_tail_n (ACE_Message_Block *new_items[],
+                      size_t count,
+                      ACE_Time_Value *timeout = 0);
+
+  /// Dequeue up to @a count blocks at once.
+  /// @sa ACE_Lockfree_Message_Queue::dequeue_head_n()
+  int dequeue_head_n (ACE_Message_Block *items[],
+                      size_t count,
+                      ACE_Time_Value *timeout = 0);
+
+  // = Check if queue is full/empty.
+  virtual bool is_full (void);
+  virtual bool is_empty (void);
+
+  // = Queue statistic methods.
+  virtual size_t message_bytes (void);
+  virtual size_t message_length (void);
+  virtual size_t message_count (void);
+  virtual void message_bytes (size_t new_size);
+  virtual void message_length (size_t new_length);
+
+  // = Activation control methods.
+  virtual int deactivate (void);
+  virtual int activate (void);
+  virtual int pulse (void);
+  virtual int state (void);
+  virtual int deactivated (void);
+
+  // = Notification hook.
+  virtual int notify (void);
+  virtual ACE_Notification_Strategy *notification_strategy (void);
+  virtual void notification_strategy (ACE_Notification_Strategy *s);
+
+  /// The queue that holds the messages.
+  ACE_Lockfree_Message_Queue &queue (void);
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// The queue that holds the messages.
+  ACE_Lockfree_Message_Queue queue_;
+};
+
+/**
+ * @class ACE_Lockfree_Task
+ *
+ * @brief An ACE_Task whose message queue is an
+ * ACE_Lockfree_Message_Queue_T.
+ *
+ * A task that derives from this class instead of ACE_Task puts and
+ * gets its messages without taking a lock, and otherwise runs
+ * unchanged, as long as it doesn't return messages to its queue with
+ * <ungetq>.  The batch calls of the queue are reached through
+ * <lockfree_queue>.
+ */
+template <ACE_SYNCH_DECL, class TIME_POLICY = ACE_System_Time_Policy>
+class ACE_Lockfree_Task : public ACE_Task<ACE_SYNCH_USE, TIME_POLICY>
+{
+public:
+  typedef ACE_Lockfree_Message_Queue_T<ACE_SYNCH_USE, TIME_POLICY> QUEUE;
+
+  /// Create a task whose queue holds up to @a capacity message
+  /// blocks.
+  ACE_Lockfree_Task (ACE_Thread_Manager *thr_mgr = 0,
+                     size_t capacity = ACE_LOCKFREE_MESSAGE_QUEUE_CAPACITY);
+
+  /// The queue the task was created with, 0 if it was replaced with
+  /// <msg_queue>.
+  QUEUE *lockfree_queue (void);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  /// Allocate the queue before the ACE_Task base is built.
+  static QUEUE *make_queue (size_t capacity);
+
+  /// The queue allocated by the constructor.
+  QUEUE *lockfree_queue_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Lockfree_Message_Queue_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Lockfree_Message_Queue_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL && ACE_HAS_THREADS */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_LOCKFREE_MESSAGE_QUEUE_T_H */
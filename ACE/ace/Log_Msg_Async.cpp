@@ -0,0 +1,372 @@
+#include "ace/Log_Msg_Async.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL) && defined (ACE_HAS_THREADS)
+
+#include "ace/Guard_T.h"
+#include "ace/Log_Priority.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Thread.h"
+#include "ace/Time_Value.h"
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Log_Msg_Async.inl"
+#endif /* __ACE_INLINE__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Log_Msg_Async)
+
+#if defined (ACE_HAS_THR_C_DEST)
+extern "C"
+#endif /* ACE_HAS_THR_C_DEST */
+void
+ACE_Log_Msg_Async_detach (void *ring)
+{
+  ACE_Log_Msg_Async::detach (ring);
+}
+
+// Bytes a record of @a size bytes takes in a ring, the records are
+// kept aligned for their header.
+static inline size_t
+ace_log_msg_async_space (size_t size)
+{
+  return (size + 7) & ~size_t (7);
+}
+
+ACE_Log_Msg_Async::ACE_Log_Msg_Async (ACE_Log_Msg_Backend *backend,
+                                      size_t ring_size,
+                                      size_t max_rings)
+  : backend_ (backend),
+    ring_size_ (1024),
+    max_record_ (0),
+    rings_ (0),
+    max_rings_ (0),
+    key_ (),
+    dropped_ (0),
+    flush_priorities_ (LM_CRITICAL | LM_ALERT | LM_EMERGENCY),
+    thr_handle_ (),
+    running_ (false),
+    stop_ (0)
+{
+  while (this->ring_size_ < ring_size)
+    this->ring_size_ <<= 1;
+
+  // A record may take a quarter of the ring, so a thread that logs a
+  // long message doesn't lose the ring for the short ones.
+  this->max_record_ = this->ring_size_ / 4;
+
+  if (ACE_Thread::keycreate (&this->key_, &ACE_Log_Msg_Async_detach) != 0)
+    return;
+
+  ACE_NEW_NORETURN (this->rings_, Ring[max_rings]);
+  if (this->rings_ == 0)
+    return;
+
+  for (size_t i = 0; i != max_rings; ++i)
+    {
+      this->rings_[i].head_.value_ = 0;
+      this->rings_[i].tail_.value_ = 0;
+      this->rings_[i].buffer_ = 0;
+      this->rings_[i].owned_ = 0;
+      this->rings_[i].detached_ = 0;
+      this->rings_[i].draining_ = 0;
+    }
+
+  this->max_rings_ = max_rings;
+}
+
+ACE_Log_Msg_Async::~ACE_Log_Msg_Async (void)
+{
+  if (this->running_)
+    this->close ();
+
+  if (this->rings_ != 0)
+    {
+      ACE_Thread::keyfree (this->key_);
+
+      for (size_t i = 0; i != this->max_rings_; ++i)
+        delete [] this->rings_[i].buffer_;
+
+      delete [] this->rings_;
+    }
+}
+
+int
+ACE_Log_Msg_Async::open (const ACE_TCHAR *logger_key)
+{
+  int const result = this->backend_->open (logger_key);
+
+  if (!this->running_)
+    {
+      __atomic_store_n (&this->stop_, 0, __ATOMIC_RELAXED);
+
+      if (ACE_Thread::spawn (&ACE_Log_Msg_Async::svc_run,
+                             this,
+                             THR_NEW_LWP | THR_JOINABLE,
+                             0,
+                             &this->thr_handle_) == -1)
+        return -1;
+
+      this->running_ = true;
+    }
+
+  return result;
+}
+
+int
+ACE_Log_Msg_Async::reset (void)
+{
+  this->flush ();
+  return this->backend_->reset ();
+}
+
+int
+ACE_Log_Msg_Async::close (void)
+{
+  if (this->running_)
+    {
+      __atomic_store_n (&this->stop_, 1, __ATOMIC_RELEASE);
+      ACE_Thread::join (this->thr_handle_);
+      this->running_ = false;
+    }
+
+  this->flush ();
+  return this->backend_->close ();
+}
+
+ssize_t
+ACE_Log_Msg_Async::log (ACE_Log_Record &log_record)
+{
+  void *tss = 0;
+  Ring *ring = 0;
+
+  if (this->max_rings_ != 0
+      && ACE_Thread::getspecific (this->key_, &tss) == 0)
+    {
+      ring = static_cast<Ring *> (tss);
+      if (ring == 0)
+        ring = this->claim_i ();
+    }
+
+  if (ring == 0)
+    {
+      __atomic_fetch_add (&this->dropped_, 1, __ATOMIC_RELAXED);
+      return -1;
+    }
+
+  size_t const header = ace_log_msg_async_space (sizeof (Record));
+  size_t length = log_record.msg_data_len () - 1;
+  if (header + (length + 1) * sizeof (ACE_TCHAR) > this->max_record_)
+    length = (this->max_record_ - header) / sizeof (ACE_TCHAR) - 1;
+  size_t const space =
+    ace_log_msg_async_space (header + (length + 1) * sizeof (ACE_TCHAR));
+
+  // Only this thread moves the head, the drain moves the tail.  A
+  // record that doesn't fit before the end of the ring starts over at
+  // its beginning, the rest is skipped through a padding record if
+  // there is room for its header.
+  size_t const mask = this->ring_size_ - 1;
+  size_t const head = ring->head_.value_;
+  size_t const tail = __atomic_load_n (&ring->tail_.value_, __ATOMIC_ACQUIRE);
+  size_t const room = this->ring_size_ - (head & mask);
+  size_t const skip = room < space ? room : 0;
+
+  if (head + skip + space - tail > this->ring_size_)
+    {
+      __atomic_fetch_add (&this->dropped_, 1, __ATOMIC_RELAXED);
+      return -1;
+    }
+
+  if (skip >= header)
+    {
+      Record *padding = reinterpret_cast<Record *> (ring->buffer_ + (head & mask));
+      padding->size_ = static_cast<ACE_UINT32> (skip);
+      padding->type_ = PADDING;
+    }
+
+  char *const position = ring->buffer_ + ((head + skip) & mask);
+  Record *record = reinterpret_cast<Record *> (position);
+  ACE_Time_Value const time_stamp = log_record.time_stamp ();
+  record->size_ = static_cast<ACE_UINT32> (space);
+  record->type_ = log_record.type ();
+  record->pid_ = log_record.pid ();
+  record->sec_ = time_stamp.sec ();
+  record->usec_ = static_cast<long> (time_stamp.usec ());
+
+  ACE_TCHAR *const text = reinterpret_cast<ACE_TCHAR *> (position + header);
+  ACE_OS::memcpy (text, log_record.msg_data (), length * sizeof (ACE_TCHAR));
+  text[length] = 0;
+
+  __atomic_store_n (&ring->head_.value_, head + skip + space, __ATOMIC_RELEASE);
+
+  if (ACE_BIT_ENABLED (this->flush_priorities_, log_record.type ()))
+    this->flush ();
+
+  return static_cast<ssize_t> (length);
+}
+
+size_t
+ACE_Log_Msg_Async::flush (void)
+{
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->drain_lock_, 0);
+
+  size_t count = 0;
+
+  for (size_t i = 0; i != this->max_rings_; ++i)
+    if (__atomic_load_n (&this->rings_[i].owned_, __ATOMIC_ACQUIRE) != 0)
+      count += this->drain_i (this->rings_[i], ACE_INVALID_HANDLE);
+
+  return count;
+}
+
+size_t
+ACE_Log_Msg_Async::flush_on_abort (ACE_HANDLE handle)
+{
+  size_t count = 0;
+
+  for (size_t i = 0; i != this->max_rings_; ++i)
+    if (__atomic_load_n (&this->rings_[i].owned_, __ATOMIC_ACQUIRE) != 0)
+      count += this->drain_i (this->rings_[i], handle);
+
+  return count;
+}
+
+void
+ACE_Log_Msg_Async::detach (void *ring)
+{
+  if (ring != 0)
+    __atomic_store_n (&static_cast<Ring *> (ring)->detached_,
+                      1,
+                      __ATOMIC_RELEASE);
+}
+
+ACE_Log_Msg_Async::Ring *
+ACE_Log_Msg_Async::claim_i (void)
+{
+  for (size_t i = 0; i != this->max_rings_; ++i)
+    {
+      Ring &ring = this->rings_[i];
+      int expected = 0;
+
+      if (__atomic_load_n (&ring.owned_, __ATOMIC_RELAXED) != 0
+          || !__atomic_compare_exchange_n (&ring.owned_,
+                                           &expected,
+                                           1,
+                                           false,
+                                           __ATOMIC_ACQUIRE,
+                                           __ATOMIC_RELAXED))
+        continue;
+
+      // The buffer stays with the ring when its thread exits.
+      if (ring.buffer_ == 0)
+        ACE_NEW_NORETURN (ring.buffer_, char[this->ring_size_]);
+
+      if (ring.buffer_ == 0
+          || ACE_Thread::setspecific (this->key_, &ring) != 0)
+        {
+          __atomic_store_n (&ring.owned_, 0, __ATOMIC_RELEASE);
+          return 0;
+        }
+
+      return &ring;
+    }
+
+  return 0;
+}
+
+size_t
+ACE_Log_Msg_Async::drain_i (Ring &ring, ACE_HANDLE handle)
+{
+  // The ring may be read by a flush_on_abort() that interrupted a
+  // flush(), or the other way around; neither waits for the other.
+  int expected = 0;
+  if (!__atomic_compare_exchange_n (&ring.draining_,
+                                    &expected,
+                                    1,
+                                    false,
+                                    __ATOMIC_ACQUIRE,
+                                    __ATOMIC_RELAXED))
+    return 0;
+
+  // The detached flag is set after the last record of the thread, so
+  // when it is seen here the head below is final.
+  bool const detached =
+    __atomic_load_n (&ring.detached_, __ATOMIC_ACQUIRE) != 0;
+  size_t const head = __atomic_load_n (&ring.head_.value_, __ATOMIC_ACQUIRE);
+  size_t const header = ace_log_msg_async_space (sizeof (Record));
+  size_t const mask = this->ring_size_ - 1;
+  size_t tail = ring.tail_.value_;
+  size_t count = 0;
+
+  while (tail != head)
+    {
+      size_t const room = this->ring_size_ - (tail & mask);
+
+      if (room < header)
+        {
+          tail += room;
+        }
+      else
+        {
+          Record const *record =
+            reinterpret_cast<Record const *> (ring.buffer_ + (tail & mask));
+
+          const ACE_TCHAR *const text =
+            reinterpret_cast<const ACE_TCHAR *> (ring.buffer_
+                                                 + (tail & mask)
+                                                 + header);
+
+          if (record->type_ != PADDING)
+            {
+              if (handle != ACE_INVALID_HANDLE)
+                {
+                  ACE_OS::write (handle,
+                                 text,
+                                 ACE_OS::strlen (text) * sizeof (ACE_TCHAR));
+                }
+              else
+                {
+                  this->record_.type (record->type_);
+                  this->record_.pid (record->pid_);
+                  this->record_.time_stamp (ACE_Time_Value (record->sec_,
+                                                            record->usec_));
+                  this->record_.msg_data (text);
+                  this->backend_->log (this->record_);
+                }
+              ++count;
+            }
+
+          tail += record->size_;
+        }
+
+      __atomic_store_n (&ring.tail_.value_, tail, __ATOMIC_RELEASE);
+    }
+
+  if (detached)
+    {
+      __atomic_store_n (&ring.detached_, 0, __ATOMIC_RELAXED);
+      __atomic_store_n (&ring.owned_, 0, __ATOMIC_RELEASE);
+    }
+
+  __atomic_store_n (&ring.draining_, 0, __ATOMIC_RELEASE);
+  return count;
+}
+
+ACE_THR_FUNC_RETURN
+ACE_Log_Msg_Async::svc_run (void *arg)
+{
+  ACE_Log_Msg_Async *const self = static_cast<ACE_Log_Msg_Async *> (arg);
+  ACE_Time_Value const interval (0, ACE_LOG_MSG_ASYNC_INTERVAL);
+
+  while (__atomic_load_n (&self->stop_, __ATOMIC_ACQUIRE) == 0)
+    if (self->flush () == 0)
+      ACE_OS::sleep (interval);
+
+  return 0;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL && ACE_HAS_THREADS */
@@ -0,0 +1,245 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async.h
+ *
+ *  ACE_Log_Msg_Backend that queues the log records of each thread
+ *  without a lock and hands them to another backend in a background
+ *  thread.
+ */
+//=============================================================================
+
+#ifndef ACE_LOG_MSG_ASYNC_H
+#define ACE_LOG_MSG_ASYNC_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL) && defined (ACE_HAS_THREADS)
+
+#include "ace/Log_Msg_Backend.h"
+#include "ace/Log_Record.h"
+#include "ace/Basic_Types.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/Thread_Mutex.h"
+
+/// Default number of bytes of the ring buffer of each thread.
+#if !defined (ACE_LOG_MSG_ASYNC_RING_SIZE)
+# define ACE_LOG_MSG_ASYNC_RING_SIZE 32768
+#endif /* ACE_LOG_MSG_ASYNC_RING_SIZE */
+
+/// Default number of threads that get a ring buffer.
+#if !defined (ACE_LOG_MSG_ASYNC_MAX_RINGS)
+# define ACE_LOG_MSG_ASYNC_MAX_RINGS 64
+#endif /* ACE_LOG_MSG_ASYNC_MAX_RINGS */
+
+/// Microseconds the background thread sleeps when it found nothing
+/// to log.
+#if !defined (ACE_LOG_MSG_ASYNC_INTERVAL)
+# define ACE_LOG_MSG_ASYNC_INTERVAL 10000
+#endif /* ACE_LOG_MSG_ASYNC_INTERVAL */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Log_Msg_Async
+ *
+ * @brief ACE_Log_Msg_Backend that decouples the logging threads from
+ * another backend.
+ *
+ * Each thread that logs gets a ring buffer of its own, which it is
+ * the only writer of.  <log> copies the priority, time stamp, pid and
+ * text of the record into that ring and returns, a background thread
+ * started by <open> takes the records out of all the rings and passes
+ * them on to the wrapped backend, e.g. an ACE_Log_Msg_UNIX_Syslog or
+ * ACE_Log_Msg_IPC.  Neither side takes a lock to use a ring.
+ *
+ * The memory is bounded: there are at most @c max_rings rings of
+ * @c ring_size bytes, a ring stays with its thread until the thread
+ * exits and is then reused by another one.  A record that doesn't fit
+ * in the ring of its thread, or that is logged by a thread that found
+ * no free ring, is dropped and counted in <dropped>.  Texts longer
+ * than a quarter of a ring are truncated.
+ *
+ * The records of the priorities in <flush_priorities>, by default
+ * LM_CRITICAL, LM_ALERT and LM_EMERGENCY, are not left behind: <log>
+ * hands everything queued so far to the wrapped backend before it
+ * returns, so the messages that precede an abort aren't lost.  A
+ * signal or terminate handler calls <flush_on_abort> for the same
+ * purpose, <flush> must not be used there.
+ *
+ * Use it through ACE_Log_Msg::msg_backend() and the
+ * ACE_Log_Msg::CUSTOM flag.  Clear the ACE_Log_Msg::STDERR and
+ * ACE_Log_Msg::OSTREAM flags, these are still written in the logging
+ * thread.  ACE_Log_Msg formats the message before it calls <log>,
+ * that cost stays with the logging thread.
+ *
+ * @note The records are passed on without their category, which
+ * belongs to the logging thread.  The wrapped backend must not log
+ * through ACE_Log_Msg itself.
+ */
+class ACE_Export ACE_Log_Msg_Async : public ACE_Log_Msg_Backend
+{
+public:
+  /// Queue the records for @a backend, which remains owned by the
+  /// caller and must outlive this object.  @a ring_size is rounded up
+  /// to a power of two.
+  ACE_Log_Msg_Async (ACE_Log_Msg_Backend *backend,
+                     size_t ring_size = ACE_LOG_MSG_ASYNC_RING_SIZE,
+                     size_t max_rings = ACE_LOG_MSG_ASYNC_MAX_RINGS);
+
+  /// Closes the backend if that wasn't done and frees the rings.
+  virtual ~ACE_Log_Msg_Async (void);
+
+  //FUZZ: disable check_for_lack_ACE_OS
+  /// Open the wrapped backend and start the background thread.
+  ///FUZZ: enable check_for_lack_ACE_OS
+  virtual int open (const ACE_TCHAR *logger_key);
+
+  /// Pass the queued records on and reset the wrapped backend.
+  virtual int reset (void);
+
+  //FUZZ: disable check_for_lack_ACE_OS
+  /// Stop the background thread, pass the queued records on and close
+  /// the wrapped backend.
+  ///FUZZ: enable check_for_lack_ACE_OS
+  virtual int close (void);
+
+  /// Queue @a log_record in the ring of the calling thread.  Returns
+  /// the number of characters queued, or -1 if the record was
+  /// dropped.
+  virtual ssize_t log (ACE_Log_Record &log_record);
+
+  /// Pass all the queued records on to the wrapped backend in the
+  /// calling thread.  Returns the number of records.  It takes a lock
+  /// and calls the wrapped backend, so it must not be called from a
+  /// signal handler; use <flush_on_abort> there.
+  size_t flush (void);
+
+  /// Write the texts of the queued records straight to @a handle, for
+  /// signal and terminate handlers.  It takes no lock and doesn't call
+  /// the wrapped backend, only write(), so it is async-signal-safe and
+  /// can interrupt <flush>: the rings another call is reading at that
+  /// time are skipped.  Returns the number of records written.
+  size_t flush_on_abort (ACE_HANDLE handle = ACE_STDERR);
+
+  /// Number of records dropped because a ring was full or no ring was
+  /// free.
+  ACE_UINT64 dropped (void) const;
+
+  /// Set and get the mask of ACE_Log_Priority values whose records
+  /// are flushed by <log>.
+  void flush_priorities (u_long mask);
+  u_long flush_priorities (void) const;
+
+  /// @internal Give up the ring @a ring of a thread that exits.
+  static void detach (void *ring);
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  enum
+  {
+    CACHE_LINE = 64
+  };
+
+  /// A counter alone on its cache line.
+  struct Position
+  {
+    size_t value_;
+    char pad_[CACHE_LINE - sizeof (size_t)];
+  };
+
+  /// Ring buffer of one thread.  The records are written at @c head_
+  /// by that thread and read at @c tail_ by whoever set @c draining_;
+  /// both count bytes from the creation of the ring.
+  struct Ring
+  {
+    Position head_;
+    Position tail_;
+    char *buffer_;
+    /// Set while a thread uses the ring, cleared by the drain once a
+    /// detached ring is empty.
+    int owned_;
+    /// Set when the thread that owns the ring exits.
+    int detached_;
+    /// Set while <flush> or <flush_on_abort> reads the ring.
+    int draining_;
+  };
+
+  /// Header of a queued record, followed by its text.
+  struct Record
+  {
+    /// Bytes taken by the record and its text.
+    ACE_UINT32 size_;
+    /// Priority of the record, or PADDING up to the end of the ring.
+    ACE_UINT32 type_;
+    long pid_;
+    time_t sec_;
+    long usec_;
+  };
+
+  static ACE_UINT32 const PADDING = ~ACE_UINT32 (0);
+
+  /// Find a free ring for the calling thread and make it its own.
+  Ring *claim_i (void);
+
+  /// Pass on the records of @a ring to the wrapped backend, the
+  /// caller holds the drain lock, or write their texts to @a handle if
+  /// it is valid.  A ring that is being read already is skipped.
+  size_t drain_i (Ring &ring, ACE_HANDLE handle);
+
+  /// Entry point of the background thread.
+  static ACE_THR_FUNC_RETURN svc_run (void *arg);
+
+  /// The backend the records are passed on to.
+  ACE_Log_Msg_Backend *backend_;
+
+  /// Size of a ring, a power of two, and the largest record in it.
+  size_t ring_size_;
+  size_t max_record_;
+
+  /// The rings, allocated on first use.
+  Ring *rings_;
+  size_t max_rings_;
+
+  /// Points each thread to its ring.
+  ACE_thread_key_t key_;
+
+  /// Records dropped.
+  ACE_UINT64 dropped_;
+
+  /// Priorities flushed by <log>.
+  u_long flush_priorities_;
+
+  /// Serializes the calls of <flush> and of the wrapped backend.
+  ACE_Thread_Mutex drain_lock_;
+
+  /// Record passed on to the wrapped backend, under the drain lock.
+  ACE_Log_Record record_;
+
+  /// The background thread and whether it has to stop.
+  ACE_hthread_t thr_handle_;
+  bool running_;
+  int stop_;
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Log_Msg_Async &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Log_Msg_Async (const ACE_Log_Msg_Async &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Log_Msg_Async.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL && ACE_HAS_THREADS */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_LOG_MSG_ASYNC_H */
@@ -0,0 +1,22 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE ACE_UINT64
+ACE_Log_Msg_Async::dropped (void) const
+{
+  return __atomic_load_n (&this->dropped_, __ATOMIC_RELAXED);
+}
+
+ACE_INLINE void
+ACE_Log_Msg_Async::flush_priorities (u_long mask)
+{
+  this->flush_priorities_ = mask;
+}
+
+ACE_INLINE u_long
+ACE_Log_Msg_Async::flush_priorities (void) const
+{
+  return this->flush_priorities_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
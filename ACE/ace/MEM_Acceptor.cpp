@@ -178,13 +178,17 @@ ACE_MEM_Acceptor::accept (ACE_MEM_Stream &new_stream,
   // Protocol negociation:
   //   Tell the client side what level of signaling strategy
   //   we support.
-  ACE_MEM_IO::Signal_Strategy client_signaling =
-#if defined (ACE_WIN32) || !defined (_ACE_USE_SV_SEM)
-    this->preferred_strategy_;
-#else
-    // We don't support MT.
-    ACE_MEM_IO::Reactive;
-#endif /* ACE_WIN32 || !_ACE_USE_SV_SEM */
+  ACE_MEM_IO::Signal_Strategy client_signaling = this->preferred_strategy_;
+#if !defined (ACE_HAS_FUTEX)
+  // We don't support Ring, MT blocks the same way.
+  if (client_signaling == ACE_MEM_IO::Ring)
+    client_signaling = ACE_MEM_IO::MT;
+#endif /* ACE_HAS_FUTEX */
+#if !defined (ACE_WIN32) && defined (_ACE_USE_SV_SEM)
+  // We don't support MT.
+  if (client_signaling == ACE_MEM_IO::MT)
+    client_signaling = ACE_MEM_IO::Reactive;
+#endif /* !ACE_WIN32 && _ACE_USE_SV_SEM */
   if (ACE::send (new_handle, &client_signaling,
                  sizeof (ACE_INT16)) == -1)
     ACELIB_ERROR_RETURN ((LM_DEBUG,
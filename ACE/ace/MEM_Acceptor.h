@@ -103,7 +103,8 @@ public:
 
   /**
    * Change the initial MMAP buffer size (in bytes) of the MEM_Stream
-   * this MEM_Acceptor creates.
+   * this MEM_Acceptor creates.  With the ACE_MEM_IO::Ring strategy
+   * this is the size of the ring for each direction.
    */
   void init_buffer_size (ACE_OFF_T bytes);
 
@@ -106,12 +106,23 @@ ACE_MEM_Connector::connect (ACE_MEM_Stream &new_stream,
                        ACE_TEXT ("ACE_MEM_Connector::connect error receiving strategy\n")),
                       -1);
 
-  // If either side don't support MT, we will not use it.
-#if defined (ACE_WIN32) || !defined (_ACE_USE_SV_SEM)
-  if (! (this->preferred_strategy_ == ACE_MEM_IO::MT &&
-         server_strategy == ACE_MEM_IO::MT))
-#endif /* ACE_WIN32 || !_ACE_USE_SV_SEM */
+  // If either side don't support MT, we will not use it.  Ring is only
+  // used if both sides ask for it, a side asking for it blocks the same
+  // way with MT.
+  ACE_MEM_IO::Signal_Strategy client_strategy = this->preferred_strategy_;
+#if !defined (ACE_HAS_FUTEX)
+  if (client_strategy == ACE_MEM_IO::Ring)
+    client_strategy = ACE_MEM_IO::MT;
+#endif /* ACE_HAS_FUTEX */
+  if (client_strategy == ACE_MEM_IO::Reactive
+      || server_strategy == ACE_MEM_IO::Reactive)
     server_strategy = ACE_MEM_IO::Reactive;
+  else if (client_strategy != server_strategy)
+    server_strategy = ACE_MEM_IO::MT;
+#if !defined (ACE_WIN32) && defined (_ACE_USE_SV_SEM)
+  if (server_strategy == ACE_MEM_IO::MT)
+    server_strategy = ACE_MEM_IO::Reactive;
+#endif /* !ACE_WIN32 && _ACE_USE_SV_SEM */
 
   if (ACE::send (new_handle, &server_strategy,
                  sizeof (ACE_INT16)) == -1)
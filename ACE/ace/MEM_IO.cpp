@@ -1,6 +1,7 @@
 // MEM_IO.cpp
 #include "ace/MEM_IO.h"
 #include "ace/Handle_Set.h"
+#include "ace/Min_Max.h"
 
 #if (ACE_HAS_POSITION_INDEPENDENT_POINTERS == 1)
 
@@ -8,6 +9,16 @@
 #include "ace/MEM_IO.inl"
 #endif /* __ACE_INLINE__ */
 
+#if defined (ACE_HAS_FUTEX)
+# include "ace/OS_NS_fcntl.h"
+# include "ace/OS_NS_sys_mman.h"
+# include "ace/OS_NS_sys_socket.h"
+# include "ace/OS_NS_sys_stat.h"
+# include "ace/OS_NS_sys_time.h"
+# include "ace/OS_NS_unistd.h"
+# include /**/ <linux/futex.h>
+# include /**/ <sys/syscall.h>
+#endif /* ACE_HAS_FUTEX */
 
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -333,6 +344,468 @@ ACE_MT_MEM_IO::send_buf (ACE_MEM_SAP_Node *buf,
 }
 #endif /* ACE_WIN32 || !_ACE_USE_SV_SEM */
 
+#if defined (ACE_HAS_FUTEX)
+
+/// Size of a cache line.  The indices of the two sides of a ring and
+/// the messages in it start on their own line.
+static ACE_UINT32 const ace_ring_line = 64;
+
+/// Smallest ring we create, a message is limited to half of it.
+static ACE_UINT32 const ace_ring_min_size = 4096;
+
+/// Largest ring we create, so the distance between the indices fits.
+static ACE_UINT32 const ace_ring_max_size = 1U << 30;
+
+/// Capacity of the node that tells the consumer to skip to the start
+/// of the ring.  Empty messages are valid, ACE_MEM_Stream::close()
+/// sends one.
+static size_t const ace_ring_skip = ~static_cast<size_t> (0);
+
+/// Marks a region set up by ACE_Ring_MEM_IO.
+static ACE_UINT32 const ace_ring_magic = 0x41524e47;
+
+/// How long a side sleeps before it checks whether the peer is gone.
+static time_t const ace_ring_check_interval = 1;
+
+struct ACE_Ring_MEM_IO::Ring
+{
+  /// Written by the producer: the bytes it published so far and
+  /// whether it sleeps on room to be freed.
+  ACE_UINT32 tail_;
+  ACE_UINT32 producer_sleeping_;
+  char producer_pad_[ace_ring_line - 2 * sizeof (ACE_UINT32)];
+
+  /// Written by the consumer: the bytes it freed so far and whether it
+  /// sleeps on data to arrive.
+  ACE_UINT32 head_;
+  ACE_UINT32 consumer_sleeping_;
+  char consumer_pad_[ace_ring_line - 2 * sizeof (ACE_UINT32)];
+
+  /// Set up by the side that creates the region.
+  ACE_UINT32 magic_;
+  ACE_UINT32 size_;
+
+  /// Set when either side closes down.
+  ACE_UINT32 closed_;
+  char pad_[ace_ring_line - 3 * sizeof (ACE_UINT32)];
+};
+
+// Bytes a message of @a capacity bytes takes up in a ring.
+static inline ACE_UINT32
+ace_ring_record (size_t capacity)
+{
+  return static_cast<ACE_UINT32> (
+    (sizeof (ACE_MEM_SAP_Node) + capacity + ace_ring_line - 1)
+    & ~static_cast<size_t> (ace_ring_line - 1));
+}
+
+// Free room in a ring for its producer, or data for its consumer,
+// given the own index @a own and the index @a other of the other side.
+static inline ACE_UINT32
+ace_ring_available (bool producer,
+                    ACE_UINT32 size,
+                    ACE_UINT32 own,
+                    ACE_UINT32 other)
+{
+  return producer ? size - (own - other) : other - own;
+}
+
+static inline long
+ace_ring_futex (ACE_UINT32 *word,
+                int op,
+                ACE_UINT32 value,
+                const timespec *timeout)
+{
+  return ::syscall (SYS_futex, word, op, value, timeout, 0, 0);
+}
+
+ACE_Ring_MEM_IO::~ACE_Ring_MEM_IO (void)
+{
+  this->fini ();
+}
+
+int
+ACE_Ring_MEM_IO::init (ACE_HANDLE handle,
+                       const ACE_TCHAR *name,
+                       MALLOC_OPTIONS *options)
+{
+  ACE_TRACE ("ACE_Ring_MEM_IO::init");
+
+  if (this->base_ != 0)
+    return -1;
+
+  this->handle_ = handle;
+
+  // The acceptor removed any stale file, so the side that creates it
+  // is the acceptor.
+  ACE_HANDLE fd = ACE_OS::open (name,
+                                O_RDWR | O_CREAT | O_EXCL,
+                                ACE_DEFAULT_FILE_PERMS);
+  bool const creator = fd != ACE_INVALID_HANDLE;
+  if (!creator)
+    {
+      if (errno != EEXIST)
+        return -1;
+      fd = ACE_OS::open (name, O_RDWR);
+      if (fd == ACE_INVALID_HANDLE)
+        return -1;
+    }
+
+  ACE_UINT32 size = ace_ring_min_size;
+  size_t length = 0;
+  if (creator)
+    {
+      while (options != 0
+             && size < ace_ring_max_size
+             && static_cast<ACE_OFF_T> (size) < options->minimum_bytes_)
+        size <<= 1;
+
+      length = 2 * sizeof (Ring) + 2 * static_cast<size_t> (size);
+      if (ACE_OS::ftruncate (fd, static_cast<ACE_OFF_T> (length)) == -1)
+        {
+          ACE_OS::close (fd);
+          ACE_OS::unlink (name);
+          return -1;
+        }
+    }
+  else
+    {
+      ACE_OFF_T const file_size = ACE_OS::filesize (fd);
+      if (file_size < static_cast<ACE_OFF_T> (2 * sizeof (Ring)))
+        {
+          ACE_OS::close (fd);
+          errno = EINVAL;
+          return -1;
+        }
+      length = static_cast<size_t> (file_size);
+    }
+
+  void *addr = ACE_OS::mmap (0,
+                             length,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED,
+                             fd);
+  ACE_OS::close (fd);
+  if (addr == MAP_FAILED)
+    {
+      if (creator)
+        ACE_OS::unlink (name);
+      return -1;
+    }
+
+  Ring *rings = static_cast<Ring *> (addr);
+  if (creator)
+    {
+      // The file starts out zero filled.
+      rings[0].magic_ = rings[1].magic_ = ace_ring_magic;
+      rings[0].size_ = rings[1].size_ = size;
+      this->name_ = ACE::strnew (name);
+    }
+  else
+    {
+      size = rings[0].size_;
+      if (rings[0].magic_ != ace_ring_magic
+          || size < ace_ring_min_size
+          || (size & (size - 1)) != 0
+          || length != 2 * sizeof (Ring) + 2 * static_cast<size_t> (size))
+        {
+          ACE_OS::munmap (addr, length);
+          errno = EINVAL;
+          return -1;
+        }
+
+      // Nobody else needs the name, the region lives as long as it is
+      // mapped.
+      ACE_OS::unlink (name);
+    }
+
+  this->base_ = static_cast<char *> (addr);
+  this->length_ = length;
+  this->size_ = size;
+
+  // Spinning only helps if the peer runs on another processor.
+  this->spin_count_ =
+    ACE_OS::num_processors_online () > 1 ? ACE_MEM_IO_RING_SPIN_COUNT : 0;
+
+  // Ring 0 goes to the acceptor, ring 1 to the connector.
+  char *data = this->base_ + 2 * sizeof (Ring);
+  int const recv_index = creator ? 0 : 1;
+  this->recv_ring_ = &rings[recv_index];
+  this->recv_data_ = data + recv_index * static_cast<size_t> (size);
+  this->send_ring_ = &rings[1 - recv_index];
+  this->send_data_ = data + (1 - recv_index) * static_cast<size_t> (size);
+  return 0;
+}
+
+int
+ACE_Ring_MEM_IO::fini (void)
+{
+  ACE_TRACE ("ACE_Ring_MEM_IO::fini");
+
+  if (this->base_ != 0)
+    {
+      // Let the peer drain what we sent and see the end of the data.
+      __atomic_store_n (&this->send_ring_->closed_, 1U, __ATOMIC_SEQ_CST);
+      __atomic_store_n (&this->recv_ring_->closed_, 1U, __ATOMIC_SEQ_CST);
+      this->wake (&this->send_ring_->consumer_sleeping_);
+      this->wake (&this->recv_ring_->producer_sleeping_);
+
+      ACE_OS::munmap (this->base_, this->length_);
+      this->base_ = 0;
+      this->recv_ring_ = this->send_ring_ = 0;
+      this->recv_data_ = this->send_data_ = 0;
+      this->recv_node_ = this->send_node_ = 0;
+    }
+
+  if (this->name_ != 0)
+    {
+      // In case the connector never got to it.
+      ACE_OS::unlink (this->name_);
+#if defined (ACE_HAS_ALLOC_HOOKS)
+      ACE_Allocator::instance ()->free (this->name_);
+#else
+      delete [] this->name_;
+#endif /* ACE_HAS_ALLOC_HOOKS */
+      this->name_ = 0;
+    }
+
+  return 0;
+}
+
+ACE_MEM_SAP_Node *
+ACE_Ring_MEM_IO::acquire_buffer (const ssize_t size,
+                                 const ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Ring_MEM_IO::acquire_buffer");
+
+  if (this->base_ == 0 || size < 0)
+    return 0;
+
+  // A reservation that was never sent is simply reused.
+  this->send_node_ = 0;
+
+  // Messages are limited to half a ring, so any of them fits once the
+  // consumer caught up.
+  size_t const capacity =
+    ACE_MIN (static_cast<size_t> (size),
+             this->size_ / 2 - sizeof (ACE_MEM_SAP_Node));
+  ACE_UINT32 const record = ace_ring_record (capacity);
+
+  // A message that doesn't fit before the end of the ring is put at
+  // its start, the rest of the ring is skipped.
+  ACE_UINT32 const tail = this->send_ring_->tail_;
+  ACE_UINT32 position = tail & (this->size_ - 1);
+  ACE_UINT32 const skip =
+    record > this->size_ - position ? this->size_ - position : 0;
+
+  ACE_UINT32 head = 0;
+  int const result =
+    this->wait (this->send_ring_, true, skip + record, head, timeout);
+  if (result != 0)
+    {
+      if (result == 1)
+        errno = EPIPE;
+      return 0;
+    }
+
+  if (skip != 0)
+    {
+      ACE_MEM_SAP_Node *marker =
+        reinterpret_cast<ACE_MEM_SAP_Node *> (this->send_data_ + position);
+      marker->capacity_ = ace_ring_skip;
+      position = 0;
+    }
+
+  // The nodes in a ring are never linked, so only the sizes are set.
+  ACE_MEM_SAP_Node *node =
+    reinterpret_cast<ACE_MEM_SAP_Node *> (this->send_data_ + position);
+  node->capacity_ = capacity;
+  node->size_ = 0;
+
+  this->send_node_ = node;
+  this->send_end_ = tail + skip + record;
+  return node;
+}
+
+ssize_t
+ACE_Ring_MEM_IO::send_buf (ACE_MEM_SAP_Node *buf,
+                           int flags,
+                           const ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Ring_MEM_IO::send_buf");
+  ACE_UNUSED_ARG (flags);
+  ACE_UNUSED_ARG (timeout);
+
+  if (this->base_ == 0 || buf == 0 || buf != this->send_node_)
+    return -1;
+
+  this->send_node_ = 0;
+  __atomic_store_n (&this->send_ring_->tail_,
+                    this->send_end_,
+                    __ATOMIC_SEQ_CST);
+  this->wake (&this->send_ring_->consumer_sleeping_);
+
+  return ACE_Utils::truncate_cast<ssize_t> (buf->size ());
+}
+
+ssize_t
+ACE_Ring_MEM_IO::recv_buf (ACE_MEM_SAP_Node *&buf,
+                           int flags,
+                           const ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Ring_MEM_IO::recv_buf");
+  ACE_UNUSED_ARG (flags);
+
+  buf = 0;
+
+  if (this->base_ == 0)
+    return -1;
+
+  if (this->recv_node_ != 0)
+    this->release_buffer (this->recv_node_);
+
+  ACE_UINT32 const head = this->recv_ring_->head_;
+  ACE_UINT32 tail = 0;
+  int const result = this->wait (this->recv_ring_, false, 1, tail, timeout);
+  if (result != 0)
+    return result == 1 ? 0 : -1;
+
+  ACE_UINT32 position = head & (this->size_ - 1);
+  ACE_UINT32 end = head;
+  ACE_MEM_SAP_Node *node =
+    reinterpret_cast<ACE_MEM_SAP_Node *> (this->recv_data_ + position);
+  if (node->capacity_ == ace_ring_skip)
+    {
+      // The message is at the start of the ring.
+      end += this->size_ - position;
+      node = reinterpret_cast<ACE_MEM_SAP_Node *> (this->recv_data_);
+    }
+  end += ace_ring_record (node->capacity_);
+
+  this->recv_node_ = node;
+  this->recv_end_ = end;
+  buf = node;
+  return ACE_Utils::truncate_cast<ssize_t> (node->size ());
+}
+
+int
+ACE_Ring_MEM_IO::release_buffer (ACE_MEM_SAP_Node *buf)
+{
+  ACE_TRACE ("ACE_Ring_MEM_IO::release_buffer");
+
+  if (buf == 0)
+    return -1;
+
+  if (buf == this->send_node_)
+    {
+      this->send_node_ = 0;
+      return 0;
+    }
+
+  if (buf != this->recv_node_)
+    return -1;
+
+  this->recv_node_ = 0;
+  __atomic_store_n (&this->recv_ring_->head_,
+                    this->recv_end_,
+                    __ATOMIC_SEQ_CST);
+  this->wake (&this->recv_ring_->producer_sleeping_);
+  return 0;
+}
+
+int
+ACE_Ring_MEM_IO::wait (Ring *ring,
+                       bool producer,
+                       ACE_UINT32 needed,
+                       ACE_UINT32 &index,
+                       const ACE_Time_Value *timeout)
+{
+  // Our own index only changes in this thread.
+  ACE_UINT32 const own = producer ? ring->tail_ : ring->head_;
+  ACE_UINT32 *other = producer ? &ring->head_ : &ring->tail_;
+  ACE_UINT32 *sleeping =
+    producer ? &ring->producer_sleeping_ : &ring->consumer_sleeping_;
+
+  for (int i = 0; i < this->spin_count_; ++i)
+    {
+      index = __atomic_load_n (other, __ATOMIC_ACQUIRE);
+      if (ace_ring_available (producer, this->size_, own, index) >= needed)
+        return 0;
+    }
+
+  ACE_Time_Value deadline;
+  if (timeout != 0)
+    deadline = ACE_OS::gettimeofday () + *timeout;
+
+  for (;;)
+    {
+      // The other side checks the flag after it moved its index, so
+      // either it sees the flag or we see the index.
+      __atomic_store_n (sleeping, 1U, __ATOMIC_SEQ_CST);
+      index = __atomic_load_n (other, __ATOMIC_SEQ_CST);
+      if (ace_ring_available (producer, this->size_, own, index) >= needed)
+        break;
+
+      if (__atomic_load_n (&ring->closed_, __ATOMIC_ACQUIRE) != 0)
+        {
+          __atomic_store_n (sleeping, 0U, __ATOMIC_RELAXED);
+          return 1;
+        }
+
+      ACE_Time_Value interval (ace_ring_check_interval);
+      if (timeout != 0)
+        {
+          ACE_Time_Value const remaining = deadline - ACE_OS::gettimeofday ();
+          if (remaining <= ACE_Time_Value::zero)
+            {
+              __atomic_store_n (sleeping, 0U, __ATOMIC_RELAXED);
+              errno = ETIME;
+              return -1;
+            }
+          if (remaining < interval)
+            interval = remaining;
+        }
+
+      timespec_t ts = interval;
+      if (ace_ring_futex (sleeping, FUTEX_WAIT, 1U, &ts) == -1
+          && errno == ETIMEDOUT
+          && this->peer_closed ())
+        {
+          __atomic_store_n (sleeping, 0U, __ATOMIC_RELAXED);
+          return 1;
+        }
+    }
+
+  __atomic_store_n (sleeping, 0U, __ATOMIC_RELAXED);
+  return 0;
+}
+
+void
+ACE_Ring_MEM_IO::wake (ACE_UINT32 *sleeping)
+{
+  if (__atomic_load_n (sleeping, __ATOMIC_SEQ_CST) != 0
+      && __atomic_exchange_n (sleeping, 0U, __ATOMIC_SEQ_CST) != 0)
+    ace_ring_futex (sleeping, FUTEX_WAKE, 1U, 0);
+}
+
+bool
+ACE_Ring_MEM_IO::peer_closed (void) const
+{
+  if (this->handle_ == ACE_INVALID_HANDLE)
+    return false;
+
+  // No data goes over the socket, so it only becomes readable when the
+  // peer closed it.
+  ACE_Time_Value poll (ACE_Time_Value::zero);
+  if (ACE::handle_read_ready (this->handle_, &poll) != 1)
+    return false;
+
+  char c;
+  return ACE_OS::recv (this->handle_, &c, 1, MSG_PEEK) <= 0;
+}
+
+#endif /* ACE_HAS_FUTEX */
+
 void
 ACE_MEM_IO::dump (void) const
 {
@@ -364,6 +837,13 @@ ACE_MEM_IO::init (const ACE_TCHAR *name,
                       -1);
       break;
 #endif /* ACE_WIN32 || !_ACE_USE_SV_SEM */
+#if defined (ACE_HAS_FUTEX)
+    case ACE_MEM_IO::Ring:
+      ACE_NEW_RETURN (this->deliver_strategy_,
+                      ACE_Ring_MEM_IO (),
+                      -1);
+      break;
+#endif /* ACE_HAS_FUTEX */
     default:
       return -1;
     }
@@ -407,18 +887,31 @@ ACE_MEM_IO::send (const ACE_Message_Block *message_block,
   if (len != 0)
     {
       ACE_MEM_SAP_Node *buf =
-        reinterpret_cast<ACE_MEM_SAP_Node *> (
-          this->deliver_strategy_->acquire_buffer (
-            ACE_Utils::truncate_cast<ssize_t> (len)));
+        this->deliver_strategy_->acquire_buffer (
+          ACE_Utils::truncate_cast<ssize_t> (len),
+          timeout);
+
+      if (buf == 0)
+        {
+          return -1;
+        }
+
+      // The strategy may have less room than we asked for.
+      if (len > buf->capacity ())
+        {
+          len = buf->capacity ();
+        }
 
       size_t n = 0;
 
-      while (message_block != 0)
+      while (message_block != 0 && n < len)
         {
+          size_t const length =
+            ACE_MIN (message_block->length (), len - n);
           ACE_OS::memcpy (static_cast<char *> (buf->data ()) + n,
                           message_block->rd_ptr (),
-                          message_block->length ());
-          n += message_block->length ();
+                          length);
+          n += length;
 
           if (message_block->cont ())
             {
@@ -141,6 +141,128 @@ private:
 };
 #endif /* ACE_WIN32 || !_ACE_USE_SV_SEM */
 
+#if defined (ACE_HAS_FUTEX)
+
+#if !defined (ACE_MEM_IO_RING_SPIN_COUNT)
+/// Number of times a ring end polls before it goes to sleep on the
+/// futex.  There is no spinning on a single processor.
+# define ACE_MEM_IO_RING_SPIN_COUNT 2000
+#endif /* ACE_MEM_IO_RING_SPIN_COUNT */
+
+/**
+ * @class ACE_Ring_MEM_IO
+ *
+ * @brief Passes data through a pair of single-producer/single-consumer
+ * rings in a shared memory region.
+ *
+ * The region holds one ring per direction.  The sender builds each
+ * message in place at the tail of its ring and publishes it by moving
+ * the tail, the receiver reads it where it is and frees it by moving
+ * the head.  Neither side takes a lock or allocates from a shared
+ * heap, and each side only writes the cache line that holds its own
+ * index.  A side that finds nothing to do spins briefly and then sleeps
+ * on a futex; the other side only makes the wake up system call when
+ * it sees the sleeping flag set.
+ *
+ * The acceptor creates the region in the file named by @a name and
+ * the connector removes the file once it has mapped it, so the memory
+ * goes away with the last mapping.  The socket of the connection
+ * carries no data with this strategy; it only tells a side that waits
+ * for too long that the peer is gone.
+ *
+ * A message is limited to half a ring, larger sends are partial.  Like
+ * ACE_MT_MEM_IO, this strategy blocks the calling thread in recv and
+ * can't be driven by a reactor.
+ */
+class ACE_Export ACE_Ring_MEM_IO : public ACE_MEM_SAP
+{
+public:
+  ACE_Ring_MEM_IO (void);
+
+  virtual ~ACE_Ring_MEM_IO (void);
+
+  /**
+   * Create or attach to the shared memory region in file @a name.
+   * The ring size of the region is taken from the
+   * <options->minimum_bytes_> of the side that creates it.
+   */
+  virtual int init (ACE_HANDLE handle,
+                    const ACE_TCHAR *name,
+                    MALLOC_OPTIONS *options);
+
+  /// Tell the peer we are closing down and unmap the region.
+  virtual int fini (void);
+
+  /// Wait up to @a timeout for the next message in the receive ring.
+  /// Returns 0 once the peer closed and the ring is drained.
+  virtual ssize_t recv_buf (ACE_MEM_SAP_Node *&buf,
+                            int flags,
+                            const ACE_Time_Value *timeout);
+
+  /// Publish @a buf, which must be the last buffer acquired, to the
+  /// peer.
+  virtual ssize_t send_buf (ACE_MEM_SAP_Node *buf,
+                            int flags,
+                            const ACE_Time_Value *timeout);
+
+  /// Reserve room for a message of up to @a size bytes at the tail of
+  /// the send ring, waiting up to @a timeout for the peer to free it.
+  virtual ACE_MEM_SAP_Node *acquire_buffer (const ssize_t size,
+                                            const ACE_Time_Value *timeout = 0);
+
+  /// Give the message last received back to the peer, or drop the
+  /// reservation made by <acquire_buffer>.
+  virtual int release_buffer (ACE_MEM_SAP_Node *buf);
+
+  /// Layout of the indices of one ring in the shared memory.
+  struct Ring;
+
+private:
+  /// Wait until @a ring has @a needed bytes of data (@a producer is
+  /// false) or free room (@a producer is true).  Returns the head or
+  /// tail index of the other side in @a index.
+  int wait (Ring *ring,
+            bool producer,
+            ACE_UINT32 needed,
+            ACE_UINT32 &index,
+            const ACE_Time_Value *timeout);
+
+  /// Wake the other side of @a ring up if it went to sleep.
+  void wake (ACE_UINT32 *sleeping);
+
+  /// Check whether the peer closed the connection socket.
+  bool peer_closed (void) const;
+
+  /// Name of the file we created the region in, 0 if we attached to
+  /// it.
+  ACE_TCHAR *name_;
+
+  /// Start and length of the mapped region.
+  char *base_;
+  size_t length_;
+
+  Ring *recv_ring_;
+  char *recv_data_;
+  Ring *send_ring_;
+  char *send_data_;
+
+  /// Size of each ring, a power of two.
+  ACE_UINT32 size_;
+
+  /// Number of polls before we sleep.
+  int spin_count_;
+
+  /// Message last received and the head index that frees it.
+  ACE_MEM_SAP_Node *recv_node_;
+  ACE_UINT32 recv_end_;
+
+  /// Room reserved by <acquire_buffer> and the tail index that
+  /// publishes it.
+  ACE_MEM_SAP_Node *send_node_;
+  ACE_UINT32 send_end_;
+};
+#endif /* ACE_HAS_FUTEX */
+
 /**
  * @class ACE_MEM_IO
  *
@@ -179,7 +301,8 @@ public:
   typedef enum
   {
     Reactive,
-    MT
+    MT,
+    Ring
   }  Signal_Strategy;
 
   /**
@@ -46,6 +46,26 @@ ACE_MT_MEM_IO::Simple_Queue::init (MQ_Struct *mq,
 }
 #endif /* ACE_WIN32 || !_ACE_USE_SV_SEM */
 
+#if defined (ACE_HAS_FUTEX)
+ACE_INLINE
+ACE_Ring_MEM_IO::ACE_Ring_MEM_IO (void)
+  : name_ (0),
+    base_ (0),
+    length_ (0),
+    recv_ring_ (0),
+    recv_data_ (0),
+    send_ring_ (0),
+    send_data_ (0),
+    size_ (0),
+    spin_count_ (0),
+    recv_node_ (0),
+    recv_end_ (0),
+    send_node_ (0),
+    send_end_ (0)
+{
+}
+#endif /* ACE_HAS_FUTEX */
+
 ACE_INLINE ssize_t
 ACE_Reactive_MEM_IO::get_buf_len (const ACE_OFF_T off, ACE_MEM_SAP_Node *&buf)
 {
@@ -134,13 +154,20 @@ ACE_MEM_IO::send (const void *buf,
 
   ACE_MEM_SAP_Node *sbuf =
     this->deliver_strategy_->acquire_buffer (
-      ACE_Utils::truncate_cast<ssize_t> (len));
+      ACE_Utils::truncate_cast<ssize_t> (len),
+      timeout);
 
   if (sbuf == 0)
     {
       return -1;                  // Memory buffer not initialized.
     }
 
+  // The strategy may have less room than we asked for.
+  if (len > sbuf->capacity ())
+    {
+      len = sbuf->capacity ();
+    }
+
   ACE_OS::memcpy (sbuf->data (), buf, len);
 
   ///
@@ -32,6 +32,7 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_MEM_SAP;
 class ACE_Reactive_MEM_IO;
 class ACE_MT_MEM_IO;
+class ACE_Ring_MEM_IO;
 class ACE_MEM_IO;
 
 // Internal data structure
@@ -109,12 +110,15 @@ public:
                             const ACE_Time_Value *timeout) = 0;
 
   /// request a buffer of size @a size.  Return 0 if the <shm_malloc_> is
-  /// not initialized.
-  ACE_MEM_SAP_Node *acquire_buffer (const ssize_t size);
+  /// not initialized.  A strategy that has to wait for room uses
+  /// @a timeout, and may hand out a buffer with a smaller capacity
+  /// than @a size.
+  virtual ACE_MEM_SAP_Node *acquire_buffer (const ssize_t size,
+                                            const ACE_Time_Value *timeout = 0);
 
   /// release a buffer pointed by @a buf.  Return -1 if the <shm_malloc_>
   /// is not initialized.
-  int release_buffer (ACE_MEM_SAP_Node *buf);
+  virtual int release_buffer (ACE_MEM_SAP_Node *buf);
 
   /// Dump the state of an object.
   void dump (void) const;
@@ -31,9 +31,12 @@ ACE_MEM_SAP_Node::data (void)
 
 
 ACE_INLINE ACE_MEM_SAP_Node *
-ACE_MEM_SAP::acquire_buffer (const ssize_t size)
+ACE_MEM_SAP::acquire_buffer (const ssize_t size,
+                             const ACE_Time_Value *timeout)
 {
   ACE_TRACE ("ACE_MEM_SAP::acquire_buffer");
+  ACE_UNUSED_ARG (timeout);
+
   if (this->shm_malloc_ == 0)
     return 0;                  // not initialized.
 
@@ -117,7 +117,11 @@ ACE_MMAP_Memory_Pool::ACE_MMAP_Memory_Pool (
     minimum_bytes_ (0),
     sa_ (0),
     file_mode_ (ACE_DEFAULT_FILE_PERMS),
-    install_signal_handler_ (true)
+    install_signal_handler_ (true),
+    huge_pages_ (ACE_MMAP_Memory_Pool_Options::NO_HUGE_PAGES),
+    populate_ (false),
+    numa_node_ (-1),
+    huge_page_size_ (ACE_DEFAULT_HUGE_PAGE_SIZE)
 {
   ACE_TRACE ("ACE_MMAP_Memory_Pool::ACE_MMAP_Memory_Pool");
 
@@ -152,6 +156,24 @@ ACE_MMAP_Memory_Pool::ACE_MMAP_Memory_Pool (
         this->sa_ = options->sa_;
       this->file_mode_ = options->file_mode_;
       this->install_signal_handler_ = options->install_signal_handler_;
+      this->huge_pages_ = options->huge_pages_;
+      this->populate_ = options->populate_;
+      this->numa_node_ = options->numa_node_;
+      if (options->huge_page_size_ != 0)
+        this->huge_page_size_ = options->huge_page_size_;
+
+#if defined (MAP_HUGETLB)
+      if (this->huge_pages_ == ACE_MMAP_Memory_Pool_Options::HUGETLB_PAGES)
+        ACE_SET_BITS (flags_, MAP_HUGETLB);
+#endif /* MAP_HUGETLB */
+#if defined (MAP_POPULATE)
+      // Pages that have to be advised or placed first are faulted in
+      // by place_pages() instead.
+      if (this->populate_
+          && this->numa_node_ < 0
+          && this->huge_pages_ != ACE_MMAP_Memory_Pool_Options::TRANSPARENT_HUGE_PAGES)
+        ACE_SET_BITS (flags_, MAP_POPULATE);
+#endif /* MAP_POPULATE */
     }
 
   if (backing_store_name == 0)
@@ -221,6 +243,25 @@ ACE_MMAP_Memory_Pool::commit_backing_store_name (size_t rounded_bytes,
 #if defined (__Lynx__)
   map_size = rounded_bytes;
 #else
+  if (this->huge_pages_ == ACE_MMAP_Memory_Pool_Options::HUGETLB_PAGES)
+    {
+      // hugetlbfs files can't be written to, only truncated to a
+      // multiple of the huge page size.
+      ACE_OFF_T const file_size = ACE_OS::filesize (this->mmap_.handle ());
+
+      if (file_size == -1
+          || ACE_OS::ftruncate (this->mmap_.handle (),
+                                file_size
+                                  + static_cast<ACE_OFF_T> (rounded_bytes)) == -1)
+        ACELIB_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("(%P|%t) %p\n"),
+                           this->backing_store_name_),
+                          -1);
+
+      map_size = static_cast<size_t> (file_size) + rounded_bytes;
+      return 0;
+    }
+
   size_t seek_len;
 
   if (this->write_each_page_)
@@ -323,10 +364,61 @@ ACE_MMAP_Memory_Pool::map_file (size_t map_size)
       ACE_BASED_POINTER_REPOSITORY::instance ()->bind (this->base_addr_,
                                                        map_size);
 #endif /* ACE_HAS_POSITION_INDEPENDENT_POINTERS == 1 */
+      this->place_pages ();
       return 0;
     }
 }
 
+// Advise, place and fault in the pages of the current mapping, which
+// map_file() replaces each time the pool grows.
+
+void
+ACE_MMAP_Memory_Pool::place_pages (void)
+{
+  ACE_TRACE ("ACE_MMAP_Memory_Pool::place_pages");
+
+  char *const addr = static_cast<char *> (this->mmap_.addr ());
+  size_t const len = this->mmap_.size ();
+
+  if (addr == 0 || len == 0)
+    return;
+
+  // Advice and placement are best effort, the pool works without them.
+#if defined (MADV_HUGEPAGE)
+  if (this->huge_pages_ == ACE_MMAP_Memory_Pool_Options::TRANSPARENT_HUGE_PAGES
+      && ACE_OS::madvise (addr, len, MADV_HUGEPAGE) == -1
+      && ACE::debug ())
+    ACELIB_DEBUG ((LM_DEBUG,
+                   ACE_TEXT ("(%P|%t) ACE_MMAP_Memory_Pool::place_pages, %p\n"),
+                   ACE_TEXT ("madvise")));
+#endif /* MADV_HUGEPAGE */
+
+  if (this->numa_node_ >= 0
+      && ACE::bind_to_numa_node (addr, len, this->numa_node_) == -1
+      && ACE::debug ())
+    ACELIB_DEBUG ((LM_DEBUG,
+                   ACE_TEXT ("(%P|%t) ACE_MMAP_Memory_Pool::place_pages, %p\n"),
+                   ACE_TEXT ("mbind")));
+
+#if defined (MAP_POPULATE)
+  if (ACE_BIT_ENABLED (this->flags_, MAP_POPULATE))
+    return;
+#endif /* MAP_POPULATE */
+
+  if (this->populate_)
+    {
+      // Reading a byte of each page faults it in without touching what
+      // other processes sharing the pool may be writing.
+      size_t const page_size =
+        this->huge_pages_ == ACE_MMAP_Memory_Pool_Options::HUGETLB_PAGES
+          ? this->huge_page_size_
+          : ACE::round_to_pagesize (1);
+      char const volatile *page = addr;
+      for (size_t offset = 0; offset < len; offset += page_size)
+        (void) page[offset];
+    }
+}
+
 // Ask operating system for more shared memory, increasing the mapping
 // accordingly.  Note that this routine assumes that the appropriate
 // locks are held when it is called.
@@ -415,6 +507,7 @@ ACE_MMAP_Memory_Pool::init_acquire (size_t nbytes,
                                                        this->mmap_.size());
 #endif /* ACE_HAS_POSITION_INDEPENDENT_POINTERS == 1 */
 
+      this->place_pages ();
       return this->mmap_.addr ();
     }
   else
@@ -470,7 +563,11 @@ ACE_MMAP_Memory_Pool_Options::ACE_MMAP_Memory_Pool_Options (
   LPSECURITY_ATTRIBUTES sa,
   mode_t file_mode,
   bool unique,
-  bool install_signal_handler)
+  bool install_signal_handler,
+  int huge_pages,
+  bool populate,
+  int numa_node,
+  size_t huge_page_size)
   : base_addr_ (base_addr),
     use_fixed_addr_ (use_fixed_addr),
     write_each_page_ (write_each_page),
@@ -480,7 +577,11 @@ ACE_MMAP_Memory_Pool_Options::ACE_MMAP_Memory_Pool_Options (
     sa_ (sa),
     file_mode_ (file_mode),
     unique_ (unique),
-    install_signal_handler_ (install_signal_handler)
+    install_signal_handler_ (install_signal_handler),
+    huge_pages_ (huge_pages),
+    populate_ (populate),
+    numa_node_ (numa_node),
+    huge_page_size_ (huge_page_size)
 {
   ACE_TRACE ("ACE_MMAP_Memory_Pool_Options::ACE_MMAP_Memory_Pool_Options");
   // for backwards compatibility
@@ -557,6 +658,11 @@ size_t
 ACE_MMAP_Memory_Pool::round_up (size_t nbytes)
 {
   ACE_TRACE ("ACE_MMAP_Memory_Pool::round_up");
+
+  if (this->huge_pages_ == ACE_MMAP_Memory_Pool_Options::HUGETLB_PAGES)
+    return (nbytes + this->huge_page_size_ - 1)
+      / this->huge_page_size_ * this->huge_page_size_;
+
   return ACE::round_to_pagesize (nbytes);
 }
 
@@ -61,6 +61,25 @@ public:
     NEVER_FIXED = 2
   };
 
+  enum
+  {
+    /// The pages of the pool have the base page size.
+    NO_HUGE_PAGES = 0,
+
+    /**
+     * Advise the kernel to back the pool with transparent huge pages.
+     * For a shared mapping this only has an effect when the backing
+     * store is on tmpfs and the kernel allows huge pages there.
+     */
+    TRANSPARENT_HUGE_PAGES = 1,
+
+    /**
+     * Map the pool with @c MAP_HUGETLB.  The backing store must be on
+     * a hugetlbfs mount, and the pool grows by whole huge pages.
+     */
+    HUGETLB_PAGES = 2
+  };
+
   /// Constructor
   ACE_MMAP_Memory_Pool_Options (const void *base_addr = ACE_DEFAULT_BASE_ADDR,
                                 int use_fixed_addr = ALWAYS_FIXED,
@@ -71,7 +90,11 @@ public:
                                 LPSECURITY_ATTRIBUTES sa = 0,
                                 mode_t file_mode = ACE_DEFAULT_FILE_PERMS,
                                 bool unique_ = false,
-                                bool install_signal_handler = true);
+                                bool install_signal_handler = true,
+                                int huge_pages = NO_HUGE_PAGES,
+                                bool populate = false,
+                                int numa_node = -1,
+                                size_t huge_page_size = ACE_DEFAULT_HUGE_PAGE_SIZE);
 
   /// Base address of the memory-mapped backing store.
   const void *base_addr_;
@@ -119,6 +142,23 @@ public:
   /// Should we install a signal handler
   bool install_signal_handler_;
 
+  /// Whether the pool uses huge pages, and which kind.
+  int huge_pages_;
+
+  /**
+   * Fault all the pages of the pool in whenever it is mapped, so that
+   * the first access to them doesn't take a page fault.  This uses
+   * @c MAP_POPULATE unless the pages must be placed first.
+   */
+  bool populate_;
+
+  /// NUMA node to place the pages of the pool on, with mbind(2), or
+  /// -1 to leave them to the memory policy of the process.
+  int numa_node_;
+
+  /// Size of the pages of a pool with @c HUGETLB_PAGES.
+  size_t huge_page_size_;
+
 private:
   // Prevent copying
   ACE_MMAP_Memory_Pool_Options (const ACE_MMAP_Memory_Pool_Options &);
@@ -238,6 +278,10 @@ protected:
   /// Memory map the file up to @a map_size bytes.
   virtual int map_file (size_t map_size);
 
+  /// Apply the huge page advice, NUMA placement and pre-faulting of
+  /// the options to the current mapping.
+  void place_pages (void);
+
 #if !defined (ACE_WIN32)
   /**
    * Handle SIGSEGV and SIGBUS signals to remap memory properly.  When a
@@ -299,6 +343,18 @@ protected:
 
   /// Should we install a signal handler
   bool install_signal_handler_;
+
+  /// Whether the pool uses huge pages, and which kind.
+  int huge_pages_;
+
+  /// Should the pages be faulted in when they are mapped?
+  bool populate_;
+
+  /// NUMA node the pages are placed on, or -1.
+  int numa_node_;
+
+  /// Size of the pages when @c huge_pages_ is @c HUGETLB_PAGES.
+  size_t huge_page_size_;
 };
 
 /**
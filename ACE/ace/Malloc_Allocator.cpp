@@ -103,6 +103,13 @@ ACE_Allocator::ACE_Allocator (void)
   ACE_TRACE ("ACE_Allocator::ACE_Allocator");
 }
 
+void *
+ACE_Allocator::malloc_colocated (size_type, size_type, void *&buffer)
+{
+  buffer = 0;
+  return 0;
+}
+
 /******************************************************************************/
 
 void *
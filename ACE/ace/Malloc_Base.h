@@ -76,6 +76,18 @@ public:
   /// Free @a ptr (must have been allocated by ACE_Allocator::malloc()).
   virtual void free (void *ptr) = 0;
 
+  /**
+   * Allocate @a header_size bytes followed by a buffer of @a nbytes
+   * bytes in a single block and set @a buffer to the latter, so that
+   * an object and the data it manages take one allocation.  free() of
+   * @a buffer does nothing, free() of the returned block releases both.
+   * Returns 0 if the allocator can't do this, which is the default, in
+   * which case the caller allocates them separately.
+   */
+  virtual void *malloc_colocated (size_type header_size,
+                                  size_type nbytes,
+                                  void *&buffer);
+
   /// Remove any resources associated with this memory manager.
   virtual int remove (void) = 0;
 
@@ -53,6 +53,37 @@ ACE_TIMEPROBE_EVENT_DESCRIPTIONS (ACE_MB_Timeprobe_Description,
 
 #endif /* ACE_ENABLE_TIMEPROBES */
 
+// Create a data block whose buffer is part of the same allocation,
+// if @a allocator_strategy supports that.  Both are then released by
+// @a allocator_strategy.
+static ACE_Data_Block *
+ace_colocated_data_block (size_t size,
+                          ACE_Message_Block::ACE_Message_Type msg_type,
+                          ACE_Allocator *allocator_strategy,
+                          ACE_Lock *locking_strategy,
+                          ACE_Message_Block::Message_Flags flags)
+{
+  void *buffer = 0;
+  void *memory =
+    allocator_strategy->malloc_colocated (sizeof (ACE_Data_Block),
+                                          size,
+                                          buffer);
+  if (memory == 0)
+    return 0;
+
+#if defined (ACE_INITIALIZE_MEMORY_BEFORE_USE)
+  (void) ACE_OS::memset (buffer, '\0', size);
+#endif /* ACE_INITIALIZE_MEMORY_BEFORE_USE */
+
+  return new (memory) ACE_Data_Block (size,
+                                      msg_type,
+                                      static_cast<char *> (buffer),
+                                      allocator_strategy,
+                                      locking_strategy,
+                                      flags,
+                                      allocator_strategy);
+}
+
 void
 ACE_Message_Block::data_block (ACE_Data_Block *db)
 {
@@ -709,6 +740,15 @@ ACE_Message_Block::init_i (size_t size,
       this->data_block_ = 0;
     }
 
+  // Save an allocation if the buffer can share the memory of the
+  // data block.
+  if (db == 0 && msg_data == 0 && allocator_strategy != 0)
+    db = ace_colocated_data_block (size,
+                                   msg_type,
+                                   allocator_strategy,
+                                   locking_strategy,
+                                   flags);
+
   if (db == 0)
     {
       if (data_block_allocator == 0)
@@ -1152,7 +1192,16 @@ ACE_Data_Block::clone_nocopy (ACE_Message_Block::Message_Flags mask,
   const size_t newsize =
     max_size == 0 ? this->max_size_ : max_size;
 
-  ACE_Data_Block *nb = 0;
+  ACE_Data_Block *nb = ace_colocated_data_block (newsize,
+                                                this->type_,
+                                                this->allocator_strategy_,
+                                                this->locking_strategy_,
+                                                this->flags_);
+  if (nb != 0)
+    {
+      nb->clr_flags (mask | always_clear);
+      return nb;
+    }
 
   ACE_NEW_MALLOC_RETURN (nb,
                          static_cast<ACE_Data_Block*> (
@@ -44,6 +44,15 @@ namespace ACE_OS
                size_t len,
                int map_advice);
 
+  /// Set the NUMA memory policy of a range, see mbind(2).
+  ACE_NAMESPACE_INLINE_FUNCTION
+  int mbind (void *addr,
+             size_t len,
+             int mode,
+             const unsigned long *nodemask,
+             unsigned long maxnode,
+             unsigned int flags);
+
   ACE_NAMESPACE_INLINE_FUNCTION
   void *mmap (void *addr,
               size_t len,
@@ -28,6 +28,36 @@ ACE_OS::madvise (caddr_t addr, size_t len, int map_advice)
 #endif /* ACE_WIN32 */
 }
 
+ACE_INLINE int
+ACE_OS::mbind (void *addr,
+               size_t len,
+               int mode,
+               const unsigned long *nodemask,
+               unsigned long maxnode,
+               unsigned int flags)
+{
+  ACE_OS_TRACE ("ACE_OS::mbind");
+#if defined (ACE_HAS_MBIND)
+  // glibc has no wrapper, it is in libnuma.
+  ACE_OSCALL_RETURN (::syscall (__NR_mbind,
+                                addr,
+                                len,
+                                mode,
+                                nodemask,
+                                maxnode,
+                                flags),
+                     int, -1);
+#else
+  ACE_UNUSED_ARG (addr);
+  ACE_UNUSED_ARG (len);
+  ACE_UNUSED_ARG (mode);
+  ACE_UNUSED_ARG (nodemask);
+  ACE_UNUSED_ARG (maxnode);
+  ACE_UNUSED_ARG (flags);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_MBIND */
+}
+
 ACE_INLINE void *
 ACE_OS::mmap (void *addr,
               size_t len,
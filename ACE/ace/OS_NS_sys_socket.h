@@ -103,6 +103,17 @@ namespace ACE_OS
                      int *addrlen,
                      const ACE_Accept_QoS_Params &qos_params);
 
+  /**
+   * Linux @c accept4, which sets @a flags (@c SOCK_NONBLOCK,
+   * @c SOCK_CLOEXEC) on the new handle in the same system call.
+   * Returns ACE_INVALID_HANDLE with @c ENOTSUP on other platforms.
+   */
+  ACE_NAMESPACE_INLINE_FUNCTION
+  ACE_HANDLE accept4 (ACE_HANDLE handle,
+                      struct sockaddr *addr,
+                      int *addrlen,
+                      int flags);
+
   ACE_NAMESPACE_INLINE_FUNCTION
   int bind (ACE_HANDLE s,
             struct sockaddr *name,
@@ -193,6 +204,17 @@ namespace ACE_OS
                    struct msghdr *msg,
                    int flags);
 
+  /**
+   * Receive up to @a vlen messages in one system call (Linux
+   * @c recvmmsg), setting the @c msg_len of each.  Returns the number
+   * of messages received, or -1 with @c ENOTSUP on other platforms.
+   */
+  ACE_NAMESPACE_INLINE_FUNCTION
+  int recvmmsg (ACE_HANDLE handle,
+                ACE_mmsghdr *msgvec,
+                unsigned int vlen,
+                int flags);
+
 #if !defined ACE_LACKS_RECVMSG && defined ACE_HAS_WINSOCK2 && ACE_HAS_WINSOCK2
   extern ACE_Export
   int recvmsg_win32_i (ACE_HANDLE handle,
@@ -225,6 +247,17 @@ namespace ACE_OS
                    const struct msghdr *msg,
                    int flags);
 
+  /**
+   * Send up to @a vlen messages in one system call (Linux
+   * @c sendmmsg), setting the @c msg_len of each.  Returns the number
+   * of messages sent, or -1 with @c ENOTSUP on other platforms.
+   */
+  ACE_NAMESPACE_INLINE_FUNCTION
+  int sendmmsg (ACE_HANDLE handle,
+                ACE_mmsghdr *msgvec,
+                unsigned int vlen,
+                int flags);
+
 #if !defined ACE_LACKS_RECVMSG && defined ACE_HAS_WINSOCK2 && ACE_HAS_WINSOCK2
   extern ACE_Export
   int sendmsg_win32_i (ACE_HANDLE handle,
@@ -95,6 +95,35 @@ ACE_OS::accept (ACE_HANDLE handle,
 #endif /* defined (ACE_WIN32) */
 }
 
+ACE_INLINE ACE_HANDLE
+ACE_OS::accept4 (ACE_HANDLE handle,
+                 struct sockaddr *addr,
+                 int *addrlen,
+                 int flags)
+{
+  ACE_OS_TRACE ("ACE_OS::accept4");
+#if defined (ACE_HAS_ACCEPT4)
+  ACE_HANDLE const ace_result = ::accept4 ((ACE_SOCKET) handle,
+                                           addr,
+                                           (ACE_SOCKET_LEN *) addrlen,
+                                           flags);
+
+# if !(defined (EAGAIN) && defined (EWOULDBLOCK) && EAGAIN == EWOULDBLOCK)
+  // See ACE_OS::accept() above.
+  if (ace_result == ACE_INVALID_HANDLE && errno == EAGAIN)
+    errno = EWOULDBLOCK;
+# endif /* EAGAIN != EWOULDBLOCK*/
+
+  return ace_result;
+#else
+  ACE_UNUSED_ARG (handle);
+  ACE_UNUSED_ARG (addr);
+  ACE_UNUSED_ARG (addrlen);
+  ACE_UNUSED_ARG (flags);
+  ACE_NOTSUP_RETURN (ACE_INVALID_HANDLE);
+#endif /* ACE_HAS_ACCEPT4 */
+}
+
 ACE_INLINE int
 ACE_OS::bind (ACE_HANDLE handle, struct sockaddr *addr, int addrlen)
 {
@@ -503,6 +532,36 @@ ACE_OS::recvmsg (ACE_HANDLE handle, struct msghdr *msg, int flags)
 #endif /* ACE_LACKS_RECVMSG */
 }
 
+ACE_INLINE int
+ACE_OS::recvmmsg (ACE_HANDLE handle,
+                  ACE_mmsghdr *msgvec,
+                  unsigned int vlen,
+                  int flags)
+{
+  ACE_OS_TRACE ("ACE_OS::recvmmsg");
+#if defined (ACE_HAS_RECVMMSG)
+  int const ace_result = ::recvmmsg ((ACE_SOCKET) handle,
+                                     msgvec,
+                                     vlen,
+                                     flags,
+                                     0);
+
+# if !(defined (EAGAIN) && defined (EWOULDBLOCK) && EAGAIN == EWOULDBLOCK)
+  // See ACE_OS::accept() above.
+  if (ace_result == -1 && errno == EAGAIN)
+    errno = EWOULDBLOCK;
+# endif /* EAGAIN != EWOULDBLOCK*/
+
+  return ace_result;
+#else
+  ACE_UNUSED_ARG (handle);
+  ACE_UNUSED_ARG (msgvec);
+  ACE_UNUSED_ARG (vlen);
+  ACE_UNUSED_ARG (flags);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_RECVMMSG */
+}
+
 ACE_INLINE ssize_t
 ACE_OS::recvv (ACE_HANDLE handle,
                iovec *buffers,
@@ -664,6 +723,35 @@ ACE_OS::sendmsg (ACE_HANDLE handle,
 #endif /* ACE_LACKS_SENDMSG */
 }
 
+ACE_INLINE int
+ACE_OS::sendmmsg (ACE_HANDLE handle,
+                  ACE_mmsghdr *msgvec,
+                  unsigned int vlen,
+                  int flags)
+{
+  ACE_OS_TRACE ("ACE_OS::sendmmsg");
+#if defined (ACE_HAS_SENDMMSG)
+  int const ace_result = ::sendmmsg ((ACE_SOCKET) handle,
+                                     msgvec,
+                                     vlen,
+                                     flags);
+
+# if !(defined (EAGAIN) && defined (EWOULDBLOCK) && EAGAIN == EWOULDBLOCK)
+  // See ACE_OS::accept() above.
+  if (ace_result == -1 && errno == EAGAIN)
+    errno = EWOULDBLOCK;
+# endif /* EAGAIN != EWOULDBLOCK*/
+
+  return ace_result;
+#else
+  ACE_UNUSED_ARG (handle);
+  ACE_UNUSED_ARG (msgvec);
+  ACE_UNUSED_ARG (vlen);
+  ACE_UNUSED_ARG (flags);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_SENDMMSG */
+}
+
 ACE_INLINE ssize_t
 ACE_OS::sendto (ACE_HANDLE handle,
                 const char *buf,
@@ -68,7 +68,10 @@ public:
     PROACTOR_SUN    = 3,
 
     /// Callback notifications
-    PROACTOR_CB     = 4
+    PROACTOR_CB     = 4,
+
+    /// Linux io_uring
+    PROACTOR_URING  = 5
   };
 
 
@@ -93,7 +96,10 @@ public:
 
   enum Opcode {
     ACE_OPCODE_READ = 1,
-    ACE_OPCODE_WRITE = 2
+    ACE_OPCODE_WRITE = 2,
+    /// Only supported by the ACE_Uring_Proactor.
+    ACE_OPCODE_ACCEPT = 3,
+    ACE_OPCODE_CONNECT = 4
   };
 
   virtual Proactor_Type  get_impl_type (void);
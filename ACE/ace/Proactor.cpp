@@ -22,6 +22,7 @@
 #if defined (ACE_HAS_AIO_CALLS)
 #   include "ace/POSIX_Proactor.h"
 #   include "ace/POSIX_CB_Proactor.h"
+#   include "ace/Uring_Proactor.h"
 #else /* !ACE_HAS_AIO_CALLS */
 #   include "ace/WIN32_Proactor.h"
 #endif /* ACE_HAS_AIO_CALLS */
@@ -331,6 +332,14 @@ ACE_Proactor::ACE_Proactor (ACE_Proactor_Impl *implementation,
       ACE_NEW (implementation, ACE_POSIX_AIOCB_Proactor);
 #  elif defined (ACE_POSIX_SIG_PROACTOR)
       ACE_NEW (implementation, ACE_POSIX_SIG_Proactor);
+#  elif defined (ACE_URING_PROACTOR) && defined (ACE_HAS_IO_URING)
+      // Fall back to the callback Proactor on kernels without io_uring.
+      ACE_NEW (implementation, ACE_Uring_Proactor);
+      if (implementation->get_handle () == ACE_INVALID_HANDLE)
+        {
+          delete implementation;
+          ACE_NEW (implementation, ACE_POSIX_CB_Proactor);
+        }
 #  else /* Default order: CB, SIG, AIOCB */
 #    if !defined(ACE_HAS_BROKEN_SIGEVENT_STRUCT)
       ACE_NEW (implementation, ACE_POSIX_CB_Proactor);
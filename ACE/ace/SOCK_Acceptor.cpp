@@ -4,6 +4,7 @@
 #include "ace/OS_Errno.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_sys_socket.h"
+#include "ace/OS_NS_fcntl.h"
 #include "ace/os_include/os_fcntl.h"
 #if defined (ACE_HAS_ALLOC_HOOKS)
 # include "ace/Malloc_Base.h"
@@ -23,9 +24,29 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 ACE_ALLOC_HOOK_DEFINE(ACE_SOCK_Acceptor)
 
+// Put @a handle in the modes of the ACE_SOCK_Acceptor::accept_flags()
+// @a flags.
+static int
+set_accept_flags (ACE_HANDLE handle, int flags)
+{
+  if (ACE_BIT_ENABLED (flags, ACE_SOCK_Acceptor::ACCEPT_NONBLOCK)
+      && ACE::set_flags (handle, ACE_NONBLOCK) == -1)
+    return -1;
+
+#if defined (F_SETFD)
+  if (ACE_BIT_ENABLED (flags, ACE_SOCK_Acceptor::ACCEPT_CLOEXEC)
+      && ACE_OS::fcntl (handle, F_SETFD, FD_CLOEXEC) == -1)
+    return -1;
+#endif /* F_SETFD */
+
+  return 0;
+}
+
 // Do nothing routine for constructor.
 
 ACE_SOCK_Acceptor::ACE_SOCK_Acceptor (void)
+  : reuse_port_ (false),
+    accept_flags_ (0)
 {
   ACE_TRACE ("ACE_SOCK_Acceptor::ACE_SOCK_Acceptor");
 }
@@ -85,8 +106,9 @@ ACE_SOCK_Acceptor::shared_accept_finish (ACE_SOCK_Stream new_stream,
       // originally.
       ACE::clr_flags (this->get_handle (),
                       ACE_NONBLOCK);
-      ACE::clr_flags (new_handle,
-                      ACE_NONBLOCK);
+      if (ACE_BIT_DISABLED (this->accept_flags_, ACCEPT_NONBLOCK))
+        ACE::clr_flags (new_handle,
+                        ACE_NONBLOCK);
     }
 
 #if defined (ACE_HAS_WINSOCK2) && (ACE_HAS_WINSOCK2 != 0)
@@ -132,9 +154,7 @@ ACE_SOCK_Acceptor::accept (ACE_SOCK_Stream &new_stream,
         }
 
       do
-        new_stream.set_handle (ACE_OS::accept (this->get_handle (),
-                                               addr,
-                                               len_ptr));
+        new_stream.set_handle (this->accept_i (addr, len_ptr));
       while (new_stream.get_handle () == ACE_INVALID_HANDLE
              && restart
              && errno == EINTR
@@ -197,6 +217,14 @@ ACE_SOCK_Acceptor::accept (ACE_SOCK_Stream &new_stream,
              && errno == EINTR
              && timeout == 0);
 
+      if (new_stream.get_handle () != ACE_INVALID_HANDLE
+          && set_accept_flags (new_stream.get_handle (),
+                               this->accept_flags_) == -1)
+        {
+          ACE_Errno_Guard error (errno);
+          new_stream.close ();
+        }
+
       // Reset the size of the addr, which is only necessary for UNIX
       // domain sockets.
       if (new_stream.get_handle () != ACE_INVALID_HANDLE
@@ -210,6 +238,35 @@ ACE_SOCK_Acceptor::accept (ACE_SOCK_Stream &new_stream,
 }
 #endif  // ACE_HAS_WINCE
 
+ACE_HANDLE
+ACE_SOCK_Acceptor::accept_i (sockaddr *addr, int *addrlen) const
+{
+#if defined (ACE_HAS_ACCEPT4)
+  if (this->accept_flags_ != 0)
+    {
+      int flags = 0;
+      if (ACE_BIT_ENABLED (this->accept_flags_, ACCEPT_NONBLOCK))
+        ACE_SET_BITS (flags, SOCK_NONBLOCK);
+      if (ACE_BIT_ENABLED (this->accept_flags_, ACCEPT_CLOEXEC))
+        ACE_SET_BITS (flags, SOCK_CLOEXEC);
+      return ACE_OS::accept4 (this->get_handle (), addr, addrlen, flags);
+    }
+#endif /* ACE_HAS_ACCEPT4 */
+
+  ACE_HANDLE const handle = ACE_OS::accept (this->get_handle (),
+                                            addr,
+                                            addrlen);
+  if (handle != ACE_INVALID_HANDLE
+      && set_accept_flags (handle, this->accept_flags_) == -1)
+    {
+      ACE_Errno_Guard error (errno);
+      ACE_OS::closesocket (handle);
+      return ACE_INVALID_HANDLE;
+    }
+
+  return handle;
+}
+
 void
 ACE_SOCK_Acceptor::dump (void) const
 {
@@ -227,6 +284,28 @@ ACE_SOCK_Acceptor::shared_open (const ACE_Addr &local_sap,
   ACE_TRACE ("ACE_SOCK_Acceptor::shared_open");
   int error = 0;
 
+  if (this->reuse_port_)
+    {
+#if defined (SO_REUSEPORT)
+      int one = 1;
+      if (this->set_option (SOL_SOCKET,
+                            SO_REUSEPORT,
+                            &one,
+                            sizeof one) == -1)
+        error = 1;
+#else
+      errno = ENOTSUP;
+      error = 1;
+#endif /* SO_REUSEPORT */
+
+      if (error != 0)
+        {
+          ACE_Errno_Guard g (errno);    // Preserve across close() below.
+          this->close ();
+          return -1;
+        }
+    }
+
 #if !defined (ACE_HAS_IPV6)
   ACE_UNUSED_ARG (ipv6_only);
 #else /* defined (ACE_HAS_IPV6) */
@@ -352,6 +431,8 @@ ACE_SOCK_Acceptor::ACE_SOCK_Acceptor (const ACE_Addr &local_sap,
                                       int backlog,
                                       int protocol,
                                       int ipv6_only)
+  : reuse_port_ (false),
+    accept_flags_ (0)
 {
   ACE_TRACE ("ACE_SOCK_Acceptor::ACE_SOCK_Acceptor");
   if (this->open (local_sap,
@@ -411,6 +492,8 @@ ACE_SOCK_Acceptor::ACE_SOCK_Acceptor (const ACE_Addr &local_sap,
                                       int backlog,
                                       int protocol,
                                       int ipv6_only)
+  : reuse_port_ (false),
+    accept_flags_ (0)
 {
   ACE_TRACE ("ACE_SOCK_Acceptor::ACE_SOCK_Acceptor");
   if (this->open (local_sap,
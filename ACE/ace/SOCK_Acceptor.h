@@ -37,6 +37,15 @@ class ACE_Accept_QoS_Params;
 class ACE_Export ACE_SOCK_Acceptor : public ACE_SOCK
 {
 public:
+  /// Flags for accept_flags().
+  enum
+  {
+    /// New connections are in non-blocking mode.
+    ACCEPT_NONBLOCK = 1,
+    /// New connections are closed on exec.
+    ACCEPT_CLOEXEC = 2
+  };
+
   /// Default constructor.
   ACE_SOCK_Acceptor (void);
 
@@ -138,6 +147,26 @@ public:
               bool reset_new_handle = false) const;
 #endif  // ACE_HAS_WINCE
 
+  /**
+   * Set @c SO_REUSEPORT on the socket before open() binds it, so that
+   * several acceptors, each owned by its own reactor or thread, can
+   * listen on the same endpoint; the kernel spreads the new
+   * connections over them.  Must be set before open() and on every
+   * acceptor sharing the endpoint.  open() fails with @c ENOTSUP on
+   * platforms without @c SO_REUSEPORT.
+   */
+  void reuse_port (bool reuse_port);
+  bool reuse_port (void) const;
+
+  /**
+   * Set the modes, ACCEPT_NONBLOCK and/or ACCEPT_CLOEXEC, the handles
+   * of new connections are put in by accept().  Where @c accept4 is
+   * available they are set by the accept system call itself,
+   * elsewhere right after it.
+   */
+  void accept_flags (int flags);
+  int accept_flags (void) const;
+
   // = Meta-type info
   typedef ACE_INET_Addr PEER_ADDR;
   typedef ACE_SOCK_Stream PEER_STREAM;
@@ -171,9 +200,19 @@ protected:
                    int backlog,
                    int ipv6_only);
 
+  /// Accept a new connection on the socket, putting its handle in
+  /// the modes of @c accept_flags_.
+  ACE_HANDLE accept_i (sockaddr *addr, int *addrlen) const;
+
 private:
   /// Do not allow this function to percolate up to this interface...
   int get_remote_addr (ACE_Addr &) const;
+
+  /// Set @c SO_REUSEPORT before binding the socket.
+  bool reuse_port_;
+
+  /// Modes of the handles of new connections.
+  int accept_flags_;
 };
 
 ACE_END_VERSIONED_NAMESPACE_DECL
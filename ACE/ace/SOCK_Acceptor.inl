@@ -7,4 +7,28 @@ ACE_SOCK_Acceptor::~ACE_SOCK_Acceptor (void)
   ACE_TRACE ("ACE_SOCK_Acceptor::~ACE_SOCK_Acceptor");
 }
 
+ACE_INLINE void
+ACE_SOCK_Acceptor::reuse_port (bool reuse_port)
+{
+  this->reuse_port_ = reuse_port;
+}
+
+ACE_INLINE bool
+ACE_SOCK_Acceptor::reuse_port (void) const
+{
+  return this->reuse_port_;
+}
+
+ACE_INLINE void
+ACE_SOCK_Acceptor::accept_flags (int flags)
+{
+  this->accept_flags_ = flags;
+}
+
+ACE_INLINE int
+ACE_SOCK_Acceptor::accept_flags (void) const
+{
+  return this->accept_flags_;
+}
+
 ACE_END_VERSIONED_NAMESPACE_DECL
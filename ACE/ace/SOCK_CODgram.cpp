@@ -1,5 +1,7 @@
 #include "ace/SOCK_CODgram.h"
+#include "ace/Dgram_Batch.h"
 #include "ace/Log_Category.h"
+#include "ace/ACE.h"
 #include "ace/OS_NS_sys_socket.h"
 #if defined (ACE_HAS_ALLOC_HOOKS)
 # include "ace/Malloc_Base.h"
@@ -147,4 +149,25 @@ ACE_SOCK_CODgram::open (const ACE_Addr &remote, const ACE_Addr &local,
     }
 }
 
+ssize_t
+ACE_SOCK_CODgram::recv (ACE_Dgram_Batch &batch,
+                        int flags,
+                        const ACE_Time_Value *timeout) const
+{
+  ACE_TRACE ("ACE_SOCK_CODgram::recv");
+  if (timeout != 0
+      && ACE::handle_read_ready (this->get_handle (), timeout) != 1)
+    return -1;
+
+  return batch.recv (this->get_handle (), flags);
+}
+
+ssize_t
+ACE_SOCK_CODgram::send (ACE_Dgram_Batch &batch,
+                        int flags) const
+{
+  ACE_TRACE ("ACE_SOCK_CODgram::send");
+  return batch.send (this->get_handle (), flags);
+}
+
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -25,6 +25,8 @@
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
+class ACE_Dgram_Batch;
+
 /**
  * @class ACE_SOCK_CODgram
  *
@@ -121,6 +123,26 @@ public:
             int protocol = 0,
             int reuse_addr = 0);
 
+  using ACE_SOCK_IO::recv;
+  using ACE_SOCK_IO::send;
+
+  /**
+   * Receive a burst of datagrams into @a batch (uses <recvmmsg(2)>
+   * where available).  Waits up to @a timeout, or until action is
+   * possible if @a timeout == 0, for the first datagram, then takes
+   * those already queued up to the capacity of @a batch.  Returns the
+   * number of datagrams received.
+   */
+  ssize_t recv (ACE_Dgram_Batch &batch,
+                int flags = 0,
+                const ACE_Time_Value *timeout = 0) const;
+
+  /// Send the datagrams of @a batch to the connected peer (uses
+  /// <sendmmsg(2)> where available).  Returns the number of datagrams
+  /// sent.
+  ssize_t send (ACE_Dgram_Batch &batch,
+                int flags = 0) const;
+
   // = Meta-type info.
   typedef ACE_INET_Addr PEER_ADDR;
 
@@ -1,5 +1,6 @@
 #include "ace/SOCK_Dgram.h"
 
+#include "ace/Dgram_Batch.h"
 #include "ace/Log_Category.h"
 #include "ace/INET_Addr.h"
 #include "ace/ACE.h"
@@ -8,6 +9,11 @@
 #include "ace/OS_NS_ctype.h"
 #include "ace/os_include/net/os_if.h"
 #include "ace/Truncate.h"
+#include "ace/Min_Max.h"
+
+#if defined (ACE_HAS_UDP_SEGMENT) || defined (ACE_HAS_UDP_GRO)
+#  include /**/ <netinet/udp.h>
+#endif /* ACE_HAS_UDP_SEGMENT || ACE_HAS_UDP_GRO */
 #if defined (ACE_HAS_ALLOC_HOOKS)
 # include "ace/Malloc_Base.h"
 #endif /* ACE_HAS_ALLOC_HOOKS */
@@ -575,6 +581,198 @@ ACE_SOCK_Dgram::send (const void *buf,
     }
 }
 
+ssize_t
+ACE_SOCK_Dgram::recv (ACE_Dgram_Batch &batch,
+                      int flags,
+                      const ACE_Time_Value *timeout) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::recv");
+  if (timeout != 0
+      && ACE::handle_read_ready (this->get_handle (), timeout) != 1)
+    return -1;
+
+  return batch.recv (this->get_handle (), flags);
+}
+
+ssize_t
+ACE_SOCK_Dgram::send (ACE_Dgram_Batch &batch,
+                      int flags) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::send");
+  return batch.send (this->get_handle (), flags);
+}
+
+ssize_t
+ACE_SOCK_Dgram::send_segments (const iovec iov[],
+                               int n,
+                               size_t segment_size,
+                               const ACE_Addr &addr,
+                               int flags) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::send_segments");
+
+  if (segment_size == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  size_t total = 0;
+  for (int i = 0; i < n; ++i)
+    total += iov[i].iov_len;
+
+  if (total <= segment_size)
+    return this->send (iov, n, addr, flags);
+
+#if defined (ACE_HAS_UDP_SEGMENT)
+  if (segment_size <= ACE_UINT16_MAX)
+    {
+      union
+      {
+        cmsghdr header_;
+        u_char space_[ACE_CMSG_SPACE (sizeof (ACE_UINT16))];
+      } control;
+
+      msghdr send_msg;
+      ACE_OS::memset (&send_msg, 0, sizeof send_msg);
+      send_msg.msg_iov = const_cast<iovec *> (iov);
+      send_msg.msg_iovlen = n;
+      send_msg.msg_name = (struct sockaddr *) addr.get_addr ();
+      send_msg.msg_namelen = addr.get_size ();
+      send_msg.msg_control = &control;
+      send_msg.msg_controllen = sizeof control;
+
+      cmsghdr *cmsg = ACE_CMSG_FIRSTHDR (&send_msg);
+      cmsg->cmsg_level = SOL_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN (sizeof (ACE_UINT16));
+      ACE_UINT16 const gso_size = static_cast<ACE_UINT16> (segment_size);
+      ACE_OS::memcpy (ACE_CMSG_DATA (cmsg), &gso_size, sizeof gso_size);
+
+      ssize_t const result =
+        ACE_OS::sendmsg (this->get_handle (), &send_msg, flags);
+
+      // The kernel refuses too many datagrams at once, and devices that
+      // can't checksum them; send those one by one.
+      if (result != -1
+          || (errno != EINVAL && errno != EIO && errno != ENOPROTOOPT))
+        return result;
+    }
+#endif /* ACE_HAS_UDP_SEGMENT */
+
+  iovec segment[ACE_IOV_MAX];
+  size_t sent = 0;
+  int i = 0;
+  size_t offset = 0;
+
+  while (sent < total)
+    {
+      // Gather the next segment_size bytes.
+      int count = 0;
+      size_t length = 0;
+      while (i < n && length < segment_size)
+        {
+          size_t const left = iov[i].iov_len - offset;
+          if (left == 0)
+            {
+              ++i;
+              offset = 0;
+              continue;
+            }
+
+          if (count == ACE_IOV_MAX)
+            {
+              errno = EMSGSIZE;
+              return sent == 0 ? -1 : static_cast<ssize_t> (sent);
+            }
+
+          size_t const take = ACE_MIN (left, segment_size - length);
+          segment[count].iov_base = static_cast<char *> (iov[i].iov_base) + offset;
+          segment[count].iov_len = take;
+          ++count;
+          length += take;
+          offset += take;
+        }
+
+      if (this->send (segment, count, addr, flags) == -1)
+        return sent == 0 ? -1 : static_cast<ssize_t> (sent);
+
+      sent += length;
+    }
+
+  return static_cast<ssize_t> (sent);
+}
+
+ssize_t
+ACE_SOCK_Dgram::recv_segments (void *buf,
+                               size_t n,
+                               ACE_Addr &addr,
+                               size_t &segment_size,
+                               int flags) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::recv_segments");
+
+#if defined (ACE_HAS_UDP_GRO)
+  union
+  {
+    cmsghdr header_;
+    u_char space_[ACE_CMSG_SPACE (sizeof (int))];
+  } control;
+
+  iovec iov;
+  iov.iov_base = static_cast<char *> (buf);
+  iov.iov_len = n;
+
+  msghdr recv_msg;
+  ACE_OS::memset (&recv_msg, 0, sizeof recv_msg);
+  recv_msg.msg_iov = &iov;
+  recv_msg.msg_iovlen = 1;
+  recv_msg.msg_name = (struct sockaddr *) addr.get_addr ();
+  recv_msg.msg_namelen = addr.get_size ();
+  recv_msg.msg_control = &control;
+  recv_msg.msg_controllen = sizeof control;
+
+  ssize_t const result =
+    ACE_OS::recvmsg (this->get_handle (), &recv_msg, flags);
+  if (result == -1)
+    return -1;
+
+  addr.set_size (recv_msg.msg_namelen);
+  addr.set_type (((sockaddr_in *) addr.get_addr ())->sin_family);
+
+  segment_size = static_cast<size_t> (result);
+  for (cmsghdr *cmsg = ACE_CMSG_FIRSTHDR (&recv_msg);
+       cmsg != 0;
+       cmsg = ACE_CMSG_NXTHDR (&recv_msg, cmsg))
+    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+      {
+        int gso_size = 0;
+        ACE_OS::memcpy (&gso_size, ACE_CMSG_DATA (cmsg), sizeof gso_size);
+        segment_size = static_cast<size_t> (gso_size);
+      }
+
+  return result;
+#else
+  ssize_t const result = this->recv (buf, n, addr, flags);
+  if (result != -1)
+    segment_size = static_cast<size_t> (result);
+  return result;
+#endif /* ACE_HAS_UDP_GRO */
+}
+
+int
+ACE_SOCK_Dgram::enable_gro (void)
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::enable_gro");
+
+#if defined (ACE_HAS_UDP_GRO)
+  int one = 1;
+  return this->set_option (SOL_UDP, UDP_GRO, &one, sizeof one);
+#else
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_UDP_GRO */
+}
+
 int
 ACE_SOCK_Dgram::set_nic (const ACE_TCHAR *net_if,
                          int addr_family)
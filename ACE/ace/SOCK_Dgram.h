@@ -27,6 +27,7 @@
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class ACE_Time_Value;
+class ACE_Dgram_Batch;
 
 /**
  * @class ACE_SOCK_Dgram
@@ -163,6 +164,57 @@ public:
                 int flags,
                 const ACE_Time_Value *timeout) const;
 
+  /**
+   * Receive a burst of datagrams into @a batch (uses <recvmmsg(2)>
+   * where available).  Waits up to @a timeout, or until action is
+   * possible if @a timeout == 0, for the first datagram, then takes
+   * those already queued up to the capacity of @a batch.  Returns the
+   * number of datagrams received.
+   */
+  ssize_t recv (ACE_Dgram_Batch &batch,
+                int flags = 0,
+                const ACE_Time_Value *timeout = 0) const;
+
+  /// Send the datagrams of @a batch, each to the address it was added
+  /// with (uses <sendmmsg(2)> where available).  Returns the number of
+  /// datagrams sent.
+  ssize_t send (ACE_Dgram_Batch &batch,
+                int flags = 0) const;
+
+  /**
+   * Send the data of the @a n buffers of @a iov to @a addr as a run of
+   * datagrams of @a segment_size bytes each, the last one possibly
+   * shorter.  The kernel splits the data (uses @c UDP_SEGMENT where
+   * available, which takes up to 64 datagrams and ACE_MAX_UDP_PACKET_SIZE
+   * bytes per call); elsewhere, or if the kernel refuses, the datagrams
+   * are sent one by one.  Returns the number of bytes sent, which is
+   * less than the total if sending a datagram after the first failed.
+   */
+  ssize_t send_segments (const iovec iov[],
+                         int n,
+                         size_t segment_size,
+                         const ACE_Addr &addr,
+                         int flags = 0) const;
+
+  /**
+   * Receive into the @a n bytes at @a buf what may be several datagrams
+   * of the same sender, coalesced by the kernel once enable_gro() was
+   * called.  @a segment_size is set to the size of each of them, the
+   * last one possibly shorter, which is the number of bytes received
+   * if they weren't coalesced.  Returns the number of bytes received.
+   */
+  ssize_t recv_segments (void *buf,
+                         size_t n,
+                         ACE_Addr &addr,
+                         size_t &segment_size,
+                         int flags = 0) const;
+
+  /// Let the kernel coalesce the datagrams received from one sender
+  /// into one buffer (sets @c UDP_GRO), see recv_segments() and
+  /// ACE_Dgram_Batch::segment_size().  Returns -1 with @c ENOTSUP where
+  /// the platform lacks it.
+  int enable_gro (void);
+
   /// Send <buffer_count> worth of @a buffers to @a addr using overlapped
   /// I/O (uses <WSASendTo>).  Returns 0 on success.
   ssize_t send (const iovec buffers[],
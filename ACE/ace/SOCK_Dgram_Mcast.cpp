@@ -1,4 +1,5 @@
 #include "ace/SOCK_Dgram_Mcast.h"
+#include "ace/Dgram_Batch.h"
 
 #include "ace/OS_Memory.h"
 #include "ace/OS_NS_string.h"
@@ -934,4 +935,26 @@ ACE_SOCK_Dgram_Mcast::clear_subs_list (void)
   return result;
 }
 
+ssize_t
+ACE_SOCK_Dgram_Mcast::send (ACE_Dgram_Batch &batch,
+                            int flags) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram_Mcast::send");
+  return batch.send (this->get_handle (), flags, &this->send_addr_);
+}
+
+ssize_t
+ACE_SOCK_Dgram_Mcast::send_segments (const iovec iov[],
+                                     int n,
+                                     size_t segment_size,
+                                     int flags) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram_Mcast::send_segments");
+  return this->ACE_SOCK_Dgram::send_segments (iov,
+                                              n,
+                                              segment_size,
+                                              this->send_addr_,
+                                              flags);
+}
+
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -309,6 +309,20 @@ public:
                 int n,
                 int flags = 0) const;
 
+  /// Send the datagrams of @a batch, using the multicast address and
+  /// network interface defined by the first open() or subscribe().
+  ssize_t send (ACE_Dgram_Batch &batch,
+                int flags = 0) const;
+
+  /// Send the data of the @a n buffers of @a iov as datagrams of
+  /// @a segment_size bytes each, see ACE_SOCK_Dgram::send_segments(),
+  /// using the multicast address and network interface defined by the
+  /// first open() or subscribe().
+  ssize_t send_segments (const iovec iov[],
+                         int n,
+                         size_t segment_size,
+                         int flags = 0) const;
+
   // = Options.
 
   /// Set a socket option.
@@ -1,4 +1,5 @@
 #include "ace/SOCK_Stream.h"
+#include "ace/SOCK_Zerocopy.h"
 
 #if !defined (__ACE_INLINE__)
 #include "ace/SOCK_Stream.inl"
@@ -37,4 +38,17 @@ ACE_SOCK_Stream::close (void)
   return ACE_SOCK::close ();
 }
 
+ssize_t
+ACE_SOCK_Stream::send_n (const ACE_Message_Block *message_block,
+                         ACE_SOCK_Zerocopy &zerocopy,
+                         const ACE_Time_Value *timeout,
+                         size_t *bytes_transferred) const
+{
+  ACE_TRACE ("ACE_SOCK_Stream::send_n");
+  return zerocopy.send_n (this->get_handle (),
+                          message_block,
+                          timeout,
+                          bytes_transferred);
+}
+
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -24,6 +24,7 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // Forward declarations.
 class ACE_Message_Block;
+class ACE_SOCK_Zerocopy;
 
 /**
  * @class ACE_SOCK_Stream
@@ -134,6 +135,15 @@ public:
                   const ACE_Time_Value *timeout = 0,
                   size_t *bytes_transferred = 0) const;
 
+  /// Send all the message blocks chained through their @c cont
+  /// pointers without copying their data into the kernel, if
+  /// @a zerocopy was enabled on this socket.  @a zerocopy holds the
+  /// data until the kernel is done with it.
+  ssize_t send_n (const ACE_Message_Block *message_block,
+                  ACE_SOCK_Zerocopy &zerocopy,
+                  const ACE_Time_Value *timeout = 0,
+                  size_t *bytes_transferred = 0) const;
+
   /// Send an @c iovec of size @a iovcnt to the connected socket.
   ssize_t sendv_n (const iovec iov[],
                    int iovcnt,
@@ -0,0 +1,408 @@
+#include "ace/SOCK_Zerocopy.h"
+#include "ace/ACE.h"
+#include "ace/Message_Block.h"
+#include "ace/Lock_Adapter_T.h"
+#include "ace/Singleton.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Truncate.h"
+#include "ace/OS_NS_sys_socket.h"
+#include "ace/OS_NS_sys_uio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/Log_Category.h"
+
+#if defined (ACE_HAS_MSG_ZEROCOPY)
+# include /**/ <linux/errqueue.h>
+#endif /* ACE_HAS_MSG_ZEROCOPY */
+
+#if !defined (__ACE_INLINE__)
+#include "ace/SOCK_Zerocopy.inl"
+#endif /* __ACE_INLINE__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE (ACE_SOCK_Zerocopy)
+
+typedef ACE_Singleton<ACE_Lock_Adapter<ACE_SYNCH_MUTEX>, ACE_SYNCH_MUTEX>
+        ACE_SOCK_Zerocopy_Lock;
+
+ACE_SOCK_Zerocopy::ACE_SOCK_Zerocopy (void)
+  : enabled_ (false),
+    next_ (0),
+    pending_ (0),
+    copied_ (0)
+{
+  ACE_TRACE ("ACE_SOCK_Zerocopy::ACE_SOCK_Zerocopy");
+}
+
+ACE_SOCK_Zerocopy::~ACE_SOCK_Zerocopy (void)
+{
+  ACE_TRACE ("ACE_SOCK_Zerocopy::~ACE_SOCK_Zerocopy");
+
+  Send send;
+  while (this->sends_.dequeue_head (send) == 0)
+    if (send.chain_ != 0)
+      send.chain_->release ();
+}
+
+void
+ACE_SOCK_Zerocopy::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_SOCK_Zerocopy::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("enabled_ = %d\n"), this->enabled_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("next_ = %u\n"), this->next_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("pending_ = %B\n"), this->pending_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("copied_ = %B\n"), this->copied_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_Lock *
+ACE_SOCK_Zerocopy::lock (void)
+{
+  return ACE_SOCK_Zerocopy_Lock::instance ();
+}
+
+int
+ACE_SOCK_Zerocopy::enable (ACE_HANDLE handle)
+{
+  ACE_TRACE ("ACE_SOCK_Zerocopy::enable");
+
+#if defined (ACE_HAS_MSG_ZEROCOPY)
+  int one = 1;
+  if (ACE_OS::setsockopt (handle,
+                          SOL_SOCKET,
+                          SO_ZEROCOPY,
+                          reinterpret_cast<const char *> (&one),
+                          sizeof one) == -1)
+    return -1;
+
+  this->enabled_ = true;
+  return 0;
+#else
+  ACE_UNUSED_ARG (handle);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_MSG_ZEROCOPY */
+}
+
+ACE_Message_Block *
+ACE_SOCK_Zerocopy::pin (const ACE_Message_Block *message_block)
+{
+  ACE_TRACE ("ACE_SOCK_Zerocopy::pin");
+
+  ACE_Message_Block *head = 0;
+  ACE_Message_Block *tail = 0;
+
+  for (const ACE_Message_Block *mb = message_block;
+       mb != 0;
+       mb = mb->cont ())
+    {
+      ACE_Message_Block *pinned = 0;
+      ACE_Data_Block *db = mb->data_block ();
+
+      // Only data nobody can write any more is shared.
+      if (db != 0
+          && mb != message_block
+          && ACE_BIT_DISABLED (db->flags (), ACE_Message_Block::DONT_DELETE)
+          && db->reference_count () == 1)
+        {
+          if (db->locking_strategy () == 0)
+            db->locking_strategy (ACE_SOCK_Zerocopy::lock ());
+
+          ACE_Data_Block *shared = db->duplicate ();
+          ACE_NEW_NORETURN (pinned, ACE_Message_Block (shared));
+          if (pinned == 0)
+            shared->release ();
+          else
+            {
+              pinned->rd_ptr (mb->rd_ptr ());
+              pinned->wr_ptr (mb->wr_ptr ());
+            }
+        }
+      else
+        {
+          ACE_NEW_NORETURN (pinned,
+                            ACE_Message_Block (mb->length (),
+                                               ACE_Message_Block::MB_DATA,
+                                               0,
+                                               0,
+                                               0,
+                                               ACE_SOCK_Zerocopy::lock ()));
+          if (pinned != 0 && pinned->copy (mb->rd_ptr (), mb->length ()) == -1)
+            {
+              pinned->release ();
+              pinned = 0;
+            }
+        }
+
+      if (pinned == 0)
+        {
+          if (head != 0)
+            head->release ();
+          errno = ENOMEM;
+          return 0;
+        }
+
+      if (tail == 0)
+        head = pinned;
+      else
+        tail->cont (pinned);
+      tail = pinned;
+    }
+
+  return head;
+}
+
+ssize_t
+ACE_SOCK_Zerocopy::sendv (ACE_HANDLE handle,
+                          const iovec iov[],
+                          int iovcnt,
+                          ACE_Message_Block *owner,
+                          const ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_SOCK_Zerocopy::sendv");
+
+#if defined (ACE_HAS_MSG_ZEROCOPY)
+  if (!this->enabled_)
+    return ACE::sendv (handle, iov, iovcnt, timeout);
+
+  // Hold the data before the kernel can refer to it.
+  ACE_Message_Block *chain = owner->duplicate ();
+  if (chain == 0)
+    {
+      errno = ENOMEM;
+      return -1;
+    }
+
+  int val = 0;
+  if (timeout != 0 && ACE::enter_send_timedwait (handle, timeout, val) == -1)
+    {
+      chain->release ();
+      return -1;
+    }
+
+  msghdr msg;
+  ACE_OS::memset (&msg, 0, sizeof msg);
+  msg.msg_iov = const_cast<iovec *> (iov);
+  msg.msg_iovlen = iovcnt;
+
+  ssize_t n = ACE_OS::sendmsg (handle, &msg, MSG_ZEROCOPY);
+
+  if (n > 0)
+    {
+      // Only a successful send gets a number.
+      Send send;
+      send.id_ = this->next_++;
+      send.chain_ = chain;
+      if (this->sends_.enqueue_tail (send) == -1)
+        {
+          // Better leak the data than let the kernel send it after it
+          // was released.
+          ACELIB_ERROR ((LM_ERROR,
+                         ACE_TEXT ("ACE_SOCK_Zerocopy::sendv, cannot hold ")
+                         ACE_TEXT ("the data of send %u\n"),
+                         send.id_));
+        }
+      else
+        ++this->pending_;
+    }
+  else
+    {
+      ACE_Errno_Guard error (errno);
+      chain->release ();
+    }
+
+  // The kernel is short of memory for zero-copy state, send a copy.
+  if (n == -1 && errno == ENOBUFS)
+    n = ACE_OS::sendv (handle, iov, iovcnt);
+
+  if (timeout != 0)
+    ACE::restore_non_blocking_mode (handle, val);
+
+  return n;
+#else
+  ACE_UNUSED_ARG (owner);
+  return ACE::sendv (handle, iov, iovcnt, timeout);
+#endif /* ACE_HAS_MSG_ZEROCOPY */
+}
+
+ssize_t
+ACE_SOCK_Zerocopy::send_n (ACE_HANDLE handle,
+                           const ACE_Message_Block *message_block,
+                           const ACE_Time_Value *timeout,
+                           size_t *bt)
+{
+  ACE_TRACE ("ACE_SOCK_Zerocopy::send_n");
+
+  size_t temp;
+  size_t &bytes_transferred = bt == 0 ? temp : *bt;
+  bytes_transferred = 0;
+
+  if (message_block == 0)
+    return 0;
+
+  ACE_Message_Block *pinned = ACE_SOCK_Zerocopy::pin (message_block);
+  if (pinned == 0)
+    return -1;
+
+  int val = 0;
+  ACE::record_and_set_non_blocking_mode (handle, val);
+
+  iovec iov[ACE_IOV_MAX];
+  const ACE_Message_Block *mb = pinned;
+  ssize_t result = 0;
+  int error = 0;
+
+  while (!error && mb != 0)
+    {
+      // Gather the data of as many blocks as one send takes.
+      int iovcnt = 0;
+      for (; mb != 0 && iovcnt < ACE_IOV_MAX; mb = mb->cont ())
+        if (mb->length () > 0)
+          {
+            iov[iovcnt].iov_base = mb->rd_ptr ();
+            iov[iovcnt].iov_len =
+              ACE_Utils::truncate_cast<u_long> (mb->length ());
+            ++iovcnt;
+          }
+
+      for (int s = 0; s < iovcnt; )
+        {
+          ssize_t n = this->sendv (handle, iov + s, iovcnt - s, pinned);
+
+          if (n == 0 || n == -1)
+            {
+              if (n == -1 && errno == EWOULDBLOCK)
+                {
+                  // Release what the kernel is done with while waiting
+                  // for it to take more.
+                  this->reap (handle);
+
+                  if (ACE::handle_write_ready (handle, timeout) != -1)
+                    continue;
+                }
+
+              error = 1;
+              result = n;
+              break;
+            }
+
+          for (bytes_transferred += n;
+               s < iovcnt
+                 && n >= static_cast<ssize_t> (iov[s].iov_len);
+               s++)
+            n -= iov[s].iov_len;
+
+          if (n != 0)
+            {
+              char *base = reinterpret_cast<char *> (iov[s].iov_base);
+              iov[s].iov_base = base + n;
+              iov[s].iov_len = iov[s].iov_len - static_cast<u_long> (n);
+            }
+        }
+    }
+
+  ACE::restore_non_blocking_mode (handle, val);
+  pinned->release ();
+
+  if (error)
+    return result;
+
+  return ACE_Utils::truncate_cast<ssize_t> (bytes_transferred);
+}
+
+int
+ACE_SOCK_Zerocopy::reap (ACE_HANDLE handle)
+{
+  ACE_TRACE ("ACE_SOCK_Zerocopy::reap");
+
+#if defined (ACE_HAS_MSG_ZEROCOPY)
+  int completed = 0;
+
+  while (this->pending_ > 0)
+    {
+      // Room for the error and the address the IPv6 report carries.
+      char control[CMSG_SPACE (sizeof (sock_extended_err)
+                               + sizeof (sockaddr_in6))];
+      msghdr msg;
+      ACE_OS::memset (&msg, 0, sizeof msg);
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof control;
+
+      // Reading the error queue never blocks.
+      if (ACE_OS::recvmsg (handle, &msg, MSG_ERRQUEUE) == -1)
+        {
+          if (errno == EAGAIN || errno == EWOULDBLOCK)
+            break;
+          return -1;
+        }
+
+      for (cmsghdr *cmsg = CMSG_FIRSTHDR (&msg);
+           cmsg != 0;
+           cmsg = CMSG_NXTHDR (&msg, cmsg))
+        {
+          bool const report =
+            (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+# if defined (IPV6_RECVERR)
+            || (cmsg->cmsg_level == SOL_IPV6
+                && cmsg->cmsg_type == IPV6_RECVERR)
+# endif /* IPV6_RECVERR */
+            ;
+          if (!report)
+            continue;
+
+          sock_extended_err const *err =
+            reinterpret_cast<sock_extended_err const *> (CMSG_DATA (cmsg));
+          if (err->ee_errno != 0
+              || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+            continue;
+
+          // The sends from ee_info to ee_data completed.
+          int const n = this->complete (err->ee_info, err->ee_data);
+          if (ACE_BIT_ENABLED (err->ee_code, SO_EE_CODE_ZEROCOPY_COPIED))
+            this->copied_ += n;
+          completed += n;
+        }
+    }
+
+  return completed;
+#else
+  ACE_UNUSED_ARG (handle);
+  return 0;
+#endif /* ACE_HAS_MSG_ZEROCOPY */
+}
+
+int
+ACE_SOCK_Zerocopy::complete (ACE_UINT32 first, ACE_UINT32 last)
+{
+  int completed = 0;
+
+  // Send numbers wrap around.
+  ACE_UINT32 const range = last - first;
+
+  ACE_Unbounded_Queue_Iterator<Send> iter (this->sends_);
+  for (Send *send = 0; iter.next (send) != 0; iter.advance ())
+    if (send->chain_ != 0
+        && static_cast<ACE_UINT32> (send->id_ - first) <= range)
+      {
+        send->chain_->release ();
+        send->chain_ = 0;
+        --this->pending_;
+        ++completed;
+      }
+
+  // Forget the sends completed, up to the oldest one that isn't.
+  Send *head = 0;
+  while (this->sends_.get (head) == 0 && head->chain_ == 0)
+    {
+      Send send;
+      this->sends_.dequeue_head (send);
+    }
+
+  return completed;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,164 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    SOCK_Zerocopy.h
+ */
+//=============================================================================
+
+#ifndef ACE_SOCK_ZEROCOPY_H
+#define ACE_SOCK_ZEROCOPY_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Basic_Types.h"
+#include "ace/Unbounded_Queue.h"
+#include "ace/os_include/sys/os_uio.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Message_Block;
+class ACE_Lock;
+class ACE_Time_Value;
+
+/**
+ * @class ACE_SOCK_Zerocopy
+ *
+ * @brief Sends the data of message blocks through a stream socket
+ * without copying it into the kernel, using @c MSG_ZEROCOPY where the
+ * platform has it.
+ *
+ * The kernel keeps referring to the data after a zero-copy send
+ * returns, until it reports on the error queue of the socket that it
+ * is done with it.  The message blocks sent are therefore kept, as
+ * duplicates, until reap() reads that report.  reap() should be called
+ * whenever the socket is found ready for reading or with an error, and
+ * before sending more; a select()-based reactor keeps reporting the
+ * socket as ready while reports are queued.
+ *
+ * Zero-copy only pays off for large sends, of tens of kilobytes or
+ * more.  Where the kernel copies the data anyway, as on the loopback
+ * interface, copied() counts it.  This class isn't thread-safe.
+ */
+class ACE_Export ACE_SOCK_Zerocopy
+{
+public:
+  ACE_SOCK_Zerocopy (void);
+
+  /// Release the message blocks still held.  Close the socket first;
+  /// data the kernel didn't send by then may go out corrupted.
+  ~ACE_SOCK_Zerocopy (void);
+
+  /// Enable zero-copy sends on @a handle.  Returns -1 with @c ENOTSUP
+  /// on platforms without @c SO_ZEROCOPY, where the data is copied.
+  int enable (ACE_HANDLE handle);
+
+  /// Whether zero-copy sends were enabled.
+  bool enabled (void) const;
+
+  /**
+   * Return a chain, linked through @c cont, with the data of
+   * @a message_block that stays unchanged until the kernel is done
+   * with it.  The data is copied from the first block, which the
+   * caller keeps and may write again, as ACE_OutputCDR does with its
+   * start block after reset(), and from the blocks whose data is
+   * referenced outside of the chain too, as the octet sequences
+   * ACE_OutputCDR::write_octet_array_mb() chains in.  The other
+   * reference counted data blocks are shared and given a locking
+   * strategy if they have none, since the kernel may report that it
+   * is done with them to another thread; the caller must only release
+   * them.  Returns 0 if memory is exhausted.
+   */
+  static ACE_Message_Block *pin (const ACE_Message_Block *message_block);
+
+  /**
+   * Send the @a iovcnt buffers of @a iov, whose data is held by
+   * @a owner, with a single zero-copy send, like ACE::sendv().  On
+   * success a duplicate of @a owner, which must come from pin(), is
+   * kept until the kernel is done with it.  The data is copied instead
+   * if the kernel is short of memory for zero-copy sends.  Returns the
+   * number of bytes sent or -1.
+   */
+  ssize_t sendv (ACE_HANDLE handle,
+                 const iovec iov[],
+                 int iovcnt,
+                 ACE_Message_Block *owner,
+                 const ACE_Time_Value *timeout = 0);
+
+  /// Send all of @a message_block, chained through its @c cont
+  /// pointers, like ACE::send_n().
+  ssize_t send_n (ACE_HANDLE handle,
+                  const ACE_Message_Block *message_block,
+                  const ACE_Time_Value *timeout = 0,
+                  size_t *bytes_transferred = 0);
+
+  /**
+   * Read the completion reports queued on the error queue of
+   * @a handle and release the message blocks the kernel is done with.
+   * Never blocks.  Returns the number of sends completed or -1 if the
+   * error queue couldn't be read.
+   */
+  int reap (ACE_HANDLE handle);
+
+  /// Number of message block chains held.
+  size_t pending (void) const;
+
+  /// Number of completed sends whose data the kernel copied.
+  size_t copied (void) const;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  /// Release the data of the sends from @a first to @a last.  Returns
+  /// the number of them.
+  int complete (ACE_UINT32 first, ACE_UINT32 last);
+
+  /// Locking strategy given to the data blocks pinned.
+  static ACE_Lock *lock (void);
+
+  ACE_SOCK_Zerocopy (const ACE_SOCK_Zerocopy &);
+  ACE_SOCK_Zerocopy &operator= (const ACE_SOCK_Zerocopy &);
+
+  /// A zero-copy send the kernel may not be done with.
+  struct Send
+  {
+    /// Number the kernel gave to the send.
+    ACE_UINT32 id_;
+
+    /// The data sent, 0 once the send completed.
+    ACE_Message_Block *chain_;
+  };
+
+  /// Sends in the order they were made.
+  ACE_Unbounded_Queue<Send> sends_;
+
+  /// Whether zero-copy sends were enabled.
+  bool enabled_;
+
+  /// Number the kernel gives to the next successful send.
+  ACE_UINT32 next_;
+
+  /// Number of chains held.
+  size_t pending_;
+
+  /// Number of completed sends whose data was copied.
+  size_t copied_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/SOCK_Zerocopy.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_SOCK_ZEROCOPY_H */
@@ -0,0 +1,22 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE bool
+ACE_SOCK_Zerocopy::enabled (void) const
+{
+  return this->enabled_;
+}
+
+ACE_INLINE size_t
+ACE_SOCK_Zerocopy::pending (void) const
+{
+  return this->pending_;
+}
+
+ACE_INLINE size_t
+ACE_SOCK_Zerocopy::copied (void) const
+{
+  return this->copied_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -352,6 +352,24 @@ ACE_SSL_Context::filter_versions (const char* versionlist)
   return 0;
 }
 
+int
+ACE_SSL_Context::kernel_tls (bool enable)
+{
+#if defined (SSL_OP_ENABLE_KTLS)
+  this->check_context ();
+
+  if (enable)
+    ::SSL_CTX_set_options (this->context_, SSL_OP_ENABLE_KTLS);
+  else
+    ::SSL_CTX_clear_options (this->context_, SSL_OP_ENABLE_KTLS);
+
+  return 0;
+#else
+  ACE_UNUSED_ARG (enable);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* SSL_OP_ENABLE_KTLS */
+}
+
 
 bool
 ACE_SSL_Context::check_host (const ACE_INET_Addr &host, SSL *peerssl)
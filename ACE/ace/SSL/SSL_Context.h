@@ -174,6 +174,19 @@ public:
   /// verify the peer cert matches the host
   bool check_host (const ACE_INET_Addr& host, SSL * peerssl);
 
+  /**
+   * Have OpenSSL hand the session keys to the kernel (kernel TLS)
+   * once the handshake of a connection is done, so the kernel
+   * encrypts and decrypts the records.  Only affects the connections
+   * set up afterwards, and only those whose socket, protocol version
+   * and cipher the kernel supports; the others stay in user space.
+   * Returns -1 with @c errno set to @c ENOTSUP if the OpenSSL library
+   * was built without kernel TLS support.
+   *
+   * @see ACE_SSL_SOCK_Stream::kernel_tls_send()
+   */
+  int kernel_tls (bool enable = true);
+
   /**
    *  Load the location of the trusted certification authority
    *  certificates.  Note that CA certificates are stored in PEM format
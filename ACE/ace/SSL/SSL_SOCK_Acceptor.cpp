@@ -31,7 +31,10 @@ ACE_SSL_SOCK_Acceptor::ssl_accept (ACE_SSL_SOCK_Stream &new_stream,
   SSL *ssl = new_stream.ssl ();
 
   if (SSL_is_init_finished (ssl))
-    return 0;
+    {
+      new_stream.check_kernel_tls ();
+      return 0;
+    }
 
   if (!SSL_in_accept_init (ssl))
     ::SSL_set_accept_state (ssl);
@@ -157,7 +160,11 @@ ACE_SSL_SOCK_Acceptor::ssl_accept (ACE_SSL_SOCK_Stream &new_stream,
       ACE::clr_flags (handle, ACE_NONBLOCK);
     }
 
-  return (status == -1 ? -1 : 0);
+  if (status == -1)
+    return -1;
+
+  new_stream.check_kernel_tls ();
+  return 0;
 
 }
 
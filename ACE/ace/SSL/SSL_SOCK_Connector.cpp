@@ -30,7 +30,10 @@ ACE_SSL_SOCK_Connector::ssl_connect (ACE_SSL_SOCK_Stream &new_stream,
   SSL *ssl = new_stream.ssl ();
 
   if (SSL_is_init_finished (ssl))
-    return 0;
+    {
+      new_stream.check_kernel_tls ();
+      return 0;
+    }
 
   // Check if a connection is already pending for the given SSL
   // structure.
@@ -179,7 +182,11 @@ ACE_SSL_SOCK_Connector::ssl_connect (ACE_SSL_SOCK_Stream &new_stream,
       ACE::clr_flags (handle, ACE_NONBLOCK);
     }
 
-  return (status == -1 ? -1 : 0);
+  if (status == -1)
+    return -1;
+
+  new_stream.check_kernel_tls ();
+  return 0;
 }
 
 int
@@ -19,7 +19,8 @@ ACE_ALLOC_HOOK_DEFINE(ACE_SSL_SOCK_Stream)
 
 ACE_SSL_SOCK_Stream::ACE_SSL_SOCK_Stream (ACE_SSL_Context *context)
   : ssl_ (0),
-    stream_ ()
+    stream_ (),
+    kernel_send_ (false)
 {
   ACE_TRACE ("ACE_SSL_SOCK_Stream::ACE_SSL_SOCK_Stream");
 
@@ -56,6 +57,11 @@ ACE_SSL_SOCK_Stream::sendv (const iovec iov[],
 {
   ACE_TRACE ("ACE_SSL_SOCK_Stream::sendv");
 
+  if (this->kernel_send_)
+    return this->stream_.sendv (iov,
+                                ACE_Utils::truncate_cast<int> (n),
+                                max_wait_time);
+
   // There is subtle problem in this method that occurs when using
   // non-blocking IO.  The semantics of a non-blocking scatter write
   // (sendv()) are not possible to retain with the emulation in this
@@ -484,6 +490,9 @@ ACE_SSL_SOCK_Stream::sendv_n (const iovec iov[], size_t iovcnt) const
 {
   ACE_TRACE ("ACE_SSL_SOCK_Stream::sendv_n");
 
+  if (this->kernel_send_)
+    return this->stream_.sendv_n (iov, ACE_Utils::truncate_cast<int> (iovcnt));
+
   ssize_t bytes_sent = 0;
 
   for (size_t i = 0; i < iovcnt; ++i)
@@ -554,6 +563,18 @@ ACE_SSL_SOCK_Stream::recvv_n (iovec iov[], size_t iovcnt) const
   return bytes_read;
 }
 
+void
+ACE_SSL_SOCK_Stream::check_kernel_tls (void)
+{
+#if defined (SSL_OP_ENABLE_KTLS)
+  this->kernel_send_ =
+    this->ssl_ != 0
+    && BIO_get_ktls_send (::SSL_get_wbio (this->ssl_)) != 0;
+#else
+  this->kernel_send_ = false;
+#endif /* SSL_OP_ENABLE_KTLS */
+}
+
 int
 ACE_SSL_SOCK_Stream::get_remote_addr (ACE_Addr &addr) const
 {
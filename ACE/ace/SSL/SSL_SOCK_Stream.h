@@ -107,7 +107,8 @@ public:
   /**
    * Note that it is not possible to perform a "scattered" write with
    * the underlying OpenSSL implementation.  As such, the expected
-   * semantics are not fully reproduced with this implementation.
+   * semantics are not fully reproduced with this implementation,
+   * unless the kernel encrypts the data sent (see kernel_tls_send()).
    */
   ssize_t sendv (const iovec iov[],
                  size_t n,
@@ -291,6 +292,23 @@ public:
   /// Return a pointer to the underlying SSL structure.
   SSL *ssl (void) const;
 
+  /**
+   * Return true if the kernel encrypts the data sent on this stream
+   * (see ACE_SSL_Context::kernel_tls()).  The send methods then write
+   * to the socket directly, with a single gather write for sendv()
+   * and sendv_n().  Data is always received with @c SSL_read(), which
+   * handles the records that are not application data, such as TLS
+   * 1.3 session tickets and key updates.
+   */
+  bool kernel_tls_send (void) const;
+
+  /// Check whether OpenSSL handed the session keys to the kernel.
+  /**
+   * Only an ACE_SSL_SOCK_Acceptor or ACE_SSL_SOCK_Connector should
+   * call this method, once the SSL handshake is done.
+   */
+  void check_kernel_tls (void);
+
   /**
    * Return the address of the remotely connected peer (if there is
    * one), in the referenced <ACE_Addr>. Returns 0 if successful, else
@@ -333,6 +351,9 @@ protected:
   /// The stream which works under the ssl connection.
   ACE_SOCK_Stream stream_;
 
+  /// Whether the kernel encrypts the data sent.
+  bool kernel_send_;
+
 };
 
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -8,16 +8,15 @@ ACE_INLINE void
 ACE_SSL_SOCK_Stream::set_handle (ACE_HANDLE fd)
 {
   if (this->ssl_ == 0 || fd == ACE_INVALID_HANDLE)
-    {
-      this->ACE_SSL_SOCK::set_handle (ACE_INVALID_HANDLE);
-      return;
-    }
+    this->ACE_SSL_SOCK::set_handle (ACE_INVALID_HANDLE);
   else
     {
       (void) ::SSL_set_fd (this->ssl_, (int) fd);
       this->ACE_SSL_SOCK::set_handle (fd);
       this->stream_.set_handle (fd);
     }
+
+  this->kernel_send_ = false;
 }
 
 ACE_INLINE ssize_t
@@ -35,6 +34,10 @@ ACE_SSL_SOCK_Stream::send_i (const void *buf,
       ACE_NOTSUP_RETURN (-1);
     }
 
+  // The kernel builds the records.
+  if (this->kernel_send_)
+    return this->stream_.send (buf, n, flags);
+
   int const bytes_sent = ::SSL_write (this->ssl_,
                                       static_cast<const char *> (buf),
                                       ACE_Utils::truncate_cast<int> (n));
@@ -361,4 +364,10 @@ ACE_SSL_SOCK_Stream::ssl (void) const
   return this->ssl_;
 }
 
+ACE_INLINE bool
+ACE_SSL_SOCK_Stream::kernel_tls_send (void) const
+{
+  return this->kernel_send_;
+}
+
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,857 @@
+#include "ace/Sharded_Dev_Poll_Reactor.h"
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+#include "ace/Reactor.h"
+#include "ace/Handle_Set.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Sharded_Dev_Poll_Reactor)
+
+ACE_Sharded_Dev_Poll_Reactor::ACE_Sharded_Dev_Poll_Reactor (
+    size_t shards,
+    size_t size,
+    bool restart,
+    ACE_Sig_Handler *sh,
+    ACE_Timer_Queue *tq,
+    int disable_notify_pipe,
+    ACE_Reactor_Notify *notify,
+    int mask_signals,
+    int s_queue,
+    int event_batch)
+  : shards_ (0)
+  , shard_count_ (shards == 0 ? 1 : shards)
+  , handle_shard_ (0)
+  , handle_shard_size_ (size)
+  , next_shard_ (0)
+  , bound_threads_ (0)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::ACE_Sharded_Dev_Poll_Reactor");
+
+  ACE_NEW_NORETURN (this->handle_shard_, size_t[size]);
+  ACE_NEW_NORETURN (this->shards_, ACE_Dev_Poll_Reactor *[this->shard_count_]);
+  if (this->shards_ != 0)
+    for (size_t i = 0; i < this->shard_count_; ++i)
+      this->shards_[i] = 0;
+
+  if (this->handle_shard_ == 0 || this->shards_ == 0)
+    {
+      ACELIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("%p\n"),
+                     ACE_TEXT ("ACE_Sharded_Dev_Poll_Reactor::CTOR")));
+      this->release_shards ();
+      return;
+    }
+
+  ACE_OS::memset (this->handle_shard_, 0, size * sizeof (size_t));
+
+  // Only the first shard gets the caller's signal handler, timer queue
+  // and notification handler; the others create their own.
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    {
+      ACE_NEW_NORETURN (this->shards_[i],
+                        ACE_Dev_Poll_Reactor (size,
+                                              restart,
+                                              i == 0 ? sh : 0,
+                                              i == 0 ? tq : 0,
+                                              disable_notify_pipe,
+                                              i == 0 ? notify : 0,
+                                              mask_signals,
+                                              s_queue,
+                                              event_batch));
+
+      if (this->shards_[i] == 0 || !this->shards_[i]->initialized ())
+        {
+          ACELIB_ERROR ((LM_ERROR,
+                         ACE_TEXT ("%p\n"),
+                         ACE_TEXT ("ACE_Sharded_Dev_Poll_Reactor::CTOR shard")));
+          this->release_shards ();
+          return;
+        }
+    }
+}
+
+ACE_Sharded_Dev_Poll_Reactor::~ACE_Sharded_Dev_Poll_Reactor (void)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::~ACE_Sharded_Dev_Poll_Reactor");
+
+  this->release_shards ();
+}
+
+void
+ACE_Sharded_Dev_Poll_Reactor::release_shards (void)
+{
+  if (this->shards_ != 0)
+    for (size_t i = 0; i < this->shard_count_; ++i)
+      delete this->shards_[i];
+
+  delete [] this->shards_;
+  this->shards_ = 0;
+  delete [] this->handle_shard_;
+  this->handle_shard_ = 0;
+
+  // No handle is in range of the missing table any more.
+  this->handle_shard_size_ = 0;
+}
+
+size_t
+ACE_Sharded_Dev_Poll_Reactor::shards (void) const
+{
+  return this->shard_count_;
+}
+
+ACE_Dev_Poll_Reactor *
+ACE_Sharded_Dev_Poll_Reactor::shard_of (ACE_HANDLE handle)
+{
+  if (handle < 0 || static_cast<size_t> (handle) >= this->handle_shard_size_)
+    return 0;
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->lock_, 0);
+
+  size_t const shard = this->handle_shard_[handle];
+  return shard == 0 ? 0 : this->shards_[shard - 1];
+}
+
+ACE_Dev_Poll_Reactor *
+ACE_Sharded_Dev_Poll_Reactor::thread_shard (void)
+{
+  size_t &shard = *this->thread_shard_;
+
+  if (shard == 0)
+    {
+      ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->lock_, 0);
+      shard = this->bound_threads_++ % this->shard_count_ + 1;
+    }
+
+  return this->shards_[shard - 1];
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::bind_thread (size_t shard)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::bind_thread");
+
+  if (shard >= this->shard_count_)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  size_t &bound = *this->thread_shard_;
+  if (bound != 0)
+    {
+      errno = EBUSY;
+      return -1;
+    }
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->lock_, -1);
+  bound = shard + 1;
+  ++this->bound_threads_;
+  return 0;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::register_handler_i (size_t shard,
+                                                  ACE_HANDLE handle,
+                                                  ACE_Event_Handler *event_handler,
+                                                  ACE_Reactor_Mask mask)
+{
+  if (handle < 0 || static_cast<size_t> (handle) >= this->handle_shard_size_)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  // Registration doesn't upcall the event handler, so the lock can be
+  // held throughout; this keeps the shard assignment consistent with
+  // concurrent registrations of the same handle.
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->lock_, -1);
+
+  // A handle that is still registered (maybe for other events) stays
+  // in its shard.  Handlers may have been removed by their shard
+  // without us knowing, so make sure.
+  size_t const current = this->handle_shard_[handle];
+  if (current != 0
+      && this->shards_[current - 1]->handler (handle,
+                                              ACE_Event_Handler::NULL_MASK) == 0)
+    shard = current - 1;
+
+  if (this->shards_[shard]->register_handler (handle,
+                                              event_handler,
+                                              mask) == -1)
+    return -1;
+
+  this->handle_shard_[handle] = shard + 1;
+  return 0;
+}
+
+void
+ACE_Sharded_Dev_Poll_Reactor::unbind_handle (ACE_HANDLE handle)
+{
+  if (handle < 0 || static_cast<size_t> (handle) >= this->handle_shard_size_)
+    return;
+
+  ACE_GUARD (ACE_SYNCH_MUTEX, guard, this->lock_);
+
+  size_t const shard = this->handle_shard_[handle];
+  if (shard != 0
+      && this->shards_[shard - 1]->handler (handle,
+                                            ACE_Event_Handler::NULL_MASK) == -1)
+    this->handle_shard_[handle] = 0;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::register_handler (size_t shard,
+                                                ACE_Event_Handler *event_handler,
+                                                ACE_Reactor_Mask mask)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::register_handler");
+
+  if (shard >= this->shard_count_)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  return this->register_handler_i (shard,
+                                   event_handler->get_handle (),
+                                   event_handler,
+                                   mask);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::open (size_t size,
+                                    bool restart,
+                                    ACE_Sig_Handler *sh,
+                                    ACE_Timer_Queue *tq,
+                                    int disable_notify_pipe,
+                                    ACE_Reactor_Notify *notify)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::open");
+
+  if (this->shards_ == 0 || size > this->handle_shard_size_)
+    return -1;
+
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    if (this->shards_[i] == 0
+        || this->shards_[i]->open (size,
+                                   restart,
+                                   i == 0 ? sh : 0,
+                                   i == 0 ? tq : 0,
+                                   disable_notify_pipe,
+                                   i == 0 ? notify : 0) == -1)
+      return -1;
+
+  return 0;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::current_info (ACE_HANDLE, size_t & /* size */)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::set_sig_handler (ACE_Sig_Handler *signal_handler)
+{
+  return this->shards_[0]->set_sig_handler (signal_handler);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::timer_queue (ACE_Timer_Queue *tq)
+{
+  return this->shards_[0]->timer_queue (tq);
+}
+
+ACE_Timer_Queue *
+ACE_Sharded_Dev_Poll_Reactor::timer_queue (void) const
+{
+  return this->shards_[0]->timer_queue ();
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::close (void)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::close");
+
+  int result = 0;
+
+  if (this->shards_ != 0)
+    for (size_t i = 0; i < this->shard_count_; ++i)
+      if (this->shards_[i] != 0 && this->shards_[i]->close () == -1)
+        result = -1;
+
+  if (this->handle_shard_ != 0)
+    {
+      ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->lock_, -1);
+      ACE_OS::memset (this->handle_shard_,
+                      0,
+                      this->handle_shard_size_ * sizeof (size_t));
+    }
+
+  return result;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::work_pending (const ACE_Time_Value &max_wait_time)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::work_pending");
+
+  return this->thread_shard ()->work_pending (max_wait_time);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::handle_events (ACE_Time_Value *max_wait_time)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::handle_events");
+
+  return this->thread_shard ()->handle_events (max_wait_time);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::alertable_handle_events (
+  ACE_Time_Value *max_wait_time)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::alertable_handle_events");
+
+  return this->thread_shard ()->alertable_handle_events (max_wait_time);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::handle_events (ACE_Time_Value &max_wait_time)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::handle_events");
+
+  return this->thread_shard ()->handle_events (max_wait_time);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::alertable_handle_events (
+  ACE_Time_Value &max_wait_time)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::alertable_handle_events");
+
+  return this->thread_shard ()->alertable_handle_events (max_wait_time);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::deactivated (void)
+{
+  return this->shards_[0]->deactivated ();
+}
+
+void
+ACE_Sharded_Dev_Poll_Reactor::deactivate (int do_stop)
+{
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    this->shards_[i]->deactivate (do_stop);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::register_handler (ACE_Event_Handler *event_handler,
+                                                ACE_Reactor_Mask mask)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::register_handler");
+
+  return this->register_handler (event_handler->get_handle (),
+                                 event_handler,
+                                 mask);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::register_handler (ACE_HANDLE handle,
+                                                ACE_Event_Handler *event_handler,
+                                                ACE_Reactor_Mask mask)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::register_handler");
+
+  size_t shard = 0;
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->lock_, -1);
+    shard = this->next_shard_;
+    this->next_shard_ = (this->next_shard_ + 1) % this->shard_count_;
+  }
+
+  return this->register_handler_i (shard, handle, event_handler, mask);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::register_handler (
+  ACE_HANDLE /* event_handle */,
+  ACE_HANDLE /* io_handle */,
+  ACE_Event_Handler * /* event_handler */,
+  ACE_Reactor_Mask /* mask */)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::register_handler (const ACE_Handle_Set &handles,
+                                                ACE_Event_Handler *event_handler,
+                                                ACE_Reactor_Mask mask)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::register_handler");
+
+  // One event handler for several handles is kept in a single shard,
+  // so that it is never upcalled by two threads at a time.
+  size_t shard = 0;
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->lock_, -1);
+    shard = this->next_shard_;
+    this->next_shard_ = (this->next_shard_ + 1) % this->shard_count_;
+  }
+
+  ACE_Handle_Set_Iterator handle_iter (handles);
+  for (ACE_HANDLE h = handle_iter ();
+       h != ACE_INVALID_HANDLE;
+       h = handle_iter ())
+    if (this->register_handler_i (shard, h, event_handler, mask) == -1)
+      return -1;
+
+  return 0;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::register_handler (int signum,
+                                                ACE_Event_Handler *new_sh,
+                                                ACE_Sig_Action *new_disp,
+                                                ACE_Event_Handler **old_sh,
+                                                ACE_Sig_Action *old_disp)
+{
+  return this->shards_[0]->register_handler (signum,
+                                             new_sh,
+                                             new_disp,
+                                             old_sh,
+                                             old_disp);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::register_handler (const ACE_Sig_Set &sigset,
+                                                ACE_Event_Handler *new_sh,
+                                                ACE_Sig_Action *new_disp)
+{
+  return this->shards_[0]->register_handler (sigset, new_sh, new_disp);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::remove_handler (ACE_Event_Handler *event_handler,
+                                              ACE_Reactor_Mask mask)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::remove_handler");
+
+  return this->remove_handler (event_handler->get_handle (), mask);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::remove_handler (ACE_HANDLE handle,
+                                              ACE_Reactor_Mask mask)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::remove_handler");
+
+  ACE_Dev_Poll_Reactor * const shard = this->shard_of (handle);
+  if (shard == 0)
+    return -1;
+
+  // The lock isn't held here: handle_close() may call back into the
+  // reactor.
+  int const result = shard->remove_handler (handle, mask);
+  this->unbind_handle (handle);
+  return result;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::remove_handler (const ACE_Handle_Set &handle_set,
+                                              ACE_Reactor_Mask mask)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::remove_handler");
+
+  ACE_Handle_Set_Iterator handle_iter (handle_set);
+  for (ACE_HANDLE h = handle_iter ();
+       h != ACE_INVALID_HANDLE;
+       h = handle_iter ())
+    if (this->remove_handler (h, mask) == -1)
+      return -1;
+
+  return 0;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::remove_handler (int signum,
+                                              ACE_Sig_Action *new_disp,
+                                              ACE_Sig_Action *old_disp,
+                                              int sigkey)
+{
+  return this->shards_[0]->remove_handler (signum, new_disp, old_disp, sigkey);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::remove_handler (const ACE_Sig_Set &sigset)
+{
+  return this->shards_[0]->remove_handler (sigset);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::suspend_handler (ACE_Event_Handler *event_handler)
+{
+  return this->suspend_handler (event_handler->get_handle ());
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::suspend_handler (ACE_HANDLE handle)
+{
+  ACE_Dev_Poll_Reactor * const shard = this->shard_of (handle);
+  return shard == 0 ? -1 : shard->suspend_handler (handle);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::suspend_handler (const ACE_Handle_Set &handles)
+{
+  ACE_Handle_Set_Iterator handle_iter (handles);
+  for (ACE_HANDLE h = handle_iter ();
+       h != ACE_INVALID_HANDLE;
+       h = handle_iter ())
+    if (this->suspend_handler (h) == -1)
+      return -1;
+
+  return 0;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::suspend_handlers (void)
+{
+  int result = 0;
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    if (this->shards_[i]->suspend_handlers () == -1)
+      result = -1;
+  return result;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::resume_handler (ACE_Event_Handler *event_handler)
+{
+  return this->resume_handler (event_handler->get_handle ());
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::resume_handler (ACE_HANDLE handle)
+{
+  ACE_Dev_Poll_Reactor * const shard = this->shard_of (handle);
+  return shard == 0 ? -1 : shard->resume_handler (handle);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::resume_handler (const ACE_Handle_Set &handles)
+{
+  ACE_Handle_Set_Iterator handle_iter (handles);
+  for (ACE_HANDLE h = handle_iter ();
+       h != ACE_INVALID_HANDLE;
+       h = handle_iter ())
+    if (this->resume_handler (h) == -1)
+      return -1;
+
+  return 0;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::resume_handlers (void)
+{
+  int result = 0;
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    if (this->shards_[i]->resume_handlers () == -1)
+      result = -1;
+  return result;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::resumable_handler (void)
+{
+  return this->shards_[0]->resumable_handler ();
+}
+
+bool
+ACE_Sharded_Dev_Poll_Reactor::uses_event_associations (void)
+{
+  return false;
+}
+
+long
+ACE_Sharded_Dev_Poll_Reactor::schedule_timer (ACE_Event_Handler *event_handler,
+                                              const void *arg,
+                                              const ACE_Time_Value &delay,
+                                              const ACE_Time_Value &interval)
+{
+  return this->shards_[0]->schedule_timer (event_handler,
+                                           arg,
+                                           delay,
+                                           interval);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::reset_timer_interval (long timer_id,
+                                                    const ACE_Time_Value &interval)
+{
+  return this->shards_[0]->reset_timer_interval (timer_id, interval);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::cancel_timer (ACE_Event_Handler *event_handler,
+                                            int dont_call_handle_close)
+{
+  return this->shards_[0]->cancel_timer (event_handler,
+                                         dont_call_handle_close);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::cancel_timer (long timer_id,
+                                            const void **arg,
+                                            int dont_call_handle_close)
+{
+  return this->shards_[0]->cancel_timer (timer_id,
+                                         arg,
+                                         dont_call_handle_close);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::use_timer_fd (bool enable)
+{
+  return this->shards_[0]->use_timer_fd (enable);
+}
+
+bool
+ACE_Sharded_Dev_Poll_Reactor::uses_timer_fd (void) const
+{
+  return this->shards_[0]->uses_timer_fd ();
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::schedule_wakeup (ACE_Event_Handler *eh,
+                                               ACE_Reactor_Mask mask)
+{
+  return this->mask_ops (eh->get_handle (), mask, ACE_Reactor::ADD_MASK);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::schedule_wakeup (ACE_HANDLE handle,
+                                               ACE_Reactor_Mask mask)
+{
+  return this->mask_ops (handle, mask, ACE_Reactor::ADD_MASK);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::cancel_wakeup (ACE_Event_Handler *eh,
+                                             ACE_Reactor_Mask mask)
+{
+  return this->mask_ops (eh->get_handle (), mask, ACE_Reactor::CLR_MASK);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::cancel_wakeup (ACE_HANDLE handle,
+                                             ACE_Reactor_Mask mask)
+{
+  return this->mask_ops (handle, mask, ACE_Reactor::CLR_MASK);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::notify (ACE_Event_Handler *eh,
+                                      ACE_Reactor_Mask mask,
+                                      ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::notify");
+
+  ACE_Dev_Poll_Reactor *shard = 0;
+  if (eh != 0)
+    shard = this->shard_of (eh->get_handle ());
+  if (shard == 0)
+    shard = this->shards_[0];
+
+  return shard->notify (eh, mask, timeout);
+}
+
+void
+ACE_Sharded_Dev_Poll_Reactor::max_notify_iterations (int iterations)
+{
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    this->shards_[i]->max_notify_iterations (iterations);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::max_notify_iterations (void)
+{
+  return this->shards_[0]->max_notify_iterations ();
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::purge_pending_notifications (ACE_Event_Handler *eh,
+                                                           ACE_Reactor_Mask mask)
+{
+  int purged = 0;
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    {
+      int const n = this->shards_[i]->purge_pending_notifications (eh, mask);
+      if (n == -1)
+        return -1;
+      purged += n;
+    }
+  return purged;
+}
+
+ACE_Event_Handler *
+ACE_Sharded_Dev_Poll_Reactor::find_handler (ACE_HANDLE handle)
+{
+  ACE_Dev_Poll_Reactor * const shard = this->shard_of (handle);
+  return shard == 0 ? 0 : shard->find_handler (handle);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::handler (ACE_HANDLE handle,
+                                       ACE_Reactor_Mask mask,
+                                       ACE_Event_Handler **event_handler)
+{
+  ACE_Dev_Poll_Reactor * const shard = this->shard_of (handle);
+  return shard == 0 ? -1 : shard->handler (handle, mask, event_handler);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::handler (int signum,
+                                       ACE_Event_Handler **eh)
+{
+  return this->shards_[0]->handler (signum, eh);
+}
+
+bool
+ACE_Sharded_Dev_Poll_Reactor::initialized (void)
+{
+  if (this->shards_ == 0 || this->handle_shard_ == 0)
+    return false;
+
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    if (this->shards_[i] == 0 || !this->shards_[i]->initialized ())
+      return false;
+
+  return true;
+}
+
+size_t
+ACE_Sharded_Dev_Poll_Reactor::size (void) const
+{
+  size_t total = 0;
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    total += this->shards_[i]->size ();
+  return total;
+}
+
+ACE_Lock &
+ACE_Sharded_Dev_Poll_Reactor::lock (void)
+{
+  return this->shards_[0]->lock ();
+}
+
+void
+ACE_Sharded_Dev_Poll_Reactor::wakeup_all_threads (void)
+{
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    this->shards_[i]->wakeup_all_threads ();
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::owner (ACE_thread_t /* new_owner */,
+                                     ACE_thread_t * /* old_owner */)
+{
+  // As with the ACE_Dev_Poll_Reactor, there is no need to set the
+  // owner of the event loop.
+  return 0;
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::owner (ACE_thread_t * /* owner */)
+{
+  return 0;
+}
+
+bool
+ACE_Sharded_Dev_Poll_Reactor::restart (void)
+{
+  return this->shards_[0]->restart ();
+}
+
+bool
+ACE_Sharded_Dev_Poll_Reactor::restart (bool r)
+{
+  bool const old = this->shards_[0]->restart ();
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    this->shards_[i]->restart (r);
+  return old;
+}
+
+void
+ACE_Sharded_Dev_Poll_Reactor::requeue_position (int)
+{
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::requeue_position (void)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::mask_ops (ACE_Event_Handler *event_handler,
+                                        ACE_Reactor_Mask mask,
+                                        int ops)
+{
+  return this->mask_ops (event_handler->get_handle (), mask, ops);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::mask_ops (ACE_HANDLE handle,
+                                        ACE_Reactor_Mask mask,
+                                        int ops)
+{
+  ACE_Dev_Poll_Reactor * const shard = this->shard_of (handle);
+  return shard == 0 ? -1 : shard->mask_ops (handle, mask, ops);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::ready_ops (ACE_Event_Handler * /* event_handler */,
+                                         ACE_Reactor_Mask /* mask */,
+                                         int /* ops */)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Sharded_Dev_Poll_Reactor::ready_ops (ACE_HANDLE /* handle */,
+                                         ACE_Reactor_Mask /* mask */,
+                                         int /* ops */)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+void
+ACE_Sharded_Dev_Poll_Reactor::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Sharded_Dev_Poll_Reactor::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("shard_count_ = %B"),
+                 this->shard_count_));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("bound_threads_ = %B"),
+                 this->bound_threads_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+
+  for (size_t i = 0; i < this->shard_count_; ++i)
+    this->shards_[i]->dump ();
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
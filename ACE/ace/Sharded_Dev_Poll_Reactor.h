@@ -0,0 +1,377 @@
+// -*- C++ -*-
+
+// =========================================================================
+/**
+ *  @file    Sharded_Dev_Poll_Reactor.h
+ *
+ *  Reactor that spreads its handlers over several ACE_Dev_Poll_Reactor
+ *  instances, each run by its own thread.
+ */
+// =========================================================================
+
+
+#ifndef ACE_SHARDED_DEV_POLL_REACTOR_H
+#define ACE_SHARDED_DEV_POLL_REACTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/TSS_T.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Sharded_Dev_Poll_Reactor
+ *
+ * @brief A Reactor made of one ACE_Dev_Poll_Reactor (shard) per event
+ *        loop thread.
+ *
+ * All threads running the event loop of an ACE_Dev_Poll_Reactor take
+ * turns on a single token to wait on a single interest set, which
+ * limits how far it scales with the number of threads.  The
+ * ACE_Sharded_Dev_Poll_Reactor instead owns a number of independent
+ * ACE_Dev_Poll_Reactor shards, each with its own interest set and
+ * token:
+ * - Each I/O handle is assigned to one shard when it is registered,
+ *   either round robin or to the shard given by the caller (see
+ *   register_handler (size_t, ...)).  All other operations on the
+ *   handle are forwarded to that shard.
+ * - The first call to handle_events() made by a thread binds the
+ *   thread to the next shard that has no thread yet.  From then on
+ *   the thread only dispatches the events of that shard, so threads
+ *   don't contend with each other.  Threads beyond the number of
+ *   shards are bound round robin and share a shard's token.
+ * - Timers and signal handlers live in the first shard.  They can be
+ *   scheduled and cancelled from any thread and are dispatched by the
+ *   thread bound to the first shard.
+ * - Notifications for an event handler that is registered for a
+ *   handle go to the shard of that handle, so they are serialized with
+ *   its I/O upcalls.  All other notifications go to the first shard.
+ *
+ * @note Every shard must be run by a thread, else the events of the
+ *       handles assigned to it are never dispatched.  Create the
+ *       reactor with as many shards as threads will run its event loop.
+ */
+class ACE_Export ACE_Sharded_Dev_Poll_Reactor : public ACE_Reactor_Impl
+{
+public:
+  /// Initialize with @a shards shards of size @a size each.
+  /**
+   * The remaining arguments are passed on to the constructor of the
+   * shards; the signal handler, timer queue and notification handler
+   * are only used by the first shard.
+   */
+  ACE_Sharded_Dev_Poll_Reactor (size_t shards,
+                                size_t size,
+                                bool restart = false,
+                                ACE_Sig_Handler * = 0,
+                                ACE_Timer_Queue * = 0,
+                                int disable_notify_pipe = 0,
+                                ACE_Reactor_Notify *notify = 0,
+                                int mask_signals = 1,
+                                int s_queue = ACE_DEV_POLL_TOKEN::FIFO,
+                                int event_batch = ACE_DEFAULT_DEV_POLL_EVENT_BATCH);
+
+  /// Close down and release all resources.
+  virtual ~ACE_Sharded_Dev_Poll_Reactor (void);
+
+  /// Number of shards.
+  size_t shards (void) const;
+
+  /// Register @a event_handler with @a mask in shard @a shard, unless
+  /// its handle is already registered, in which case the shard it is
+  /// registered in is used.
+  int register_handler (size_t shard,
+                        ACE_Event_Handler *event_handler,
+                        ACE_Reactor_Mask mask);
+
+  /// Bind the calling thread to shard @a shard instead of the one
+  /// handle_events() would pick.  Must be called before the thread
+  /// first runs the event loop.
+  int bind_thread (size_t shard);
+
+  // = ACE_Reactor_Impl interface.
+
+  /// Initialization.  The reactor is opened by the constructor; this
+  /// fails unless it has been closed since.
+  virtual int open (size_t size,
+                    bool restart = false,
+                    ACE_Sig_Handler * = 0,
+                    ACE_Timer_Queue * = 0,
+                    int disable_notify_pipe = 0,
+                    ACE_Reactor_Notify * = 0);
+
+  virtual int current_info (ACE_HANDLE handle, size_t & /* size */);
+
+  virtual int set_sig_handler (ACE_Sig_Handler *signal_handler);
+
+  virtual int timer_queue (ACE_Timer_Queue *tq);
+
+  virtual ACE_Timer_Queue *timer_queue (void) const;
+
+  virtual int close (void);
+
+  // = Event loop drivers.  They operate on the calling thread's shard.
+
+  virtual int work_pending (const ACE_Time_Value &max_wait_time =  ACE_Time_Value::zero);
+
+  virtual int handle_events (ACE_Time_Value *max_wait_time = 0);
+
+  virtual int alertable_handle_events (ACE_Time_Value *max_wait_time = 0);
+
+  virtual int handle_events (ACE_Time_Value &max_wait_time);
+
+  virtual int alertable_handle_events (ACE_Time_Value &max_wait_time);
+
+  // = Event handling control.
+
+  virtual int deactivated (void);
+
+  virtual void deactivate (int do_stop);
+
+  // = Register and remove handlers.
+
+  virtual int register_handler (ACE_Event_Handler *event_handler,
+                                ACE_Reactor_Mask mask);
+
+  virtual int register_handler (ACE_HANDLE io_handle,
+                                ACE_Event_Handler *event_handler,
+                                ACE_Reactor_Mask mask);
+
+  /// Not implemented.
+  virtual int register_handler (ACE_HANDLE event_handle,
+                                ACE_HANDLE io_handle,
+                                ACE_Event_Handler *event_handler,
+                                ACE_Reactor_Mask mask);
+
+  virtual int register_handler (const ACE_Handle_Set &handles,
+                                ACE_Event_Handler *event_handler,
+                                ACE_Reactor_Mask mask);
+
+  virtual int register_handler (int signum,
+                                ACE_Event_Handler *new_sh,
+                                ACE_Sig_Action *new_disp = 0,
+                                ACE_Event_Handler **old_sh = 0,
+                                ACE_Sig_Action *old_disp = 0);
+
+  virtual int register_handler (const ACE_Sig_Set &sigset,
+                                ACE_Event_Handler *new_sh,
+                                ACE_Sig_Action *new_disp = 0);
+
+  virtual int remove_handler (ACE_Event_Handler *event_handler,
+                              ACE_Reactor_Mask mask);
+
+  virtual int remove_handler (ACE_HANDLE handle,
+                              ACE_Reactor_Mask mask);
+
+  virtual int remove_handler (const ACE_Handle_Set &handle_set,
+                              ACE_Reactor_Mask mask);
+
+  virtual int remove_handler (int signum,
+                              ACE_Sig_Action *new_disp,
+                              ACE_Sig_Action *old_disp = 0,
+                              int sigkey = -1);
+
+  virtual int remove_handler (const ACE_Sig_Set &sigset);
+
+  // = Suspend and resume handlers.
+
+  virtual int suspend_handler (ACE_Event_Handler *event_handler);
+
+  virtual int suspend_handler (ACE_HANDLE handle);
+
+  virtual int suspend_handler (const ACE_Handle_Set &handles);
+
+  virtual int suspend_handlers (void);
+
+  virtual int resume_handler (ACE_Event_Handler *event_handler);
+
+  virtual int resume_handler (ACE_HANDLE handle);
+
+  virtual int resume_handler (const ACE_Handle_Set &handles);
+
+  virtual int resume_handlers (void);
+
+  virtual int resumable_handler (void);
+
+  virtual bool uses_event_associations (void);
+
+  // = Timer management, performed by the first shard.
+
+  virtual long schedule_timer (ACE_Event_Handler *event_handler,
+                               const void *arg,
+                               const ACE_Time_Value &delay,
+                               const ACE_Time_Value &interval = ACE_Time_Value::zero);
+
+  virtual int reset_timer_interval (long timer_id,
+                                    const ACE_Time_Value &interval);
+
+  virtual int cancel_timer (ACE_Event_Handler *event_handler,
+                            int dont_call_handle_close = 1);
+
+  virtual int cancel_timer (long timer_id,
+                            const void **arg = 0,
+                            int dont_call_handle_close = 1);
+
+  /// Enable or disable timer expiry through a timerfd in the first
+  /// shard, see ACE_Dev_Poll_Reactor::use_timer_fd().
+  int use_timer_fd (bool enable = true);
+
+  /// True if timers expire through a timerfd.
+  bool uses_timer_fd (void) const;
+
+  // = High-level event handler scheduling operations.
+
+  virtual int schedule_wakeup (ACE_Event_Handler *event_handler,
+                               ACE_Reactor_Mask masks_to_be_added);
+
+  virtual int schedule_wakeup (ACE_HANDLE handle,
+                               ACE_Reactor_Mask masks_to_be_added);
+
+  virtual int cancel_wakeup (ACE_Event_Handler *event_handler,
+                             ACE_Reactor_Mask masks_to_be_cleared);
+
+  virtual int cancel_wakeup (ACE_HANDLE handle,
+                             ACE_Reactor_Mask masks_to_be_cleared);
+
+  // = Notification methods.
+
+  /// Notify the shard @a event_handler's handle is registered in, or
+  /// the first shard.
+  virtual int notify (ACE_Event_Handler *event_handler = 0,
+                      ACE_Reactor_Mask mask = ACE_Event_Handler::EXCEPT_MASK,
+                      ACE_Time_Value * = 0);
+
+  virtual void max_notify_iterations (int);
+
+  virtual int max_notify_iterations (void);
+
+  virtual int purge_pending_notifications (ACE_Event_Handler * = 0,
+                                           ACE_Reactor_Mask = ACE_Event_Handler::ALL_EVENTS_MASK);
+
+  virtual ACE_Event_Handler *find_handler (ACE_HANDLE handle);
+
+  virtual int handler (ACE_HANDLE handle,
+                       ACE_Reactor_Mask mask,
+                       ACE_Event_Handler **event_handler = 0);
+
+  virtual int handler (int signum,
+                       ACE_Event_Handler ** = 0);
+
+  virtual bool initialized (void);
+
+  /// Sum of the sizes of the shards.
+  virtual size_t size (void) const;
+
+  /// Lock of the first shard.
+  virtual ACE_Lock &lock (void);
+
+  virtual void wakeup_all_threads (void);
+
+  /// Not implemented: each shard has its own owner.
+  virtual int owner (ACE_thread_t new_owner, ACE_thread_t *old_owner = 0);
+
+  /// Not implemented: each shard has its own owner.
+  virtual int owner (ACE_thread_t *owner);
+
+  virtual bool restart (void);
+
+  virtual bool restart (bool r);
+
+  virtual void requeue_position (int);
+
+  virtual int requeue_position (void);
+
+  virtual int mask_ops (ACE_Event_Handler *event_handler,
+                        ACE_Reactor_Mask mask,
+                        int ops);
+
+  virtual int mask_ops (ACE_HANDLE handle,
+                        ACE_Reactor_Mask mask,
+                        int ops);
+
+  /// Not implemented.
+  virtual int ready_ops (ACE_Event_Handler *event_handler,
+                         ACE_Reactor_Mask mask,
+                         int ops);
+
+  /// Not implemented.
+  virtual int ready_ops (ACE_HANDLE handle,
+                         ACE_Reactor_Mask,
+                         int ops);
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Shard @a handle is registered in, or 0 if it isn't registered.
+  ACE_Dev_Poll_Reactor *shard_of (ACE_HANDLE handle);
+
+  /// Shard the calling thread dispatches, binding the thread to one if
+  /// it isn't bound yet.
+  ACE_Dev_Poll_Reactor *thread_shard (void);
+
+  /// Register @a handle in shard @a shard, or in the shard it is
+  /// already registered in.
+  int register_handler_i (size_t shard,
+                          ACE_HANDLE handle,
+                          ACE_Event_Handler *event_handler,
+                          ACE_Reactor_Mask mask);
+
+  /// Forget the shard of @a handle if the shard doesn't hold it any
+  /// more.
+  void unbind_handle (ACE_HANDLE handle);
+
+  /// Delete the shards and the handle table, which leaves the reactor
+  /// unopened.
+  void release_shards (void);
+
+private:
+  /// The shards.
+  ACE_Dev_Poll_Reactor **shards_;
+
+  /// Number of entries in @c shards_.
+  size_t shard_count_;
+
+  /// Index plus one of the shard each handle is registered in; 0 if
+  /// the handle isn't registered.
+  size_t *handle_shard_;
+
+  /// Number of entries in @c handle_shard_.
+  size_t handle_shard_size_;
+
+  /// Shard the next handler is registered in, round robin.
+  size_t next_shard_;
+
+  /// Number of threads bound to shards so far.
+  size_t bound_threads_;
+
+  /// Protects @c handle_shard_, @c next_shard_ and @c bound_threads_.
+  ACE_SYNCH_MUTEX lock_;
+
+  /// Index plus one of the shard the calling thread is bound to; 0 if
+  /// it isn't bound.
+  ACE_TSS<ACE_TSS_Type_Adapter<size_t> > thread_shard_;
+
+  ACE_UNIMPLEMENTED_FUNC (ACE_Sharded_Dev_Poll_Reactor (const ACE_Sharded_Dev_Poll_Reactor &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Sharded_Dev_Poll_Reactor &operator= (const ACE_Sharded_Dev_Poll_Reactor &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+
+#include /**/ "ace/post.h"
+
+#endif  /* ACE_SHARDED_DEV_POLL_REACTOR_H */
@@ -0,0 +1,204 @@
+#ifndef ACE_SLAB_ALLOCATOR_T_CPP
+#define ACE_SLAB_ALLOCATOR_T_CPP
+
+#include "ace/Slab_Allocator_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Slab_Allocator_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Guard_T.h"
+#include "ace/Malloc.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <class ACE_LOCK>
+ACE_Slab_Allocator<ACE_LOCK>::ACE_Slab_Allocator (size_t max_chunk_size,
+                                                  size_t slab_size)
+  : classes_array_ (0),
+    classes_ (0),
+    slab_size_ (slab_size),
+    header_size_ (ACE_MALLOC_ROUNDUP (sizeof (size_t), ACE_MALLOC_ALIGN))
+{
+  for (size_t size = MIN_CHUNK; size < max_chunk_size; size <<= 1)
+    ++this->classes_;
+  ++this->classes_;
+
+  ACE_NEW_NORETURN (this->classes_array_, Size_Class[this->classes_]);
+  if (this->classes_array_ == 0)
+    this->classes_ = 0;
+}
+
+template <class ACE_LOCK>
+ACE_Slab_Allocator<ACE_LOCK>::~ACE_Slab_Allocator (void)
+{
+  for (size_t sc = 0; sc < this->classes_; ++sc)
+    while (this->classes_array_[sc].slabs_ != 0)
+      {
+        char *slab = this->classes_array_[sc].slabs_;
+        this->classes_array_[sc].slabs_ = *reinterpret_cast<char **> (slab);
+        delete [] slab;
+      }
+
+  delete [] this->classes_array_;
+}
+
+ACE_ALLOC_HOOK_DEFINE_Tc(ACE_Slab_Allocator)
+
+template <class ACE_LOCK> int
+ACE_Slab_Allocator<ACE_LOCK>::grow_i (size_t sc)
+{
+  Size_Class &size_class = this->classes_array_[sc];
+  size_t const stride =
+    this->header_size_ + (static_cast<size_t> (MIN_CHUNK) << sc);
+  size_t const n_chunks =
+    this->slab_size_ > stride ? this->slab_size_ / stride : 1;
+
+  char *slab = 0;
+  ACE_NEW_RETURN (slab,
+                  char[this->header_size_ + n_chunks * stride],
+                  -1);
+
+  *reinterpret_cast<char **> (slab) = size_class.slabs_;
+  size_class.slabs_ = slab;
+
+  // The chunks start after the link to the next slab, which takes as
+  // many bytes as a chunk header.
+  char *chunk = slab + this->header_size_;
+  for (size_t c = 0; c < n_chunks; ++c, chunk += stride)
+    {
+      *reinterpret_cast<size_t *> (chunk) = sc;
+      void *ptr = chunk + this->header_size_;
+      *static_cast<void **> (ptr) = size_class.free_;
+      size_class.free_ = ptr;
+    }
+
+  size_class.depth_ += n_chunks;
+  return 0;
+}
+
+template <class ACE_LOCK> void *
+ACE_Slab_Allocator<ACE_LOCK>::malloc_i (size_t sc)
+{
+  Size_Class &size_class = this->classes_array_[sc];
+
+  ACE_GUARD_RETURN (ACE_LOCK, ace_mon, size_class.lock_, 0);
+
+  if (size_class.free_ == 0 && this->grow_i (sc) == -1)
+    return 0;
+
+  void *ptr = size_class.free_;
+  size_class.free_ = *static_cast<void **> (ptr);
+  --size_class.depth_;
+  return ptr;
+}
+
+template <class ACE_LOCK> void *
+ACE_Slab_Allocator<ACE_LOCK>::heap_malloc (size_t nbytes)
+{
+  char *ptr =
+    static_cast<char *> (
+      this->ACE_New_Allocator::malloc (this->header_size_ + nbytes));
+  if (ptr == 0)
+    return 0;
+
+  *reinterpret_cast<size_t *> (ptr) = HEAP_CHUNK;
+  return ptr + this->header_size_;
+}
+
+template <class ACE_LOCK> void *
+ACE_Slab_Allocator<ACE_LOCK>::malloc (size_t nbytes)
+{
+  size_t const sc = this->size_class (nbytes);
+
+  return sc < this->classes_ ? this->malloc_i (sc) : this->heap_malloc (nbytes);
+}
+
+template <class ACE_LOCK> void *
+ACE_Slab_Allocator<ACE_LOCK>::calloc (size_t nbytes,
+                                      char initial_value)
+{
+  void *ptr = this->malloc (nbytes);
+  if (ptr != 0)
+    ACE_OS::memset (ptr, initial_value, nbytes);
+  return ptr;
+}
+
+template <class ACE_LOCK> void *
+ACE_Slab_Allocator<ACE_LOCK>::calloc (size_t n_elem,
+                                      size_t elem_size,
+                                      char initial_value)
+{
+  return this->calloc (n_elem * elem_size, initial_value);
+}
+
+template <class ACE_LOCK> void
+ACE_Slab_Allocator<ACE_LOCK>::free (void *ptr)
+{
+  if (ptr == 0)
+    return;
+
+  char *header = static_cast<char *> (ptr) - this->header_size_;
+  size_t const sc = *reinterpret_cast<size_t *> (header);
+
+  if (sc == COLOCATED_BUFFER)
+    // Released along with the chunk it is part of.
+    return;
+
+  if (sc == HEAP_CHUNK)
+    {
+      this->ACE_New_Allocator::free (header);
+      return;
+    }
+
+  Size_Class &size_class = this->classes_array_[sc];
+
+  ACE_GUARD (ACE_LOCK, ace_mon, size_class.lock_);
+
+  *static_cast<void **> (ptr) = size_class.free_;
+  size_class.free_ = ptr;
+  ++size_class.depth_;
+}
+
+template <class ACE_LOCK> void *
+ACE_Slab_Allocator<ACE_LOCK>::malloc_colocated (size_t header_size,
+                                                size_t nbytes,
+                                                void *&buffer)
+{
+  // The buffer has a header too, so that free() leaves it alone.
+  size_t const offset =
+    ACE_MALLOC_ROUNDUP (header_size, ACE_MALLOC_ALIGN) + this->header_size_;
+
+  char *ptr = static_cast<char *> (this->malloc (offset + nbytes));
+  if (ptr == 0)
+    {
+      buffer = 0;
+      return 0;
+    }
+
+  *reinterpret_cast<size_t *> (ptr + offset - this->header_size_) =
+    COLOCATED_BUFFER;
+  buffer = ptr + offset;
+  return ptr;
+}
+
+template <class ACE_LOCK> size_t
+ACE_Slab_Allocator<ACE_LOCK>::pool_depth (size_t nbytes)
+{
+  size_t const sc = this->size_class (nbytes);
+  if (sc >= this->classes_)
+    return 0;
+
+  ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->classes_array_[sc].lock_, 0);
+  return this->classes_array_[sc].depth_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_SLAB_ALLOCATOR_T_CPP */
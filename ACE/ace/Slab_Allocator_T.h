@@ -0,0 +1,174 @@
+// -*- C++ -*-
+
+//==========================================================================
+/**
+ *  @file    Slab_Allocator_T.h
+ *
+ *  Allocator with power-of-two size classes carved out of slabs.
+ */
+//==========================================================================
+
+#ifndef ACE_SLAB_ALLOCATOR_T_H
+#define ACE_SLAB_ALLOCATOR_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Malloc_Allocator.h"
+#include "ace/Global_Macros.h"
+#include "ace/Default_Constants.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Slab_Allocator
+ *
+ * @brief An allocator with power-of-two size classes.
+ *
+ * Each request is rounded up to the next power of two, at least
+ * 16 bytes, and served from the free list of that size class.  When
+ * a free list is empty a slab of @a slab_size bytes is allocated and
+ * carved into chunks of its class, so most malloc() and free() calls
+ * just pop or push a chunk under the lock of their class.  The slabs
+ * are released when the allocator is destroyed.  Requests larger than
+ * @a max_chunk_size are passed on to ACE_New_Allocator.
+ *
+ * The allocator also implements malloc_colocated(), which
+ * ACE_Message_Block uses to allocate an ACE_Data_Block and its buffer
+ * in a single chunk when the allocator is the allocator strategy of
+ * the data block, saving an allocation per message block.  The buffer
+ * is then released along with the data block.
+ *
+ * Each chunk carries a header of ACE_MALLOC_ALIGN bytes, which tells
+ * free() where it goes.  The ACE_LOCK must support the
+ * @a ACE_Thread_Mutex constructor API.
+ *
+ * @sa ACE_Dynamic_Cached_Allocator
+ */
+template <class ACE_LOCK>
+class ACE_Slab_Allocator : public ACE_New_Allocator
+{
+public:
+  /// Create an allocator with size classes up to @a max_chunk_size,
+  /// refilled @a slab_size bytes at a time.
+  ACE_Slab_Allocator (size_t max_chunk_size =
+                        ACE_DEFAULT_SLAB_ALLOCATOR_MAX_CHUNK,
+                      size_t slab_size =
+                        ACE_DEFAULT_SLAB_ALLOCATOR_SLAB_SIZE);
+
+  /// Release the slabs.
+  virtual ~ACE_Slab_Allocator (void);
+
+  /// Get a chunk of the size class of @a nbytes, or from
+  /// ACE_New_Allocator if @a nbytes is larger than the largest class.
+  virtual void *malloc (size_t nbytes);
+
+  /// Get a chunk and set its first @a nbytes bytes to
+  /// @a initial_value.
+  virtual void *calloc (size_t nbytes,
+                        char initial_value = '\0');
+
+  /// Get a chunk for @a n_elem elements of @a elem_size bytes and set
+  /// them to @a initial_value.
+  virtual void *calloc (size_t n_elem,
+                        size_t elem_size,
+                        char initial_value = '\0');
+
+  /// Return a chunk to the free list of its size class.
+  virtual void free (void *);
+
+  /// Get a single chunk for @a header_size bytes followed by a buffer
+  /// of @a nbytes bytes.
+  virtual void *malloc_colocated (size_t header_size,
+                                  size_t nbytes,
+                                  void *&buffer);
+
+  /// Number of free chunks in the size class of @a nbytes, 0 if
+  /// @a nbytes is larger than the largest class.
+  size_t pool_depth (size_t nbytes);
+
+  /// Usable size of the chunks that serve a request of @a nbytes, 0
+  /// if @a nbytes is larger than the largest class.
+  size_t chunk_size (size_t nbytes) const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  enum
+  {
+    /// Size of the smallest class.
+    MIN_CHUNK = 16,
+
+    /// Header of the memory from ACE_New_Allocator.
+    HEAP_CHUNK = 0xff,
+
+    /// Header of a buffer colocated with the object that manages it.
+    COLOCATED_BUFFER = 0xfe
+  };
+
+  /// The free chunks of a size class.
+  struct Size_Class
+  {
+    Size_Class (void);
+
+    /// Synchronize access to the free list.
+    ACE_LOCK lock_;
+
+    /// Free chunks, linked through their first word.
+    void *free_;
+
+    /// Slabs of the class, linked through their first word.
+    char *slabs_;
+
+    /// Number of chunks on the free list.
+    size_t depth_;
+  };
+
+  /// Index of the size class of @a nbytes, classes_ if there is none.
+  size_t size_class (size_t nbytes) const;
+
+  /// Allocate a slab for @a sc.  The lock of @a sc must be held.
+  int grow_i (size_t sc);
+
+  /// Get a chunk of size class @a sc, with its header set.
+  void *malloc_i (size_t sc);
+
+  /// Allocate @a nbytes from ACE_New_Allocator, with a header that
+  /// marks the memory as not belonging to a size class.
+  void *heap_malloc (size_t nbytes);
+
+  /// The size classes.
+  Size_Class *classes_array_;
+
+  /// Number of size classes.
+  size_t classes_;
+
+  /// Size of the slabs.
+  size_t const slab_size_;
+
+  /// Bytes before the memory a chunk hands out.
+  size_t const header_size_;
+
+  // = Don't allow these operations.
+  ACE_UNIMPLEMENTED_FUNC (ACE_Slab_Allocator (const ACE_Slab_Allocator<ACE_LOCK> &))
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Slab_Allocator<ACE_LOCK> &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Slab_Allocator_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Slab_Allocator_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Slab_Allocator_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_SLAB_ALLOCATOR_T_H */
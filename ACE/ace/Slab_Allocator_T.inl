@@ -0,0 +1,30 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <class ACE_LOCK> ACE_INLINE
+ACE_Slab_Allocator<ACE_LOCK>::Size_Class::Size_Class (void)
+  : free_ (0),
+    slabs_ (0),
+    depth_ (0)
+{
+}
+
+template <class ACE_LOCK> ACE_INLINE size_t
+ACE_Slab_Allocator<ACE_LOCK>::size_class (size_t nbytes) const
+{
+  size_t sc = 0;
+  for (size_t size = MIN_CHUNK;
+       size < nbytes && sc < this->classes_;
+       size <<= 1)
+    ++sc;
+  return sc;
+}
+
+template <class ACE_LOCK> ACE_INLINE size_t
+ACE_Slab_Allocator<ACE_LOCK>::chunk_size (size_t nbytes) const
+{
+  size_t const sc = this->size_class (nbytes);
+  return sc < this->classes_ ? static_cast<size_t> (MIN_CHUNK) << sc : 0;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,323 @@
+#ifndef ACE_TSS_CACHED_ALLOCATOR_T_CPP
+#define ACE_TSS_CACHED_ALLOCATOR_T_CPP
+
+#include "ace/TSS_Cached_Allocator_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if !defined (__ACE_INLINE__)
+#include "ace/TSS_Cached_Allocator_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Guard_T.h"
+#include "ace/Malloc.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <class ACE_LOCK>
+ACE_TSS_Cached_Allocator_Depot<ACE_LOCK>::ACE_TSS_Cached_Allocator_Depot (
+  size_t n_chunks,
+  size_t stride,
+  size_t header_size,
+  size_t magazine_size)
+  : batches_ (0),
+    slabs_ (0),
+    chunks_ (0),
+    refcount_ (1),
+    stride_ (stride),
+    header_size_ (header_size),
+    magazine_size_ (magazine_size),
+    grow_ (n_chunks > magazine_size ? n_chunks : magazine_size)
+{
+  if (n_chunks > 0)
+    (void) this->grow_i (n_chunks);
+}
+
+template <class ACE_LOCK>
+ACE_TSS_Cached_Allocator_Depot<ACE_LOCK>::~ACE_TSS_Cached_Allocator_Depot (void)
+{
+  while (this->slabs_ != 0)
+    {
+      char *slab = this->slabs_;
+      this->slabs_ = *reinterpret_cast<char **> (slab);
+      delete [] slab;
+    }
+}
+
+template <class ACE_LOCK> int
+ACE_TSS_Cached_Allocator_Depot<ACE_LOCK>::grow_i (size_t n_chunks)
+{
+  char *slab = 0;
+  ACE_NEW_RETURN (slab,
+                  char[this->header_size_ + n_chunks * this->stride_],
+                  -1);
+
+  *reinterpret_cast<char **> (slab) = this->slabs_;
+  this->slabs_ = slab;
+
+  // The chunks start after the link to the next slab, which takes as
+  // many bytes as a chunk header.
+  char *chunk = slab + this->header_size_;
+  ACE_TSS_Cached_Allocator_Node *batch = 0;
+
+  for (size_t c = 0; c < n_chunks; ++c, chunk += this->stride_)
+    {
+      *reinterpret_cast<void **> (chunk) = this;
+
+      ACE_TSS_Cached_Allocator_Node *node =
+        reinterpret_cast<ACE_TSS_Cached_Allocator_Node *> (
+          chunk + this->header_size_);
+
+      if (batch != 0 && batch->batch_size_ < this->magazine_size_)
+        {
+          node->next_ = batch->next_;
+          batch->next_ = node;
+          ++batch->batch_size_;
+        }
+      else
+        {
+          node->next_ = 0;
+          node->next_batch_ = this->batches_;
+          node->batch_size_ = 1;
+          this->batches_ = node;
+          batch = node;
+        }
+    }
+
+  this->chunks_ += n_chunks;
+  return 0;
+}
+
+template <class ACE_LOCK> size_t
+ACE_TSS_Cached_Allocator_Depot<ACE_LOCK>::get (void **magazine)
+{
+  ACE_TSS_Cached_Allocator_Node *batch = 0;
+
+  {
+    ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, 0);
+
+    if (this->batches_ == 0 && this->grow_i (this->grow_) == -1)
+      return 0;
+
+    batch = this->batches_;
+    this->batches_ = batch->next_batch_;
+    this->chunks_ -= batch->batch_size_;
+  }
+
+  // The batch is ours now, walk it without the lock.
+  size_t count = 0;
+  for (ACE_TSS_Cached_Allocator_Node *node = batch; node != 0; )
+    {
+      ACE_TSS_Cached_Allocator_Node *next = node->next_;
+      magazine[count++] = node;
+      node = next;
+    }
+
+  return count;
+}
+
+template <class ACE_LOCK> void
+ACE_TSS_Cached_Allocator_Depot<ACE_LOCK>::put (void **magazine, size_t count)
+{
+  if (count == 0)
+    return;
+
+  // Link the batch before taking the lock.
+  ACE_TSS_Cached_Allocator_Node *batch =
+    static_cast<ACE_TSS_Cached_Allocator_Node *> (magazine[0]);
+
+  for (size_t i = 0; i < count; ++i)
+    static_cast<ACE_TSS_Cached_Allocator_Node *> (magazine[i])->next_ =
+      i + 1 < count
+        ? static_cast<ACE_TSS_Cached_Allocator_Node *> (magazine[i + 1])
+        : 0;
+  batch->batch_size_ = count;
+
+  ACE_GUARD (ACE_LOCK, ace_mon, this->lock_);
+
+  batch->next_batch_ = this->batches_;
+  this->batches_ = batch;
+  this->chunks_ += count;
+}
+
+template <class ACE_LOCK> size_t
+ACE_TSS_Cached_Allocator_Depot<ACE_LOCK>::depth (void)
+{
+  ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, 0);
+  return this->chunks_;
+}
+
+template <class ACE_LOCK> void
+ACE_TSS_Cached_Allocator_Depot<ACE_LOCK>::add_ref (void)
+{
+  ACE_GUARD (ACE_LOCK, ace_mon, this->lock_);
+  ++this->refcount_;
+}
+
+template <class ACE_LOCK> void
+ACE_TSS_Cached_Allocator_Depot<ACE_LOCK>::remove_ref (void)
+{
+  {
+    ACE_GUARD (ACE_LOCK, ace_mon, this->lock_);
+    if (--this->refcount_ > 0)
+      return;
+  }
+
+  delete this;
+}
+
+template <class ACE_LOCK>
+ACE_TSS_Cached_Allocator_Cache<ACE_LOCK>::ACE_TSS_Cached_Allocator_Cache (void)
+  : depot_ (0),
+    magazines_ (0),
+    loaded_ (0),
+    loaded_count_ (0),
+    previous_ (0),
+    previous_count_ (0)
+{
+}
+
+template <class ACE_LOCK>
+ACE_TSS_Cached_Allocator_Cache<ACE_LOCK>::~ACE_TSS_Cached_Allocator_Cache (void)
+{
+  if (this->depot_ != 0)
+    {
+      this->depot_->put (this->loaded_, this->loaded_count_);
+      this->depot_->put (this->previous_, this->previous_count_);
+      this->depot_->remove_ref ();
+    }
+
+  delete [] this->magazines_;
+}
+
+template <class ACE_LOCK> int
+ACE_TSS_Cached_Allocator_Cache<ACE_LOCK>::open (
+  ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> *depot)
+{
+  size_t const magazine_size = depot->magazine_size ();
+
+  ACE_NEW_RETURN (this->magazines_, void *[2 * magazine_size], -1);
+  this->loaded_ = this->magazines_;
+  this->previous_ = this->magazines_ + magazine_size;
+
+  depot->add_ref ();
+  this->depot_ = depot;
+  return 0;
+}
+
+template <class ACE_LOCK>
+ACE_TSS_Cached_Allocator<ACE_LOCK>::ACE_TSS_Cached_Allocator (
+  size_t n_chunks,
+  size_t chunk_size,
+  size_t magazine_size)
+  : depot_ (0),
+    chunk_size_ (ACE_MALLOC_ROUNDUP (chunk_size < sizeof (ACE_TSS_Cached_Allocator_Node)
+                                       ? sizeof (ACE_TSS_Cached_Allocator_Node)
+                                       : chunk_size,
+                                     ACE_MALLOC_ALIGN)),
+    header_size_ (ACE_MALLOC_ROUNDUP (sizeof (void *), ACE_MALLOC_ALIGN))
+{
+  ACE_NEW (this->depot_,
+           ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> (
+             n_chunks,
+             this->header_size_ + this->chunk_size_,
+             this->header_size_,
+             magazine_size > 0 ? magazine_size : 1));
+}
+
+template <class ACE_LOCK>
+ACE_TSS_Cached_Allocator<ACE_LOCK>::~ACE_TSS_Cached_Allocator (void)
+{
+  // The cache of this thread lets go of the depot when cache_ is
+  // destroyed, those of the other threads when they exit.
+  if (this->depot_ != 0)
+    this->depot_->remove_ref ();
+}
+
+ACE_ALLOC_HOOK_DEFINE_Tc(ACE_TSS_Cached_Allocator)
+
+template <class ACE_LOCK> ACE_TSS_Cached_Allocator_Cache<ACE_LOCK> *
+ACE_TSS_Cached_Allocator<ACE_LOCK>::cache (void)
+{
+  ACE_TSS_Cached_Allocator_Cache<ACE_LOCK> *cache = this->cache_;
+
+  if (cache != 0
+      && cache->depot () == 0
+      && (this->depot_ == 0 || cache->open (this->depot_) == -1))
+    return 0;
+
+  return cache;
+}
+
+template <class ACE_LOCK> void *
+ACE_TSS_Cached_Allocator<ACE_LOCK>::heap_malloc (size_t nbytes)
+{
+  char *ptr =
+    static_cast<char *> (
+      this->ACE_New_Allocator::malloc (this->header_size_ + nbytes));
+  if (ptr == 0)
+    return 0;
+
+  *reinterpret_cast<void **> (ptr) = 0;
+  return ptr + this->header_size_;
+}
+
+template <class ACE_LOCK> void *
+ACE_TSS_Cached_Allocator<ACE_LOCK>::malloc (size_t nbytes)
+{
+  ACE_TSS_Cached_Allocator_Cache<ACE_LOCK> *cache =
+    nbytes <= this->chunk_size_ ? this->cache () : 0;
+
+  void *ptr = cache != 0 ? cache->get () : 0;
+
+  return ptr != 0 ? ptr : this->heap_malloc (nbytes);
+}
+
+template <class ACE_LOCK> void *
+ACE_TSS_Cached_Allocator<ACE_LOCK>::calloc (size_t nbytes,
+                                            char initial_value)
+{
+  void *ptr = this->malloc (nbytes);
+  if (ptr != 0)
+    ACE_OS::memset (ptr, initial_value, nbytes);
+  return ptr;
+}
+
+template <class ACE_LOCK> void *
+ACE_TSS_Cached_Allocator<ACE_LOCK>::calloc (size_t n_elem,
+                                            size_t elem_size,
+                                            char initial_value)
+{
+  return this->calloc (n_elem * elem_size, initial_value);
+}
+
+template <class ACE_LOCK> void
+ACE_TSS_Cached_Allocator<ACE_LOCK>::free (void *ptr)
+{
+  if (ptr == 0)
+    return;
+
+  char *header = static_cast<char *> (ptr) - this->header_size_;
+  ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> *depot =
+    *reinterpret_cast<ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> **> (header);
+
+  if (depot == 0)
+    {
+      this->ACE_New_Allocator::free (header);
+      return;
+    }
+
+  ACE_TSS_Cached_Allocator_Cache<ACE_LOCK> *cache = this->cache ();
+  if (cache != 0 && cache->depot () == depot)
+    cache->put (ptr);
+  else
+    depot->put (&ptr, 1);
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_TSS_CACHED_ALLOCATOR_T_CPP */
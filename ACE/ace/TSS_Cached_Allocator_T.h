@@ -0,0 +1,295 @@
+// -*- C++ -*-
+
+//==========================================================================
+/**
+ *  @file    TSS_Cached_Allocator_T.h
+ *
+ *  Fixed-size allocator that caches chunks per thread.
+ */
+//==========================================================================
+
+#ifndef ACE_TSS_CACHED_ALLOCATOR_T_H
+#define ACE_TSS_CACHED_ALLOCATOR_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Malloc_Allocator.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/TSS_T.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @struct ACE_TSS_Cached_Allocator_Node
+ *
+ * @brief Overlays a free chunk of an ACE_TSS_Cached_Allocator.
+ *
+ * The chunks in the depot are kept in batches of at most a
+ * magazine.  Only the first chunk of a batch uses @c next_batch_ and
+ * @c batch_size_.
+ */
+struct ACE_TSS_Cached_Allocator_Node
+{
+  /// Next chunk of the batch.
+  ACE_TSS_Cached_Allocator_Node *next_;
+
+  /// Next batch in the depot.
+  ACE_TSS_Cached_Allocator_Node *next_batch_;
+
+  /// Number of chunks in the batch.
+  size_t batch_size_;
+};
+
+/**
+ * @class ACE_TSS_Cached_Allocator_Depot
+ *
+ * @brief The chunks of an ACE_TSS_Cached_Allocator that are not
+ * cached by a thread.
+ *
+ * The depot hands out and takes back a batch of chunks at a time, so
+ * its lock is taken once per magazine rather than once per chunk.  It
+ * carves the chunks out of slabs it allocates when it runs dry, and
+ * is reference counted so that it outlives its allocator as long as a
+ * thread still caches some of its chunks.
+ *
+ * This class is internal to ACE_TSS_Cached_Allocator.
+ */
+template <class ACE_LOCK>
+class ACE_TSS_Cached_Allocator_Depot
+{
+public:
+  /// Create a depot of @a n_chunks chunks each taking @a stride bytes,
+  /// the first @a header_size of which hold the address of the depot.
+  ACE_TSS_Cached_Allocator_Depot (size_t n_chunks,
+                                  size_t stride,
+                                  size_t header_size,
+                                  size_t magazine_size);
+
+  /// Fill @a magazine with a batch of chunks and return their number,
+  /// 0 if the depot is empty and can't grow.
+  size_t get (void **magazine);
+
+  /// Take back the @a count chunks in @a magazine.
+  void put (void **magazine, size_t count);
+
+  /// Number of chunks in a full magazine.
+  size_t magazine_size (void) const;
+
+  /// Number of chunks in the depot.
+  size_t depth (void);
+
+  /// Reference counting, the depot deletes itself once the count
+  /// drops to 0.
+  void add_ref (void);
+  void remove_ref (void);
+
+private:
+  /// Only remove_ref() deletes the depot.
+  ~ACE_TSS_Cached_Allocator_Depot (void);
+
+  /// Allocate a slab of @a n_chunks chunks and add them in batches.
+  /// The lock must be held.
+  int grow_i (size_t n_chunks);
+
+  /// Synchronize access to the depot.
+  ACE_LOCK lock_;
+
+  /// Batches of free chunks.
+  ACE_TSS_Cached_Allocator_Node *batches_;
+
+  /// Slabs the chunks are carved from, linked through their first
+  /// word.
+  char *slabs_;
+
+  /// Number of chunks in the batches.
+  size_t chunks_;
+
+  /// Reference count.
+  size_t refcount_;
+
+  /// Bytes taken by a chunk, including its header.
+  size_t const stride_;
+
+  /// Bytes before the memory a chunk hands out.
+  size_t const header_size_;
+
+  /// Number of chunks in a full magazine.
+  size_t const magazine_size_;
+
+  /// Number of chunks of the slabs allocated when the depot runs dry.
+  size_t const grow_;
+
+  // = Don't allow these operations.
+  ACE_UNIMPLEMENTED_FUNC (ACE_TSS_Cached_Allocator_Depot (const ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> &))
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> &))
+};
+
+/**
+ * @class ACE_TSS_Cached_Allocator_Cache
+ *
+ * @brief The chunks a thread caches, in two magazines.
+ *
+ * A thread allocates from and frees to its loaded magazine.  When it
+ * is empty (or full) the previous magazine is tried, and only when
+ * both are empty (or full) is a magazine exchanged with the depot.  A
+ * thread that alternates between allocating and freeing around a
+ * magazine boundary thus doesn't go to the depot each time.  The
+ * chunks go back to the depot when the thread exits.
+ *
+ * This class is internal to ACE_TSS_Cached_Allocator.
+ */
+template <class ACE_LOCK>
+class ACE_TSS_Cached_Allocator_Cache
+{
+public:
+  ACE_TSS_Cached_Allocator_Cache (void);
+
+  /// Return the chunks to the depot.
+  ~ACE_TSS_Cached_Allocator_Cache (void);
+
+  /// Cache the chunks of @a depot.
+  int open (ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> *depot);
+
+  /// The depot of the chunks, 0 before open().
+  ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> *depot (void) const;
+
+  /// Get a chunk, 0 if none is left.
+  void *get (void);
+
+  /// Cache the chunk @a ptr.
+  void put (void *ptr);
+
+private:
+  /// Exchange the loaded and previous magazines.
+  void swap (void);
+
+  ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> *depot_;
+
+  /// Storage of both magazines.
+  void **magazines_;
+
+  /// The magazine chunks are allocated from and freed to.
+  void **loaded_;
+  size_t loaded_count_;
+
+  /// The other magazine.
+  void **previous_;
+  size_t previous_count_;
+
+  // = Don't allow these operations.
+  ACE_UNIMPLEMENTED_FUNC (ACE_TSS_Cached_Allocator_Cache (const ACE_TSS_Cached_Allocator_Cache<ACE_LOCK> &))
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_TSS_Cached_Allocator_Cache<ACE_LOCK> &))
+};
+
+/**
+ * @class ACE_TSS_Cached_Allocator
+ *
+ * @brief A fixed-size allocator that caches chunks per thread.
+ *
+ * ACE_Cached_Allocator and ACE_Dynamic_Cached_Allocator take a lock
+ * for each malloc() and free().  This allocator keeps the free chunks
+ * of each thread in thread-specific magazines and exchanges whole
+ * magazines with a shared depot, so a thread takes the lock once per
+ * ACE_DEFAULT_TSS_CACHED_ALLOCATOR_MAGAZINE allocations at most.  A
+ * chunk may be freed by any thread, it simply goes to the magazine of
+ * that thread.
+ *
+ * Unlike ACE_Dynamic_Cached_Allocator it never runs out of chunks: the
+ * depot allocates another slab of chunks when it is empty.  Requests
+ * larger than the chunk size are passed on to ACE_New_Allocator, so the
+ * allocator can stand in for an ACE_New_Allocator that mostly serves
+ * requests of the same size.  Each chunk carries a header of
+ * ACE_MALLOC_ALIGN bytes to tell the two apart.
+ *
+ * The ACE_LOCK protects the depot; it must support the
+ * @a ACE_Thread_Mutex constructor API.
+ *
+ * @sa ACE_Dynamic_Cached_Allocator
+ */
+template <class ACE_LOCK>
+class ACE_TSS_Cached_Allocator : public ACE_New_Allocator
+{
+public:
+  /// Create an allocator with @a n_chunks chunks of @a chunk_size
+  /// bytes to begin with.  A thread caches up to twice
+  /// @a magazine_size chunks.
+  ACE_TSS_Cached_Allocator (size_t n_chunks,
+                            size_t chunk_size,
+                            size_t magazine_size =
+                              ACE_DEFAULT_TSS_CACHED_ALLOCATOR_MAGAZINE);
+
+  /// Clear things up.  The chunks still cached by other threads are
+  /// released when the last of these threads exits.
+  virtual ~ACE_TSS_Cached_Allocator (void);
+
+  /// Get a chunk from the magazines of the calling thread, or from
+  /// ACE_New_Allocator if @a nbytes is larger than chunk_size().
+  virtual void *malloc (size_t nbytes = 0);
+
+  /// Get a chunk and set its first @a nbytes bytes to
+  /// @a initial_value.
+  virtual void *calloc (size_t nbytes,
+                        char initial_value = '\0');
+
+  /// Get a chunk for @a n_elem elements of @a elem_size bytes and set
+  /// them to @a initial_value.
+  virtual void *calloc (size_t n_elem,
+                        size_t elem_size,
+                        char initial_value = '\0');
+
+  /// Return a chunk to the magazines of the calling thread.
+  virtual void free (void *);
+
+  /// Return the number of chunks in the depot, which doesn't include
+  /// those cached by the threads.
+  size_t pool_depth (void);
+
+  /// Size of the chunks.
+  size_t chunk_size (void) const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  /// The cache of the calling thread, 0 if it can't be set up.
+  ACE_TSS_Cached_Allocator_Cache<ACE_LOCK> *cache (void);
+
+  /// Allocate @a nbytes from ACE_New_Allocator, with a header that
+  /// marks the memory as not cached.
+  void *heap_malloc (size_t nbytes);
+
+  /// The chunks not cached by a thread.
+  ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> *depot_;
+
+  /// Size of the chunks.
+  size_t const chunk_size_;
+
+  /// Bytes before the memory a chunk hands out.
+  size_t const header_size_;
+
+  /// The magazines of each thread.
+  ACE_TSS<ACE_TSS_Cached_Allocator_Cache<ACE_LOCK> > cache_;
+
+  // = Don't allow these operations.
+  ACE_UNIMPLEMENTED_FUNC (ACE_TSS_Cached_Allocator (const ACE_TSS_Cached_Allocator<ACE_LOCK> &))
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_TSS_Cached_Allocator<ACE_LOCK> &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/TSS_Cached_Allocator_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/TSS_Cached_Allocator_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("TSS_Cached_Allocator_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_TSS_CACHED_ALLOCATOR_T_H */
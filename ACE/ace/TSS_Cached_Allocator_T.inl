@@ -0,0 +1,76 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <class ACE_LOCK> ACE_INLINE size_t
+ACE_TSS_Cached_Allocator_Depot<ACE_LOCK>::magazine_size (void) const
+{
+  return this->magazine_size_;
+}
+
+template <class ACE_LOCK> ACE_INLINE ACE_TSS_Cached_Allocator_Depot<ACE_LOCK> *
+ACE_TSS_Cached_Allocator_Cache<ACE_LOCK>::depot (void) const
+{
+  return this->depot_;
+}
+
+template <class ACE_LOCK> ACE_INLINE void
+ACE_TSS_Cached_Allocator_Cache<ACE_LOCK>::swap (void)
+{
+  void **magazine = this->loaded_;
+  this->loaded_ = this->previous_;
+  this->previous_ = magazine;
+
+  size_t const count = this->loaded_count_;
+  this->loaded_count_ = this->previous_count_;
+  this->previous_count_ = count;
+}
+
+template <class ACE_LOCK> ACE_INLINE void *
+ACE_TSS_Cached_Allocator_Cache<ACE_LOCK>::get (void)
+{
+  if (this->loaded_count_ == 0)
+    {
+      if (this->previous_count_ > 0)
+        this->swap ();
+      else
+        {
+          this->loaded_count_ = this->depot_->get (this->loaded_);
+          if (this->loaded_count_ == 0)
+            return 0;
+        }
+    }
+
+  return this->loaded_[--this->loaded_count_];
+}
+
+template <class ACE_LOCK> ACE_INLINE void
+ACE_TSS_Cached_Allocator_Cache<ACE_LOCK>::put (void *ptr)
+{
+  if (this->loaded_count_ == this->depot_->magazine_size ())
+    {
+      // Both full: hand the previous magazine to the depot and keep
+      // the loaded one as the previous.
+      if (this->previous_count_ > 0)
+        {
+          this->depot_->put (this->previous_, this->previous_count_);
+          this->previous_count_ = 0;
+        }
+      this->swap ();
+    }
+
+  this->loaded_[this->loaded_count_++] = ptr;
+}
+
+template <class ACE_LOCK> ACE_INLINE size_t
+ACE_TSS_Cached_Allocator<ACE_LOCK>::pool_depth (void)
+{
+  return this->depot_->depth ();
+}
+
+template <class ACE_LOCK> ACE_INLINE size_t
+ACE_TSS_Cached_Allocator<ACE_LOCK>::chunk_size (void) const
+{
+  return this->chunk_size_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
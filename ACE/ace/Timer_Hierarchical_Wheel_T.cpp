@@ -0,0 +1,919 @@
+#ifndef ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP
+#define ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/OS_NS_string.h"
+#include "ace/Guard_T.h"
+#include "ace/Timer_Hierarchical_Wheel_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Numeric_Limits.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Design/implementation notes for ACE_Timer_Hierarchical_Wheel_T.
+//
+// The expiration time of a timer is converted to a tick count.  The
+// wheel is at current_tick_, and a timer whose tick agrees with
+// current_tick_ in all the bits above level L but not in the bits of
+// level L is linked into the slot of level L indexed by its own bits
+// of that level.  Each slot is a circular doubly-linked list with a
+// dummy root node, so a node can be unlinked without knowing which
+// slot it is in.  The slots of level 0 are kept sorted, the others
+// aren't.
+//
+// A timer is never linked into the slot that current_tick_ itself
+// indexes at a level above 0, and no timer is linked into a slot
+// before current_tick_ (timers that are due already are linked into
+// the level 0 slot of current_tick_).  So the earliest timer is the
+// first one of the first occupied level 0 slot at or after
+// current_tick_.  If there is none, the wheel moves to the start of
+// the next occupied slot of the lowest level that has one, and that
+// slot is relinked, which moves its timers to lower levels.
+//
+// The wheel doesn't move beyond horizon_tick_, the latest tick known
+// to have passed, or timers that aren't due could end up before
+// current_tick_ and all be sorted into one slot.  If the next
+// occupied slot starts after it, that slot is searched for the
+// earliest timer instead, which is remembered until it is unlinked.
+//
+// The timer id of a node is an index into the timer_ids_ table, which
+// makes cancel() O(1).  Unused ids are kept in a circular queue.
+
+/**
+* Default Constructor that sets the default tick and doesn't do any
+* preallocation.
+*
+* @param upcall_functor A pointer to a functor to use instead of the default
+* @param freelist       A pointer to a freelist to use instead of the default
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_T
+(FUNCTOR* upcall_functor
+ , FreeList* freelist
+ , TIME_POLICY const & time_policy
+ )
+  : Base_Timer_Queue (upcall_functor, freelist, time_policy)
+  , tick_usec_ (0)
+  , current_tick_ (0)
+  , horizon_tick_ (0)
+  , earliest_ (0)
+  , roots_ (0)
+  , timer_ids_ (0)
+  , timer_ids_size_ (0)
+  , free_timer_ids_ (0)
+  , free_timer_ids_head_ (0)
+  , free_timer_ids_count_ (0)
+  , iterator_ (0)
+  , timer_count_ (0)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::ACE_Timer_Hierarchical_Wheel_T");
+  this->open_i (ACE_Time_Value::zero, 0);
+}
+
+/**
+* Constructor that sets up the wheel and also may preallocate some
+* nodes on the free list and some timer ids.
+*
+* @param tick           The granularity of the wheel
+* @param prealloc       The number of timers to preallocate for
+* @param upcall_functor A pointer to a functor to use instead of the default
+* @param freelist       A pointer to a freelist to use instead of the default
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_T
+  (const ACE_Time_Value &tick,
+   size_t prealloc,
+   FUNCTOR* upcall_functor,
+   FreeList* freelist,
+   TIME_POLICY const & time_policy)
+  : Base_Timer_Queue (upcall_functor, freelist, time_policy)
+  , tick_usec_ (0)
+  , current_tick_ (0)
+  , horizon_tick_ (0)
+  , earliest_ (0)
+  , roots_ (0)
+  , timer_ids_ (0)
+  , timer_ids_size_ (0)
+  , free_timer_ids_ (0)
+  , free_timer_ids_head_ (0)
+  , free_timer_ids_count_ (0)
+  , iterator_ (0)
+  , timer_count_ (0)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::ACE_Timer_Hierarchical_Wheel_T");
+  this->open_i (tick, prealloc);
+}
+
+/**
+* Initialize the queue.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::open_i
+  (const ACE_Time_Value &tick, size_t prealloc)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::open_i");
+
+  tick.to_usec (this->tick_usec_);
+  if (this->tick_usec_ == 0)
+    this->tick_usec_ = ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK;
+
+  this->tick_.set (
+    static_cast<time_t> (this->tick_usec_ / ACE_ONE_SECOND_IN_USECS),
+    static_cast<suseconds_t> (this->tick_usec_ % ACE_ONE_SECOND_IN_USECS));
+
+  ACE_OS::memset (this->occupied_, 0, sizeof this->occupied_);
+
+  this->free_list_->resize (prealloc);
+
+  if (this->grow_timer_ids (prealloc) == -1)
+    return;
+
+  // Create the root nodes, including the one of the overflow list.
+  ACE_NEW (this->roots_, ACE_Timer_Node_T<TYPE>[LEVELS * SLOTS + 1]);
+  for (u_int i = 0; i <= LEVELS * SLOTS; ++i)
+    {
+      this->roots_[i].set_prev (&this->roots_[i]);
+      this->roots_[i].set_next (&this->roots_[i]);
+    }
+
+  ACE_NEW (iterator_, Iterator (*this));
+}
+
+/// Destructor just cleans up its memory
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::~ACE_Timer_Hierarchical_Wheel_T (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::~ACE_Timer_Hierarchical_Wheel_T");
+
+  delete this->iterator_;
+
+  this->close ();
+
+  delete [] this->roots_;
+  delete [] this->timer_ids_;
+  delete [] this->free_timer_ids_;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::close (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::close");
+
+  // Remove any remaining nodes
+  for (size_t i = 0; i < this->timer_ids_size_; ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* n = this->timer_ids_[i];
+      if (n != 0 && n->get_next () != 0)
+        {
+          this->upcall_functor ().deletion (*this,
+                                            n->get_type (),
+                                            n->get_act ());
+          this->unlink (n);
+          this->free_node (n);
+        }
+    }
+
+  return 0;
+}
+
+/**
+* Check to see if the wheel is empty
+*
+* @return True if empty
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::is_empty (void) const
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::is_empty");
+  return this->timer_count_ == 0;
+}
+
+/**
+* Finding the earliest node may advance the wheel, which doesn't
+* change the set of timers, so it is done through a non-const path.
+*
+* @return The time of the earliest node in the wheel
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> const ACE_Time_Value &
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::earliest_time (void) const
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::earliest_time");
+  ACE_Timer_Node_T<TYPE>* n =
+    const_cast<ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> *> (this)->get_first_i ();
+  if (n != 0)
+    return n->get_timer_value ();
+  return ACE_Time_Value::zero;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> const ACE_Time_Value &
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::tick (void) const
+{
+  return this->tick_;
+}
+
+/// Converts an absolute time to the number of ticks since the epoch.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_UINT64
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::to_tick
+  (const ACE_Time_Value &t) const
+{
+  ACE_UINT64 usec = 0;
+  t.to_usec (usec);
+  return usec / this->tick_usec_;
+}
+
+/**
+* Creates a ACE_Timer_Node_T based on the input parameters, gives it
+* an unused timer id and inserts it into the wheel.
+*
+*  @param type            The data of the timer node
+*  @param act             Asynchronous Completion Token (AKA magic cookie)
+*  @param future_time     The time the timer is scheduled for (absolute time)
+*  @param interval        If not ACE_Time_Value::zero, then this is a periodic
+*                         timer and interval is the time period
+*
+*  @return Unique identifier (can be used to cancel the timer).
+*          -1 on failure.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> long
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::schedule_i (const TYPE& type,
+                                                                     const void* act,
+                                                                     const ACE_Time_Value& future_time,
+                                                                     const ACE_Time_Value& interval)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::schedule_i");
+
+  if (this->free_timer_ids_count_ == 0 && this->grow_timer_ids (0) == -1)
+    return -1;
+
+  ACE_Timer_Node_T<TYPE>* n = this->alloc_node ();
+  if (n == 0)
+    {
+      errno = ENOMEM;
+      return -1;
+    }
+
+  long const id = this->pop_timer_id ();
+  n->set (type, act, future_time, interval, 0, 0, id);
+  this->timer_ids_[id] = n;
+  this->insert (n);
+  return id;
+}
+
+/**
+* Takes an ACE_Timer_Node and inserts it into the correct slot again.
+* It keeps its timer id.
+*
+* @param n The timer node to reschedule
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::reschedule (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::reschedule");
+  this->insert (n);
+}
+
+/// Releases the timer id of a node that is no longer scheduled before
+/// returning it to the free list.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::free_node (ACE_Timer_Node_T<TYPE>* n)
+{
+  long const id = n->get_timer_id ();
+  if (this->find_node (id) == n)
+    {
+      this->timer_ids_[id] = 0;
+      this->push_timer_id (id);
+    }
+
+  Base_Timer_Queue::free_node (n);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::dispatch_info_i
+  (const ACE_Time_Value &current_time,
+   ACE_Timer_Node_Dispatch_Info_T<TYPE> &info)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::dispatch_info_i");
+
+  ACE_UINT64 const now = this->to_tick (current_time);
+  if (now > this->horizon_tick_)
+    this->horizon_tick_ = now;
+
+  return Base_Timer_Queue::dispatch_info_i (current_time, info);
+}
+
+/// Counts a node that is being scheduled and links it.  An empty
+/// wheel is moved to the current time (or the node's tick if that is
+/// earlier) so that it doesn't have to be advanced from wherever the
+/// previous timers left it.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::insert (ACE_Timer_Node_T<TYPE>* n)
+{
+  if (this->timer_count_++ == 0)
+    {
+      ACE_UINT64 const now = this->to_tick (this->gettimeofday_static ());
+      if (now > this->horizon_tick_)
+        this->horizon_tick_ = now;
+
+      ACE_UINT64 const tick = this->to_tick (n->get_timer_value ());
+      this->current_tick_ = tick < this->horizon_tick_ ? tick : this->horizon_tick_;
+      this->earliest_ = n;
+    }
+  else if (this->earliest_ != 0
+           && n->get_timer_value () < this->earliest_->get_timer_value ())
+    this->earliest_ = n;
+
+  this->link (n);
+}
+
+/// Links a node into the slot of its tick relative to current_tick_.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::link (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_UINT64 tick = this->to_tick (n->get_timer_value ());
+  if (tick < this->current_tick_)
+    tick = this->current_tick_;
+
+  ACE_Timer_Node_T<TYPE>* root = &this->roots_[LEVELS * SLOTS];
+  for (u_int level = 0; level < LEVELS; ++level)
+    {
+      u_int const shift = (level + 1) * LEVEL_BITS;
+      if ((tick >> shift) == (this->current_tick_ >> shift))
+        {
+          u_int const slot =
+            static_cast<u_int> (tick >> (level * LEVEL_BITS)) & (SLOTS - 1);
+          this->occupied_[level][slot / 64] |= ACE_UINT64 (1) << (slot % 64);
+          root = &this->roots_[level * SLOTS + slot];
+          break;
+        }
+    }
+
+  // Only the slots of level 0 are sorted.  We always want to search
+  // backwards from the tail of the list, because this minimizes the
+  // search when timers are scheduled in order.
+  ACE_Timer_Node_T<TYPE>* p = root->get_prev ();
+  if (root < &this->roots_[SLOTS])
+    while (p != root && p->get_timer_value () > n->get_timer_value ())
+      p = p->get_prev ();
+
+  // insert after
+  n->set_prev (p);
+  n->set_next (p->get_next ());
+  p->get_next ()->set_prev (n);
+  p->set_next (n);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::unlink (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::unlink");
+  --this->timer_count_;
+
+  if (n == this->earliest_)
+    this->earliest_ = 0;
+
+  ACE_Timer_Node_T<TYPE>* prev = n->get_prev ();
+  ACE_Timer_Node_T<TYPE>* next = n->get_next ();
+  prev->set_next (next);
+  next->set_prev (prev);
+  n->set_prev (0);
+  n->set_next (0);
+
+  // Only the root is left when both neighbours are the same node.
+  if (prev == next)
+    {
+      size_t const index = prev - this->roots_;
+      if (index < LEVELS * SLOTS)
+        this->occupied_[index / SLOTS][(index % SLOTS) / 64] &=
+          ~(ACE_UINT64 (1) << (index % 64));
+    }
+}
+
+/// Empties a slot, then links its nodes again relative to the
+/// current_tick_, which has moved to the slot.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::relink (ACE_Timer_Node_T<TYPE>* root)
+{
+  ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+  root->get_prev ()->set_next (0);
+  root->set_prev (root);
+  root->set_next (root);
+
+  size_t const index = root - this->roots_;
+  if (index < LEVELS * SLOTS)
+    this->occupied_[index / SLOTS][(index % SLOTS) / 64] &=
+      ~(ACE_UINT64 (1) << (index % 64));
+
+  while (n != 0 && n != root)
+    {
+      ACE_Timer_Node_T<TYPE>* next = n->get_next ();
+      this->link (n);
+      n = next;
+    }
+}
+
+/// Returns the earliest node of an unsorted slot.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::find_earliest
+  (ACE_Timer_Node_T<TYPE>* root) const
+{
+  ACE_Timer_Node_T<TYPE>* earliest = root->get_next ();
+  for (ACE_Timer_Node_T<TYPE>* n = earliest->get_next ();
+       n != root;
+       n = n->get_next ())
+    if (n->get_timer_value () < earliest->get_timer_value ())
+      earliest = n;
+  return earliest;
+}
+
+/**
+* Advances the wheel towards the earliest node if needed.
+*
+* @return The earliest timer node or 0 if the wheel is empty.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::get_first_i (void)
+{
+  if (this->timer_count_ == 0)
+    return 0;
+
+  if (this->earliest_ != 0)
+    return this->earliest_;
+
+  bool clock_read = false;
+  for (;;)
+    {
+      int const slot =
+        next_slot (this->occupied_[0],
+                   static_cast<u_int> (this->current_tick_) & (SLOTS - 1));
+      if (slot != -1)
+        {
+          this->earliest_ = this->roots_[slot].get_next ();
+          return this->earliest_;
+        }
+
+      // Find the next occupied slot of the lowest level that has one,
+      // and the tick it starts at.
+      ACE_Timer_Node_T<TYPE>* root = 0;
+      ACE_UINT64 start = 0;
+      for (u_int level = 1; level < LEVELS && root == 0; ++level)
+        {
+          u_int const shift = level * LEVEL_BITS;
+          u_int const current =
+            static_cast<u_int> (this->current_tick_ >> shift) & (SLOTS - 1);
+          int const next = current + 1 < SLOTS
+            ? next_slot (this->occupied_[level], current + 1)
+            : -1;
+          if (next != -1)
+            {
+              root = &this->roots_[level * SLOTS + next];
+              start =
+                ((this->current_tick_ >> (shift + LEVEL_BITS)) << (shift + LEVEL_BITS))
+                | (ACE_UINT64 (next) << shift);
+            }
+        }
+
+      // Everything left is on the overflow list, so the wheel can
+      // start over at the block of the top level of its earliest node.
+      ACE_Timer_Node_T<TYPE>* earliest = 0;
+      if (root == 0)
+        {
+          root = &this->roots_[LEVELS * SLOTS];
+          earliest = this->find_earliest (root);
+          u_int const shift = LEVELS * LEVEL_BITS;
+          start = (this->to_tick (earliest->get_timer_value ()) >> shift) << shift;
+        }
+
+      if (start > this->horizon_tick_ && !clock_read)
+        {
+          ACE_UINT64 const now = this->to_tick (this->gettimeofday_static ());
+          if (now > this->horizon_tick_)
+            this->horizon_tick_ = now;
+          clock_read = true;
+        }
+
+      if (start > this->horizon_tick_)
+        {
+          // Not due yet, so search the slot but stay where we are.
+          this->earliest_ = earliest != 0 ? earliest : this->find_earliest (root);
+          return this->earliest_;
+        }
+
+      // Move to the slot and let its timers trickle down.
+      this->current_tick_ = start;
+      this->relink (root);
+    }
+}
+
+/// Returns the index of the first occupied slot at or after @a start,
+/// or -1 if there is none.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::next_slot
+  (const ACE_UINT64 *occupied, u_int start)
+{
+  u_int word = start / 64;
+  ACE_UINT64 bits = occupied[word] & (~ACE_UINT64 (0) << (start % 64));
+
+  while (bits == 0)
+    {
+      if (++word == SLOTS / 64)
+        return -1;
+      bits = occupied[word];
+    }
+
+  // Find the lowest bit set.
+  int slot = word * 64;
+  if (static_cast<ACE_UINT32> (bits) == 0)
+    {
+      bits >>= 32;
+      slot += 32;
+    }
+  if ((bits & 0xFFFF) == 0)
+    {
+      bits >>= 16;
+      slot += 16;
+    }
+  if ((bits & 0xFF) == 0)
+    {
+      bits >>= 8;
+      slot += 8;
+    }
+  if ((bits & 0xF) == 0)
+    {
+      bits >>= 4;
+      slot += 4;
+    }
+  if ((bits & 0x3) == 0)
+    {
+      bits >>= 2;
+      slot += 2;
+    }
+  if ((bits & 0x1) == 0)
+    slot += 1;
+
+  return slot;
+}
+
+/// Returns the scheduled node of @a timer_id or 0 if there is none.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::find_node (long timer_id) const
+{
+  if (timer_id < 0 || static_cast<size_t> (timer_id) >= this->timer_ids_size_)
+    return 0;
+  return this->timer_ids_[timer_id];
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> long
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::pop_timer_id (void)
+{
+  long const id = this->free_timer_ids_[this->free_timer_ids_head_];
+  if (++this->free_timer_ids_head_ == this->timer_ids_size_)
+    this->free_timer_ids_head_ = 0;
+  --this->free_timer_ids_count_;
+  return id;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::push_timer_id (long timer_id)
+{
+  size_t tail = this->free_timer_ids_head_ + this->free_timer_ids_count_;
+  if (tail >= this->timer_ids_size_)
+    tail -= this->timer_ids_size_;
+  this->free_timer_ids_[tail] = timer_id;
+  ++this->free_timer_ids_count_;
+}
+
+/// Doubles the timer id table, or grows it to @a min_size if that is
+/// larger.  Only called when all the timer ids are in use.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::grow_timer_ids (size_t min_size)
+{
+  size_t new_size = this->timer_ids_size_ * 2;
+  if (new_size < min_size)
+    new_size = min_size;
+  if (new_size == 0)
+    new_size = ACE_DEFAULT_TIMERS;
+
+  if (new_size > static_cast<size_t> (ACE_Numeric_Limits<long>::max ()))
+    {
+      errno = ENOMEM;
+      return -1;
+    }
+
+  ACE_Timer_Node_T<TYPE>** timer_ids = 0;
+  ACE_NEW_RETURN (timer_ids, ACE_Timer_Node_T<TYPE>*[new_size], -1);
+
+  long* free_timer_ids = 0;
+  ACE_NEW_NORETURN (free_timer_ids, long[new_size]);
+  if (free_timer_ids == 0)
+    {
+      delete [] timer_ids;
+      return -1;
+    }
+
+  for (size_t i = 0; i < this->timer_ids_size_; ++i)
+    timer_ids[i] = this->timer_ids_[i];
+
+  for (size_t i = this->timer_ids_size_; i < new_size; ++i)
+    {
+      timer_ids[i] = 0;
+      free_timer_ids[i - this->timer_ids_size_] = static_cast<long> (i);
+    }
+
+  delete [] this->timer_ids_;
+  delete [] this->free_timer_ids_;
+
+  this->free_timer_ids_head_ = 0;
+  this->free_timer_ids_count_ = new_size - this->timer_ids_size_;
+  this->timer_ids_ = timer_ids;
+  this->free_timer_ids_ = free_timer_ids;
+  this->timer_ids_size_ = new_size;
+  return 0;
+}
+
+/**
+* Find the timer node by using the id as an index.  Then use
+* set_interval() on the node to update the interval.
+*
+* @param timer_id The timer identifier
+* @param interval The new interval
+*
+* @return 0 if successful, -1 if no.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::reset_interval (long timer_id,
+                                                                         const ACE_Time_Value &interval)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::reset_interval");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+  ACE_Timer_Node_T<TYPE>* n = this->find_node (timer_id);
+  if (n != 0)
+    {
+      // The interval will take effect the next time this node is expired.
+      n->set_interval (interval);
+      return 0;
+    }
+  return -1;
+}
+
+/**
+* Goes through the timer id table and whenever we find a node with
+* the correct type value, we remove it and continue.
+*
+* @param type       The value to search for.
+* @param skip_close If this non-zero, the cancellation method of the
+*                   functor will not be called for each cancelled timer.
+*
+* @return Number of timers cancelled
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cancel (const TYPE& type, int skip_close)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::cancel");
+
+  int num_canceled = 0; // Note : Technically this can overflow.
+  int cookie = 0;
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+
+  for (size_t i = 0; i < this->timer_ids_size_ && !this->is_empty (); ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* n = this->timer_ids_[i];
+      if (n != 0 && n->get_next () != 0 && n->get_type () == type)
+        {
+          ++num_canceled;
+          this->unlink (n);
+          this->free_node (n);
+        }
+    }
+
+  // Call the close hooks.
+
+  // cancel_type() called once per <type>.
+  this->upcall_functor ().cancel_type (*this,
+                                       type,
+                                       skip_close,
+                                       cookie);
+
+  for (int i = 0;
+       i < num_canceled;
+       ++i)
+    {
+      // cancel_timer() called once per <timer>.
+      this->upcall_functor ().cancel_timer (*this,
+                                            type,
+                                            skip_close,
+                                            cookie);
+    }
+
+  return num_canceled;
+}
+
+/**
+* Cancels the single timer that is specified by the timer_id.  The
+* timer_id indexes the table of scheduled nodes, so a made up or
+* stale timer_id just isn't found.
+*
+* @param timer_id   Timer Identifier
+* @param act        Asychronous Completion Token (AKA magic cookie):
+*                   If this is non-zero, stores the magic cookie of
+*                   the cancelled timer here.
+* @param skip_close If this non-zero, the cancellation method of the
+*                   functor will not be called.
+*
+* @return 1 for sucess and 0 if the timer_id wasn't found
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cancel (long timer_id,
+                                                                 const void **act,
+                                                                 int skip_close)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::cancel");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+  ACE_Timer_Node_T<TYPE>* n = this->find_node (timer_id);
+
+  // A node that isn't linked is being dispatched and will be
+  // rescheduled or freed by the dispatching thread.
+  if (n == 0 || n->get_next () == 0)
+    return 0;
+
+  // Call the close hooks.
+  int cookie = 0;
+
+  // cancel_type() called once per <type>.
+  this->upcall_functor ().cancel_type (*this,
+                                       n->get_type (),
+                                       skip_close,
+                                       cookie);
+
+  // cancel_timer() called once per <timer>.
+  this->upcall_functor ().cancel_timer (*this,
+                                        n->get_type (),
+                                        skip_close,
+                                        cookie);
+  if (act != 0)
+    *act = n->get_act ();
+
+  this->unlink (n);
+  this->free_node (n);
+  return 1;
+}
+
+/**
+* Dumps out the tick, the position of the wheel, and the contents of
+* the wheel.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ntick_usec_ = %Q"), this->tick_usec_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ncurrent_tick_ = %Q"), this->current_tick_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ntimer_count_ = %B"), this->timer_count_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nwheel_ =\n")));
+
+  for (u_int i = 0; i <= LEVELS * SLOTS; ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* root = &this->roots_[i];
+      if (root->get_next () == root)
+        continue;
+
+      ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("%d %d\n"), i / SLOTS, i % SLOTS));
+      for (ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+           n != root;
+           n = n->get_next ())
+        {
+          n->dump ();
+        }
+    }
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+/**
+* Removes the earliest node.
+*
+* @return The earliest timer node.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::remove_first (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::remove_first");
+  ACE_Timer_Node_T<TYPE>* n = this->get_first_i ();
+  if (n != 0)
+    this->unlink (n);
+  return n;
+}
+
+/**
+* Returns the earliest node without removing it
+*
+* @return The earliest timer node.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::get_first (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::get_first");
+  return this->get_first_i ();
+}
+
+/**
+* @return The iterator
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Queue_Iterator_T<TYPE> &
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::iter (void)
+{
+  this->iterator_->first ();
+  return *this->iterator_;
+}
+
+///////////////////////////////////////////////////////////////////////////
+// ACE_Timer_Hierarchical_Wheel_Iterator_T
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_Iterator_T
+(Wheel& wheel)
+  : timer_wheel_ (wheel)
+  , position_ (0)
+{
+  this->first ();
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::~ACE_Timer_Hierarchical_Wheel_Iterator_T (void)
+{
+}
+
+/**
+* Positions the iterator at the scheduled node with the lowest timer id.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::first (void)
+{
+  this->goto_next (0);
+}
+
+/**
+* Positions the iterator at the next node.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::next (void)
+{
+  if (this->isdone ())
+    return;
+
+  this->goto_next (this->position_ + 1);
+}
+
+/// Helper class for common functionality of next() and first()
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::goto_next (size_t start)
+{
+  size_t const size = this->timer_wheel_.timer_ids_size_;
+  for (this->position_ = start; this->position_ < size; ++this->position_)
+    {
+      ACE_Timer_Node_T<TYPE>* n = this->timer_wheel_.timer_ids_[this->position_];
+      if (n != 0 && n->get_next () != 0)
+        return;
+    }
+}
+
+/**
+* @return True when we there aren't any more items
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::isdone (void) const
+{
+  return this->position_ >= this->timer_wheel_.timer_ids_size_;
+}
+
+/**
+* @return The node at the current position in the sequence or 0 if
+*         there are no more nodes
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::item (void)
+{
+  if (this->isdone ())
+    return 0;
+  return this->timer_wheel_.timer_ids_[this->position_];
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP */
@@ -0,0 +1,293 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Timer_Hierarchical_Wheel_T.h
+ *
+ *  Hierarchical timing wheel version of ACE_Timer_Queue_T.
+ */
+//=============================================================================
+
+#ifndef ACE_TIMER_HIERARCHICAL_WHEEL_T_H
+#define ACE_TIMER_HIERARCHICAL_WHEEL_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Timer_Queue_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Forward declaration
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+class ACE_Timer_Hierarchical_Wheel_T;
+
+/**
+ * @class ACE_Timer_Hierarchical_Wheel_Iterator_T
+ *
+ * @brief Iterates over an ACE_Timer_Hierarchical_Wheel_T.
+ *
+ * This is a generic iterator that can be used to visit every
+ * node of a timer queue.  Be aware that it doesn't traverse
+ * in the order of timeout values.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY = ACE_Default_Time_Policy>
+class ACE_Timer_Hierarchical_Wheel_Iterator_T
+  : public ACE_Timer_Queue_Iterator_T <TYPE>
+{
+public:
+  typedef ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Wheel;
+
+  /// Constructor
+  ACE_Timer_Hierarchical_Wheel_Iterator_T (Wheel &);
+
+  /// Destructor
+  virtual ~ACE_Timer_Hierarchical_Wheel_Iterator_T (void);
+
+  /// Positions the iterator at the first node in the Timer Queue
+  virtual void first (void);
+
+  /// Positions the iterator at the next node in the Timer Queue
+  virtual void next (void);
+
+  /// Returns true when there are no more nodes in the sequence
+  virtual bool isdone (void) const;
+
+  /// Returns the node at the current position in the sequence
+  virtual ACE_Timer_Node_T<TYPE>* item (void);
+
+protected:
+  /// The wheel that we are iterating over.
+  Wheel& timer_wheel_;
+
+  /// Timer id of the current node.
+  size_t position_;
+
+private:
+  void goto_next (size_t start);
+};
+
+/**
+ * @class ACE_Timer_Hierarchical_Wheel_T
+ *
+ * @brief Provides a hierarchical timing wheel version of
+ *        ACE_Timer_Queue.
+ *
+ * Time is divided into ticks of a configurable granularity.  The
+ * wheel has LEVELS levels of SLOTS slots each; a slot of level 0
+ * holds the timers of one tick, and a slot of level @c n the timers
+ * of SLOTS^n ticks.  A timer is linked into the lowest level whose
+ * span still contains its tick, so scheduling and cancelling are
+ * O(1).  When the wheel advances past the timers of level 0 the
+ * next occupied slot of a higher level is cascaded into the levels
+ * below it, so each timer is moved at most LEVELS times before it
+ * expires.  Timers further out than the top level are kept on an
+ * overflow list until the wheel gets there.  This is the scheme
+ * described in Varghese and Lauck's paper "Hashed and Hierarchical
+ * Timing Wheels: Data Structures for the Efficient Implementation
+ * of a Timer Facility".
+ *
+ * The wheel only advances up to the time passed to expire() (or
+ * read from the time policy), and then directly to the next occupied
+ * slot rather than a tick at a time.  Unlike ACE_Timer_Wheel_T, the
+ * earliest timer is always known exactly: the timers of a level 0
+ * slot are kept sorted, and when the earliest timer is in a higher
+ * level slot that isn't due yet that slot is searched once and the
+ * result cached.  The tick granularity therefore only trades the cost
+ * of sorting timers within a tick against the cost of cascading, not
+ * precision.
+ *
+ * Nodes come from the free list and timer ids index a table of the
+ * scheduled nodes, so neither is allocated per timer once the queue
+ * has been preallocated (or has grown) to the number of timers in
+ * use.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY = ACE_Default_Time_Policy>
+class ACE_Timer_Hierarchical_Wheel_T
+  : public ACE_Timer_Queue_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>
+{
+public:
+  /// Type of iterator
+  typedef ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Iterator;
+  /// Iterator is a friend
+  friend class ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>;
+  typedef ACE_Timer_Node_T<TYPE> Node;
+  /// Type inherited from
+  typedef ACE_Timer_Queue_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Base_Timer_Queue;
+  typedef ACE_Free_List<Node> FreeList;
+
+  /// Shape of the wheel.
+  enum
+  {
+    /// Number of bits of the tick handled by each level.
+    LEVEL_BITS = 8,
+    /// Number of slots in each level.
+    SLOTS = 1 << LEVEL_BITS,
+    /// Number of levels.  With the default tick of 1 millisecond the
+    /// levels span almost 35 years.
+    LEVELS = 5
+  };
+
+  /// Default constructor, uses a tick of
+  /// ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK microseconds.
+  ACE_Timer_Hierarchical_Wheel_T (FUNCTOR* upcall_functor = 0,
+                                  FreeList* freelist = 0,
+                                  TIME_POLICY const & time_policy = TIME_POLICY());
+
+  /**
+   * Constructor with opportunities to set the granularity of the
+   * wheel and to preallocate the nodes and timer ids of @a prealloc
+   * timers.  A @a tick of zero selects the default.
+   */
+  ACE_Timer_Hierarchical_Wheel_T (const ACE_Time_Value &tick,
+                                  size_t prealloc = 0,
+                                  FUNCTOR* upcall_functor = 0,
+                                  FreeList* freelist = 0,
+                                  TIME_POLICY const & time_policy = TIME_POLICY());
+
+  /// Destructor
+  virtual ~ACE_Timer_Hierarchical_Wheel_T (void);
+
+  /// True if queue is empty, else false.
+  virtual bool is_empty (void) const;
+
+  /// Returns the time of the earliest node in the wheel.
+  /// Must be called on a non-empty queue.
+  virtual const ACE_Time_Value& earliest_time (void) const;
+
+  /// Changes the interval of a timer (and can make it periodic or non
+  /// periodic by setting it to ACE_Time_Value::zero or not).
+  virtual int reset_interval (long timer_id,
+                              const ACE_Time_Value& interval);
+
+  /// Cancel all timer associated with @a type.  If @a dont_call_handle_close is
+  /// 0 then the <functor> will be invoked.  Returns number of timers
+  /// cancelled.
+  virtual int cancel (const TYPE& type,
+                      int dont_call_handle_close = 1);
+
+  /// Cancel the single timer that matches the @a timer_id value (which
+  /// was returned from the <schedule> method).  If act is non-NULL
+  /// then it will be set to point to the ``magic cookie'' argument
+  /// passed in when the timer was registered.  This makes it possible
+  /// to free up the memory and avoid memory leaks.  If
+  /// @a dont_call_handle_close is 0 then the <functor> will be invoked.
+  /// Returns 1 if cancellation succeeded and 0 if the @a timer_id
+  /// wasn't found.
+  virtual int cancel (long timer_id,
+                      const void** act = 0,
+                      int dont_call_handle_close = 1);
+
+  /// Destroy timer queue. Cancels all timers.
+  virtual int close (void);
+
+  /// Returns a pointer to this ACE_Timer_Queue_T's iterator.
+  virtual ACE_Timer_Queue_Iterator_T<TYPE> & iter (void);
+
+  /// Removes the earliest node from the queue and returns it
+  virtual ACE_Timer_Node_T<TYPE>* remove_first (void);
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  /// Reads the earliest node from the queue and returns it.
+  virtual ACE_Timer_Node_T<TYPE>* get_first (void);
+
+  /// Returns the granularity of the wheel.
+  const ACE_Time_Value &tick (void) const;
+
+protected:
+  /// Schedules a timer.
+  virtual long schedule_i (const TYPE& type,
+                           const void* act,
+                           const ACE_Time_Value& future_time,
+                           const ACE_Time_Value& interval);
+
+  /// Reschedule an "interval" node.
+  virtual void reschedule (ACE_Timer_Node_T<TYPE> *);
+
+  /// Releases the timer id of the node along with the node.
+  virtual void free_node (ACE_Timer_Node_T<TYPE> *);
+
+  /// Lets the wheel advance up to @a current_time before dispatching.
+  virtual int dispatch_info_i (const ACE_Time_Value &current_time,
+                               ACE_Timer_Node_Dispatch_Info_T<TYPE> &info);
+
+private:
+  // The following are documented in the .cpp file.
+  void open_i (const ACE_Time_Value &tick, size_t prealloc);
+  ACE_UINT64 to_tick (const ACE_Time_Value &t) const;
+  ACE_Timer_Node_T<TYPE>* get_first_i (void);
+  ACE_Timer_Node_T<TYPE>* find_node (long timer_id) const;
+  void insert (ACE_Timer_Node_T<TYPE>* n);
+  void link (ACE_Timer_Node_T<TYPE>* n);
+  void unlink (ACE_Timer_Node_T<TYPE>* n);
+  void relink (ACE_Timer_Node_T<TYPE>* root);
+  ACE_Timer_Node_T<TYPE>* find_earliest (ACE_Timer_Node_T<TYPE>* root) const;
+  long pop_timer_id (void);
+  void push_timer_id (long timer_id);
+  int grow_timer_ids (size_t min_size);
+  static int next_slot (const ACE_UINT64 *occupied, u_int start);
+
+  /// Granularity of the wheel.
+  ACE_Time_Value tick_;
+
+  /// Granularity of the wheel in microseconds.
+  ACE_UINT64 tick_usec_;
+
+  /// The tick the wheel is at.  No timer is linked into a slot before
+  /// it, timers that are already due are linked into its level 0 slot.
+  ACE_UINT64 current_tick_;
+
+  /// The latest tick known to have passed.  The wheel never advances
+  /// beyond it, so that only timers that are due can be scheduled
+  /// before current_tick_.
+  ACE_UINT64 horizon_tick_;
+
+  /// The earliest node, or 0 if it has to be looked up.
+  ACE_Timer_Node_T<TYPE>* earliest_;
+
+  /// Dummy root nodes of the LEVELS * SLOTS slot lists, followed by
+  /// the one of the overflow list.
+  ACE_Timer_Node_T<TYPE>* roots_;
+
+  /// One bit per slot that isn't empty.
+  ACE_UINT64 occupied_[LEVELS][SLOTS / 64];
+
+  /// Scheduled nodes indexed by timer id.
+  ACE_Timer_Node_T<TYPE>** timer_ids_;
+
+  /// Size of the <timer_ids_> array.
+  size_t timer_ids_size_;
+
+  /// Circular queue of the unused timer ids.  Ids are reused oldest
+  /// first so that a stale id is less likely to cancel a new timer.
+  long* free_timer_ids_;
+
+  /// Index of the oldest unused timer id in <free_timer_ids_>.
+  size_t free_timer_ids_head_;
+
+  /// Number of unused timer ids.
+  size_t free_timer_ids_count_;
+
+  /// Iterator returned by iter().
+  Iterator* iterator_;
+
+  /// The total number of timers currently scheduled.
+  size_t timer_count_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Timer_Hierarchical_Wheel_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Timer_Hierarchical_Wheel_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_TIMER_HIERARCHICAL_WHEEL_T_H */
@@ -0,0 +1,376 @@
+#include "ace/Uring_Asynch_IO.h"
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+#include "ace/Uring_Proactor.h"
+#include "ace/Message_Block.h"
+#include "ace/Addr.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_socket.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Cancel all results in @a pending.  Returns 1 if there were none
+  /// (AIO_ALLDONE) and 0 otherwise (AIO_CANCELED).
+  int
+  cancel_pending (ACE_Uring_Proactor *proactor,
+                  ACE_Uring_Asynch_Pending_Ptr &pending)
+  {
+    // The results stay in the set until they are deleted, which is
+    // after they are dispatched, so none of them can be reused for
+    // a new operation while the lock is held.
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, pending->lock_, -1);
+
+    if (pending->results_.is_empty ())
+      return 1;
+
+    ACE_Unbounded_Set_Iterator<ACE_POSIX_Asynch_Result *>
+      iter (pending->results_);
+    for (ACE_POSIX_Asynch_Result **result = 0; iter.next (result); iter.advance ())
+      proactor->cancel_result (*result);
+
+    return 0;
+  }
+
+  /// Remove @a result from @a pending.
+  void
+  remove_pending (ACE_Uring_Asynch_Pending_Ptr &pending,
+                  ACE_POSIX_Asynch_Result *result)
+  {
+    ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, pending->lock_);
+    pending->results_.remove (result);
+  }
+}
+
+// *********************************************************************
+
+ACE_Uring_Asynch_Accept_Result::ACE_Uring_Asynch_Accept_Result
+  (const ACE_Handler::Proxy_Ptr &handler_proxy,
+   ACE_HANDLE listen_handle,
+   ACE_Message_Block &message_block,
+   size_t bytes_to_read,
+   const void* act,
+   int priority,
+   int signal_number,
+   const ACE_Uring_Asynch_Pending_Ptr &pending)
+  : ACE_POSIX_Asynch_Accept_Result (handler_proxy,
+                                    listen_handle,
+                                    ACE_INVALID_HANDLE,
+                                    message_block,
+                                    bytes_to_read,
+                                    act,
+                                    ACE_INVALID_HANDLE,
+                                    priority,
+                                    signal_number),
+    pending_ (pending)
+{
+}
+
+ACE_Uring_Asynch_Accept_Result::~ACE_Uring_Asynch_Accept_Result (void)
+{
+  remove_pending (this->pending_, this);
+}
+
+// *********************************************************************
+
+ACE_Uring_Asynch_Accept::ACE_Uring_Asynch_Accept (ACE_Uring_Proactor *uring_proactor)
+  : ACE_POSIX_Asynch_Operation (uring_proactor),
+    uring_proactor_ (uring_proactor),
+    pending_ (new ACE_Uring_Asynch_Pending)
+{
+}
+
+ACE_Uring_Asynch_Accept::~ACE_Uring_Asynch_Accept (void)
+{
+  this->close ();
+}
+
+int
+ACE_Uring_Asynch_Accept::open (const ACE_Handler::Proxy_Ptr &handler_proxy,
+                               ACE_HANDLE handle,
+                               const void *completion_key,
+                               ACE_Proactor *proactor)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Accept::open");
+
+  return ACE_POSIX_Asynch_Operation::open (handler_proxy,
+                                           handle,
+                                           completion_key,
+                                           proactor);
+}
+
+int
+ACE_Uring_Asynch_Accept::accept (ACE_Message_Block &message_block,
+                                 size_t bytes_to_read,
+                                 ACE_HANDLE,
+                                 const void *act,
+                                 int priority,
+                                 int signal_number,
+                                 int addr_family)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Accept::accept");
+
+  if (this->handle_ == ACE_INVALID_HANDLE)
+    ACELIB_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT ("%N:%l:ACE_Uring_Asynch_Accept::accept: ")
+                          ACE_TEXT ("acceptor was not opened before\n")),
+                         -1);
+
+  // Sanity check: make sure that enough space has been allocated by
+  // the caller.
+  size_t address_size = sizeof (sockaddr_in);
+#if defined (ACE_HAS_IPV6)
+  if (addr_family == AF_INET6)
+    address_size = sizeof (sockaddr_in6);
+#else
+  ACE_UNUSED_ARG (addr_family);
+#endif
+  if (message_block.space () < bytes_to_read + 2 * address_size)
+    {
+      ACE_OS::last_error (ENOBUFS);
+      return -1;
+    }
+
+  ACE_Uring_Asynch_Accept_Result *result = 0;
+  ACE_NEW_RETURN (result,
+                  ACE_Uring_Asynch_Accept_Result (this->handler_proxy_,
+                                                  this->handle_,
+                                                  message_block,
+                                                  bytes_to_read,
+                                                  act,
+                                                  priority,
+                                                  signal_number,
+                                                  this->pending_),
+                  -1);
+
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->pending_->lock_, -1);
+    if (this->pending_->results_.insert_tail (result) == -1)
+      {
+        delete result;
+        return -1;
+      }
+  }
+
+  int const return_val =
+    this->uring_proactor_->start_aio (result,
+                                      ACE_POSIX_Proactor::ACE_OPCODE_ACCEPT);
+  if (return_val == -1)
+    delete result;
+
+  return return_val;
+}
+
+int
+ACE_Uring_Asynch_Accept::cancel (void)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Accept::cancel");
+
+  return cancel_pending (this->uring_proactor_, this->pending_);
+}
+
+int
+ACE_Uring_Asynch_Accept::close (void)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Accept::close");
+
+  this->cancel ();
+  this->handle_ = ACE_INVALID_HANDLE;
+  return 0;
+}
+
+// *********************************************************************
+
+ACE_Uring_Asynch_Connect_Result::ACE_Uring_Asynch_Connect_Result
+  (const ACE_Handler::Proxy_Ptr &handler_proxy,
+   ACE_HANDLE connect_handle,
+   const void* act,
+   int priority,
+   int signal_number,
+   const ACE_Uring_Asynch_Pending_Ptr &pending)
+  : ACE_POSIX_Asynch_Connect_Result (handler_proxy,
+                                     connect_handle,
+                                     act,
+                                     ACE_INVALID_HANDLE,
+                                     priority,
+                                     signal_number),
+    pending_ (pending)
+{
+  ACE_OS::memset (&this->remote_addr_, 0, sizeof (this->remote_addr_));
+  this->aio_buf = &this->remote_addr_;
+}
+
+ACE_Uring_Asynch_Connect_Result::~ACE_Uring_Asynch_Connect_Result (void)
+{
+  remove_pending (this->pending_, this);
+}
+
+// *********************************************************************
+
+ACE_Uring_Asynch_Connect::ACE_Uring_Asynch_Connect (ACE_Uring_Proactor *uring_proactor)
+  : ACE_POSIX_Asynch_Operation (uring_proactor),
+    uring_proactor_ (uring_proactor),
+    pending_ (new ACE_Uring_Asynch_Pending)
+{
+}
+
+ACE_Uring_Asynch_Connect::~ACE_Uring_Asynch_Connect (void)
+{
+  this->close ();
+}
+
+int
+ACE_Uring_Asynch_Connect::open (const ACE_Handler::Proxy_Ptr &handler_proxy,
+                                ACE_HANDLE handle,
+                                const void *completion_key,
+                                ACE_Proactor *proactor)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Connect::open");
+
+  // Ignore the result, there is no handle yet.
+  ACE_POSIX_Asynch_Operation::open (handler_proxy,
+                                    handle,
+                                    completion_key,
+                                    proactor);
+  return 0;
+}
+
+int
+ACE_Uring_Asynch_Connect::connect (ACE_HANDLE connect_handle,
+                                   const ACE_Addr &remote_sap,
+                                   const ACE_Addr &local_sap,
+                                   int reuse_addr,
+                                   const void *act,
+                                   int priority,
+                                   int signal_number)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Connect::connect");
+
+  if (static_cast<size_t> (remote_sap.get_size ()) > sizeof (sockaddr_storage))
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ACE_Uring_Asynch_Connect_Result *result = 0;
+  ACE_NEW_RETURN (result,
+                  ACE_Uring_Asynch_Connect_Result (this->handler_proxy_,
+                                                   connect_handle,
+                                                   act,
+                                                   priority,
+                                                   signal_number,
+                                                   this->pending_),
+                  -1);
+
+  // Report failures to set up the handle through the handler, as
+  // ACE_POSIX_Asynch_Connect does.
+  if (this->prepare_i (result,
+                       local_sap,
+                       remote_sap.get_type (),
+                       reuse_addr) == -1)
+    return this->uring_proactor_->post_completion (result);
+
+  ACE_OS::memcpy (&result->remote_addr_,
+                  remote_sap.get_addr (),
+                  remote_sap.get_size ());
+  result->aio_nbytes = remote_sap.get_size ();
+
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->pending_->lock_, -1);
+    if (this->pending_->results_.insert_tail (result) == -1)
+      {
+        delete result;
+        return -1;
+      }
+  }
+
+  int const return_val =
+    this->uring_proactor_->start_aio (result,
+                                      ACE_POSIX_Proactor::ACE_OPCODE_CONNECT);
+  if (return_val == -1)
+    delete result;
+
+  return return_val;
+}
+
+int
+ACE_Uring_Asynch_Connect::prepare_i (ACE_Uring_Asynch_Connect_Result *result,
+                                     const ACE_Addr &local_sap,
+                                     int remote_type,
+                                     int reuse_addr)
+{
+  ACE_HANDLE handle = result->connect_handle ();
+
+  if (handle == ACE_INVALID_HANDLE)
+    {
+      handle = ACE_OS::socket (remote_type, SOCK_STREAM, 0);
+      result->connect_handle (handle);
+      if (handle == ACE_INVALID_HANDLE)
+        {
+          result->set_error (errno);
+          ACELIB_ERROR_RETURN
+            ((LM_ERROR,
+              ACE_TEXT ("ACE_Uring_Asynch_Connect::prepare_i: %p\n"),
+              ACE_TEXT ("socket")),
+             -1);
+        }
+
+      int one = 1;
+      if (remote_type != PF_UNIX
+          && reuse_addr != 0
+          && ACE_OS::setsockopt (handle,
+                                 SOL_SOCKET,
+                                 SO_REUSEADDR,
+                                 (const char*) &one,
+                                 sizeof one) == -1)
+        {
+          result->set_error (errno);
+          ACELIB_ERROR_RETURN
+            ((LM_ERROR,
+              ACE_TEXT ("ACE_Uring_Asynch_Connect::prepare_i: %p\n"),
+              ACE_TEXT ("setsockopt")),
+             -1);
+        }
+    }
+
+  if (local_sap != ACE_Addr::sap_any
+      && ACE_OS::bind (handle,
+                       reinterpret_cast<sockaddr *> (local_sap.get_addr ()),
+                       local_sap.get_size ()) == -1)
+    {
+      result->set_error (errno);
+      ACELIB_ERROR_RETURN
+        ((LM_ERROR,
+          ACE_TEXT ("ACE_Uring_Asynch_Connect::prepare_i: %p\n"),
+          ACE_TEXT ("bind")),
+         -1);
+    }
+
+  return 0;
+}
+
+int
+ACE_Uring_Asynch_Connect::cancel (void)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Connect::cancel");
+
+  return cancel_pending (this->uring_proactor_, this->pending_);
+}
+
+int
+ACE_Uring_Asynch_Connect::close (void)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Connect::close");
+
+  this->cancel ();
+  return 0;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
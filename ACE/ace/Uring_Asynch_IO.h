@@ -0,0 +1,233 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Uring_Asynch_IO.h
+ *
+ *  The asynchronous accept and connect operations of the
+ *  ACE_Uring_Proactor.  All other operations are the POSIX ones.
+ */
+//=============================================================================
+
+#ifndef ACE_URING_ASYNCH_IO_H
+#define ACE_URING_ASYNCH_IO_H
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+#include "ace/POSIX_Asynch_IO.h"
+#include "ace/Refcounted_Auto_Ptr.h"
+#include "ace/Unbounded_Set.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Uring_Proactor;
+
+/**
+ * @class ACE_Uring_Asynch_Pending
+ *
+ * @internal
+ *
+ * The results of an accept or connect operation that haven't been
+ * deleted yet.  Shared by the operation and its results, so that the
+ * operation can cancel them by result even after the handle they
+ * were started on is closed, and the results can outlive the
+ * operation.
+ */
+class ACE_Uring_Asynch_Pending
+{
+public:
+  /// Protects @c results_.
+  ACE_SYNCH_MUTEX lock_;
+
+  /// Results not deleted yet.
+  ACE_Unbounded_Set<ACE_POSIX_Asynch_Result *> results_;
+};
+
+typedef ACE_Refcounted_Auto_Ptr<ACE_Uring_Asynch_Pending, ACE_SYNCH_MUTEX>
+  ACE_Uring_Asynch_Pending_Ptr;
+
+/**
+ * @class ACE_Uring_Asynch_Accept_Result
+ *
+ * @brief The result of an @c IORING_OP_ACCEPT request.
+ */
+class ACE_Export ACE_Uring_Asynch_Accept_Result
+  : public ACE_POSIX_Asynch_Accept_Result
+{
+  /// Factory class will have special permissions.
+  friend class ACE_Uring_Asynch_Accept;
+
+protected:
+  ACE_Uring_Asynch_Accept_Result (const ACE_Handler::Proxy_Ptr &handler_proxy,
+                                  ACE_HANDLE listen_handle,
+                                  ACE_Message_Block &message_block,
+                                  size_t bytes_to_read,
+                                  const void* act,
+                                  int priority,
+                                  int signal_number,
+                                  const ACE_Uring_Asynch_Pending_Ptr &pending);
+
+  /// Destructor.  Removes the result from the pending results.
+  virtual ~ACE_Uring_Asynch_Accept_Result (void);
+
+private:
+  ACE_Uring_Asynch_Pending_Ptr pending_;
+};
+
+/**
+ * @class ACE_Uring_Asynch_Accept
+ *
+ * @brief Asynchronous accepts on the ring of an ACE_Uring_Proactor.
+ *
+ * Each accept() is an @c IORING_OP_ACCEPT request on the listen
+ * handle; several may be outstanding at a time.  As with the other
+ * POSIX Proactors no data is read with the new connection.  Unlike
+ * ACE_POSIX_Asynch_Accept, close() doesn't close the listen handle,
+ * which belongs to the caller.
+ */
+class ACE_Export ACE_Uring_Asynch_Accept
+  : public virtual ACE_Asynch_Accept_Impl,
+    public ACE_POSIX_Asynch_Operation
+{
+public:
+  /// Constructor.
+  ACE_Uring_Asynch_Accept (ACE_Uring_Proactor *uring_proactor);
+
+  /// Destructor.  Cancels the accepts still in flight.
+  virtual ~ACE_Uring_Asynch_Accept (void);
+
+  int open (const ACE_Handler::Proxy_Ptr &handler_proxy,
+            ACE_HANDLE handle,
+            const void *completion_key,
+            ACE_Proactor *proactor = 0);
+
+  /**
+   * Start an asynchronous accept.  As with ACE_POSIX_Asynch_Accept,
+   * @a accept_handle is ignored; the kernel creates the handle of the
+   * new connection.  @a message_block must have room for
+   * @a bytes_to_read bytes and two addresses of @a addr_family.
+   */
+  int accept (ACE_Message_Block &message_block,
+              size_t bytes_to_read,
+              ACE_HANDLE accept_handle,
+              const void *act,
+              int priority,
+              int signal_number = 0,
+              int addr_family = AF_INET);
+
+  /// Cancel the accepts in flight.  They complete with
+  /// @c ECANCELED.
+  int cancel (void);
+
+  /// Cancel the accepts in flight.
+  int close (void);
+
+private:
+  ACE_Uring_Proactor *uring_proactor_;
+
+  ACE_Uring_Asynch_Pending_Ptr pending_;
+};
+
+/**
+ * @class ACE_Uring_Asynch_Connect_Result
+ *
+ * @brief The result of an @c IORING_OP_CONNECT request.
+ *
+ * Holds the remote address until the kernel is done with it.
+ */
+class ACE_Export ACE_Uring_Asynch_Connect_Result
+  : public ACE_POSIX_Asynch_Connect_Result
+{
+  /// Factory class will have special permissions.
+  friend class ACE_Uring_Asynch_Connect;
+
+protected:
+  ACE_Uring_Asynch_Connect_Result (const ACE_Handler::Proxy_Ptr &handler_proxy,
+                                   ACE_HANDLE connect_handle,
+                                   const void* act,
+                                   int priority,
+                                   int signal_number,
+                                   const ACE_Uring_Asynch_Pending_Ptr &pending);
+
+  /// Destructor.  Removes the result from the pending results.
+  virtual ~ACE_Uring_Asynch_Connect_Result (void);
+
+private:
+  /// Remote address, pointed to by @c aio_buf.
+  sockaddr_storage remote_addr_;
+
+  ACE_Uring_Asynch_Pending_Ptr pending_;
+};
+
+/**
+ * @class ACE_Uring_Asynch_Connect
+ *
+ * @brief Asynchronous connects on the ring of an ACE_Uring_Proactor.
+ *
+ * The connect handle is created and bound as by
+ * ACE_POSIX_Asynch_Connect; the connect itself is an
+ * @c IORING_OP_CONNECT request.
+ */
+class ACE_Export ACE_Uring_Asynch_Connect
+  : public virtual ACE_Asynch_Connect_Impl,
+    public ACE_POSIX_Asynch_Operation
+{
+public:
+  /// Constructor.
+  ACE_Uring_Asynch_Connect (ACE_Uring_Proactor *uring_proactor);
+
+  /// Destructor.  Cancels the connects still in flight.
+  virtual ~ACE_Uring_Asynch_Connect (void);
+
+  int open (const ACE_Handler::Proxy_Ptr &handler_proxy,
+            ACE_HANDLE handle,
+            const void *completion_key,
+            ACE_Proactor *proactor = 0);
+
+  /**
+   * Start an asynchronous connect.
+   *
+   * @arg connect_handle   will be used for the connect call.  If
+   *                       ACE_INVALID_HANDLE is specified, a new
+   *                       handle will be created.
+   */
+  int connect (ACE_HANDLE connect_handle,
+               const ACE_Addr &remote_sap,
+               const ACE_Addr &local_sap,
+               int reuse_addr,
+               const void *act,
+               int priority,
+               int signal_number = 0);
+
+  /// Cancel the connects in flight.  They complete with
+  /// @c ECANCELED.
+  int cancel (void);
+
+  /// Cancel the connects in flight.
+  int close (void);
+
+private:
+  /// Create and bind the connect handle if needed.  Returns -1 and
+  /// sets the error of @a result on failure.
+  int prepare_i (ACE_Uring_Asynch_Connect_Result *result,
+                 const ACE_Addr &local_sap,
+                 int remote_type,
+                 int reuse_addr);
+
+  ACE_Uring_Proactor *uring_proactor_;
+
+  ACE_Uring_Asynch_Pending_Ptr pending_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
+#endif /* ACE_URING_ASYNCH_IO_H */
@@ -0,0 +1,609 @@
+#include "ace/Uring_Proactor.h"
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+#include "ace/Uring_Asynch_IO.h"
+#include "ace/ACE.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Countdown_Time.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+#include /**/ <linux/io_uring.h>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Tag of the user data of posted completions.  Results are at
+  /// least pointer aligned, so the low bit of their address is free.
+  const __u64 URING_POSTED_TAG = 1;
+
+  /// user_data of cancellation requests; their completions are
+  /// ignored.
+  const __u64 URING_CANCEL_TAG = 0;
+
+  /// Largest length a single read or write request can describe.
+  const size_t URING_MAX_LENGTH = 0x7ffff000;
+
+  /// Time close() waits for cancelled operations to complete.
+  const int URING_CLOSE_WAIT_MSEC = 5000;
+}
+
+ACE_Uring_Proactor::ACE_Uring_Proactor (unsigned int entries)
+  : ring_fd_ (ACE_INVALID_HANDLE),
+    waiting_ (0),
+    in_flight_ (0),
+    closing_ (false),
+    handle_state_ (0),
+    handle_state_size_ (0),
+    buffers_ (0),
+    buffer_count_ (0)
+{
+  this->ring_fd_ = this->ring_.open (entries);
+  if (this->ring_fd_ == ACE_INVALID_HANDLE)
+    {
+      ACELIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("%N:%l:(%P|%t)::%p\n"),
+                     ACE_TEXT ("ACE_Uring_Proactor: io_uring setup failed")));
+      return;
+    }
+
+  size_t const size = static_cast<size_t> (ACE::max_handles ());
+  ACE_NEW_NORETURN (this->handle_state_, Handle_State[size]);
+  if (this->handle_state_ == 0)
+    {
+      this->ring_.close ();
+      ACE_OS::close (this->ring_fd_);
+      this->ring_fd_ = ACE_INVALID_HANDLE;
+      return;
+    }
+  ACE_OS::memset (this->handle_state_, 0, size * sizeof (Handle_State));
+  this->handle_state_size_ = size;
+}
+
+ACE_Uring_Proactor::~ACE_Uring_Proactor (void)
+{
+  this->close ();
+}
+
+ACE_POSIX_Proactor::Proactor_Type
+ACE_Uring_Proactor::get_impl_type (void)
+{
+  return PROACTOR_URING;
+}
+
+int
+ACE_Uring_Proactor::close (void)
+{
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->ring_lock_, -1);
+
+    if (!this->ring_.is_open ())
+      return 0;
+
+    this->closing_ = true;
+
+#if defined (IORING_ASYNC_CANCEL_ANY)
+    if (this->in_flight_ > 0)
+      {
+        struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+        if (sqe != 0)
+          {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY | IORING_ASYNC_CANCEL_ALL;
+            sqe->user_data = URING_CANCEL_TAG;
+            this->ring_.commit_sqe ();
+          }
+      }
+#endif /* IORING_ASYNC_CANCEL_ANY */
+  }
+
+  // Wait for the cancelled operations and the posted completions and
+  // delete their results without dispatching them.  Event loop
+  // threads still running dispatch any completions they reap.
+  ACE_Time_Value const deadline =
+    ACE_OS::gettimeofday () + ACE_Time_Value (0, URING_CLOSE_WAIT_MSEC * 1000);
+  Completion completions[ACE_URING_PROACTOR_COMPLETION_BATCH];
+
+  for (;;)
+    {
+      int count = 0;
+      {
+        ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->ring_lock_, -1);
+
+        count = this->reap_i (completions, ACE_URING_PROACTOR_COMPLETION_BATCH);
+        if (count == 0)
+          {
+            if (this->in_flight_ == 0 || ACE_OS::gettimeofday () >= deadline)
+              break;
+
+            unsigned int const to_submit = this->ring_.pending ();
+            ace_mon.release ();
+            (void) this->ring_.wait (to_submit, 10);
+          }
+      }
+
+      for (int i = 0; i < count; ++i)
+        delete completions[i].result;
+    }
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->ring_lock_, -1);
+
+  if (this->in_flight_ > 0)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%N:%l:(%P|%t)::ACE_Uring_Proactor::close: ")
+                   ACE_TEXT ("%B operations did not complete\n"),
+                   this->in_flight_));
+
+  this->ring_.close ();
+  ACE_OS::close (this->ring_fd_);
+  this->ring_fd_ = ACE_INVALID_HANDLE;
+
+  delete [] this->handle_state_;
+  this->handle_state_ = 0;
+  this->handle_state_size_ = 0;
+
+  delete [] this->buffers_;
+  this->buffers_ = 0;
+  this->buffer_count_ = 0;
+
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::handle_events (ACE_Time_Value &wait_time)
+{
+  // Decrement <wait_time> with the amount of time spent in the method
+  ACE_Countdown_Time countdown (&wait_time);
+  return this->handle_events_i (static_cast<int> (wait_time.msec ()));
+}
+
+int
+ACE_Uring_Proactor::handle_events (void)
+{
+  return this->handle_events_i (-1);
+}
+
+int
+ACE_Uring_Proactor::handle_events_i (int milli_seconds)
+{
+  Completion completions[ACE_URING_PROACTOR_COMPLETION_BATCH];
+  int count = 0;
+
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->ring_lock_, -1);
+
+    if (!this->ring_.is_open ())
+      {
+        errno = ESHUTDOWN;
+        return -1;
+      }
+
+    // Completions already posted by the kernel cost no system call.
+    count = this->reap_i (completions, ACE_URING_PROACTOR_COMPLETION_BATCH);
+
+    while (count == 0)
+      {
+        // Submit the queued entries and wait in the same call.
+        unsigned int const to_submit = this->ring_.pending ();
+        ++this->waiting_;
+        ace_mon.release ();
+
+        int const result = this->ring_.wait (to_submit, milli_seconds);
+        int const error = errno;
+
+        ace_mon.acquire ();
+        --this->waiting_;
+
+        if (!this->ring_.is_open ())
+          {
+            errno = ESHUTDOWN;
+            return -1;
+          }
+
+        count = this->reap_i (completions, ACE_URING_PROACTOR_COMPLETION_BATCH);
+        if (count > 0)
+          break;
+
+        if (result == -1)
+          {
+            if (error == ETIME || error == EINTR)
+              return 0;
+            if (error != EBUSY && error != EAGAIN)
+              {
+                errno = error;
+                return -1;
+              }
+          }
+
+        // Only cancellation completions.  Bounded waits report a
+        // (spurious) timeout; unbounded waits go back to sleep.
+        if (milli_seconds >= 0)
+          return 0;
+      }
+
+    // Hand operations re-queued by reap_i() to the kernel.
+    if (this->ring_.pending () > 0)
+      this->ring_.submit ();
+  }
+
+  for (int i = 0; i < count; ++i)
+    this->application_specific_code (completions[i].result,
+                                      completions[i].bytes_transferred,
+                                      0, // No completion key.
+                                      completions[i].error);
+
+  return 1;
+}
+
+int
+ACE_Uring_Proactor::reap_i (Completion *completions, int max)
+{
+  int count = 0;
+  ACE_UINT64 user_data = 0;
+  ACE_INT32 res = 0;
+
+  while (count < max && this->ring_.next_cqe (user_data, res))
+    {
+      if (user_data == URING_CANCEL_TAG)
+        continue;
+
+      if ((user_data & URING_POSTED_TAG) != 0)
+        {
+          ACE_POSIX_Asynch_Result *result =
+            reinterpret_cast<ACE_POSIX_Asynch_Result *> (user_data
+                                                         & ~URING_POSTED_TAG);
+          --this->in_flight_;
+
+          Completion &completion = completions[count++];
+          completion.result = result;
+          completion.bytes_transferred = result->bytes_transferred ();
+          completion.error = result->error ();
+          continue;
+        }
+
+      ACE_POSIX_Asynch_Result *result =
+        reinterpret_cast<ACE_POSIX_Asynch_Result *> (user_data);
+      int const op = result->aio_lio_opcode;
+
+      Handle_State &state = this->handle_state_[this->state_handle_i (result)];
+      bool const cancelled = state.cancelled;
+      --this->in_flight_;
+      if (--state.pending == 0)
+        state.cancelled = false;
+
+      // The kernel cancels the requests submitted by a thread when the
+      // thread exits.  Nobody asked for that, so submit the request
+      // again.
+      if (res == -ECANCELED
+          && !cancelled
+          && !this->closing_
+          && this->queue_i (result) == 0)
+        continue;
+
+      Completion &completion = completions[count++];
+      completion.result = result;
+
+      if (res < 0)
+        {
+          completion.bytes_transferred = 0;
+          completion.error = static_cast<u_long> (-res);
+          if (op == ACE_OPCODE_ACCEPT)
+            result->aio_fildes = ACE_INVALID_HANDLE;
+        }
+      else
+        {
+          completion.error = 0;
+          if (op == ACE_OPCODE_ACCEPT)
+            {
+              result->aio_fildes = static_cast<ACE_HANDLE> (res);
+              completion.bytes_transferred = 0;
+            }
+          else if (op == ACE_OPCODE_CONNECT)
+            completion.bytes_transferred = 0;
+          else
+            completion.bytes_transferred = static_cast<size_t> (res);
+        }
+    }
+
+  return count;
+}
+
+ACE_HANDLE
+ACE_Uring_Proactor::state_handle_i (ACE_POSIX_Asynch_Result *result) const
+{
+  // Accept results carry the handle of the new connection, the
+  // requests are made on the listen handle.
+  if (result->aio_lio_opcode == ACE_OPCODE_ACCEPT)
+    return static_cast<ACE_POSIX_Asynch_Accept_Result *> (result)->listen_handle ();
+
+  return result->aio_fildes;
+}
+
+int
+ACE_Uring_Proactor::queue_i (ACE_POSIX_Asynch_Result *result)
+{
+  ACE_HANDLE const handle = this->state_handle_i (result);
+  if (handle < 0 || static_cast<size_t> (handle) >= this->handle_state_size_)
+    {
+      errno = EBADF;
+      return -1;
+    }
+
+  struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+  if (sqe == 0)
+    return -1;
+
+  switch (result->aio_lio_opcode)
+    {
+    case ACE_OPCODE_READ:
+    case ACE_OPCODE_WRITE:
+      {
+        bool const read = result->aio_lio_opcode == ACE_OPCODE_READ;
+        char *const buf = static_cast<char *> (const_cast<void *> (result->aio_buf));
+        size_t const len = result->aio_nbytes < URING_MAX_LENGTH
+          ? result->aio_nbytes
+          : URING_MAX_LENGTH;
+
+        sqe->opcode = read ? IORING_OP_READ : IORING_OP_WRITE;
+        sqe->fd = handle;
+        sqe->addr = reinterpret_cast<__u64> (buf);
+        sqe->len = static_cast<__u32> (len);
+        sqe->off = static_cast<__u64> (result->aio_offset);
+
+        for (unsigned int i = 0; i < this->buffer_count_; ++i)
+          {
+            char *const base = static_cast<char *> (this->buffers_[i].iov_base);
+            if (buf >= base && buf + len <= base + this->buffers_[i].iov_len)
+              {
+                sqe->opcode = read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+                sqe->buf_index = static_cast<__u16> (i);
+                break;
+              }
+          }
+      }
+      break;
+
+    case ACE_OPCODE_ACCEPT:
+      sqe->opcode = IORING_OP_ACCEPT;
+      sqe->fd = handle;
+      break;
+
+    case ACE_OPCODE_CONNECT:
+      // The address length goes where the offset of a read would.
+      sqe->opcode = IORING_OP_CONNECT;
+      sqe->fd = handle;
+      sqe->addr = reinterpret_cast<__u64> (result->aio_buf);
+      sqe->off = static_cast<__u64> (result->aio_nbytes);
+      break;
+    }
+
+  sqe->user_data = reinterpret_cast<__u64> (result);
+  this->ring_.commit_sqe ();
+
+  ++this->handle_state_[handle].pending;
+  ++this->in_flight_;
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::start_aio (ACE_POSIX_Asynch_Result *result,
+                               ACE_POSIX_Proactor::Opcode op)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::start_aio");
+
+  switch (op)
+    {
+    case ACE_OPCODE_READ:
+    case ACE_OPCODE_WRITE:
+    case ACE_OPCODE_ACCEPT:
+    case ACE_OPCODE_CONNECT:
+      break;
+
+    default:
+      ACELIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("%N:%l:(%P|%t)::")
+                            ACE_TEXT ("start_aio: Invalid op code %d\n"),
+                            op),
+                           -1);
+    }
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->ring_lock_, -1);
+
+  if (!this->ring_.is_open () || this->closing_)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  result->aio_lio_opcode = op;
+  if (this->queue_i (result) == -1)
+    return -1;
+
+  // Entries are normally handed to the kernel by the next wait for
+  // completions.  If a thread is already blocked waiting, it won't see
+  // them until it wakes up, so submit them now.
+  if (this->waiting_ > 0)
+    return this->ring_.submit ();
+
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::post_completion (ACE_POSIX_Asynch_Result *result)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->ring_lock_, -1);
+
+  if (!this->ring_.is_open ())
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+  if (sqe == 0)
+    return -1;
+
+  sqe->opcode = IORING_OP_NOP;
+  sqe->user_data = reinterpret_cast<__u64> (result) | URING_POSTED_TAG;
+  this->ring_.commit_sqe ();
+  ++this->in_flight_;
+
+  if (this->waiting_ > 0)
+    return this->ring_.submit ();
+
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::queue_cancel_i (ACE_POSIX_Asynch_Result *result,
+                                    ACE_HANDLE h)
+{
+  struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+  if (sqe == 0)
+    return -1;
+
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  if (result != 0)
+    {
+      sqe->fd = -1;
+      sqe->addr = reinterpret_cast<__u64> (result);
+    }
+  else
+    {
+#if defined (IORING_ASYNC_CANCEL_FD)
+      sqe->fd = h;
+      sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+#else
+      ACE_UNUSED_ARG (h);
+      errno = ENOTSUP;
+      return -1;
+#endif /* IORING_ASYNC_CANCEL_FD */
+    }
+  sqe->user_data = URING_CANCEL_TAG;
+  this->ring_.commit_sqe ();
+
+  this->handle_state_[h].cancelled = true;
+
+  // The request must reach the kernel while the operations it cancels
+  // can't complete and be reused: their results are only deleted
+  // after they are reaped, which needs the lock held here.
+  return this->ring_.submit ();
+}
+
+int
+ACE_Uring_Proactor::cancel_aio (ACE_HANDLE h)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::cancel_aio");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->ring_lock_, -1);
+
+  if (!this->ring_.is_open ()
+      || h < 0
+      || static_cast<size_t> (h) >= this->handle_state_size_
+      || this->handle_state_[h].pending == 0)
+    return 1;  // AIO_ALLDONE
+
+  return this->queue_cancel_i (0, h) == -1 ? -1 : 0;
+}
+
+int
+ACE_Uring_Proactor::cancel_result (ACE_POSIX_Asynch_Result *result)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::cancel_result");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->ring_lock_, -1);
+
+  ACE_HANDLE const h = this->state_handle_i (result);
+  if (!this->ring_.is_open ()
+      || h < 0
+      || static_cast<size_t> (h) >= this->handle_state_size_
+      || this->handle_state_[h].pending == 0)
+    return 1;  // AIO_ALLDONE
+
+  return this->queue_cancel_i (result, h) == -1 ? -1 : 0;
+}
+
+int
+ACE_Uring_Proactor::register_buffers (const iovec *iov, unsigned int count)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->ring_lock_, -1);
+
+  if (!this->ring_.is_open ())
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  if (this->buffer_count_ > 0)
+    {
+      this->ring_.unregister_buffers ();
+      delete [] this->buffers_;
+      this->buffers_ = 0;
+      this->buffer_count_ = 0;
+    }
+
+  iovec *buffers = 0;
+  ACE_NEW_RETURN (buffers, iovec[count], -1);
+  ACE_OS::memcpy (buffers, iov, count * sizeof (iovec));
+
+  if (this->ring_.register_buffers (buffers, count) == -1)
+    {
+      delete [] buffers;
+      return -1;
+    }
+
+  this->buffers_ = buffers;
+  this->buffer_count_ = count;
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::unregister_buffers (void)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->ring_lock_, -1);
+
+  if (this->buffer_count_ == 0)
+    return 0;
+
+  int const result = this->ring_.unregister_buffers ();
+  delete [] this->buffers_;
+  this->buffers_ = 0;
+  this->buffer_count_ = 0;
+  return result;
+}
+
+ACE_HANDLE
+ACE_Uring_Proactor::get_handle (void) const
+{
+  return this->ring_fd_;
+}
+
+ACE_Asynch_Accept_Impl *
+ACE_Uring_Proactor::create_asynch_accept (void)
+{
+  ACE_Asynch_Accept_Impl *implementation = 0;
+  ACE_NEW_RETURN (implementation,
+                  ACE_Uring_Asynch_Accept (this),
+                  0);
+  return implementation;
+}
+
+ACE_Asynch_Connect_Impl *
+ACE_Uring_Proactor::create_asynch_connect (void)
+{
+  ACE_Asynch_Connect_Impl *implementation = 0;
+  ACE_NEW_RETURN (implementation,
+                  ACE_Uring_Asynch_Connect (this),
+                  0);
+  return implementation;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
@@ -0,0 +1,228 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Uring_Proactor.h
+ *
+ *  Linux @c io_uring based Proactor implementation.
+ */
+//=============================================================================
+
+#ifndef ACE_URING_PROACTOR_H
+#define ACE_URING_PROACTOR_H
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+#include "ace/POSIX_Proactor.h"
+#include "ace/Uring_Ring.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Uring_Proactor
+ *
+ * @brief An @c io_uring based Proactor implementation.
+ *
+ * The ACE_Uring_Proactor runs the POSIX asynchronous operations on a
+ * Linux @c io_uring instance instead of the POSIX AIO library.  Each
+ * operation becomes one submission queue entry whose user data is the
+ * ACE_POSIX_Asynch_Result of the operation, and each completion is
+ * dispatched to the ACE_Handler of the operation exactly as the other
+ * POSIX Proactors do:
+ * - Stream, file and datagram reads and writes are @c IORING_OP_READ
+ *   and @c IORING_OP_WRITE requests, or their @c _FIXED variants if
+ *   the buffer lies in a buffer registered with register_buffers().
+ *   ACE_Asynch_Transmit_File is built on those reads and writes.
+ * - Accepts and connects are @c IORING_OP_ACCEPT and
+ *   @c IORING_OP_CONNECT requests (see ACE_Uring_Asynch_Accept and
+ *   ACE_Uring_Asynch_Connect), so unlike the other POSIX Proactors no
+ *   auxiliary reactor thread is involved.
+ * - Posted completions, including timer expiry and the wakeups of
+ *   ACE_Proactor::end_event_loop(), are @c IORING_OP_NOP requests.
+ *
+ * Entries are queued without entering the kernel and handed to it by
+ * the next handle_events() call, which waits for completions in the
+ * same @c io_uring_enter() call.  If a thread is already waiting for
+ * completions, entries are submitted right away instead.  There is no
+ * limit on the number of operations in flight other than the memory
+ * the kernel is willing to use.
+ *
+ * Any number of threads may run handle_events() at the same time.
+ * Each call reaps a batch of completions and dispatches them after
+ * releasing the ring, so the completion handlers may start new
+ * operations.
+ *
+ * @note Requires Linux 5.11 or later; cancellation of operations
+ *       by handle (ACE_Asynch_Operation::cancel()) requires Linux
+ *       5.19.  The constructor logs an error and get_handle() returns
+ *       ACE_INVALID_HANDLE if the ring can't be set up.
+ */
+class ACE_Export ACE_Uring_Proactor : public ACE_POSIX_Proactor
+{
+public:
+  /// Create a ring with @a entries submission queue entries.
+  ACE_Uring_Proactor (unsigned int entries = ACE_DEFAULT_URING_PROACTOR_ENTRIES);
+
+  /// Destructor.
+  virtual ~ACE_Uring_Proactor (void);
+
+  virtual Proactor_Type get_impl_type (void);
+
+  /// Cancel all operations in flight, delete their results without
+  /// dispatching them and close the ring.
+  virtual int close (void);
+
+  /**
+   * Dispatch a single set of events.  If @a wait_time elapses before
+   * any events occur, return 0.  Return 1 on success i.e., when a
+   * completion is dispatched, non-zero (-1) on errors and errno is
+   * set accordingly.
+   */
+  virtual int handle_events (ACE_Time_Value &wait_time);
+
+  /**
+   * Block indefinitely until at least one event is dispatched.
+   * Dispatch a single set of events.  Return 1 on success i.e., when a
+   * completion is dispatched, non-zero (-1) on errors and errno is
+   * set accordingly.
+   */
+  virtual int handle_events (void);
+
+  /// Post a result to the completion queue of the ring.
+  virtual int post_completion (ACE_POSIX_Asynch_Result *result);
+
+  /// Queue the operation @a op described by @a result.  The buffer,
+  /// length, offset and handle are taken from the @c aiocb part of
+  /// @a result.
+  virtual int start_aio (ACE_POSIX_Asynch_Result *result, Opcode op);
+
+  /**
+   * Cancel all operations in flight on @a h.  Returns 0 if the
+   * cancellation was requested, 1 if no operation was in flight and
+   * -1 on errors.  The cancelled operations complete with
+   * @c ECANCELED.
+   */
+  virtual int cancel_aio (ACE_HANDLE h);
+
+  /**
+   * Cancel the single operation in flight described by @a result.
+   * The result must not have been dispatched yet.  Used by the accept
+   * and connect operations, whose handles may already be closed.
+   */
+  int cancel_result (ACE_POSIX_Asynch_Result *result);
+
+  /**
+   * Register @a count buffers for use by reads and writes.  An
+   * operation whose buffer lies completely in one of the registered
+   * buffers is started as a fixed buffer operation, which saves the
+   * kernel pinning and mapping the user pages on every call.  Any
+   * previously registered buffers are unregistered first.
+   */
+  int register_buffers (const iovec *iov, unsigned int count);
+
+  /// Unregister the buffers registered with register_buffers().
+  int unregister_buffers (void);
+
+  /// The @c io_uring descriptor, or ACE_INVALID_HANDLE if the ring
+  /// couldn't be set up.
+  virtual ACE_HANDLE get_handle (void) const;
+
+  /// Create accept and connect operations that run on the ring.
+  virtual ACE_Asynch_Accept_Impl *create_asynch_accept (void);
+  virtual ACE_Asynch_Connect_Impl *create_asynch_connect (void);
+
+protected:
+  /**
+   * Dispatch a single set of events.  If @a milli_seconds elapses
+   * before any events occur, return 0.  A negative value waits
+   * without a time limit.  Return 1 if a completion is dispatched.
+   * Return -1 on errors.
+   */
+  int handle_events_i (int milli_seconds);
+
+private:
+  /**
+   * @struct Handle_State
+   *
+   * @internal
+   *
+   * Per-handle bookkeeping of the operations in flight.
+   */
+  struct Handle_State
+  {
+    /// Number of operations in flight.
+    ACE_UINT32 pending;
+
+    /// Was a cancellation requested since the handle was idle?
+    bool cancelled;
+  };
+
+  /**
+   * @struct Completion
+   *
+   * @internal
+   *
+   * A reaped completion waiting to be dispatched.
+   */
+  struct Completion
+  {
+    ACE_POSIX_Asynch_Result *result;
+    size_t bytes_transferred;
+    u_long error;
+  };
+
+  /// Queue a submission queue entry for @a result, which must carry
+  /// its operation code in @c aio_lio_opcode.
+  int queue_i (ACE_POSIX_Asynch_Result *result);
+
+  /// Queue a cancellation request and hand it to the kernel.
+  int queue_cancel_i (ACE_POSIX_Asynch_Result *result, ACE_HANDLE h);
+
+  /// Reap up to @a max completions into @a completions.  Returns the
+  /// number of completions stored.
+  int reap_i (Completion *completions, int max);
+
+  /// The handle whose state tracks @a result.
+  ACE_HANDLE state_handle_i (ACE_POSIX_Asynch_Result *result) const;
+
+  /// The submission and completion queues.
+  ACE_Uring_Ring ring_;
+
+  /// The ring descriptor.
+  ACE_HANDLE ring_fd_;
+
+  /// Protects the ring and the bookkeeping.
+  ACE_SYNCH_MUTEX ring_lock_;
+
+  /// Number of threads blocked in @c io_uring_enter().
+  int waiting_;
+
+  /// Number of requests in flight, including posted completions.
+  size_t in_flight_;
+
+  /// Set by close(); completions are no longer dispatched.
+  bool closing_;
+
+  /// Handle state, indexed by handle.
+  Handle_State *handle_state_;
+
+  /// Number of entries in @c handle_state_.
+  size_t handle_state_size_;
+
+  /// Copy of the buffers registered with register_buffers().
+  iovec *buffers_;
+
+  /// Number of entries in @c buffers_.
+  unsigned int buffer_count_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
+#endif /* ACE_URING_PROACTOR_H */
@@ -0,0 +1,392 @@
+#include "ace/Uring_Reactor.h"
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_EVENT_POLL)
+
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_Memory.h"
+#include "ace/ACE.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+
+#include /**/ <linux/io_uring.h>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Uring_Reactor)
+
+namespace
+{
+  /// user_data of poll removal requests; their completions are ignored.
+  const __u64 URING_REMOVE_TAG = ~static_cast<__u64> (0);
+
+  inline __u64
+  poll_user_data (ACE_HANDLE handle, ACE_UINT32 generation)
+  {
+    return (static_cast<__u64> (generation) << 32)
+      | static_cast<ACE_UINT32> (handle);
+  }
+}
+
+ACE_Uring_Reactor::ACE_Uring_Reactor (ACE_Sig_Handler *sh,
+                                      ACE_Timer_Queue *tq,
+                                      int disable_notify_pipe,
+                                      ACE_Reactor_Notify *notify,
+                                      int mask_signals,
+                                      int s_queue)
+  : ACE_Dev_Poll_Reactor (DEFERRED_OPEN, mask_signals, s_queue)
+  , entries_ (ACE_DEFAULT_URING_REACTOR_ENTRIES)
+  , waiting_ (false)
+  , poll_state_ (0)
+  , poll_state_size_ (0)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::ACE_Uring_Reactor");
+
+  if (this->open (ACE::max_handles (),
+                  0,
+                  sh,
+                  tq,
+                  disable_notify_pipe,
+                  notify) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%p\n"),
+                   ACE_TEXT ("ACE_Uring_Reactor::open ")
+                   ACE_TEXT ("failed inside ")
+                   ACE_TEXT ("ACE_Uring_Reactor::CTOR")));
+}
+
+ACE_Uring_Reactor::ACE_Uring_Reactor (size_t size,
+                                      bool rs,
+                                      ACE_Sig_Handler *sh,
+                                      ACE_Timer_Queue *tq,
+                                      int disable_notify_pipe,
+                                      ACE_Reactor_Notify *notify,
+                                      int mask_signals,
+                                      int s_queue,
+                                      unsigned int entries,
+                                      int event_batch)
+  : ACE_Dev_Poll_Reactor (DEFERRED_OPEN, mask_signals, s_queue, event_batch)
+  , entries_ (entries)
+  , waiting_ (false)
+  , poll_state_ (0)
+  , poll_state_size_ (0)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::ACE_Uring_Reactor");
+
+  if (this->open (size,
+                  rs,
+                  sh,
+                  tq,
+                  disable_notify_pipe,
+                  notify) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%p\n"),
+                   ACE_TEXT ("ACE_Uring_Reactor::open ")
+                   ACE_TEXT ("failed inside ACE_Uring_Reactor::CTOR")));
+}
+
+ACE_Uring_Reactor::~ACE_Uring_Reactor (void)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::~ACE_Uring_Reactor");
+
+  (void) this->close ();
+}
+
+int
+ACE_Uring_Reactor::close (void)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::close");
+
+  // The base class closes the ring descriptor and unbinds all
+  // handlers, which may still try to change the interest set.  Only
+  // release the mappings afterwards.
+  int const result = ACE_Dev_Poll_Reactor::close ();
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->ring_lock_, -1);
+  this->release_ring_i ();
+
+  return result;
+}
+
+void
+ACE_Uring_Reactor::release_ring_i (void)
+{
+  this->ring_.close ();
+
+  delete [] this->poll_state_;
+  this->poll_state_ = 0;
+  this->poll_state_size_ = 0;
+}
+
+ACE_HANDLE
+ACE_Uring_Reactor::poll_open_i (size_t size)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::poll_open_i");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->ring_lock_, ACE_INVALID_HANDLE);
+
+  // Re-opening after close() starts from scratch.
+  this->release_ring_i ();
+
+  ACE_HANDLE const fd = this->ring_.open (this->entries_);
+  if (fd == ACE_INVALID_HANDLE)
+    return ACE_INVALID_HANDLE;
+
+  ACE_NEW_NORETURN (this->poll_state_, Poll_State[size]);
+  if (this->poll_state_ == 0)
+    {
+      this->release_ring_i ();
+      ACE_OS::close (fd);
+      errno = ENOMEM;
+      return ACE_INVALID_HANDLE;
+    }
+  ACE_OS::memset (this->poll_state_, 0, size * sizeof (Poll_State));
+  this->poll_state_size_ = size;
+  this->waiting_ = false;
+
+  return fd;
+}
+
+int
+ACE_Uring_Reactor::queue_poll_add_i (ACE_HANDLE handle)
+{
+  Poll_State &state = this->poll_state_[handle];
+
+  struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+  if (sqe == 0)
+    return -1;
+
+  ++state.generation;
+
+  __u32 events = state.events;
+#if defined (ACE_BIG_ENDIAN)
+  // The kernel swaps the half words of poll32_events on big endian
+  // hosts to keep the 16-bit poll_events layout working.
+  events = (events << 16) | (events >> 16);
+#endif /* ACE_BIG_ENDIAN */
+
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = handle;
+  sqe->poll32_events = events;
+  sqe->user_data = poll_user_data (handle, state.generation);
+  this->ring_.commit_sqe ();
+
+  state.armed = true;
+  return 0;
+}
+
+int
+ACE_Uring_Reactor::queue_poll_remove_i (ACE_HANDLE handle)
+{
+  Poll_State &state = this->poll_state_[handle];
+
+  if (state.armed)
+    {
+      struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+      if (sqe == 0)
+        return -1;
+
+      sqe->opcode = IORING_OP_POLL_REMOVE;
+      sqe->fd = -1;
+      sqe->addr = poll_user_data (handle, state.generation);
+      sqe->user_data = URING_REMOVE_TAG;
+      this->ring_.commit_sqe ();
+    }
+
+  // Whether or not the removal finds the request, any completion
+  // still to come for it is stale from now on.
+  ++state.generation;
+  state.armed = false;
+  return 0;
+}
+
+int
+ACE_Uring_Reactor::poll_ctl_i (int op, ACE_HANDLE handle, __uint32_t events)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::poll_ctl_i");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->ring_lock_, -1);
+
+  if (!this->ring_.is_open ())
+    {
+      errno = EBADF;
+      return -1;
+    }
+
+  if (handle < 0 || static_cast<size_t> (handle) >= this->poll_state_size_)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  if (this->queue_poll_remove_i (handle) == -1)
+    return -1;
+
+  if (op != EPOLL_CTL_DEL)
+    {
+      Poll_State &state = this->poll_state_[handle];
+      state.persistent = ACE_BIT_DISABLED (events, EPOLLONESHOT);
+      state.events = events & ~static_cast<__uint32_t> (EPOLLONESHOT);
+
+      if (this->queue_poll_add_i (handle) == -1)
+        return -1;
+    }
+
+  // Changes are normally handed to the kernel by the next wait for
+  // events.  If a thread is already blocked waiting, it won't see them
+  // until it wakes up, so submit them now.
+  if (this->waiting_)
+    return this->ring_.submit ();
+
+  return 0;
+}
+
+int
+ACE_Uring_Reactor::reap_i (struct epoll_event *events, int max_events)
+{
+  int nevents = 0;
+  ACE_UINT64 user_data = 0;
+  ACE_INT32 res = 0;
+
+  while (nevents < max_events && this->ring_.next_cqe (user_data, res))
+    {
+      if (user_data == URING_REMOVE_TAG)
+        continue;
+
+      ACE_HANDLE const handle =
+        static_cast<ACE_HANDLE> (user_data & 0xffffffffU);
+      ACE_UINT32 const generation = static_cast<ACE_UINT32> (user_data >> 32);
+
+      if (handle < 0
+          || static_cast<size_t> (handle) >= this->poll_state_size_)
+        continue;
+
+      Poll_State &state = this->poll_state_[handle];
+      if (!state.armed || state.generation != generation)
+        continue;       // Removed or re-armed since; stale.
+
+      state.armed = false;
+
+      // The kernel cancels the requests submitted by a thread when the
+      // thread exits.  The handle is still registered, so submit the
+      // request again.
+      if (res == -ECANCELED)
+        {
+          (void) this->queue_poll_add_i (handle);
+          continue;
+        }
+
+      if (res < 0)
+        continue;       // The handle went away.
+
+      // Emulate a level-triggered registration by re-arming right
+      // away.  The request goes out with the next wait; if the handle
+      // is still ready it completes immediately.
+      if (state.persistent)
+        (void) this->queue_poll_add_i (handle);
+
+      events[nevents].data.fd = handle;
+      events[nevents].events = static_cast<__uint32_t> (res);
+      ++nevents;
+    }
+
+  return nevents;
+}
+
+int
+ACE_Uring_Reactor::poll_wait_i (struct epoll_event *events,
+                                int max_events,
+                                int timeout)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::poll_wait_i");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->ring_lock_, -1);
+
+  if (!this->ring_.is_open ())
+    {
+      errno = EBADF;
+      return -1;
+    }
+
+  // Events already posted by the kernel cost no system call at all.
+  int nevents = this->reap_i (events, max_events);
+  if (nevents > 0)
+    return nevents;
+
+  if (timeout == 0)
+    {
+      if (this->ring_.pending () == 0)
+        return 0;
+
+      int result = 0;
+      do
+        result = this->ring_.wait (this->ring_.pending (), 0);
+      while (result == -1 && errno == EINTR);
+
+      if (result == -1)
+        return -1;
+
+      return this->reap_i (events, max_events);
+    }
+
+  for (;;)
+    {
+      // Submit queued (re-)arm requests and wait in the same call.
+      unsigned int const to_submit = this->ring_.pending ();
+      this->waiting_ = true;
+      grd.release ();
+
+      int const result = this->ring_.wait (to_submit, timeout);
+      int const error = errno;
+
+      grd.acquire ();
+      this->waiting_ = false;
+
+      if (!this->ring_.is_open ())
+        {
+          errno = EBADF;
+          return -1;
+        }
+
+      nevents = this->reap_i (events, max_events);
+      if (nevents > 0)
+        return nevents;
+
+      if (result == -1)
+        {
+          if (error == ETIME)
+            return 0;
+          if (error != EBUSY && error != EAGAIN)
+            {
+              errno = error;
+              return -1;
+            }
+        }
+
+      // Only stale completions.  Bounded waits report a (spurious)
+      // timeout; unbounded waits go back to sleep.
+      if (timeout > 0)
+        return 0;
+    }
+}
+
+void
+ACE_Uring_Reactor::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Uring_Reactor::dump");
+
+  ACE_Dev_Poll_Reactor::dump ();
+
+  this->ring_.dump ();
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("waiting_ = %d"), this->waiting_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* ACE_HAS_IO_URING && ACE_HAS_EVENT_POLL */
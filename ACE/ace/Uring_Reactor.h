@@ -0,0 +1,192 @@
+// -*- C++ -*-
+
+// =========================================================================
+/**
+ *  @file    Uring_Reactor.h
+ *
+ *  Linux @c io_uring based Reactor implementation.
+ */
+// =========================================================================
+
+
+#ifndef ACE_URING_REACTOR_H
+#define ACE_URING_REACTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_EVENT_POLL)
+
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Uring_Ring.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Uring_Reactor
+ *
+ * @brief An @c io_uring based Reactor implementation.
+ *
+ * The ACE_Uring_Reactor is an ACE_Dev_Poll_Reactor whose interest set
+ * is a Linux @c io_uring instance instead of an epoll descriptor.
+ * Handle registration, the token based leader/follower dispatching,
+ * the automatic suspension of handlers around upcalls, notifications
+ * and timers all behave exactly as they do in the
+ * ACE_Dev_Poll_Reactor.
+ *
+ * Each registered handle has one @c IORING_OP_POLL_ADD request
+ * outstanding while it is not suspended.  Requests are one-shot, which
+ * gives the same auto-suspend semantics as @c EPOLLONESHOT; handles
+ * that are registered without one-shot semantics (the notification
+ * pipe) are re-armed as soon as their completion is reaped.
+ *
+ * The difference lies in the system call pattern:
+ * - Arming, re-arming and removing a handle only queue a submission
+ *   queue entry.  Queued entries are handed to the kernel by the
+ *   same @c io_uring_enter() call that waits for the next event, so
+ *   the @c epoll_ctl() call that resumes a handler after each upcall
+ *   goes away.  If a thread is currently blocked waiting for events,
+ *   changes are submitted immediately instead.
+ * - Every completion that is already in the completion queue is
+ *   dispatched without entering the kernel at all, whereas
+ *   @c epoll_wait() is called once per event by the
+ *   ACE_Dev_Poll_Reactor.
+ *
+ * @note The ACE_Uring_Reactor is a Reactor: handlers are notified of
+ *       readiness and perform their own I/O.  Use a Proactor to have
+ *       the reads and writes themselves submitted to the kernel.
+ *
+ * @note Requires Linux 5.11 or later (@c IORING_FEAT_EXT_ARG is used
+ *       for wait timeouts).  open() fails with @c ENOTSUP on older
+ *       kernels.
+ */
+class ACE_Export ACE_Uring_Reactor : public ACE_Dev_Poll_Reactor
+{
+public:
+  /// Initialize ACE_Uring_Reactor with the default size.
+  /**
+   * The default size for the ACE_Uring_Reactor is the maximum
+   * number of open file descriptors for the process.
+   */
+  ACE_Uring_Reactor (ACE_Sig_Handler * = 0,
+                     ACE_Timer_Queue * = 0,
+                     int disable_notify_pipe = 0,
+                     ACE_Reactor_Notify *notify = 0,
+                     int mask_signals = 1,
+                     int s_queue = ACE_DEV_POLL_TOKEN::FIFO);
+
+  /// Initialize ACE_Uring_Reactor with size @a size.
+  /**
+   * @a size has the same meaning as for the ACE_Dev_Poll_Reactor.
+   * @a entries is the number of submission queue entries of the ring;
+   * the completion queue is sized by the kernel to twice that.
+   * @a event_batch is the maximum number of completions reaped into
+   * the ready list at a time, see ACE_Dev_Poll_Reactor.
+   */
+  ACE_Uring_Reactor (size_t size,
+                     bool restart = false,
+                     ACE_Sig_Handler * = 0,
+                     ACE_Timer_Queue * = 0,
+                     int disable_notify_pipe = 0,
+                     ACE_Reactor_Notify *notify = 0,
+                     int mask_signals = 1,
+                     int s_queue = ACE_DEV_POLL_TOKEN::FIFO,
+                     unsigned int entries = ACE_DEFAULT_URING_REACTOR_ENTRIES,
+                     int event_batch = ACE_DEFAULT_DEV_POLL_EVENT_BATCH);
+
+  /// Close down and release all resources.
+  virtual ~ACE_Uring_Reactor (void);
+
+  /// Close down and release all resources, including the ring.
+  virtual int close (void);
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Create the ring and the per-handle poll state.
+  virtual ACE_HANDLE poll_open_i (size_t size);
+
+  /// Queue the poll requests equivalent to the given @c epoll_ctl()
+  /// operation.
+  virtual int poll_ctl_i (int op, ACE_HANDLE handle, __uint32_t events);
+
+  /// Reap up to @a max_events poll completions into @a events,
+  /// submitting queued requests and waiting for completions as needed.
+  virtual int poll_wait_i (struct epoll_event *events,
+                           int max_events,
+                           int timeout);
+
+private:
+  /**
+   * @struct Poll_State
+   *
+   * @internal
+   *
+   * Per-handle bookkeeping of the outstanding poll request.
+   */
+  struct Poll_State
+  {
+    /// Generation of the current poll request, part of its user_data.
+    /// Completions of earlier generations are discarded.
+    ACE_UINT32 generation;
+
+    /// poll() events the handle is armed for.
+    __uint32_t events;
+
+    /// Is a poll request outstanding in the kernel?
+    bool armed;
+
+    /// Re-arm automatically after each completion (no one-shot).
+    bool persistent;
+  };
+
+  /// Queue a poll request for @a handle using its current state.
+  int queue_poll_add_i (ACE_HANDLE handle);
+
+  /// Queue the removal of the outstanding poll request of @a handle.
+  int queue_poll_remove_i (ACE_HANDLE handle);
+
+  /// Reap completions until @a max_events ready events are stored in
+  /// @a events or the completion queue is empty.  Returns the number
+  /// of events stored.
+  int reap_i (struct epoll_event *events, int max_events);
+
+  /// Unmap the rings and release the poll state.
+  void release_ring_i (void);
+
+  /// Number of submission queue entries requested at open time.
+  unsigned int entries_;
+
+  /// Protects the ring and the poll state.  Held by the waiter while
+  /// reaping and by any thread changing the interest set.
+  ACE_SYNCH_MUTEX ring_lock_;
+
+  /// True while a thread is blocked in @c io_uring_enter().
+  bool waiting_;
+
+  /// Poll state, indexed by handle.
+  Poll_State *poll_state_;
+
+  /// Number of entries in @c poll_state_.
+  size_t poll_state_size_;
+
+  /// The submission and completion queues.
+  ACE_Uring_Ring ring_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* ACE_HAS_IO_URING && ACE_HAS_EVENT_POLL */
+
+#include /**/ "ace/post.h"
+
+#endif  /* ACE_URING_REACTOR_H */
@@ -0,0 +1,313 @@
+#include "ace/Uring_Ring.h"
+
+#if defined (ACE_HAS_IO_URING)
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Uring_Ring.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_mman.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Log_Category.h"
+
+#include /**/ <sys/syscall.h>
+#include /**/ <linux/io_uring.h>
+#include /**/ <linux/time_types.h>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  inline int
+  io_uring_setup (unsigned int entries, struct io_uring_params *p)
+  {
+    return static_cast<int> (::syscall (__NR_io_uring_setup, entries, p));
+  }
+
+  inline int
+  io_uring_enter (int fd,
+                  unsigned int to_submit,
+                  unsigned int min_complete,
+                  unsigned int flags,
+                  void *arg,
+                  size_t argsz)
+  {
+    return static_cast<int> (::syscall (__NR_io_uring_enter,
+                                        fd,
+                                        to_submit,
+                                        min_complete,
+                                        flags,
+                                        arg,
+                                        argsz));
+  }
+
+  inline int
+  io_uring_register (int fd,
+                     unsigned int opcode,
+                     const void *arg,
+                     unsigned int nr_args)
+  {
+    return static_cast<int> (::syscall (__NR_io_uring_register,
+                                        fd,
+                                        opcode,
+                                        arg,
+                                        nr_args));
+  }
+}
+
+ACE_Uring_Ring::ACE_Uring_Ring (void)
+  : fd_ (ACE_INVALID_HANDLE)
+  , sq_ring_ (MAP_FAILED)
+  , sq_ring_size_ (0)
+  , sq_head_ (0)
+  , sq_tail_ (0)
+  , sq_mask_ (0)
+  , sq_array_ (0)
+  , sq_entries_ (0)
+  , sqes_ (0)
+  , sqes_size_ (0)
+  , cq_ring_ (MAP_FAILED)
+  , cq_ring_size_ (0)
+  , cq_head_ (0)
+  , cq_tail_ (0)
+  , cq_mask_ (0)
+  , cqes_ (0)
+{
+}
+
+ACE_Uring_Ring::~ACE_Uring_Ring (void)
+{
+  this->close ();
+}
+
+void
+ACE_Uring_Ring::close (void)
+{
+  if (this->sqes_ != 0)
+    {
+      (void) ACE_OS::munmap (this->sqes_, this->sqes_size_);
+      this->sqes_ = 0;
+    }
+
+  if (this->cq_ring_ != MAP_FAILED && this->cq_ring_ != this->sq_ring_)
+    (void) ACE_OS::munmap (this->cq_ring_, this->cq_ring_size_);
+  this->cq_ring_ = MAP_FAILED;
+
+  if (this->sq_ring_ != MAP_FAILED)
+    (void) ACE_OS::munmap (this->sq_ring_, this->sq_ring_size_);
+  this->sq_ring_ = MAP_FAILED;
+
+  this->sq_head_ = this->sq_tail_ = this->sq_mask_ = this->sq_array_ = 0;
+  this->cq_head_ = this->cq_tail_ = this->cq_mask_ = 0;
+  this->cqes_ = 0;
+  this->sq_entries_ = 0;
+  this->fd_ = ACE_INVALID_HANDLE;
+}
+
+ACE_HANDLE
+ACE_Uring_Ring::open (unsigned int entries)
+{
+  // Re-opening starts from scratch.
+  this->close ();
+
+  struct io_uring_params params;
+  ACE_OS::memset (&params, 0, sizeof (params));
+
+  int const fd = io_uring_setup (entries, &params);
+  if (fd == -1)
+    return ACE_INVALID_HANDLE;
+
+  // Without IORING_FEAT_EXT_ARG there is no way to bound a wait for
+  // completions other than queueing timeout requests.
+  if (ACE_BIT_DISABLED (params.features, IORING_FEAT_EXT_ARG))
+    {
+      ACE_OS::close (fd);
+      errno = ENOTSUP;
+      return ACE_INVALID_HANDLE;
+    }
+
+  this->sq_ring_size_ =
+    params.sq_off.array + params.sq_entries * sizeof (unsigned int);
+  this->cq_ring_size_ =
+    params.cq_off.cqes + params.cq_entries * sizeof (struct io_uring_cqe);
+
+  bool const single_mmap =
+    ACE_BIT_ENABLED (params.features, IORING_FEAT_SINGLE_MMAP);
+  if (single_mmap)
+    {
+      if (this->cq_ring_size_ > this->sq_ring_size_)
+        this->sq_ring_size_ = this->cq_ring_size_;
+      this->cq_ring_size_ = this->sq_ring_size_;
+    }
+
+  this->sq_ring_ = ACE_OS::mmap (0,
+                                 this->sq_ring_size_,
+                                 PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE,
+                                 fd,
+                                 IORING_OFF_SQ_RING);
+  if (this->sq_ring_ == MAP_FAILED)
+    {
+      ACE_OS::close (fd);
+      return ACE_INVALID_HANDLE;
+    }
+
+  if (single_mmap)
+    this->cq_ring_ = this->sq_ring_;
+  else
+    {
+      this->cq_ring_ = ACE_OS::mmap (0,
+                                     this->cq_ring_size_,
+                                     PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE,
+                                     fd,
+                                     IORING_OFF_CQ_RING);
+      if (this->cq_ring_ == MAP_FAILED)
+        {
+          this->close ();
+          ACE_OS::close (fd);
+          return ACE_INVALID_HANDLE;
+        }
+    }
+
+  this->sqes_size_ = params.sq_entries * sizeof (struct io_uring_sqe);
+  void *sqes = ACE_OS::mmap (0,
+                             this->sqes_size_,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE,
+                             fd,
+                             IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+    {
+      this->close ();
+      ACE_OS::close (fd);
+      return ACE_INVALID_HANDLE;
+    }
+  this->sqes_ = static_cast<struct io_uring_sqe *> (sqes);
+
+  char *sq = static_cast<char *> (this->sq_ring_);
+  this->sq_head_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.head);
+  this->sq_tail_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.tail);
+  this->sq_mask_ =
+    reinterpret_cast<unsigned int *> (sq + params.sq_off.ring_mask);
+  this->sq_array_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.array);
+  this->sq_entries_ = params.sq_entries;
+
+  char *cq = static_cast<char *> (this->cq_ring_);
+  this->cq_head_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.head);
+  this->cq_tail_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.tail);
+  this->cq_mask_ =
+    reinterpret_cast<unsigned int *> (cq + params.cq_off.ring_mask);
+  this->cqes_ =
+    reinterpret_cast<struct io_uring_cqe *> (cq + params.cq_off.cqes);
+
+  this->fd_ = fd;
+  return fd;
+}
+
+struct io_uring_sqe *
+ACE_Uring_Ring::get_sqe (void)
+{
+  if (this->pending () == this->sq_entries_
+      && (this->submit () == -1 || this->pending () == this->sq_entries_))
+    {
+      errno = EAGAIN;
+      return 0;
+    }
+
+  unsigned int const index = *this->sq_tail_ & *this->sq_mask_;
+  struct io_uring_sqe *sqe = &this->sqes_[index];
+  ACE_OS::memset (sqe, 0, sizeof (*sqe));
+  this->sq_array_[index] = index;
+
+  return sqe;
+}
+
+int
+ACE_Uring_Ring::submit (void)
+{
+  unsigned int const to_submit = this->pending ();
+  if (to_submit == 0)
+    return 0;
+
+  int result = 0;
+  do
+    result = io_uring_enter (this->fd_, to_submit, 0, 0, 0, 0);
+  while (result == -1 && errno == EINTR);
+
+  return result == -1 ? -1 : 0;
+}
+
+int
+ACE_Uring_Ring::wait (unsigned int to_submit, int timeout)
+{
+  if (timeout == 0)
+    return io_uring_enter (this->fd_,
+                           to_submit,
+                           0,
+                           IORING_ENTER_GETEVENTS,
+                           0,
+                           0);
+
+  struct __kernel_timespec ts;
+  struct io_uring_getevents_arg arg;
+  ACE_OS::memset (&arg, 0, sizeof (arg));
+  if (timeout > 0)
+    {
+      ts.tv_sec = timeout / 1000;
+      ts.tv_nsec = (timeout % 1000) * 1000000L;
+      arg.ts = reinterpret_cast<__u64> (&ts);
+    }
+
+  return io_uring_enter (this->fd_,
+                         to_submit,
+                         1,
+                         IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                         &arg,
+                         sizeof (arg));
+}
+
+bool
+ACE_Uring_Ring::next_cqe (ACE_UINT64 &user_data, ACE_INT32 &res)
+{
+  unsigned int const head = *this->cq_head_;
+  if (head == __atomic_load_n (this->cq_tail_, __ATOMIC_ACQUIRE))
+    return false;
+
+  struct io_uring_cqe const &cqe = this->cqes_[head & *this->cq_mask_];
+  user_data = cqe.user_data;
+  res = cqe.res;
+
+  // Hand the entry back to the kernel only after it has been read.
+  __atomic_store_n (this->cq_head_, head + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+int
+ACE_Uring_Ring::register_buffers (const struct iovec *iov, unsigned int count)
+{
+  return io_uring_register (this->fd_, IORING_REGISTER_BUFFERS, iov, count);
+}
+
+int
+ACE_Uring_Ring::unregister_buffers (void)
+{
+  return io_uring_register (this->fd_, IORING_UNREGISTER_BUFFERS, 0, 0);
+}
+
+void
+ACE_Uring_Ring::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("fd_ = %d"), this->fd_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nsq_entries_ = %u"), this->sq_entries_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* ACE_HAS_IO_URING */
@@ -0,0 +1,172 @@
+// -*- C++ -*-
+
+// =========================================================================
+/**
+ *  @file    Uring_Ring.h
+ *
+ *  Submission and completion queue rings of a Linux @c io_uring
+ *  instance.
+ */
+// =========================================================================
+
+
+#ifndef ACE_URING_RING_H
+#define ACE_URING_RING_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_IO_URING)
+
+#include "ace/os_include/os_stddef.h"
+#include "ace/os_include/sys/os_types.h"
+#include "ace/Basic_Types.h"
+#include "ace/Global_Macros.h"
+#include "ace/os_include/sys/os_uio.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Uring_Ring
+ *
+ * @brief The memory mapped rings of an @c io_uring instance.
+ *
+ * Sets up an @c io_uring instance and maps its submission and
+ * completion queues into the process.  Entries are queued with
+ * get_sqe() and commit_sqe() and handed to the kernel with submit()
+ * or wait(); completions are consumed with next_cqe().
+ *
+ * The ring does not serialize access: all methods except wait()
+ * must be called with a lock held by the owner.  wait() is meant to
+ * be called after releasing that lock, so that other threads can
+ * keep queueing entries while one thread sleeps in the kernel;
+ * commit_sqe() publishes entries with release semantics, so such a
+ * thread sees either the whole entry or none of it.
+ *
+ * The ring descriptor returned by open() belongs to the caller and
+ * must stay open as long as the ring is used; close() only unmaps the
+ * rings.
+ *
+ * @note Requires @c IORING_FEAT_EXT_ARG (Linux 5.11), which is the
+ *       only way to bound a wait for completions without queueing
+ *       timeout requests.  open() fails with @c ENOTSUP on older
+ *       kernels.
+ */
+class ACE_Export ACE_Uring_Ring
+{
+public:
+  /// Initialize an unopened ring.
+  ACE_Uring_Ring (void);
+
+  /// Unmap the rings.
+  ~ACE_Uring_Ring (void);
+
+  /// Set up an @c io_uring instance with @a entries submission queue
+  /// entries and map its rings.  Returns the ring descriptor, or
+  /// ACE_INVALID_HANDLE with errno set on failure.
+  ACE_HANDLE open (unsigned int entries);
+
+  /// Unmap the rings.  The ring descriptor is not closed.
+  void close (void);
+
+  /// True if the rings are mapped.
+  bool is_open (void) const;
+
+  /// Get a free submission queue entry, cleared to zero.  If the
+  /// queue is full, the queued entries are submitted first.  Returns
+  /// 0 with errno set to @c EAGAIN if no entry is available.
+  struct io_uring_sqe *get_sqe (void);
+
+  /// Make the entry returned by get_sqe() visible to the kernel.
+  void commit_sqe (void);
+
+  /// Number of queued entries the kernel hasn't consumed yet.
+  unsigned int pending (void) const;
+
+  /// Hand all queued entries to the kernel without waiting.
+  int submit (void);
+
+  /**
+   * Submit @a to_submit queued entries, as returned by pending()
+   * while the lock was held, and wait for a completion.  @a timeout
+   * is in milliseconds; a negative value waits without a time limit
+   * and 0 doesn't wait at all.  Returns -1 with errno set to @c ETIME
+   * if the time ran out, and -1 with errno set to @c EINTR if a
+   * signal interrupted the wait.
+   */
+  int wait (unsigned int to_submit, int timeout);
+
+  /**
+   * Consume the next completion.  Returns false if the completion
+   * queue is empty, otherwise stores the user data and the result of
+   * the completion in @a user_data and @a res.
+   */
+  bool next_cqe (ACE_UINT64 &user_data, ACE_INT32 &res);
+
+  /// True if a completion is waiting in the completion queue.
+  bool has_cqe (void) const;
+
+  /// Register @a count buffers described by @a iov for fixed buffer
+  /// reads and writes.  Returns -1 with errno set on failure.
+  int register_buffers (const struct iovec *iov, unsigned int count);
+
+  /// Unregister the buffers registered with register_buffers().
+  int unregister_buffers (void);
+
+  /// Number of submission queue entries of the ring.
+  unsigned int sq_entries (void) const;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+private:
+  /// The ring descriptor.  Not owned.
+  ACE_HANDLE fd_;
+
+  /// @name Submission queue ring
+  //@{
+  void *sq_ring_;
+  size_t sq_ring_size_;
+  unsigned int *sq_head_;
+  unsigned int *sq_tail_;
+  unsigned int *sq_mask_;
+  unsigned int *sq_array_;
+  unsigned int sq_entries_;
+  struct io_uring_sqe *sqes_;
+  size_t sqes_size_;
+  //@}
+
+  /// @name Completion queue ring
+  //@{
+  void *cq_ring_;
+  size_t cq_ring_size_;
+  unsigned int *cq_head_;
+  unsigned int *cq_tail_;
+  unsigned int *cq_mask_;
+  struct io_uring_cqe *cqes_;
+  //@}
+
+private:
+  ACE_UNIMPLEMENTED_FUNC (ACE_Uring_Ring (const ACE_Uring_Ring &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Uring_Ring &operator= (const ACE_Uring_Ring &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Uring_Ring.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif  /* ACE_HAS_IO_URING */
+
+#include /**/ "ace/post.h"
+
+#endif  /* ACE_URING_RING_H */
@@ -0,0 +1,37 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE bool
+ACE_Uring_Ring::is_open (void) const
+{
+  return this->sqes_ != 0;
+}
+
+ACE_INLINE void
+ACE_Uring_Ring::commit_sqe (void)
+{
+  // A thread waiting for completions enters the kernel without the
+  // owner's lock, so the entry must be complete before the tail moves
+  // past it.
+  __atomic_store_n (this->sq_tail_, *this->sq_tail_ + 1, __ATOMIC_RELEASE);
+}
+
+ACE_INLINE unsigned int
+ACE_Uring_Ring::pending (void) const
+{
+  return *this->sq_tail_ - __atomic_load_n (this->sq_head_, __ATOMIC_ACQUIRE);
+}
+
+ACE_INLINE bool
+ACE_Uring_Ring::has_cqe (void) const
+{
+  return *this->cq_head_ != __atomic_load_n (this->cq_tail_, __ATOMIC_ACQUIRE);
+}
+
+ACE_INLINE unsigned int
+ACE_Uring_Ring::sq_entries (void) const
+{
+  return this->sq_entries_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -248,6 +248,88 @@
 #  endif
 #endif
 
+// eventfd() with flags, used by the ACE_Dev_Poll_Reactor_Eventfd_Notify.
+#if !defined (ACE_HAS_EVENTFD) && !defined (ACE_LACKS_EVENTFD)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (2,6,27))
+#    define ACE_HAS_EVENTFD
+#  endif
+#endif
+
+// timerfd with flags, used by ACE_Dev_Poll_Reactor::use_timer_fd().
+#if !defined (ACE_HAS_TIMERFD) && !defined (ACE_LACKS_TIMERFD)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (2,6,27))
+#    define ACE_HAS_TIMERFD
+#  endif
+#endif
+
+// io_uring with IORING_FEAT_EXT_ARG, used by the ACE_Uring_Reactor.
+#if !defined (ACE_HAS_IO_URING) && !defined (ACE_LACKS_IO_URING)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (5,11,0))
+#    define ACE_HAS_IO_URING
+#  endif
+#endif
+
+// accept4() with flags, used by ACE_SOCK_Acceptor::accept_flags().
+#if !defined (ACE_HAS_ACCEPT4) && !defined (ACE_LACKS_ACCEPT4)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (2,6,28))
+#    define ACE_HAS_ACCEPT4
+#  endif
+#endif
+
+// recvmmsg() and sendmmsg(), used by ACE_SOCK_Dgram to move a batch of
+// datagrams per system call.
+#if !defined (ACE_HAS_RECVMMSG) && !defined (ACE_LACKS_RECVMMSG)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (2,6,33)) && defined (__GLIBC__) \
+      && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 12))
+#    define ACE_HAS_RECVMMSG
+#  endif
+#endif
+#if !defined (ACE_HAS_SENDMMSG) && !defined (ACE_LACKS_SENDMMSG)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (3,0,0)) && defined (__GLIBC__) \
+      && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14))
+#    define ACE_HAS_SENDMMSG
+#  endif
+#endif
+
+// UDP_SEGMENT and UDP_GRO, used by ACE_SOCK_Dgram to send and receive a
+// run of equally sized datagrams as one buffer.
+#if !defined (ACE_HAS_UDP_SEGMENT) && !defined (ACE_LACKS_UDP_SEGMENT)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (4,18,0)) && defined (__GLIBC__) \
+      && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#    define ACE_HAS_UDP_SEGMENT
+#  endif
+#endif
+#if !defined (ACE_HAS_UDP_GRO) && !defined (ACE_LACKS_UDP_GRO)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (5,0,0)) && defined (__GLIBC__) \
+      && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#    define ACE_HAS_UDP_GRO
+#  endif
+#endif
+
+// SO_ZEROCOPY and MSG_ZEROCOPY, used by ACE_SOCK_Zerocopy.
+#if !defined (ACE_HAS_MSG_ZEROCOPY) && !defined (ACE_LACKS_MSG_ZEROCOPY)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (4,14,0)) && defined (__GLIBC__) \
+      && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+#    define ACE_HAS_MSG_ZEROCOPY
+#  endif
+#endif
+
+// Process shared futexes, used by the ACE_Ring_MEM_IO strategy of
+// ACE_MEM_Stream.
+#if !defined (ACE_HAS_FUTEX) && !defined (ACE_LACKS_FUTEX)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (2,6,0))
+#    define ACE_HAS_FUTEX
+#  endif
+#endif
+
+// mbind(), used by the memory pools to place their memory on a NUMA
+// node.
+#if !defined (ACE_HAS_MBIND) && !defined (ACE_LACKS_MBIND)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (2,6,7))
+#    define ACE_HAS_MBIND
+#  endif
+#endif
+
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION (2,4,11))
 #  define ACE_HAS_GETTID // See ACE_OS::thr_gettid()
 #endif
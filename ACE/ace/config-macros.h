@@ -129,6 +129,41 @@
 #   define ACE_LACKS_POSIX_DEVCTL
 # endif
 
+// SSE2 is available whenever the compiler targets it, which is always
+// the case on x86-64.  Define ACE_LACKS_SSE2 to use the portable code
+// paths instead.
+# if !defined (ACE_HAS_SSE2) && !defined (ACE_LACKS_SSE2)
+#   if defined (__SSE2__) || defined (_M_X64) || \
+       (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#     define ACE_HAS_SSE2
+#   endif
+# endif /* !ACE_HAS_SSE2 && !ACE_LACKS_SSE2 */
+
+// g++ 4.9 and clang build single functions for SSSE3 or AVX2 and
+// tell at run time whether the processor has them, so that code can
+// pick the widest instructions the machine offers.  Define
+// ACE_LACKS_SIMD_DISPATCH to stay with SSE2.
+# if !defined (ACE_HAS_SIMD_DISPATCH) && !defined (ACE_LACKS_SIMD_DISPATCH)
+#   if defined (ACE_HAS_SSE2) \
+       && (defined (__x86_64__) || defined (__i386__)) \
+       && (defined (__clang__) \
+           || (defined (__GNUC__) \
+               && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#     define ACE_HAS_SIMD_DISPATCH
+#   endif
+# endif /* !ACE_HAS_SIMD_DISPATCH && !ACE_LACKS_SIMD_DISPATCH */
+
+// The __atomic builtins, which take a memory order, come with g++
+// 4.7 and clang on top of the __sync builtins of
+// ACE_HAS_GCC_ATOMIC_BUILTINS.  The code that only needs acquire and
+// release ordering between threads is built on them.
+# if !defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+#   if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1) \
+       && defined (__ATOMIC_ACQUIRE)
+#     define ACE_HAS_GCC_ATOMIC_MEMORY_MODEL
+#   endif
+# endif /* !ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+
 // =========================================================================
 // INLINE macros
 //
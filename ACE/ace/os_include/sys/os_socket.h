@@ -101,6 +101,21 @@ extern "C"
    typedef WSACMSGHDR cmsghdr;
 #endif /* ACE_WIN32 */
 
+#if defined (ACE_HAS_RECVMMSG) || defined (ACE_HAS_SENDMMSG)
+   typedef struct mmsghdr ACE_mmsghdr;
+#else
+   /// An element of the message vector of ACE_OS::recvmmsg() and
+   /// ACE_OS::sendmmsg(), laid out like the Linux mmsghdr.
+   struct ACE_mmsghdr
+   {
+     /// The message.
+     msghdr msg_hdr;
+
+     /// Number of bytes received or sent.
+     unsigned int msg_len;
+   };
+#endif /* ACE_HAS_RECVMMSG || ACE_HAS_SENDMMSG */
+
    // Using msghdr::msg_control and msghdr::msg_controllen portably:
    // For a parameter of size n, reserve space for ACE_CMSG_SPACE(n) bytes.
    // This can be extended to the sum of ACE_CMSG_SPACE(n_i) for multiple
@@ -0,0 +1,173 @@
+//=============================================================================
+/**
+ *  @file   cdr_array_test.cpp
+ *
+ * Measures how fast ACE_InputCDR::read_short_array, read_long_array
+ * and read_double_array demarshal arrays from 1 KB to 64 MB, once in
+ * the native byte order, where the data is only copied, and once in
+ * the other byte order, where it is swapped on the way.  For each type
+ * and size the array is read repeatedly until about the same amount of
+ * data went through, and the throughput is reported in MB per second.
+ */
+//=============================================================================
+
+#include "ace/CDR_Stream.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Log_Msg.h"
+
+static size_t min_size = 1024;
+static size_t max_size = 64 * 1024 * 1024;
+static size_t volume = 1024 * 1024 * 1024;
+
+struct Short_Array
+{
+  static const ACE_TCHAR *name (void) { return ACE_TEXT ("short"); }
+  static size_t size (void) { return ACE_CDR::SHORT_SIZE; }
+  static ACE_CDR::Boolean read (ACE_InputCDR &cdr, void *x, ACE_CDR::ULong n)
+  {
+    return cdr.read_short_array (static_cast<ACE_CDR::Short *> (x), n);
+  }
+};
+
+struct Long_Array
+{
+  static const ACE_TCHAR *name (void) { return ACE_TEXT ("long"); }
+  static size_t size (void) { return ACE_CDR::LONG_SIZE; }
+  static ACE_CDR::Boolean read (ACE_InputCDR &cdr, void *x, ACE_CDR::ULong n)
+  {
+    return cdr.read_long_array (static_cast<ACE_CDR::Long *> (x), n);
+  }
+};
+
+struct Double_Array
+{
+  static const ACE_TCHAR *name (void) { return ACE_TEXT ("double"); }
+  static size_t size (void) { return ACE_CDR::LONGLONG_SIZE; }
+  static ACE_CDR::Boolean read (ACE_InputCDR &cdr, void *x, ACE_CDR::ULong n)
+  {
+    return cdr.read_double_array (static_cast<ACE_CDR::Double *> (x), n);
+  }
+};
+
+// Read the <bytes> of <source> as an array of T in <byte_order> until
+// <volume> bytes went through, and return the MB per second.
+template <typename T>
+static double
+time_read (const char *source, char *target, size_t bytes, int byte_order)
+{
+  ACE_CDR::ULong const n = static_cast<ACE_CDR::ULong> (bytes / T::size ());
+  size_t const iterations = volume / bytes > 0 ? volume / bytes : 1;
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  for (size_t i = 0; i < iterations; ++i)
+    {
+      ACE_InputCDR cdr (source, bytes, byte_order);
+      if (!T::read (cdr, target, n))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%s: read of %B bytes failed\n"),
+                      T::name (), bytes));
+          return 0.0;
+        }
+    }
+  timer.stop ();
+
+  ACE_hrtime_t nsec;
+  timer.elapsed_time (nsec);
+  return static_cast<double> (bytes) * static_cast<double> (iterations)
+    * 1.0e3 / static_cast<double> (nsec);
+}
+
+template <typename T>
+static void
+run_test (const char *source, char *target)
+{
+  int const other_order = ACE_CDR_BYTE_ORDER ? 0 : 1;
+
+  for (size_t bytes = min_size; bytes <= max_size; bytes *= 4)
+    {
+      double const copy =
+        time_read<T> (source, target, bytes, ACE_CDR_BYTE_ORDER);
+      double const swap =
+        time_read<T> (source, target, bytes, other_order);
+
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%-6s %10B bytes  native: %9.1f MB/s  ")
+                  ACE_TEXT ("swapped: %9.1f MB/s\n"),
+                  T::name (), bytes, copy, swap));
+    }
+}
+
+static void
+usage (void)
+{
+  ACE_ERROR ((LM_ERROR,
+              "cdr_array_test\n"
+              "  [-m smallest array in bytes]\n"
+              "  [-x largest array in bytes]\n"
+              "  [-v bytes read for each array size]\n"));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("m:x:v:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    {
+      switch (c)
+        {
+        case 'm':
+          min_size = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'x':
+          max_size = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'v':
+          volume = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        default:
+          usage ();
+          return 1;
+        }
+    }
+
+  // The arrays are whole doubles.
+  min_size &= ~static_cast<size_t> (ACE_CDR::LONGLONG_SIZE - 1);
+  if (min_size == 0 || max_size < min_size || volume == 0)
+    {
+      usage ();
+      return 1;
+    }
+
+  char *source = 0;
+  char *target = 0;
+  ACE_NEW_RETURN (source, char[max_size + ACE_CDR::MAX_ALIGNMENT], 1);
+  ACE_NEW_RETURN (target, char[max_size + ACE_CDR::MAX_ALIGNMENT], 1);
+
+  // ACE_InputCDR expects the data aligned on ACE_CDR::MAX_ALIGNMENT.
+  char *const aligned_source =
+    ACE_ptr_align_binary (source, ACE_CDR::MAX_ALIGNMENT);
+  char *const aligned_target =
+    ACE_ptr_align_binary (target, ACE_CDR::MAX_ALIGNMENT);
+  for (size_t i = 0; i < max_size; ++i)
+    aligned_source[i] = static_cast<char> (i * 7);
+  ACE_OS::memset (aligned_target, 0, max_size);
+
+  ACE_High_Res_Timer::calibrate ();
+
+  run_test<Short_Array> (aligned_source, aligned_target);
+  run_test<Long_Array> (aligned_source, aligned_target);
+  run_test<Double_Array> (aligned_source, aligned_target);
+
+  delete [] source;
+  delete [] target;
+  return 0;
+}
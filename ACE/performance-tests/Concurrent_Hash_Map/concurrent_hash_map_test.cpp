@@ -0,0 +1,254 @@
+//=============================================================================
+/**
+ *  @file   concurrent_hash_map_test.cpp
+ *
+ * Compares the throughput of ACE_Concurrent_Hash_Map with the one of
+ * ACE_Hash_Map_Manager_Ex, locked with a mutex or with a
+ * readers/writer lock, when several threads look up, rebind and
+ * unbind keys concurrently.  For each map and each ratio of reads to
+ * writes, every thread runs the same number of operations on random
+ * keys, and the number of operations per second of all the threads
+ * together is reported.
+ */
+//=============================================================================
+
+#include "ace/Concurrent_Hash_Map_T.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Barrier.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/RW_Thread_Mutex.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Log_Msg.h"
+
+#if defined (ACE_HAS_THREADS)
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+typedef ACE_Concurrent_Hash_Map<ACE_UINT32,
+                                ACE_UINT32,
+                                ACE_Hash<ACE_UINT32>,
+                                ACE_Equal_To<ACE_UINT32>,
+                                ACE_Thread_Mutex> CONCURRENT_MAP;
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+
+typedef ACE_Hash_Map_Manager_Ex<ACE_UINT32,
+                                ACE_UINT32,
+                                ACE_Hash<ACE_UINT32>,
+                                ACE_Equal_To<ACE_UINT32>,
+                                ACE_Thread_Mutex> MUTEX_MAP;
+
+typedef ACE_Hash_Map_Manager_Ex<ACE_UINT32,
+                                ACE_UINT32,
+                                ACE_Hash<ACE_UINT32>,
+                                ACE_Equal_To<ACE_UINT32>,
+                                ACE_RW_Thread_Mutex> RW_MAP;
+
+static size_t n_threads = 4;
+static size_t n_keys = 100000;
+static size_t n_operations = 1000000;
+static int read_percent = -1;
+static const ACE_TCHAR *map_type = 0;
+
+// Ratios run when none is given with -r.
+static const int read_percents[] = { 50, 90, 99, 100 };
+
+static ACE_Atomic_Op<ACE_Thread_Mutex, long> seed_source;
+
+// Lookups that found their key, so that they can't be optimized away.
+static ACE_Atomic_Op<ACE_Thread_Mutex, long> found_total;
+
+template <class MAP_T>
+struct Run
+{
+  MAP_T *map_;
+  ACE_Barrier *barrier_;
+  int read_percent_;
+};
+
+static ACE_UINT32
+next_random (ACE_UINT32 &seed)
+{
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+template <class MAP_T>
+static ACE_THR_FUNC_RETURN
+worker (void *arg)
+{
+  Run<MAP_T> *const run = static_cast<Run<MAP_T> *> (arg);
+  MAP_T *const map = run->map_;
+  ACE_UINT32 seed = static_cast<ACE_UINT32> (++seed_source);
+  ACE_UINT32 const reads = static_cast<ACE_UINT32> (run->read_percent_);
+  ACE_UINT32 const keys = static_cast<ACE_UINT32> (n_keys);
+  size_t found = 0;
+
+  run->barrier_->wait ();
+
+  for (size_t i = 0; i < n_operations; ++i)
+    {
+      // Twice as many keys as bound ones, so that half the lookups miss.
+      ACE_UINT32 const key = next_random (seed) % (2 * keys);
+      ACE_UINT32 const op = next_random (seed) % 100;
+      ACE_UINT32 value = 0;
+
+      if (op < reads)
+        {
+          if (map->find (key, value) == 0)
+            ++found;
+        }
+      else if (op % 2 == 0)
+        map->rebind (key, key);
+      else
+        map->unbind (key);
+    }
+
+  found_total += static_cast<long> (found);
+  return 0;
+}
+
+template <class MAP_T>
+static int
+run_test (const ACE_TCHAR *name, int percent)
+{
+  MAP_T *map = 0;
+  ACE_NEW_RETURN (map, MAP_T (2 * n_keys), -1);
+
+  for (ACE_UINT32 key = 0; key < n_keys; ++key)
+    map->bind (key, key);
+
+  ACE_Barrier barrier (static_cast<unsigned int> (n_threads + 1));
+  Run<MAP_T> run;
+  run.map_ = map;
+  run.barrier_ = &barrier;
+  run.read_percent_ = percent;
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (n_threads,
+                                                ACE_THR_FUNC (worker<MAP_T>),
+                                                &run,
+                                                THR_NEW_LWP | THR_JOINABLE) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), -1);
+
+  ACE_High_Res_Timer timer;
+  barrier.wait ();
+  timer.start ();
+  ACE_Thread_Manager::instance ()->wait ();
+  timer.stop ();
+
+  ACE_hrtime_t nsec;
+  timer.elapsed_time (nsec);
+  double const total = static_cast<double> (n_threads * n_operations);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-10s threads: %3B reads: %3d%% ")
+              ACE_TEXT ("operations per second: %12.0f (%6.1f nsec each)\n"),
+              name, n_threads, percent,
+              total * 1.0e9 / static_cast<double> (nsec),
+              static_cast<double> (nsec) / total));
+
+  delete map;
+  return 0;
+}
+
+static int
+run_tests (int percent)
+{
+  int result = 0;
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+  if (map_type == 0 || ACE_OS::strcmp (map_type, ACE_TEXT ("concurrent")) == 0)
+    if (run_test<CONCURRENT_MAP> (ACE_TEXT ("concurrent"), percent) != 0)
+      result = -1;
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+
+  if (map_type == 0 || ACE_OS::strcmp (map_type, ACE_TEXT ("mutex")) == 0)
+    if (run_test<MUTEX_MAP> (ACE_TEXT ("mutex"), percent) != 0)
+      result = -1;
+
+  if (map_type == 0 || ACE_OS::strcmp (map_type, ACE_TEXT ("rw")) == 0)
+    if (run_test<RW_MAP> (ACE_TEXT ("rw"), percent) != 0)
+      result = -1;
+
+  return result;
+}
+
+static void
+usage (void)
+{
+  ACE_ERROR ((LM_ERROR,
+              "concurrent_hash_map_test\n"
+              "  [-t number of threads]\n"
+              "  [-k number of keys]\n"
+              "  [-n number of operations per thread]\n"
+              "  [-r percentage of reads (default: 50, 90, 99 and 100)]\n"
+              "  [-m concurrent|mutex|rw (default: all)]\n"));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("t:k:n:r:m:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    {
+      switch (c)
+        {
+        case 't':
+          n_threads = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'k':
+          n_keys = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'n':
+          n_operations = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'r':
+          read_percent = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+        case 'm':
+          map_type = get_opt.opt_arg ();
+          break;
+        default:
+          usage ();
+          return 1;
+        }
+    }
+
+  if (n_threads == 0 || n_keys == 0 || read_percent > 100)
+    {
+      usage ();
+      return 1;
+    }
+
+  ACE_High_Res_Timer::calibrate ();
+
+  int result = 0;
+  if (read_percent >= 0)
+    result = run_tests (read_percent);
+  else
+    for (size_t i = 0;
+         i < sizeof (read_percents) / sizeof (read_percents[0]);
+         ++i)
+      if (run_tests (read_percents[i]) != 0)
+        result = -1;
+
+  return result == 0 ? 0 : 1;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS */
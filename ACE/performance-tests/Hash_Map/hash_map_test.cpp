@@ -0,0 +1,217 @@
+//=============================================================================
+/**
+ *  @file   hash_map_test.cpp
+ *
+ * Compares the cost of the basic operations of ACE_Flat_Hash_Map,
+ * ACE_Hash_Map_Manager_Ex and ACE_Map_Manager as the number of
+ * entries grows.  For each map and number of entries the time per
+ * entry is reported for binding the entries, finding them in random
+ * order, looking up keys that aren't bound, and unbinding the entries
+ * in random order.
+ */
+//=============================================================================
+
+#include "ace/Flat_Hash_Map_T.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Map_Manager.h"
+#include "ace/Null_Mutex.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Log_Msg.h"
+
+typedef ACE_Flat_Hash_Map<ACE_UINT32,
+                          ACE_UINT32,
+                          ACE_Hash<ACE_UINT32>,
+                          ACE_Equal_To<ACE_UINT32>,
+                          ACE_Null_Mutex> FLAT_MAP;
+
+typedef ACE_Hash_Map_Manager_Ex<ACE_UINT32,
+                                ACE_UINT32,
+                                ACE_Hash<ACE_UINT32>,
+                                ACE_Equal_To<ACE_UINT32>,
+                                ACE_Null_Mutex> HASH_MAP;
+
+typedef ACE_Map_Manager<ACE_UINT32,
+                        ACE_UINT32,
+                        ACE_Null_Mutex> LINEAR_MAP;
+
+static size_t min_entries = 1000;
+static size_t max_entries = 1000000;
+static const ACE_TCHAR *map_type = 0;
+
+// ACE_Map_Manager searches its entries linearly, so don't let it run
+// for hours.
+static const size_t max_map_entries = 10000;
+
+static double
+per_entry (ACE_High_Res_Timer &timer, size_t n)
+{
+  ACE_hrtime_t nsec;
+  timer.elapsed_time (nsec);
+  return static_cast<double> (nsec) / static_cast<double> (n);
+}
+
+template <class MAP_T>
+static int
+run_test (const ACE_TCHAR *name,
+          size_t n,
+          const ACE_UINT32 *keys,
+          const size_t *order)
+{
+  MAP_T *map = 0;
+  ACE_NEW_RETURN (map, MAP_T (n), -1);
+
+  ACE_High_Res_Timer timer;
+  int result = 0;
+
+  // Bind
+  timer.start ();
+  for (size_t i = 0; i < n; ++i)
+    map->bind (keys[i], static_cast<ACE_UINT32> (i));
+  timer.stop ();
+  double const bind_nsec = per_entry (timer, n);
+
+  // Find the entries in random order.
+  size_t found = 0;
+  timer.start ();
+  for (size_t i = 0; i < n; ++i)
+    {
+      ACE_UINT32 value;
+      if (map->find (keys[order[i]], value) == 0 && value == order[i])
+        ++found;
+    }
+  timer.stop ();
+  double const find_nsec = per_entry (timer, n);
+
+  // Look up keys that aren't bound, the keys are all even.
+  size_t missed = 0;
+  timer.start ();
+  for (size_t i = 0; i < n; ++i)
+    if (map->find (keys[i] + 1) == -1)
+      ++missed;
+  timer.stop ();
+  double const miss_nsec = per_entry (timer, n);
+
+  // Unbind the entries in random order.
+  timer.start ();
+  for (size_t i = 0; i < n; ++i)
+    map->unbind (keys[order[i]]);
+  timer.stop ();
+  double const unbind_nsec = per_entry (timer, n);
+
+  if (found != n || missed != n || map->current_size () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: found %B and missed %B of %B entries, %B left\n"),
+                  name, found, missed, n, map->current_size ()));
+      result = -1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-5s entries: %8B nsec per entry: bind %7.1f ")
+              ACE_TEXT ("find %7.1f miss %7.1f unbind %7.1f\n"),
+              name, n, bind_nsec, find_nsec, miss_nsec, unbind_nsec));
+
+  delete map;
+  return result;
+}
+
+static int
+run_tests (size_t n)
+{
+  ACE_UINT32 *keys = 0;
+  size_t *order = 0;
+  ACE_NEW_RETURN (keys, ACE_UINT32[n], -1);
+  ACE_NEW_RETURN (order, size_t[n], -1);
+
+  // Distinct even keys, spread over the whole range.
+  for (size_t i = 0; i < n; ++i)
+    {
+      keys[i] = static_cast<ACE_UINT32> (i) * 2654435762u;
+      order[i] = i;
+    }
+
+  u_int seed = 42;
+  for (size_t i = n; i > 1; --i)
+    {
+      size_t const j =
+        ((static_cast<size_t> (ACE_OS::rand_r (&seed)) << 16)
+         ^ static_cast<size_t> (ACE_OS::rand_r (&seed))) % i;
+      size_t const tmp = order[i - 1];
+      order[i - 1] = order[j];
+      order[j] = tmp;
+    }
+
+  int result = 0;
+
+  if (map_type == 0 || ACE_OS::strcmp (map_type, ACE_TEXT ("flat")) == 0)
+    if (run_test<FLAT_MAP> (ACE_TEXT ("flat"), n, keys, order) != 0)
+      result = -1;
+
+  if (map_type == 0 || ACE_OS::strcmp (map_type, ACE_TEXT ("hash")) == 0)
+    if (run_test<HASH_MAP> (ACE_TEXT ("hash"), n, keys, order) != 0)
+      result = -1;
+
+  if (n <= max_map_entries
+      && (map_type == 0 || ACE_OS::strcmp (map_type, ACE_TEXT ("map")) == 0))
+    if (run_test<LINEAR_MAP> (ACE_TEXT ("map"), n, keys, order) != 0)
+      result = -1;
+
+  delete [] order;
+  delete [] keys;
+  return result;
+}
+
+static void
+usage (void)
+{
+  ACE_ERROR ((LM_ERROR,
+              "hash_map_test\n"
+              "  [-m smallest number of entries]\n"
+              "  [-n largest number of entries]\n"
+              "  [-t flat|hash|map (default: all)]\n"));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("m:n:t:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    {
+      switch (c)
+        {
+        case 'm':
+          min_entries = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'n':
+          max_entries = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 't':
+          map_type = get_opt.opt_arg ();
+          break;
+        default:
+          usage ();
+          return 1;
+        }
+    }
+
+  if (min_entries == 0 || max_entries < min_entries)
+    {
+      usage ();
+      return 1;
+    }
+
+  ACE_High_Res_Timer::calibrate ();
+
+  int result = 0;
+  for (size_t n = min_entries; n <= max_entries; n *= 10)
+    if (run_tests (n) != 0)
+      result = 1;
+
+  return result;
+}
@@ -0,0 +1,21 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+$T = new PerlACE::Process ("hash_map_test", "-n 100000");
+
+$test = $T->SpawnWaitKill (300);
+
+if ($test != 0) {
+    print "ERROR: hash_map_test returned $test\n";
+    $status = 1;
+}
+
+exit $status;
@@ -0,0 +1,342 @@
+//=============================================================================
+/**
+ *  @file   lockfree_message_queue_test.cpp
+ *
+ * Compares the throughput of ACE_Lockfree_Message_Queue, with single
+ * and with batch calls, with the one of ACE_Message_Queue<ACE_MT_SYNCH>
+ * when several producer threads pass messages to several consumer
+ * threads.  Both queues are bounded to the same number of messages.
+ * The number of messages per second that go through each queue is
+ * reported.
+ */
+//=============================================================================
+
+#include "ace/Lockfree_Message_Queue.h"
+#include "ace/Message_Queue.h"
+#include "ace/Message_Block.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Barrier.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Log_Msg.h"
+
+#if defined (ACE_HAS_THREADS)
+
+static size_t n_producers = 2;
+static size_t n_consumers = 2;
+static size_t n_messages = 1000000;
+static size_t capacity = 1024;
+static size_t batch_size = 16;
+static const ACE_TCHAR *queue_type = 0;
+
+// Size of the data of each message.
+static const size_t message_size = 8;
+
+// Mode of a run.
+enum Mode
+{
+  LOCKED,
+  LOCKFREE,
+  BATCH
+};
+
+struct Run
+{
+  Mode mode_;
+  ACE_Message_Queue<ACE_MT_SYNCH> *locked_;
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+  ACE_Lockfree_Message_Queue *lockfree_;
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+  ACE_Barrier *start_;
+  ACE_Barrier *sent_;
+  ACE_Barrier *done_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> received_;
+};
+
+// Each producer sends its own blocks over and over.  The queues hold
+// at most <capacity> messages, so a block has always been dequeued by
+// the time it comes around again.
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  Run *const run = static_cast<Run *> (arg);
+  size_t const n_blocks = 2 * capacity + batch_size;
+  ACE_Message_Block **blocks = 0;
+  ACE_NEW_RETURN (blocks, ACE_Message_Block *[n_blocks], 0);
+  for (size_t i = 0; i < n_blocks; ++i)
+    {
+      ACE_NEW_RETURN (blocks[i], ACE_Message_Block (message_size), 0);
+      blocks[i]->wr_ptr (message_size);
+    }
+
+  run->start_->wait ();
+
+  size_t next = 0;
+  for (size_t sent = 0; sent < n_messages; )
+    {
+      switch (run->mode_)
+        {
+        case LOCKED:
+          run->locked_->enqueue_tail (blocks[next]);
+          ++sent;
+          next = (next + 1) % n_blocks;
+          break;
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+        case LOCKFREE:
+          run->lockfree_->enqueue_tail (blocks[next]);
+          ++sent;
+          next = (next + 1) % n_blocks;
+          break;
+        case BATCH:
+          {
+            size_t n = n_messages - sent < batch_size
+              ? n_messages - sent
+              : batch_size;
+            if (next + n > n_blocks)
+              next = 0;
+            run->lockfree_->enqueue_tail_n (blocks + next, n);
+            sent += n;
+            next += n;
+          }
+          break;
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+        default:
+          sent = n_messages;
+          break;
+        }
+    }
+
+  // Wait for the consumers before the blocks go away.
+  run->sent_->wait ();
+  run->done_->wait ();
+
+  for (size_t i = 0; i < n_blocks; ++i)
+    blocks[i]->release ();
+  delete [] blocks;
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+consumer (void *arg)
+{
+  Run *const run = static_cast<Run *> (arg);
+  ACE_Message_Block **blocks = 0;
+  ACE_NEW_RETURN (blocks, ACE_Message_Block *[batch_size], 0);
+  long received = 0;
+
+  run->start_->wait ();
+
+  for (;;)
+    {
+      int n = -1;
+      switch (run->mode_)
+        {
+        case LOCKED:
+          if (run->locked_->dequeue_head (blocks[0]) != -1)
+            n = 1;
+          break;
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+        case LOCKFREE:
+          if (run->lockfree_->dequeue_head (blocks[0]) != -1)
+            n = 1;
+          break;
+        case BATCH:
+          n = run->lockfree_->dequeue_head_n (blocks, batch_size);
+          break;
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+        default:
+          break;
+        }
+
+      if (n == -1)
+        break;
+      received += n;
+    }
+
+  run->received_ += received;
+  delete [] blocks;
+
+  run->done_->wait ();
+  return 0;
+}
+
+static int
+run_test (const ACE_TCHAR *name, Mode mode)
+{
+  unsigned int const n_threads =
+    static_cast<unsigned int> (n_producers + n_consumers);
+  ACE_Barrier start (n_threads + 1);
+  ACE_Barrier sent (static_cast<unsigned int> (n_producers + 1));
+  ACE_Barrier done (n_threads + 1);
+  Run run;
+  run.mode_ = mode;
+  run.locked_ = 0;
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+  run.lockfree_ = 0;
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+  run.start_ = &start;
+  run.sent_ = &sent;
+  run.done_ = &done;
+
+  ACE_Message_Queue_Base *queue = 0;
+  if (mode == LOCKED)
+    {
+      // The water marks are in bytes, make them hold <capacity>
+      // messages.
+      ACE_NEW_RETURN (run.locked_,
+                      ACE_Message_Queue<ACE_MT_SYNCH> (capacity * message_size,
+                                                       capacity * message_size),
+                      -1);
+      queue = run.locked_;
+    }
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+  else
+    {
+      ACE_NEW_RETURN (run.lockfree_,
+                      ACE_Lockfree_Message_Queue (capacity),
+                      -1);
+      queue = run.lockfree_;
+    }
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+
+  ACE_Thread_Manager *const tm = ACE_Thread_Manager::instance ();
+  if (tm->spawn_n (n_producers,
+                   ACE_THR_FUNC (producer),
+                   &run,
+                   THR_NEW_LWP | THR_JOINABLE) == -1
+      || tm->spawn_n (n_consumers,
+                      ACE_THR_FUNC (consumer),
+                      &run,
+                      THR_NEW_LWP | THR_JOINABLE) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), -1);
+
+  long const total = static_cast<long> (n_producers * n_messages);
+  ACE_High_Res_Timer timer;
+  start.wait ();
+  timer.start ();
+
+  // Once the producers are done and the consumers have taken every
+  // message, deactivating the queue lets the consumers go.
+  sent.wait ();
+  while (!queue->is_empty ())
+    ACE_OS::thr_yield ();
+  queue->deactivate ();
+
+  done.wait ();
+  timer.stop ();
+  tm->wait ();
+
+  ACE_hrtime_t nsec;
+  timer.elapsed_time (nsec);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-9s producers: %2B consumers: %2B ")
+              ACE_TEXT ("messages per second: %12.0f (%6.1f nsec each)\n"),
+              name, n_producers, n_consumers,
+              static_cast<double> (total) * 1.0e9 / static_cast<double> (nsec),
+              static_cast<double> (nsec) / static_cast<double> (total)));
+
+  int result = 0;
+  if (run.received_.value () != total)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: received %d messages instead of %d\n"),
+                  name, run.received_.value (), total));
+      result = -1;
+    }
+
+  delete queue;
+  return result;
+}
+
+static void
+usage (void)
+{
+  ACE_ERROR ((LM_ERROR,
+              "lockfree_message_queue_test\n"
+              "  [-p number of producers]\n"
+              "  [-c number of consumers]\n"
+              "  [-n number of messages per producer]\n"
+              "  [-s capacity of the queues in messages]\n"
+              "  [-b number of messages per batch]\n"
+              "  [-q locked|lockfree|batch (default: all)]\n"));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("p:c:n:s:b:q:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    {
+      switch (c)
+        {
+        case 'p':
+          n_producers = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'c':
+          n_consumers = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'n':
+          n_messages = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 's':
+          capacity = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'b':
+          batch_size = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'q':
+          queue_type = get_opt.opt_arg ();
+          break;
+        default:
+          usage ();
+          return 1;
+        }
+    }
+
+  if (n_producers == 0 || n_consumers == 0 || capacity == 0 || batch_size == 0)
+    {
+      usage ();
+      return 1;
+    }
+
+  ACE_High_Res_Timer::calibrate ();
+
+  int result = 0;
+
+  if (queue_type == 0 || ACE_OS::strcmp (queue_type, ACE_TEXT ("locked")) == 0)
+    if (run_test (ACE_TEXT ("locked"), LOCKED) != 0)
+      result = -1;
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+  if (queue_type == 0 || ACE_OS::strcmp (queue_type, ACE_TEXT ("lockfree")) == 0)
+    if (run_test (ACE_TEXT ("lockfree"), LOCKFREE) != 0)
+      result = -1;
+
+  if (queue_type == 0 || ACE_OS::strcmp (queue_type, ACE_TEXT ("batch")) == 0)
+    if (run_test (ACE_TEXT ("batch"), BATCH) != 0)
+      result = -1;
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+
+  return result == 0 ? 0 : 1;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS */
@@ -0,0 +1,249 @@
+//=============================================================================
+/**
+ *  @file   notify_test.cpp
+ *
+ * Measures the throughput of ACE_Reactor::notify() with a growing
+ * number of notifying threads.  For every reactor and producer count,
+ * the producers each send a number of notifications to one handler
+ * while a single thread runs the event loop, and the number of
+ * notifications dispatched per second is reported.
+ */
+//=============================================================================
+
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/TP_Reactor.h"
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Dev_Poll_Reactor_Eventfd_Notify.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Log_Msg.h"
+
+static size_t iterations = 100000;
+static size_t max_producers = 64;
+static const ACE_TCHAR *reactor_type = 0;
+
+/**
+ * @class Handler
+ *
+ * Counts the notifications and ends the event loop after the last one.
+ */
+class Handler : public ACE_Event_Handler
+{
+public:
+  Handler (size_t expected) : received_ (0), expected_ (expected) {}
+
+  virtual int handle_exception (ACE_HANDLE)
+  {
+    if (++this->received_ == this->expected_)
+      this->reactor ()->end_reactor_event_loop ();
+    return 0;
+  }
+
+private:
+  size_t received_;
+  size_t const expected_;
+};
+
+/**
+ * @class Producer
+ *
+ * Sends @c iterations notifications from each of its threads.
+ */
+class Producer : public ACE_Task_Base
+{
+public:
+  Producer (ACE_Reactor &reactor, Handler &handler)
+    : reactor_ (reactor), handler_ (handler) {}
+
+  virtual int svc (void)
+  {
+    for (size_t i = 0; i < iterations; ++i)
+      if (this->reactor_.notify (&this->handler_) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                           ACE_TEXT ("notify")), -1);
+    return 0;
+  }
+
+private:
+  ACE_Reactor &reactor_;
+  Handler &handler_;
+};
+
+/**
+ * @class Event_Loop
+ *
+ * Runs the reactor event loop in one thread.
+ */
+class Event_Loop : public ACE_Task_Base
+{
+public:
+  Event_Loop (ACE_Reactor &reactor) : reactor_ (reactor) {}
+
+  virtual int svc (void)
+  {
+    this->reactor_.owner (ACE_Thread::self ());
+    this->reactor_.run_reactor_event_loop ();
+    return 0;
+  }
+
+private:
+  ACE_Reactor &reactor_;
+};
+
+static ACE_Reactor_Impl *
+make_reactor (const ACE_TCHAR *name, ACE_Reactor_Notify *&notify)
+{
+  ACE_Reactor_Impl *impl = 0;
+  notify = 0;
+
+  if (ACE_OS::strcmp (name, ACE_TEXT ("select")) == 0)
+    ACE_NEW_RETURN (impl, ACE_Select_Reactor, 0);
+  else if (ACE_OS::strcmp (name, ACE_TEXT ("tp")) == 0)
+    ACE_NEW_RETURN (impl, ACE_TP_Reactor, 0);
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+  else if (ACE_OS::strcmp (name, ACE_TEXT ("dev_poll")) == 0)
+    ACE_NEW_RETURN (impl, ACE_Dev_Poll_Reactor, 0);
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+#if defined (ACE_HAS_EVENT_POLL) && defined (ACE_HAS_EVENTFD)
+  else if (ACE_OS::strcmp (name, ACE_TEXT ("eventfd")) == 0)
+    {
+      ACE_NEW_RETURN (notify, ACE_Dev_Poll_Reactor_Eventfd_Notify, 0);
+      ACE_NEW_NORETURN (impl,
+                        ACE_Dev_Poll_Reactor (ACE::max_handles (),
+                                              false,
+                                              0,
+                                              0,
+                                              0,
+                                              notify));
+    }
+#endif /* ACE_HAS_EVENT_POLL && ACE_HAS_EVENTFD */
+  else
+    return 0;
+
+  if (impl == 0 || !impl->initialized ())
+    {
+      delete impl;
+      delete notify;
+      notify = 0;
+      return 0;
+    }
+  return impl;
+}
+
+static int
+run_test (const ACE_TCHAR *name, size_t producers)
+{
+  ACE_Reactor_Notify *notify = 0;
+  ACE_Reactor_Impl *impl = make_reactor (name, notify);
+  if (impl == 0)
+    {
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%-8s not available\n"), name));
+      return 0;
+    }
+
+  int result = 0;
+  size_t const expected = producers * iterations;
+  ACE_High_Res_Timer timer;
+  {
+    ACE_Reactor reactor (impl, 1);
+    Handler handler (expected);
+    handler.reactor (&reactor);
+
+    Event_Loop event_loop (reactor);
+    Producer producer (reactor, handler);
+
+    timer.start ();
+    if (event_loop.activate (THR_NEW_LWP | THR_JOINABLE, 1) == -1
+        || producer.activate (THR_NEW_LWP | THR_JOINABLE,
+                              static_cast<int> (producers)) == -1)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("activate")));
+        reactor.end_reactor_event_loop ();
+        result = -1;
+      }
+
+    producer.wait ();
+    event_loop.wait ();
+    timer.stop ();
+  }
+  delete notify;
+
+  ACE_hrtime_t usec;
+  timer.elapsed_microseconds (usec);
+  double const rate = usec == 0 ? 0.0
+    : static_cast<double> (expected) * 1000000.0 / static_cast<double> (usec);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-8s producers: %2B notify: %12.1f msgs/sec\n"),
+              name, producers, rate));
+
+  return result;
+}
+
+static void
+usage (void)
+{
+  ACE_ERROR ((LM_ERROR,
+              "notify_test\n"
+              "  [-i notifications per producer]\n"
+              "  [-p maximum number of producer threads]\n"
+              "  [-r select|tp|dev_poll|eventfd (default: all)]\n"));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("i:p:r:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    {
+      switch (c)
+        {
+        case 'i':
+          iterations = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'p':
+          max_producers = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'r':
+          reactor_type = get_opt.opt_arg ();
+          break;
+        default:
+          usage ();
+          return 1;
+        }
+    }
+
+  if (iterations == 0 || max_producers == 0)
+    {
+      usage ();
+      return 1;
+    }
+
+  ACE_High_Res_Timer::calibrate ();
+
+  static const ACE_TCHAR *all[] =
+    {
+      ACE_TEXT ("select"),
+      ACE_TEXT ("tp"),
+      ACE_TEXT ("dev_poll"),
+      ACE_TEXT ("eventfd")
+    };
+
+  int result = 0;
+  for (size_t i = 0; i < sizeof all / sizeof all[0]; ++i)
+    if (reactor_type == 0 || ACE_OS::strcmp (reactor_type, all[i]) == 0)
+      for (size_t p = 1; p <= max_producers; p *= 2)
+        if (run_test (all[i], p) != 0)
+          result = 1;
+
+  return result;
+}
@@ -0,0 +1,312 @@
+//=============================================================================
+/**
+ *  @file   reactor_test.cpp
+ *
+ * Measures how the reactor implementations scale with the number of
+ * connections.  A producer thread writes one byte at a time to each
+ * of a number of connected socket pairs while one or more event loop
+ * threads dispatch and read them.  For each reactor the time to
+ * register all the connections and the rate at which messages are
+ * dispatched are reported.
+ */
+//=============================================================================
+
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/TP_Reactor.h"
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Uring_Reactor.h"
+#include "ace/Pipe.h"
+#include "ace/ACE.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/Log_Msg.h"
+
+static size_t connections = 1000;
+static size_t iterations = 100;
+static size_t threads = 1;
+static const ACE_TCHAR *reactor_type = 0;
+
+// Total number of messages dispatched so far.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, size_t> received;
+
+// Total number of messages expected.
+static size_t expected = 0;
+
+/**
+ * @class Receiver
+ *
+ * Reads the bytes written to one connection.
+ */
+class Receiver : public ACE_Event_Handler
+{
+public:
+  Receiver (void) {}
+
+  virtual ACE_HANDLE get_handle (void) const
+  {
+    return this->pipe_.read_handle ();
+  }
+
+  virtual int handle_input (ACE_HANDLE fd)
+  {
+    char buf[64];
+    ssize_t const n = ACE::recv (fd, buf, sizeof buf);
+    if (n <= 0)
+      return n == 0 ? -1 : 0;
+
+    if ((received += static_cast<size_t> (n)) >= expected)
+      this->reactor ()->end_reactor_event_loop ();
+    return 0;
+  }
+
+  ACE_Pipe pipe_;
+};
+
+/**
+ * @class Producer
+ *
+ * Writes @c iterations messages to each connection, one connection
+ * after the other.
+ */
+class Producer : public ACE_Task_Base
+{
+public:
+  Producer (Receiver *receivers) : receivers_ (receivers) {}
+
+  virtual int svc (void)
+  {
+    for (size_t i = 0; i < iterations; ++i)
+      for (size_t c = 0; c < connections; ++c)
+        if (ACE::send_n (this->receivers_[c].pipe_.write_handle (),
+                         "x", 1) != 1)
+          ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                             ACE_TEXT ("send_n")), -1);
+    return 0;
+  }
+
+private:
+  Receiver *receivers_;
+};
+
+/**
+ * @class Event_Loop
+ *
+ * Runs the reactor event loop in @c threads threads.
+ */
+class Event_Loop : public ACE_Task_Base
+{
+public:
+  Event_Loop (ACE_Reactor &reactor) : reactor_ (reactor) {}
+
+  virtual int svc (void)
+  {
+    this->reactor_.owner (ACE_Thread::self ());
+    this->reactor_.run_reactor_event_loop ();
+    return 0;
+  }
+
+private:
+  ACE_Reactor &reactor_;
+};
+
+static ACE_Reactor_Impl *
+make_reactor (const ACE_TCHAR *name, size_t size)
+{
+  ACE_Reactor_Impl *impl = 0;
+
+  if (ACE_OS::strcmp (name, ACE_TEXT ("select")) == 0)
+    ACE_NEW_RETURN (impl, ACE_Select_Reactor (size), 0);
+  else if (ACE_OS::strcmp (name, ACE_TEXT ("tp")) == 0)
+    ACE_NEW_RETURN (impl, ACE_TP_Reactor (size), 0);
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+  else if (ACE_OS::strcmp (name, ACE_TEXT ("dev_poll")) == 0)
+    ACE_NEW_RETURN (impl, ACE_Dev_Poll_Reactor (size), 0);
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_EVENT_POLL)
+  else if (ACE_OS::strcmp (name, ACE_TEXT ("uring")) == 0)
+    ACE_NEW_RETURN (impl, ACE_Uring_Reactor (size), 0);
+#endif /* ACE_HAS_IO_URING && ACE_HAS_EVENT_POLL */
+  else
+    return 0;
+
+  if (!impl->initialized ())
+    {
+      delete impl;
+      return 0;
+    }
+  return impl;
+}
+
+static int
+run_test (const ACE_TCHAR *name)
+{
+  size_t conns = connections;
+  size_t loop_threads = threads;
+
+  // The select based reactors are limited to FD_SETSIZE handles and
+  // the ACE_Select_Reactor can only be run by a single thread.
+  bool const select_based =
+    ACE_OS::strcmp (name, ACE_TEXT ("select")) == 0
+    || ACE_OS::strcmp (name, ACE_TEXT ("tp")) == 0;
+  if (select_based && conns * 2 + 16 > ACE_DEFAULT_SELECT_REACTOR_SIZE)
+    conns = (ACE_DEFAULT_SELECT_REACTOR_SIZE - 16) / 2;
+  if (ACE_OS::strcmp (name, ACE_TEXT ("select")) == 0)
+    loop_threads = 1;
+
+  ACE_Reactor_Impl *impl = make_reactor (name, conns * 2 + 16);
+  if (impl == 0)
+    {
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%-8s not available\n"), name));
+      return 0;
+    }
+  ACE_Reactor reactor (impl, 1);
+
+  Receiver *receivers = 0;
+  ACE_NEW_RETURN (receivers, Receiver[conns], -1);
+
+  for (size_t c = 0; c < conns; ++c)
+    if (receivers[c].pipe_.open () == -1)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("pipe")));
+        delete [] receivers;
+        return -1;
+      }
+
+  // Time the registration of all connections.
+  ACE_High_Res_Timer register_timer;
+  register_timer.start ();
+  for (size_t c = 0; c < conns; ++c)
+    if (reactor.register_handler (&receivers[c],
+                                  ACE_Event_Handler::READ_MASK) == -1)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("register")));
+        delete [] receivers;
+        return -1;
+      }
+  register_timer.stop ();
+
+  // Only the producer's connections are counted.
+  size_t const saved_connections = connections;
+  connections = conns;
+  received = 0;
+  expected = conns * iterations;
+
+  Producer producer (receivers);
+  Event_Loop event_loop (reactor);
+
+  ACE_High_Res_Timer dispatch_timer;
+  dispatch_timer.start ();
+
+  if (producer.activate (THR_NEW_LWP | THR_JOINABLE, 1) == -1
+      || event_loop.activate (THR_NEW_LWP | THR_JOINABLE,
+                              static_cast<int> (loop_threads)) == -1)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("activate")));
+
+  event_loop.wait ();
+  dispatch_timer.stop ();
+  producer.wait ();
+  connections = saved_connections;
+
+  ACE_hrtime_t register_usec;
+  register_timer.elapsed_microseconds (register_usec);
+  ACE_hrtime_t dispatch_usec;
+  dispatch_timer.elapsed_microseconds (dispatch_usec);
+
+  double const per_register =
+    static_cast<double> (register_usec) / static_cast<double> (conns);
+  double const rate = dispatch_usec == 0 ? 0.0
+    : static_cast<double> (received.value ()) * 1000000.0
+      / static_cast<double> (dispatch_usec);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-8s conns: %6B threads: %2B ")
+              ACE_TEXT ("register: %8.3f usec/conn ")
+              ACE_TEXT ("dispatch: %12.1f msgs/sec\n"),
+              name, conns, loop_threads, per_register, rate));
+
+  for (size_t c = 0; c < conns; ++c)
+    {
+      reactor.remove_handler (&receivers[c],
+                              ACE_Event_Handler::ALL_EVENTS_MASK |
+                              ACE_Event_Handler::DONT_CALL);
+      receivers[c].pipe_.close ();
+    }
+  delete [] receivers;
+
+  return 0;
+}
+
+static void
+usage (void)
+{
+  ACE_ERROR ((LM_ERROR,
+              "reactor_test\n"
+              "  [-n number of connections]\n"
+              "  [-i messages per connection]\n"
+              "  [-t number of event loop threads]\n"
+              "  [-r select|tp|dev_poll|uring (default: all)]\n"));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("n:i:t:r:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    {
+      switch (c)
+        {
+        case 'n':
+          connections = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'i':
+          iterations = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 't':
+          threads = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 'r':
+          reactor_type = get_opt.opt_arg ();
+          break;
+        default:
+          usage ();
+          return 1;
+        }
+    }
+
+  if (connections == 0 || iterations == 0 || threads == 0)
+    {
+      usage ();
+      return 1;
+    }
+
+  // Two handles per connection.
+  ACE::set_handle_limit (static_cast<int> (connections * 2 + 64), 1);
+
+  ACE_High_Res_Timer::calibrate ();
+
+  static const ACE_TCHAR *all[] =
+    {
+      ACE_TEXT ("select"),
+      ACE_TEXT ("tp"),
+      ACE_TEXT ("dev_poll"),
+      ACE_TEXT ("uring")
+    };
+
+  int result = 0;
+  for (size_t i = 0; i < sizeof all / sizeof all[0]; ++i)
+    if (reactor_type == 0 || ACE_OS::strcmp (reactor_type, all[i]) == 0)
+      if (run_test (all[i]) != 0)
+        result = 1;
+
+  return result;
+}
@@ -0,0 +1,32 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+foreach $threads (1, 4) {
+    $T = new PerlACE::Process ("reactor_test", "-n 1000 -i 100 -t $threads");
+
+    $test = $T->SpawnWaitKill (120);
+
+    if ($test != 0) {
+        print "ERROR: reactor_test returned $test\n";
+        $status = 1;
+    }
+}
+
+$N = new PerlACE::Process ("notify_test", "-i 10000 -p 64");
+
+$test = $N->SpawnWaitKill (300);
+
+if ($test != 0) {
+    print "ERROR: notify_test returned $test\n";
+    $status = 1;
+}
+
+exit $status;
@@ -0,0 +1,260 @@
+//=============================================================================
+/**
+ *  @file   timer_queue_test.cpp
+ *
+ * Compares the cost of the basic operations of the ACE timer queues
+ * with a large number of timers.  For each queue the time per timer
+ * is reported for scheduling the timers, cancelling them in random
+ * order, rescheduling each of them (as done for idle timeouts) and
+ * expiring them while the time advances.
+ */
+//=============================================================================
+
+#include "ace/Timer_Heap.h"
+#include "ace/Timer_Hash.h"
+#include "ace/Timer_List.h"
+#include "ace/Timer_Wheel.h"
+#include "ace/Timer_Hierarchical_Wheel.h"
+#include "ace/Recursive_Thread_Mutex.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/Log_Msg.h"
+
+static size_t timers = 100000;
+static time_t span = 60;
+static const ACE_TCHAR *queue_type = 0;
+
+// ACE_Timer_List is O(n) per timer scheduled, so don't let it run
+// for hours.
+static const size_t max_list_timers = 10000;
+
+// Number of steps in which the time advances over the span.
+static const int expire_steps = 1000;
+
+/**
+ * @class Handler
+ *
+ * Counts the expired timers.
+ */
+class Handler : public ACE_Event_Handler
+{
+public:
+  Handler (void) : expired_ (0) {}
+
+  virtual int handle_timeout (const ACE_Time_Value &, const void *)
+  {
+    ++this->expired_;
+    return 0;
+  }
+
+  size_t expired_;
+};
+
+static ACE_Timer_Queue *
+make_queue (const ACE_TCHAR *name, size_t n)
+{
+  ACE_Timer_Queue *tq = 0;
+
+  if (ACE_OS::strcmp (name, ACE_TEXT ("heap")) == 0)
+    ACE_NEW_RETURN (tq, ACE_Timer_Heap (n, true), 0);
+  else if (ACE_OS::strcmp (name, ACE_TEXT ("hash")) == 0)
+    ACE_NEW_RETURN (tq, ACE_Timer_Hash, 0);
+  else if (ACE_OS::strcmp (name, ACE_TEXT ("list")) == 0)
+    ACE_NEW_RETURN (tq, ACE_Timer_List, 0);
+  else if (ACE_OS::strcmp (name, ACE_TEXT ("wheel")) == 0)
+    ACE_NEW_RETURN (tq,
+                    ACE_Timer_Wheel (ACE_DEFAULT_TIMER_WHEEL_SIZE,
+                                     ACE_DEFAULT_TIMER_WHEEL_RESOLUTION,
+                                     n),
+                    0);
+  else if (ACE_OS::strcmp (name, ACE_TEXT ("hwheel")) == 0)
+    ACE_NEW_RETURN (tq,
+                    ACE_Timer_Hierarchical_Wheel (ACE_Time_Value::zero, n),
+                    0);
+
+  return tq;
+}
+
+static double
+per_timer (ACE_High_Res_Timer &timer, size_t n)
+{
+  ACE_hrtime_t nsec;
+  timer.elapsed_time (nsec);
+  return static_cast<double> (nsec) / 1000.0 / static_cast<double> (n);
+}
+
+static int
+run_test (const ACE_TCHAR *name)
+{
+  size_t n = timers;
+  if (ACE_OS::strcmp (name, ACE_TEXT ("list")) == 0 && n > max_list_timers)
+    n = max_list_timers;
+
+  ACE_Timer_Queue *tq = make_queue (name, n);
+  if (tq == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), name), -1);
+
+  ACE_Time_Value *times = 0;
+  long *ids = 0;
+  size_t *order = 0;
+  ACE_NEW_RETURN (times, ACE_Time_Value[n], -1);
+  ACE_NEW_RETURN (ids, long[n], -1);
+  ACE_NEW_RETURN (order, size_t[n], -1);
+
+  ACE_Time_Value const now = ACE_OS::gettimeofday ();
+  ACE_UINT64 const span_usec = static_cast<ACE_UINT64> (span) * ACE_ONE_SECOND_IN_USECS;
+  u_int seed = 42;
+  for (size_t i = 0; i < n; ++i)
+    {
+      ACE_UINT64 const r =
+        (static_cast<ACE_UINT64> (ACE_OS::rand_r (&seed)) << 16
+         ^ static_cast<ACE_UINT64> (ACE_OS::rand_r (&seed))) % span_usec;
+      times[i] = now + ACE_Time_Value (static_cast<time_t> (r / ACE_ONE_SECOND_IN_USECS),
+                                       static_cast<suseconds_t> (r % ACE_ONE_SECOND_IN_USECS));
+      order[i] = i;
+    }
+  for (size_t i = n; i > 1; --i)
+    {
+      size_t const j = ACE_OS::rand_r (&seed) % i;
+      size_t const tmp = order[i - 1];
+      order[i - 1] = order[j];
+      order[j] = tmp;
+    }
+
+  Handler handler;
+  ACE_High_Res_Timer timer;
+  int result = 0;
+
+  // Schedule
+  timer.start ();
+  for (size_t i = 0; i < n; ++i)
+    ids[i] = tq->schedule (&handler, 0, times[i]);
+  timer.stop ();
+  double const schedule_usec = per_timer (timer, n);
+
+  // Reschedule, i.e. cancel and schedule again a bit later.
+  timer.start ();
+  for (size_t i = 0; i < n; ++i)
+    {
+      size_t const k = order[i];
+      tq->cancel (ids[k]);
+      ids[k] = tq->schedule (&handler, 0, times[k] + ACE_Time_Value (0, 1000));
+    }
+  timer.stop ();
+  double const reschedule_usec = per_timer (timer, n);
+
+  // Cancel
+  timer.start ();
+  for (size_t i = 0; i < n; ++i)
+    tq->cancel (ids[order[i]]);
+  timer.stop ();
+  double const cancel_usec = per_timer (timer, n);
+
+  if (!tq->is_empty ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%s: timers left after cancel\n"), name));
+      result = -1;
+    }
+
+  // Schedule and expire while the time advances.
+  for (size_t i = 0; i < n; ++i)
+    ids[i] = tq->schedule (&handler, 0, times[i]);
+
+  ACE_Time_Value const step (span / expire_steps,
+                             static_cast<suseconds_t> (span_usec / expire_steps
+                                                       % ACE_ONE_SECOND_IN_USECS));
+  ACE_Time_Value cur = now;
+  timer.start ();
+  for (int i = 0; i <= expire_steps; ++i)
+    {
+      cur += step;
+      tq->expire (cur);
+    }
+  tq->expire (now + ACE_Time_Value (span + 1));
+  timer.stop ();
+  double const expire_usec = per_timer (timer, n);
+
+  if (handler.expired_ != n)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: %B of %B timers expired\n"),
+                  name, handler.expired_, n));
+      result = -1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-7s timers: %7B usec per timer: schedule %7.3f ")
+              ACE_TEXT ("reschedule %7.3f cancel %7.3f expire %7.3f\n"),
+              name, n, schedule_usec, reschedule_usec, cancel_usec, expire_usec));
+
+  delete [] order;
+  delete [] ids;
+  delete [] times;
+  delete tq;
+  return result;
+}
+
+static void
+usage (void)
+{
+  ACE_ERROR ((LM_ERROR,
+              "timer_queue_test\n"
+              "  [-n number of timers]\n"
+              "  [-s seconds over which the timers are spread]\n"
+              "  [-q heap|hash|list|wheel|hwheel (default: all)]\n"));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("n:s:q:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    {
+      switch (c)
+        {
+        case 'n':
+          timers = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          break;
+        case 's':
+          span = static_cast<time_t> (ACE_OS::strtoul (get_opt.opt_arg (), 0, 10));
+          break;
+        case 'q':
+          queue_type = get_opt.opt_arg ();
+          break;
+        default:
+          usage ();
+          return 1;
+        }
+    }
+
+  if (timers == 0 || span == 0)
+    {
+      usage ();
+      return 1;
+    }
+
+  ACE_High_Res_Timer::calibrate ();
+
+  static const ACE_TCHAR *all[] =
+    {
+      ACE_TEXT ("heap"),
+      ACE_TEXT ("hash"),
+      ACE_TEXT ("list"),
+      ACE_TEXT ("wheel"),
+      ACE_TEXT ("hwheel")
+    };
+
+  int result = 0;
+  for (size_t i = 0; i < sizeof all / sizeof all[0]; ++i)
+    if (queue_type == 0 || ACE_OS::strcmp (queue_type, all[i]) == 0)
+      if (run_test (all[i]) != 0)
+        result = 1;
+
+  return result;
+}
@@ -5,6 +5,7 @@
  *
  *  Checks ACE_OutputCDR::write_XX_array.
  *  Checks ACE_InputCDR::read_XX_array.
+ *  Checks ACE_CDR::swap_XX_array on short and misaligned arrays.
  *  Checks operator<< and operator>> for CDR Streams in
  *  each of the basic CDR types.
  *  Gives a measure of the speed of the ACE CDR streams wrt those
@@ -38,6 +39,7 @@
 #include "test_config.h"
 #include "ace/OS_Memory.h"
 #include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
 #include "ace/Get_Opt.h"
 #include "ace/CDR_Stream.h"
 #include "ace/High_Res_Timer.h"
@@ -850,6 +852,68 @@ struct CharHelper
     }
 };
 
+//
+// Swap arrays of every length up to a few vectors, from and to every
+// alignment, and compare each element with its bytes reversed.  This
+// goes through the vector kernels as well as through the scalar code
+// that handles what they leave.
+//
+int
+check_swap_arrays ()
+{
+  static const size_t max_n = 80;
+  static const size_t sizes[] = { 2, 4, 8, 16 };
+
+  char src[16 * max_n + 8];
+  char dst[16 * max_n + 8];
+  for (size_t i = 0; i < sizeof (src); i++)
+    src[i] = static_cast<char> (i * 13 + 1);
+
+  int errors = 0;
+  for (size_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); s++)
+    {
+      size_t const size = sizes[s];
+      for (size_t n = 1; n <= max_n; n++)
+        for (size_t so = 0; so < 8; so++)
+          for (size_t doff = 0; doff < 8; doff++)
+            {
+              ACE_OS::memset (dst, 0, sizeof (dst));
+              switch (size)
+                {
+                case 2:
+                  ACE_CDR::swap_2_array (src + so, dst + doff, n);
+                  break;
+                case 4:
+                  ACE_CDR::swap_4_array (src + so, dst + doff, n);
+                  break;
+                case 8:
+                  ACE_CDR::swap_8_array (src + so, dst + doff, n);
+                  break;
+                default:
+                  ACE_CDR::swap_16_array (src + so, dst + doff, n);
+                  break;
+                }
+
+              bool ok = true;
+              for (size_t i = 0; i < n * size && ok; i++)
+                {
+                  size_t const e = i - i % size;
+                  ok = dst[doff + i] == src[so + e + size - 1 - i % size];
+                }
+              // Nothing is written past the array.
+              for (size_t i = doff + n * size; i < sizeof (dst) && ok; i++)
+                ok = dst[i] == 0;
+
+              if (!ok && errors++ < 10)
+                ACE_ERROR ((LM_ERROR,
+                            ACE_TEXT ("swap_%B_array of %B elements ")
+                            ACE_TEXT ("from offset %B to offset %B failed\n"),
+                            size, n, so, doff));
+            }
+    }
+  return errors;
+}
+
 void usage (const ACE_TCHAR* cmd)
 {
   ACE_ERROR((LM_ERROR,
@@ -965,6 +1029,12 @@ run_main (int argc, ACE_TCHAR *argv[])
       dtotal = ftotal = qtotal = wtotal = htotal = ctotal = total;
     }
 
+  if (check_swap_arrays () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("ACE_CDR::swap_XX_array check failed\n")));
+    }
+
   int use_array;
   for (use_array = 0; use_array < 2; use_array++)
     {
@@ -0,0 +1,404 @@
+//=============================================================================
+/**
+ *  @file    CDR_Chain_Test.cpp
+ *
+ *  Checks that ACE_InputCDR reads a chain of message blocks the same
+ *  way it reads one contiguous buffer.  The same stream is split in
+ *  blocks of many sizes, with the blocks continuing the alignment of
+ *  the stream or not, so primitives, arrays, strings and
+ *  encapsulations straddle the boundaries.  Copies of the stream,
+ *  consolidate() and swapped arrays are checked too.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/CDR_Stream.h"
+#include "ace/Message_Block.h"
+#include "ace/OS_NS_string.h"
+
+// Collects everything read from a stream, so two reads can be
+// compared byte for byte.
+struct Sink
+{
+  Sink (void) : len_ (0) {}
+
+  void add (const void *data, size_t n)
+  {
+    if (this->len_ + n <= sizeof (this->buf_))
+      ACE_OS::memcpy (this->buf_ + this->len_, data, n);
+    this->len_ += n;
+  }
+
+  bool operator== (const Sink &rhs) const
+  {
+    return this->len_ == rhs.len_
+      && ACE_OS::memcmp (this->buf_, rhs.buf_, this->len_) == 0;
+  }
+
+  char buf_[8192];
+  size_t len_;
+};
+
+static const char *const strings[] =
+  {
+    "",
+    "a",
+    "chained",
+    "a string long enough to cross a few of the smaller blocks"
+  };
+static const size_t n_strings = sizeof strings / sizeof strings[0];
+
+static const ACE_CDR::ULong n_shorts = 37;
+static const ACE_CDR::ULong n_longs = 29;
+static const ACE_CDR::ULong n_longlongs = 23;
+static const ACE_CDR::ULong n_longdoubles = 5;
+static const ACE_CDR::ULong n_octets = 100;
+
+static void
+write_mixed (ACE_OutputCDR &out)
+{
+  out.write_octet (1);
+  out.write_ushort (0x1234);
+  out.write_ulong (0x12345678);
+  out.write_ulonglong (ACE_UINT64_LITERAL (0x0123456789abcdef));
+  out.write_double (3.25);
+
+  ACE_CDR::Boolean const b[] = { true, false, true, true, false, false, true };
+  out.write_boolean_array (b, sizeof b / sizeof b[0]);
+
+  for (size_t i = 0; i != n_strings; ++i)
+    out.write_string (strings[i]);
+
+  out.write_string ("skipped");
+  ACE_CDR::Octet const skipped[5] = { 1, 2, 3, 4, 5 };
+  out.write_octet_array (skipped, sizeof skipped);
+
+  out.write_octet (7);
+  out.align_write_ptr (ACE_CDR::LONGLONG_ALIGN);
+  out.write_ulonglong (ACE_UINT64_LITERAL (0xfedcba9876543210));
+
+  ACE_OutputCDR encap;
+  encap.write_octet (ACE_CDR_BYTE_ORDER);
+  encap.write_ulong (77);
+  encap.write_string ("inside the encapsulation");
+  ACE_CDR::ULong const encap_length =
+    static_cast<ACE_CDR::ULong> (encap.total_length ());
+  out.write_ulong (encap_length);
+  out.write_octet_array_mb (encap.begin ());
+
+  ACE_CDR::Octet octets[n_octets];
+  for (ACE_CDR::ULong i = 0; i != n_octets; ++i)
+    octets[i] = static_cast<ACE_CDR::Octet> (i * 7);
+  out.write_octet_array (octets, n_octets);
+}
+
+static void
+read_mixed (ACE_InputCDR &cdr, Sink &sink)
+{
+  ACE_CDR::Octet o = 0;
+  ACE_CDR::UShort us = 0;
+  ACE_CDR::ULong ul = 0;
+  ACE_CDR::ULongLong ull = 0;
+  ACE_CDR::Double d = 0;
+
+  cdr.read_octet (o);
+  sink.add (&o, sizeof o);
+  cdr.read_ushort (us);
+  sink.add (&us, sizeof us);
+  cdr.read_ulong (ul);
+  sink.add (&ul, sizeof ul);
+  cdr.read_ulonglong (ull);
+  sink.add (&ull, sizeof ull);
+  cdr.read_double (d);
+  sink.add (&d, sizeof d);
+
+  ACE_CDR::Boolean b[7];
+  cdr.read_boolean_array (b, 7);
+  sink.add (b, sizeof b);
+
+  for (size_t i = 0; i != n_strings; ++i)
+    {
+      ACE_CDR::Char *s = 0;
+      cdr.read_string (s);
+      if (s != 0)
+        sink.add (s, ACE_OS::strlen (s) + 1);
+      delete [] s;
+    }
+
+  cdr.skip_string ();
+  cdr.skip_bytes (5);
+
+  cdr.read_octet (o);
+  sink.add (&o, sizeof o);
+  cdr.align_read_ptr (ACE_CDR::LONGLONG_ALIGN);
+  cdr.read_ulonglong (ull);
+  sink.add (&ull, sizeof ull);
+
+  ACE_CDR::ULong encap_length = 0;
+  cdr.read_ulong (encap_length);
+  ACE_InputCDR encap (cdr, encap_length);
+  encap.read_ulong (ul);
+  sink.add (&ul, sizeof ul);
+  ACE_CDR::Char *s = 0;
+  encap.read_string (s);
+  if (s != 0)
+    sink.add (s, ACE_OS::strlen (s) + 1);
+  delete [] s;
+  if (!encap.good_bit ())
+    sink.add ("bad encapsulation", 17);
+  cdr.skip_bytes (encap_length);
+
+  ACE_CDR::Octet octets[n_octets];
+  cdr.read_octet_array (octets, n_octets);
+  sink.add (octets, sizeof octets);
+}
+
+static void
+write_arrays (ACE_OutputCDR &out)
+{
+  ACE_CDR::UShort s[n_shorts];
+  for (ACE_CDR::ULong i = 0; i != n_shorts; ++i)
+    s[i] = static_cast<ACE_CDR::UShort> (0x0102 * (i + 1));
+  ACE_CDR::ULong l[n_longs];
+  for (ACE_CDR::ULong i = 0; i != n_longs; ++i)
+    l[i] = 0x01020304 * (i + 1);
+  ACE_CDR::ULongLong ll[n_longlongs];
+  for (ACE_CDR::ULong i = 0; i != n_longlongs; ++i)
+    ll[i] = ACE_UINT64_LITERAL (0x0102030405060708) * (i + 1);
+  ACE_CDR::LongDouble ld[n_longdoubles];
+  for (ACE_CDR::ULong i = 0; i != sizeof ld; ++i)
+    reinterpret_cast<char *> (ld)[i] = static_cast<char> (i);
+
+  // An octet first, so the arrays need padding.
+  out.write_octet (9);
+  out.write_ushort_array (s, n_shorts);
+  out.write_ulong_array (l, n_longs);
+  out.write_octet (9);
+  out.write_ulonglong_array (ll, n_longlongs);
+  out.write_octet (9);
+  out.write_longdouble_array (ld, n_longdoubles);
+}
+
+static void
+read_arrays (ACE_InputCDR &cdr, Sink &sink)
+{
+  ACE_CDR::Octet o = 0;
+  ACE_CDR::UShort s[n_shorts];
+  ACE_CDR::ULong l[n_longs];
+  ACE_CDR::ULongLong ll[n_longlongs];
+  ACE_CDR::LongDouble ld[n_longdoubles];
+  ACE_OS::memset (s, 0, sizeof s);
+  ACE_OS::memset (l, 0, sizeof l);
+  ACE_OS::memset (ll, 0, sizeof ll);
+  ACE_OS::memset (ld, 0, sizeof ld);
+
+  cdr.read_octet (o);
+  sink.add (&o, sizeof o);
+  cdr.read_ushort_array (s, n_shorts);
+  sink.add (s, sizeof s);
+  cdr.read_ulong_array (l, n_longs);
+  sink.add (l, sizeof l);
+  cdr.read_octet (o);
+  sink.add (&o, sizeof o);
+  cdr.read_ulonglong_array (ll, n_longlongs);
+  sink.add (ll, sizeof ll);
+  cdr.read_octet (o);
+  sink.add (&o, sizeof o);
+  cdr.read_longdouble_array (ld, n_longdoubles);
+  sink.add (ld, sizeof ld);
+}
+
+// Copy @a len bytes of @a data to a chain of blocks of @a step bytes.
+// Each block starts at the offset of its data modulo MAX_ALIGNMENT,
+// unless @a misalign is set, then all but the first are shifted.
+static ACE_Message_Block *
+split (const char *data, size_t len, size_t step, bool misalign)
+{
+  ACE_Message_Block *head = 0;
+  ACE_Message_Block *tail = 0;
+
+  for (size_t pos = 0; pos < len; pos += step)
+    {
+      size_t const n = len - pos < step ? len - pos : step;
+      ACE_Message_Block *mb = 0;
+      ACE_NEW_RETURN (mb,
+                      ACE_Message_Block (n + 2 * ACE_CDR::MAX_ALIGNMENT),
+                      head);
+      ACE_CDR::mb_align (mb);
+      size_t offset = pos % ACE_CDR::MAX_ALIGNMENT;
+      if (misalign && pos != 0)
+        offset = (offset + 3) % ACE_CDR::MAX_ALIGNMENT;
+      mb->rd_ptr (offset);
+      mb->wr_ptr (offset);
+      mb->copy (data + pos, n);
+
+      if (tail == 0)
+        head = mb;
+      else
+        tail->cont (mb);
+      tail = mb;
+    }
+
+  return head;
+}
+
+static int
+check (const ACE_TCHAR *what,
+       size_t step,
+       bool misalign,
+       const Sink &expected,
+       const Sink &actual)
+{
+  if (expected == actual)
+    return 0;
+
+  ACE_ERROR ((LM_ERROR,
+              ACE_TEXT ("%s differs, blocks of %B bytes%s\n"),
+              what,
+              step,
+              misalign ? ACE_TEXT (", misaligned") : ACE_TEXT ("")));
+  return 1;
+}
+
+static int
+check_end (ACE_InputCDR &cdr, size_t step, bool misalign)
+{
+  ACE_CDR::Octet o = 0;
+  if (cdr.good_bit () && cdr.length () == 0 && !cdr.read_octet (o))
+    return 0;
+
+  ACE_ERROR ((LM_ERROR,
+              ACE_TEXT ("stream not at its end, blocks of %B bytes%s\n"),
+              step,
+              misalign ? ACE_TEXT (", misaligned") : ACE_TEXT ("")));
+  return 1;
+}
+
+static int
+test_chains (void)
+{
+  int errors = 0;
+
+  ACE_OutputCDR out;
+  write_mixed (out);
+  size_t const mixed_length = out.total_length ();
+  write_arrays (out);
+  out.consolidate ();
+  const char *const data = out.buffer ();
+  size_t const len = out.total_length ();
+
+  Sink mixed;
+  Sink arrays;
+  {
+    ACE_InputCDR cdr (data, len);
+    read_mixed (cdr, mixed);
+    read_arrays (cdr, arrays);
+    errors += check_end (cdr, len, false);
+  }
+
+  ACE_OutputCDR swapped_out;
+  write_arrays (swapped_out);
+  swapped_out.consolidate ();
+  Sink swapped;
+  {
+    ACE_InputCDR cdr (swapped_out.buffer (),
+                      swapped_out.total_length (),
+                      !ACE_CDR_BYTE_ORDER);
+    read_arrays (cdr, swapped);
+  }
+
+  static const size_t steps[] =
+    { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 15, 16, 17, 24, 31, 64, 509 };
+  size_t const empty = 0;
+
+  for (size_t i = 0; i != sizeof steps / sizeof steps[0]; ++i)
+    for (int m = 0; m != 2; ++m)
+      {
+        size_t const step = steps[i];
+        bool const misalign = m != 0;
+
+        ACE_Message_Block *chain = split (data, len, step, misalign);
+        if (chain == 0)
+          return ++errors;
+
+        // The stream holds its own references to the blocks.
+        ACE_InputCDR cdr (empty);
+        cdr.append (chain);
+        ACE_Message_Block::release (chain);
+
+        Sink m_actual;
+        read_mixed (cdr, m_actual);
+        errors += check (ACE_TEXT ("mixed"), step, misalign, mixed, m_actual);
+
+        ACE_InputCDR copy (cdr);
+        ACE_InputCDR assigned (empty);
+        assigned = cdr;
+
+        Sink a_actual;
+        read_arrays (cdr, a_actual);
+        errors += check (ACE_TEXT ("arrays"), step, misalign, arrays, a_actual);
+        errors += check_end (cdr, step, misalign);
+
+        Sink c_actual;
+        read_arrays (copy, c_actual);
+        errors += check (ACE_TEXT ("copy"), step, misalign, arrays, c_actual);
+        errors += check_end (copy, step, misalign);
+
+        if (assigned.consolidate () != 0 || assigned.start ()->cont () != 0)
+          {
+            ACE_ERROR ((LM_ERROR, ACE_TEXT ("consolidate failed\n")));
+            ++errors;
+          }
+        Sink s_actual;
+        read_arrays (assigned, s_actual);
+        errors += check (ACE_TEXT ("consolidated"), step, misalign,
+                         arrays, s_actual);
+        errors += check_end (assigned, step, misalign);
+
+        ACE_Message_Block *swapped_chain =
+          split (swapped_out.buffer (), swapped_out.total_length (),
+                 step, misalign);
+        ACE_InputCDR swapped_cdr (empty, !ACE_CDR_BYTE_ORDER);
+        swapped_cdr.append (swapped_chain);
+        ACE_Message_Block::release (swapped_chain);
+        Sink w_actual;
+        read_arrays (swapped_cdr, w_actual);
+        errors += check (ACE_TEXT ("swapped"), step, misalign,
+                         swapped, w_actual);
+        errors += check_end (swapped_cdr, step, misalign);
+      }
+
+  // Start from a data block, the way a protocol reads the first
+  // block, and append the rest of the message.
+  ACE_Message_Block *chain = split (data, len, mixed_length / 3, true);
+  ACE_InputCDR cdr (chain->data_block ()->duplicate (),
+                    0,
+                    static_cast<size_t> (chain->rd_ptr () - chain->base ()),
+                    static_cast<size_t> (chain->wr_ptr () - chain->base ()));
+  cdr.append (chain->cont ());
+  ACE_Message_Block::release (chain);
+
+  Sink m_actual;
+  Sink a_actual;
+  read_mixed (cdr, m_actual);
+  read_arrays (cdr, a_actual);
+  errors += check (ACE_TEXT ("mixed"), mixed_length / 3, true,
+                   mixed, m_actual);
+  errors += check (ACE_TEXT ("arrays"), mixed_length / 3, true,
+                   arrays, a_actual);
+  errors += check_end (cdr, mixed_length / 3, true);
+
+  return errors;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("CDR_Chain_Test"));
+
+  int const status = test_chains ();
+
+  ACE_END_TEST;
+
+  return status;
+}
@@ -373,6 +373,103 @@ short_stream (void)
   return 0;
 }
 
+// Reserve the size computed by an ACE_SizeCDR and check that the data
+// then goes into a single block.
+static int
+reserve_stream (void)
+{
+  ACE_CDR::ULong const count = 1024;
+  ACE_CDR::Long l_array[count];
+  ACE_CDR::Double d_array[count];
+  for (ACE_CDR::ULong i = 0; i != count; ++i)
+    {
+      l_array[i] = static_cast<ACE_CDR::Long> (i) - 512;
+      d_array[i] = i * 1.5;
+    }
+
+  ACE_Message_Block mb1 (100);
+  ACE_Message_Block mb2 (37);
+  mb1.wr_ptr (100);
+  mb2.wr_ptr (37);
+  mb1.cont (&mb2);
+
+  ACE_SizeCDR ss;
+  ss << ACE_CDR::ULong (count);
+  ss.write_long_array (l_array, count);
+  ss << "reserve";
+  ss.write_double_array (d_array, count);
+  ss.write_octet_array_mb (&mb1);
+
+  ACE_OutputCDR os (64);
+  os << ACE_OutputCDR::from_octet (1);
+
+  if (os.reserve (ss.total_length ()) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("reserve")),
+                      1);
+
+  const ACE_Message_Block *reserved = os.current ();
+  if (reserved == os.begin ())
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("reserve did not add a block\n")),
+                      1);
+
+  os << ACE_CDR::ULong (count);
+  os.write_long_array (l_array, count);
+  os << "reserve";
+  os.write_double_array (d_array, count);
+  // Copy the octets instead of chaining mb1 and mb2.
+  os.write_octet_array (reinterpret_cast<ACE_CDR::Octet *> (mb1.rd_ptr ()),
+                        100);
+  os.write_octet_array (reinterpret_cast<ACE_CDR::Octet *> (mb2.rd_ptr ()),
+                        37);
+
+  if (os.current () != reserved || os.begin ()->cont () != reserved)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("stream grew after reserve\n")),
+                      1);
+
+  if (os.total_length () - 1 > ss.total_length () + ACE_CDR::MAX_ALIGNMENT)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("size %B does not match %B\n"),
+                       os.total_length () - 1,
+                       ss.total_length ()),
+                      1);
+
+  // A stream with room left is not grown.
+  ACE_OutputCDR roomy (1024);
+  if (roomy.reserve (512) != 0 || roomy.current () != roomy.begin ())
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("reserve grew a stream with room left\n")),
+                      1);
+
+  ACE_InputCDR is (os);
+  ACE_CDR::Octet o = 0;
+  ACE_CDR::ULong len = 0;
+  ACE_CDR::Long l_in[count];
+  ACE_CDR::Double d_in[count];
+  ACE_CString str;
+  if (!(is >> ACE_InputCDR::to_octet (o))
+      || !(is >> len)
+      || !is.read_long_array (l_in, count)
+      || !(is >> str)
+      || !is.read_double_array (d_in, count)
+      || !is.skip_bytes (137))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("reading reserved stream failed\n")),
+                      1);
+
+  if (o != 1 || len != count || str != "reserve"
+      || ACE_OS::memcmp (l_in, l_array, sizeof (l_array)) != 0
+      || ACE_OS::memcmp (d_in, d_array, sizeof (d_array)) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("reserved stream data mismatch\n")),
+                      1);
+
+  return 0;
+}
+
 int
 CDR_Test_Types::test_put (ACE_OutputCDR &cdr)
 {
@@ -1027,7 +1124,14 @@ run_main (int argc, ACE_TCHAR *argv[])
     return 1;
 
   ACE_DEBUG ((LM_DEBUG,
-              ACE_TEXT ("Placeholder/Replace - no errors\n\n")));
+              ACE_TEXT ("Placeholder/Replace - no errors\n\n")
+              ACE_TEXT ("Testing reserve\n\n")));
+
+  if (reserve_stream () != 0)
+    return 1;
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Reserve - no errors\n\n")));
 
   ACE_END_TEST;
   return 0;
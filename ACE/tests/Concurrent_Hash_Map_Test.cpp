@@ -0,0 +1,587 @@
+//=============================================================================
+/**
+ *  @file    Concurrent_Hash_Map_Test.cpp
+ *
+ *  Tests ACE_Epoch_Manager and ACE_Concurrent_Hash_Map, first on their
+ *  own against ACE_Hash_Map_Manager_Ex, then with reader threads that
+ *  check what they find while writer threads retire nodes, or rebind,
+ *  unbind and grow the map under them.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Concurrent_Hash_Map_T.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Atomic_Op.h"
+#include "ace/SString.h"
+#include "ace/Null_Mutex.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+
+typedef ACE_Concurrent_Hash_Map<ACE_UINT32,
+                                ACE_UINT32,
+                                ACE_Hash<ACE_UINT32>,
+                                ACE_Equal_To<ACE_UINT32>,
+                                ACE_Thread_Mutex> CONCURRENT_MAP;
+
+typedef ACE_Hash_Map_Manager_Ex<ACE_UINT32,
+                                ACE_UINT32,
+                                ACE_Hash<ACE_UINT32>,
+                                ACE_Equal_To<ACE_UINT32>,
+                                ACE_Null_Mutex> REFERENCE_MAP;
+
+typedef ACE_Concurrent_Hash_Map<ACE_CString,
+                                ACE_CString,
+                                ACE_Hash<ACE_CString>,
+                                ACE_Equal_To<ACE_CString>,
+                                ACE_Null_Mutex> STRING_MAP;
+
+static ACE_UINT32
+next_random (ACE_UINT32 &seed)
+{
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+// A node that counts its reclamation.
+struct Counted_Node : public ACE_Epoch_Node
+{
+  static void cleanup (void *node, void *count)
+  {
+    ++*static_cast<size_t *> (count);
+    delete static_cast<Counted_Node *> (static_cast<ACE_Epoch_Node *> (node));
+  }
+};
+
+static int
+test_epoch_manager (void)
+{
+  int status = 0;
+  size_t reclaimed = 0;
+  ACE_Epoch_Manager manager (&reclaimed);
+
+  {
+    ACE_Epoch_Guard *guard = 0;
+    ACE_NEW_RETURN (guard, ACE_Epoch_Guard (manager), 1);
+
+    for (int i = 0; i < 10; ++i)
+      manager.retire (new Counted_Node, &Counted_Node::cleanup);
+
+    // The copy keeps the reader in after the original is gone.
+    ACE_Epoch_Guard copy (*guard);
+    delete guard;
+
+    for (int i = 0; i < 5; ++i)
+      manager.reclaim ();
+
+    if (reclaimed != 0 || manager.pending () != 10)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%B nodes reclaimed under a reader\n"),
+                    reclaimed));
+        status = 1;
+      }
+  }
+
+  for (int i = 0; i < 2; ++i)
+    manager.reclaim ();
+
+  if (reclaimed != 10 || manager.pending () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B nodes reclaimed, %B pending after the reader left\n"),
+                  reclaimed, manager.pending ()));
+      status = 1;
+    }
+
+  // Without readers, the nodes go as the epoch advances.
+  for (int i = 0; i < 1000; ++i)
+    manager.retire (new Counted_Node, &Counted_Node::cleanup);
+
+  if (manager.pending () > 3 * ACE_EPOCH_MANAGER_RECLAIM_INTERVAL)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B nodes pending without readers\n"),
+                  manager.pending ()));
+      status = 1;
+    }
+
+  manager.reclaim_all ();
+  if (reclaimed != 1010)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("reclaim_all left nodes\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+// Readers keep following a shared pointer while writers replace it
+// and retire the old node, and another thread advances the epoch as
+// fast as it can.  A reader must never see a node that was reclaimed;
+// the cleanup hook clears the mark before it frees the node, so the
+// reader notices, and ASan or TSan catch the use after free too.
+struct Stress_Node : public ACE_Epoch_Node
+{
+  // Keep the mark away from what the allocator reuses of a free block.
+  ACE_UINT64 pad_[2];
+  ACE_UINT64 mark_;
+
+  static void cleanup (void *node, void *)
+  {
+    Stress_Node *const self =
+      static_cast<Stress_Node *> (static_cast<ACE_Epoch_Node *> (node));
+    __atomic_store_n (&self->mark_, ACE_UINT64 (0), __ATOMIC_RELAXED);
+    delete self;
+  }
+};
+
+static ACE_UINT64 const live_mark = ACE_UINT64_LITERAL (0x5AFE5AFE5AFE5AFE);
+static int const stress_iterations = 200000;
+static size_t const n_stress_readers = 4;
+static size_t const n_stress_writers = 2;
+
+static ACE_Epoch_Manager *stress_manager = 0;
+static Stress_Node *stress_node = 0;
+static ACE_Atomic_Op<ACE_Thread_Mutex, long> stress_writers_left;
+static ACE_Atomic_Op<ACE_Thread_Mutex, long> stress_errors;
+
+static Stress_Node *
+make_stress_node (void)
+{
+  Stress_Node *node = 0;
+  ACE_NEW_RETURN (node, Stress_Node, 0);
+  node->mark_ = live_mark;
+  return node;
+}
+
+static ACE_THR_FUNC_RETURN
+stress_writer (void *)
+{
+  for (int i = 0; i < stress_iterations; ++i)
+    {
+      Stress_Node *const node = make_stress_node ();
+      Stress_Node *const old =
+        __atomic_exchange_n (&stress_node, node, __ATOMIC_ACQ_REL);
+      stress_manager->retire (old, &Stress_Node::cleanup);
+      if (i % 64 == 0)
+        ACE_OS::thr_yield ();
+    }
+
+  --stress_writers_left;
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+stress_reclaimer (void *)
+{
+  while (stress_writers_left.value () > 0)
+    {
+      stress_manager->reclaim ();
+      ACE_OS::thr_yield ();
+    }
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+stress_reader (void *)
+{
+  size_t entered = 0;
+
+  while (stress_writers_left.value () > 0)
+    {
+      {
+        ACE_Epoch_Guard guard (*stress_manager);
+        Stress_Node *const node =
+          __atomic_load_n (&stress_node, __ATOMIC_ACQUIRE);
+
+        // Stay in a little, so the epoch moves under the reader.
+        for (int i = 0; i < 16; ++i)
+          if (__atomic_load_n (&node->mark_, __ATOMIC_RELAXED) != live_mark)
+            {
+              ++stress_errors;
+              break;
+            }
+        ++entered;
+      }
+
+      // The threads give up the processor now and then, the readers
+      // outside of their critical section, or on a single one the
+      // epoch hardly moves.
+      ACE_OS::thr_yield ();
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("(%t) stress reader entered %B times\n"),
+              entered));
+  return 0;
+}
+
+static int
+test_epoch_stress (void)
+{
+  int status = 0;
+  ACE_Epoch_Manager manager;
+  stress_manager = &manager;
+  stress_node = make_stress_node ();
+  stress_writers_left = static_cast<long> (n_stress_writers);
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (n_stress_readers,
+                                                ACE_THR_FUNC (stress_reader),
+                                                0,
+                                                THR_NEW_LWP | THR_JOINABLE) == -1
+      || ACE_Thread_Manager::instance ()->spawn (ACE_THR_FUNC (stress_reclaimer),
+                                                 0,
+                                                 THR_NEW_LWP | THR_JOINABLE) == -1
+      || ACE_Thread_Manager::instance ()->spawn_n (n_stress_writers,
+                                                   ACE_THR_FUNC (stress_writer),
+                                                   0,
+                                                   THR_NEW_LWP | THR_JOINABLE) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("spawn_n")),
+                      1);
+
+  ACE_Thread_Manager::instance ()->wait ();
+
+  if (stress_errors.value () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("readers saw %d reclaimed nodes\n"),
+                  static_cast<int> (stress_errors.value ())));
+      status = 1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("stress: epoch %Q, %B nodes pending\n"),
+              manager.epoch (),
+              manager.pending ()));
+
+  Stress_Node::cleanup (static_cast<ACE_Epoch_Node *> (stress_node), 0);
+  stress_node = 0;
+  stress_manager = 0;
+  return status;
+}
+
+// Random operations, checked against ACE_Hash_Map_Manager_Ex.
+static int
+test_against_reference (void)
+{
+  int status = 0;
+  CONCURRENT_MAP map (1);
+  REFERENCE_MAP reference;
+  ACE_UINT32 seed = 7;
+  size_t const operations = 200000;
+  ACE_UINT32 const key_range = 5000;
+
+  for (size_t i = 0; i < operations && status == 0; ++i)
+    {
+      ACE_UINT32 const key = next_random (seed) % key_range;
+      ACE_UINT32 const op = next_random (seed) % 5;
+      ACE_UINT32 value = 0;
+      ACE_UINT32 expected = 0;
+
+      int result = 0;
+      int expected_result = 0;
+      if (op == 0)
+        {
+          result = map.unbind (key, value);
+          expected_result = reference.unbind (key, expected);
+        }
+      else if (op == 1)
+        {
+          result = map.find (key, value);
+          expected_result = reference.find (key, expected);
+        }
+      else if (op == 2)
+        {
+          value = expected = static_cast<ACE_UINT32> (i);
+          result = map.trybind (key, value);
+          expected_result = reference.trybind (key, expected);
+        }
+      else
+        {
+          result = map.rebind (key, static_cast<ACE_UINT32> (i), value);
+          expected_result = reference.rebind (key, static_cast<ACE_UINT32> (i), expected);
+        }
+
+      if (result != expected_result || value != expected
+          || map.current_size () != reference.current_size ())
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("operation %u on key %u returned %d, ")
+                      ACE_TEXT ("expected %d, size %B, expected %B\n"),
+                      op, key, result, expected_result,
+                      map.current_size (), reference.current_size ()));
+          status = 1;
+        }
+    }
+
+  size_t seen = 0;
+  for (CONCURRENT_MAP::iterator iter = map.begin (); iter != map.end (); ++iter)
+    {
+      ACE_UINT32 expected = 0;
+      if (reference.find (iter->key (), expected) != 0
+          || expected != iter->item ())
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("iteration found unexpected key %u\n"),
+                      iter->key ()));
+          status = 1;
+        }
+      ++seen;
+    }
+
+  if (seen != reference.current_size ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("iteration saw %B entries, expected %B\n"),
+                  seen, reference.current_size ()));
+      status = 1;
+    }
+
+  if (map.bind (key_range, 1) != 0 || map.bind (key_range, 2) != 1
+      || map.find (key_range) != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("bind of a new and a bound key\n")));
+      status = 1;
+    }
+
+  map.unbind_all ();
+  if (map.current_size () != 0 || map.find (key_range) != -1
+      || map.begin () != map.end ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind_all left entries\n")));
+      status = 1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("reference: %B buckets, %B entries pending\n"),
+              map.total_size (), map.epoch_manager ().pending ()));
+  return status;
+}
+
+static int
+test_strings (void)
+{
+  int status = 0;
+  STRING_MAP map;
+  char key[32];
+
+  for (int i = 0; i < 5000; ++i)
+    {
+      ACE_OS::sprintf (key, "key %d", i);
+      map.bind (ACE_CString (key), ACE_CString (key + 4));
+    }
+
+  for (int i = 0; i < 5000; i += 2)
+    {
+      ACE_OS::sprintf (key, "key %d", i);
+      map.unbind (ACE_CString (key));
+    }
+
+  for (int i = 0; i < 5000; ++i)
+    {
+      ACE_OS::sprintf (key, "key %d", i);
+      ACE_CString value;
+      int const result = map.find (ACE_CString (key), value);
+      if ((i % 2 == 0) != (result == -1)
+          || (result == 0 && value != key + 4))
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("string key %C\n"), key));
+          status = 1;
+          break;
+        }
+    }
+
+  if (map.current_size () != 2500)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B string entries\n"),
+                  map.current_size ()));
+      status = 1;
+    }
+
+  return status;
+}
+
+// The stable keys are bound all along, the others come and go.  The
+// item of a key is always the key times 1000 plus something less than
+// 1000, so a reader can tell when it finds a wrong one.
+static ACE_UINT32 const stable_keys = 1000;
+static ACE_UINT32 const all_keys = 4000;
+static int const writer_iterations = 200000;
+static size_t const n_readers = 4;
+static size_t const n_writers = 2;
+
+static CONCURRENT_MAP *shared_map = 0;
+static ACE_Atomic_Op<ACE_Thread_Mutex, long> writers_left;
+static ACE_Atomic_Op<ACE_Thread_Mutex, long> errors;
+static ACE_Atomic_Op<ACE_Thread_Mutex, long> seed_source;
+
+static ACE_THR_FUNC_RETURN
+writer (void *)
+{
+  ACE_UINT32 seed = static_cast<ACE_UINT32> (++seed_source);
+
+  for (int i = 0; i < writer_iterations; ++i)
+    {
+      ACE_UINT32 const key = next_random (seed) % all_keys;
+      ACE_UINT32 const value = key * 1000 + next_random (seed) % 1000;
+
+      if (key < stable_keys || next_random (seed) % 2 == 0)
+        shared_map->rebind (key, value);
+      else
+        shared_map->unbind (key);
+    }
+
+  --writers_left;
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+reader (void *)
+{
+  ACE_UINT32 seed = static_cast<ACE_UINT32> (++seed_source);
+  size_t lookups = 0;
+  size_t iterations = 0;
+
+  while (writers_left.value () > 0)
+    {
+      for (int i = 0; i < 1000; ++i, ++lookups)
+        {
+          ACE_UINT32 const key = next_random (seed) % all_keys;
+          ACE_UINT32 value = 0;
+          int const result = shared_map->find (key, value);
+          if ((result == 0 && value / 1000 != key)
+              || (result != 0 && key < stable_keys))
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%t) key %u found %d with item %u\n"),
+                          key, result, value));
+              ++errors;
+            }
+        }
+
+      // Each stable key stays in the map, so the iteration sees it
+      // exactly once.
+      size_t stable_seen = 0;
+      for (CONCURRENT_MAP::iterator iter = shared_map->begin ();
+           !iter.done ();
+           iter.advance ())
+        {
+          if (iter->item () / 1000 != iter->key ())
+            ++errors;
+          if (iter->key () < stable_keys)
+            ++stable_seen;
+        }
+      ++iterations;
+
+      if (stable_seen != stable_keys)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) iteration saw %B stable keys\n"),
+                      stable_seen));
+          ++errors;
+        }
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("(%t) reader did %B lookups and %B iterations\n"),
+              lookups, iterations));
+  return 0;
+}
+
+static int
+test_concurrent (void)
+{
+  int status = 0;
+
+  // Start small, so that the table grows under the readers.
+  CONCURRENT_MAP map (1);
+  shared_map = &map;
+
+  for (ACE_UINT32 key = 0; key < stable_keys; ++key)
+    map.bind (key, key * 1000);
+
+  writers_left = static_cast<long> (n_writers);
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (n_readers,
+                                                ACE_THR_FUNC (reader),
+                                                0,
+                                                THR_NEW_LWP | THR_JOINABLE) == -1
+      || ACE_Thread_Manager::instance ()->spawn_n (n_writers,
+                                                   ACE_THR_FUNC (writer),
+                                                   0,
+                                                   THR_NEW_LWP | THR_JOINABLE) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("spawn_n")),
+                      1);
+
+  ACE_Thread_Manager::instance ()->wait ();
+
+  if (errors.value () != 0)
+    status = 1;
+
+  size_t seen = 0;
+  for (CONCURRENT_MAP::iterator iter = map.begin (); iter != map.end (); ++iter)
+    ++seen;
+
+  if (seen != map.current_size () || map.total_size () < seen)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B entries seen, size %B, %B buckets\n"),
+                  seen, map.current_size (), map.total_size ()));
+      status = 1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("concurrent: %B entries in %B buckets, ")
+              ACE_TEXT ("epoch %Q, %B entries pending\n"),
+              map.current_size (), map.total_size (),
+              map.epoch_manager ().epoch (),
+              map.epoch_manager ().pending ()));
+
+  // With the readers gone, two advances of the epoch reclaim all.
+  for (int i = 0; i < 3; ++i)
+    map.epoch_manager ().reclaim ();
+
+  if (map.epoch_manager ().pending () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B entries still pending\n"),
+                  map.epoch_manager ().pending ()));
+      status = 1;
+    }
+
+  shared_map = 0;
+  return status;
+}
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Concurrent_Hash_Map_Test"));
+
+  int status = 0;
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL)
+  status += test_epoch_manager ();
+  status += test_epoch_stress ();
+  status += test_against_reference ();
+  status += test_strings ();
+  status += test_concurrent ();
+#else
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("ACE_Concurrent_Hash_Map not supported on this platform\n")));
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL */
+
+  ACE_END_TEST;
+
+  return status;
+}
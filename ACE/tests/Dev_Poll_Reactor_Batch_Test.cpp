@@ -0,0 +1,322 @@
+//=============================================================================
+/**
+ *  @file    Dev_Poll_Reactor_Batch_Test.cpp
+ *
+ *  This test verifies the ready list of the ACE_Dev_Poll_Reactor when
+ *  more than one event is retrieved per wait:
+ *  - Several threads dispatch events for many handles and every byte
+ *    written must be read exactly once, with no handler being upcalled
+ *    by two threads at a time.
+ *  - Handlers removed while their events are still on the ready list
+ *    must not be dispatched any more.
+ *
+ *  The same tests are run against the ACE_Uring_Reactor if available.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/Reactor.h"
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Uring_Reactor.h"
+#include "ace/Pipe.h"
+#include "ace/ACE.h"
+#include "ace/Flag_Manip.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+
+#if defined (ACE_HAS_EVENT_POLL)
+
+// Number of events retrieved per wait.
+static const int event_batch = 16;
+
+// Number of pipes.
+static const size_t pipe_count = 128;
+
+// Number of bytes written to each pipe.
+static const int rounds = 20;
+
+// Number of event loop threads.
+static const int loop_threads = 4;
+
+// Total number of bytes read by all readers.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> total_received;
+
+class Reader : public ACE_Event_Handler
+{
+public:
+  Reader (void) : received_ (0), in_upcall_ (0), overlaps_ (0) {}
+
+  ACE_HANDLE get_handle (void) const { return this->pipe_.read_handle (); }
+
+  int handle_input (ACE_HANDLE fd)
+  {
+    // With EPOLLONESHOT the handler is suspended during the upcall, so
+    // no other thread may enter it now.
+    if (++this->in_upcall_ != 1)
+      ++this->overlaps_;
+
+    char c;
+    if (ACE::recv (fd, &c, 1) == 1)
+      {
+        ++this->received_;
+        ++total_received;
+      }
+
+    --this->in_upcall_;
+    return 0;
+  }
+
+  ACE_Pipe pipe_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> received_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> in_upcall_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> overlaps_;
+};
+
+class Event_Loop : public ACE_Task_Base
+{
+public:
+  Event_Loop (ACE_Reactor &reactor, long expected)
+    : reactor_ (reactor), expected_ (expected) {}
+
+  int svc (void)
+  {
+    ACE_Time_Value deadline = ACE_OS::gettimeofday () + ACE_Time_Value (20);
+    while (total_received.value () < this->expected_
+           && ACE_OS::gettimeofday () < deadline)
+      {
+        ACE_Time_Value tv (0, 50000);
+        this->reactor_.handle_events (tv);
+      }
+    return 0;
+  }
+
+private:
+  ACE_Reactor &reactor_;
+  long const expected_;
+};
+
+static bool
+test_concurrent_dispatch (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Testing %B handles with %d threads\n"),
+              pipe_count, loop_threads));
+
+  bool ok = true;
+  Reader readers[pipe_count];
+  total_received = 0;
+
+  for (size_t i = 0; i < pipe_count; ++i)
+    if (readers[i].pipe_.open () != 0
+        || reactor.register_handler (&readers[i],
+                                     ACE_Event_Handler::READ_MASK) != 0)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p %B\n"),
+                         ACE_TEXT ("register"), i), false);
+
+  long const expected = static_cast<long> (pipe_count) * rounds;
+  Event_Loop event_loop (reactor, expected);
+  if (event_loop.activate (THR_NEW_LWP | THR_JOINABLE, loop_threads) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("activate")), false);
+
+  for (int r = 0; r < rounds; ++r)
+    for (size_t i = 0; i < pipe_count; ++i)
+      ACE::send_n (readers[i].pipe_.write_handle (), "x", 1);
+
+  event_loop.wait ();
+
+  for (size_t i = 0; i < pipe_count; ++i)
+    {
+      if (readers[i].received_.value () != rounds)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Reader %B received %d, expected %d\n"),
+                      i, readers[i].received_.value (), rounds));
+          ok = false;
+        }
+      if (readers[i].overlaps_.value () != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Reader %B upcalled concurrently %d times\n"),
+                      i, readers[i].overlaps_.value ()));
+          ok = false;
+        }
+      reactor.remove_handler (&readers[i],
+                              ACE_Event_Handler::ALL_EVENTS_MASK |
+                              ACE_Event_Handler::DONT_CALL);
+      readers[i].pipe_.close ();
+    }
+
+  return ok;
+}
+
+/**
+ * The first one of these dispatched removes all the others, whose
+ * events were retrieved by the same wait, and registers them again
+ * with new pipes.  These usually get the same handles, and their
+ * stale events must not be dispatched.
+ */
+class Remover : public ACE_Event_Handler
+{
+public:
+  Remover (void) : peers_ (0), count_ (0), dispatched_ (0) {}
+
+  ACE_HANDLE get_handle (void) const { return this->pipe_.read_handle (); }
+
+  int handle_input (ACE_HANDLE fd)
+  {
+    char c;
+    ACE::recv (fd, &c, 1);
+    ++this->dispatched_;
+
+    if (this->dispatched_ == 1)
+      for (size_t i = 0; i < this->count_; ++i)
+        if (&this->peers_[i] != this && this->peers_[i].dispatched_ == 0)
+          {
+            this->reactor ()->remove_handler (&this->peers_[i],
+                                              ACE_Event_Handler::ALL_EVENTS_MASK |
+                                              ACE_Event_Handler::DONT_CALL);
+            this->peers_[i].pipe_.close ();
+            if (this->peers_[i].open () != 0
+                || this->reactor ()->register_handler
+                     (&this->peers_[i], ACE_Event_Handler::READ_MASK) != 0)
+              ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"),
+                          ACE_TEXT ("re-register")));
+          }
+    return 0;
+  }
+
+  /// Open the pipe, with a non-blocking read side so that a spurious
+  /// dispatch can't hang the test.
+  int open (void)
+  {
+    if (this->pipe_.open () != 0)
+      return -1;
+    return ACE::set_flags (this->pipe_.read_handle (), ACE_NONBLOCK);
+  }
+
+  ACE_Pipe pipe_;
+  Remover *peers_;
+  size_t count_;
+  int dispatched_;
+};
+
+static bool
+test_remove_queued (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing removal of queued events\n")));
+
+  // All of them fit on the ready list at once.
+  static const size_t count = event_batch / 2;
+  Remover removers[count];
+
+  for (size_t i = 0; i < count; ++i)
+    {
+      removers[i].peers_ = removers;
+      removers[i].count_ = count;
+      if (removers[i].open () != 0
+          || reactor.register_handler (&removers[i],
+                                       ACE_Event_Handler::READ_MASK) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p %B\n"),
+                           ACE_TEXT ("register"), i), false);
+    }
+
+  for (size_t i = 0; i < count; ++i)
+    ACE::send_n (removers[i].pipe_.write_handle (), "x", 1);
+
+  for (int i = 0; i < 5; ++i)
+    {
+      ACE_Time_Value tv (0, 50000);
+      reactor.handle_events (tv);
+    }
+
+  int dispatched = 0;
+  for (size_t i = 0; i < count; ++i)
+    {
+      dispatched += removers[i].dispatched_;
+      reactor.remove_handler (&removers[i],
+                              ACE_Event_Handler::ALL_EVENTS_MASK |
+                              ACE_Event_Handler::DONT_CALL);
+      removers[i].pipe_.close ();
+    }
+
+  if (dispatched != 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%d upcalls, expected 1\n"),
+                       dispatched), false);
+  return true;
+}
+
+static int
+run_tests (ACE_Reactor_Impl &impl, const ACE_TCHAR *name)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing %s\n"), name));
+
+  ACE_Reactor reactor (&impl);
+  int result = 0;
+
+  if (!test_concurrent_dispatch (reactor))
+    ++result;
+  if (!test_remove_queued (reactor))
+    ++result;
+
+  return result;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Dev_Poll_Reactor_Batch_Test"));
+  int result = 0;
+
+  {
+    ACE_Dev_Poll_Reactor dev_poll_reactor (ACE::max_handles (),
+                                           false,
+                                           0,
+                                           0,
+                                           0,
+                                           0,
+                                           1,
+                                           ACE_DEV_POLL_TOKEN::FIFO,
+                                           event_batch);
+    result += run_tests (dev_poll_reactor, ACE_TEXT ("ACE_Dev_Poll_Reactor"));
+  }
+
+#if defined (ACE_HAS_IO_URING)
+  {
+    ACE_Uring_Reactor uring_reactor (ACE::max_handles (),
+                                     false,
+                                     0,
+                                     0,
+                                     0,
+                                     0,
+                                     1,
+                                     ACE_DEV_POLL_TOKEN::FIFO,
+                                     ACE_DEFAULT_URING_REACTOR_ENTRIES,
+                                     event_batch);
+    if (uring_reactor.initialized ())
+      result += run_tests (uring_reactor, ACE_TEXT ("ACE_Uring_Reactor"));
+    else
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("ACE_Uring_Reactor is UNSUPPORTED by ")
+                  ACE_TEXT ("this kernel\n")));
+  }
+#endif /* ACE_HAS_IO_URING */
+
+  ACE_END_TEST;
+  return result;
+}
+
+#else
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Dev_Poll_Reactor_Batch_Test"));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("The epoll based ACE_Dev_Poll_Reactor is ")
+              ACE_TEXT ("UNSUPPORTED on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+#endif /* ACE_HAS_EVENT_POLL */
@@ -0,0 +1,272 @@
+//=============================================================================
+/**
+ *  @file    Dev_Poll_Reactor_Eventfd_Notify_Test.cpp
+ *
+ *  This test verifies the ACE_Dev_Poll_Reactor_Eventfd_Notify
+ *  notification strategy:
+ *  - Notifications sent concurrently by many threads are all dispatched
+ *    exactly once, while several threads run the event loop.
+ *  - A notification wakes up a thread waiting in handle_events().
+ *  - purge_pending_notifications() removes the queued notifications of
+ *    one handler only, and reference counts are balanced.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/Reactor.h"
+#include "ace/Dev_Poll_Reactor_Eventfd_Notify.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+
+#if defined (ACE_HAS_EVENT_POLL) && defined (ACE_HAS_EVENTFD)
+
+// Number of notifying threads.
+static const int producers = 8;
+
+// Number of notifications sent by each of them.
+static const int notifications = 10000;
+
+// Number of event loop threads.
+static const int loop_threads = 2;
+
+class Handler : public ACE_Event_Handler
+{
+public:
+  Handler (void) : count_ (0)
+  {
+    this->reference_counting_policy ().value (
+      ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
+  }
+
+  int handle_exception (ACE_HANDLE)
+  {
+    ++this->count_;
+    return 0;
+  }
+
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> count_;
+};
+
+class Producer : public ACE_Task_Base
+{
+public:
+  Producer (ACE_Reactor &reactor, Handler &handler)
+    : reactor_ (reactor), handler_ (handler) {}
+
+  int svc (void)
+  {
+    for (int i = 0; i < notifications; ++i)
+      if (this->reactor_.notify (&this->handler_) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("(%t) %p\n"),
+                           ACE_TEXT ("notify")), -1);
+    return 0;
+  }
+
+private:
+  ACE_Reactor &reactor_;
+  Handler &handler_;
+};
+
+class Event_Loop : public ACE_Task_Base
+{
+public:
+  Event_Loop (ACE_Reactor &reactor, Handler &handler, long expected)
+    : reactor_ (reactor), handler_ (handler), expected_ (expected) {}
+
+  int svc (void)
+  {
+    ACE_Time_Value deadline = ACE_OS::gettimeofday () + ACE_Time_Value (30);
+    while (this->handler_.count_.value () < this->expected_
+           && ACE_OS::gettimeofday () < deadline)
+      {
+        ACE_Time_Value tv (0, 50000);
+        this->reactor_.handle_events (tv);
+      }
+    return 0;
+  }
+
+private:
+  ACE_Reactor &reactor_;
+  Handler &handler_;
+  long const expected_;
+};
+
+static int
+test_concurrent_notify (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Testing %d producers and %d event loop threads\n"),
+              producers, loop_threads));
+
+  Handler handler;
+  long const expected = static_cast<long> (producers) * notifications;
+
+  Event_Loop event_loop (reactor, handler, expected);
+  Producer producer (reactor, handler);
+  if (event_loop.activate (THR_NEW_LWP | THR_JOINABLE, loop_threads) == -1
+      || producer.activate (THR_NEW_LWP | THR_JOINABLE, producers) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("activate")), 1);
+
+  producer.wait ();
+  event_loop.wait ();
+
+  int result = 0;
+  if (handler.count_.value () != expected)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Dispatched %d notifications, expected %d\n"),
+                  handler.count_.value (), expected));
+      ++result;
+    }
+
+  // Each queued notification held a reference that its dispatch
+  // released again.
+  if (handler.add_reference () != 2)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Unbalanced reference count\n")));
+      ++result;
+    }
+  handler.remove_reference ();
+
+  return result;
+}
+
+class Notifier : public ACE_Task_Base
+{
+public:
+  Notifier (ACE_Reactor &reactor, Handler &handler)
+    : reactor_ (reactor), handler_ (handler) {}
+
+  int svc (void)
+  {
+    ACE_OS::sleep (ACE_Time_Value (0, 200000));
+    return this->reactor_.notify (&this->handler_);
+  }
+
+private:
+  ACE_Reactor &reactor_;
+  Handler &handler_;
+};
+
+static int
+test_wakeup (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing wake-up of a waiting thread\n")));
+
+  Handler handler;
+  Notifier notifier (reactor, handler);
+  if (notifier.activate (THR_NEW_LWP | THR_JOINABLE) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("activate")), 1);
+
+  // The thread is woken once to reset the eventfd and once more for the
+  // notification; it must not wait for the timeout in between.
+  ACE_Time_Value const start = ACE_OS::gettimeofday ();
+  for (int i = 0; i < 4 && handler.count_.value () == 0; ++i)
+    {
+      ACE_Time_Value tv (10);
+      reactor.handle_events (tv);
+    }
+  ACE_Time_Value const elapsed = ACE_OS::gettimeofday () - start;
+
+  notifier.wait ();
+
+  if (handler.count_.value () != 1 || elapsed > ACE_Time_Value (5))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("Notification not dispatched promptly\n")),
+                      1);
+  return 0;
+}
+
+static int
+test_purge (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing purge_pending_notifications\n")));
+
+  Handler purged;
+  Handler kept;
+
+  for (int i = 0; i < 5; ++i)
+    {
+      reactor.notify (&purged);
+      reactor.notify (&kept);
+    }
+
+  int result = 0;
+  int const n = reactor.purge_pending_notifications (&purged);
+  if (n != 5)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Purged %d notifications, expected 5\n"), n));
+      ++result;
+    }
+
+  for (int i = 0; i < 20 && kept.count_.value () < 5; ++i)
+    {
+      ACE_Time_Value tv (0, 50000);
+      reactor.handle_events (tv);
+    }
+
+  if (purged.count_.value () != 0 || kept.count_.value () != 5)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Dispatched %d purged and %d kept ")
+                  ACE_TEXT ("notifications, expected 0 and 5\n"),
+                  purged.count_.value (), kept.count_.value ()));
+      ++result;
+    }
+
+  if (purged.add_reference () != 2 || kept.add_reference () != 2)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Unbalanced reference count\n")));
+      ++result;
+    }
+  purged.remove_reference ();
+  kept.remove_reference ();
+
+  return result;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Dev_Poll_Reactor_Eventfd_Notify_Test"));
+  int result = 0;
+
+  ACE_Dev_Poll_Reactor_Eventfd_Notify notify_strategy;
+  {
+    ACE_Dev_Poll_Reactor dev_poll_reactor (ACE::max_handles (),
+                                           false,
+                                           0,
+                                           0,
+                                           0,
+                                           &notify_strategy);
+    if (!dev_poll_reactor.initialized ())
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                         ACE_TEXT ("ACE_Dev_Poll_Reactor")), 1);
+
+    ACE_Reactor reactor (&dev_poll_reactor);
+
+    result += test_wakeup (reactor);
+    result += test_purge (reactor);
+    result += test_concurrent_notify (reactor);
+  }
+
+  ACE_END_TEST;
+  return result;
+}
+
+#else
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Dev_Poll_Reactor_Eventfd_Notify_Test"));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("eventfd notifications are UNSUPPORTED ")
+              ACE_TEXT ("on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+#endif /* ACE_HAS_EVENT_POLL && ACE_HAS_EVENTFD */
@@ -0,0 +1,337 @@
+//=============================================================================
+/**
+ *  @file    Dev_Poll_Reactor_Timerfd_Test.cpp
+ *
+ *  This test verifies timer expiry through a timerfd in the
+ *  ACE_Dev_Poll_Reactor (see ACE_Dev_Poll_Reactor::use_timer_fd()):
+ *  - Timers scheduled in one go, some of them cancelled, all expire
+ *    exactly once and never before their time, while several threads
+ *    run the event loop.
+ *  - Timers scheduled from an upcall and periodic timers expire.
+ *  - A timer scheduled by another thread wakes up a thread waiting
+ *    for events while no timer was scheduled.
+ *  - Timers still expire after the timerfd has been disabled again.
+ *
+ *  The same tests are run against the ACE_Uring_Reactor if available.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/Reactor.h"
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Uring_Reactor.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+
+#if defined (ACE_HAS_EVENT_POLL) && defined (ACE_HAS_TIMERFD)
+
+// Number of timers scheduled in one go.
+static const int timer_count = 200;
+
+// Number of event loop threads.
+static const int loop_threads = 4;
+
+class Timer_Handler : public ACE_Event_Handler
+{
+public:
+  Timer_Handler (void) : count_ (0), early_ (0) {}
+
+  virtual int handle_timeout (const ACE_Time_Value &current_time,
+                              const void *)
+  {
+    if (ACE_OS::gettimeofday () < this->deadline_
+        || current_time < this->deadline_)
+      ++this->early_;
+    ++this->count_;
+    return 0;
+  }
+
+  ACE_Time_Value deadline_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> count_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> early_;
+};
+
+class Event_Loop : public ACE_Task_Base
+{
+public:
+  Event_Loop (ACE_Reactor &reactor) : reactor_ (reactor), done_ (0) {}
+
+  virtual int svc (void)
+  {
+    ACE_Time_Value const end = ACE_OS::gettimeofday () + ACE_Time_Value (10);
+    while (this->done_.value () == 0 && ACE_OS::gettimeofday () < end)
+      {
+        ACE_Time_Value tv (0, 100000);
+        this->reactor_.handle_events (tv);
+      }
+    return 0;
+  }
+
+  ACE_Reactor &reactor_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> done_;
+};
+
+static int
+test_schedule_cancel (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing expiry of %d timers\n"),
+              timer_count));
+
+  Timer_Handler handlers[timer_count];
+  long ids[timer_count];
+
+  ACE_Time_Value const now = ACE_OS::gettimeofday ();
+  for (int i = 0; i < timer_count; ++i)
+    {
+      ACE_Time_Value const delay (0, ((i * 37) % 500) * 1000);
+      handlers[i].deadline_ = now + delay;
+      ids[i] = reactor.schedule_timer (&handlers[i], 0, delay);
+      if (ids[i] == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                           ACE_TEXT ("schedule_timer")), 1);
+    }
+
+  // Cancel every fifth timer, including the earliest one.
+  for (int i = 0; i < timer_count; i += 5)
+    reactor.cancel_timer (ids[i]);
+
+  Event_Loop loop (reactor);
+  if (loop.activate (THR_NEW_LWP | THR_JOINABLE, loop_threads) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("activate")), 1);
+
+  ACE_Time_Value const end = ACE_OS::gettimeofday () + ACE_Time_Value (5);
+  bool all_expired = false;
+  while (!all_expired && ACE_OS::gettimeofday () < end)
+    {
+      ACE_OS::sleep (ACE_Time_Value (0, 50000));
+      all_expired = true;
+      for (int i = 1; i < timer_count && all_expired; ++i)
+        if (i % 5 != 0 && handlers[i].count_.value () == 0)
+          all_expired = false;
+    }
+
+  // Give a timer that expires twice a chance to show up.
+  ACE_OS::sleep (ACE_Time_Value (0, 100000));
+  ++loop.done_;
+  loop.wait ();
+
+  int result = 0;
+  for (int i = 0; i < timer_count; ++i)
+    {
+      long const expected = i % 5 == 0 ? 0 : 1;
+      if (handlers[i].count_.value () != expected)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Timer %d expired %d times, expected %d\n"),
+                      i, handlers[i].count_.value (), expected));
+          ++result;
+        }
+      if (handlers[i].early_.value () != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Timer %d expired early\n"), i));
+          ++result;
+        }
+    }
+
+  return result;
+}
+
+class Rescheduler : public ACE_Event_Handler
+{
+public:
+  Rescheduler (void) : count_ (0) {}
+
+  virtual int handle_timeout (const ACE_Time_Value &, const void *)
+  {
+    // Schedule a batch of timers from the upcall, the first one
+    // earlier than any timer scheduled before.
+    if (this->count_++ == 0)
+      for (int i = 10; i > 0; --i)
+        this->reactor ()->schedule_timer (this,
+                                          0,
+                                          ACE_Time_Value (0, i * 1000));
+    return 0;
+  }
+
+  int count_;
+};
+
+static int
+test_upcall_and_periodic (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Testing timers scheduled from an upcall ")
+              ACE_TEXT ("and periodic timers\n")));
+
+  Rescheduler rescheduler;
+  rescheduler.reactor (&reactor);
+  Timer_Handler periodic;
+  Timer_Handler far_away;
+
+  reactor.schedule_timer (&far_away, 0, ACE_Time_Value (3600));
+  reactor.schedule_timer (&rescheduler, 0, ACE_Time_Value (0, 1000));
+  long const periodic_id =
+    reactor.schedule_timer (&periodic,
+                            0,
+                            ACE_Time_Value (0, 2000),
+                            ACE_Time_Value (0, 2000));
+
+  ACE_Time_Value const end = ACE_OS::gettimeofday () + ACE_Time_Value (5);
+  while ((rescheduler.count_ < 11 || periodic.count_.value () < 20)
+         && ACE_OS::gettimeofday () < end)
+    {
+      ACE_Time_Value tv (0, 100000);
+      reactor.handle_events (tv);
+    }
+
+  reactor.cancel_timer (periodic_id);
+  reactor.cancel_timer (&far_away);
+  reactor.cancel_timer (&rescheduler);
+
+  int result = 0;
+  if (rescheduler.count_ != 11)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d timers scheduled from an upcall expired, ")
+                  ACE_TEXT ("expected 11\n"),
+                  rescheduler.count_));
+      ++result;
+    }
+  if (periodic.count_.value () < 20)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Periodic timer expired %d times, ")
+                  ACE_TEXT ("expected at least 20\n"),
+                  periodic.count_.value ()));
+      ++result;
+    }
+  if (far_away.count_.value () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Timer expired too early\n")));
+      ++result;
+    }
+
+  return result;
+}
+
+class Scheduler : public ACE_Task_Base
+{
+public:
+  Scheduler (ACE_Reactor &reactor, Timer_Handler &handler)
+    : reactor_ (reactor), handler_ (handler) {}
+
+  virtual int svc (void)
+  {
+    ACE_OS::sleep (ACE_Time_Value (0, 200000));
+    ACE_Time_Value const delay (0, 50000);
+    this->handler_.deadline_ = ACE_OS::gettimeofday () + delay;
+    this->reactor_.schedule_timer (&this->handler_, 0, delay);
+    return 0;
+  }
+
+private:
+  ACE_Reactor &reactor_;
+  Timer_Handler &handler_;
+};
+
+static int
+test_wakeup (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Testing a timer scheduled by another thread\n")));
+
+  Timer_Handler handler;
+  Scheduler scheduler (reactor, handler);
+  if (scheduler.activate (THR_NEW_LWP | THR_JOINABLE) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("activate")), 1);
+
+  // No timer is scheduled yet, so the thread waits for as long as it
+  // is allowed to; the new timer must cut that short.
+  ACE_Time_Value const start = ACE_OS::gettimeofday ();
+  for (int i = 0; i < 4 && handler.count_.value () == 0; ++i)
+    {
+      ACE_Time_Value tv (10);
+      reactor.handle_events (tv);
+    }
+  ACE_Time_Value const elapsed = ACE_OS::gettimeofday () - start;
+
+  scheduler.wait ();
+
+  if (handler.count_.value () != 1
+      || handler.early_.value () != 0
+      || elapsed > ACE_Time_Value (5))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("Timer not dispatched on time\n")),
+                      1);
+  return 0;
+}
+
+static int
+run_tests (ACE_Dev_Poll_Reactor &impl, const ACE_TCHAR *name)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing %s\n"), name));
+
+  ACE_Reactor reactor (&impl);
+  int result = 0;
+
+  if (impl.use_timer_fd () == -1 || !impl.uses_timer_fd ())
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("use_timer_fd")), 1);
+
+  result += test_schedule_cancel (reactor);
+  result += test_upcall_and_periodic (reactor);
+  result += test_wakeup (reactor);
+
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing with the timerfd disabled\n")));
+  if (impl.use_timer_fd (false) == -1 || impl.uses_timer_fd ())
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("use_timer_fd")), result + 1);
+
+  result += test_upcall_and_periodic (reactor);
+
+  return result;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Dev_Poll_Reactor_Timerfd_Test"));
+  int result = 0;
+
+  {
+    ACE_Dev_Poll_Reactor dev_poll_reactor;
+    result += run_tests (dev_poll_reactor, ACE_TEXT ("ACE_Dev_Poll_Reactor"));
+  }
+
+#if defined (ACE_HAS_IO_URING)
+  {
+    ACE_Uring_Reactor uring_reactor;
+    if (uring_reactor.initialized ())
+      result += run_tests (uring_reactor, ACE_TEXT ("ACE_Uring_Reactor"));
+    else
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("ACE_Uring_Reactor is UNSUPPORTED by ")
+                  ACE_TEXT ("this kernel\n")));
+  }
+#endif /* ACE_HAS_IO_URING */
+
+  ACE_END_TEST;
+  return result;
+}
+
+#else
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Dev_Poll_Reactor_Timerfd_Test"));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("timerfd timer expiry is UNSUPPORTED ")
+              ACE_TEXT ("on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+#endif /* ACE_HAS_EVENT_POLL && ACE_HAS_TIMERFD */
@@ -0,0 +1,337 @@
+//=============================================================================
+/**
+ *  @file    Flat_Hash_Map_Test.cpp
+ *
+ *  Tests ACE_Flat_Hash_Map against ACE_Hash_Map_Manager_Ex, with keys
+ *  that collide, tables that grow and shrink back, and iterators.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Flat_Hash_Map_T.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/SString.h"
+#include "ace/Null_Mutex.h"
+
+typedef ACE_Flat_Hash_Map<ACE_UINT32,
+                          ACE_UINT32,
+                          ACE_Hash<ACE_UINT32>,
+                          ACE_Equal_To<ACE_UINT32>,
+                          ACE_Null_Mutex> FLAT_MAP;
+
+typedef ACE_Hash_Map_Manager_Ex<ACE_UINT32,
+                                ACE_UINT32,
+                                ACE_Hash<ACE_UINT32>,
+                                ACE_Equal_To<ACE_UINT32>,
+                                ACE_Null_Mutex> REFERENCE_MAP;
+
+typedef ACE_Flat_Hash_Map<ACE_CString,
+                          ACE_CString,
+                          ACE_Hash<ACE_CString>,
+                          ACE_Equal_To<ACE_CString>,
+                          ACE_Null_Mutex> STRING_MAP;
+
+// Hashes every key to the same value, so that all of them collide.
+struct Constant_Hash
+{
+  u_long operator() (ACE_UINT32) const { return 42; }
+};
+
+typedef ACE_Flat_Hash_Map<ACE_UINT32,
+                          ACE_UINT32,
+                          Constant_Hash,
+                          ACE_Equal_To<ACE_UINT32>,
+                          ACE_Null_Mutex> COLLIDING_MAP;
+
+static ACE_UINT32
+next_random (ACE_UINT32 &seed)
+{
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+static int
+test_bind_find_unbind (void)
+{
+  int status = 0;
+  FLAT_MAP map;
+
+  if (map.current_size () != 0 || map.find (1) != -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("new map is not empty\n")));
+      status = 1;
+    }
+
+  if (map.bind (1, 10) != 0 || map.bind (1, 11) != 1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("bind of a new key and of a bound key\n")));
+      status = 1;
+    }
+
+  ACE_UINT32 value = 12;
+  if (map.trybind (1, value) != 1 || value != 10)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("trybind of a bound key got %u\n"), value));
+      status = 1;
+    }
+
+  ACE_UINT32 old_value = 0;
+  if (map.rebind (1, 13, old_value) != 1 || old_value != 10
+      || map.find (1, value) != 0 || value != 13)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("rebind of a bound key\n")));
+      status = 1;
+    }
+
+  ACE_UINT32 old_key = 0;
+  if (map.rebind (2, 20, old_key, old_value) != 0 || map.current_size () != 2)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("rebind of a new key\n")));
+      status = 1;
+    }
+
+  FLAT_MAP::ENTRY *entry = 0;
+  if (map.find (2, entry) != 0 || entry->key () != 2 || entry->item () != 20)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("find of an entry\n")));
+      status = 1;
+    }
+  else if (map.unbind (entry) != 0 || map.find (2) != -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind of an entry\n")));
+      status = 1;
+    }
+
+  FLAT_MAP::iterator pos = map.end ();
+  map.find (1, pos);
+  if (pos == map.end () || (*pos).item () != 13)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("find of an iterator\n")));
+      status = 1;
+    }
+  else if (map.unbind (pos) != 0 || map.current_size () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind of an iterator\n")));
+      status = 1;
+    }
+
+  map.find (1, pos);
+  if (pos != map.end () || map.unbind (1) != -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("find or unbind of an unbound key\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+// Random binds and unbinds, checked against ACE_Hash_Map_Manager_Ex.
+template <class MAP>
+static int
+test_against_reference (const ACE_TCHAR *name, ACE_UINT32 key_range)
+{
+  int status = 0;
+  MAP map;
+  REFERENCE_MAP reference;
+  ACE_UINT32 seed = 7;
+  size_t const operations = 200000;
+
+  for (size_t i = 0; i < operations && status == 0; ++i)
+    {
+      ACE_UINT32 const key = next_random (seed) % key_range;
+      ACE_UINT32 const op = next_random (seed) % 4;
+      ACE_UINT32 value = 0;
+      ACE_UINT32 expected = 0;
+
+      int result = 0;
+      int expected_result = 0;
+      if (op == 0)
+        {
+          result = map.unbind (key, value);
+          expected_result = reference.unbind (key, expected);
+        }
+      else if (op == 1)
+        {
+          result = map.find (key, value);
+          expected_result = reference.find (key, expected);
+        }
+      else
+        {
+          result = map.rebind (key, static_cast<ACE_UINT32> (i));
+          expected_result = reference.rebind (key, static_cast<ACE_UINT32> (i));
+        }
+
+      if (result != expected_result || value != expected
+          || map.current_size () != reference.current_size ())
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%s: operation %u on key %u returned %d, ")
+                      ACE_TEXT ("expected %d, size %B, expected %B\n"),
+                      name, op, key, result, expected_result,
+                      map.current_size (), reference.current_size ()));
+          status = 1;
+        }
+    }
+
+  // The iteration sees every entry of the reference map once.
+  size_t seen = 0;
+  for (typename MAP::iterator iter = map.begin (); iter != map.end (); ++iter)
+    {
+      ACE_UINT32 expected = 0;
+      if (reference.find (iter->key (), expected) != 0
+          || expected != iter->item ())
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%s: iteration found unexpected key %u\n"),
+                      name, iter->key ()));
+          status = 1;
+        }
+      ++seen;
+    }
+
+  if (seen != reference.current_size ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: iteration saw %B entries, expected %B\n"),
+                  name, seen, reference.current_size ()));
+      status = 1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%s: %B entries in %B slots\n"),
+              name, map.current_size (), map.total_size ()));
+  return status;
+}
+
+static int
+test_growth (void)
+{
+  int status = 0;
+  FLAT_MAP map (1);
+  size_t const initial = map.total_size ();
+  ACE_UINT32 const count = 100000;
+
+  for (ACE_UINT32 i = 0; i < count; ++i)
+    map.bind (i, i * 2);
+
+  if (map.current_size () != count || map.total_size () < count)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B entries in %B slots after binding %u\n"),
+                  map.current_size (), map.total_size (), count));
+      status = 1;
+    }
+
+  for (ACE_UINT32 i = 0; i < count; ++i)
+    {
+      ACE_UINT32 value = 0;
+      if (map.find (i, value) != 0 || value != i * 2)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("key %u lost while growing\n"), i));
+          status = 1;
+          break;
+        }
+    }
+
+  // Unbinding everything while iterating leaves the iterator valid.
+  for (FLAT_MAP::iterator iter = map.begin (); !iter.done (); iter.advance ())
+    map.unbind (iter);
+
+  if (map.current_size () != 0 || map.begin () != map.end ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("map not empty after unbinding all\n")));
+      status = 1;
+    }
+
+  // Churning through keys with a constant number of entries reuses
+  // the slots rather than growing the table.
+  FLAT_MAP small;
+  for (ACE_UINT32 i = 0; i < count; ++i)
+    {
+      small.bind (i, i);
+      if (i >= 4)
+        small.unbind (i - 4);
+    }
+
+  if (small.current_size () != 4 || small.total_size () != initial)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("churn left %B entries in %B slots\n"),
+                  small.current_size (), small.total_size ()));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_strings (void)
+{
+  int status = 0;
+  STRING_MAP map;
+  char key[32];
+
+  for (int i = 0; i < 5000; ++i)
+    {
+      ACE_OS::sprintf (key, "key %d", i);
+      map.bind (ACE_CString (key), ACE_CString (key + 4));
+    }
+
+  for (int i = 0; i < 5000; i += 2)
+    {
+      ACE_OS::sprintf (key, "key %d", i);
+      map.unbind (ACE_CString (key));
+    }
+
+  for (int i = 0; i < 5000; ++i)
+    {
+      ACE_OS::sprintf (key, "key %d", i);
+      ACE_CString value;
+      int const result = map.find (ACE_CString (key), value);
+      if ((i % 2 == 0) != (result == -1)
+          || (result == 0 && value != key + 4))
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("string key %C\n"), key));
+          status = 1;
+          break;
+        }
+    }
+
+  STRING_MAP const &const_map = map;
+  size_t seen = 0;
+  for (STRING_MAP::const_iterator iter = const_map.begin ();
+       iter != const_map.end ();
+       ++iter)
+    ++seen;
+
+  if (seen != 2500 || map.current_size () != 2500)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%B string entries seen\n"), seen));
+      status = 1;
+    }
+
+  map.unbind_all ();
+  if (map.current_size () != 0 || map.find (ACE_CString ("key 1")) != -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("unbind_all left entries\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Flat_Hash_Map_Test"));
+
+  int status = test_bind_find_unbind ();
+  status += test_against_reference<FLAT_MAP> (ACE_TEXT ("flat map"), 5000);
+  status += test_against_reference<COLLIDING_MAP> (ACE_TEXT ("colliding keys"), 300);
+  status += test_growth ();
+  status += test_strings ();
+
+  ACE_END_TEST;
+
+  return status;
+}
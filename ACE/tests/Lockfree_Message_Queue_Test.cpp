@@ -0,0 +1,544 @@
+//=============================================================================
+/**
+ *  @file    Lockfree_Message_Queue_Test.cpp
+ *
+ *  Tests ACE_Lockfree_Message_Queue: the FIFO order, the accounting
+ *  and the timeouts of a single thread, the batch calls, waking up
+ *  blocked threads on deactivate and pulse, producers and consumers
+ *  that keep the queue alternately full and empty, and an
+ *  ACE_Lockfree_Task that runs like any ACE_Task.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Lockfree_Message_Queue_T.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Message_Block.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL) && defined (ACE_HAS_THREADS)
+
+static const size_t n_producers = 4;
+static const size_t n_consumers = 4;
+static const ACE_UINT32 n_messages = 20000;
+static const size_t batch_size = 8;
+
+// Block that carries the id of its producer and its sequence number.
+static ACE_Message_Block *
+make_block (ACE_UINT32 producer, ACE_UINT32 sequence)
+{
+  ACE_Message_Block *mb = 0;
+  ACE_NEW_RETURN (mb, ACE_Message_Block (2 * sizeof (ACE_UINT32)), 0);
+  ACE_OS::memcpy (mb->wr_ptr (), &producer, sizeof producer);
+  mb->wr_ptr (sizeof producer);
+  ACE_OS::memcpy (mb->wr_ptr (), &sequence, sizeof sequence);
+  mb->wr_ptr (sizeof sequence);
+  return mb;
+}
+
+static void
+read_block (ACE_Message_Block *mb, ACE_UINT32 &producer, ACE_UINT32 &sequence)
+{
+  ACE_OS::memcpy (&producer, mb->rd_ptr (), sizeof producer);
+  ACE_OS::memcpy (&sequence, mb->rd_ptr () + sizeof producer, sizeof sequence);
+}
+
+static int
+test_single_thread (void)
+{
+  int errors = 0;
+  ACE_Lockfree_Message_Queue queue (5);
+
+  if (queue.capacity () != 8)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("capacity is %B instead of 8\n"),
+                  queue.capacity ()));
+      ++errors;
+    }
+
+  if (!queue.is_empty () || queue.is_full ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("new queue isn't empty\n")));
+      ++errors;
+    }
+
+  for (ACE_UINT32 i = 0; i < 8; ++i)
+    if (queue.enqueue_tail (make_block (0, i)) != static_cast<int> (i + 1))
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("enqueue_tail %u doesn't count %u messages\n"),
+                    i, i + 1));
+        ++errors;
+      }
+
+  if (!queue.is_full ()
+      || queue.message_count () != 8
+      || queue.message_length () != 8 * 2 * sizeof (ACE_UINT32)
+      || queue.message_bytes () != 8 * 2 * sizeof (ACE_UINT32))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("full queue counts %B messages, %B length, %B bytes\n"),
+                  queue.message_count (),
+                  queue.message_length (),
+                  queue.message_bytes ()));
+      ++errors;
+    }
+
+  // A full queue times out.
+  ACE_Message_Block *extra = make_block (0, 8);
+  ACE_Time_Value timeout = ACE_OS::gettimeofday () + ACE_Time_Value (0, 10000);
+  if (queue.enqueue_tail (extra, &timeout) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("enqueue on a full queue didn't time out\n")));
+      ++errors;
+    }
+  extra->release ();
+
+  ACE_Message_Block *mb = 0;
+  if (queue.peek_dequeue_head (mb) != -1 || errno != ENOTSUP)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("peek_dequeue_head is supported\n")));
+      ++errors;
+    }
+
+  for (ACE_UINT32 i = 0; i < 8; ++i)
+    {
+      ACE_UINT32 producer = 0;
+      ACE_UINT32 sequence = 0;
+      if (queue.dequeue_head (mb) != static_cast<int> (7 - i))
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("dequeue_head %u failed\n"), i));
+          ++errors;
+          continue;
+        }
+      read_block (mb, producer, sequence);
+      if (sequence != i)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("dequeued message %u instead of %u\n"),
+                      sequence, i));
+          ++errors;
+        }
+      mb->release ();
+    }
+
+  if (!queue.is_empty () || queue.message_bytes () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("drained queue isn't empty\n")));
+      ++errors;
+    }
+
+  // An empty queue times out as well, also with a time in the past.
+  timeout = ACE_OS::gettimeofday () + ACE_Time_Value (0, 10000);
+  if (queue.dequeue_head (mb, &timeout) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("dequeue on an empty queue didn't time out\n")));
+      ++errors;
+    }
+  if (queue.dequeue_head (mb, &timeout) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("dequeue with a past time didn't fail\n")));
+      ++errors;
+    }
+
+  // Batches: more blocks than fit only partly go in before the time
+  // elapses, and come out in order.
+  ACE_Message_Block *blocks[12];
+  for (ACE_UINT32 i = 0; i < 12; ++i)
+    blocks[i] = make_block (0, i);
+  timeout = ACE_OS::gettimeofday () + ACE_Time_Value (0, 10000);
+  int const enqueued = queue.enqueue_tail_n (blocks, 12, &timeout);
+  if (enqueued != 8)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("enqueue_tail_n enqueued %d blocks instead of 8\n"),
+                  enqueued));
+      ++errors;
+    }
+  for (size_t i = 8; i < 12; ++i)
+    blocks[i]->release ();
+
+  ACE_Message_Block *out[12];
+  ACE_UINT32 expected = 0;
+  int n = 0;
+  while (queue.message_count () > 0 && (n = queue.dequeue_head_n (out, 3)) > 0)
+    for (int i = 0; i < n; ++i)
+      {
+        ACE_UINT32 producer = 0;
+        ACE_UINT32 sequence = 0;
+        read_block (out[i], producer, sequence);
+        if (sequence != expected++)
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("batch dequeued message %u out of order\n"),
+                        sequence));
+            ++errors;
+          }
+        out[i]->release ();
+      }
+  if (expected != 8)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("batches dequeued %u messages instead of 8\n"),
+                  expected));
+      ++errors;
+    }
+
+  // Messages left in the queue are released by close.
+  queue.enqueue_tail (make_block (0, 0));
+  queue.enqueue_tail (make_block (0, 1));
+  if (queue.close () != 2 || !queue.deactivated ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("close didn't release 2 messages\n")));
+      ++errors;
+    }
+
+  mb = make_block (0, 0);
+  if (queue.enqueue_tail (mb) != -1 || errno != ESHUTDOWN)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("closed queue accepted a message\n")));
+      ++errors;
+    }
+  queue.activate ();
+  if (queue.enqueue_tail (mb) != 1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("activated queue refused a message\n")));
+      mb->release ();
+      ++errors;
+    }
+
+  return errors;
+}
+
+static ACE_Atomic_Op<ACE_Thread_Mutex, long> wake_up_errors;
+
+// A consumer that blocks on an empty queue until it is deactivated
+// or pulsed.
+static ACE_THR_FUNC_RETURN
+blocked_consumer (void *arg)
+{
+  ACE_Lockfree_Message_Queue *queue =
+    static_cast<ACE_Lockfree_Message_Queue *> (arg);
+  ACE_Message_Block *mb = 0;
+
+  if (queue->dequeue_head (mb) != -1 || errno != ESHUTDOWN)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) blocked dequeue didn't fail with ESHUTDOWN\n")));
+      ++wake_up_errors;
+    }
+  return 0;
+}
+
+static int
+test_wake_up (void)
+{
+  int errors = 0;
+  ACE_Lockfree_Message_Queue queue (16);
+
+  for (int round = 0; round < 2; ++round)
+    {
+      bool const pulse = round == 1;
+
+      if (ACE_Thread_Manager::instance ()->spawn_n (2,
+                                                    ACE_THR_FUNC (blocked_consumer),
+                                                    &queue,
+                                                    THR_NEW_LWP | THR_JOINABLE) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 1);
+
+      // Give the consumers the time to go to sleep.
+      ACE_OS::sleep (ACE_Time_Value (0, 100000));
+
+      int const previous = pulse ? queue.pulse () : queue.deactivate ();
+      if (previous != ACE_Message_Queue_Base::ACTIVATED)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("queue wasn't active\n")));
+          ++errors;
+        }
+
+      ACE_Thread_Manager::instance ()->wait ();
+
+      if (pulse)
+        {
+          // A pulsed queue still takes messages.
+          ACE_Message_Block *mb = make_block (0, 0);
+          if (queue.enqueue_tail (mb) != 1 || queue.dequeue_head (mb) != 0)
+            {
+              ACE_ERROR ((LM_ERROR, ACE_TEXT ("pulsed queue doesn't work\n")));
+              ++errors;
+            }
+          else
+            mb->release ();
+        }
+
+      queue.activate ();
+    }
+
+  return errors + static_cast<int> (wake_up_errors.value ());
+}
+
+struct Shared
+{
+  ACE_Lockfree_Message_Queue queue_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> producer_id_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> consumer_id_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> received_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> errors_;
+
+  Shared (void)
+    : queue_ (64),
+      producer_id_ (0),
+      consumer_id_ (0),
+      received_ (0),
+      errors_ (0)
+  {
+  }
+};
+
+// Producers with an odd id enqueue in batches.
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  Shared *shared = static_cast<Shared *> (arg);
+  ACE_UINT32 const id = static_cast<ACE_UINT32> (shared->producer_id_++);
+  bool const batch = id % 2 == 1;
+  ACE_Message_Block *blocks[batch_size];
+
+  for (ACE_UINT32 i = 0; i < n_messages; )
+    {
+      if (!batch)
+        {
+          if (shared->queue_.enqueue_tail (make_block (id, i)) == -1)
+            {
+              ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("enqueue_tail")));
+              ++shared->errors_;
+              break;
+            }
+          ++i;
+          continue;
+        }
+
+      size_t n = 0;
+      for (; n < batch_size && i + n < n_messages; ++n)
+        blocks[n] = make_block (id, static_cast<ACE_UINT32> (i + n));
+      if (shared->queue_.enqueue_tail_n (blocks, n) != static_cast<int> (n))
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("enqueue_tail_n")));
+          ++shared->errors_;
+          break;
+        }
+      i += static_cast<ACE_UINT32> (n);
+    }
+
+  return 0;
+}
+
+// Consumers with an odd id dequeue in batches.  Each checks that it
+// gets the messages of every producer in order.
+static ACE_THR_FUNC_RETURN
+consumer (void *arg)
+{
+  Shared *shared = static_cast<Shared *> (arg);
+  bool const batch = shared->consumer_id_++ % 2 == 1;
+  ACE_Message_Block *blocks[batch_size];
+  long last[n_producers];
+  for (size_t i = 0; i < n_producers; ++i)
+    last[i] = -1;
+
+  for (;;)
+    {
+      int n = 0;
+      if (batch)
+        n = shared->queue_.dequeue_head_n (blocks, batch_size);
+      else if (shared->queue_.dequeue_head (blocks[0]) != -1)
+        n = 1;
+      else
+        n = -1;
+
+      if (n == -1)
+        {
+          if (errno != ESHUTDOWN)
+            {
+              ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("dequeue")));
+              ++shared->errors_;
+            }
+          break;
+        }
+
+      for (int i = 0; i < n; ++i)
+        {
+          ACE_UINT32 id = 0;
+          ACE_UINT32 sequence = 0;
+          read_block (blocks[i], id, sequence);
+          blocks[i]->release ();
+
+          if (id >= n_producers || static_cast<long> (sequence) <= last[id])
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%t) message %u of producer %u out of order\n"),
+                          sequence, id));
+              ++shared->errors_;
+            }
+          else
+            last[id] = static_cast<long> (sequence);
+        }
+      shared->received_ += n;
+    }
+
+  return 0;
+}
+
+static int
+test_concurrent (void)
+{
+  Shared shared;
+  ACE_Thread_Manager *tm = ACE_Thread_Manager::instance ();
+
+  int const consumers = tm->spawn_n (n_consumers,
+                                     ACE_THR_FUNC (consumer),
+                                     &shared,
+                                     THR_NEW_LWP | THR_JOINABLE);
+  int const producers = tm->spawn_n (n_producers,
+                                     ACE_THR_FUNC (producer),
+                                     &shared,
+                                     THR_NEW_LWP | THR_JOINABLE);
+  if (consumers == -1 || producers == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 1);
+
+  // Wait for the consumers to take every message, then let them go.
+  long const total = static_cast<long> (n_producers * n_messages);
+  while (shared.received_.value () < total && shared.errors_.value () == 0)
+    ACE_OS::sleep (ACE_Time_Value (0, 10000));
+  tm->wait_grp (producers);
+  shared.queue_.deactivate ();
+  tm->wait ();
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%B producers and %B consumers passed %d messages\n"),
+              n_producers,
+              n_consumers,
+              shared.received_.value ()));
+
+  if (shared.received_.value () != total || !shared.queue_.is_empty ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("received %d messages instead of %d\n"),
+                  shared.received_.value (),
+                  total));
+      return 1;
+    }
+
+  return static_cast<int> (shared.errors_.value ());
+}
+
+// A task that adds up what it gets from its queue, unaware of which
+// queue that is.
+class Summing_Task : public ACE_Lockfree_Task<ACE_MT_SYNCH>
+{
+public:
+  Summing_Task (void)
+    : ACE_Lockfree_Task<ACE_MT_SYNCH> (0, 32),
+      sum_ (0)
+  {
+  }
+
+  virtual int svc (void)
+  {
+    ACE_Message_Block *mb = 0;
+    while (this->getq (mb) != -1)
+      {
+        ACE_UINT32 producer = 0;
+        ACE_UINT32 sequence = 0;
+        read_block (mb, producer, sequence);
+        mb->release ();
+        this->sum_ += sequence;
+      }
+    return 0;
+  }
+
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> sum_;
+};
+
+static int
+test_task (void)
+{
+  int errors = 0;
+  Summing_Task task;
+
+  if (task.lockfree_queue () == 0
+      || task.lockfree_queue () != task.msg_queue ()
+      || task.lockfree_queue ()->queue ().capacity () != 32)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("task doesn't use a lock-free queue\n")));
+      ++errors;
+    }
+
+  if (task.activate (THR_NEW_LWP | THR_JOINABLE, 2) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("activate")), 1);
+
+  long expected = 0;
+  for (ACE_UINT32 i = 0; i < 1000; ++i)
+    {
+      if (task.putq (make_block (0, i)) == -1)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("putq")));
+          ++errors;
+          break;
+        }
+      expected += i;
+    }
+
+  ACE_Message_Block *mb = make_block (0, 0);
+  if (task.ungetq (mb) != -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("ungetq is supported\n")));
+      ++errors;
+    }
+  mb->release ();
+
+  while (!task.msg_queue ()->is_empty ())
+    ACE_OS::sleep (ACE_Time_Value (0, 10000));
+  task.msg_queue ()->deactivate ();
+  task.wait ();
+
+  if (task.sum_.value () != expected)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("task added up to %d instead of %d\n"),
+                  task.sum_.value (),
+                  expected));
+      ++errors;
+    }
+
+  return errors;
+}
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL && ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Lockfree_Message_Queue_Test"));
+
+  int status = 0;
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL) && defined (ACE_HAS_THREADS)
+  status += test_single_thread ();
+  status += test_wake_up ();
+  status += test_concurrent ();
+  status += test_task ();
+#else
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("ACE_Lockfree_Message_Queue not supported on this platform\n")));
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL && ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+
+  return status;
+}
@@ -0,0 +1,548 @@
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async_Test.cpp
+ *
+ *  Tests ACE_Log_Msg_Async: the records of several threads reach the
+ *  wrapped backend in their order, a full ring drops and counts the
+ *  records, the flush priorities are passed on at once, the ring of a
+ *  thread that exited is reused, ACE_Log_Msg logs through it as its
+ *  custom backend, and a signal handler can flush the rings while a
+ *  flush is passing the records on.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Async.h"
+#include "ace/Log_Record.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Signal.h"
+#include "ace/Thread_Manager.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL) && defined (ACE_HAS_THREADS)
+
+static const size_t n_producers = 4;
+static const unsigned long n_records = 5000;
+
+// Backend that counts the records it gets and checks that the ones of
+// each producer arrive in their order.
+class Backend : public ACE_Log_Msg_Backend
+{
+public:
+  Backend (void)
+    : open_ (false), close_ (false), log_count_ (0), out_of_order_ (0)
+  {
+    for (size_t i = 0; i != n_producers; ++i)
+      this->next_[i] = 0;
+  }
+
+  //FUZZ: disable check_for_lack_ACE_OS
+  ///FUZZ: enable check_for_lack_ACE_OS
+  virtual int open (const ACE_TCHAR *)
+  {
+    this->open_ = true;
+    return 0;
+  }
+
+  virtual int reset (void)
+  {
+    return 0;
+  }
+
+  //FUZZ: disable check_for_lack_ACE_OS
+  ///FUZZ: enable check_for_lack_ACE_OS
+  virtual int close (void)
+  {
+    this->close_ = true;
+    return 0;
+  }
+
+  // The text of the records is "<producer> <sequence>", the others
+  // are only counted.
+  virtual ssize_t log (ACE_Log_Record &log_record)
+  {
+    ++this->log_count_;
+
+    ACE_TCHAR *end = 0;
+    unsigned long const producer =
+      ACE_OS::strtoul (log_record.msg_data (), &end, 10);
+    if (end == log_record.msg_data () || producer >= n_producers)
+      return 0;
+
+    unsigned long const sequence = ACE_OS::strtoul (end, 0, 10);
+    if (sequence < this->next_[producer])
+      ++this->out_of_order_;
+    this->next_[producer] = sequence + 1;
+    return 0;
+  }
+
+  bool open_;
+  bool close_;
+  size_t log_count_;
+  size_t out_of_order_;
+  unsigned long next_[n_producers];
+};
+
+static void
+make_record (ACE_Log_Record &record,
+             ACE_Log_Priority type,
+             unsigned long producer,
+             unsigned long sequence)
+{
+  ACE_TCHAR text[64];
+  ACE_OS::sprintf (text, ACE_TEXT ("%lu %lu"), producer, sequence);
+  record.type (type);
+  record.msg_data (text);
+}
+
+static ACE_Log_Msg_Async *producer_async = 0;
+
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  unsigned long const id =
+    static_cast<unsigned long> (reinterpret_cast<size_t> (arg));
+  ACE_Log_Record record;
+
+  for (unsigned long i = 0; i != n_records; ++i)
+    {
+      make_record (record, LM_DEBUG, id, i);
+      producer_async->log (record);
+    }
+
+  return 0;
+}
+
+// Several threads log while the background thread passes the records
+// on; each record is either passed on in order or counted as dropped.
+static int
+test_concurrent (void)
+{
+  int status = 0;
+  Backend backend;
+  ACE_Log_Msg_Async async (&backend);
+  producer_async = &async;
+
+  async.open (ACE_TEXT ("Log_Msg_Async_Test"));
+
+  for (size_t i = 0; i != n_producers; ++i)
+    ACE_Thread_Manager::instance ()->spawn (producer,
+                                            reinterpret_cast<void *> (i));
+  ACE_Thread_Manager::instance ()->wait ();
+
+  async.close ();
+
+  size_t const total = n_producers * n_records;
+  size_t const dropped = static_cast<size_t> (async.dropped ());
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%B records passed on, %B dropped\n"),
+              backend.log_count_,
+              dropped));
+
+  if (!backend.open_ || !backend.close_)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Wrapped backend not opened and closed\n")));
+      ++status;
+    }
+
+  if (backend.log_count_ + dropped != total)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B records passed on and %B dropped, ")
+                  ACE_TEXT ("expected %B\n"),
+                  backend.log_count_,
+                  dropped,
+                  total));
+      ++status;
+    }
+
+  if (backend.out_of_order_ != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B records out of order\n"),
+                  backend.out_of_order_));
+      ++status;
+    }
+
+  return status;
+}
+
+// Without the background thread a small ring fills up; the records
+// that don't fit are dropped until the ring is flushed.
+static int
+test_drops (void)
+{
+  int status = 0;
+  Backend backend;
+  ACE_Log_Msg_Async async (&backend, 1024, 1);
+  ACE_Log_Record record;
+
+  unsigned long queued = 0;
+  for (unsigned long i = 0; i != 100; ++i)
+    {
+      make_record (record, LM_DEBUG, 0, i);
+      if (async.log (record) != -1)
+        ++queued;
+    }
+
+  if (queued == 0 || queued == 100 || async.dropped () != 100 - queued)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%lu records queued and %Q dropped\n"),
+                  queued,
+                  async.dropped ()));
+      ++status;
+    }
+
+  size_t const flushed = async.flush ();
+  if (flushed != queued || backend.log_count_ != queued)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B records flushed, expected %lu\n"),
+                  flushed,
+                  queued));
+      ++status;
+    }
+
+  // Now there is room again, also for a text that is truncated.
+  ACE_TCHAR text[2048];
+  for (size_t i = 0; i != 2047; ++i)
+    text[i] = ACE_TEXT ('x');
+  text[2047] = 0;
+  record.msg_data (text);
+  ssize_t const length = async.log (record);
+  if (length <= 0 || length >= 1024)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Long record queued with %b characters\n"),
+                  length));
+      ++status;
+    }
+
+  if (async.flush () != 1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Long record not passed on\n")));
+      ++status;
+    }
+
+  return status;
+}
+
+// A record of a flush priority takes the queued records with it.
+static int
+test_flush_priorities (void)
+{
+  int status = 0;
+  Backend backend;
+  ACE_Log_Msg_Async async (&backend);
+  ACE_Log_Record record;
+
+  for (unsigned long i = 0; i != 3; ++i)
+    {
+      make_record (record, LM_INFO, 0, i);
+      async.log (record);
+    }
+
+  if (backend.log_count_ != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B records passed on before the flush\n"),
+                  backend.log_count_));
+      ++status;
+    }
+
+  make_record (record, LM_CRITICAL, 0, 3);
+  async.log (record);
+
+  if (backend.log_count_ != 4 || backend.out_of_order_ != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B records passed on by LM_CRITICAL, ")
+                  ACE_TEXT ("expected 4\n"),
+                  backend.log_count_));
+      ++status;
+    }
+
+  async.flush_priorities (LM_INFO);
+  make_record (record, LM_INFO, 0, 4);
+  async.log (record);
+
+  if (backend.log_count_ != 5)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("LM_INFO not passed on as a flush priority\n")));
+      ++status;
+    }
+
+  return status;
+}
+
+static ACE_THR_FUNC_RETURN
+log_once (void *arg)
+{
+  ACE_Log_Record record;
+  make_record (record, LM_DEBUG, 0, 0);
+  *static_cast<ssize_t *> (arg) = producer_async->log (record);
+  return 0;
+}
+
+// With a single ring, a thread only gets it after the one that had it
+// exited and its records were passed on.
+static int
+test_reuse (void)
+{
+  int status = 0;
+  Backend backend;
+  ACE_Log_Msg_Async async (&backend, 1024, 1);
+  producer_async = &async;
+
+  for (int i = 0; i != 3; ++i)
+    {
+      ssize_t result = 0;
+      ACE_Thread_Manager::instance ()->spawn (log_once, &result);
+      ACE_Thread_Manager::instance ()->wait ();
+      async.flush ();
+
+      if (result == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Thread %d found no free ring\n"),
+                      i));
+          ++status;
+        }
+    }
+
+  if (backend.log_count_ != 3 || async.dropped () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B records passed on and %Q dropped, ")
+                  ACE_TEXT ("expected 3 and 0\n"),
+                  backend.log_count_,
+                  async.dropped ()));
+      ++status;
+    }
+
+  return status;
+}
+
+static ACE_THR_FUNC_RETURN
+log_msg_producer (void *arg)
+{
+  int const id = static_cast<int> (reinterpret_cast<size_t> (arg));
+
+  for (int i = 0; i != 100; ++i)
+    ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("%d %d\n"), id, i));
+
+  return 0;
+}
+
+// ACE_Log_Msg hands its records to the async backend, which passes
+// them on to the wrapped one.
+static int
+test_log_msg (void)
+{
+  int status = 0;
+  Backend backend;
+  ACE_Log_Msg_Async async (&backend);
+  ACE_Log_Msg_Backend *old_backend = ACE_Log_Msg::msg_backend (&async);
+
+  u_long const flags = ACE_LOG_MSG->flags ();
+  if (ACE_LOG_MSG->open (ACE_TEXT ("Log_Msg_Async_Test"),
+                         flags | ACE_Log_Msg::CUSTOM) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("Reopening log")));
+      ++status;
+    }
+
+  for (size_t i = 0; i != n_producers; ++i)
+    ACE_Thread_Manager::instance ()->spawn (log_msg_producer,
+                                            reinterpret_cast<void *> (i));
+  ACE_Thread_Manager::instance ()->wait ();
+
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::CUSTOM);
+  ACE_Log_Msg::msg_backend (old_backend);
+  async.close ();
+
+  if (backend.log_count_ + async.dropped () != n_producers * 100
+      || backend.out_of_order_ != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B records passed on, %Q dropped and %B out ")
+                  ACE_TEXT ("of order through ACE_Log_Msg\n"),
+                  backend.log_count_,
+                  async.dropped (),
+                  backend.out_of_order_));
+      ++status;
+    }
+
+  return status;
+}
+
+// Number of lines written to the pipe @a fds, which is closed.
+static int
+read_lines (ACE_HANDLE fds[2])
+{
+  ACE_OS::close (fds[1]);
+
+  int lines = 0;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = ACE_OS::read (fds[0], buffer, sizeof buffer)) > 0)
+    for (ssize_t i = 0; i != n; ++i)
+      if (buffer[i] == '\n')
+        ++lines;
+
+  ACE_OS::close (fds[0]);
+  return lines;
+}
+
+static void
+log_abort_records (ACE_Log_Msg_Async &async, int count)
+{
+  ACE_Log_Record record;
+  record.type (LM_DEBUG);
+  record.msg_data (ACE_TEXT ("written on abort\n"));
+
+  for (int i = 0; i != count; ++i)
+    async.log (record);
+}
+
+static ACE_THR_FUNC_RETURN
+log_two_abort_records (void *)
+{
+  log_abort_records (*producer_async, 2);
+  return 0;
+}
+
+#if !defined (ACE_LACKS_UNIX_SIGNALS)
+static ACE_HANDLE abort_handle = ACE_INVALID_HANDLE;
+static size_t abort_flushed = 0;
+static bool abort_handled = false;
+
+extern "C" void
+abort_handler (int)
+{
+  abort_flushed = producer_async->flush_on_abort (abort_handle);
+  abort_handled = true;
+}
+
+// Backend that interrupts the flush passing it the records with a
+// signal, whose handler flushes for an abort.
+class Signal_Backend : public Backend
+{
+public:
+  virtual ssize_t log (ACE_Log_Record &log_record)
+  {
+    if (this->log_count_ == 0)
+      ACE_OS::thr_kill (ACE_OS::thr_self (), SIGUSR1);
+
+    return Backend::log (log_record);
+  }
+};
+#endif /* !ACE_LACKS_UNIX_SIGNALS */
+
+// flush_on_abort() writes the texts without the wrapped backend, and
+// a signal handler can use it in the middle of a flush(): the ring
+// that flush() reads is skipped instead of waited for.
+static int
+test_flush_on_abort (void)
+{
+  int status = 0;
+
+  {
+    Backend backend;
+    ACE_Log_Msg_Async async (&backend, 1024, 1);
+    ACE_HANDLE fds[2];
+    if (ACE_OS::pipe (fds) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("pipe")), 1);
+
+    log_abort_records (async, 3);
+    size_t const flushed = async.flush_on_abort (fds[1]);
+    int const lines = read_lines (fds);
+
+    if (flushed != 3 || lines != 3 || backend.log_count_ != 0
+        || async.flush () != 0)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%B records flushed on abort, %d lines ")
+                    ACE_TEXT ("written, %B passed on, expected 3, 3, 0\n"),
+                    flushed,
+                    lines,
+                    backend.log_count_));
+        ++status;
+      }
+  }
+
+#if !defined (ACE_LACKS_UNIX_SIGNALS)
+  {
+    Signal_Backend backend;
+    ACE_Log_Msg_Async async (&backend, 1024, 2);
+    producer_async = &async;
+    ACE_HANDLE fds[2];
+    if (ACE_OS::pipe (fds) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("pipe")), 1);
+    abort_handle = fds[1];
+
+    // This thread gets the first ring, the one flush() is reading
+    // when the signal comes; the records of the other thread are
+    // written by the handler.
+    log_abort_records (async, 3);
+    ACE_Thread_Manager::instance ()->spawn (log_two_abort_records);
+    ACE_Thread_Manager::instance ()->wait ();
+
+    ACE_Sig_Action sa (reinterpret_cast<ACE_SignalHandler> (abort_handler),
+                       SIGUSR1);
+    size_t const flushed = async.flush ();
+    ACE_Sig_Action restore (static_cast<ACE_SignalHandler> (SIG_DFL),
+                            SIGUSR1);
+
+    int const lines = read_lines (fds);
+
+    if (!abort_handled || abort_flushed != 2 || lines != 2
+        || flushed != 3 || backend.log_count_ != 3)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("Signal handled %d, %B records flushed on ")
+                    ACE_TEXT ("abort, %d lines written, %B passed on, ")
+                    ACE_TEXT ("expected 1, 2, 2, 3\n"),
+                    static_cast<int> (abort_handled),
+                    abort_flushed,
+                    lines,
+                    flushed));
+        ++status;
+      }
+  }
+#endif /* !ACE_LACKS_UNIX_SIGNALS */
+
+  return status;
+}
+
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL && ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Async_Test"));
+
+  int status = 0;
+
+#if defined (ACE_HAS_GCC_ATOMIC_MEMORY_MODEL) && defined (ACE_HAS_THREADS)
+  status += test_concurrent ();
+  status += test_drops ();
+  status += test_flush_priorities ();
+  status += test_reuse ();
+  status += test_log_msg ();
+  status += test_flush_on_abort ();
+#else
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("ACE_Log_Msg_Async not supported on this platform\n")));
+#endif /* ACE_HAS_GCC_ATOMIC_MEMORY_MODEL && ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+
+  return status;
+}
@@ -46,6 +46,7 @@
   // and can only handle one connection.
 # define NUMBER_OF_MT_CONNECTIONS 1
 #endif /* ACE_WIN32 || !_ACE_USE_SV_SEM */
+#define NUMBER_OF_RING_CONNECTIONS 3
 
 #define NUMBER_OF_ITERATIONS 100
 
@@ -325,12 +326,16 @@ test_reactive (const ACE_TCHAR *prog,
 
 int
 test_concurrent (const ACE_TCHAR *prog,
-                 ACE_MEM_Addr &server_addr)
+                 ACE_MEM_Addr &server_addr,
+                 ACE_MEM_IO::Signal_Strategy strategy)
 {
-  ACE_DEBUG ((LM_DEBUG, "Testing Multithreaded MEM_Stream\n\n"));
+  if (strategy == ACE_MEM_IO::Ring)
+    ACE_DEBUG ((LM_DEBUG, "Testing Ring MEM_Stream\n\n"));
+  else
+    ACE_DEBUG ((LM_DEBUG, "Testing Multithreaded MEM_Stream\n\n"));
 
   int status = 0;
-  client_strategy = ACE_MEM_IO::MT;     // Echo_Handler uses this.
+  client_strategy = strategy;           // Echo_Handler uses this.
 
   ACE_Accept_Strategy<Echo_Handler, ACE_MEM_ACCEPTOR> accept_strategy;
   ACE_Creation_Strategy<Echo_Handler> create_strategy;
@@ -350,10 +355,14 @@ test_concurrent (const ACE_TCHAR *prog,
                        ACE_TEXT ("MEM_Acceptor::accept\n")), 1);
 
   // Make sure the MEM_Stream created by the underlying MEM_Acceptor
-  // is capable of passing messages of 1MB.
-  acceptor.acceptor ().init_buffer_size (1024 * 1024);
+  // is capable of passing messages of 1MB.  The rings are kept small
+  // so the messages wrap around them.
+  if (strategy == ACE_MEM_IO::Ring)
+    acceptor.acceptor ().init_buffer_size (ACE_MEM_STREAM_MIN_BUFFER);
+  else
+    acceptor.acceptor ().init_buffer_size (1024 * 1024);
   acceptor.acceptor ().mmap_prefix (ACE_TEXT ("MEM_Acceptor_"));
-  acceptor.acceptor ().preferred_strategy (ACE_MEM_IO::MT);
+  acceptor.acceptor ().preferred_strategy (strategy);
 
   ACE_MEM_Addr local_addr;
   if (acceptor.acceptor ().get_local_addr (local_addr) == -1)
@@ -362,23 +371,30 @@ test_concurrent (const ACE_TCHAR *prog,
                       1);
 
   u_short sport = local_addr.get_port_number ();
+  size_t const connections = strategy == ACE_MEM_IO::Ring
+    ? NUMBER_OF_RING_CONNECTIONS
+    : NUMBER_OF_MT_CONNECTIONS;
 
 #if defined (_TEST_USES_THREADS)
   ACE_UNUSED_ARG (prog);
 
-  if (ACE_Thread_Manager::instance ()->spawn_n (NUMBER_OF_MT_CONNECTIONS,
+  if (ACE_Thread_Manager::instance ()->spawn_n (connections,
                                                 connect_client,
                                                 &sport) == -1)
     ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n()")));
 #else
   ACE_Process_Options opts;
 #  if defined (ACE_WIN32) || !defined (ACE_USES_WCHAR)
-  const ACE_TCHAR *cmdline_fmt = ACE_TEXT ("%s -p%d -m");
+  const ACE_TCHAR *cmdline_fmt = ACE_TEXT ("%s -p%d %s");
 #  else
-  const ACE_TCHAR *cmdline_fmt = ACE_TEXT ("%ls -p%d -m");
+  const ACE_TCHAR *cmdline_fmt = ACE_TEXT ("%ls -p%d %ls");
 #  endif /* ACE_WIN32 || !ACE_USES_WCHAR */
-  opts.command_line (cmdline_fmt, prog, sport);
-  if (ACE_Process_Manager::instance ()->spawn_n (NUMBER_OF_MT_CONNECTIONS,
+  opts.command_line (cmdline_fmt,
+                     prog,
+                     sport,
+                     strategy == ACE_MEM_IO::Ring ? ACE_TEXT ("-g")
+                                                  : ACE_TEXT ("-m"));
+  if (ACE_Process_Manager::instance ()->spawn_n (connections,
                                                  opts) == -1)
     ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n()")));
 #endif /* _TEST_USES_THREADS */
@@ -439,7 +455,18 @@ run_main (int argc, ACE_TCHAR *argv[])
 #endif /* !ACE_WIN32 && _ACE_USE_SV_SEM */
       reset_handler (NUMBER_OF_MT_CONNECTIONS);
 
-      test_concurrent (argc > 0 ? argv[0] : ACE_TEXT ("MEM_Stream_Test"), server_addr);
+      test_concurrent (argc > 0 ? argv[0] : ACE_TEXT ("MEM_Stream_Test"),
+                       server_addr,
+                       ACE_MEM_IO::MT);
+
+#if defined (ACE_HAS_FUTEX)
+      ACE_Reactor::instance ()->reset_reactor_event_loop ();
+      reset_handler (NUMBER_OF_RING_CONNECTIONS);
+
+      test_concurrent (argc > 0 ? argv[0] : ACE_TEXT ("MEM_Stream_Test"),
+                       server_addr,
+                       ACE_MEM_IO::Ring);
+#endif /* ACE_HAS_FUTEX */
 
 #endif // ACE_LACKS_ACCEPT
       ACE_END_TEST;
@@ -449,7 +476,7 @@ run_main (int argc, ACE_TCHAR *argv[])
     {
       // We end up here if this is a child process spawned for one of
       // the test passes.  command line is: -p <port> -r (reactive) |
-      // -m (multithreaded)
+      // -m (multithreaded) | -g (ring)
 
       ACE_TCHAR lognm[MAXPATHLEN];
       int mypid (ACE_OS::getpid ());
@@ -457,7 +484,7 @@ run_main (int argc, ACE_TCHAR *argv[])
                         ACE_TEXT ("MEM_Stream_Test-%d"), mypid);
       ACE_START_TEST (lognm);
 
-      ACE_Get_Opt opts (argc, argv, ACE_TEXT ("p:rm"));
+      ACE_Get_Opt opts (argc, argv, ACE_TEXT ("p:rmg"));
       int opt, iport, status;
       ACE_MEM_IO::Signal_Strategy model = ACE_MEM_IO::Reactive;
 
@@ -478,9 +505,13 @@ run_main (int argc, ACE_TCHAR *argv[])
               model = ACE_MEM_IO::MT;
               break;
 
+            case 'g':
+              model = ACE_MEM_IO::Ring;
+              break;
+
             default:
               ACE_ERROR_RETURN ((LM_ERROR,
-                                 ACE_TEXT ("Invalid option (-p <port> -r | -m)\n")),
+                                 ACE_TEXT ("Invalid option (-p <port> -r | -m | -g)\n")),
                                 1);
             }
         }
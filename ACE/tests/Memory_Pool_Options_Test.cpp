@@ -0,0 +1,208 @@
+//=============================================================================
+/**
+ *  @file    Memory_Pool_Options_Test.cpp
+ *
+ *  Tests the huge page, pre-faulting and NUMA placement options of
+ *  ACE_MMAP_Memory_Pool and ACE_Local_Memory_Pool, through ACE_Malloc_T
+ *  as well as directly.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Malloc_T.h"
+#include "ace/Memory_Pool.h"
+#include "ace/Null_Mutex.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_Memory.h"
+#include "ace/ACE.h"
+#include "ace/Lib_Find.h"
+
+#if defined (ACE_LINUX)
+#  include /**/ <sys/mman.h>
+#endif /* ACE_LINUX */
+
+typedef ACE_Malloc_T<ACE_MMAP_MEMORY_POOL,
+                     ACE_Null_Mutex,
+                     ACE_Control_Block> MMAP_MALLOC;
+typedef ACE_Malloc_T<ACE_LOCAL_MEMORY_POOL,
+                     ACE_Null_Mutex,
+                     ACE_Control_Block> LOCAL_MALLOC;
+
+static size_t const block_size = 1024 * 1024;
+static size_t const n_blocks = 8;
+
+// Are all the pages of the @a len bytes at @a addr in memory?  Always
+// true where this can't be told.
+static bool
+resident (void *addr, size_t len)
+{
+#if defined (ACE_LINUX)
+  size_t const page_size = ACE::round_to_pagesize (1);
+  char *const start =
+    reinterpret_cast<char *> (reinterpret_cast<size_t> (addr) & ~(page_size - 1));
+  size_t const pages =
+    (static_cast<char *> (addr) + len - start + page_size - 1) / page_size;
+
+  unsigned char *vec = 0;
+  ACE_NEW_RETURN (vec, unsigned char[pages], false);
+
+  bool in_memory = ::mincore (start, pages * page_size, vec) == 0;
+  for (size_t i = 0; in_memory && i < pages; ++i)
+    in_memory = (vec[i] & 1) != 0;
+
+  delete [] vec;
+  return in_memory;
+#else
+  ACE_UNUSED_ARG (addr);
+  ACE_UNUSED_ARG (len);
+  return true;
+#endif /* ACE_LINUX */
+}
+
+// Allocate blocks from @a allocator, check they were faulted in before
+// being used, and that they hold what was written to them.
+template <class MALLOC>
+static int
+test_blocks (MALLOC &allocator, const ACE_TCHAR *name)
+{
+  int status = 0;
+  char *blocks[n_blocks];
+
+  for (size_t i = 0; i < n_blocks; ++i)
+    {
+      blocks[i] = static_cast<char *> (allocator.malloc (block_size));
+      if (blocks[i] == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%s: %p\n"),
+                           name,
+                           ACE_TEXT ("malloc")),
+                          1);
+
+      if (!resident (blocks[i], block_size))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%s: block %B was not faulted in\n"),
+                      name,
+                      i));
+          status = 1;
+        }
+
+      ACE_OS::memset (blocks[i], static_cast<int> ('a' + i), block_size);
+    }
+
+  for (size_t i = 0; i < n_blocks; ++i)
+    {
+      if (blocks[i][0] != static_cast<char> ('a' + i)
+          || blocks[i][block_size - 1] != static_cast<char> ('a' + i))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%s: block %B was overwritten\n"),
+                      name,
+                      i));
+          status = 1;
+        }
+      allocator.free (blocks[i]);
+    }
+
+  return status;
+}
+
+static int
+test_mmap_pool (void)
+{
+  ACE_TCHAR backing_store[MAXPATHLEN + 1];
+  if (ACE::get_temp_dir (backing_store, MAXPATHLEN - 30) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("get_temp_dir")), 1);
+  ACE_OS::strcat (backing_store, ACE_TEXT ("Memory_Pool_Options_Test"));
+  ACE_OS::unlink (backing_store);
+
+  ACE_MMAP_Memory_Pool_Options options
+    (ACE_DEFAULT_BASE_ADDR,
+     ACE_MMAP_Memory_Pool_Options::ALWAYS_FIXED,
+     false,
+     0,
+     0,
+     true,
+     0,
+     ACE_DEFAULT_FILE_PERMS,
+     false,
+     true,
+     ACE_MMAP_Memory_Pool_Options::TRANSPARENT_HUGE_PAGES,
+     true,
+     0);
+
+  MMAP_MALLOC allocator (backing_store, 0, &options);
+  if (allocator.bad ())
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("ACE_Malloc_T<ACE_MMAP_MEMORY_POOL>")),
+                      1);
+
+  int const status = test_blocks (allocator, ACE_TEXT ("MMAP pool"));
+  allocator.remove ();
+  return status;
+}
+
+static int
+test_local_pool (void)
+{
+  int status = 0;
+
+  // Without options the pool allocates with new, as it always did.
+  {
+    LOCAL_MALLOC allocator;
+    void *block = allocator.malloc (block_size);
+    if (block == 0)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("%p\n"),
+                         ACE_TEXT ("ACE_Malloc_T<ACE_LOCAL_MEMORY_POOL>")),
+                        1);
+    allocator.free (block);
+  }
+
+  ACE_Local_Memory_Pool_Options options
+    (ACE_Local_Memory_Pool_Options::TRANSPARENT_HUGE_PAGES,
+     true,
+     0);
+
+  LOCAL_MALLOC allocator (0, 0, &options);
+  status |= test_blocks (allocator, ACE_TEXT ("local pool"));
+
+  // MAP_HUGETLB only works with huge pages reserved by the system.
+  ACE_Local_Memory_Pool_Options hugetlb_options
+    (ACE_Local_Memory_Pool_Options::HUGETLB_PAGES);
+  ACE_Local_Memory_Pool pool (0, &hugetlb_options);
+
+  size_t rounded_bytes = 0;
+  char *chunk = static_cast<char *> (pool.acquire (1, rounded_bytes));
+  if (chunk == 0)
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("No huge pages available, MAP_HUGETLB not tested\n")));
+  else if (rounded_bytes != ACE_DEFAULT_HUGE_PAGE_SIZE)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("huge page chunk of %B bytes\n"),
+                  rounded_bytes));
+      status = 1;
+    }
+  else
+    ACE_OS::memset (chunk, 0, rounded_bytes);
+
+  pool.release ();
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Memory_Pool_Options_Test"));
+
+  int status = 0;
+
+  status |= test_mmap_pool ();
+  status |= test_local_pool ();
+
+  ACE_END_TEST;
+  return status;
+}
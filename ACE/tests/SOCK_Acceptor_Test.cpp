@@ -3,7 +3,10 @@
 /**
  *  @file    SOCK_Acceptor_Test.cpp
  *
- *   This is a test of the <ACE_SOCK_Acceptor> class.
+ *   This is a test of the <ACE_SOCK_Acceptor> class: IPv6-only
+ *   listening, SO_REUSEPORT sharing of an endpoint by several
+ *   ACE_Acceptors on their own reactors, and the modes of accepted
+ *   handles.
  *
  *  @author Steve Huston <shuston@riverace.com>
  */
@@ -16,6 +19,12 @@
 #include "ace/Time_Value.h"
 #include "ace/SOCK_Connector.h"
 #include "ace/SOCK_Acceptor.h"
+#include "ace/Acceptor.h"
+#include "ace/Svc_Handler.h"
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/ACE.h"
 
 
 static int
@@ -82,6 +91,171 @@ test_accept (ACE_Addr listen_addr, int v6_only)
   return status;
 }
 
+#if defined (SO_REUSEPORT)
+
+// Number of connections made to the shared endpoint.
+static const int shard_connections = 64;
+
+// Number of acceptors sharing the endpoint.
+static const int shards = 2;
+
+class Shard_Handler : public ACE_Svc_Handler<ACE_SOCK_Stream, ACE_NULL_SYNCH>
+{
+public:
+  /// Count the connection and check the modes of its handle, then
+  /// refuse it so that it's closed.
+  virtual int open (void *acceptor);
+
+  static int connections_[shards];
+  static int bad_modes_;
+};
+
+int Shard_Handler::connections_[shards];
+int Shard_Handler::bad_modes_ = 0;
+
+typedef ACE_Acceptor<Shard_Handler, ACE_SOCK_Acceptor> Shard_Acceptor;
+
+static Shard_Acceptor *shard_acceptors[shards];
+
+int
+Shard_Handler::open (void *acceptor)
+{
+  for (int i = 0; i < shards; ++i)
+    if (acceptor == shard_acceptors[i])
+      ++connections_[i];
+
+  ACE_HANDLE const h = this->peer ().get_handle ();
+  if (ACE_BIT_DISABLED (ACE::get_flags (h), ACE_NONBLOCK)
+      || ACE_BIT_DISABLED (ACE_OS::fcntl (h, F_GETFD), FD_CLOEXEC))
+    ++bad_modes_;
+
+  return -1;
+}
+
+static int
+test_reuse_port (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) testing SO_REUSEPORT\n")));
+
+  int status = 0;
+  ACE_Reactor *reactors[shards];
+  ACE_INET_Addr listening_at;
+
+  for (int i = 0; i < shards; ++i)
+    {
+      ACE_NEW_RETURN (reactors[i],
+                      ACE_Reactor (new ACE_Select_Reactor, true),
+                      -1);
+      ACE_NEW_RETURN (shard_acceptors[i], Shard_Acceptor, -1);
+      shard_acceptors[i]->acceptor ().reuse_port (true);
+      shard_acceptors[i]->acceptor ().accept_flags
+        (ACE_SOCK_Acceptor::ACCEPT_NONBLOCK | ACE_SOCK_Acceptor::ACCEPT_CLOEXEC);
+
+      // The first acceptor picks the port, the others share it.
+      ACE_INET_Addr addr (i == 0 ? 0 : listening_at.get_port_number (),
+                          ACE_LOCALHOST,
+                          PF_INET);
+      // ACE_Acceptor sets the blocking mode of each handler from its
+      // own flags, so ask for non-blocking handlers there as well.
+      if (shard_acceptors[i]->open (addr, reactors[i], ACE_NONBLOCK) == -1
+          || shard_acceptors[i]->acceptor ().get_local_addr (listening_at) == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%P|%t) %p\n"),
+                      ACE_TEXT ("open shard")));
+          status = 1;
+        }
+    }
+
+  // Without SO_REUSEPORT the endpoint is taken.
+  ACE_SOCK_Acceptor intruder;
+  if (status == 0
+      && intruder.open (listening_at, 0, PF_INET) != -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%P|%t) listened at a shared endpoint ")
+                  ACE_TEXT ("without SO_REUSEPORT\n")));
+      intruder.close ();
+      status = 1;
+    }
+
+  // Connect a few at a time so the listen backlogs never overflow,
+  // and let the reactors accept each batch.
+  ACE_SOCK_Connector connector;
+  int connected = 0;
+  while (status == 0 && connected < shard_connections)
+    {
+      ACE_SOCK_Stream streams[4];
+      for (size_t j = 0; j < sizeof streams / sizeof streams[0]; ++j)
+        {
+          if (connector.connect (streams[j], listening_at) == -1)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%P|%t) %p\n"),
+                          ACE_TEXT ("connect")));
+              status = 1;
+              break;
+            }
+          ++connected;
+        }
+
+      for (int tries = 0; tries < 100; ++tries)
+        {
+          int accepted = 0;
+          for (int i = 0; i < shards; ++i)
+            accepted += Shard_Handler::connections_[i];
+          if (accepted == connected)
+            break;
+
+          for (int i = 0; i < shards; ++i)
+            {
+              ACE_Time_Value tv (0, 10000);
+              reactors[i]->handle_events (tv);
+            }
+        }
+
+      for (size_t j = 0; j < sizeof streams / sizeof streams[0]; ++j)
+        streams[j].close ();
+    }
+
+  int accepted = 0;
+  for (int i = 0; i < shards; ++i)
+    {
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("(%P|%t) shard %d accepted %d connections\n"),
+                  i,
+                  Shard_Handler::connections_[i]));
+      accepted += Shard_Handler::connections_[i];
+    }
+
+  if (status == 0 && accepted != connected)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%P|%t) accepted %d of %d connections\n"),
+                  accepted,
+                  connected));
+      status = 1;
+    }
+
+  if (Shard_Handler::bad_modes_ != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%P|%t) %d connections not in ")
+                  ACE_TEXT ("non-blocking, close-on-exec mode\n"),
+                  Shard_Handler::bad_modes_));
+      status = 1;
+    }
+
+  for (int i = 0; i < shards; ++i)
+    {
+      delete shard_acceptors[i];
+      delete reactors[i];
+    }
+
+  return status;
+}
+#endif /* SO_REUSEPORT */
+
 int
 run_main (int, ACE_TCHAR *[])
 {
@@ -93,6 +267,10 @@ run_main (int, ACE_TCHAR *[])
     status = 1;
   if (test_accept (ACE_Addr::sap_any, 0) != 0)
     status = 1;
+#if defined (SO_REUSEPORT)
+  if (test_reuse_port () != 0)
+    status = 1;
+#endif /* SO_REUSEPORT */
 
   ACE_END_TEST;
   return status;
@@ -0,0 +1,206 @@
+//=============================================================================
+/**
+ *  @file    SOCK_Dgram_Batch_Test.cpp
+ *
+ *  Tests sending and receiving bursts of datagrams with an
+ *  ACE_Dgram_Batch through ACE_SOCK_Dgram and ACE_SOCK_CODgram.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Dgram_Batch.h"
+#include "ace/SOCK_Dgram.h"
+#include "ace/SOCK_CODgram.h"
+#include "ace/INET_Addr.h"
+#include "ace/Time_Value.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_errno.h"
+
+static const size_t burst = 8;
+
+// Datagram @a i of a burst is @a i + 1 copies of the letter 'a' + @a i.
+static size_t
+fill (char *buf, size_t i)
+{
+  ACE_OS::memset (buf, 'a' + static_cast<int> (i), i + 1);
+  return i + 1;
+}
+
+static int
+check_burst (const ACE_Dgram_Batch &batch,
+             ssize_t received,
+             const ACE_INET_Addr &from)
+{
+  if (received != static_cast<ssize_t> (burst)
+      || batch.size () != burst)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("received %b datagrams, batch holds %B, ")
+                       ACE_TEXT ("expected %B: %p\n"),
+                       received,
+                       batch.size (),
+                       burst,
+                       ACE_TEXT ("recv")),
+                      1);
+
+  for (size_t i = 0; i < burst; ++i)
+    {
+      char expected[burst];
+      size_t const n = fill (expected, i);
+      if (batch.length (i) != n
+          || ACE_OS::memcmp (batch.data (i), expected, n) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("datagram %B has %B bytes, ")
+                           ACE_TEXT ("expected %B\n"),
+                           i,
+                           batch.length (i),
+                           n),
+                          1);
+
+      ACE_INET_Addr addr;
+      batch.addr (i, addr);
+      if (addr.get_port_number () != from.get_port_number ())
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("datagram %B from port %d, ")
+                           ACE_TEXT ("expected %d\n"),
+                           i,
+                           addr.get_port_number (),
+                           from.get_port_number ()),
+                          1);
+    }
+
+  return 0;
+}
+
+static int
+test_dgram (ACE_SOCK_Dgram &server, const ACE_INET_Addr &server_addr)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing ACE_SOCK_Dgram\n")));
+
+  ACE_SOCK_Dgram client;
+  ACE_INET_Addr client_addr;
+  if (client.open (ACE_INET_Addr (static_cast<u_short> (0), ACE_LOCALHOST)) == -1
+      || client.get_local_addr (client_addr) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("client")), 1);
+
+  int status = 0;
+
+  // The data of the datagrams added to a batch isn't copied.
+  char data[burst][burst];
+  ACE_Dgram_Batch out (burst, 0);
+  for (size_t i = 0; i < burst; ++i)
+    if (out.add (data[i], fill (data[i], i), server_addr) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("add")), 1);
+
+  if (out.add (data[0], 1, server_addr) != -1 || errno != ENOSPC)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("added a datagram to a full batch\n")));
+      status = 1;
+    }
+
+  ssize_t const sent = client.send (out);
+  if (sent != static_cast<ssize_t> (burst))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("sent %b datagrams, expected %B: %p\n"),
+                       sent,
+                       burst,
+                       ACE_TEXT ("send")),
+                      1);
+
+  // All of the burst is queued by now and comes in one receive, with
+  // room to spare in the batch.
+  ACE_Dgram_Batch in (2 * burst);
+  ACE_Time_Value timeout (5);
+  status |= check_burst (in, server.recv (in, 0, &timeout), client_addr);
+
+  // Nothing more is queued.
+  timeout.set (0, 100000);
+  if (server.recv (in, 0, &timeout) != -1 || errno != ETIME)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("received %B datagrams that weren't sent\n"),
+                  in.size ()));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_codgram (ACE_SOCK_Dgram &server, const ACE_INET_Addr &server_addr)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing ACE_SOCK_CODgram\n")));
+
+  ACE_SOCK_CODgram client;
+  ACE_INET_Addr client_addr;
+  if (client.open (server_addr) == -1
+      || client.get_local_addr (client_addr) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("client")), 1);
+
+  // Datagrams to the connected peer need no address.
+  char data[burst][burst];
+  ACE_Dgram_Batch out (burst, 0);
+  for (size_t i = 0; i < burst; ++i)
+    out.add (data[i], fill (data[i], i), ACE_Addr::sap_any);
+
+  ssize_t const sent = client.send (out);
+  if (sent != static_cast<ssize_t> (burst))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("sent %b datagrams, expected %B: %p\n"),
+                       sent,
+                       burst,
+                       ACE_TEXT ("send")),
+                      1);
+
+  // Receive into buffers of our own.
+  char buffers[burst][burst];
+  ACE_Dgram_Batch in (burst, 0);
+  for (size_t i = 0; i < burst; ++i)
+    in.buffer (i, buffers[i], sizeof buffers[i]);
+
+  ACE_Time_Value timeout (5);
+  ssize_t const received = server.recv (in, 0, &timeout);
+  if (check_burst (in, received, client_addr) != 0)
+    return 1;
+
+  if (in.data (0) != buffers[0])
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("datagram not received into its buffer\n")),
+                      1);
+
+  // And the other way around.
+  ACE_Dgram_Batch back (burst, 0);
+  for (size_t i = 0; i < burst; ++i)
+    back.add (data[i], fill (data[i], i), client_addr);
+  if (server.send (back) != static_cast<ssize_t> (burst))
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("send")), 1);
+
+  ACE_Dgram_Batch reply (burst);
+  return check_burst (reply, client.recv (reply, 0, &timeout), server_addr);
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("SOCK_Dgram_Batch_Test"));
+
+  int status = 0;
+
+  ACE_SOCK_Dgram server;
+  ACE_INET_Addr server_addr;
+  if (server.open (ACE_INET_Addr (static_cast<u_short> (0), ACE_LOCALHOST)) == -1
+      || server.get_local_addr (server_addr) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("server")));
+      status = 1;
+    }
+  else
+    {
+      status |= test_dgram (server, server_addr);
+      status |= test_codgram (server, server_addr);
+      server.close ();
+    }
+
+  ACE_END_TEST;
+  return status;
+}
@@ -0,0 +1,232 @@
+//=============================================================================
+/**
+ *  @file    SOCK_Dgram_Segments_Test.cpp
+ *
+ *  Tests sending a run of datagrams with
+ *  ACE_SOCK_Dgram::send_segments() and receiving them, coalesced or
+ *  not, with ACE_SOCK_Dgram::recv_segments() and an ACE_Dgram_Batch.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/SOCK_Dgram.h"
+#include "ace/Dgram_Batch.h"
+#include "ace/INET_Addr.h"
+#include "ace/Time_Value.h"
+#include "ace/ACE.h"
+#include "ace/Min_Max.h"
+
+static const size_t segment_size = 1000;
+static const size_t segments = 10;
+static const size_t tail_size = 300;
+static const size_t total_size = segments * segment_size + tail_size;
+
+// Byte @a i of the data sent.
+static char
+pattern (size_t i)
+{
+  return static_cast<char> ((i * 13) % 241);
+}
+
+// Check the @a n bytes at @a buf, received at @a offset of the data
+// sent, that hold datagrams of @a size bytes.  Returns the number of
+// datagrams or -1.
+static int
+check (const char *buf, size_t n, size_t size, size_t offset)
+{
+  if (size == 0 || size > n)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("segment size %B of %B bytes\n"),
+                       size,
+                       n),
+                      -1);
+
+  int count = 0;
+  for (size_t start = 0; start < n; start += size, ++count)
+    {
+      size_t const length = ACE_MIN (size, n - start);
+      size_t const expected =
+        offset + start < segments * segment_size ? segment_size : tail_size;
+      if (length != expected)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("datagram at %B has %B bytes, ")
+                           ACE_TEXT ("expected %B\n"),
+                           offset + start,
+                           length,
+                           expected),
+                          -1);
+    }
+
+  for (size_t i = 0; i < n; ++i)
+    if (buf[i] != pattern (offset + i))
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("wrong data at byte %B\n"),
+                         offset + i),
+                        -1);
+
+  return count;
+}
+
+static int
+send_run (ACE_SOCK_Dgram &client, const ACE_INET_Addr &server_addr)
+{
+  // Buffers that don't line up with the datagrams.
+  static char data[total_size];
+  for (size_t i = 0; i < total_size; ++i)
+    data[i] = pattern (i);
+
+  iovec iov[3];
+  iov[0].iov_base = data;
+  iov[0].iov_len = 1500;
+  iov[1].iov_base = data + 1500;
+  iov[1].iov_len = 0;
+  iov[2].iov_base = data + 1500;
+  iov[2].iov_len = total_size - 1500;
+
+  ssize_t const sent =
+    client.send_segments (iov, 3, segment_size, server_addr);
+  if (sent != static_cast<ssize_t> (total_size))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("sent %b bytes, expected %B: %p\n"),
+                       sent,
+                       total_size,
+                       ACE_TEXT ("send_segments")),
+                      1);
+  return 0;
+}
+
+static int
+test_recv_segments (ACE_SOCK_Dgram &client,
+                    ACE_SOCK_Dgram &server,
+                    const ACE_INET_Addr &server_addr)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing recv_segments\n")));
+
+  if (send_run (client, server_addr) != 0)
+    return 1;
+
+  static char buf[ACE_MAX_UDP_PACKET_SIZE];
+  size_t received = 0;
+  size_t datagrams = 0;
+  size_t reads = 0;
+  ACE_Time_Value timeout (5);
+
+  while (received < total_size)
+    {
+      if (ACE::handle_read_ready (server.get_handle (), &timeout) != 1)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%p after %B bytes\n"),
+                           ACE_TEXT ("handle_read_ready"),
+                           received),
+                          1);
+
+      ACE_INET_Addr from;
+      size_t size = 0;
+      ssize_t const n = server.recv_segments (buf, sizeof buf, from, size);
+      if (n <= 0)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("recv")), 1);
+
+      int const count = check (buf, n, size, received);
+      if (count == -1)
+        return 1;
+
+      received += n;
+      datagrams += count;
+      ++reads;
+    }
+
+  if (datagrams != segments + 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("received %B datagrams, expected %B\n"),
+                       datagrams,
+                       segments + 1),
+                      1);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Received %B datagrams with %B reads\n"),
+              datagrams,
+              reads));
+  return 0;
+}
+
+static int
+test_batch (ACE_SOCK_Dgram &client,
+            ACE_SOCK_Dgram &server,
+            const ACE_INET_Addr &server_addr)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing ACE_Dgram_Batch\n")));
+
+  if (send_run (client, server_addr) != 0)
+    return 1;
+
+  ACE_Dgram_Batch batch (segments + 1, ACE_MAX_UDP_PACKET_SIZE);
+  size_t received = 0;
+  size_t datagrams = 0;
+  ACE_Time_Value timeout (5);
+
+  while (received < total_size)
+    {
+      ssize_t const count = server.recv (batch, 0, &timeout);
+      if (count <= 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%p after %B bytes\n"),
+                           ACE_TEXT ("recv"),
+                           received),
+                          1);
+
+      for (size_t i = 0; i < static_cast<size_t> (count); ++i)
+        {
+          int const n = check (batch.data (i),
+                               batch.length (i),
+                               batch.segment_size (i),
+                               received);
+          if (n == -1)
+            return 1;
+
+          received += batch.length (i);
+          datagrams += n;
+        }
+    }
+
+  if (datagrams != segments + 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("received %B datagrams, expected %B\n"),
+                       datagrams,
+                       segments + 1),
+                      1);
+  return 0;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("SOCK_Dgram_Segments_Test"));
+
+  int status = 0;
+
+  ACE_SOCK_Dgram server;
+  ACE_SOCK_Dgram client;
+  ACE_INET_Addr server_addr;
+  if (server.open (ACE_INET_Addr (static_cast<u_short> (0), ACE_LOCALHOST)) == -1
+      || server.get_local_addr (server_addr) == -1
+      || client.open (ACE_INET_Addr (static_cast<u_short> (0), ACE_LOCALHOST)) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")));
+      status = 1;
+    }
+  else
+    {
+      if (server.enable_gro () == -1)
+        ACE_DEBUG ((LM_INFO,
+                    ACE_TEXT ("Datagrams aren't coalesced (%p)\n"),
+                    ACE_TEXT ("enable_gro")));
+
+      status |= test_recv_segments (client, server, server_addr);
+      status |= test_batch (client, server, server_addr);
+      client.close ();
+      server.close ();
+    }
+
+  ACE_END_TEST;
+  return status;
+}
@@ -0,0 +1,255 @@
+//=============================================================================
+/**
+ *  @file    SOCK_Zerocopy_Test.cpp
+ *
+ *  Tests which blocks ACE_SOCK_Zerocopy::pin() copies, sending a chain
+ *  of message blocks with ACE_SOCK_Zerocopy, releasing it right away,
+ *  and reaping the completions of the zero-copy sends.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/SOCK_Zerocopy.h"
+#include "ace/SOCK_Acceptor.h"
+#include "ace/SOCK_Connector.h"
+#include "ace/SOCK_Stream.h"
+#include "ace/Message_Block.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Time_Value.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+
+#if defined (ACE_HAS_THREADS)
+
+static const size_t header_size = 64;
+static const size_t body_size = 1024 * 1024;
+static const size_t trailer_size = 512 * 1024;
+static const size_t total_size = header_size + body_size + trailer_size;
+
+// Byte @a i of the data sent.
+static char
+pattern (size_t i)
+{
+  return static_cast<char> ((i * 7) % 251);
+}
+
+static void
+fill (char *buf, size_t n, size_t offset)
+{
+  for (size_t i = 0; i < n; ++i)
+    buf[i] = pattern (offset + i);
+}
+
+static int reader_status = 0;
+
+static ACE_THR_FUNC_RETURN
+reader (void *arg)
+{
+  ACE_SOCK_Stream *stream = static_cast<ACE_SOCK_Stream *> (arg);
+
+  char buf[8192];
+  size_t received = 0;
+  ACE_Time_Value timeout (ACE_DEFAULT_TIMEOUT);
+
+  while (received < total_size)
+    {
+      ssize_t const n = stream->recv (buf, sizeof buf, &timeout);
+      if (n <= 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) %p after %B bytes\n"),
+                      ACE_TEXT ("recv"),
+                      received));
+          reader_status = 1;
+          return 0;
+        }
+
+      for (ssize_t i = 0; i < n; ++i)
+        if (buf[i] != pattern (received + i))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("(%t) wrong data at byte %B\n"),
+                        received + i));
+            reader_status = 1;
+            return 0;
+          }
+
+      received += n;
+    }
+
+  return 0;
+}
+
+static int
+test_pin (void)
+{
+  int status = 0;
+
+  char stack_data[header_size];
+  ACE_Message_Block header (stack_data, sizeof stack_data);
+  header.wr_ptr (sizeof stack_data);
+  ACE_Message_Block *body = new ACE_Message_Block (body_size);
+  body->wr_ptr (body_size);
+  ACE_Message_Block *borrowed = new ACE_Message_Block (trailer_size);
+  borrowed->wr_ptr (trailer_size);
+  ACE_Message_Block *trailer = borrowed->duplicate ();
+  header.cont (body);
+  body->cont (trailer);
+
+  ACE_Message_Block *pinned = ACE_SOCK_Zerocopy::pin (&header);
+  if (pinned == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("pin")), 1);
+
+  // The block on the stack is copied, the heap block only the chain
+  // refers to shared, and the one also referred to by another block
+  // copied, since its owner may still write it.
+  if (pinned->rd_ptr () == stack_data
+      || pinned->length () != header_size
+      || pinned->cont () == 0
+      || pinned->cont ()->rd_ptr () != body->rd_ptr ()
+      || pinned->cont ()->length () != body_size
+      || pinned->cont ()->data_block () != body->data_block ()
+      || body->data_block ()->reference_count () != 2
+      || body->data_block ()->locking_strategy () == 0
+      || pinned->cont ()->cont () == 0
+      || pinned->cont ()->cont ()->data_block () == borrowed->data_block ()
+      || pinned->cont ()->cont ()->length () != trailer_size
+      || borrowed->data_block ()->reference_count () != 2)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("pinned chain is wrong\n")));
+      status = 1;
+    }
+  pinned->release ();
+
+  // The first block is copied even from the heap, its owner may
+  // reuse it.
+  pinned = ACE_SOCK_Zerocopy::pin (body);
+  if (pinned == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("pin")), 1);
+
+  if (pinned->data_block () == body->data_block ()
+      || pinned->length () != body_size)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("pinned first block is shared\n")));
+      status = 1;
+    }
+  pinned->release ();
+
+  body->release ();
+  borrowed->release ();
+  return status;
+}
+
+static int
+test_send (void)
+{
+  ACE_SOCK_Acceptor acceptor;
+  ACE_INET_Addr server_addr;
+  if (acceptor.open (ACE_INET_Addr (static_cast<u_short> (0), ACE_LOCALHOST)) == -1
+      || acceptor.get_local_addr (server_addr) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("acceptor")), 1);
+
+  ACE_SOCK_Stream client;
+  ACE_SOCK_Stream server;
+  ACE_SOCK_Connector connector;
+  if (connector.connect (client,
+                         ACE_INET_Addr (server_addr.get_port_number (),
+                                        ACE_LOCALHOST)) == -1
+      || acceptor.accept (server) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("connect")), 1);
+  acceptor.close ();
+
+  ACE_SOCK_Zerocopy zerocopy;
+  if (zerocopy.enable (client.get_handle ()) == -1)
+    ACE_DEBUG ((LM_INFO,
+                ACE_TEXT ("Zero-copy sends not available (%p), ")
+                ACE_TEXT ("the data is copied\n"),
+                ACE_TEXT ("enable")));
+
+  if (ACE_Thread_Manager::instance ()->spawn (reader, &server) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+
+  int status = 0;
+
+  char stack_data[header_size];
+  fill (stack_data, header_size, 0);
+  ACE_Message_Block *header = new ACE_Message_Block (stack_data, header_size);
+  header->wr_ptr (header_size);
+  ACE_Message_Block *body = new ACE_Message_Block (body_size);
+  fill (body->wr_ptr (), body_size, header_size);
+  body->wr_ptr (body_size);
+  ACE_Message_Block *trailer = new ACE_Message_Block (trailer_size);
+  fill (trailer->wr_ptr (), trailer_size, header_size + body_size);
+  trailer->wr_ptr (trailer_size);
+  header->cont (body);
+  body->cont (trailer);
+
+  size_t sent = 0;
+  ACE_Time_Value timeout (ACE_DEFAULT_TIMEOUT);
+  if (client.send_n (header, zerocopy, &timeout, &sent)
+      != static_cast<ssize_t> (total_size))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("sent %B bytes: %p\n"),
+                  sent,
+                  ACE_TEXT ("send_n")));
+      status = 1;
+    }
+
+  // The data the kernel still refers to outlives the chain.
+  header->release ();
+  ACE_OS::memset (stack_data, 0, sizeof stack_data);
+
+  ACE_Thread_Manager::instance ()->wait ();
+  status |= reader_status;
+
+  // All the sends complete once the data was received.
+  for (int i = 0; i < 500 && zerocopy.pending () > 0; ++i)
+    {
+      if (zerocopy.reap (client.get_handle ()) == -1)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("reap")));
+          status = 1;
+          break;
+        }
+      if (zerocopy.pending () > 0)
+        ACE_OS::sleep (ACE_Time_Value (0, 10000));
+    }
+
+  if (zerocopy.pending () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B sends never completed\n"),
+                  zerocopy.pending ()));
+      status = 1;
+    }
+  else
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("All sends completed, %B of them copied\n"),
+                zerocopy.copied ()));
+
+  client.close ();
+  server.close ();
+  return status;
+}
+
+#endif /* ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("SOCK_Zerocopy_Test"));
+
+  int status = 0;
+
+#if defined (ACE_HAS_THREADS)
+  status |= test_pin ();
+  status |= test_send ();
+#else
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
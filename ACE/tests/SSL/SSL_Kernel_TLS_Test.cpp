@@ -0,0 +1,262 @@
+//=============================================================================
+/**
+ *  @file    SSL_Kernel_TLS_Test.cpp
+ *
+ *  Sends data over a loopback SSL connection, first encrypted by
+ *  OpenSSL and then, if available, by the kernel (see
+ *  ACE_SSL_Context::kernel_tls()), checks the data received and
+ *  reports the throughput of both.
+ */
+//=============================================================================
+
+#include "../test_config.h"
+#include "ace/SSL/SSL_Context.h"
+#include "ace/SSL/SSL_SOCK_Acceptor.h"
+#include "ace/SSL/SSL_SOCK_Connector.h"
+#include "ace/SSL/SSL_SOCK_Stream.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Time_Value.h"
+#include "ace/OS_NS_errno.h"
+
+#if defined (ACE_HAS_THREADS)
+
+static const size_t chunk_size = 64 * 1024;
+static const size_t chunks = 256;
+static const size_t total_size = chunks * chunk_size;
+
+// Byte @a i of the data sent.
+static char
+pattern (size_t i)
+{
+  return static_cast<char> ((i * 7) % 251);
+}
+
+struct Server_Args
+{
+  ACE_SSL_SOCK_Acceptor *acceptor_;
+  ACE_SSL_Context *context_;
+  bool kernel_send_;
+  int status_;
+};
+
+static ACE_THR_FUNC_RETURN
+server (void *arg)
+{
+  Server_Args *args = static_cast<Server_Args *> (arg);
+  args->status_ = 1;
+
+  ACE_SSL_SOCK_Stream stream (args->context_);
+  ACE_Time_Value timeout (ACE_DEFAULT_TIMEOUT);
+  if (args->acceptor_->accept (stream, 0, &timeout) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("accept")));
+      return 0;
+    }
+  args->kernel_send_ = stream.kernel_tls_send ();
+
+  static char buf[chunk_size];
+  size_t received = 0;
+
+  while (received < total_size)
+    {
+      ssize_t const n = stream.recv (buf, sizeof buf, &timeout);
+      if (n <= 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) %p after %B bytes\n"),
+                      ACE_TEXT ("recv"),
+                      received));
+          stream.close ();
+          return 0;
+        }
+
+      for (ssize_t i = 0; i < n; ++i)
+        if (buf[i] != pattern (received + i))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("(%t) wrong data at byte %B\n"),
+                        received + i));
+            stream.close ();
+            return 0;
+          }
+
+      received += n;
+    }
+
+  // Tell the client all the data arrived.
+  char const done = 1;
+  if (stream.send_n (&done, 1) != 1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("send_n")));
+      stream.close ();
+      return 0;
+    }
+
+  stream.close ();
+  args->status_ = 0;
+  return 0;
+}
+
+// Sends the data over a connection set up with @a context, and
+// returns the throughput in MB/s in @a rate.
+static int
+transfer (ACE_SSL_Context &context, bool &kernel_send, double &rate)
+{
+  ACE_SSL_SOCK_Acceptor acceptor;
+  ACE_INET_Addr server_addr;
+  if (acceptor.open (ACE_INET_Addr (static_cast<u_short> (0), ACE_LOCALHOST)) == -1
+      || acceptor.get_local_addr (server_addr) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("acceptor")), 1);
+
+  Server_Args args = { &acceptor, &context, false, 1 };
+  if (ACE_Thread_Manager::instance ()->spawn (server, &args) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+
+  int status = 0;
+
+  ACE_SSL_SOCK_Stream stream (&context);
+  ACE_SSL_SOCK_Connector connector;
+  ACE_Time_Value timeout (ACE_DEFAULT_TIMEOUT);
+  if (connector.connect (stream,
+                         ACE_INET_Addr (server_addr.get_port_number (),
+                                        ACE_LOCALHOST),
+                         &timeout) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("connect")));
+      status = 1;
+    }
+  else
+    {
+      kernel_send = stream.kernel_tls_send ();
+
+      // Each chunk goes in two pieces, so the data is gathered.
+      static char data[chunk_size];
+      iovec iov[2];
+      iov[0].iov_base = data;
+      iov[0].iov_len = 100;
+      iov[1].iov_base = data + 100;
+      iov[1].iov_len = chunk_size - 100;
+
+      ACE_High_Res_Timer timer;
+      timer.start ();
+
+      for (size_t i = 0; i < chunks && status == 0; ++i)
+        {
+          for (size_t j = 0; j < chunk_size; ++j)
+            data[j] = pattern (i * chunk_size + j);
+
+          if (stream.sendv_n (iov, 2) != static_cast<ssize_t> (chunk_size))
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("%p of chunk %B\n"),
+                          ACE_TEXT ("sendv_n"),
+                          i));
+              status = 1;
+            }
+        }
+
+      char done = 0;
+      if (status == 0 && stream.recv_n (&done, 1, &timeout) != 1)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("recv_n")));
+          status = 1;
+        }
+
+      timer.stop ();
+      ACE_Time_Value elapsed;
+      timer.elapsed_time (elapsed);
+      double const seconds =
+        elapsed.sec () + elapsed.usec () / 1000000.0;
+      rate = seconds > 0 ? total_size / seconds / (1024 * 1024) : 0;
+
+      stream.close ();
+    }
+
+  ACE_Thread_Manager::instance ()->wait ();
+  acceptor.close ();
+
+  if (kernel_send != args.kernel_send_)
+    ACE_DEBUG ((LM_INFO,
+                ACE_TEXT ("Kernel TLS used for %C sends only\n"),
+                kernel_send ? "client" : "server"));
+
+  return status | args.status_;
+}
+
+static int
+init_context (ACE_SSL_Context &context)
+{
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+  // The test certificate is signed with MD5.
+  ::SSL_CTX_set_security_level (context.context (), 0);
+#endif /* OPENSSL_VERSION_NUMBER >= 0x10100000L */
+
+  // Note - the next two strings are naked on purpose... the arguments
+  // to the ACE_SSL_Context methods are const char *, not ACE_TCHAR *.
+  if (context.certificate ("dummy.pem", SSL_FILETYPE_PEM) != 0
+      || context.private_key ("key.pem", SSL_FILETYPE_PEM) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("cannot load dummy.pem or key.pem\n")),
+                      1);
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("SSL_Kernel_TLS_Test"));
+
+  int status = 0;
+
+#if defined (ACE_HAS_THREADS)
+  ACE_SSL_Context user_context;
+  ACE_SSL_Context kernel_context;
+
+  bool kernel_send = false;
+  double user_rate = 0;
+  double kernel_rate = 0;
+
+  status |= init_context (user_context);
+  status |= init_context (kernel_context);
+
+  if (status == 0)
+    {
+      status |= transfer (user_context, kernel_send, user_rate);
+      if (kernel_send)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Kernel TLS used without being enabled\n")));
+          status = 1;
+        }
+
+      if (kernel_context.kernel_tls () == -1)
+        ACE_DEBUG ((LM_INFO,
+                    ACE_TEXT ("Kernel TLS not supported (%p)\n"),
+                    ACE_TEXT ("kernel_tls")));
+
+      status |= transfer (kernel_context, kernel_send, kernel_rate);
+      if (!kernel_send)
+        ACE_DEBUG ((LM_INFO,
+                    ACE_TEXT ("Kernel TLS not available, ")
+                    ACE_TEXT ("OpenSSL encrypted the data\n")));
+    }
+
+  if (status == 0)
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("Sent %B bytes at %.1f MB/s encrypted by OpenSSL, ")
+                ACE_TEXT ("at %.1f MB/s encrypted by %C\n"),
+                total_size,
+                user_rate,
+                kernel_rate,
+                kernel_send ? "the kernel" : "OpenSSL"));
+#else
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
@@ -0,0 +1,264 @@
+//=============================================================================
+/**
+ *  @file    Sharded_Dev_Poll_Reactor_Test.cpp
+ *
+ *  This test verifies the ACE_Sharded_Dev_Poll_Reactor:
+ *  - Handles registered with one shard are only dispatched by the
+ *    thread running that shard's event loop, and every byte written is
+ *    read exactly once.
+ *  - Handles registered without a shard are spread over all shards.
+ *  - Timers scheduled and notifications sent from another thread are
+ *    dispatched.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Reactor.h"
+#include "ace/Sharded_Dev_Poll_Reactor.h"
+#include "ace/Pipe.h"
+#include "ace/ACE.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+
+#if defined (ACE_HAS_EVENT_POLL)
+
+// Number of shards, each run by one thread.
+static const size_t shard_count = 4;
+
+// Number of pipes per shard.
+static const size_t pipes_per_shard = 16;
+
+// Number of bytes written to each pipe.
+static const int rounds = 20;
+
+// Thread running each shard.
+static ACE_thread_t shard_threads[shard_count];
+
+// Set once all event loop threads have been bound.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> bound_threads;
+
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> total_received;
+
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> done;
+
+class Reader : public ACE_Event_Handler
+{
+public:
+  Reader (void)
+    : shard_ (0), received_ (0), wrong_thread_ (0), notified_ (0) {}
+
+  ACE_HANDLE get_handle (void) const { return this->pipe_.read_handle (); }
+
+  int handle_input (ACE_HANDLE fd)
+  {
+    if (!ACE_OS::thr_equal (ACE_Thread::self (), shard_threads[this->shard_]))
+      ++this->wrong_thread_;
+
+    char c;
+    if (ACE::recv (fd, &c, 1) == 1)
+      {
+        ++this->received_;
+        ++total_received;
+      }
+    return 0;
+  }
+
+  int handle_exception (ACE_HANDLE)
+  {
+    if (!ACE_OS::thr_equal (ACE_Thread::self (), shard_threads[this->shard_]))
+      ++this->wrong_thread_;
+    ++this->notified_;
+    return 0;
+  }
+
+  ACE_Pipe pipe_;
+  size_t shard_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> received_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> wrong_thread_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> notified_;
+};
+
+class Timer_Handler : public ACE_Event_Handler
+{
+public:
+  Timer_Handler (void) : expired_ (0) {}
+
+  int handle_timeout (const ACE_Time_Value &, const void *)
+  {
+    ++this->expired_;
+    return 0;
+  }
+
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> expired_;
+};
+
+class Event_Loop : public ACE_Task_Base
+{
+public:
+  Event_Loop (ACE_Sharded_Dev_Poll_Reactor &impl, ACE_Reactor &reactor)
+    : impl_ (impl), reactor_ (reactor), next_ (0) {}
+
+  int svc (void)
+  {
+    size_t shard;
+    {
+      ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->lock_, -1);
+      shard = this->next_++;
+    }
+
+    if (this->impl_.bind_thread (shard) != 0)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p %B\n"),
+                         ACE_TEXT ("bind_thread"), shard), -1);
+    shard_threads[shard] = ACE_Thread::self ();
+    ++bound_threads;
+
+    ACE_Time_Value deadline = ACE_OS::gettimeofday () + ACE_Time_Value (20);
+    while (done.value () == 0 && ACE_OS::gettimeofday () < deadline)
+      {
+        ACE_Time_Value tv (0, 50000);
+        this->reactor_.handle_events (tv);
+      }
+    return 0;
+  }
+
+private:
+  ACE_Sharded_Dev_Poll_Reactor &impl_;
+  ACE_Reactor &reactor_;
+  ACE_SYNCH_MUTEX lock_;
+  size_t next_;
+};
+
+static bool
+wait_for (ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> &counter, long expected)
+{
+  ACE_Time_Value deadline = ACE_OS::gettimeofday () + ACE_Time_Value (10);
+  while (counter.value () < expected && ACE_OS::gettimeofday () < deadline)
+    ACE_OS::sleep (ACE_Time_Value (0, 10000));
+  return counter.value () >= expected;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Sharded_Dev_Poll_Reactor_Test"));
+  int result = 0;
+
+  ACE_Sharded_Dev_Poll_Reactor impl (shard_count, ACE::max_handles ());
+  if (!impl.initialized ())
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("ACE_Sharded_Dev_Poll_Reactor")), 1);
+  ACE_Reactor reactor (&impl);
+
+  static const size_t pipe_count = shard_count * pipes_per_shard;
+  Reader readers[pipe_count];
+
+  // The first half of the handles is assigned explicitly, the rest is
+  // distributed by the reactor.
+  for (size_t i = 0; i < pipe_count; ++i)
+    {
+      int r = readers[i].pipe_.open ();
+      if (r == 0)
+        r = i < pipe_count / 2
+          ? impl.register_handler (i % shard_count,
+                                   &readers[i],
+                                   ACE_Event_Handler::READ_MASK)
+          : reactor.register_handler (&readers[i],
+                                      ACE_Event_Handler::READ_MASK);
+      if (r != 0)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p %B\n"),
+                           ACE_TEXT ("register"), i), 1);
+      readers[i].shard_ = i % shard_count;
+    }
+
+  Event_Loop event_loop (impl, reactor);
+  if (event_loop.activate (THR_NEW_LWP | THR_JOINABLE,
+                           static_cast<int> (shard_count)) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("activate")), 1);
+
+  if (!wait_for (bound_threads, static_cast<long> (shard_count)))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Event loop threads didn't start\n")));
+      ++result;
+    }
+
+  for (int r = 0; r < rounds; ++r)
+    for (size_t i = 0; i < pipe_count; ++i)
+      ACE::send_n (readers[i].pipe_.write_handle (), "x", 1);
+
+  if (!wait_for (total_received, static_cast<long> (pipe_count) * rounds))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Received %d bytes, expected %d\n"),
+                  total_received.value (),
+                  static_cast<long> (pipe_count) * rounds));
+      ++result;
+    }
+
+  // Timers are run by the first shard.
+  Timer_Handler timer;
+  if (reactor.schedule_timer (&timer, 0, ACE_Time_Value (0, 10000)) == -1
+      || !wait_for (timer.expired_, 1))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Timer did not expire\n")));
+      ++result;
+    }
+
+  // Notifications go to the shard of the handler.
+  Reader &notified = readers[pipe_count - 1];
+  if (reactor.notify (&notified) == -1
+      || !wait_for (notified.notified_, 1))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Notification not dispatched\n")));
+      ++result;
+    }
+
+  done = 1;
+  event_loop.wait ();
+
+  for (size_t i = 0; i < pipe_count; ++i)
+    {
+      if (readers[i].received_.value () != rounds)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Reader %B received %d, expected %d\n"),
+                      i, readers[i].received_.value (), rounds));
+          ++result;
+        }
+      if (readers[i].wrong_thread_.value () != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Reader %B dispatched by another shard's ")
+                      ACE_TEXT ("thread %d times\n"),
+                      i, readers[i].wrong_thread_.value ()));
+          ++result;
+        }
+      if (reactor.remove_handler (&readers[i],
+                                  ACE_Event_Handler::ALL_EVENTS_MASK |
+                                  ACE_Event_Handler::DONT_CALL) != 0)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p %B\n"),
+                      ACE_TEXT ("remove_handler"), i));
+          ++result;
+        }
+      readers[i].pipe_.close ();
+    }
+
+  ACE_END_TEST;
+  return result;
+}
+
+#else
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Sharded_Dev_Poll_Reactor_Test"));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("The epoll based ACE_Sharded_Dev_Poll_Reactor is ")
+              ACE_TEXT ("UNSUPPORTED on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+#endif /* ACE_HAS_EVENT_POLL */
@@ -0,0 +1,296 @@
+//=============================================================================
+/**
+ *  @file    Slab_Allocator_Test.cpp
+ *
+ *  Tests the size classes of ACE_Slab_Allocator, its use by several
+ *  threads, and the message blocks that keep their data block and
+ *  buffer in a single chunk of it.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Slab_Allocator_T.h"
+#include "ace/Message_Block.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Null_Mutex.h"
+#include "ace/OS_NS_string.h"
+
+typedef ACE_Slab_Allocator<ACE_SYNCH_MUTEX> SLAB_ALLOCATOR;
+
+// Counts the allocations that reach the allocator.
+template <class ALLOCATOR>
+class Counting_Allocator : public ALLOCATOR
+{
+public:
+  Counting_Allocator (void) : count_ (0) {}
+
+  virtual void *malloc (size_t nbytes)
+  {
+    ++this->count_;
+    return this->ALLOCATOR::malloc (nbytes);
+  }
+
+  size_t count_;
+};
+
+static int
+test_size_classes (void)
+{
+  int status = 0;
+  SLAB_ALLOCATOR allocator (1024, 4096);
+
+  static const size_t sizes[][2] =
+    {
+      { 0, 16 }, { 1, 16 }, { 16, 16 }, { 17, 32 },
+      { 100, 128 }, { 1024, 1024 }, { 1025, 0 }
+    };
+
+  for (size_t i = 0; i < sizeof sizes / sizeof sizes[0]; ++i)
+    if (allocator.chunk_size (sizes[i][0]) != sizes[i][1])
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("chunk size of %B is %B, expected %B\n"),
+                    sizes[i][0],
+                    allocator.chunk_size (sizes[i][0]),
+                    sizes[i][1]));
+        status = 1;
+      }
+
+  // Fill one chunk of each size and check none overlaps another.
+  char *chunks[12];
+  for (size_t i = 0; i < 12; ++i)
+    {
+      size_t const size = size_t (1) << i;
+      chunks[i] = static_cast<char *> (allocator.malloc (size));
+      if (chunks[i] == 0)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("malloc")), 1);
+      ACE_OS::memset (chunks[i], static_cast<int> ('a' + i), size);
+    }
+
+  for (size_t i = 0; i < 12; ++i)
+    {
+      size_t const size = size_t (1) << i;
+      if (chunks[i][0] != static_cast<char> ('a' + i)
+          || chunks[i][size - 1] != static_cast<char> ('a' + i))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("chunk of %B bytes was overwritten\n"),
+                      size));
+          status = 1;
+        }
+    }
+
+  size_t const depth = allocator.pool_depth (100);
+  for (size_t i = 0; i < 12; ++i)
+    allocator.free (chunks[i]);
+  allocator.free (0);
+
+  // The chunk of 128 bytes went back to its class, the 2048 byte one
+  // to the heap.
+  if (allocator.pool_depth (100) != depth + 1
+      || allocator.pool_depth (2048) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("pool depth %B, expected %B\n"),
+                  allocator.pool_depth (100),
+                  depth + 1));
+      status = 1;
+    }
+
+  // A freed chunk is handed out again.
+  void *again = allocator.malloc (128);
+  if (again != chunks[7])
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("freed chunk not reused\n")));
+      status = 1;
+    }
+  allocator.free (again);
+
+  return status;
+}
+
+#if defined (ACE_HAS_THREADS)
+
+static int thread_status = 0;
+
+static ACE_THR_FUNC_RETURN
+worker (void *arg)
+{
+  SLAB_ALLOCATOR *allocator = static_cast<SLAB_ALLOCATOR *> (arg);
+  char *chunks[64];
+  char const tag = static_cast<char> (ACE_OS::thr_self () & 0x7f);
+
+  for (size_t i = 0; i < 2000; ++i)
+    {
+      for (size_t j = 0; j < 64; ++j)
+        {
+          size_t const size = 8 + ((i + j) * 37) % 3000;
+          chunks[j] = static_cast<char *> (allocator->malloc (size));
+          if (chunks[j] == 0)
+            {
+              thread_status = 1;
+              return 0;
+            }
+          chunks[j][0] = tag;
+          chunks[j][size - 1] = tag;
+        }
+
+      for (size_t j = 0; j < 64; ++j)
+        {
+          size_t const size = 8 + ((i + j) * 37) % 3000;
+          if (chunks[j][0] != tag || chunks[j][size - 1] != tag)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%t) chunk %@ is shared\n"),
+                          chunks[j]));
+              thread_status = 1;
+            }
+          allocator->free (chunks[j]);
+        }
+    }
+
+  return 0;
+}
+
+static int
+test_threads (void)
+{
+  SLAB_ALLOCATOR allocator (2048);
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (4, worker, &allocator) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 1);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  return thread_status;
+}
+
+#endif /* ACE_HAS_THREADS */
+
+// Allocations for @a n message blocks of @a size bytes with
+// @a allocator as their buffer and data block allocator.
+template <class ALLOCATOR>
+static size_t
+message_block_allocations (ALLOCATOR &allocator, size_t n, size_t size)
+{
+  allocator.count_ = 0;
+
+  for (size_t i = 0; i < n; ++i)
+    {
+      ACE_Message_Block mb (size,
+                            ACE_Message_Block::MB_DATA,
+                            0,
+                            0,
+                            &allocator,
+                            0,
+                            ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY,
+                            ACE_Time_Value::zero,
+                            ACE_Time_Value::max_time,
+                            &allocator);
+      ACE_OS::memset (mb.wr_ptr (), 'x', size);
+      mb.wr_ptr (size);
+    }
+
+  return allocator.count_;
+}
+
+static int
+test_colocated (void)
+{
+  int status = 0;
+  Counting_Allocator<SLAB_ALLOCATOR> slab;
+  Counting_Allocator<ACE_New_Allocator> heap;
+
+  // The data block and its buffer share a chunk.
+  {
+    ACE_Message_Block mb (512,
+                          ACE_Message_Block::MB_DATA,
+                          0,
+                          0,
+                          &slab,
+                          0,
+                          ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY,
+                          ACE_Time_Value::zero,
+                          ACE_Time_Value::max_time,
+                          &heap);
+
+    char *const db = reinterpret_cast<char *> (mb.data_block ());
+    if (mb.base () <= db
+        || mb.base () > db + sizeof (ACE_Data_Block) + 64
+        || mb.data_block ()->data_block_allocator () != &slab
+        || mb.size () != 512)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("buffer not colocated with its data block\n")));
+        status = 1;
+      }
+
+    ACE_OS::strcpy (mb.wr_ptr (), "colocated");
+    mb.wr_ptr (10);
+
+    // A clone is colocated too, and doesn't lose the data.
+    ACE_Message_Block *clone = mb.clone ();
+    ACE_Message_Block *dup = mb.duplicate ();
+    if (clone == 0 || dup == 0
+        || ACE_OS::strcmp (clone->rd_ptr (), "colocated") != 0
+        || reinterpret_cast<char *> (clone->data_block ()) + sizeof (ACE_Data_Block) + 64
+             < clone->base ())
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("clone of colocated block\n")));
+        status = 1;
+      }
+
+    // Growing the buffer moves it out of the chunk.
+    if (clone != 0
+        && (clone->size (8192) != 0
+            || ACE_OS::strcmp (clone->rd_ptr (), "colocated") != 0))
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("resize of colocated block\n")));
+        status = 1;
+      }
+
+    if (clone != 0)
+      clone->release ();
+    if (dup != 0)
+      dup->release ();
+  }
+
+  size_t const n = 1000;
+  size_t const slab_count = message_block_allocations (slab, n, 256);
+  size_t const heap_count = message_block_allocations (heap, n, 256);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%B message blocks took %B allocations from ")
+              ACE_TEXT ("ACE_Slab_Allocator, %B from ACE_New_Allocator\n"),
+              n,
+              slab_count,
+              heap_count));
+
+  if (slab_count != n || heap_count != 2 * n)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("expected %B and %B allocations\n"),
+                  n,
+                  2 * n));
+      status = 1;
+    }
+
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Slab_Allocator_Test"));
+
+  int status = 0;
+
+  status |= test_size_classes ();
+  status |= test_colocated ();
+#if defined (ACE_HAS_THREADS)
+  status |= test_threads ();
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
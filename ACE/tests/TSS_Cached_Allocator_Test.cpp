@@ -0,0 +1,243 @@
+//=============================================================================
+/**
+ *  @file    TSS_Cached_Allocator_Test.cpp
+ *
+ *  Tests ACE_TSS_Cached_Allocator with threads that free the chunks
+ *  allocated by others, and compares its speed with
+ *  ACE_Dynamic_Cached_Allocator.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/TSS_Cached_Allocator_T.h"
+#include "ace/Malloc_T.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Message_Queue_T.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_string.h"
+
+#if defined (ACE_HAS_THREADS)
+
+typedef ACE_TSS_Cached_Allocator<ACE_Thread_Mutex> TSS_ALLOCATOR;
+typedef ACE_Dynamic_Cached_Allocator<ACE_Thread_Mutex> DYNAMIC_ALLOCATOR;
+
+static const size_t chunk_size = 40;
+static const size_t n_chunks = 64;
+static const size_t n_threads = 4;
+static const size_t iterations = 2000;
+static const size_t batch = 50;
+
+static int status = 0;
+
+// Chunks handed from each thread to the next one, which frees them.
+static ACE_Message_Queue<ACE_MT_SYNCH> *queues[n_threads];
+
+static ACE_THR_FUNC_RETURN
+worker (void *arg)
+{
+  TSS_ALLOCATOR *allocator = static_cast<TSS_ALLOCATOR *> (arg);
+
+  // Each thread finds its queue by taking the next free slot.
+  static ACE_Thread_Mutex slot_lock;
+  static size_t next_slot = 0;
+  size_t slot = 0;
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, slot_lock, 0);
+    slot = next_slot++;
+  }
+  ACE_Message_Queue<ACE_MT_SYNCH> *to_next = queues[(slot + 1) % n_threads];
+  ACE_Message_Queue<ACE_MT_SYNCH> *mine = queues[slot];
+
+  char *chunks[batch];
+
+  for (size_t i = 0; i < iterations; ++i)
+    {
+      for (size_t j = 0; j < batch; ++j)
+        {
+          chunks[j] = static_cast<char *> (allocator->malloc (chunk_size));
+          if (chunks[j] == 0)
+            {
+              ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("malloc")));
+              status = 1;
+              return 0;
+            }
+          ACE_OS::memset (chunks[j], static_cast<int> (slot + 1), chunk_size);
+        }
+
+      for (size_t j = 0; j < batch; ++j)
+        if (chunks[j][0] != static_cast<char> (slot + 1)
+            || chunks[j][chunk_size - 1] != static_cast<char> (slot + 1))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("(%t) chunk %@ is shared\n"),
+                        chunks[j]));
+            status = 1;
+          }
+
+      // Every other round, the chunks are freed by the next thread.
+      if (i % 2 == 0)
+        {
+          for (size_t j = 0; j < batch; ++j)
+            {
+              ACE_Message_Block *mb = 0;
+              ACE_NEW_RETURN (mb, ACE_Message_Block (chunks[j], chunk_size), 0);
+              to_next->enqueue_tail (mb);
+            }
+        }
+      else
+        for (size_t j = 0; j < batch; ++j)
+          allocator->free (chunks[j]);
+
+      // Free what the previous thread handed over.
+      ACE_Time_Value no_wait (ACE_Time_Value::zero);
+      ACE_Message_Block *mb = 0;
+      while (mine->dequeue_head (mb, &no_wait) != -1)
+        {
+          allocator->free (mb->base ());
+          mb->release ();
+        }
+    }
+
+  return 0;
+}
+
+static int
+test_threads (void)
+{
+  TSS_ALLOCATOR allocator (n_chunks, chunk_size, 16);
+
+  // The queues must not block once the thread freeing from them is
+  // done.
+  size_t const queued = iterations * batch * chunk_size;
+  for (size_t i = 0; i < n_threads; ++i)
+    queues[i] = new ACE_Message_Queue<ACE_MT_SYNCH> (queued, queued);
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (n_threads, worker, &allocator) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 1);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  // Free what is still queued.
+  for (size_t i = 0; i < n_threads; ++i)
+    {
+      ACE_Time_Value no_wait (ACE_Time_Value::zero);
+      ACE_Message_Block *mb = 0;
+      while (queues[i]->dequeue_head (mb, &no_wait) != -1)
+        {
+          allocator.free (mb->base ());
+          mb->release ();
+        }
+      delete queues[i];
+    }
+
+  // The chunks cached by the threads went back to the depot when they
+  // exited, those freed here are cached by this thread.
+  size_t const depth = allocator.pool_depth ();
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%B chunks in the depot after the threads exited\n"),
+              depth));
+  if (depth == 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("the threads didn't return their chunks\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_sizes (void)
+{
+  TSS_ALLOCATOR allocator (0, chunk_size);
+  int result = 0;
+
+  if (allocator.chunk_size () < chunk_size)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("chunk size %B is below %B\n"),
+                       allocator.chunk_size (),
+                       chunk_size),
+                      1);
+
+  // Larger requests aren't cached.
+  char *large = static_cast<char *> (allocator.malloc (10 * chunk_size));
+  char *small = static_cast<char *> (allocator.calloc (chunk_size, 'x'));
+  if (large == 0 || small == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("malloc")), 1);
+
+  ACE_OS::memset (large, 'y', 10 * chunk_size);
+  if (small[0] != 'x' || small[chunk_size - 1] != 'x')
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("calloc didn't set the chunk\n")));
+      result = 1;
+    }
+
+  allocator.free (large);
+  allocator.free (small);
+  allocator.free (0);
+
+  // The depot grew by a magazine for the small chunk, and that whole
+  // magazine is now cached by this thread.
+  if (allocator.pool_depth () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B chunks in the depot, expected 0\n"),
+                  allocator.pool_depth ()));
+      result = 1;
+    }
+
+  return result;
+}
+
+template <class ALLOCATOR>
+static double
+speed (ALLOCATOR &allocator)
+{
+  void *chunks[batch];
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  for (size_t i = 0; i < iterations * 10; ++i)
+    {
+      for (size_t j = 0; j < batch; ++j)
+        chunks[j] = allocator.malloc (chunk_size);
+      for (size_t j = 0; j < batch; ++j)
+        allocator.free (chunks[j]);
+    }
+  timer.stop ();
+
+  ACE_hrtime_t usecs = 0;
+  timer.elapsed_microseconds (usecs);
+  return static_cast<double> (usecs) * 1000.0 / (iterations * 10 * batch);
+}
+
+#endif /* ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("TSS_Cached_Allocator_Test"));
+
+  int result = 0;
+
+#if defined (ACE_HAS_THREADS)
+  result |= test_sizes ();
+  result |= test_threads ();
+
+  TSS_ALLOCATOR tss_allocator (batch, chunk_size);
+  DYNAMIC_ALLOCATOR dynamic_allocator (batch, chunk_size);
+  double const tss_ns = speed (tss_allocator);
+  double const dynamic_ns = speed (dynamic_allocator);
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("malloc+free: %.1f ns with ACE_TSS_Cached_Allocator, ")
+              ACE_TEXT ("%.1f ns with ACE_Dynamic_Cached_Allocator\n"),
+              tss_ns,
+              dynamic_ns));
+#else
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return result;
+}
@@ -3,9 +3,10 @@
 /**
  *  @file    Timer_Queue_Test.cpp
  *
- *    This is a simple test of <ACE_Timer_Queue> and four of its
+ *    This is a simple test of <ACE_Timer_Queue> and five of its
  *    subclasses (<ACE_Timer_List>, <ACE_Timer_Heap>,
- *    <ACE_Timer_Wheel>, and <ACE_Timer_Hash>).  The test sets up a
+ *    <ACE_Timer_Wheel>, <ACE_Timer_Hierarchical_Wheel>, and
+ *    <ACE_Timer_Hash>).  The test sets up a
  *    bunch of timers and then adds them to a timer queue. The
  *    functionality of the timer queue is then tested. No command
  *    line arguments are needed to run the test.
@@ -23,12 +24,14 @@
 #include "ace/Timer_List.h"
 #include "ace/Timer_Heap.h"
 #include "ace/Timer_Wheel.h"
+#include "ace/Timer_Hierarchical_Wheel.h"
 #include "ace/Timer_Hash.h"
 #include "ace/Timer_Queue.h"
 #include "ace/Time_Policy.h"
 #include "ace/Recursive_Thread_Mutex.h"
 #include "ace/Null_Mutex.h"
 #include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_stdlib.h"
 #include "ace/Containers_T.h"
 #include "ace/Event_Handler.h"
 
@@ -129,6 +132,96 @@ test_interval_timer (ACE_Timer_Queue *tq)
   tq->cancel (id);
 }
 
+// Checks that each timer expires in the first call to expire() that
+// is passed a time at or after its timeout value.
+class Expiration_Handler : public ACE_Event_Handler
+{
+public:
+  Expiration_Handler (const ACE_Time_Value *times)
+    : times_ (times), count_ (0), wrong_ (0) {}
+
+  virtual int handle_timeout (const ACE_Time_Value &current_time,
+                              const void *arg)
+  {
+    const ACE_Time_Value &t = this->times_[reinterpret_cast<size_t> (arg)];
+    if (t > current_time || t <= this->previous_)
+      ++this->wrong_;
+    ++this->count_;
+    return 0;
+  }
+
+  const ACE_Time_Value *times_;
+
+  /// Time passed to the previous call to expire().
+  ACE_Time_Value previous_;
+
+  int count_;
+  int wrong_;
+};
+
+static void
+test_expiration_order (ACE_Timer_Queue *tq)
+{
+  ACE_TEST_ASSERT (tq->is_empty () != 0);
+
+  ACE_Time_Value *times = 0;
+  ACE_NEW (times, ACE_Time_Value[max_iterations]);
+
+  // Spread the timers over milliseconds, hours and decades so that
+  // queues that bucket them by time have to move them around.
+  ACE_Time_Value const base = tq->gettimeofday ();
+  u_int seed = 4711;
+  for (int i = 0; i < max_iterations; ++i)
+    {
+      long const r = ACE_OS::rand_r (&seed);
+      switch (i % 3)
+        {
+        case 0:
+          times[i] = base + ACE_Time_Value (0, r % 1000000);
+          break;
+        case 1:
+          times[i] = base + ACE_Time_Value (r % 3600, r % 1000);
+          break;
+        default:
+          times[i] = base + ACE_Time_Value (static_cast<time_t> (r % 1000) * 1576800);
+          break;
+        }
+    }
+
+  Expiration_Handler handler (times);
+  int cancelled = 0;
+  for (int i = 0; i < max_iterations; ++i)
+    {
+      timer_ids[i] = tq->schedule (&handler,
+                                   reinterpret_cast<const void *> (static_cast<size_t> (i)),
+                                   times[i]);
+      ACE_TEST_ASSERT (timer_ids[i] != -1);
+    }
+
+  for (int i = 0; i < max_iterations; i += 7)
+    cancelled += tq->cancel (timer_ids[i]);
+
+  // Expire the timers in ever larger steps.
+  handler.previous_ = base;
+  for (ACE_Time_Value step (0, 1000);
+       !tq->is_empty ();
+       step *= 2)
+    {
+      tq->expire (base + step);
+      handler.previous_ = base + step;
+    }
+
+  if (handler.wrong_ != 0
+      || handler.count_ + cancelled != max_iterations)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("%d of %d timers expired, %d too early or late\n"),
+                handler.count_,
+                max_iterations - cancelled,
+                handler.wrong_));
+
+  delete [] times;
+}
+
 static void
 test_functionality (ACE_Timer_Queue *tq)
 {
@@ -656,6 +749,21 @@ run_main (int argc, ACE_TCHAR *argv[])
                                      ACE_TEXT ("ACE_Timer_Wheel (preallocated)"),
                                      tq_stack),
                   -1);
+
+  // Timer_Hierarchical_Wheel without preallocated memory
+  ACE_NEW_RETURN (tq_stack,
+                  Timer_Queue_Stack (new ACE_Timer_Hierarchical_Wheel,
+                                     ACE_TEXT ("ACE_Timer_Hierarchical_Wheel (non-preallocated)"),
+                                     tq_stack),
+                  -1);
+
+  // Timer_Hierarchical_Wheel with preallocated memory.
+  ACE_NEW_RETURN (tq_stack,
+                  Timer_Queue_Stack (new ACE_Timer_Hierarchical_Wheel (ACE_Time_Value::zero,
+                                                                       max_iterations),
+                                     ACE_TEXT ("ACE_Timer_Hierarchical_Wheel (preallocated)"),
+                                     tq_stack),
+                  -1);
   // Timer_Heap without preallocated memory.
   ACE_NEW_RETURN (tq_stack,
                   Timer_Queue_Stack (new ACE_Timer_Heap,
@@ -710,6 +818,7 @@ run_main (int argc, ACE_TCHAR *argv[])
                   tq_ptr->name_));
       test_interval_timer (tq_ptr->queue_);
       test_functionality (tq_ptr->queue_);
+      test_expiration_order (tq_ptr->queue_);
       test_performance (tq_ptr->queue_,
                         tq_ptr->name_);
       delete tq_ptr->queue_;
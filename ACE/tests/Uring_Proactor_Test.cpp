@@ -0,0 +1,316 @@
+//=============================================================================
+/**
+ *  @file    Uring_Proactor_Test.cpp
+ *
+ *  This test verifies the parts of the ACE_Uring_Proactor that
+ *  Proactor_Test doesn't reach: reads and writes on registered
+ *  buffers, cancellation of operations in flight and operations
+ *  started by a thread that exits before they complete.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Proactor.h"
+#include "ace/Asynch_IO.h"
+#include "ace/Uring_Proactor.h"
+#include "ace/Message_Block.h"
+#include "ace/Pipe.h"
+#include "ace/Thread_Manager.h"
+#include "ace/ACE.h"
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+static const char message[] = "Hello there! Hope you get this message";
+
+class Pipe_Handler : public ACE_Handler
+{
+public:
+  Pipe_Handler (ACE_Proactor &proactor);
+
+  int open (void);
+
+  virtual void handle_read_stream (const ACE_Asynch_Read_Stream::Result &result);
+
+  virtual void handle_write_stream (const ACE_Asynch_Write_Stream::Result &result);
+
+  ACE_Pipe pipe_;
+  ACE_Asynch_Read_Stream rs_;
+  ACE_Asynch_Write_Stream ws_;
+
+  int reads_;
+  int writes_;
+  size_t bytes_read_;
+  u_long read_error_;
+};
+
+Pipe_Handler::Pipe_Handler (ACE_Proactor &proactor)
+  : ACE_Handler (&proactor),
+    reads_ (0),
+    writes_ (0),
+    bytes_read_ (0),
+    read_error_ (0)
+{
+}
+
+int
+Pipe_Handler::open (void)
+{
+  if (this->pipe_.open () == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("pipe")), -1);
+
+  if (this->rs_.open (*this, this->pipe_.read_handle (), 0, this->proactor ()) == -1
+      || this->ws_.open (*this, this->pipe_.write_handle (), 0, this->proactor ()) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), -1);
+
+  return 0;
+}
+
+void
+Pipe_Handler::handle_read_stream (const ACE_Asynch_Read_Stream::Result &result)
+{
+  ++this->reads_;
+  this->bytes_read_ = result.bytes_transferred ();
+  this->read_error_ = result.error ();
+}
+
+void
+Pipe_Handler::handle_write_stream (const ACE_Asynch_Write_Stream::Result &result)
+{
+  ++this->writes_;
+  if (!result.success ())
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("write failed: %d\n"),
+                static_cast<int> (result.error ())));
+}
+
+// Run the event loop until @a count reaches @a expected or the time
+// limit passes.
+static bool
+run_until (ACE_Proactor &proactor, const int &count, int expected)
+{
+  ACE_Time_Value limit (5);
+  while (count < expected && limit > ACE_Time_Value::zero)
+    if (proactor.handle_events (limit) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                         ACE_TEXT ("handle_events")),
+                        false);
+
+  if (count < expected)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%d of %d completions dispatched\n"),
+                       count, expected),
+                      false);
+  return true;
+}
+
+static bool
+test_registered_buffers (ACE_Proactor &proactor, ACE_Uring_Proactor &impl)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing registered buffers\n")));
+
+  Pipe_Handler handler (proactor);
+  if (handler.open () == -1)
+    return false;
+
+  // One buffer holds both the data to write and the data read.
+  static char buffer[2 * sizeof (message)];
+  ACE_OS::memset (buffer, 0, sizeof (buffer));
+  ACE_OS::memcpy (buffer, message, sizeof (message));
+
+  iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = sizeof (buffer);
+  if (impl.register_buffers (&iov, 1) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("register_buffers")),
+                      false);
+
+  ACE_Message_Block out (buffer, sizeof (message));
+  out.wr_ptr (sizeof (message));
+  ACE_Message_Block in (buffer + sizeof (message), sizeof (message));
+
+  bool ok = true;
+  if (handler.ws_.write (out, sizeof (message)) == -1
+      || handler.rs_.read (in, sizeof (message)) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("start")));
+      ok = false;
+    }
+
+  if (ok)
+    ok = run_until (proactor, handler.writes_, 1)
+      && run_until (proactor, handler.reads_, 1);
+
+  if (ok && (handler.bytes_read_ != sizeof (message)
+             || ACE_OS::memcmp (buffer + sizeof (message),
+                                message,
+                                sizeof (message)) != 0))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("read %B bytes <%C>, expected <%C>\n"),
+                  handler.bytes_read_,
+                  buffer + sizeof (message),
+                  message));
+      ok = false;
+    }
+
+  if (impl.unregister_buffers () == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("unregister_buffers")));
+      ok = false;
+    }
+
+  return ok;
+}
+
+static bool
+test_cancel (ACE_Proactor &proactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing cancellation\n")));
+
+  Pipe_Handler handler (proactor);
+  if (handler.open () == -1)
+    return false;
+
+  // Nothing is written, so the read stays in flight until cancelled.
+  ACE_Message_Block in (sizeof (message));
+  if (handler.rs_.read (in, sizeof (message)) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("read")), false);
+
+  // Let the read reach the kernel.
+  ACE_Time_Value tv (0, 100000);
+  proactor.handle_events (tv);
+
+  int const cancelled = handler.rs_.cancel ();
+  if (cancelled != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("cancel returned %d, expected 0\n"),
+                       cancelled),
+                      false);
+
+  if (!run_until (proactor, handler.reads_, 1))
+    return false;
+
+  if (handler.read_error_ != ECANCELED)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("read completed with error %d, expected %d\n"),
+                       static_cast<int> (handler.read_error_), ECANCELED),
+                      false);
+
+  int const done = handler.rs_.cancel ();
+  if (done != 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("cancel returned %d without reads, ")
+                       ACE_TEXT ("expected 1\n"),
+                       done),
+                      false);
+
+  return true;
+}
+
+static ACE_THR_FUNC_RETURN
+start_read (void *arg)
+{
+  Pipe_Handler *handler = static_cast<Pipe_Handler *> (arg);
+
+  static ACE_Message_Block in (sizeof (message));
+  if (handler->rs_.read (in, sizeof (message)) == -1)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("read")));
+
+  // Submit the read from this thread, then exit.
+  ACE_Time_Value tv (ACE_Time_Value::zero);
+  handler->proactor ()->handle_events (tv);
+  return 0;
+}
+
+static bool
+test_thread_exit (ACE_Proactor &proactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing operations of exited threads\n")));
+
+  Pipe_Handler handler (proactor);
+  if (handler.open () == -1)
+    return false;
+
+  // The kernel cancels the read when the thread exits; the proactor
+  // must start it again rather than report it as cancelled.
+  if (ACE_Thread_Manager::instance ()->spawn (start_read, &handler) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), false);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  if (ACE::write_n (handler.pipe_.write_handle (),
+                    message,
+                    sizeof (message)) != static_cast<ssize_t> (sizeof (message)))
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("write_n")), false);
+
+  if (!run_until (proactor, handler.reads_, 1))
+    return false;
+
+  if (handler.read_error_ != 0 || handler.bytes_read_ != sizeof (message))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("read %B bytes with error %d\n"),
+                       handler.bytes_read_,
+                       static_cast<int> (handler.read_error_)),
+                      false);
+
+  return true;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Uring_Proactor_Test"));
+
+  int result = 0;
+
+  ACE_Uring_Proactor *impl = 0;
+  ACE_NEW_RETURN (impl, ACE_Uring_Proactor, -1);
+  if (impl->get_handle () == ACE_INVALID_HANDLE)
+    {
+      // Kernel too old or io_uring disabled at run time.
+      if (ACE_OS::last_error () == ENOTSUP
+          || ACE_OS::last_error () == ENOSYS
+          || ACE_OS::last_error () == EPERM)
+        ACE_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("ACE_Uring_Proactor is UNSUPPORTED by ")
+                    ACE_TEXT ("this kernel\n")));
+      else
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"),
+                      ACE_TEXT ("ACE_Uring_Proactor")));
+          ++result;
+        }
+      delete impl;
+      ACE_END_TEST;
+      return result;
+    }
+
+  {
+    ACE_Proactor proactor (impl, true);
+
+    if (!test_registered_buffers (proactor, *impl))
+      ++result;
+    if (!test_cancel (proactor))
+      ++result;
+    if (!test_thread_exit (proactor))
+      ++result;
+  }
+
+  ACE_END_TEST;
+  return result;
+}
+
+#else
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Uring_Proactor_Test"));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("ACE_Uring_Proactor is UNSUPPORTED on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
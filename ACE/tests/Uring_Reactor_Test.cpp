@@ -0,0 +1,410 @@
+//=============================================================================
+/**
+ *  @file    Uring_Reactor_Test.cpp
+ *
+ *  This test verifies the ACE_Uring_Reactor: dispatch order of timers,
+ *  output and input, suspension and resumption of handlers, dispatching
+ *  of many handles that become ready at once, notifications from other
+ *  threads and removal of handlers while events for them are queued.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/Reactor.h"
+#include "ace/Uring_Reactor.h"
+#include "ace/Pipe.h"
+#include "ace/ACE.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_EVENT_POLL)
+
+static const char *message = "Hello there! Hope you get this message";
+
+// Number of pipes made ready at the same time.
+static const size_t pipe_count = 64;
+
+// Number of notifications sent by each notifier thread.
+static const int notifications = 1000;
+
+// Number of notifier threads.
+static const int notifier_threads = 4;
+
+class Order_Handler : public ACE_Event_Handler
+{
+public:
+  Order_Handler (ACE_Reactor &reactor);
+
+  ~Order_Handler (void);
+
+  int handle_timeout (const ACE_Time_Value &tv, const void *arg);
+
+  int handle_input (ACE_HANDLE fd);
+
+  int handle_output (ACE_HANDLE fd);
+
+  ACE_HANDLE get_handle (void) const;
+
+  ACE_Pipe pipe_;
+
+  int dispatch_order_;
+  bool ok_;           // Constructed and initialized ok
+};
+
+Order_Handler::Order_Handler (ACE_Reactor &reactor)
+  : ACE_Event_Handler (&reactor),
+    dispatch_order_ (1),
+    ok_ (false)
+{
+  if (0 != this->pipe_.open ())
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("pipe")));
+  else if (0 != this->reactor ()->register_handler
+                  (this->pipe_.read_handle (),
+                   this,
+                   ACE_Event_Handler::READ_MASK | ACE_Event_Handler::WRITE_MASK))
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("register")));
+  else
+    this->ok_ = true;
+}
+
+Order_Handler::~Order_Handler (void)
+{
+  this->pipe_.close ();
+}
+
+ACE_HANDLE
+Order_Handler::get_handle (void) const
+{
+  return this->pipe_.read_handle ();
+}
+
+int
+Order_Handler::handle_timeout (const ACE_Time_Value &, const void *)
+{
+  int me = this->dispatch_order_++;
+  if (me != 1)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("handle_timeout should be #1; it's %d\n"),
+                me));
+  return 0;
+}
+
+int
+Order_Handler::handle_output (ACE_HANDLE)
+{
+  int me = this->dispatch_order_++;
+  if (me != 2)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("handle_output should be #2; it's %d\n"),
+                me));
+
+  // Don't want to continually see writeable; only verify its relative order.
+  this->reactor ()->mask_ops (this->pipe_.read_handle (),
+                              ACE_Event_Handler::WRITE_MASK,
+                              ACE_Reactor::CLR_MASK);
+  return 0;
+}
+
+int
+Order_Handler::handle_input (ACE_HANDLE fd)
+{
+  int me = this->dispatch_order_++;
+  if (me != 3)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("handle_input should be #3; it's %d\n"),
+                me));
+
+  char buffer[BUFSIZ];
+  ssize_t result = ACE::recv (fd, buffer, sizeof buffer);
+  if (result != ssize_t (ACE_OS::strlen (message)))
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("Handler recv'd %b bytes; expected %B\n"),
+                result, ACE_OS::strlen (message)));
+
+  this->reactor ()->end_reactor_event_loop ();
+  return 0;
+}
+
+static bool
+test_dispatch_order (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing dispatch order\n")));
+
+  Order_Handler handler (reactor);
+  if (!handler.ok_)
+    return false;
+
+  bool ok_to_go = true;
+
+  ssize_t result =
+    ACE::send_n (handler.pipe_.write_handle (),
+                 message,
+                 ACE_OS::strlen (message));
+  if (result != ssize_t (ACE_OS::strlen (message)))
+    ok_to_go = false;
+
+  if (-1 == reactor.schedule_timer (&handler, 0, ACE_Time_Value (0)))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("schedule_timer")));
+      ok_to_go = false;
+    }
+
+  // Suspend the handlers - only the timer should be dispatched.
+  ACE_Time_Value tv (1);
+  reactor.suspend_handlers ();
+  reactor.run_reactor_event_loop (tv);
+
+  if (handler.dispatch_order_ != 2)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Incorrect number fired %d\n"),
+                  handler.dispatch_order_));
+      ok_to_go = false;
+    }
+
+  handler.dispatch_order_ = 1;
+  if (-1 == reactor.schedule_timer (&handler, 0, ACE_Time_Value (0)))
+    ok_to_go = false;
+
+  // Resume the handlers - things should work now.
+  reactor.resume_handlers ();
+
+  if (ok_to_go)
+    {
+      tv.set (1, 0);
+      reactor.run_reactor_event_loop (tv);
+    }
+
+  if (0 != reactor.remove_handler (handler.pipe_.read_handle (),
+                                   ACE_Event_Handler::ALL_EVENTS_MASK |
+                                   ACE_Event_Handler::DONT_CALL))
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("remove_handler")));
+
+  if (handler.dispatch_order_ != 4)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Incorrect number fired %d\n"),
+                  handler.dispatch_order_));
+      ok_to_go = false;
+    }
+
+  // handle_input() ended the event loop; let the next tests run it.
+  reactor.reset_reactor_event_loop ();
+
+  return ok_to_go;
+}
+
+/**
+ * Reads a fixed number of messages from its pipe.  Used to check that
+ * completions for many handles are all dispatched, and that handles
+ * are re-armed after each upcall.
+ */
+class Pipe_Reader : public ACE_Event_Handler
+{
+public:
+  Pipe_Reader (void) : received_ (0) {}
+
+  ACE_HANDLE get_handle (void) const { return this->pipe_.read_handle (); }
+
+  int handle_input (ACE_HANDLE fd)
+  {
+    char c;
+    if (ACE::recv (fd, &c, 1) == 1)
+      ++this->received_;
+    return 0;
+  }
+
+  ACE_Pipe pipe_;
+  int received_;
+};
+
+static bool
+test_many_handles (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing %B handles\n"), pipe_count));
+
+  bool ok_to_go = true;
+  Pipe_Reader readers[pipe_count];
+
+  for (size_t i = 0; i < pipe_count; ++i)
+    if (readers[i].pipe_.open () != 0
+        || reactor.register_handler (&readers[i],
+                                     ACE_Event_Handler::READ_MASK) != 0)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p %B\n"),
+                    ACE_TEXT ("register"), i));
+        return false;
+      }
+
+  // Make every pipe ready twice so each handle must be re-armed.
+  for (int round = 0; round < 2; ++round)
+    {
+      for (size_t i = 0; i < pipe_count; ++i)
+        ACE::send_n (readers[i].pipe_.write_handle (), "x", 1);
+
+      int expected = (round + 1) * static_cast<int> (pipe_count);
+      int total = 0;
+      ACE_Time_Value deadline = ACE_OS::gettimeofday () + ACE_Time_Value (5);
+      while (total < expected && ACE_OS::gettimeofday () < deadline)
+        {
+          ACE_Time_Value tv (0, 100000);
+          reactor.handle_events (tv);
+          total = 0;
+          for (size_t i = 0; i < pipe_count; ++i)
+            total += readers[i].received_;
+        }
+
+      if (total != expected)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Round %d: received %d, expected %d\n"),
+                      round, total, expected));
+          ok_to_go = false;
+        }
+    }
+
+  // Queue data, remove the handlers and make sure nothing is
+  // dispatched for them any more.
+  for (size_t i = 0; i < pipe_count; ++i)
+    {
+      ACE::send_n (readers[i].pipe_.write_handle (), "x", 1);
+      reactor.remove_handler (&readers[i],
+                              ACE_Event_Handler::READ_MASK |
+                              ACE_Event_Handler::DONT_CALL);
+    }
+
+  ACE_Time_Value tv (0, 200000);
+  reactor.handle_events (tv);
+
+  for (size_t i = 0; i < pipe_count; ++i)
+    {
+      if (readers[i].received_ != 2)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Reader %B dispatched %d times after ")
+                      ACE_TEXT ("removal\n"),
+                      i, readers[i].received_ - 2));
+          ok_to_go = false;
+        }
+      readers[i].pipe_.close ();
+    }
+
+  return ok_to_go;
+}
+
+class Notify_Handler : public ACE_Event_Handler
+{
+public:
+  Notify_Handler (void) : count_ (0) {}
+
+  int handle_exception (ACE_HANDLE)
+  {
+    ++this->count_;
+    return 0;
+  }
+
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> count_;
+};
+
+class Notifier : public ACE_Task_Base
+{
+public:
+  Notifier (ACE_Reactor &reactor, Notify_Handler &handler)
+    : reactor_ (reactor), handler_ (handler) {}
+
+  int svc (void)
+  {
+    for (int i = 0; i < notifications; ++i)
+      if (this->reactor_.notify (&this->handler_) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("(%t) %p\n"),
+                           ACE_TEXT ("notify")), -1);
+    return 0;
+  }
+
+private:
+  ACE_Reactor &reactor_;
+  Notify_Handler &handler_;
+};
+
+static bool
+test_notify (ACE_Reactor &reactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing notifications\n")));
+
+  Notify_Handler handler;
+  Notifier notifier (reactor, handler);
+  long const expected = notifications * notifier_threads;
+
+  if (notifier.activate (THR_NEW_LWP | THR_JOINABLE, notifier_threads) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("activate")), false);
+
+  ACE_Time_Value deadline = ACE_OS::gettimeofday () + ACE_Time_Value (10);
+  while (handler.count_.value () < expected
+         && ACE_OS::gettimeofday () < deadline)
+    {
+      ACE_Time_Value tv (0, 100000);
+      reactor.handle_events (tv);
+    }
+
+  notifier.wait ();
+
+  if (handler.count_.value () != expected)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("Received %d notifications, expected %d\n"),
+                       handler.count_.value (), expected), false);
+  return true;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Uring_Reactor_Test"));
+  int result = 0;
+
+  ACE_Uring_Reactor uring_reactor_impl;
+  if (!uring_reactor_impl.initialized ())
+    {
+      // Kernel too old or io_uring disabled at run time.
+      if (ACE_OS::last_error () == ENOTSUP
+          || ACE_OS::last_error () == ENOSYS
+          || ACE_OS::last_error () == EPERM)
+        ACE_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("ACE_Uring_Reactor is UNSUPPORTED by ")
+                    ACE_TEXT ("this kernel\n")));
+      else
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"),
+                      ACE_TEXT ("ACE_Uring_Reactor")));
+          ++result;
+        }
+      ACE_END_TEST;
+      return result;
+    }
+
+  ACE_Reactor reactor (&uring_reactor_impl);
+
+  // suspend_handlers()/resume_handlers() in test_dispatch_order()
+  // also affect the notification handle, so run it last.
+  if (!test_notify (reactor))
+    ++result;
+  if (!test_many_handles (reactor))
+    ++result;
+  if (!test_dispatch_order (reactor))
+    ++result;
+
+  ACE_END_TEST;
+  return result;
+}
+
+#else
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Uring_Reactor_Test"));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("ACE_Uring_Reactor is UNSUPPORTED on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+#endif /* ACE_HAS_IO_URING && ACE_HAS_EVENT_POLL */
@@ -2656,6 +2656,13 @@ TAO_CodeGen::gen_stub_hdr_includes (void)
       this->gen_standard_include (this->client_header_,
                                   "ace/streams.h");
     }
+
+  // ACE_SizeCDR and its operators for the sequences.
+  if (be_global->gen_size_cdr ())
+    {
+      this->gen_standard_include (this->client_header_,
+                                  "tao/Sequence_CDR_Size_T.h");
+    }
 }
 
 void
@@ -136,6 +136,7 @@ BE_GlobalData::BE_GlobalData (void)
     use_clonable_in_args_ (false),
     gen_template_export_ (false),
     gen_ostream_operators_ (false),
+    gen_size_cdr_ (false),
     gen_static_desc_operations_ (false),
     gen_custom_ending_ (true),
     gen_unique_guards_ (true),
@@ -1363,6 +1364,18 @@ BE_GlobalData::gen_ostream_operators (bool val)
   this->gen_ostream_operators_ = val;
 }
 
+bool
+BE_GlobalData::gen_size_cdr (void) const
+{
+  return this->gen_size_cdr_;
+}
+
+void
+BE_GlobalData::gen_size_cdr (bool val)
+{
+  this->gen_size_cdr_ = val;
+}
+
 
 bool
 BE_GlobalData::gen_static_desc_operations (void) const
@@ -3265,6 +3278,11 @@ BE_GlobalData::parse_args (long &i, char **av)
                 // CIAO servant code generation.
                 be_global->gen_ciao_svnt (true);
               }
+            else if (av[i][3] == 'z')
+              {
+                // ACE_SizeCDR operators and stub size pass.
+                be_global->gen_size_cdr (true);
+              }
             else if (av[i][3] == 't' && av[i][4] == 'l')
               {
                 // Generate code using STL types for strings
@@ -26,6 +26,10 @@
 #include "ast_structure.h"
 #include "ast_structure_fwd.h"
 #include "ast_string.h"
+#include "ast_sequence.h"
+#include "ast_field.h"
+#include "ast_predefined_type.h"
+#include "ast_array.h"
 
 #include "ace/OS_NS_string.h"
 
@@ -598,6 +602,12 @@ be_util::usage (void)
       LM_DEBUG,
       ACE_TEXT (" -Gos \t\t\tGenerate std::ostream insertion operators.\n")
     ));
+  ACE_DEBUG ((
+      LM_DEBUG,
+      ACE_TEXT (" -Gsz \t\t\tGenerate ACE_SizeCDR insertion operators and ")
+      ACE_TEXT ("size the\n\t\t\targuments of the stubs before ")
+      ACE_TEXT ("marshaling them\n")
+    ));
   ACE_DEBUG ((
       LM_DEBUG,
       ACE_TEXT (" -GI[h|s|b|e|c|a|d]\tGenerate Implementation Files\n")
@@ -1119,3 +1129,196 @@ be_util::set_arg_seen_bit (be_type *bt)
     }
 }
 
+bool
+be_util::has_size_cdr_op (AST_Type *type)
+{
+  AST_Type *t = type->unaliased_type ();
+
+  switch (t->node_type ())
+    {
+      case AST_Decl::NT_pre_defined:
+        {
+          AST_PredefinedType *pdt = AST_PredefinedType::narrow_from_decl (t);
+
+          switch (pdt->pt ())
+            {
+              case AST_PredefinedType::PT_any:
+              case AST_PredefinedType::PT_object:
+              case AST_PredefinedType::PT_value:
+              case AST_PredefinedType::PT_abstract:
+              case AST_PredefinedType::PT_void:
+              case AST_PredefinedType::PT_pseudo:
+                return false;
+              default:
+                return true;
+            }
+        }
+      case AST_Decl::NT_string:
+      case AST_Decl::NT_wstring:
+        return true;
+      case AST_Decl::NT_sequence:
+        // TAO has the operators for the sequence templates, so this
+        // covers the sequences declared in ORB IDL as well.
+        return !be_global->alt_mapping ()
+               && be_util::has_size_cdr_op (
+                    AST_Sequence::narrow_from_decl (t)->base_type ());
+      case AST_Decl::NT_struct_fwd:
+        {
+          AST_Structure *fd =
+            AST_StructureFwd::narrow_from_decl (t)->full_definition ();
+
+          return fd != 0 && be_util::has_size_cdr_op (fd);
+        }
+      case AST_Decl::NT_enum:
+      case AST_Decl::NT_struct:
+        {
+          // ORB IDL is not compiled with -Gsz.
+          ACE_CString const &file = t->file_name ();
+          ACE_CString::size_type const len = file.length ();
+          if (t->imported ()
+              && len > 5
+              && file.substr (len - 5) == ".pidl")
+            {
+              return false;
+            }
+
+          if (t->node_type () == AST_Decl::NT_enum)
+            {
+              return true;
+            }
+
+          AST_Structure *s = AST_Structure::narrow_from_decl (t);
+          ACE_Unbounded_Queue<AST_Type *> list;
+
+          if (s->is_local () || s->in_recursion (list))
+            {
+              return false;
+            }
+
+          AST_Field **f = 0;
+
+          for (ACE_CDR::ULong i = 0; i < s->nfields (); ++i)
+            {
+              if (s->field (f, i) != 0
+                  || !be_util::has_size_cdr_op ((*f)->field_type ()))
+                {
+                  return false;
+                }
+            }
+
+          return true;
+        }
+      default:
+        return false;
+    }
+}
+
+bool
+be_util::cdr_pod_layout (AST_Type *type,
+                         ACE_CDR::ULong &size,
+                         ACE_CDR::ULong &align)
+{
+  AST_Type *t = type->unaliased_type ();
+
+  switch (t->node_type ())
+    {
+      case AST_Decl::NT_pre_defined:
+        // Boolean, wchar and long double don't map to a C++ type
+        // with the CDR representation on all platforms.
+        switch (AST_PredefinedType::narrow_from_decl (t)->pt ())
+          {
+            case AST_PredefinedType::PT_octet:
+            case AST_PredefinedType::PT_char:
+              size = align = 1;
+              return true;
+            case AST_PredefinedType::PT_short:
+            case AST_PredefinedType::PT_ushort:
+              size = align = 2;
+              return true;
+            case AST_PredefinedType::PT_long:
+            case AST_PredefinedType::PT_ulong:
+            case AST_PredefinedType::PT_float:
+              size = align = 4;
+              return true;
+            case AST_PredefinedType::PT_longlong:
+            case AST_PredefinedType::PT_ulonglong:
+            case AST_PredefinedType::PT_double:
+              size = align = 8;
+              return true;
+            default:
+              return false;
+          }
+      case AST_Decl::NT_array:
+        {
+          AST_Array *array = AST_Array::narrow_from_decl (t);
+
+          if (!be_util::cdr_pod_layout (array->base_type (), size, align))
+            {
+              return false;
+            }
+
+          for (ACE_CDR::ULong i = 0; i < array->n_dims (); ++i)
+            {
+              AST_Expression *expr = array->dims ()[i];
+
+              if (expr == 0
+                  || expr->ev () == 0
+                  || expr->ev ()->et != AST_Expression::EV_ulong)
+                {
+                  return false;
+                }
+
+              size *= expr->ev ()->u.ulval;
+            }
+
+          return size != 0;
+        }
+      case AST_Decl::NT_struct:
+        {
+          AST_Structure *s = AST_Structure::narrow_from_decl (t);
+          AST_Field **f = 0;
+          ACE_CDR::ULong lead_align = 0;
+          size = 0;
+          align = 1;
+
+          // Every field has to start on its alignment and the struct
+          // has to end on its own, then neither the CDR encoding nor
+          // the C++ compiler pad anything.  The first field also has to
+          // have the alignment of the whole struct: the CDR encoding
+          // only aligns a struct for its first field, so a block that
+          // starts on the struct alignment is the same encoding only
+          // then.  The types accepted here all start with a member of
+          // their own alignment, so the nested ones need no more.
+          for (ACE_CDR::ULong i = 0; i < s->nfields (); ++i)
+            {
+              ACE_CDR::ULong field_size = 0;
+              ACE_CDR::ULong field_align = 0;
+
+              if (s->field (f, i) != 0
+                  || !be_util::cdr_pod_layout ((*f)->field_type (),
+                                               field_size,
+                                               field_align)
+                  || size % field_align != 0)
+                {
+                  return false;
+                }
+
+              if (i == 0)
+                {
+                  lead_align = field_align;
+                }
+
+              size += field_size;
+
+              if (field_align > align)
+                {
+                  align = field_align;
+                }
+            }
+
+          return size != 0 && size % align == 0 && lead_align == align;
+        }
+      default:
+        return false;
+    }
+}
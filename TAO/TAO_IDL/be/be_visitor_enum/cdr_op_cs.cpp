@@ -56,6 +56,17 @@ be_visitor_enum_cdr_op_cs::visit_enum (be_enum *node)
       << "return _tao_success;" << be_uidt_nl
       << "}" << be_nl;
 
+  if (be_global->gen_size_cdr ())
+    {
+      *os << be_nl
+          << "::CORBA::Boolean operator<< (ACE_SizeCDR &strm, "
+          << node->name () << " _tao_enumerator)" << be_nl
+          << "{" << be_idt_nl
+          << "return strm << static_cast< ::CORBA::ULong> (_tao_enumerator);"
+          << be_uidt_nl
+          << "}" << be_nl;
+    }
+
   if (be_global->gen_ostream_operators ())
     {
       node->gen_ostream_operator (os, false);
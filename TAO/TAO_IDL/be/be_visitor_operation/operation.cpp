@@ -315,6 +315,11 @@ be_visitor_operation::gen_stub_operation_body (
   *os << be_uidt_nl
       << ");" << be_uidt;
 
+  if (be_global->gen_size_cdr ())
+    {
+      this->gen_stub_size_pass (node, os);
+    }
+
   *os << be_nl_2;
 
   // Since oneways cannot raise user exceptions, we have that
@@ -454,6 +459,115 @@ be_visitor_operation::gen_stub_body_arglist (be_operation *node,
     }
 }
 
+void
+be_visitor_operation::gen_stub_size_pass (be_operation *node,
+                                          TAO_OutStream *os)
+{
+  AST_Argument *arg = 0;
+  bool variable = false;
+
+  for (UTL_ScopeActiveIterator arg_decl_iter (node, UTL_Scope::IK_decls);
+       ! arg_decl_iter.is_done ();
+       arg_decl_iter.next ())
+    {
+      arg = AST_Argument::narrow_from_decl (arg_decl_iter.item ());
+
+      if (arg->direction () == AST_Argument::dir_OUT)
+        {
+          continue;
+        }
+
+      if (!be_util::has_size_cdr_op (arg->field_type ()))
+        {
+          return;
+        }
+
+      if (arg->field_type ()->size_type () == AST_Type::VARIABLE)
+        {
+          variable = true;
+        }
+    }
+
+  // Fixed size arguments fit in the default buffer anyway.
+  if (!variable)
+    {
+      return;
+    }
+
+  *os << be_nl_2
+      << "ACE_SizeCDR _tao_size;" << be_nl_2
+      << "if (" << be_idt;
+
+  bool first = true;
+
+  for (UTL_ScopeActiveIterator arg_decl_iter (node, UTL_Scope::IK_decls);
+       ! arg_decl_iter.is_done ();
+       arg_decl_iter.next ())
+    {
+      arg = AST_Argument::narrow_from_decl (arg_decl_iter.item ());
+
+      if (arg->direction () == AST_Argument::dir_OUT)
+        {
+          continue;
+        }
+
+      if (!first)
+        {
+          *os << be_nl
+              << "&& ";
+        }
+
+      first = false;
+
+      // The types which share a C++ type with another IDL type are
+      // sized through the ACE_OutputCDR helpers, like they are
+      // marshaled.
+      AST_Type *t = arg->field_type ()->unaliased_type ();
+      const char *helper = 0;
+
+      if (t->node_type () == AST_Decl::NT_pre_defined)
+        {
+          switch (AST_PredefinedType::narrow_from_decl (t)->pt ())
+            {
+              case AST_PredefinedType::PT_boolean:
+                helper = "from_boolean";
+                break;
+              case AST_PredefinedType::PT_char:
+                helper = "from_char";
+                break;
+              case AST_PredefinedType::PT_wchar:
+                helper = "from_wchar";
+                break;
+              case AST_PredefinedType::PT_octet:
+                helper = "from_octet";
+                break;
+              default:
+                break;
+            }
+        }
+
+      *os << "(_tao_size << ";
+
+      if (helper != 0)
+        {
+          *os << "::ACE_OutputCDR::" << helper << " ("
+              << arg->local_name () << ")";
+        }
+      else
+        {
+          *os << arg->local_name ();
+        }
+
+      *os << ")";
+    }
+
+  *os << ")" << be_uidt << be_idt_nl
+      << "{" << be_idt_nl
+      << "_tao_call.marshal_size_hint (_tao_size.total_length ());"
+      << be_uidt_nl
+      << "}" << be_uidt;
+}
+
 void
 be_visitor_operation::gen_arg_template_param_name (AST_Decl *scope,
                                                    AST_Type *bt,
@@ -99,6 +99,15 @@ be_visitor_sequence_cdr_op_cs::visit_sequence (be_sequence *node)
 
   bool alt = be_global->alt_mapping ();
 
+  // A sequence of structs that are laid out like their CDR encoding
+  // is copied in one go, unless the bytes have to be swapped.
+  ACE_CDR::ULong pod_size = 0;
+  ACE_CDR::ULong pod_align = 0;
+  bool const pod =
+    !alt
+    && bt->unaliased_type ()->node_type () == AST_Decl::NT_struct
+    && be_util::cdr_pod_layout (bt, pod_size, pod_align);
+
   *os << be_global->core_versioning_begin () << be_nl;
 
   //  Set the sub state as generating code for the output operator.
@@ -134,9 +143,19 @@ be_visitor_sequence_cdr_op_cs::visit_sequence (be_sequence *node)
           << "const " << node->name () << " &_tao_sequence)"
           << be_uidt
           << be_uidt_nl
-          << "{" << be_idt_nl
-          << "return TAO::marshal_sequence(strm, _tao_sequence);"
-          << be_uidt_nl
+          << "{" << be_idt_nl;
+
+      if (pod)
+        {
+          *os << "return TAO::marshal_pod_sequence(strm, _tao_sequence, "
+              << pod_size << "u, " << pod_align << "u);";
+        }
+      else
+        {
+          *os << "return TAO::marshal_sequence(strm, _tao_sequence);";
+        }
+
+      *os << be_uidt_nl
           << "}" << be_nl_2;
         }
 
@@ -186,9 +205,19 @@ be_visitor_sequence_cdr_op_cs::visit_sequence (be_sequence *node)
           << " &_tao_sequence)"
           << be_uidt
           << be_uidt_nl
-          << "{" << be_idt_nl
-          << "return TAO::demarshal_sequence(strm, _tao_sequence);"
-          << be_uidt_nl
+          << "{" << be_idt_nl;
+
+      if (pod)
+        {
+          *os << "return TAO::demarshal_pod_sequence(strm, _tao_sequence, "
+              << pod_size << "u, " << pod_align << "u);";
+        }
+      else
+        {
+          *os << "return TAO::demarshal_sequence(strm, _tao_sequence);";
+        }
+
+      *os << be_uidt_nl
           << "}" << be_nl;
     }
 
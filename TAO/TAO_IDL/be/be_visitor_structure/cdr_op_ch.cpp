@@ -52,6 +52,13 @@ be_visitor_structure_cdr_op_ch::visit_structure (be_structure *node)
       << " operator>> (TAO_InputCDR &, "
       << node->name () << " &);" << be_nl;
 
+  if (be_global->gen_size_cdr () && be_util::has_size_cdr_op (node))
+    {
+      *os << be_global->stub_export_macro () << " ::CORBA::Boolean"
+          << " operator<< (ACE_SizeCDR &, const " << node->name ()
+          << " &);" << be_nl;
+    }
+
   if (be_global->gen_ostream_operators ())
     {
       *os << be_global->stub_export_macro () << " std::ostream&"
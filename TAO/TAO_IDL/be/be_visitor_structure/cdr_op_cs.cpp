@@ -50,44 +50,25 @@ be_visitor_structure_cdr_op_cs::visit_structure (be_structure *node)
 
   *os << be_global->core_versioning_begin () << be_nl;
 
-  //  Set the sub state as generating code for the output operator.
-  this->ctx_->sub_state (TAO_CodeGen::TAO_CDR_OUTPUT);
-
-  *os << "::CORBA::Boolean operator<< (" << be_idt << be_idt_nl
-      << "TAO_OutputCDR &strm," << be_nl
-      << "const " << node->name () << " &_tao_aggregate)" << be_uidt
-      << be_uidt_nl
-      << "{" << be_idt_nl;
-
-  be_visitor_context new_ctx (*this->ctx_);
-  be_visitor_cdr_op_field_decl field_decl (&new_ctx);
-
-  if (field_decl.visit_scope (node) == -1)
+  if (this->gen_output_operator (node, "TAO_OutputCDR") == -1)
     {
-      ACE_ERROR_RETURN ((LM_ERROR,
-                         ACE_TEXT ("be_visitor_structure_cdr_op_cs::")
-                         ACE_TEXT ("visit_structure - ")
-                         ACE_TEXT ("codegen for field decl failed\n")),
-                        -1);
+      return -1;
     }
 
-  *os << "return" << be_idt_nl;
-
-  if (this->visit_scope (node) == -1)
+  // The fields are sized just like they are marshaled.
+  if (be_global->gen_size_cdr ()
+      && be_util::has_size_cdr_op (node)
+      && this->gen_output_operator (node, "ACE_SizeCDR") == -1)
     {
-      ACE_ERROR_RETURN ((LM_ERROR,
-                         ACE_TEXT ("be_visitor_structure_cdr_op_cs::")
-                         ACE_TEXT ("visit_structure - ")
-                         ACE_TEXT ("codegen for scope failed\n")),
-                        -1);
+      return -1;
     }
 
-  *os << ";" << be_uidt << be_uidt_nl
-      << "}" << be_nl_2;
-
   // Set the substate as generating code for the input operator.
   this->ctx_->sub_state (TAO_CodeGen::TAO_CDR_INPUT);
 
+  be_visitor_context new_ctx (*this->ctx_);
+  be_visitor_cdr_op_field_decl field_decl (&new_ctx);
+
   *os << "::CORBA::Boolean operator>> (" << be_idt << be_idt_nl
       << "TAO_InputCDR &";
 
@@ -153,6 +134,50 @@ be_visitor_structure_cdr_op_cs::visit_structure (be_structure *node)
   return 0;
 }
 
+int
+be_visitor_structure_cdr_op_cs::gen_output_operator (be_structure *node,
+                                                     const char *stream)
+{
+  TAO_OutStream *os = this->ctx_->stream ();
+
+  //  Set the sub state as generating code for the output operator.
+  this->ctx_->sub_state (TAO_CodeGen::TAO_CDR_OUTPUT);
+
+  *os << "::CORBA::Boolean operator<< (" << be_idt << be_idt_nl
+      << stream << " &strm," << be_nl
+      << "const " << node->name () << " &_tao_aggregate)" << be_uidt
+      << be_uidt_nl
+      << "{" << be_idt_nl;
+
+  be_visitor_context new_ctx (*this->ctx_);
+  be_visitor_cdr_op_field_decl field_decl (&new_ctx);
+
+  if (field_decl.visit_scope (node) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("be_visitor_structure_cdr_op_cs::")
+                         ACE_TEXT ("gen_output_operator - ")
+                         ACE_TEXT ("codegen for field decl failed\n")),
+                        -1);
+    }
+
+  *os << "return" << be_idt_nl;
+
+  if (this->visit_scope (node) == -1)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("be_visitor_structure_cdr_op_cs::")
+                         ACE_TEXT ("gen_output_operator - ")
+                         ACE_TEXT ("codegen for scope failed\n")),
+                        -1);
+    }
+
+  *os << ";" << be_uidt << be_uidt_nl
+      << "}" << be_nl_2;
+
+  return 0;
+}
+
 int
 be_visitor_structure_cdr_op_cs::post_process (be_decl *bd)
 {
@@ -586,6 +586,12 @@ public:
   /// Set the gen_ostream_operators_ member.
   void gen_ostream_operators (bool val);
 
+  /// Get the gen_size_cdr_ member.
+  bool gen_size_cdr (void) const;
+
+  /// Set the gen_size_cdr_ member.
+  void gen_size_cdr (bool val);
+
   /// Get the gen_static_desc_operations_ member.
   bool gen_static_desc_operations (void) const;
 
@@ -1259,6 +1265,10 @@ private:
   /// debugging or logging.
   bool gen_ostream_operators_;
 
+  /// Generate ACE_SizeCDR insertion operators, and a size pass in
+  /// the stubs so the arguments are marshaled into one buffer.
+  bool gen_size_cdr_;
+
   /// Generate static description operations for each interface
   bool gen_static_desc_operations_;
 
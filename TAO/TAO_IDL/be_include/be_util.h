@@ -16,10 +16,13 @@
 
 #include "TAO_IDL_BE_Export.h"
 
+#include "ace/CDR_Base.h"
+
 class TAO_OutStream;
 class be_module;
 class be_type;
 class AST_Decl;
+class AST_Type;
 class AST_Generator;
 
 class be_util
@@ -71,6 +74,17 @@ public:
 
   // Called by each node upon construction.
   static void set_arg_seen_bit (be_type *);
+
+  /// Is there an ACE_SizeCDR insertion operator for @a type, either
+  /// generated by -Gsz or from ACE and TAO?
+  static bool has_size_cdr_op (AST_Type *type);
+
+  /// Is the CDR encoding of @a type its C++ layout, without any
+  /// padding, wherever it starts on its alignment?  If so @a size and
+  /// @a align are set to its CDR size and alignment.
+  static bool cdr_pod_layout (AST_Type *type,
+                              ACE_CDR::ULong &size,
+                              ACE_CDR::ULong &align);
 };
 
 #endif // if !defined
@@ -79,6 +79,13 @@ public:
                               TAO_OutStream *os,
                               bool ami = false);
 
+  /// With -Gsz, size the in and inout arguments of @a node with an
+  /// ACE_SizeCDR and pass it as marshal size hint to the invocation
+  /// adapter.  Only done if one of them is of variable size and all
+  /// of them have an ACE_SizeCDR operator.
+  void gen_stub_size_pass (be_operation *node,
+                           TAO_OutStream *os);
+
   void gen_arg_template_param_name (AST_Decl *scope,
                                     AST_Type *bt,
                                     TAO_OutStream *os);
@@ -39,6 +39,11 @@ public:
 
   /// any post processing that needs to be done after a scope element is handled
   virtual int post_process (be_decl *);
+
+private:
+  /// Generate the insertion operator for the output stream class
+  /// @a stream.
+  int gen_output_operator (be_structure *node, const char *stream);
 };
 
 #endif /* _BE_VISITOR_STRUCTURE_CDR_OP_CS_H_ */
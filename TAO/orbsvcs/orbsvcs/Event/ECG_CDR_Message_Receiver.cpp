@@ -5,6 +5,7 @@
 #include "tao/Exception.h"
 
 #include "ace/SOCK_Dgram.h"
+#include "ace/Dgram_Batch.h"
 #include "ace/ACE.h"
 #include "ace/OS_NS_string.h"
 
@@ -266,6 +267,70 @@ TAO_ECG_CDR_Message_Receiver::handle_input (
                         -1);
     }
 
+  return this->process_datagram (from, header_buf, data_buf, n, cdr_processor);
+}
+
+ssize_t
+TAO_ECG_CDR_Message_Receiver::recv_input (ACE_SOCK_Dgram& dgram)
+{
+  // Each datagram is read into a single buffer, its data following
+  // the header, which keeps the data aligned.
+  size_t const header_size = TAO_ECG_CDR_Message_Sender::ECG_HEADER_SIZE;
+  size_t const buffer_size = header_size + ACE_MAX_DGRAM_SIZE;
+
+  if (this->batch_ == 0)
+    {
+      ACE_NEW_RETURN (this->batch_,
+                      ACE_Dgram_Batch (ACE_DEFAULT_DGRAM_BATCH_SIZE,
+                                       buffer_size + ACE_CDR::MAX_ALIGNMENT),
+                      -1);
+
+      for (size_t i = 0; i < this->batch_->capacity (); ++i)
+        this->batch_->buffer (i,
+                              ACE_ptr_align_binary (this->batch_->data (i),
+                                                    ACE_CDR::MAX_ALIGNMENT),
+                              buffer_size);
+    }
+
+  ssize_t const n = dgram.recv (*this->batch_);
+
+  if (n == -1)
+    {
+      if (errno == EWOULDBLOCK)
+        return 0;
+
+      ORBSVCS_ERROR_RETURN ((LM_ERROR, "Error reading mcast fragments (%m).\n"),
+                        -1);
+    }
+
+  return n;
+}
+
+int
+TAO_ECG_CDR_Message_Receiver::process_input (
+                                 size_t i,
+                                 TAO_ECG_CDR_Processor *cdr_processor)
+{
+  ACE_INET_Addr from;
+  this->batch_->addr (i, from);
+
+  char *header_buf = this->batch_->data (i);
+  return this->process_datagram (from,
+                                 header_buf,
+                                 header_buf
+                                 + TAO_ECG_CDR_Message_Sender::ECG_HEADER_SIZE,
+                                 this->batch_->length (i),
+                                 cdr_processor);
+}
+
+int
+TAO_ECG_CDR_Message_Receiver::process_datagram (
+                                 const ACE_INET_Addr &from,
+                                 char *header_buf,
+                                 char *data_buf,
+                                 size_t n,
+                                 TAO_ECG_CDR_Processor *cdr_processor)
+{
   if (n == 0)
     {
       ORBSVCS_ERROR_RETURN ((LM_ERROR, "Trying to read mcast fragment: "
@@ -284,8 +349,11 @@ TAO_ECG_CDR_Message_Receiver::handle_input (
 
   if (this->check_crc_)
     {
-      iov[1].iov_len = n - iov[0].iov_len;
-      iov[0].iov_len -= 4;  // don't include crc
+      iovec iov[2];
+      iov[0].iov_base = header_buf;
+      iov[0].iov_len  = TAO_ECG_CDR_Message_Sender::ECG_HEADER_SIZE - 4;  // don't include crc
+      iov[1].iov_base = data_buf;
+      iov[1].iov_len  = n - TAO_ECG_CDR_Message_Sender::ECG_HEADER_SIZE;
 
       crc = ACE::crc32 (iov, 2);
     }
@@ -518,6 +586,9 @@ TAO_ECG_CDR_Message_Receiver::shutdown (void)
     }
 
   this->ignore_from_.reset ();
+
+  delete this->batch_;
+  this->batch_ = 0;
 }
 
 // ****************************************************************
@@ -23,6 +23,10 @@
 #include "ace/INET_Addr.h"
 #include "ace/Null_Mutex.h"
 
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Dgram_Batch;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 /**
@@ -171,6 +175,20 @@ public:
   int handle_input (ACE_SOCK_Dgram& dgram,
                     TAO_ECG_CDR_Processor *cdr_processor);
 
+  /// Read the datagrams queued in @a dgram, as many as fit in one
+  /// batch, with a single system call.
+  /**
+   * Returns the number of datagrams read, 0 if there were none and
+   * -1 if there were errors.  Each of them must then be passed to
+   * process_input().
+   */
+  ssize_t recv_input (ACE_SOCK_Dgram& dgram);
+
+  /// Process datagram @a i of the last recv_input() as handle_input()
+  /// does, with the same return values.
+  int process_input (size_t i,
+                     TAO_ECG_CDR_Processor *cdr_processor);
+
   /// Represents any request that has been fully received and
   /// serviced, to simplify the internal logic.
   static TAO_ECG_UDP_Request_Entry Request_Completed_;
@@ -191,6 +209,15 @@ private:
 
 private:
 
+  /// Validate the @a n bytes of a datagram received from @a from, whose
+  /// header is at @a header_buf and data at @a data_buf, and process it
+  /// as handle_input() does.
+  int process_datagram (const ACE_INET_Addr &from,
+                        char *header_buf,
+                        char *data_buf,
+                        size_t n,
+                        TAO_ECG_CDR_Processor *cdr_processor);
+
   /// Returns 1 on success, 0 if <request_id> has already been
   /// received or is below current request range, and -1 on error.
   int mark_received (const ACE_INET_Addr &from,
@@ -230,6 +257,9 @@ private:
 
   /// Flag to indicate whether CRC should be computed and checked.
   CORBA::Boolean check_crc_;
+
+  /// The datagrams read by recv_input(), allocated on its first use.
+  ACE_Dgram_Batch *batch_;
 };
 
 // ****************************************************************
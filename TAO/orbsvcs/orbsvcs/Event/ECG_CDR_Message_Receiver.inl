@@ -21,6 +21,7 @@ TAO_ECG_CDR_Message_Receiver::TAO_ECG_CDR_Message_Receiver (CORBA::Boolean crc)
   , max_requests_ (ECG_DEFAULT_MAX_FRAGMENTED_REQUESTS)
   , min_purge_count_ (ECG_DEFAULT_FRAGMENTED_REQUESTS_MIN_PURGE_COUNT)
   , check_crc_ (crc)
+  , batch_ (0)
 {
 //    ACE_NEW (this->lock_,
 //             ACE_Lock_Adapter<ACE_Null_Mutex>);
@@ -191,32 +191,58 @@ TAO_ECG_UDP_Receiver::handle_input (ACE_SOCK_Dgram& dgram)
 
           return 0;
         }
-
-      // Receive data.
-      TAO_ECG_Event_CDR_Decoder cdr_decoder;
-      int const result = this->cdr_receiver_.handle_input (dgram, &cdr_decoder);
-
-      if (result == 0)
-        // No data to act on.
-        {
-          return 0;
-        }
-      if (result == -1)
-        {
-          ORBSVCS_ERROR_RETURN ((LM_ERROR,
-                            "Error receiving multicasted events.\n"),
-                            0);
-        }
-
-      this->consumer_proxy_->push (cdr_decoder.events);
     }
-
   catch (const CORBA::Exception& ex)
     {
       ORBSVCS_ERROR ((LM_ERROR,
                   "Caught and swallowed EXCEPTION in "
                   "ECG_UDP_Receiver::handle_input: %C\n",
                   ex._info ().c_str ()));
+      return 0;
+    }
+
+  // Receive all the data queued in the socket, and push every event
+  // set completed by it.
+  ssize_t const count = this->cdr_receiver_.recv_input (dgram);
+  if (count == -1)
+    {
+      ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                        "Error receiving multicasted events.\n"),
+                        0);
+    }
+
+  // A push may shut the Receiver down, which discards the rest.
+  for (ssize_t i = 0;
+       i < count && !CORBA::is_nil (this->consumer_proxy_.in ());
+       ++i)
+    {
+      try
+        {
+          TAO_ECG_Event_CDR_Decoder cdr_decoder;
+          int const result =
+            this->cdr_receiver_.process_input (i, &cdr_decoder);
+
+          if (result == 0)
+            // No data to act on.
+            {
+              continue;
+            }
+          if (result == -1)
+            {
+              ORBSVCS_ERROR ((LM_ERROR,
+                          "Error receiving multicasted events.\n"));
+              continue;
+            }
+
+          this->consumer_proxy_->push (cdr_decoder.events);
+        }
+      catch (const CORBA::Exception& ex)
+        {
+          ORBSVCS_ERROR ((LM_ERROR,
+                      "Caught and swallowed EXCEPTION in "
+                      "ECG_UDP_Receiver::handle_input: %C\n",
+                      ex._info ().c_str ()));
+        }
     }
   return 0;
 }
@@ -219,6 +219,18 @@ TAO_UIPMC_Mcast_Connection_Handler::open (void *)
                 this->local_addr_.get_port_number ()
               ));
 
+  // Let the kernel pass up the fragments of a sender together.
+  if (factory->enable_segmentation_offload ()
+      && -1 == this->peer ().enable_gro ()
+      && TAO_debug_level)
+    ORBSVCS_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Connection_Handler::")
+                ACE_TEXT ("open, fragments aren't coalesced ")
+                ACE_TEXT ("for multicast %C:%u (Errno: '%m')\n"),
+                target_multicast_group,
+                this->local_addr_.get_port_number ()
+              ));
+
   // The socket also has to be set in non-blocking mode in order to work with
   // TAO_UIPMC_Mcast_Transport::handle_input().
   if (this->peer ().enable (ACE_NONBLOCK) == -1)
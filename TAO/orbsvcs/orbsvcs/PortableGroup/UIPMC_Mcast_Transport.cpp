@@ -12,6 +12,10 @@
 #include "tao/GIOP_Message_Base.h"
 #include "tao/Resume_Handle.h"
 
+#include "ace/Dgram_Batch.h"
+#include "ace/Min_Max.h"
+#include "ace/OS_NS_string.h"
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 TAO_UIPMC_Mcast_Transport::TAO_UIPMC_Mcast_Transport (
@@ -21,6 +25,7 @@ TAO_UIPMC_Mcast_Transport::TAO_UIPMC_Mcast_Transport (
   : TAO_Transport (IOP::TAG_UIPMC,
                    orb_core)
   , connection_handler_ (handler)
+  , recv_batch_ (0)
 {
   // Replace the default wait strategy with our own
   // since we don't support waiting on anything.
@@ -45,6 +50,8 @@ TAO_UIPMC_Mcast_Transport::~TAO_UIPMC_Mcast_Transport (void)
           delete packet;
         }
     }
+
+  delete this->recv_batch_;
 }
 
 void
@@ -146,25 +153,14 @@ int TAO_UIPMC_Mcast_Transport::send_message (
 }
 
 char *
-TAO_UIPMC_Mcast_Transport::recv_packet (
+TAO_UIPMC_Mcast_Transport::parse_packet (
   char *buf,
-  size_t len,
-  ACE_INET_Addr &from_addr,
+  size_t n,
   CORBA::UShort &packet_length,
   CORBA::ULong &packet_number,
   bool &stop_packet,
   u_long &id_hash) const
 {
-  // We read the whole MIOP packet which is not longer than MIOP_MAX_DGRAM_SIZE.
-  ssize_t const n =
-    this->connection_handler_->peer ().recv (buf,
-                                             len,
-                                             from_addr);
-
-  // There is nothing left in the socket buffer.
-  if (n <= 0)
-    return 0;
-
   // Make sure that we at least have a MIOP header.
   if (static_cast<size_t> (n) < MIOP_MIN_HEADER_SIZE)
     {
@@ -172,7 +168,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet of size %d is ")
+                      ACE_TEXT ("parse_packet, packet of size %B is ")
                       ACE_TEXT ("too small\n"),
                       this->id (),
                       n));
@@ -197,7 +193,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet didn't contain ")
+                      ACE_TEXT ("parse_packet, packet didn't contain ")
                       ACE_TEXT ("magic bytes\n"),
                       this->id ()));
         }
@@ -215,7 +211,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet has wrong version ")
+                      ACE_TEXT ("parse_packet, packet has wrong version ")
                       ACE_TEXT ("%d.%d\n"),
                       this->id (),
                       (miop_version >> 4) & 0xf,
@@ -255,14 +251,14 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, malformed packet\n"),
+                      ACE_TEXT ("parse_packet, malformed packet\n"),
                       this->id ()));
         }
 
       return 0;
     }
 
-  ssize_t const miop_header_size =
+  size_t const miop_header_size =
     (MIOP_ID_CONTENT_OFFSET + id_length + 7) & ~0x7;
   if (miop_header_size > n)
     {
@@ -270,7 +266,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet not large enough ")
+                      ACE_TEXT ("parse_packet, packet not large enough ")
                       ACE_TEXT ("for padding\n"),
                       this->id ()));
         }
@@ -310,137 +306,194 @@ TAO_UIPMC_Mcast_Transport::recv_all (TAO_Resume_Handle &rh)
   // FUZZ: enable check_for_ACE_Guard
   if (recv_guard.locked ())
     {
-      // The buffer on the stack which will be used to hold the input
-      // messages.
-      char buf [MIOP_MAX_DGRAM_SIZE + ACE_CDR::MAX_ALIGNMENT];
-      char *aligned_buf = ACE_ptr_align_binary (buf, ACE_CDR::MAX_ALIGNMENT);
-
+      // The batch which will be used to hold the input messages,
+      // allocated on the first input.
+      if (this->recv_batch_ == 0)
+        {
+          ACE_NEW_THROW_EX (this->recv_batch_,
+                            ACE_Dgram_Batch (TAO_DEFAULT_MIOP_RECV_BATCH_SIZE,
+                                             MIOP_MAX_DGRAM_SIZE
+                                             + ACE_CDR::MAX_ALIGNMENT),
+                            CORBA::NO_MEMORY (
+                              CORBA::SystemException::_tao_minor_code (
+                                TAO::VMCID,
+                                ENOMEM),
+                              CORBA::COMPLETED_NO));
+
+          for (size_t i = 0; i < this->recv_batch_->capacity (); ++i)
+            {
+              char *aligned_buf =
+                ACE_ptr_align_binary (this->recv_batch_->data (i),
+                                      ACE_CDR::MAX_ALIGNMENT);
 #if defined (ACE_INITIALIZE_MEMORY_BEFORE_USE)
-      (void) ACE_OS::memset (buf, '\0', sizeof buf);
+              (void) ACE_OS::memset (aligned_buf, '\0', MIOP_MAX_DGRAM_SIZE);
 #endif /* ACE_INITIALIZE_MEMORY_BEFORE_USE */
+              this->recv_batch_->buffer (i, aligned_buf, MIOP_MAX_DGRAM_SIZE);
+            }
+        }
 
-      while (true)
-        {
-          // This guard will cleanup expired packets each iteration.
-          TAO_PG::UIPMC_Recv_Packet_Cleanup_Guard guard (this);
-
-          ACE_INET_Addr from_addr;
-          CORBA::UShort packet_length;
-          CORBA::ULong packet_number = 0;
-          bool stop_packet = false;
-          u_long id_hash;
+      ACE_Dgram_Batch &batch = *this->recv_batch_;
+      bool done = false;
 
-          char *start_data =
-            this->recv_packet (aligned_buf, MIOP_MAX_DGRAM_SIZE, from_addr,
-                               packet_length, packet_number, stop_packet, id_hash);
+      while (!done)
+        {
+          // We read whole MIOP packets which are not longer than
+          // MIOP_MAX_DGRAM_SIZE, as many as are queued in the socket.
+          ssize_t const count = this->connection_handler_->peer ().recv (batch);
 
           // The socket buffer is empty. Try to do other useful things.
-          if (start_data == 0)
+          if (count <= 0)
             {
-              if (errno != EWOULDBLOCK && errno != EAGAIN)
+              if (count == -1 && errno != EWOULDBLOCK && errno != EAGAIN)
                 {
                   ORBSVCS_DEBUG ((LM_DEBUG,
                               ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                              ACE_TEXT ("recv_all, unexpected failure of recv_packet (Errno: '%m')\n"),
+                              ACE_TEXT ("recv_all, unexpected failure of recv (Errno: '%m')\n"),
                               this->id ()));
                 }
               break;
             }
 
-          if (TAO_debug_level >= 9)
-            {
-              char tmp[INET6_ADDRSTRLEN];
-              from_addr.get_host_addr (tmp, sizeof tmp);
-              ORBSVCS_DEBUG ((LM_DEBUG,
-                          ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                          ACE_TEXT ("recv, received %d bytes from <%C:%u> ")
-                          ACE_TEXT ("(hash %d)\n"),
-                          this->id (),
-                          packet_length,
-                          tmp,
-                          from_addr.get_port_number (),
-                          id_hash));
-            }
-
-          TAO_PG::UIPMC_Recv_Packet *packet = 0;
-          if (this->incomplete_.find (id_hash, packet) == -1)
+          for (size_t i = 0; i < static_cast<size_t> (count); ++i)
             {
-              ACE_NEW_THROW_EX (packet,
-                                TAO_PG::UIPMC_Recv_Packet,
-                                CORBA::NO_MEMORY (
-                                  CORBA::SystemException::_tao_minor_code (
-                                    TAO::VMCID,
-                                    ENOMEM),
-                                  CORBA::COMPLETED_NO));
-
-              if (this->incomplete_.bind (id_hash, packet) != 0)
+              // Split up the fragments the kernel coalesced.
+              size_t const length = batch.length (i);
+              size_t const segment_size = batch.segment_size (i);
+              for (size_t offset = 0u; offset < length; offset += segment_size)
                 {
-                  // Cleanup the packet.
-                  delete packet;
-                  ORBSVCS_DEBUG ((LM_DEBUG,
-                              ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                              ACE_TEXT ("recv_all, could not queue fragment\n"),
-                              this->id ()));
-                  continue;
-                }
-            }
-
-          // We have incomplete packet so add the new data to it.
-          // add_fragment returns 1 iff the packet is complete.
-          if (1 == packet->add_fragment (start_data, packet_length,
-                                         packet_number, stop_packet))
-            {
-              // Remove this packet from incomplete packets.
-              this->incomplete_.unbind (id_hash);
+                  // This guard will cleanup expired packets each iteration.
+                  TAO_PG::UIPMC_Recv_Packet_Cleanup_Guard guard (this);
+
+                  CORBA::UShort packet_length;
+                  CORBA::ULong packet_number = 0;
+                  bool stop_packet = false;
+                  u_long id_hash;
+
+                  // The MIOP header must be aligned; move the fragment
+                  // back over the one before, which has been copied.
+                  size_t const misalignment = offset % ACE_CDR::MAX_ALIGNMENT;
+                  char *fragment = batch.data (i) + offset - misalignment;
+                  size_t const fragment_size = ACE_MIN (segment_size,
+                                                        length - offset);
+                  if (misalignment != 0u)
+                    ACE_OS::memmove (fragment,
+                                     fragment + misalignment,
+                                     fragment_size);
+
+                  char *start_data =
+                    this->parse_packet (fragment, fragment_size,
+                                        packet_length, packet_number, stop_packet,
+                                        id_hash);
+
+                  // Drop a malformed packet.
+                  if (start_data == 0)
+                    continue;
 
-              // If there are no completed message ahead of us AND
-              // we only want a single message, just return it.
-              if (this->complete_.is_empty () && !eager_dequeue)
-                {
                   if (TAO_debug_level >= 9)
                     {
+                      ACE_INET_Addr from_addr;
+                      batch.addr (i, from_addr);
+                      char tmp[INET6_ADDRSTRLEN];
+                      from_addr.get_host_addr (tmp, sizeof tmp);
                       ORBSVCS_DEBUG ((LM_DEBUG,
                                   ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                                  ACE_TEXT ("recv_all, completed MIOP message %@\n"),
-                                  this->id (), static_cast<void *> (packet)));
+                                  ACE_TEXT ("recv, received %d bytes from <%C:%u> ")
+                                  ACE_TEXT ("(hash %d)\n"),
+                                  this->id (),
+                                  packet_length,
+                                  tmp,
+                                  from_addr.get_port_number (),
+                                  id_hash));
                     }
 
-                  return packet;
-                }
-              ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
-                                guard,
-                                this->complete_lock_,
-                                packet);
-              if (this->complete_.is_empty () && !eager_dequeue)
-                {
-                  // Another thread dequeued the waiting MIOP message before we got
-                  // the lock, simply return our single message, don't bother queueing
-                  // it after all.
-                  if (TAO_debug_level >= 9)
+                  TAO_PG::UIPMC_Recv_Packet *packet = 0;
+                  if (this->incomplete_.find (id_hash, packet) == -1)
                     {
-                      ORBSVCS_DEBUG ((LM_DEBUG,
-                                  ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                                  ACE_TEXT ("recv_all, completed MIOP message %@\n"),
-                                  this->id (), static_cast<void *> (packet)));
+                      ACE_NEW_THROW_EX (packet,
+                                        TAO_PG::UIPMC_Recv_Packet,
+                                        CORBA::NO_MEMORY (
+                                          CORBA::SystemException::_tao_minor_code (
+                                            TAO::VMCID,
+                                            ENOMEM),
+                                          CORBA::COMPLETED_NO));
+
+                      if (this->incomplete_.bind (id_hash, packet) != 0)
+                        {
+                          // Cleanup the packet.
+                          delete packet;
+                          ORBSVCS_DEBUG ((LM_DEBUG,
+                                      ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
+                                      ACE_TEXT ("recv_all, could not queue fragment\n"),
+                                      this->id ()));
+                          continue;
+                        }
                     }
 
-                  return packet;
-                }
+                  // We have incomplete packet so add the new data to it.
+                  // add_fragment returns 1 iff the packet is complete.
+                  if (1 != packet->add_fragment (start_data, packet_length,
+                                                 packet_number, stop_packet))
+                    continue;
+
+                  // Remove this packet from incomplete packets.
+                  this->incomplete_.unbind (id_hash);
+
+                  // Stop attempting to queue more messages if we are not
+                  // in eager mode, once the rest of the batch is handled.
+                  if (!eager_dequeue)
+                    done = true;
+
+                  // If there are no completed message ahead of us AND
+                  // we only want a single message AND nothing else is
+                  // left in the batch, just return it.
+                  bool const last = i + 1 == static_cast<size_t> (count)
+                    && offset + segment_size >= length;
+                  if (last && this->complete_.is_empty () && !eager_dequeue)
+                    {
+                      if (TAO_debug_level >= 9)
+                        {
+                          ORBSVCS_DEBUG ((LM_DEBUG,
+                                      ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
+                                      ACE_TEXT ("recv_all, completed MIOP message %@\n"),
+                                      this->id (), static_cast<void *> (packet)));
+                        }
+
+                      return packet;
+                    }
 
-              if (TAO_debug_level >= 9)
-                {
-                  ORBSVCS_DEBUG ((LM_DEBUG,
-                              ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                              ACE_TEXT ("recv_all, completed MIOP message %@ (QUEUED)\n"),
-                              this->id (), static_cast<void *> (packet)));
+                  {
+                    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
+                                      complete_guard,
+                                      this->complete_lock_,
+                                      packet);
+                    if (last && this->complete_.is_empty () && !eager_dequeue)
+                      {
+                        // Another thread dequeued the waiting MIOP message before we got
+                        // the lock, simply return our single message, don't bother queueing
+                        // it after all.
+                        if (TAO_debug_level >= 9)
+                          {
+                            ORBSVCS_DEBUG ((LM_DEBUG,
+                                        ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
+                                        ACE_TEXT ("recv_all, completed MIOP message %@\n"),
+                                        this->id (), static_cast<void *> (packet)));
+                          }
+
+                        return packet;
+                      }
+
+                    if (TAO_debug_level >= 9)
+                      {
+                        ORBSVCS_DEBUG ((LM_DEBUG,
+                                    ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
+                                    ACE_TEXT ("recv_all, completed MIOP message %@ (QUEUED)\n"),
+                                    this->id (), static_cast<void *> (packet)));
+                      }
+
+                    // Add it to the complete queue.
+                    this->complete_.enqueue_tail (packet);
+                  }
                 }
-
-              // Add it to the complete queue.
-              this->complete_.enqueue_tail (packet);
-
-              // Stop attempting to queue more messages if we are not in eager mode.
-              if (!eager_dequeue)
-                break;
             }
         }
       recv_guard.release ();
@@ -24,6 +24,10 @@
 #include "ace/Svc_Handler.h"
 #include "ace/Refcountable_T.h"
 
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Dgram_Batch;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // Forward decls.
@@ -105,15 +109,14 @@ public:
   //@}
 
 private:
-  /// Receive a UDP message and extract all necessary info from the MIOP
-  /// header. If everything is fine return a pointer to the first byte of
-  /// the non-MIOP data.
-  char *recv_packet (char *buf, size_t len,
-                     ACE_INET_Addr &from_addr,
-                     CORBA::UShort &packet_length,
-                     CORBA::ULong &packet_number,
-                     bool &stop_packet,
-                     u_long &id_hash) const;
+  /// Extract all necessary info from the MIOP header of the @a n bytes
+  /// of a received UDP message at @a buf. If everything is fine return
+  /// a pointer to the first byte of the non-MIOP data.
+  char *parse_packet (char *buf, size_t n,
+                      CORBA::UShort &packet_length,
+                      CORBA::ULong &packet_number,
+                      bool &stop_packet,
+                      u_long &id_hash) const;
 
   /// Return the next complete MIOP packet, possiably dequeueing
   /// as many as are available first from the socket.
@@ -134,6 +137,10 @@ private:
   /// A lock for ensuring that only one thread is doing recv.
   TAO_SYNCH_MUTEX recv_lock_;
 
+  /// The UDP messages received with one recv, allocated on the first
+  /// input and protected by recv_lock_.
+  ACE_Dgram_Batch *recv_batch_;
+
   /// Complete packets.
   typedef ACE_Unbounded_Queue<TAO_PG::UIPMC_Recv_Packet *> Packets_Queue;
   Packets_Queue complete_;
@@ -11,6 +11,7 @@
 #include "tao/GIOP_Message_Base.h"
 
 #include "ace/UUID.h"
+#include "ace/OS_NS_string.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -280,114 +281,190 @@ TAO_UIPMC_Transport::send (
       return -1;
     }
 
+  // With segmentation offload the kernel splits a run of fragments into
+  // datagrams of max_fragment_size, so all but the last fragment of the
+  // message are full.  Up to one maximum sized datagram is handed over
+  // at a time.
+  u_long fragments_per_send = 1u;
+#if defined (ACE_HAS_UDP_SEGMENT)
+  if (factory->enable_segmentation_offload ())
+    {
+      fragments_per_send = MIOP_MAX_DGRAM_SIZE / max_fragment_size;
+      if (fragments_per_send > MIOP_MAX_FRAGMENTS_PER_SEND)
+        fragments_per_send = MIOP_MAX_FRAGMENTS_PER_SEND;
+      else if (fragments_per_send == 0u)
+        fragments_per_send = 1u;
+    }
+#endif /* ACE_HAS_UDP_SEGMENT */
+
+  // Each fragment sent gets a copy of the MIOP header with its own
+  // packet number.
+  char fragment_headers[MIOP_MAX_FRAGMENTS_PER_SEND][MIOP_DEFAULT_HEADER_SIZE];
+
   // Attempt to partition up the payload data sending each of the MIOP fragments
-  iovec this_fragment_iov[ACE_IOV_MAX];
+  iovec this_send_iov[ACE_IOV_MAX];
   UIPMC_Message_Block_Data_Iterator mb_iter (iov, iovcnt);
   ACE_INET_Addr const &addr = this->connection_handler_->addr ();
   for (*packet_number= 0u;
        *packet_number < number_of_packets_required;
-       ++*packet_number)
+       )
     {
-      // The first iov for each packet points at the static MIOP header.
-      this_fragment_iov[0].iov_base = miop_hdr.current ()->rd_ptr ();
-      this_fragment_iov[0].iov_len  = MIOP_DEFAULT_HEADER_SIZE;
-      int this_fragment_iovcnt = 1;   // Just the MIOP Header so far!
-      u_long this_fragment_size= 0uL; // Just the payload data length (for now)
-
-      // Obtain the next fragment's payload data.
-      while (mb_iter.next_block (max_fragment_payload - this_fragment_size,
-                                 this_fragment_iov[this_fragment_iovcnt]))
+      CORBA::ULong const first_packet_number = *packet_number;
+      int this_send_iovcnt = 0;
+      u_long this_send_payload = 0uL; // Payload data length of all the fragments
+
+      for (u_long fragment = 0u;
+           fragment < fragments_per_send &&
+             *packet_number < number_of_packets_required;
+           ++fragment, ++*packet_number)
         {
-          // Increment the fragments length and iovcnt.
-          this_fragment_size +=
-            this_fragment_iov[this_fragment_iovcnt++].iov_len;
-
-          // Check if we have maxed out this fragment's payload.
-          if (this_fragment_size == max_fragment_payload)
+          // Leave the iovecs of a long run of fragments to the next send.
+          if (fragment && this_send_iovcnt > ACE_IOV_MAX / 2)
             break;
 
-          // Just a safety check for building iovec.
-          if (this_fragment_iovcnt >= ACE_IOV_MAX)
+          // The first iov for each fragment points at its MIOP header.
+          int const header_iov = this_send_iovcnt++;
+          u_long this_fragment_size= 0uL; // Just the payload data length
+
+          // Obtain the next fragment's payload data.
+          while (mb_iter.next_block (max_fragment_payload - this_fragment_size,
+                                     this_send_iov[this_send_iovcnt]))
             {
-              ORBSVCS_DEBUG ((LM_ERROR,
-                          ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
-                          ACE_TEXT ("Too many iovec to create fragment.\n"),
-                          this->id ()));
-              return -1;
-            }
-        } // While fragment is not complete
-
-      // Now we have the payload length for this fragment, update the MIOP header
-      *packet_length = static_cast<CORBA::UShort> (this_fragment_size);
-      if (*packet_number == number_of_packets_required-1uL)
-        *flags_field |= 0x02;
-
-      ssize_t already_sent = 0; // No data sent yet!
-      iovec *current_iov= this_fragment_iov;
-      for (this_fragment_size+= MIOP_DEFAULT_HEADER_SIZE; // Now includes MIOP header
-           this_fragment_size; // Still any data to send
-           this_fragment_size-= static_cast<u_long> (already_sent))
+              // Increment the fragments length and iovcnt.
+              this_fragment_size +=
+                this_send_iov[this_send_iovcnt++].iov_len;
+
+              // Check if we have maxed out this fragment's payload.
+              if (this_fragment_size == max_fragment_payload)
+                break;
+
+              // Just a safety check for building iovec.
+              if (this_send_iovcnt >= ACE_IOV_MAX)
+                {
+                  ORBSVCS_DEBUG ((LM_ERROR,
+                              ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
+                              ACE_TEXT ("Too many iovec to create fragment.\n"),
+                              this->id ()));
+                  return -1;
+                }
+            } // While fragment is not complete
+
+          // Now we have the payload length for this fragment, update the MIOP header
+          *packet_length = static_cast<CORBA::UShort> (this_fragment_size);
+          if (*packet_number == number_of_packets_required-1uL)
+            *flags_field |= 0x02;
+
+          ACE_OS::memcpy (fragment_headers[fragment],
+                          miop_hdr.current ()->rd_ptr (),
+                          MIOP_DEFAULT_HEADER_SIZE);
+          this_send_iov[header_iov].iov_base = fragment_headers[fragment];
+          this_send_iov[header_iov].iov_len  = MIOP_DEFAULT_HEADER_SIZE;
+
+          this_send_payload += this_fragment_size;
+        } // Add next fragment
+
+      u_long const fragments = *packet_number - first_packet_number;
+      u_long this_send_size = // Now includes the MIOP headers
+        this_send_payload + fragments * MIOP_DEFAULT_HEADER_SIZE;
+
+      if (fragments > 1u)
         {
           // Make sure we don't send our fragments too quickly
           if (factory->enable_throttling ())
             this->throttle_send_rate (
               factory->max_fragment_rate (),
               max_fragment_size,
-              this_fragment_size);
-
-          // Haven't sent some of the data yet, we need to adjust the fragments iov's
-          // to skip the data we have actually manage to send so far.
-          while (already_sent)
-            if (static_cast<u_long> (current_iov->iov_len) <= static_cast<u_long> (already_sent))
-              {
-                // This whole iov has been sent, simply skip over it
-                already_sent-= current_iov->iov_len;
-                --this_fragment_iovcnt;
-                ++current_iov;
-              }
-            else
-              {
-                // This iov has been partially sent, adjust it's data
-                // to skip over those bytes already transmitted.
-                current_iov->iov_len -= static_cast<u_long> (already_sent);
-                current_iov->iov_base =
-                  &static_cast<char *> (current_iov->iov_base)[already_sent];
-                break; // already_sent= 0;
-              }
-
-          // Ok now we attempt to actually send the fragment.
-          already_sent =
-            this->connection_handler_->peer ().send (
-              current_iov,
-              this_fragment_iovcnt,
+              this_send_size);
+
+          // The kernel splits these into one datagram per fragment.
+          ssize_t const sent =
+            this->connection_handler_->peer ().send_segments (
+              this_send_iov,
+              this_send_iovcnt,
+              max_fragment_size,
               addr);
-          if (already_sent < 0)
+          if (sent != static_cast<ssize_t> (this_send_size))
             {
               ORBSVCS_DEBUG ((LM_ERROR,
                           ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
-                          ACE_TEXT ("error sending data (Errno: '%m')\n"),
+                          ACE_TEXT ("error sending fragments (Errno: '%m')\n"),
                           this->id ()));
               return -1;
             }
-          else if (TAO_debug_level &&
-                   static_cast<u_long> (already_sent) != this_fragment_size)
-            {
-              ORBSVCS_DEBUG ((LM_DEBUG,
-                          ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
-                          ACE_TEXT ("Partial fragment (%B/%u bytes), ")
-                          ACE_TEXT ("reattempting remainder.\n"),
-                          this->id (),
-                          already_sent,
-                          this_fragment_size));
-            }
 
           // Keep a note of the number of bytes we have just buffered
           if (factory->enable_throttling ())
-            this->total_bytes_outstanding_+= static_cast<u_long> (already_sent);
-        } // Keep sending the rest of the fragment
+            this->total_bytes_outstanding_+= this_send_size;
+        }
+      else
+        {
+          ssize_t already_sent = 0; // No data sent yet!
+          iovec *current_iov= this_send_iov;
+          for (;
+               this_send_size; // Still any data to send
+               this_send_size-= static_cast<u_long> (already_sent))
+            {
+              // Make sure we don't send our fragments too quickly
+              if (factory->enable_throttling ())
+                this->throttle_send_rate (
+                  factory->max_fragment_rate (),
+                  max_fragment_size,
+                  this_send_size);
+
+              // Haven't sent some of the data yet, we need to adjust the fragments iov's
+              // to skip the data we have actually manage to send so far.
+              while (already_sent)
+                if (static_cast<u_long> (current_iov->iov_len) <= static_cast<u_long> (already_sent))
+                  {
+                    // This whole iov has been sent, simply skip over it
+                    already_sent-= current_iov->iov_len;
+                    --this_send_iovcnt;
+                    ++current_iov;
+                  }
+                else
+                  {
+                    // This iov has been partially sent, adjust it's data
+                    // to skip over those bytes already transmitted.
+                    current_iov->iov_len -= static_cast<u_long> (already_sent);
+                    current_iov->iov_base =
+                      &static_cast<char *> (current_iov->iov_base)[already_sent];
+                    break; // already_sent= 0;
+                  }
+
+              // Ok now we attempt to actually send the fragment.
+              already_sent =
+                this->connection_handler_->peer ().send (
+                  current_iov,
+                  this_send_iovcnt,
+                  addr);
+              if (already_sent < 0)
+                {
+                  ORBSVCS_DEBUG ((LM_ERROR,
+                              ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
+                              ACE_TEXT ("error sending data (Errno: '%m')\n"),
+                              this->id ()));
+                  return -1;
+                }
+              else if (TAO_debug_level &&
+                       static_cast<u_long> (already_sent) != this_send_size)
+                {
+                  ORBSVCS_DEBUG ((LM_DEBUG,
+                              ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
+                              ACE_TEXT ("Partial fragment (%B/%u bytes), ")
+                              ACE_TEXT ("reattempting remainder.\n"),
+                              this->id (),
+                              already_sent,
+                              this_send_size));
+                }
+
+              // Keep a note of the number of bytes we have just buffered
+              if (factory->enable_throttling ())
+                this->total_bytes_outstanding_+= static_cast<u_long> (already_sent);
+            } // Keep sending the rest of the fragment
+        }
 
       // Increment the number of bytes of payload transferred.
-      bytes_transferred += *packet_length;
+      bytes_transferred += this_send_payload;
 
       if (9 <= TAO_debug_level)
         {
@@ -395,15 +472,17 @@ TAO_UIPMC_Transport::send (
           addr.get_host_addr (tmp, sizeof tmp);
           ORBSVCS_DEBUG ((LM_DEBUG,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
-                      ACE_TEXT ("Sent %u bytes payload (fragment %u/%u) to <%C:%u>\n"),
+                      ACE_TEXT ("Sent %u bytes payload (fragments %u-%u/%u) to <%C:%u>\n"),
                       this->id (),
-                      *packet_length,
-                      *packet_number + 1uL,
+                      this_send_payload,
+                      first_packet_number + 1uL,
+                      *packet_number,
                       number_of_packets_required,
                       tmp,
                       addr.get_port_number ()));
         }
-    } // Send next fragment
+    } // Send next fragments
+
 
   // Return total bytes transferred.
   return bytes_transferred;
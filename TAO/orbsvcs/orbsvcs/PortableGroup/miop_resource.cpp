@@ -21,6 +21,7 @@ TAO_MIOP_Resource_Factory::TAO_MIOP_Resource_Factory (void)
   , receive_buffer_size_ (0u) // Zero is unspecified (-ORBRcvSock).
   , enable_throttling_    (!!(TAO_DEFAULT_MIOP_SEND_THROTTLING))  // Client-side SendRate throttling enabled.
   , enable_eager_dequeue_ (!!(TAO_DEFAULT_MIOP_EAGER_DEQUEUEING)) // Server-side Multiple message dequeueing.
+  , enable_segmentation_offload_ (!!(TAO_DEFAULT_MIOP_SEGMENTATION_OFFLOAD)) // Kernel splits and coalesces fragments.
 {
 }
 
@@ -262,6 +263,17 @@ TAO_MIOP_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
                         ACE_TEXT ("%s missing 0 or 1 parameter.\n"),
                         argv[curarg-1]));
         }
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT ("-ORBSegmentationOffload")) == 0)
+        {
+          if (++curarg < argc)
+            this->enable_segmentation_offload_= static_cast<bool> (ACE_OS::atoi (argv[curarg]));
+          else
+            ORBSVCS_DEBUG ((LM_ERROR,
+                        ACE_TEXT ("TAO (%P|%t) - MIOP_Resource_Factory ")
+                        ACE_TEXT ("%s missing 0 or 1 parameter.\n"),
+                        argv[curarg-1]));
+        }
       else if (ACE_OS::strncmp (argv[curarg], ACE_TEXT ("-ORB"), 4) == 0)
         {
           // Can we assume there is an argument after the option?
@@ -381,6 +393,12 @@ TAO_MIOP_Resource_Factory::enable_eager_dequeue (void) const
   return enable_eager_dequeue_;
 }
 
+bool
+TAO_MIOP_Resource_Factory::enable_segmentation_offload (void) const
+{
+  return enable_segmentation_offload_;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
 
 // ****************************************************************
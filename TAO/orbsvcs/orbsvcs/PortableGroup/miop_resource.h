@@ -94,6 +94,10 @@ public:
   /// Get the server-side eager complete message dequeuing enable flag.
   bool enable_eager_dequeue (void) const;
 
+  /// Get the flag enabling the kernel to split (client-side) and
+  /// coalesce (server-side) the MIOP fragments.
+  bool enable_segmentation_offload (void) const;
+
 private:
   enum Fragments_Cleanup_Strategy_Type
     {
@@ -131,6 +135,9 @@ private:
 
   /// Get the server-side eager complete message dequeuing enable flag.
   bool enable_eager_dequeue_;
+
+  /// Get the flag enabling the kernel to split and coalesce the MIOP fragments.
+  bool enable_segmentation_offload_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
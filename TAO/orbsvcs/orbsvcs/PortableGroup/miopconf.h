@@ -100,10 +100,24 @@ static u_long const TAO_DEFAULT_MIOP_MAX_FRAGMENTS = 0u; // Zero is unlimited
 static bool const TAO_DEFAULT_MIOP_SEND_THROTTLING = true; // Enabled
 #endif
 
+// Default number of MIOP fragments the server receives from the socket
+// with one system call.  Each takes a MIOP_MAX_DGRAM_SIZE buffer.
+#if !defined (TAO_DEFAULT_MIOP_RECV_BATCH_SIZE)
+static size_t const TAO_DEFAULT_MIOP_RECV_BATCH_SIZE = 8u;
+#endif
+
 #if !defined (TAO_DEFAULT_MIOP_EAGER_DEQUEUEING)
 static bool const TAO_DEFAULT_MIOP_EAGER_DEQUEUEING = true; // Enabled
 #endif
 
+#if !defined (TAO_DEFAULT_MIOP_SEGMENTATION_OFFLOAD)
+static bool const TAO_DEFAULT_MIOP_SEGMENTATION_OFFLOAD = false; // Disabled
+#endif
+
+// Maximum number of MIOP fragments the client hands to the kernel with
+// one system call when segmentation offload is enabled.
+static u_long const MIOP_MAX_FRAGMENTS_PER_SEND = 64u;
+
 static CORBA::Octet const miop_magic[4] = {
   0x4d, 0x49, 0x4f, 0x50
 }; // in ASCII this is 'M', 'I', 'O', 'P'
@@ -548,6 +548,17 @@ TAO::SSLIOP::Protocol_Factory::init (int argc, ACE_TCHAR* argv[])
         {
           this->check_host_ = true;
         }
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT("-SSLKernelTLS")) == 0)
+        {
+          if (ssl_ctx->kernel_tls () != 0)
+            {
+              ORBSVCS_DEBUG ((LM_WARNING,
+                          ACE_TEXT ("TAO (%P|%t) - SSLIOP factory ")
+                          ACE_TEXT ("ignores -SSLKernelTLS, OpenSSL ")
+                          ACE_TEXT ("lacks kernel TLS support.\n")));
+            }
+        }
       else if (ACE_OS::strcasecmp (argv[curarg],
                                    ACE_TEXT ("-SSLEcName")) == 0)
         {
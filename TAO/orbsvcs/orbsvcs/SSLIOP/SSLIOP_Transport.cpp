@@ -73,6 +73,30 @@ TAO::SSLIOP::Transport::send (iovec *iov,
   return retval;
 }
 
+#if TAO_HAS_SENDFILE == 1
+ssize_t
+TAO::SSLIOP::Transport::sendfile (TAO_MMAP_Allocator * allocator,
+                                  iovec * iov,
+                                  int iovcnt,
+                                  size_t &bytes_transferred,
+                                  TAO::Transport::Drain_Constraints const & dc)
+{
+  // The records are only built by the kernel with kernel TLS, and we
+  // can only use sendfile when all data is coming from the mmap
+  // allocator.  If not, we just fallback to the regular way of
+  // sending data.
+  if (allocator == 0 || !this->connection_handler_->peer ().kernel_tls_send ())
+    return this->send (iov, iovcnt, bytes_transferred, this->io_timeout (dc));
+
+  return this->sendfile_i (allocator,
+                           this->connection_handler_->peer ().get_handle (),
+                           iov,
+                           iovcnt,
+                           bytes_transferred,
+                           dc);
+}
+#endif  /* TAO_HAS_SENDFILE==1 */
+
 ssize_t
 TAO::SSLIOP::Transport::recv (char *buf,
                               size_t len,
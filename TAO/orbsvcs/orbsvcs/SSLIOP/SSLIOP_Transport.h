@@ -89,6 +89,16 @@ namespace TAO
                             size_t &bytes_transferred,
                             const ACE_Time_Value *timeout = 0);
 
+#if TAO_HAS_SENDFILE == 1
+      /// Send the data with sendfile() when the kernel encrypts the
+      /// data sent on the connection (kernel TLS).
+      virtual ssize_t sendfile (TAO_MMAP_Allocator * allocator,
+                                iovec * iov,
+                                int iovcnt,
+                                size_t &bytes_transferred,
+                                TAO::Transport::Drain_Constraints const & dc);
+#endif  /* TAO_HAS_SENDFILE==1 */
+
       /// Read len bytes from into buf.
       virtual ssize_t recv (char *buf,
                             size_t len,
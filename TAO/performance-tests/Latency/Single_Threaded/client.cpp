@@ -9,6 +9,71 @@
 
 #include "tao/Strategies/advanced_resource.h"
 
+#include <new>
+#include <cstdlib>
+
+#if defined (ACE_HAS_CPP11)
+# define LATENCY_NOTHROW noexcept
+#else
+# define LATENCY_NOTHROW throw ()
+#endif /* ACE_HAS_CPP11 */
+
+// Number of heap allocations so far, the client is single threaded.
+static unsigned long allocations = 0;
+
+void *
+operator new (std::size_t size)
+{
+  ++allocations;
+  void *ptr = std::malloc (size == 0 ? 1 : size);
+  if (ptr == 0)
+    throw std::bad_alloc ();
+  return ptr;
+}
+
+void *
+operator new (std::size_t size, const std::nothrow_t &) LATENCY_NOTHROW
+{
+  ++allocations;
+  return std::malloc (size == 0 ? 1 : size);
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  return operator new (size);
+}
+
+void *
+operator new[] (std::size_t size, const std::nothrow_t &nt) LATENCY_NOTHROW
+{
+  return operator new (size, nt);
+}
+
+void
+operator delete (void *ptr) LATENCY_NOTHROW
+{
+  std::free (ptr);
+}
+
+void
+operator delete (void *ptr, const std::nothrow_t &) LATENCY_NOTHROW
+{
+  std::free (ptr);
+}
+
+void
+operator delete[] (void *ptr) LATENCY_NOTHROW
+{
+  std::free (ptr);
+}
+
+void
+operator delete[] (void *ptr, const std::nothrow_t &) LATENCY_NOTHROW
+{
+  std::free (ptr);
+}
+
 const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
 int niterations = 100;
 int do_dump_history = 0;
@@ -108,6 +173,7 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
 
       ACE_Sample_History history (niterations);
 
+      unsigned long const allocations_start = allocations;
       ACE_hrtime_t test_start = ACE_OS::gethrtime ();
       for (int i = 0; i < niterations; ++i)
         {
@@ -120,6 +186,7 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
         }
 
       ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+      unsigned long const test_allocations = allocations - allocations_start;
 
       ACE_DEBUG ((LM_DEBUG, "test finished\n"));
 
@@ -141,6 +208,13 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
                                              test_end - test_start,
                                              stats.samples_count ());
 
+      ACE_DEBUG ((LM_DEBUG,
+                  "Total allocations: %Q (%.2f per call)\n",
+                  static_cast<ACE_UINT64> (test_allocations),
+                  niterations > 0
+                    ? double (test_allocations) / niterations
+                    : 0.0));
+
       if (do_shutdown)
         {
           roundtrip->shutdown ();
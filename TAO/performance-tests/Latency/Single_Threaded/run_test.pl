@@ -17,13 +17,15 @@ foreach $i (@ARGV) {
 }
 
 $iteration = 250000;
+$svc_conf = '';
 
 for ($iter = 0; $iter <= $#ARGV; $iter++) {
     if ($ARGV[$iter] eq "-h" || $ARGV[$iter] eq "-?") {
         print "Run_Test Perl script for Single-threaded Latency test\n\n";
-        print "run_test [-n num] [-h] \n";
+        print "run_test [-n num] [-slab] [-h] \n";
         print "\n";
         print "-n num              -- runs the client num times\n";
+        print "-slab               -- uses the slab allocator for CDR\n";
         print "-h                  -- prints this information\n";
         exit 0;
     }
@@ -31,6 +33,9 @@ for ($iter = 0; $iter <= $#ARGV; $iter++) {
         $iteration = $ARGV[$iter + 1];
         $i++;
     }
+    elsif ($ARGV[$iter] eq "-slab") {
+        $svc_conf = '-ORBSvcConf svc_slab.conf';
+    }
 }
 
 print STDERR "================ Single-threaded Latency Test\n";
@@ -44,8 +49,8 @@ my $client_iorfile = $client->LocalFile ($iorbase);
 $server->DeleteFile($iorbase);
 $client->DeleteFile($iorbase);
 
-$SV = $server->CreateProcess ("server", "-ORBdebuglevel $debug_level -o $server_iorfile");
-$CL = $client->CreateProcess ("client", "-k file://$client_iorfile -i $iteration");
+$SV = $server->CreateProcess ("server", "$svc_conf -ORBdebuglevel $debug_level -o $server_iorfile");
+$CL = $client->CreateProcess ("client", "$svc_conf -k file://$client_iorfile -i $iteration");
 
 $server_status = $SV->Spawn ();
 
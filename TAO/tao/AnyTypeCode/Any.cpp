@@ -8,6 +8,7 @@
 #include "tao/AnyTypeCode/TypeCode.h"
 #include "tao/AnyTypeCode/TypeCode_Constants.h"
 #include "tao/CDR.h"
+#include "tao/Request_Arena.h"
 #include "tao/SystemException.h"
 
 #include "ace/Log_Msg.h"
@@ -259,6 +260,10 @@ operator<< (TAO_OutputCDR &cdr, const CORBA::Any &any)
 CORBA::Boolean
 operator>> (TAO_InputCDR &cdr, CORBA::Any &any)
 {
+  // The value may be kept by the servant, beyond the arena of the
+  // request.
+  TAO::Request_Arena::Guard arena_guard (cdr, 0);
+
   CORBA::TypeCode_var tc;
 
   if ((cdr >> tc.out ()) == 0)
@@ -106,10 +106,12 @@ TAO::Unknown_IDL_Type::_tao_byte_order (void) const
 void
 TAO::Unknown_IDL_Type::_tao_decode (TAO_InputCDR & cdr)
 {
-  // @@ (JP) The following code depends on the fact that
-  //         TAO_InputCDR does not contain chained message blocks,
-  //         otherwise <begin> and <end> could be part of
-  //         different buffers!
+  // <begin> and <end> must be part of the same buffer, so copy the
+  // rest of a chained stream to one block first.
+  if (cdr.consolidate () != 0)
+    {
+      throw ::CORBA::NO_MEMORY ();
+    }
 
   // This will be the start of a new message block.
   char const * const begin = cdr.rd_ptr ();
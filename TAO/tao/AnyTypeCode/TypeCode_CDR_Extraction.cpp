@@ -24,6 +24,7 @@
 #include "tao/AnyTypeCode/TypeCode_Value_Field.h"
 
 #include "tao/CDR.h"
+#include "tao/Request_Arena.h"
 
 #include "ace/Array_Base.h"
 #include "ace/Value_Ptr.h"
@@ -1504,6 +1505,15 @@ namespace
 CORBA::Boolean
 operator>> (TAO_InputCDR & cdr, CORBA::TypeCode_ptr & tc)
 {
+  // TypeCodes are reference counted, they may outlive the arena of
+  // the request.
+  TAO::Request_Arena::Guard arena_guard (cdr, 0);
+
+  // Indirections are offsets from the rd_ptr(), so the TypeCode must
+  // be in one block.
+  if (cdr.consolidate () != 0)
+    return false;
+
   TAO::TypeCodeFactory::TC_Info_List indirect_infos;
   TAO::TypeCodeFactory::TC_Info_List direct_infos;
 
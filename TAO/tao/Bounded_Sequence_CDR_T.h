@@ -299,6 +299,32 @@ namespace TAO {
     return true;
   }
 
+  template <typename stream, typename value_t, CORBA::ULong MAX>
+  bool demarshal_pod_sequence(stream & strm, TAO::bounded_value_sequence <value_t, MAX> & target, size_t cdr_size, size_t align) {
+    typedef TAO::bounded_value_sequence <value_t, MAX> sequence;
+    if (strm.do_byte_swap() || strm.char_translator() != 0 ||
+        sizeof(value_t) != cdr_size) {
+      return demarshal_sequence(strm, target);
+    }
+    ::CORBA::ULong new_length = 0;
+    if (!(strm >> new_length)) {
+      return false;
+    }
+    if ((new_length > strm.length() / sizeof(value_t)) || (new_length > target.maximum ())) {
+      return false;
+    }
+    sequence tmp;
+    tmp.length(new_length);
+    if (new_length != 0 &&
+        (strm.align_read_ptr(align) != 0 ||
+         !strm.read_octet_array(reinterpret_cast<CORBA::Octet *> (tmp.get_buffer()),
+                                new_length * sizeof(value_t)))) {
+      return false;
+    }
+    tmp.swap(target);
+    return true;
+  }
+
   template <typename stream, typename charT, CORBA::ULong MAX>
   bool demarshal_sequence(stream & strm, TAO::bounded_basic_string_sequence <charT, MAX> & target) {
     typedef typename TAO::bounded_basic_string_sequence <charT, MAX> sequence;
@@ -518,6 +544,25 @@ namespace TAO {
     return true;
   }
 
+  template <typename stream, typename value_t, CORBA::ULong MAX>
+  bool marshal_pod_sequence(stream & strm, const TAO::bounded_value_sequence <value_t, MAX> & source, size_t cdr_size, size_t align) {
+    if (strm.do_byte_swap() || strm.char_translator() != 0 ||
+        sizeof(value_t) != cdr_size) {
+      return marshal_sequence(strm, source);
+    }
+    ::CORBA::ULong const length = source.length ();
+    if (length > source.maximum () || !(strm << length)) {
+      return false;
+    }
+    if (length == 0) {
+      return true;
+    }
+    return strm.align_write_ptr(align) == 0 &&
+      strm.write_octet_array(
+        reinterpret_cast<const CORBA::Octet *> (source.get_buffer ()),
+        length * sizeof(value_t));
+  }
+
   template <typename stream, typename charT, CORBA::ULong MAX>
   bool marshal_sequence(stream & strm, const TAO::bounded_basic_string_sequence <charT, MAX> & source) {
     ::CORBA::ULong const length = source.length ();
@@ -3,6 +3,7 @@
 #include "tao/ORB_Core.h"
 #include "tao/SystemException.h"
 #include "tao/GIOP_Fragmentation_Strategy.h"
+#include "tao/Request_Arena.h"
 
 #include "ace/Truncate.h"
 
@@ -300,10 +301,40 @@ TAO_InputCDR::TAO_InputCDR (const TAO_OutputCDR& rhs,
                   ? message_block_allocator
                   : (orb_core ?
                      orb_core->output_cdr_msgblock_allocator () : 0)),
-  orb_core_ (orb_core)
+  orb_core_ (orb_core),
+  arena_ (0)
 {
 }
 
+ACE_CDR::Boolean
+TAO_InputCDR::read_arena_string (ACE_CDR::Char *&x)
+{
+  ACE_CDR::ULong len = 0;
+
+  if (!this->read_ulong (len))
+    return false;
+
+  // As in read_string(), empty strings are returned for null ones and
+  // the length is checked before any memory is allocated.
+  if (len <= this->length ())
+    {
+      x = static_cast<ACE_CDR::Char *> (
+        this->arena_->allocate (len == 0 ? 1 : len, 1));
+
+      if (x != 0 && len == 0)
+        {
+          *x = '\0';
+          return true;
+        }
+
+      if (x != 0 && this->read_char_array (x, len))
+        return true;
+    }
+
+  x = 0;
+  return (this->good_bit_ = false);
+}
+
 void
 TAO_InputCDR::throw_stub_exception (int error_num )
 {
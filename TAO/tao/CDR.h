@@ -67,6 +67,11 @@ class TAO_ORB_Core;
 class TAO_GIOP_Fragmentation_Strategy;
 class TAO_Stub;
 
+namespace TAO
+{
+  class Request_Arena;
+}
+
 /**
  * @class TAO_OutputCDR
  *
@@ -440,10 +445,25 @@ public:
   /// Called after demarshalling.
   void reset_vt_indirect_maps ();
 
+  /// The arena strings and the buffers of unbounded sequences of
+  /// basic types are demarshaled into, 0 (the default) to allocate
+  /// them from the heap.  Copies of the stream don't share it.
+  //@{
+  TAO::Request_Arena *arena (void) const;
+  void arena (TAO::Request_Arena *arena);
+  //@}
+
+  /// Demarshal a string into the arena of the stream, as
+  /// read_string() does into the heap.
+  ACE_CDR::Boolean read_arena_string (ACE_CDR::Char *&x);
+
 private:
   /// The ORB_Core, required to extract object references.
   TAO_ORB_Core* orb_core_;
 
+  /// See arena().
+  TAO::Request_Arena *arena_;
+
   /// These maps are used by valuetype indirection support.
   Repo_Id_Map_Handle repo_id_map_;
   Codebase_URL_Map_Handle codebase_map_;
@@ -136,7 +136,8 @@ TAO_InputCDR::TAO_InputCDR (const char *buf,
                   byte_order,
                   major_version,
                   minor_version),
-    orb_core_ (orb_core)
+    orb_core_ (orb_core),
+    arena_ (0)
 {
 }
 
@@ -150,7 +151,8 @@ TAO_InputCDR::TAO_InputCDR (size_t bufsiz,
                   byte_order,
                   major_version,
                   minor_version),
-    orb_core_ (orb_core)
+    orb_core_ (orb_core),
+    arena_ (0)
 {
 }
 
@@ -164,7 +166,8 @@ TAO_InputCDR::TAO_InputCDR (const ACE_Message_Block *data,
                   byte_order,
                   major_version,
                   minor_version),
-    orb_core_ (orb_core)
+    orb_core_ (orb_core),
+    arena_ (0)
 {
 }
 
@@ -180,7 +183,8 @@ TAO_InputCDR::TAO_InputCDR (const ACE_Message_Block *data,
                   major_version,
                   minor_version,
                   lock),
-    orb_core_ (orb_core)
+    orb_core_ (orb_core),
+    arena_ (0)
 {
 }
 
@@ -196,7 +200,8 @@ TAO_InputCDR::TAO_InputCDR (ACE_Data_Block *data,
                   byte_order,
                   major_version,
                   minor_version),
-    orb_core_ (orb_core)
+    orb_core_ (orb_core),
+    arena_ (0)
 {
 }
 
@@ -217,7 +222,8 @@ TAO_InputCDR::TAO_InputCDR (ACE_Data_Block *data,
                   byte_order,
                   major_version,
                   minor_version),
-    orb_core_ (orb_core)
+    orb_core_ (orb_core),
+    arena_ (0)
 {
 }
 
@@ -229,7 +235,8 @@ TAO_InputCDR::TAO_InputCDR (const TAO_InputCDR& rhs,
   : ACE_InputCDR (rhs,
                   size,
                   offset),
-    orb_core_ (rhs.orb_core_)
+    orb_core_ (rhs.orb_core_),
+    arena_ (0)
 {
 }
 
@@ -238,7 +245,8 @@ TAO_InputCDR::TAO_InputCDR (const TAO_InputCDR& rhs,
                             size_t size)
   : ACE_InputCDR (rhs,
                   size),
-    orb_core_ (rhs.orb_core_)
+    orb_core_ (rhs.orb_core_),
+    arena_ (0)
 {
 }
 
@@ -246,6 +254,7 @@ ACE_INLINE
 TAO_InputCDR::TAO_InputCDR (const TAO_InputCDR& rhs)
   : ACE_InputCDR (rhs),
     orb_core_ (rhs.orb_core_),
+    arena_ (0),
     repo_id_map_ (rhs.repo_id_map_),
     codebase_map_ (rhs.codebase_map_),
     value_map_ (rhs.value_map_)
@@ -256,7 +265,8 @@ ACE_INLINE
 TAO_InputCDR::TAO_InputCDR (ACE_InputCDR::Transfer_Contents rhs,
                             TAO_ORB_Core* orb_core)
   : ACE_InputCDR (rhs),
-    orb_core_ (orb_core)
+    orb_core_ (orb_core),
+    arena_ (0)
 {
 }
 
@@ -272,6 +282,18 @@ TAO_InputCDR::orb_core (void) const
   return this->orb_core_;
 }
 
+ACE_INLINE TAO::Request_Arena *
+TAO_InputCDR::arena (void) const
+{
+  return this->arena_;
+}
+
+ACE_INLINE void
+TAO_InputCDR::arena (TAO::Request_Arena *arena)
+{
+  this->arena_ = arena;
+}
+
 
 ACE_INLINE TAO_InputCDR::Repo_Id_Map_Handle&
 TAO_InputCDR::get_repo_id_map ()
@@ -562,6 +584,9 @@ ACE_INLINE CORBA::Boolean operator>> (TAO_InputCDR &is,
 ACE_INLINE CORBA::Boolean operator>> (TAO_InputCDR &is,
                                       CORBA::Char* &x)
 {
+  if (is.arena () != 0 && is.char_translator () == 0)
+    return is.read_arena_string (x);
+
   return static_cast<ACE_InputCDR &> (is) >> x;
 }
 
@@ -940,6 +940,11 @@ TAO_DynValue_i::from_inputCDR (TAO_InputCDR &strm)
   // Save the start of this ValueType position in the input stream
   // to allow caching for later indirections.
   VERIFY_MAP (TAO_InputCDR, value_map, Value_Map);
+  if (strm.consolidate () != 0)
+    {
+      this->set_to_null ();
+      throw CORBA::NO_MEMORY ();
+    }
   if (strm.align_read_ptr (ACE_CDR::LONG_SIZE))
     {
       this->set_to_null ();
@@ -88,6 +88,12 @@ namespace TAO
     // This is important to decode the exception.
     CORBA::String_var buf;
 
+    // The exception is copied from the current block of the stream.
+    if (cdr.consolidate () != 0)
+      {
+        throw ::CORBA::NO_MEMORY (TAO::VMCID, CORBA::COMPLETED_YES);
+      }
+
     TAO_InputCDR tmp_stream (cdr,
                              cdr.start ()->length (),
                              0);
@@ -703,6 +703,10 @@ TAO_GIOP_Message_Base::process_request_message (TAO_Transport *transport,
                           qd->giop_version ().minor_version (),
                           this->orb_core_);
 
+  // The other fragments of the message, if any, are chained after the
+  // first one and read in place.
+  input_cdr.append (qd->msg_block ()->cont ());
+
   transport->assign_translators(&input_cdr,&output);
 
   // We know we have some request message. Check whether it is a
@@ -827,6 +831,10 @@ TAO_GIOP_Message_Base::process_reply_message (
                           qd->giop_version ().minor_version (),
                           this->orb_core_);
 
+  // The other fragments of the message, if any, are chained after the
+  // first one and read in place.
+  input_cdr.append (qd->msg_block ()->cont ());
+
   // We know we have some reply message. Check whether it is a
   // GIOP_REPLY or GIOP_LOCATE_REPLY to take action.
 
@@ -1934,11 +1942,24 @@ TAO_GIOP_Message_Base::consolidate_fragmented_message (
       this->fragment_stack_.push (head);
     }
 
-  if (tail->consolidate () == -1)
+  // The fragments stay chained, the input CDR reads across them.  A
+  // compressed message is decompressed from a single buffer though.
+#if defined (TAO_HAS_ZIOP) && TAO_HAS_ZIOP ==1
+  if (tail->state ().compressed ())
     {
-      // memory allocation failed
-      TAO_Queued_Data::release (tail);
-      return -1;
+      if (tail->consolidate () == -1)
+        {
+          // memory allocation failed
+          TAO_Queued_Data::release (tail);
+          return -1;
+        }
+    }
+  else
+#endif
+    {
+      TAO_GIOP_Message_State state (tail->state ());
+      state.more_fragments (false);
+      tail->state (state);
     }
 
   // set out value
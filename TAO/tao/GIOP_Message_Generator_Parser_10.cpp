@@ -365,6 +365,13 @@ TAO_GIOP_Message_Generator_Parser_10::parse_request_header (
   CORBA::ULong length = 0;
   hdr_status = hdr_status && input.read_ulong (length);
 
+  // The operation name is used in place, it must not straddle two
+  // fragments.
+  if (hdr_status && length > input.start ()->length ())
+    {
+      hdr_status = input.consolidate () == 0;
+    }
+
   if (hdr_status)
     {
       // Do not include NULL character at the end.
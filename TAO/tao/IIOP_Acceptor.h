@@ -181,6 +181,12 @@ protected:
    *                for situations where you might normally use an ephemeral
    *                port but can't because you're behind a firewall and don't
    *                want to permit passage on all ephemeral ports)
+   *    reuse_port -- enables SO_REUSEPORT on the listen socket, so that
+   *                the acceptors of several thread lanes or ORBs, each
+   *                with its own reactor, can listen on the same port.
+   *                The kernel spreads new connections over them and
+   *                the IORs still publish the one endpoint.  Requires
+   *                an explicit port in every endpoint sharing it.
    */
   int parse_options (const char *options);
 
@@ -259,6 +265,9 @@ protected:
   /// Enable socket option SO_REUSEADDR to be set
   int reuse_addr_;
 
+  /// Enable socket option SO_REUSEPORT to be set
+  int reuse_port_;
+
   /// Address for default endpoint
   ACE_INET_Addr default_address_;
 
@@ -279,6 +279,22 @@ TAO_IIOP_Connection_Handler::open (void*)
         return -1;
     }
 
+  size_t const zerocopy_threshold =
+    this->orb_core ()->orb_params ()->zerocopy_threshold ();
+  if (zerocopy_threshold > 0)
+    {
+      TAO_IIOP_Transport *iiop_transport =
+        static_cast<TAO_IIOP_Transport *> (this->transport ());
+      // Without zero-copy support the messages are copied as usual.
+      if (iiop_transport->enable_zerocopy (zerocopy_threshold) == -1
+          && TAO_debug_level > 2)
+        {
+          TAOLIB_DEBUG ((LM_DEBUG,
+                      ACE_TEXT("TAO (%P|%t) - IIOP_Connection_Handler::open, ")
+                      ACE_TEXT("zero-copy sends not available - %m\n")));
+        }
+    }
+
   // Called by the <Strategy_Acceptor> when the handler is
   // completely connected.
 
@@ -15,7 +15,6 @@
 #include "tao/Transport_Mux_Strategy.h"
 #include "tao/MMAP_Allocator.h"
 
-#include "ace/OS_NS_sys_sendfile.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -24,6 +23,7 @@ TAO_IIOP_Transport::TAO_IIOP_Transport (TAO_IIOP_Connection_Handler *handler,
   : TAO_Transport (IOP::TAG_INTERNET_IOP,
                    orb_core)
   , connection_handler_ (handler)
+  , zerocopy_threshold_ (0)
 {
 }
 
@@ -58,10 +58,42 @@ TAO_IIOP_Transport::send (iovec *iov, int iovcnt,
                           size_t &bytes_transferred,
                           const ACE_Time_Value *max_wait_time)
 {
-  ssize_t const retval =
-    this->connection_handler_->peer ().sendv (iov,
-                                              iovcnt,
-                                              max_wait_time);
+  ssize_t retval = 0;
+  bool sent = false;
+
+  if (this->zerocopy_threshold_ > 0)
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->zerocopy_lock_, -1);
+
+      ACE_HANDLE const handle =
+        this->connection_handler_->peer ().get_handle ();
+
+      // Release the data of the earlier sends the kernel is done with.
+      (void) this->zerocopy_.reap (handle);
+
+      size_t total = 0;
+      for (int i = 0; i < iovcnt; ++i)
+        total += iov[i].iov_len;
+
+      ACE_Message_Block * const owner =
+        total >= this->zerocopy_threshold_
+          ? this->zerocopy_owner (iov, iovcnt)
+          : 0;
+      if (owner != 0)
+        {
+          retval = this->zerocopy_.sendv (handle,
+                                          iov,
+                                          iovcnt,
+                                          owner,
+                                          max_wait_time);
+          sent = true;
+        }
+    }
+
+  if (!sent)
+    retval = this->connection_handler_->peer ().sendv (iov,
+                                                       iovcnt,
+                                                       max_wait_time);
   if (retval > 0)
     bytes_transferred = retval;
   else
@@ -95,67 +127,12 @@ TAO_IIOP_Transport::sendfile (TAO_MMAP_Allocator * allocator,
   if (allocator == 0)
     return this->send (iov, iovcnt, bytes_transferred, this->io_timeout(dc));
 
-  // We can only use sendfile when all data is coming from the mmap allocator,
-  // if not, we just fallback to to the regular way of sending data
-  iovec * const off_check_begin = iov;
-  iovec * const off_check_end   = iov + iovcnt;
-  for (iovec * index = off_check_begin; index != off_check_end; ++index)
-    {
-      if (-1 == allocator->offset (index->iov_base))
-        return this->send (iov, iovcnt, bytes_transferred,
-                           this->io_timeout(dc));
-    }
-
-  ssize_t retval = -1;
-
-  ACE_HANDLE const in_fd = allocator->handle ();
-
-  if (in_fd == ACE_INVALID_HANDLE)
-    return retval;
-
-  ACE_HANDLE const out_fd =
-    this->connection_handler_->peer ().get_handle ();
-
-  iovec * const begin = iov;
-  iovec * const end   = iov + iovcnt;
-  for (iovec * i = begin; i != end; ++i)
-    {
-      off_t offset = allocator->offset (i->iov_base);
-
-      if (this->io_timeout(dc))
-        {
-          int val = 0;
-          if (ACE::enter_send_timedwait (out_fd,
-                                         this->io_timeout(dc), val) == -1)
-            return retval;
-          else
-            {
-              retval =
-                ACE_OS::sendfile (out_fd, in_fd, &offset, i->iov_len);
-              ACE::restore_non_blocking_mode (out_fd, val);
-            }
-        }
-      else
-        {
-          retval = ACE_OS::sendfile (out_fd, in_fd, &offset, i->iov_len);
-        }
-
-      if (retval <= 0)  // Report errors below.
-        break;
-
-      bytes_transferred += static_cast<size_t> (retval);
-    }
-
-  if (retval <= 0 && TAO_debug_level > 4)
-    {
-      TAOLIB_DEBUG ((LM_DEBUG,
-                  ACE_TEXT ("TAO (%P|%t) - IIOP_Transport[%d]::sendfile, ")
-                  ACE_TEXT ("sendfile failure - %m (errno: %d)\n"),
-                  this->id (),
-                  ACE_ERRNO_GET));
-    }
-
-  return retval;
+  return this->sendfile_i (allocator,
+                           this->connection_handler_->peer ().get_handle (),
+                           iov,
+                           iovcnt,
+                           bytes_transferred,
+                           dc);
 }
 #endif  /* TAO_HAS_SENDFILE==1 */
 
@@ -185,7 +162,21 @@ TAO_IIOP_Transport::recv (char *buf,
   if (n == -1)
     {
       if (errno == EWOULDBLOCK)
-        return 0;
+        {
+          // The completions of zero-copy sends make the socket look
+          // readable to select(); consume them.
+          if (this->zerocopy_threshold_ > 0)
+            {
+              // FUZZ: disable check_for_ACE_Guard
+              ACE_Guard<TAO_SYNCH_MUTEX> guard (this->zerocopy_lock_, 0); // tryacquire
+              // FUZZ: enable check_for_ACE_Guard
+              if (guard.locked ())
+                (void) this->zerocopy_.reap (
+                  this->connection_handler_->peer ().get_handle ());
+            }
+
+          return 0;
+        }
 
       return -1;
     }
@@ -242,11 +233,41 @@ TAO_IIOP_Transport::send_message (TAO_OutputCDR &stream,
       return -1;
     }
 
+  // Large messages are sent from a pinned chain, whose data stays
+  // unchanged until the kernel is done with it: the start block of the
+  // stream, reused for the next message, and the octet sequences the
+  // caller still owns are copied, the blocks the stream grew shared.
+  ACE_Message_Block *zerocopy_chain = 0;
+  if (this->zerocopy_threshold_ > 0
+      && stream.total_length () >= this->zerocopy_threshold_)
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->zerocopy_lock_, -1);
+
+      zerocopy_chain = ACE_SOCK_Zerocopy::pin (stream.begin ());
+      if (zerocopy_chain != 0
+          && this->zerocopy_chains_.insert (zerocopy_chain) != 0)
+        {
+          zerocopy_chain->release ();
+          zerocopy_chain = 0;
+        }
+    }
+
   // This guarantees to send all data (bytes) or return an error.
-  ssize_t const n = this->send_message_shared (stub,
-                                               message_semantics,
-                                               stream.begin (),
-                                               max_wait_time);
+  ssize_t const n =
+    this->send_message_shared (stub,
+                               message_semantics,
+                               zerocopy_chain != 0
+                                 ? zerocopy_chain
+                                 : stream.begin (),
+                               max_wait_time);
+
+  if (zerocopy_chain != 0)
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->zerocopy_lock_, -1);
+
+      this->zerocopy_chains_.remove (zerocopy_chain);
+      zerocopy_chain->release ();
+    }
 
   if (n == -1)
     {
@@ -267,6 +288,54 @@ TAO_IIOP_Transport::send_message (TAO_OutputCDR &stream,
   return 1;
 }
 
+int
+TAO_IIOP_Transport::enable_zerocopy (size_t threshold)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->zerocopy_lock_, -1);
+
+  if (this->zerocopy_.enable (
+        this->connection_handler_->peer ().get_handle ()) == -1)
+    {
+      return -1;
+    }
+
+  this->zerocopy_threshold_ = threshold;
+  return 0;
+}
+
+ACE_Message_Block *
+TAO_IIOP_Transport::zerocopy_owner (const iovec *iov, int iovcnt) const
+{
+  ACE_Unbounded_Set_Const_Iterator<ACE_Message_Block *> chain (
+    this->zerocopy_chains_);
+
+  for (; !chain.done (); chain.advance ())
+    {
+      ACE_Message_Block **head = 0;
+      chain.next (head);
+
+      int i = 0;
+      for (; i < iovcnt; ++i)
+        {
+          char const * const begin = static_cast<char const *> (iov[i].iov_base);
+          char const * const end = begin + iov[i].iov_len;
+
+          ACE_Message_Block const *mb = *head;
+          for (; mb != 0; mb = mb->cont ())
+            if (begin >= mb->base () && end <= mb->end ())
+              break;
+
+          if (mb == 0)
+            break;
+        }
+
+      if (i == iovcnt)
+        return *head;
+    }
+
+  return 0;
+}
+
 int
 TAO_IIOP_Transport::tear_listen_point_list (TAO_InputCDR &cdr)
 {
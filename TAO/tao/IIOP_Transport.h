@@ -23,6 +23,8 @@
 #if defined (TAO_HAS_IIOP) && (TAO_HAS_IIOP != 0)
 
 #include "tao/Transport.h"
+#include "ace/SOCK_Zerocopy.h"
+#include "ace/Unbounded_Set.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -108,6 +110,10 @@ public:
 
   virtual int tear_listen_point_list (TAO_InputCDR &cdr);
 
+  /// Send the messages of at least @a threshold bytes without copying
+  /// them into the kernel.  Returns -1 if the platform can't.
+  int enable_zerocopy (size_t threshold);
+
   virtual TAO_Connection_Handler * connection_handler_i (void);
   //@}
 
@@ -120,10 +126,30 @@ private:
   /// endpoints in the @a acceptor
   int get_listen_point (IIOP::ListenPointList &listen_point_list,
                         TAO_Acceptor *acceptor);
+
+  /// Return the pinned chain holding all the data of @a iov, or 0 if
+  /// there is none.  Called with zerocopy_lock_ held.
+  ACE_Message_Block *zerocopy_owner (const iovec *iov, int iovcnt) const;
 private:
   /// The connection service handler used for accessing lower layer
   /// communication protocols.
   TAO_IIOP_Connection_Handler *connection_handler_;
+
+  /// Size from which messages are sent without copying them, 0 if
+  /// zero-copy sends are disabled.
+  size_t zerocopy_threshold_;
+
+  /// Keeps the data of the zero-copy sends until the kernel is done
+  /// with it.
+  ACE_SOCK_Zerocopy zerocopy_;
+
+  /// The chains, made by ACE_SOCK_Zerocopy::pin(), of the messages
+  /// being sent by send_message().
+  ACE_Unbounded_Set<ACE_Message_Block *> zerocopy_chains_;
+
+  /// Serializes access to zerocopy_ and zerocopy_chains_; recv()
+  /// reaps the zero-copy sends without holding the handler lock.
+  TAO_SYNCH_MUTEX zerocopy_lock_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
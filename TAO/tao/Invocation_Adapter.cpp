@@ -44,6 +44,8 @@ namespace TAO
                                       ex_data,
                                       ex_count);
 
+    op_details.marshal_size_hint (this->marshal_size_hint_);
+
     this->invoke_i (stub, op_details);
   }
 
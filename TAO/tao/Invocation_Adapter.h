@@ -139,6 +139,13 @@ namespace TAO
      */
     int _tao_byte_order ();
 
+    /**
+     * Set the expected size of the marshaled arguments, used by the
+     * stubs generated with -Gsz.  The output CDR stream reserves it
+     * in one block before the arguments are marshaled.
+     */
+    void marshal_size_hint (size_t size);
+
   protected:
     /**
      * The stub pointer passed to this call has all the details about
@@ -293,6 +300,9 @@ namespace TAO
 
     /// Intended byte order for message output stream
     int byte_order_;
+
+    /// Expected size of the marshaled arguments, 0 if unknown.
+    size_t marshal_size_hint_;
   };
 } // End namespace TAO
 
@@ -24,6 +24,7 @@ namespace TAO
     , type_ (type)
     , mode_ (mode)
     , byte_order_ (TAO_ENCAP_BYTE_ORDER)
+    , marshal_size_hint_ (0)
   {
   }
 
@@ -40,6 +41,13 @@ namespace TAO
   {
     return this->byte_order_;
   }
+
+  ACE_INLINE
+  void
+  Invocation_Adapter::marshal_size_hint (size_t size)
+  {
+    this->marshal_size_hint_ = size;
+  }
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -20,7 +20,7 @@
 # pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
-#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Flat_Hash_Map_T.h"
 #include "ace/Null_Mutex.h"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -88,11 +88,11 @@ private:
   /// Reply Dispatchers.
   TAO_ORB_Core * const orb_core_;
 
-  typedef ACE_Hash_Map_Manager_Ex <CORBA::ULong,
-                                   ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher>,
-                                   ACE_Hash <CORBA::ULong>,
-                                   ACE_Equal_To <CORBA::ULong>,
-                                   ACE_Null_Mutex>
+  typedef ACE_Flat_Hash_Map <CORBA::ULong,
+                             ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher>,
+                             ACE_Hash <CORBA::ULong>,
+                             ACE_Equal_To <CORBA::ULong>,
+                             ACE_Null_Mutex>
     REQUEST_DISPATCHER_TABLE;
 
   /// Table of <Request ID, Reply Dispatcher> pairs.
@@ -21,6 +21,7 @@
 #include "tao/Thread_Lane_Resources.h"
 #include "tao/Thread_Lane_Resources_Manager.h"
 #include "tao/TSS_Resources.h"
+#include "tao/Request_Arena.h"
 #include "tao/Protocols_Hooks.h"
 #include "tao/Network_Priority_Protocols_Hooks.h"
 #include "tao/IORInterceptor_Adapter.h"
@@ -1093,6 +1094,23 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
         {
           this->orb_params_.max_message_size (ACE_OS::atoi (current_arg));
 
+          arg_shifter.consume_arg ();
+        }
+      else if (0 != (current_arg = arg_shifter.get_the_parameter
+                (ACE_TEXT("-ORBZeroCopyThreshold"))))
+        {
+          this->orb_params_.zerocopy_threshold (ACE_OS::atoi (current_arg));
+
+          arg_shifter.consume_arg ();
+        }
+      else if (0 != (current_arg = arg_shifter.get_the_parameter
+                (ACE_TEXT("-ORBRequestArena"))))
+        {
+          this->orb_params_.request_arena (ACE_OS::atoi (current_arg) != 0);
+
+          if (this->orb_params_.request_arena ())
+            TAO::Request_Arena::enable ();
+
           arg_shifter.consume_arg ();
         }
       else if (0 != (current_arg = arg_shifter.get_the_parameter
@@ -3053,6 +3071,27 @@ TAO_ORB_Core::create_data_block_i (size_t size,
 {
   ACE_Data_Block *nb = 0;
 
+  // Save an allocation if the buffer allocator can put the buffer in
+  // the same chunk as the data block, both are then released by it.
+  void *buffer = 0;
+  void *memory =
+    buffer_allocator == 0
+      ? 0
+      : buffer_allocator->malloc_colocated (sizeof (ACE_Data_Block),
+                                            size,
+                                            buffer);
+  if (memory != 0)
+    {
+      nb = new (memory) ACE_Data_Block (size,
+                                        ACE_Message_Block::MB_DATA,
+                                        static_cast<char *> (buffer),
+                                        buffer_allocator,
+                                        lock_strategy,
+                                        0,
+                                        buffer_allocator);
+      return nb;
+    }
+
   ACE_NEW_MALLOC_RETURN (
                          nb,
                          static_cast<ACE_Data_Block*> (
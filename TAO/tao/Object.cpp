@@ -19,6 +19,7 @@
 #include "tao/CDR.h"
 #include "tao/SystemException.h"
 #include "tao/PolicyC.h"
+#include "tao/Request_Arena.h"
 
 #include "ace/Dynamic_Service.h"
 #include "ace/OS_NS_string.h"
@@ -846,6 +847,10 @@ CORBA::Object::tao_object_initialize (CORBA::Object *obj)
 CORBA::Boolean
 operator>> (TAO_InputCDR& cdr, CORBA::Object*& x)
 {
+  // The object may be kept by the servant, beyond the arena of the
+  // request.
+  TAO::Request_Arena::Guard arena_guard (cdr, 0);
+
   bool lazy_strategy = false;
   TAO_ORB_Core *orb_core = cdr.orb_core ();
 
@@ -21,6 +21,7 @@
 #include "tao/Timeprobe.h"
 #include "tao/ORB_Core.h"
 #include "tao/TSS_Resources.h"
+#include "tao/Request_Arena.h"
 #include "tao/Stub.h"
 #include "tao/TAO_Server_Request.h"
 #include "tao/IFR_Client_Adapter.h"
@@ -567,7 +568,12 @@ TAO_ServantBase::synchronous_upcall_dispatch (
       // the right operation on the skeleton class, and marshal any
       // results.  De/marshaling will only occur in the not collocated
       // case.
-      skel (req, servant_upcall, derived_this);
+      {
+        // The arena of the in arguments is given back on this thread,
+        // once the skeleton destroyed them.
+        TAO::Request_Arena::Upcall_Guard arena_guard (req);
+        skel (req, servant_upcall, derived_this);
+      }
 
       /*
        * Dispatch resolution specialization add hook.
@@ -635,7 +641,12 @@ TAO_ServantBase::asynchronous_upcall_dispatch (
       // the right operation on the skeleton class, and marshal any
       // results.  De/marshaling will only occur in the not collocated
       // case.
-      skel (req, servant_upcall, derived_this);
+      {
+        // The arena of the in arguments is given back on this thread,
+        // once the skeleton destroyed them.
+        TAO::Request_Arena::Upcall_Guard arena_guard (req);
+        skel (req, servant_upcall, derived_this);
+      }
 
       // It is our job to send the already marshaled reply, but only
       // send if it is expected and it has not already been sent
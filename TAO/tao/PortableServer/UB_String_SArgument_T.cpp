@@ -5,6 +5,8 @@
 #include "tao/PortableServer/UB_String_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/Request_Arena.h"
+
 #if !defined (__ACE_INLINE__)
 #include "tao/PortableServer/UB_String_SArgument_T.inl"
 #endif /* __ACE_INLINE__ */
@@ -15,6 +17,7 @@ template<typename S, typename S_var>
 CORBA::Boolean
 TAO::In_UB_String_SArgument_T<S,S_var>::demarshal (TAO_InputCDR &cdr)
 {
+  TAO::Request_Arena::Guard arena_guard (cdr, TAO::Request_Arena::current ());
   return cdr >> this->x_.out ();
 }
 
@@ -5,6 +5,8 @@
 #include "tao/PortableServer/Var_Array_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/Request_Arena.h"
+
 #if !defined (__ACE_INLINE__)
 #include "tao/PortableServer/Var_Array_SArgument_T.inl"
 #endif /* __ACE_INLINE__ */
@@ -17,6 +19,7 @@ CORBA::Boolean
 TAO::In_Var_Array_SArgument_T<S_forany,
                               Insert_Policy>::demarshal (TAO_InputCDR & cdr)
 {
+  TAO::Request_Arena::Guard arena_guard (cdr, TAO::Request_Arena::current ());
   S_forany tmp (this->x_);
   return cdr >> tmp;
 }
@@ -5,6 +5,7 @@
 #include "tao/PortableServer/Var_Size_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/Request_Arena.h"
 #include "tao/SystemException.h"
 
 #if !defined (__ACE_INLINE__)
@@ -18,6 +19,7 @@ template<typename S,
 CORBA::Boolean
 TAO::In_Var_Size_SArgument_T<S,Insert_Policy>::demarshal (TAO_InputCDR &cdr)
 {
+  TAO::Request_Arena::Guard arena_guard (cdr, TAO::Request_Arena::current ());
   return cdr >> this->x_;
 }
 
@@ -5,6 +5,8 @@
 #include "tao/PortableServer/Vector_SArgument_T.h"
 #endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
 
+#include "tao/Request_Arena.h"
+
 #if !defined (__ACE_INLINE__)
 #include "tao/PortableServer/Vector_SArgument_T.inl"
 #endif /* __ACE_INLINE__ */
@@ -16,6 +18,7 @@ template<typename S,
 CORBA::Boolean
 TAO::In_Vector_SArgument_T<S,Insert_Policy>::demarshal (TAO_InputCDR &cdr)
 {
+  TAO::Request_Arena::Guard arena_guard (cdr, TAO::Request_Arena::current ());
   return cdr >> this->x_;
 }
 
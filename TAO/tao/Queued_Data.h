@@ -38,9 +38,10 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
  * to the higher layers of the ORB.
  *
  * The ACE_Message_Block contained within this class may contain a chain
- * of message blocks (usually when GIOP fragments are involved).  In that
- * case consolidate () needs to be called prior to being sent to higher
- * layers of the ORB when the GIOP fragment chain is complete.
+ * of message blocks (usually when GIOP fragments are involved).  The
+ * input CDR stream handed to the higher layers of the ORB reads the
+ * chain in place; consolidate () copies it into one block for the
+ * cases that need a contiguous message, like decompression.
  */
 class TAO_Export TAO_Queued_Data
 {
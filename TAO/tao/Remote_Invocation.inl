@@ -21,6 +21,13 @@ namespace TAO
   void
   Remote_Invocation::marshal_data (TAO_OutputCDR &out_stream)
   {
+    // Put the arguments in one block if the stub told us their size.
+    size_t const hint = this->details_.marshal_size_hint ();
+    if (hint != 0 && out_stream.reserve (hint) != 0)
+      {
+        throw ::CORBA::NO_MEMORY ();
+      }
+
     // Marshal application data
     if (this->details_.marshal_args (out_stream) == false)
       {
@@ -0,0 +1,193 @@
+// -*- C++ -*-
+#include "tao/Request_Arena.h"
+#include "tao/TSS_Resources.h"
+#include "tao/TAO_Server_Request.h"
+#include "tao/ORB_Core.h"
+#include "ace/OS_Memory.h"
+
+#if !defined (__ACE_INLINE__)
+# include "tao/Request_Arena.inl"
+#endif /* ! __ACE_INLINE__ */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Set once an ORB uses arenas, so that CORBA::string_free() only
+  /// looks up the arenas of the thread in the processes that may have
+  /// some.  It is only written by ORB_init(), the requests just read
+  /// it.
+  bool arenas_enabled = false;
+}
+
+namespace TAO
+{
+  Request_Arena::Request_Arena (size_t chunk_size)
+    : chunk_size_ (chunk_size),
+      chunks_ (0),
+      ptr_ (0),
+      end_ (0),
+      previous_ (0)
+  {
+  }
+
+  Request_Arena::~Request_Arena (void)
+  {
+    while (this->chunks_ != 0)
+      {
+        Chunk *const next = this->chunks_->next_;
+        delete [] reinterpret_cast<char *> (this->chunks_);
+        this->chunks_ = next;
+      }
+  }
+
+  char *
+  Request_Arena::data (Chunk *chunk)
+  {
+    return reinterpret_cast<char *> (chunk)
+      + ACE_align_binary (sizeof (Chunk), ACE_CDR::MAX_ALIGNMENT);
+  }
+
+  int
+  Request_Arena::grow (size_t nbytes)
+  {
+    size_t const header =
+      ACE_align_binary (sizeof (Chunk), ACE_CDR::MAX_ALIGNMENT);
+    size_t const size =
+      header + (nbytes > this->chunk_size_ ? nbytes : this->chunk_size_);
+
+    char *memory = 0;
+    ACE_NEW_RETURN (memory, char[size], -1);
+
+    Chunk *const chunk = reinterpret_cast<Chunk *> (memory);
+    chunk->next_ = this->chunks_;
+    chunk->size_ = size;
+    this->chunks_ = chunk;
+
+    this->ptr_ = Request_Arena::data (chunk);
+    this->end_ = memory + size;
+    return 0;
+  }
+
+  bool
+  Request_Arena::owns (const void *p) const
+  {
+    const char *const cp = static_cast<const char *> (p);
+    for (const Chunk *chunk = this->chunks_; chunk != 0; chunk = chunk->next_)
+      {
+        const char *const start = reinterpret_cast<const char *> (chunk);
+        if (cp >= start && cp < start + chunk->size_)
+          return true;
+      }
+    return false;
+  }
+
+  void
+  Request_Arena::release (void)
+  {
+    Chunk *largest = 0;
+    while (this->chunks_ != 0)
+      {
+        Chunk *chunk = this->chunks_;
+        this->chunks_ = chunk->next_;
+
+        if (largest == 0 || chunk->size_ > largest->size_)
+          {
+            Chunk *const smaller = largest;
+            largest = chunk;
+            chunk = smaller;
+          }
+
+        delete [] reinterpret_cast<char *> (chunk);
+      }
+
+    this->ptr_ = 0;
+    this->end_ = 0;
+
+    if (largest != 0)
+      {
+        largest->next_ = 0;
+        this->chunks_ = largest;
+        this->ptr_ = Request_Arena::data (largest);
+        this->end_ = reinterpret_cast<char *> (largest) + largest->size_;
+      }
+  }
+
+  void
+  Request_Arena::enable (void)
+  {
+    arenas_enabled = true;
+  }
+
+  Request_Arena *
+  Request_Arena::current (void)
+  {
+    if (!arenas_enabled)
+      return 0;
+
+    return TAO_TSS_Resources::instance ()->request_arena_;
+  }
+
+  bool
+  Request_Arena::owned_by_current (const void *p)
+  {
+    for (Request_Arena *arena = Request_Arena::current ();
+         arena != 0;
+         arena = arena->previous_)
+      if (arena->owns (p))
+        return true;
+
+    return false;
+  }
+
+  Request_Arena *
+  Request_Arena::acquire (void)
+  {
+    TAO_TSS_Resources *const tss = TAO_TSS_Resources::instance ();
+
+    // A nested request gets a new arena, as the one of the thread is
+    // still used by the enclosing request.
+    Request_Arena *arena = tss->spare_request_arena_;
+    if (arena != 0)
+      tss->spare_request_arena_ = 0;
+    else
+      ACE_NEW_RETURN (arena, Request_Arena, 0);
+
+    arena->previous_ = tss->request_arena_;
+    tss->request_arena_ = arena;
+    return arena;
+  }
+
+  void
+  Request_Arena::relinquish (Request_Arena *arena)
+  {
+    if (arena == 0)
+      return;
+
+    TAO_TSS_Resources *const tss = TAO_TSS_Resources::instance ();
+
+    tss->request_arena_ = arena->previous_;
+    arena->previous_ = 0;
+    arena->release ();
+
+    if (tss->spare_request_arena_ == 0)
+      tss->spare_request_arena_ = arena;
+    else
+      delete arena;
+  }
+
+  Request_Arena::Upcall_Guard::Upcall_Guard (TAO_ServerRequest &request)
+    : arena_ (request.incoming () != 0
+              && request.orb_core ()->orb_params ()->request_arena ()
+              ? Request_Arena::acquire ()
+              : 0)
+  {
+  }
+
+  Request_Arena::Upcall_Guard::~Upcall_Guard (void)
+  {
+    Request_Arena::relinquish (this->arena_);
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
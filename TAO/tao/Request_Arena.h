@@ -0,0 +1,185 @@
+// -*- C++ -*-
+
+// ===================================================================
+/**
+ *  @file   Request_Arena.h
+ *
+ *  Arena the in arguments of a request are demarshaled into.
+ */
+// ===================================================================
+
+#ifndef TAO_REQUEST_ARENA_H
+#define TAO_REQUEST_ARENA_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/TAO_Export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/orbconf.h"
+#include "tao/CDR.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_ServerRequest;
+
+namespace TAO
+{
+  /**
+   * @class Request_Arena
+   *
+   * @brief Monotonic allocator for the in arguments of a request.
+   *
+   * With -ORBRequestArena each request dispatched to a servant gets an
+   * arena, and its in arguments demarshal their strings and the
+   * buffers of their unbounded sequences of basic types into it
+   * instead of allocating each of them from the heap.  That memory is
+   * never freed piecemeal: CORBA::string_free() leaves alone the
+   * strings of the arenas of the requests the calling thread is
+   * dispatching, and the sequences don't own their buffer.  The arena
+   * is reset in one go once the skeleton of the request returned, on
+   * the thread that dispatched it, and kept by that thread for its
+   * next request.
+   *
+   * The memory of an arena does not outlive the request, so only in
+   * arguments, which the servant gets as const and has to copy to
+   * keep, use it.  Object references, valuetypes, Anys and TypeCodes
+   * can be kept by the servant, so they are demarshaled from the heap
+   * as before.
+   */
+  class TAO_Export Request_Arena
+  {
+  public:
+    /// Create an empty arena, allocating @a chunk_size bytes at a
+    /// time.
+    explicit Request_Arena (
+      size_t chunk_size = TAO_DEFAULT_REQUEST_ARENA_CHUNK_SIZE);
+
+    /// Free all the memory of the arena.
+    ~Request_Arena (void);
+
+    /// Get @a nbytes aligned on @a align bytes, or 0 if out of memory.
+    void *allocate (size_t nbytes, size_t align);
+
+    /// Does @a p point into the memory of the arena?
+    bool owns (const void *p) const;
+
+    /// Make all the memory of the arena available again, keeping only
+    /// its largest chunk.
+    void release (void);
+
+    /// Let current() look for arenas, once an ORB is initialized with
+    /// -ORBRequestArena 1.
+    static void enable (void);
+
+    /// The arena of the innermost request the calling thread is
+    /// dispatching, 0 if there is none.
+    static Request_Arena *current (void);
+
+    /// Is @a p memory of the arena of one of the requests the calling
+    /// thread is dispatching?
+    static bool owned_by_current (const void *p);
+
+    /// Get an arena for a request the calling thread is about to
+    /// dispatch and make it the current one.
+    static Request_Arena *acquire (void);
+
+    /// Give back an arena got from acquire() by the calling thread,
+    /// once its request is done, making the arena of the enclosing
+    /// request, if any, the current one again.
+    static void relinquish (Request_Arena *arena);
+
+    /**
+     * @class Upcall_Guard
+     *
+     * @brief Gives a request an arena for the time its skeleton runs.
+     *
+     * The servant dispatch sets one up around the skeleton, so the
+     * arena is given back on the thread that got it, after the in
+     * arguments are destroyed, whichever thread the request itself is
+     * destroyed on.
+     */
+    class TAO_Export Upcall_Guard
+    {
+    public:
+      /// Get an arena if @a request was received and its ORB uses
+      /// arenas.
+      explicit Upcall_Guard (TAO_ServerRequest &request);
+      ~Upcall_Guard (void);
+
+    private:
+      Request_Arena *const arena_;
+
+      Upcall_Guard (const Upcall_Guard &);
+      void operator= (const Upcall_Guard &);
+    };
+
+    /**
+     * @class Guard
+     *
+     * @brief Sets the arena of a CDR stream for the demarshaling of a
+     * value.
+     *
+     * The in arguments use it with the current arena, the types whose
+     * values may outlive the request with no arena, and the previous
+     * arena of the stream is set back once the value is demarshaled.
+     */
+    class Guard
+    {
+    public:
+      Guard (TAO_InputCDR &cdr, Request_Arena *arena);
+      ~Guard (void);
+
+    private:
+      TAO_InputCDR &cdr_;
+      Request_Arena *const previous_;
+
+      Guard (const Guard &);
+      void operator= (const Guard &);
+    };
+
+  private:
+    /// Add a chunk to fit at least @a nbytes.
+    int grow (size_t nbytes);
+
+    /// Header of a chunk, the memory handed out follows it.
+    struct Chunk
+    {
+      Chunk *next_;
+      size_t size_;
+    };
+
+    /// Start of the memory handed out from @a chunk.
+    static char *data (Chunk *chunk);
+
+    /// Size of the chunks.
+    size_t const chunk_size_;
+
+    /// The chunks, the one memory is handed out from first.
+    Chunk *chunks_;
+
+    /// Free memory of the first chunk.
+    char *ptr_;
+    char *end_;
+
+    /// Arena of the enclosing request, while the arena is the one of
+    /// a request.
+    Request_Arena *previous_;
+
+    Request_Arena (const Request_Arena &);
+    void operator= (const Request_Arena &);
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+# include "tao/Request_Arena.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_REQUEST_ARENA_H */
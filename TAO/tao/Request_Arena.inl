@@ -0,0 +1,36 @@
+// -*- C++ -*-
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  ACE_INLINE void *
+  Request_Arena::allocate (size_t nbytes, size_t align)
+  {
+    char *p = ACE_ptr_align_binary (this->ptr_, align);
+    if (this->chunks_ == 0 || p + nbytes > this->end_)
+      {
+        if (this->grow (nbytes + align) == -1)
+          return 0;
+        p = ACE_ptr_align_binary (this->ptr_, align);
+      }
+
+    this->ptr_ = p + nbytes;
+    return p;
+  }
+
+  ACE_INLINE
+  Request_Arena::Guard::Guard (TAO_InputCDR &cdr, Request_Arena *arena)
+    : cdr_ (cdr),
+      previous_ (cdr.arena ())
+  {
+    cdr.arena (arena);
+  }
+
+  ACE_INLINE
+  Request_Arena::Guard::~Guard (void)
+  {
+    this->cdr_.arena (this->previous_);
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,55 @@
+#ifndef guard_sequence_cdr_size
+#define guard_sequence_cdr_size
+/**
+ * @file
+ *
+ * @brief Compute the CDR size of the sequences
+ *
+ * The stubs generated with -Gsz compute the size of the in arguments
+ * with an ACE_SizeCDR before they are marshaled.  The sequences of
+ * basic types, strings and of the types for which tao_idl generated
+ * an ACE_SizeCDR insertion operator are handled here, whether they
+ * were declared in application or in ORB IDL.
+ */
+
+#include "ace/CDR_Size.h"
+
+#include "tao/Sequence_T.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO {
+  template <typename value_t>
+  bool operator<< (ACE_SizeCDR & strm, const TAO::unbounded_value_sequence <value_t> & source) {
+    return TAO::marshal_sequence (strm, source);
+  }
+
+  template <typename charT>
+  bool operator<< (ACE_SizeCDR & strm, const TAO::unbounded_basic_string_sequence <charT> & source) {
+    return TAO::marshal_sequence (strm, source);
+  }
+
+  template <typename charT, CORBA::ULong BD_STR_MAX>
+  bool operator<< (ACE_SizeCDR & strm, const TAO::unbounded_bd_string_sequence <charT, BD_STR_MAX> & source) {
+    return TAO::marshal_sequence (strm, source);
+  }
+
+  template <typename value_t, CORBA::ULong MAX>
+  bool operator<< (ACE_SizeCDR & strm, const TAO::bounded_value_sequence <value_t, MAX> & source) {
+    return TAO::marshal_sequence (strm, source);
+  }
+
+  template <typename charT, CORBA::ULong MAX>
+  bool operator<< (ACE_SizeCDR & strm, const TAO::bounded_basic_string_sequence <charT, MAX> & source) {
+    return TAO::marshal_sequence (strm, source);
+  }
+
+  template <typename charT, CORBA::ULong MAX, CORBA::ULong BD_STR_MAX>
+  bool operator<< (ACE_SizeCDR & strm, const TAO::bounded_bd_string_sequence <charT, MAX, BD_STR_MAX> & source) {
+    return TAO::marshal_sequence (strm, source);
+  }
+} // namespace TAO
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* guard_sequence_cdr_size */
@@ -17,6 +17,8 @@
 #include "tao/Resume_Handle.h"
 #include "tao/GIOP_Message_Base.h"
 
+#include "ace/Dgram_Batch.h"
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 TAO_DIOP_Transport::TAO_DIOP_Transport (TAO_DIOP_Connection_Handler *handler,
@@ -25,11 +27,13 @@ TAO_DIOP_Transport::TAO_DIOP_Transport (TAO_DIOP_Connection_Handler *handler,
                    orb_core,
                    ACE_MAX_DGRAM_SIZE)
   , connection_handler_ (handler)
+  , recv_batch_ (0)
 {
 }
 
 TAO_DIOP_Transport::~TAO_DIOP_Transport (void)
 {
+  delete this->recv_batch_;
 }
 
 ACE_Event_Handler *
@@ -120,9 +124,87 @@ int
 TAO_DIOP_Transport::handle_input (TAO_Resume_Handle &rh,
                                   ACE_Time_Value *max_wait_time)
 {
-  // If there are no messages then we can go ahead to read from the
-  // handle for further reading..
+  // Only one thread at a time receives a burst of datagrams into the
+  // batch; other threads, and upcalls nested in the processing of a
+  // burst, read a single datagram.
+  // FUZZ: disable check_for_ACE_Guard
+  ACE_Guard<TAO_SYNCH_MUTEX> batch_guard (this->recv_batch_lock_, 0); // tryacquire
+  // FUZZ: enable check_for_ACE_Guard
+  if (!batch_guard.locked ())
+    return this->handle_input_i (rh, max_wait_time);
+
+  if (this->recv_batch_ == 0)
+    {
+      ACE_NEW_RETURN (this->recv_batch_,
+                      ACE_Dgram_Batch (ACE_DEFAULT_DGRAM_BATCH_SIZE,
+                                       ACE_MAX_DGRAM_SIZE
+                                       + ACE_CDR::MAX_ALIGNMENT),
+                      -1);
+
+      for (size_t i = 0; i < this->recv_batch_->capacity (); ++i)
+        this->recv_batch_->buffer (
+          i,
+          ACE_ptr_align_binary (this->recv_batch_->data (i),
+                                ACE_CDR::MAX_ALIGNMENT),
+          ACE_MAX_DGRAM_SIZE);
+    }
+
+  ACE_Dgram_Batch &batch = *this->recv_batch_;
+  ssize_t const count = this->connection_handler_->peer ().recv (batch);
+
+  if (count == -1)
+    {
+      if (TAO_debug_level > 4)
+        {
+          TAOLIB_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - DIOP_Transport::handle_input, %p\n"),
+                      ACE_TEXT ("TAO - read message failure ")
+                      ACE_TEXT ("recv ()\n")));
+        }
+
+      if (errno == EWOULDBLOCK)
+        return 0;
+
+      this->tms_->connection_closed ();
+      return -1;
+    }
+
+  for (size_t i = 0; i < static_cast<size_t> (count); ++i)
+    {
+      ACE_INET_Addr from_addr;
+      batch.addr (i, from_addr);
 
+      if (TAO_debug_level > 0)
+        {
+          TAOLIB_DEBUG ((LM_DEBUG,
+                      "TAO (%P|%t) - DIOP_Transport::handle_input, received %B bytes from %C:%d\n",
+                      batch.length (i),
+                      from_addr.get_host_name (),
+                      from_addr.get_port_number ()));
+        }
+
+      // A datagram without data is a read failure, as for recv ().
+      if (batch.length (i) == 0)
+        {
+          this->tms_->connection_closed ();
+          return -1;
+        }
+
+      // Remember the from addr to eventually use it as remote
+      // addr for the reply.
+      this->connection_handler_->addr (from_addr);
+
+      if (this->process_datagram (batch.data (i), batch.length (i), rh) == -1)
+        return -1;
+    }
+
+  return 0;
+}
+
+int
+TAO_DIOP_Transport::handle_input_i (TAO_Resume_Handle &rh,
+                                    ACE_Time_Value *max_wait_time)
+{
   // The buffer on the stack which will be used to hold the input
   // messages
   char buf [ACE_MAX_DGRAM_SIZE + ACE_CDR::MAX_ALIGNMENT];
@@ -133,30 +215,12 @@ TAO_DIOP_Transport::handle_input (TAO_Resume_Handle &rh,
                          sizeof buf);
 #endif /* ACE_INITIALIZE_MEMORY_BEFORE_USE */
 
-  // Create a data block
-  ACE_Data_Block db (sizeof (buf),
-                     ACE_Message_Block::MB_DATA,
-                     buf,
-                     this->orb_core_->input_cdr_buffer_allocator (),
-                     this->orb_core_->locking_strategy (),
-                     ACE_Message_Block::DONT_DELETE,
-                     this->orb_core_->input_cdr_dblock_allocator ());
-
-  // Create a message block
-  ACE_Message_Block message_block (&db,
-                                   ACE_Message_Block::DONT_DELETE,
-                                   this->orb_core_->input_cdr_msgblock_allocator ());
-
+  char *const aligned_buf = ACE_ptr_align_binary (buf, ACE_CDR::MAX_ALIGNMENT);
 
-  // Align the message block
-  ACE_CDR::mb_align (&message_block);
-
-
-  // Read the message into the  message block that we have created on
-  // the stack.
-  ssize_t n = this->recv (message_block.rd_ptr (),
-                          message_block.space (),
-                          max_wait_time);
+  // Read the message into the stack buffer.
+  ssize_t const n = this->recv (aligned_buf,
+                                ACE_MAX_DGRAM_SIZE,
+                                max_wait_time);
 
   // If there is an error return to the reactor..
   if (n <= 0)
@@ -169,7 +233,29 @@ TAO_DIOP_Transport::handle_input (TAO_Resume_Handle &rh,
       return static_cast<int> (n);
     }
 
-  // Set the write pointer in the stack buffer
+  return this->process_datagram (aligned_buf, n, rh);
+}
+
+int
+TAO_DIOP_Transport::process_datagram (char *buf,
+                                      size_t n,
+                                      TAO_Resume_Handle &rh)
+{
+  // Create a data block
+  ACE_Data_Block db (n,
+                     ACE_Message_Block::MB_DATA,
+                     buf,
+                     this->orb_core_->input_cdr_buffer_allocator (),
+                     this->orb_core_->locking_strategy (),
+                     ACE_Message_Block::DONT_DELETE,
+                     this->orb_core_->input_cdr_dblock_allocator ());
+
+  // Create a message block
+  ACE_Message_Block message_block (&db,
+                                   ACE_Message_Block::DONT_DELETE,
+                                   this->orb_core_->input_cdr_msgblock_allocator ());
+
+  // Set the write pointer in the buffer
   message_block.wr_ptr (n);
 
   // Make a node of the message block..
@@ -30,6 +30,10 @@
 template class TAO_Strategies_Export ACE_Svc_Handler<ACE_SOCK_DGRAM, ACE_NULL_SYNCH>;
 #endif /* ACE_HAS_EXPLICIT_TEMPLATE_INSTANTIATION_EXPORT */
 
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Dgram_Batch;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // Forward decls.
@@ -102,9 +106,26 @@ public:
 
 private:
 
+  /// Read and process a single datagram.
+  int handle_input_i (TAO_Resume_Handle &rh,
+                      ACE_Time_Value *max_wait_time);
+
+  /// Parse and process the datagram of @a n bytes at @a buf, which
+  /// must be aligned on ACE_CDR::MAX_ALIGNMENT.
+  int process_datagram (char *buf,
+                        size_t n,
+                        TAO_Resume_Handle &rh);
+
   /// The connection service handler used for accessing lower layer
   /// communication protocols.
   TAO_DIOP_Connection_Handler *connection_handler_;
+
+  /// Bursts of datagrams are received into this batch, allocated on
+  /// the first input.
+  ACE_Dgram_Batch *recv_batch_;
+
+  /// Only one thread at a time receives into @c recv_batch_.
+  TAO_SYNCH_MUTEX recv_batch_lock_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
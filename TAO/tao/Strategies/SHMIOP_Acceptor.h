@@ -85,6 +85,10 @@ public:
   int set_mmap_options (const ACE_TCHAR *prefix,
                         ACE_OFF_T size);
 
+  /// Use the rings of ACE_Ring_MEM_IO instead of ACE_MT_MEM_IO for
+  /// the connections the server threads block on.
+  void use_ring (bool use_ring);
+
 private:
   /// Implement the common part of the open*() methods.
   int open_i (TAO_ORB_Core* orb_core,
@@ -136,6 +140,10 @@ private:
   /// Determine the minimum size of mmap file.  This dictate the
   /// maximum size of a CORBA method invocation.
   ACE_OFF_T mmap_size_;
+
+  /// Whether the connections prefer ACE_MEM_IO::Ring to
+  /// ACE_MEM_IO::MT.
+  bool use_ring_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -19,7 +19,8 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 TAO_SHMIOP_Connector::TAO_SHMIOP_Connector (void)
   : TAO_Connector (TAO_TAG_SHMEM_PROFILE),
     connect_strategy_ (),
-    base_connector_ (0)
+    base_connector_ (0),
+    use_ring_ (false)
 {
 }
 
@@ -65,12 +66,20 @@ TAO_SHMIOP_Connector::open (TAO_ORB_Core *orb_core)
   else if (orb_core->client_factory ()->allow_callback () == 0)
 
     {
-      this->base_connector_.connector ().preferred_strategy (ACE_MEM_IO::MT);
-      this->connect_strategy_.connector ().preferred_strategy (ACE_MEM_IO::MT);
+      ACE_MEM_IO::Signal_Strategy const strategy =
+        this->use_ring_ ? ACE_MEM_IO::Ring : ACE_MEM_IO::MT;
+      this->base_connector_.connector ().preferred_strategy (strategy);
+      this->connect_strategy_.connector ().preferred_strategy (strategy);
     }
   return 0;
 }
 
+void
+TAO_SHMIOP_Connector::use_ring (bool use_ring)
+{
+  this->use_ring_ = use_ring;
+}
+
 int
 TAO_SHMIOP_Connector::close (void)
 {
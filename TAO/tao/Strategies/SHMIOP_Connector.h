@@ -71,6 +71,10 @@ public:
   virtual char object_key_delimiter (void) const;
   //@}
 
+  /// Use the rings of ACE_Ring_MEM_IO instead of ACE_MT_MEM_IO when
+  /// the client blocks on read.
+  void use_ring (bool use_ring);
+
 public:
 
   typedef TAO_Connect_Concurrency_Strategy<TAO_SHMIOP_Connection_Handler>
@@ -121,6 +125,10 @@ private:
 
   /// The connector initiating connection requests for SHMIOP.
   TAO_SHMIOP_BASE_CONNECTOR base_connector_;
+
+  /// Whether the connections prefer ACE_MEM_IO::Ring to
+  /// ACE_MEM_IO::MT.
+  bool use_ring_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -18,7 +18,8 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 TAO_SHMIOP_Protocol_Factory::TAO_SHMIOP_Protocol_Factory (void)
   : TAO_Protocol_Factory (TAO_TAG_SHMEM_PROFILE),
     mmap_prefix_ (0),
-    min_bytes_ (10*1024)        // @@ Nanbor, remove this magic number!!
+    min_bytes_ (10*1024),       // @@ Nanbor, remove this magic number!!
+    use_ring_ (false)
 {
 }
 
@@ -57,6 +58,7 @@ TAO_SHMIOP_Protocol_Factory::make_acceptor (void)
 
   acceptor->set_mmap_options (this->mmap_prefix_,
                               this->min_bytes_);
+  acceptor->use_ring (this->use_ring_);
 
   return acceptor;
 }
@@ -84,6 +86,11 @@ TAO_SHMIOP_Protocol_Factory::init (int argc,
           this->mmap_prefix_ = ACE::strnew (current_arg);
           arg_shifter.consume_arg ();
         }
+      else if (0 != (current_arg = arg_shifter.get_the_parameter (ACE_TEXT("-MMAPRing"))))
+        {
+          this->use_ring_ = ACE_OS::atoi (current_arg) != 0;
+          arg_shifter.consume_arg ();
+        }
       else
         // Any arguments that don't match are ignored so that the
         // caller can still use them.
@@ -96,11 +103,14 @@ TAO_SHMIOP_Protocol_Factory::init (int argc,
 TAO_Connector *
 TAO_SHMIOP_Protocol_Factory::make_connector (void)
 {
-  TAO_Connector *connector = 0;
+  TAO_SHMIOP_Connector *connector = 0;
 
   ACE_NEW_RETURN (connector,
                   TAO_SHMIOP_Connector,
                   0);
+
+  connector->use_ring (this->use_ring_);
+
   return connector;
 }
 
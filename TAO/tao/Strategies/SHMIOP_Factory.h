@@ -78,6 +78,10 @@ private:
 
   /// Minimum bytes of the mmap files.
   ACE_OFF_T min_bytes_;
+
+  /// Pass the data through the lock-free rings of ACE_Ring_MEM_IO
+  /// where the connections block on read.
+  bool use_ring_;
 };
 
 
@@ -29,6 +29,7 @@
 #include "ace/Msg_WFMO_Reactor.h"
 #include "ace/TP_Reactor.h"
 #include "ace/Dev_Poll_Reactor.h"
+#include "ace/Uring_Reactor.h"
 #include "ace/Malloc_T.h"
 #include "ace/Local_Memory_Pool.h"
 #include "ace/Null_Mutex.h"
@@ -188,6 +189,16 @@ TAO_Advanced_Resource_Factory::init (int argc, ACE_TCHAR** argv)
 #endif  /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
             }
 
+          else if (ACE_OS::strcasecmp (current_arg,
+                                       ACE_TEXT("uring")) == 0)
+            {
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_EVENT_POLL)
+              this->reactor_type_ = TAO_REACTOR_URING;
+#else
+              this->report_unsupported_error (ACE_TEXT ("Uring Reactor"));
+#endif  /* ACE_HAS_IO_URING && ACE_HAS_EVENT_POLL */
+            }
+
           else if (ACE_OS::strcasecmp (current_arg,
                                        ACE_TEXT("fl")) == 0)
             this->report_option_value_error (
@@ -481,6 +492,21 @@ TAO_Advanced_Resource_Factory::allocate_reactor_impl (void) const
       break;
 #endif  /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
 
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_EVENT_POLL)
+    case TAO_REACTOR_URING:
+      ACE_NEW_RETURN (impl,
+                      ACE_Uring_Reactor (ACE::max_handles (),
+                                         1,  // restart
+                                         (ACE_Sig_Handler*)0,
+                                         tmq.get (),
+                                         0, // Do not disable notify
+                                         0, // Allocate notify handler
+                                         this->reactor_mask_signals_,
+                                         ACE_Select_Reactor_Token::LIFO),
+                      0);
+      break;
+#endif  /* ACE_HAS_IO_URING && ACE_HAS_EVENT_POLL */
+
     default:
     case TAO_REACTOR_TP:
       ACE_NEW_RETURN (impl,
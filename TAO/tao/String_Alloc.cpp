@@ -1,5 +1,6 @@
 // -*- C++ -*-
 #include "tao/String_Alloc.h"
+#include "tao/Request_Arena.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_wchar.h"
 #include "ace/OS_Memory.h"
@@ -60,9 +61,13 @@ void
 CORBA::string_free (char *str)
 {
 #ifndef TAO_NO_SHARED_NULL_CORBA_STRING
-  if (null_char != str)
+  if (null_char == str)
+    return;
 #endif /* TAO_NO_SHARED_NULL_CORBA_STRING */
-  delete [] str;
+
+  // Strings demarshaled into the arena of a request go with it.
+  if (!TAO::Request_Arena::owned_by_current (str))
+    delete [] str;
 }
 
 // ****************************************************************
@@ -1,5 +1,6 @@
 #include "tao/TSS_Resources.h"
 #include "tao/GUIResource_Factory.h"
+#include "tao/Request_Arena.h"
 #include "tao/TAO_Singleton.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -20,12 +21,15 @@ TAO_TSS_Resources::TAO_TSS_Resources (void)
 #if (TAO_HAS_TRANSPORT_CURRENT == 1)
   , tsg_ (0)
 #endif /* TAO_HAS_TRANSPORT_CURRENT */
+  , request_arena_ (0)
+  , spare_request_arena_ (0)
 {
 }
 
 TAO_TSS_Resources::~TAO_TSS_Resources (void)
 {
   delete this->gui_resource_factory_;
+  delete this->spare_request_arena_;
 }
 
 TAO_TSS_Resources *
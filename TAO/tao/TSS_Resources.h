@@ -32,6 +32,7 @@ namespace TAO
 {
   class GUIResource_Factory;
   class Transport_Selection_Guard;
+  class Request_Arena;
 }
 /**
  * @class TAO_TSS_Resources
@@ -119,6 +120,13 @@ public:
   TAO::Transport_Selection_Guard* tsg_;
 
 #endif  /* TAO_HAS_TRANSPORT_CURRENT == 1 */
+
+  /// The arena of the innermost request with one the thread is
+  /// dispatching, see TAO::Request_Arena.
+  TAO::Request_Arena *request_arena_;
+
+  /// An arena kept for the next request the thread dispatches.
+  TAO::Request_Arena *spare_request_arena_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -92,6 +92,13 @@ TAO_Tagged_Profile::unmarshall_object_key_i (TAO_InputCDR &input)
   CORBA::Long key_length = 0;
   hdr_status = hdr_status && input.read_long (key_length);
 
+  // The key is used in place, it must not straddle two fragments.
+  if (hdr_status
+      && static_cast<size_t> (key_length) > input.start ()->length ())
+    {
+      hdr_status = input.consolidate () == 0;
+    }
+
   if (hdr_status)
     {
       this->object_key_.replace (key_length,
@@ -154,6 +161,13 @@ TAO_Tagged_Profile::unmarshall_ref_addr_i (TAO_InputCDR &input)
   CORBA::Long id_length = 0;
   hdr_status = hdr_status && input.read_long (id_length);
 
+  // The type_id is used in place, it must not straddle two fragments.
+  if (hdr_status
+      && static_cast<size_t> (id_length) > input.start ()->length ())
+    {
+      hdr_status = input.consolidate () == 0;
+    }
+
   if (hdr_status)
     {
       // Set the type_id (it is not owned by this object)
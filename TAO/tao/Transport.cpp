@@ -25,6 +25,7 @@
 #include "tao/Transport_Descriptor_Interface.h"
 #include "tao/ORB_Time_Policy.h"
 
+#include "ace/OS_NS_sys_sendfile.h"
 #include "ace/OS_NS_sys_time.h"
 #include "ace/OS_NS_stdio.h"
 #include "ace/Reactor.h"
@@ -481,15 +482,79 @@ TAO_Transport::sendfile (TAO_MMAP_Allocator * /* allocator */,
                          TAO::Transport::Drain_Constraints const & dc)
 {
   // Concrete pluggable transport doesn't implement sendfile().
-  // Fallback on TAO_Transport::send().
-
-  // @@ We can probably refactor the TAO_IIOP_Transport::sendfile()
-  //    implementation to this base class method, and leave any TCP
-  //    specific configuration out of this base class method.
-  //      -Ossama
+  // Fallback on TAO_Transport::send().  The ones that write to a
+  // socket implement it with sendfile_i().
   return this->send (iov, iovcnt, bytes_transferred,
                      this->io_timeout (dc));
 }
+
+ssize_t
+TAO_Transport::sendfile_i (TAO_MMAP_Allocator * allocator,
+                           ACE_HANDLE out_fd,
+                           iovec * iov,
+                           int iovcnt,
+                           size_t &bytes_transferred,
+                           TAO::Transport::Drain_Constraints const & dc)
+{
+  // We can only use sendfile when all data is coming from the mmap allocator,
+  // if not, we just fallback to to the regular way of sending data
+  iovec * const off_check_begin = iov;
+  iovec * const off_check_end   = iov + iovcnt;
+  for (iovec * index = off_check_begin; index != off_check_end; ++index)
+    {
+      if (-1 == allocator->offset (index->iov_base))
+        return this->send (iov, iovcnt, bytes_transferred,
+                           this->io_timeout (dc));
+    }
+
+  ssize_t retval = -1;
+
+  ACE_HANDLE const in_fd = allocator->handle ();
+
+  if (in_fd == ACE_INVALID_HANDLE)
+    return retval;
+
+  iovec * const begin = iov;
+  iovec * const end   = iov + iovcnt;
+  for (iovec * i = begin; i != end; ++i)
+    {
+      off_t offset = allocator->offset (i->iov_base);
+
+      if (this->io_timeout (dc))
+        {
+          int val = 0;
+          if (ACE::enter_send_timedwait (out_fd,
+                                         this->io_timeout (dc), val) == -1)
+            return retval;
+          else
+            {
+              retval =
+                ACE_OS::sendfile (out_fd, in_fd, &offset, i->iov_len);
+              ACE::restore_non_blocking_mode (out_fd, val);
+            }
+        }
+      else
+        {
+          retval = ACE_OS::sendfile (out_fd, in_fd, &offset, i->iov_len);
+        }
+
+      if (retval <= 0)  // Report errors below.
+        break;
+
+      bytes_transferred += static_cast<size_t> (retval);
+    }
+
+  if (retval <= 0 && TAO_debug_level > 4)
+    {
+      TAOLIB_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("TAO (%P|%t) - Transport[%d]::sendfile, ")
+                  ACE_TEXT ("sendfile failure - %m (errno: %d)\n"),
+                  this->id (),
+                  ACE_ERRNO_GET));
+    }
+
+  return retval;
+}
 #endif  /* TAO_HAS_SENDFILE==1 */
 
 int
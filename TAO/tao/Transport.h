@@ -814,6 +814,19 @@ protected:
   ACE_Time_Value const *io_timeout(
       TAO::Transport::Drain_Constraints const & dc) const;
 
+#if TAO_HAS_SENDFILE == 1
+  /// Send the I/O vector with sendfile() from the file of @a allocator
+  /// to @a out_fd, for the transports that implement sendfile() on a
+  /// socket.  Falls back to send() when some of the data doesn't come
+  /// from @a allocator.
+  ssize_t sendfile_i (TAO_MMAP_Allocator * allocator,
+                      ACE_HANDLE out_fd,
+                      iovec * iov,
+                      int iovcnt,
+                      size_t &bytes_transferred,
+                      TAO::Transport::Drain_Constraints const & dc);
+#endif  /* TAO_HAS_SENDFILE==1 */
+
 public:
   /// Format and queue a message for @a stream
   /// @param max_wait_time The maximum time that the operation can
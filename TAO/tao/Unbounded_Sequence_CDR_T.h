@@ -12,10 +12,35 @@
 #include "tao/orbconf.h"
 #include "tao/CORBA_String.h"
 #include "tao/SystemException.h"
+#include "tao/Request_Arena.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace TAO {
+  /// Give @a tmp a buffer of @a new_length elements to demarshal into,
+  /// from the arena of @a strm if it has one.  The sequence doesn't
+  /// own such a buffer, it goes with the arena.  The buffer is aligned
+  /// on @a align bytes, a power of two which defaults to the size of
+  /// the basic types.
+  template <typename stream, typename sequence>
+  typename sequence::value_type * demarshal_buffer(stream & strm, sequence & tmp, ::CORBA::ULong new_length,
+                                                   size_t align = sizeof(typename sequence::value_type)) {
+    typedef typename sequence::value_type value_type;
+    TAO::Request_Arena * const arena = strm.arena();
+    if (arena != 0 && new_length != 0) {
+      value_type * const buffer = static_cast<value_type *> (
+        arena->allocate(new_length * sizeof(value_type), align));
+      if (buffer != 0) {
+        tmp.replace(new_length, new_length, buffer, false);
+        return buffer;
+      }
+    }
+    sequence heap(new_length);
+    heap.length(new_length);
+    heap.swap(tmp);
+    return tmp.get_buffer();
+  }
+
   template <typename stream>
   bool demarshal_sequence(stream & strm, unbounded_value_sequence <CORBA::Short> & target) {
     typedef TAO::unbounded_value_sequence <CORBA::Short> sequence;
@@ -26,9 +51,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_short_array (buffer, new_length)) {
       return false;
     }
@@ -46,9 +71,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_long_array (buffer, new_length)) {
       return false;
     }
@@ -66,9 +91,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_ulong_array (buffer, new_length)) {
       return false;
     }
@@ -86,9 +111,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_ushort_array (buffer, new_length)) {
       return false;
     }
@@ -107,9 +132,11 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    if (ACE_BIT_DISABLED (strm.start ()->flags (), ACE_Message_Block::DONT_DELETE))
+    sequence tmp;
+    // The sequence would take the whole chain of a chained stream,
+    // share the octets only if the stream is a single block.
+    if (ACE_BIT_DISABLED (strm.start ()->flags (), ACE_Message_Block::DONT_DELETE)
+        && strm.start ()->cont () == 0)
     {
       TAO_ORB_Core* orb_core = strm.orb_core ();
       if (orb_core != 0 && strm.orb_core ()->resource_factory ()->
@@ -122,7 +149,8 @@ namespace TAO {
         return true;
       }
     }
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_octet_array (buffer, new_length)) {
       return false;
     }
@@ -140,9 +168,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_octet_array (buffer, new_length)) {
       return false;
     }
@@ -161,9 +189,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_char_array (buffer, new_length)) {
       return false;
     }
@@ -182,9 +210,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_wchar_array (buffer, new_length)) {
       return false;
     }
@@ -203,9 +231,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_float_array (buffer, new_length)) {
       return false;
     }
@@ -223,9 +251,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_double_array (buffer, new_length)) {
       return false;
     }
@@ -243,9 +271,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_longlong_array (buffer, new_length)) {
       return false;
     }
@@ -263,9 +291,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_ulonglong_array (buffer, new_length)) {
       return false;
     }
@@ -283,9 +311,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_longdouble_array (buffer, new_length)) {
       return false;
     }
@@ -303,9 +331,9 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
-    sequence tmp(new_length);
-    tmp.length(new_length);
-    typename sequence::value_type * buffer = tmp.get_buffer();
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length);
     if (!strm.read_boolean_array (buffer, new_length)) {
       return false;
     }
@@ -335,6 +363,38 @@ namespace TAO {
     return true;
   }
 
+  /// Demarshal a sequence of structs whose C++ layout is their CDR
+  /// encoding, @a cdr_size bytes aligned on @a align, with one copy.
+  /// Falls back to the elementwise path when the bytes must be swapped,
+  /// char members must go through the char translator of @a strm, or
+  /// the compiler laid the struct out differently.
+  template <typename stream, typename value_t>
+  bool demarshal_pod_sequence(stream & strm, TAO::unbounded_value_sequence <value_t> & target, size_t cdr_size, size_t align) {
+    typedef TAO::unbounded_value_sequence <value_t> sequence;
+    if (strm.do_byte_swap() || strm.char_translator() != 0 ||
+        sizeof(value_t) != cdr_size) {
+      return demarshal_sequence(strm, target);
+    }
+    ::CORBA::ULong new_length = 0;
+    if (!(strm >> new_length)) {
+      return false;
+    }
+    if (new_length > strm.length() / sizeof(value_t)) {
+      return false;
+    }
+    sequence tmp;
+    typename sequence::value_type * buffer =
+      demarshal_buffer(strm, tmp, new_length, align);
+    if (new_length != 0 &&
+        (strm.align_read_ptr(align) != 0 ||
+         !strm.read_octet_array(reinterpret_cast<CORBA::Octet *> (buffer),
+                                new_length * sizeof(value_t)))) {
+      return false;
+    }
+    tmp.swap(target);
+    return true;
+  }
+
   template <typename stream, typename charT>
   bool demarshal_sequence(stream & strm, TAO::unbounded_basic_string_sequence <charT> & target) {
     typedef TAO::unbounded_basic_string_sequence <charT> sequence;
@@ -568,6 +628,27 @@ namespace TAO {
     return true;
   }
 
+  /// Marshal a sequence of structs whose C++ layout is their CDR
+  /// encoding with one copy, see demarshal_pod_sequence().
+  template <typename stream, typename value_t>
+  bool marshal_pod_sequence(stream & strm, const TAO::unbounded_value_sequence <value_t> & source, size_t cdr_size, size_t align) {
+    if (strm.do_byte_swap() || strm.char_translator() != 0 ||
+        sizeof(value_t) != cdr_size) {
+      return marshal_sequence(strm, source);
+    }
+    ::CORBA::ULong const length = source.length ();
+    if (!(strm << length)) {
+      return false;
+    }
+    if (length == 0) {
+      return true;
+    }
+    return strm.align_write_ptr(align) == 0 &&
+      strm.write_octet_array(
+        reinterpret_cast<const CORBA::Octet *> (source.get_buffer ()),
+        length * sizeof(value_t));
+  }
+
   template <typename stream, typename charT>
   bool marshal_sequence(stream & strm, const TAO::unbounded_basic_string_sequence <charT> & source) {
     ::CORBA::ULong const length = source.length ();
@@ -9,6 +9,7 @@
 #include "tao/Profile.h"
 #include "tao/debug.h"
 #include "tao/CDR.h"
+#include "tao/Request_Arena.h"
 
 #if !defined (__ACE_INLINE__)
 # include "tao/Valuetype/AbstractBase.inl"
@@ -233,6 +234,10 @@ operator<< (TAO_OutputCDR &strm, const CORBA::AbstractBase_ptr abs)
 CORBA::Boolean
 operator>> (TAO_InputCDR &strm, CORBA::AbstractBase_ptr &abs)
 {
+  // The object or value may be kept by the servant, beyond the arena
+  // of the request.
+  TAO::Request_Arena::Guard arena_guard (strm, 0);
+
   abs = 0;
   CORBA::Boolean discriminator = false;
   ACE_InputCDR::to_boolean tb (discriminator);
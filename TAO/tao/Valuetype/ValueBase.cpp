@@ -214,6 +214,11 @@ CORBA::ValueBase::_tao_unmarshal_pre (
   CORBA::Boolean &is_null_object,
   CORBA::Boolean &is_indirected)
 {
+  // Valuetypes are reference counted, so neither the value nor the
+  // rest of the argument it is part of are demarshaled into the arena
+  // of the request.
+  strm.arena (0);
+
   // %! yet much to do ... look for +++ !
 
   // 1. Get the <value-tag> (else it may be <indirection-tag> or <null-ref>).
@@ -238,6 +243,13 @@ CORBA::ValueBase::_tao_unmarshal_pre (
 
   CORBA::Boolean is_chunked = false;
 
+  // Indirections and chunks are tracked by their position in the
+  // stream, which must therefore be contiguous from here on.
+  if (strm.consolidate () != 0)
+    {
+      return false;
+    }
+
   // Save the position of the start of the ValueType
   // to allow caching for later indirection.
   if (strm.align_read_ptr (ACE_CDR::LONG_SIZE))
@@ -476,6 +488,13 @@ CORBA::ValueBase::_tao_validate_box_type (TAO_InputCDR &strm,
   null_object = false;
   is_indirected = false;
 
+  // An indirection is an offset from the rd_ptr(), see
+  // _tao_unmarshal_pre().
+  if (strm.consolidate () != 0)
+    {
+      return false;
+    }
+
   if (!strm.read_long (value_tag))
     {
       return false;
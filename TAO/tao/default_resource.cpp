@@ -23,6 +23,10 @@
 #include "ace/Malloc.h"
 #include "ace/Reactor.h"
 #include "ace/Malloc_T.h"
+#include "ace/TSS_Cached_Allocator_T.h"
+#include "ace/Slab_Allocator_T.h"
+#include "ace/Message_Block.h"
+#include "ace/CDR_Base.h"
 #include "ace/Local_Memory_Pool.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_strings.h"
@@ -122,6 +126,8 @@ TAO_Default_Resource_Factory::TAO_Default_Resource_Factory (void)
 #else
   , use_local_memory_pool_ (false)
 #endif
+  , use_tss_cached_allocator_ (false)
+  , use_slab_allocator_ (false)
   , cached_connection_lock_type_ (TAO_THREAD_LOCK)
 #if defined (TAO_USE_BLOCKING_FLUSHING)
   , flushing_strategy_type_ (TAO_BLOCKING_FLUSHING)
@@ -465,6 +471,16 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
               {
                 this->output_cdr_allocator_type_ = LOCAL_MEMORY_POOL;
               }
+            else if (ACE_OS::strcasecmp (current_arg,
+                                         ACE_TEXT("tss")) == 0)
+              {
+                this->output_cdr_allocator_type_ = TSS_CACHED_ALLOCATOR;
+              }
+            else if (ACE_OS::strcasecmp (current_arg,
+                                         ACE_TEXT("slab")) == 0)
+              {
+                this->output_cdr_allocator_type_ = SLAB_ALLOCATOR;
+              }
             else if (ACE_OS::strcasecmp (current_arg,
                                          ACE_TEXT("default")) == 0)
               {
@@ -477,6 +493,41 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
               }
           }
       }
+    else if (0 == ACE_OS::strcasecmp (argv[curarg],
+                                      ACE_TEXT("-ORBTSSCachedAllocator")))
+      {
+        ++curarg;
+
+        if (curarg < argc)
+          {
+            this->use_tss_cached_allocator_ =
+              (0 != ACE_OS::atoi (argv[curarg]));
+
+            if (this->use_tss_cached_allocator_
+                && this->output_cdr_allocator_type_ == DEFAULT)
+              this->output_cdr_allocator_type_ = TSS_CACHED_ALLOCATOR;
+          }
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBTSSCachedAllocator"),
+                                           argv[curarg]);
+      }
+    else if (0 == ACE_OS::strcasecmp (argv[curarg],
+                                      ACE_TEXT("-ORBSlabAllocator")))
+      {
+        ++curarg;
+
+        if (curarg < argc)
+          {
+            this->use_slab_allocator_ = (0 != ACE_OS::atoi (argv[curarg]));
+
+            if (this->use_slab_allocator_
+                && this->output_cdr_allocator_type_ == DEFAULT)
+              this->output_cdr_allocator_type_ = SLAB_ALLOCATOR;
+          }
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBSlabAllocator"),
+                                           argv[curarg]);
+      }
     else if (0 == ACE_OS::strcasecmp (argv[curarg],
                                       ACE_TEXT("-ORBZeroCopyWrite")))
       {
@@ -820,6 +871,14 @@ TAO_Default_Resource_Factory::reclaim_reactor (ACE_Reactor *reactor)
 typedef ACE_Malloc<ACE_LOCAL_MEMORY_POOL,TAO_SYNCH_MUTEX> LOCKED_MALLOC;
 typedef ACE_Allocator_Adapter<LOCKED_MALLOC> LOCKED_ALLOCATOR_POOL;
 typedef ACE_New_Allocator LOCKED_ALLOCATOR_NO_POOL;
+typedef ACE_TSS_Cached_Allocator<TAO_SYNCH_MUTEX> LOCKED_ALLOCATOR_TSS;
+typedef ACE_Slab_Allocator<TAO_SYNCH_MUTEX> LOCKED_ALLOCATOR_SLAB;
+
+// Chunk sizes of the LOCKED_ALLOCATOR_TSS allocators, larger requests
+// go to the heap.
+static size_t const TAO_TSS_CDR_BUFFER_CHUNK =
+  ACE_CDR::DEFAULT_BUFSIZE + ACE_CDR::MAX_ALIGNMENT;
+static size_t const TAO_TSS_RESPONSE_HANDLER_CHUNK = 256;
 
 void
 TAO_Default_Resource_Factory::use_local_memory_pool (bool flag)
@@ -840,6 +899,18 @@ TAO_Default_Resource_Factory::input_cdr_dblock_allocator (void)
                     LOCKED_ALLOCATOR_POOL,
                     0);
   }
+  else if (use_tss_cached_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_TSS (0, sizeof (ACE_Data_Block)),
+                    0);
+  }
+  else if (use_slab_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_SLAB,
+                    0);
+  }
   else
   {
     ACE_NEW_RETURN (allocator,
@@ -860,6 +931,18 @@ TAO_Default_Resource_Factory::input_cdr_buffer_allocator (void)
                     LOCKED_ALLOCATOR_POOL,
                     0);
   }
+  else if (use_tss_cached_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_TSS (0, TAO_TSS_CDR_BUFFER_CHUNK),
+                    0);
+  }
+  else if (use_slab_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_SLAB,
+                    0);
+  }
   else
   {
     ACE_NEW_RETURN (allocator,
@@ -880,6 +963,18 @@ TAO_Default_Resource_Factory::input_cdr_msgblock_allocator (void)
                     LOCKED_ALLOCATOR_POOL,
                     0);
   }
+  else if (use_tss_cached_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_TSS (0, sizeof (ACE_Message_Block)),
+                    0);
+  }
+  else if (use_slab_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_SLAB,
+                    0);
+  }
   else
   {
     ACE_NEW_RETURN (allocator,
@@ -906,6 +1001,18 @@ TAO_Default_Resource_Factory::output_cdr_dblock_allocator (void)
                     LOCKED_ALLOCATOR_POOL,
                     0);
   }
+  else if (output_cdr_allocator_type_ == TSS_CACHED_ALLOCATOR)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_TSS (0, sizeof (ACE_Data_Block)),
+                    0);
+  }
+  else if (output_cdr_allocator_type_ == SLAB_ALLOCATOR)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_SLAB,
+                    0);
+  }
   else
   {
     ACE_NEW_RETURN (allocator,
@@ -939,6 +1046,20 @@ TAO_Default_Resource_Factory::output_cdr_buffer_allocator (void)
       break;
 #endif  /* TAO_HAS_SENDFILE==1 */
 
+    case TSS_CACHED_ALLOCATOR:
+      ACE_NEW_RETURN (allocator,
+                      LOCKED_ALLOCATOR_TSS (0, TAO_TSS_CDR_BUFFER_CHUNK),
+                      0);
+
+      break;
+
+    case SLAB_ALLOCATOR:
+      ACE_NEW_RETURN (allocator,
+                      LOCKED_ALLOCATOR_SLAB,
+                      0);
+
+      break;
+
     case DEFAULT:
     default:
       ACE_NEW_RETURN (allocator,
@@ -961,6 +1082,18 @@ TAO_Default_Resource_Factory::output_cdr_msgblock_allocator (void)
                     LOCKED_ALLOCATOR_POOL,
                     0);
   }
+  else if (output_cdr_allocator_type_ == TSS_CACHED_ALLOCATOR)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_TSS (0, sizeof (ACE_Message_Block)),
+                    0);
+  }
+  else if (output_cdr_allocator_type_ == SLAB_ALLOCATOR)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_SLAB,
+                    0);
+  }
   else
   {
     ACE_NEW_RETURN (allocator,
@@ -981,6 +1114,18 @@ TAO_Default_Resource_Factory::amh_response_handler_allocator (void)
                     LOCKED_ALLOCATOR_POOL,
                     0);
   }
+  else if (use_tss_cached_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_TSS (0, TAO_TSS_RESPONSE_HANDLER_CHUNK),
+                    0);
+  }
+  else if (use_slab_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_SLAB,
+                    0);
+  }
   else
   {
     ACE_NEW_RETURN (allocator,
@@ -1001,6 +1146,18 @@ TAO_Default_Resource_Factory::ami_response_handler_allocator (void)
                     LOCKED_ALLOCATOR_POOL,
                     0);
   }
+  else if (use_tss_cached_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_TSS (0, TAO_TSS_RESPONSE_HANDLER_CHUNK),
+                    0);
+  }
+  else if (use_slab_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    LOCKED_ALLOCATOR_SLAB,
+                    0);
+  }
   else
   {
     ACE_NEW_RETURN (allocator,
@@ -277,6 +277,8 @@ protected:
 #if TAO_HAS_SENDFILE == 1
       MMAP_ALLOCATOR,
 #endif  /* TAO_HAS_SENDFILE == 1*/
+      TSS_CACHED_ALLOCATOR,
+      SLAB_ALLOCATOR,
       DEFAULT
     };
 
@@ -287,6 +289,14 @@ protected:
   /// should use the local memory pool or not.
   bool use_local_memory_pool_;
 
+  /// This flag is used to determine whether the input CDR and response
+  /// handler allocators should cache their memory per thread.
+  bool use_tss_cached_allocator_;
+
+  /// This flag is used to determine whether the input CDR and response
+  /// handler allocators should use size classes.
+  bool use_slab_allocator_;
+
 private:
   enum Lock_Type
   {
@@ -175,6 +175,11 @@ public:
   TAO_Reply_Dispatcher *reply_dispatcher (void) const;
   void reply_dispatcher (TAO_Reply_Dispatcher *rd);
 
+  /// Expected size of the marshaled arguments, 0 if unknown.
+  /// Invocations reserve it in the output CDR before marshaling.
+  size_t marshal_size_hint (void) const;
+  void marshal_size_hint (size_t size);
+
 private:
 
   /// Name of the operation being invoked.
@@ -236,6 +241,9 @@ private:
   /// The optional reply dispatcher
   TAO_Reply_Dispatcher *reply_dispatcher_;
 
+  /// Expected size of the marshaled arguments
+  size_t marshal_size_hint_;
+
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -27,6 +27,7 @@ TAO_Operation_Details::TAO_Operation_Details (const char *name,
 #endif /*TAO_HAS_INTERCEPTORS == 1*/
     , cac_ (0)
     , reply_dispatcher_ (0)
+    , marshal_size_hint_ (0)
 {
 }
 
@@ -256,5 +257,17 @@ TAO_Operation_Details::reply_dispatcher (TAO_Reply_Dispatcher *rd)
   this->reply_dispatcher_ = rd;
 }
 
+ACE_INLINE size_t
+TAO_Operation_Details::marshal_size_hint (void) const
+{
+  return this->marshal_size_hint_;
+}
+
+ACE_INLINE void
+TAO_Operation_Details::marshal_size_hint (size_t size)
+{
+  this->marshal_size_hint_ = size;
+}
+
 
 TAO_END_VERSIONED_NAMESPACE_DECL
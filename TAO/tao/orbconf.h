@@ -141,6 +141,12 @@ const size_t TAO_DEFAULT_OBJECT_REF_TABLE_SIZE = 256;
 const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
 #endif  /* !TAO_DEFAULT_ORB_TABLE_SIZE */
 
+// The size of the chunks of the arenas the in arguments of requests
+// are demarshaled into when -ORBRequestArena is enabled.
+#if !defined (TAO_DEFAULT_REQUEST_ARENA_CHUNK_SIZE)
+const size_t TAO_DEFAULT_REQUEST_ARENA_CHUNK_SIZE = 16 * 1024;
+#endif  /* !TAO_DEFAULT_REQUEST_ARENA_CHUNK_SIZE */
+
 // The default size of TAO's server active object map.
 #if !defined (TAO_DEFAULT_SERVER_ACTIVE_OBJECT_MAP_SIZE)
 # define TAO_DEFAULT_SERVER_ACTIVE_OBJECT_MAP_SIZE 64
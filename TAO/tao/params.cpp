@@ -31,6 +31,8 @@ TAO_ORB_Parameters::TAO_ORB_Parameters (void)
   , iiop_client_port_span_ (0)
   , cdr_memcpy_tradeoff_ (ACE_DEFAULT_CDR_MEMCPY_TRADEOFF)
   , max_message_size_ (0) // Disable outgoing GIOP fragments by default
+  , zerocopy_threshold_ (0)
+  , request_arena_ (false)
   , use_dotted_decimal_addresses_ (0)
   , cache_incoming_by_dotted_decimal_address_ (0)
   , linger_ (-1)
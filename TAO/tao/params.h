@@ -127,6 +127,27 @@ public:
   void max_message_size (ACE_CDR::ULong size);
   //@}
 
+  /**
+   * Size from which outgoing GIOP messages are sent without copying
+   * them into the kernel, on transports that support it.  0, the
+   * default, disables zero-copy sends.
+   */
+  //@{
+  size_t zerocopy_threshold (void) const;
+  void zerocopy_threshold (size_t size);
+  //@}
+
+  /**
+   * Demarshal the in arguments of the requests dispatched to servants
+   * into an arena per request, released in one go after the upcall,
+   * instead of allocating each of their strings and sequence buffers
+   * from the heap.  Off by default.
+   */
+  //@{
+  bool request_arena (void) const;
+  void request_arena (bool enable);
+  //@}
+
   /// The ORB will use the dotted decimal notation for addresses. By
   /// default we use the full ascii names.
   int use_dotted_decimal_addresses (void) const;
@@ -351,6 +372,13 @@ private:
    */
   ACE_CDR::ULong max_message_size_;
 
+  /// Size from which outgoing GIOP messages are sent without copying
+  /// them, 0 if never.
+  size_t zerocopy_threshold_;
+
+  /// Demarshal the in arguments of requests into an arena.
+  bool request_arena_;
+
   /// For selecting a address notation
   int use_dotted_decimal_addresses_;
 
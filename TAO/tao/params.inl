@@ -49,6 +49,30 @@ TAO_ORB_Parameters::max_message_size (ACE_CDR::ULong size)
   this->max_message_size_ = size;
 }
 
+ACE_INLINE size_t
+TAO_ORB_Parameters::zerocopy_threshold (void) const
+{
+  return this->zerocopy_threshold_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::zerocopy_threshold (size_t size)
+{
+  this->zerocopy_threshold_ = size;
+}
+
+ACE_INLINE bool
+TAO_ORB_Parameters::request_arena (void) const
+{
+  return this->request_arena_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::request_arena (bool enable)
+{
+  this->request_arena_ = enable;
+}
+
 ACE_INLINE int
 TAO_ORB_Parameters::use_dotted_decimal_addresses (void) const
 {
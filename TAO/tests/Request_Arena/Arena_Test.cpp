@@ -0,0 +1,156 @@
+#include "Arena_Test.h"
+#include "ace/OS_NS_string.h"
+
+static CORBA::Long
+checksum (const char *text,
+          const Test::Record &rec,
+          const Test::LongSeq &values)
+{
+  CORBA::Long sum = rec.id;
+  sum += static_cast<CORBA::Long> (ACE_OS::strlen (text));
+  sum += static_cast<CORBA::Long> (ACE_OS::strlen (rec.name.in ()));
+
+  for (CORBA::ULong i = 0; i != rec.values.length (); ++i)
+    sum += rec.values[i];
+
+  for (CORBA::ULong i = 0; i != values.length (); ++i)
+    sum += values[i];
+
+  return sum;
+}
+
+Arena_Test::Thread_State::Thread_State (void)
+  : nesting_ (0),
+    last_text_ (0)
+{
+}
+
+Arena_Test::Arena_Test (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb)),
+    failures_ (0),
+    moves_ (0)
+{
+}
+
+void
+Arena_Test::self (Test::Arena_Test_ptr self)
+{
+  this->self_ = Test::Arena_Test::_duplicate (self);
+}
+
+CORBA::Long
+Arena_Test::process (const char * text,
+                     const Test::Record & rec,
+                     const Test::LongSeq & values,
+                     CORBA::ULong depth)
+{
+  Thread_State * const state = this->state_;
+  ++state->nesting_;
+
+  TAO::Request_Arena * const arena = TAO::Request_Arena::current ();
+  this->check_arena (arena, text, rec, values);
+
+  // The arena is reset and kept by the thread for its next request,
+  // so the requests that are not nested in another one of the thread
+  // get their arguments at the same address.
+  if (state->nesting_ == 1 && depth == 0)
+    {
+      if (state->last_text_ != 0 && state->last_text_ != text)
+        ++this->moves_;
+      state->last_text_ = text;
+    }
+
+  CORBA::Long const result = checksum (text, rec, values);
+
+  if (depth != 0)
+    {
+      // The nested request gets an arena of its own, once it is done
+      // the arguments of this one must be as they were.
+      CORBA::Long const nested =
+        this->self_->process (text, rec, values, depth - 1);
+
+      if (nested != result || checksum (text, rec, values) != result)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: nested request at depth %u "
+                      "returned %d, expected %d\n",
+                      depth, nested, result));
+          ++this->failures_;
+        }
+
+      if (TAO::Request_Arena::current () != arena)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: arena not restored after the "
+                      "nested request at depth %u\n",
+                      depth));
+          ++this->failures_;
+        }
+
+      this->check_arena (arena, text, rec, values);
+    }
+
+  --state->nesting_;
+  return result;
+}
+
+CORBA::ULong
+Arena_Test::failures (void)
+{
+  return this->failures_.value ();
+}
+
+CORBA::ULong
+Arena_Test::moves (void)
+{
+  return this->moves_.value ();
+}
+
+void
+Arena_Test::shutdown (void)
+{
+  this->self_ = Test::Arena_Test::_nil ();
+  this->orb_->shutdown (0);
+}
+
+void
+Arena_Test::check_arena (TAO::Request_Arena *arena,
+                         const char *text,
+                         const Test::Record &rec,
+                         const Test::LongSeq &values)
+{
+  if (arena == 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: request dispatched without an arena\n"));
+      ++this->failures_;
+      return;
+    }
+
+  if (!arena->owns (text) || !arena->owns (rec.name.in ()))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: string not demarshaled into the arena\n"));
+      ++this->failures_;
+    }
+
+  this->check_buffer (arena, rec.values, "struct member");
+  this->check_buffer (arena, values, "argument");
+}
+
+void
+Arena_Test::check_buffer (TAO::Request_Arena *arena,
+                          const Test::LongSeq &values,
+                          const char *what)
+{
+  // The buffer goes with the arena, the sequence must not free it.
+  if (values.length () != 0
+      && (!arena->owns (values.get_buffer ()) || values.release ()))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: sequence %C not demarshaled into "
+                  "the arena\n",
+                  what));
+      ++this->failures_;
+    }
+}
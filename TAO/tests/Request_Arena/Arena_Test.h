@@ -0,0 +1,73 @@
+#ifndef ARENA_TEST_H
+#define ARENA_TEST_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+#include "tao/Request_Arena.h"
+#include "ace/Atomic_Op.h"
+#include "ace/TSS_T.h"
+
+/// Implement the Test::Arena_Test interface
+class Arena_Test
+  : public virtual POA_Test::Arena_Test
+{
+public:
+  /// Constructor
+  Arena_Test (CORBA::ORB_ptr orb);
+
+  /// Set the reference the nested requests are sent to
+  void self (Test::Arena_Test_ptr self);
+
+  // = The skeleton methods
+  virtual CORBA::Long process (const char * text,
+                               const Test::Record & rec,
+                               const Test::LongSeq & values,
+                               CORBA::ULong depth);
+
+  virtual CORBA::ULong failures (void);
+
+  virtual CORBA::ULong moves (void);
+
+  virtual void shutdown (void);
+
+private:
+  /// Check that the strings and the sequence buffers of the in
+  /// arguments are memory of @a arena
+  void check_arena (TAO::Request_Arena *arena,
+                    const char *text,
+                    const Test::Record &rec,
+                    const Test::LongSeq &values);
+
+  void check_buffer (TAO::Request_Arena *arena,
+                     const Test::LongSeq &values,
+                     const char *what);
+
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+
+  /// Reference to this servant, called through the ORB for the nested
+  /// requests
+  Test::Arena_Test_var self_;
+
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, CORBA::ULong> failures_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, CORBA::ULong> moves_;
+
+  /// What is tracked for each thread, with the CSD thread pool the
+  /// requests are dispatched by several threads, each with its arena
+  struct Thread_State
+  {
+    Thread_State (void);
+
+    /// Number of process() requests the thread is dispatching
+    CORBA::ULong nesting_;
+
+    /// The text argument of the last request the thread dispatched
+    /// that was not nested
+    const char *last_text_;
+  };
+
+  ACE_TSS<Thread_State> state_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* ARENA_TEST_H */
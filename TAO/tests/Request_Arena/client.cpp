@@ -0,0 +1,159 @@
+#include "TestC.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+
+const ACE_TCHAR *ior = ACE_TEXT ("file://test.ior");
+int iterations = 100;
+CORBA::ULong depth = 3;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:i:d:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'd':
+        depth = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-i <iterations> "
+                           "-d <nesting depth> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Send @a iterations requests with @a nested more requests each,
+/// return the number of wrong results.
+int
+run_requests (Test::Arena_Test_ptr arena_test, CORBA::ULong nested)
+{
+  int errors = 0;
+  const char text[] = "Demarshaled into the arena of the request";
+
+  Test::Record rec;
+  rec.name = CORBA::string_dup ("A string member of the struct");
+  rec.values.length (16);
+
+  Test::LongSeq values (256);
+  values.length (256);
+
+  for (int i = 0; i != iterations; ++i)
+    {
+      rec.id = i;
+
+      CORBA::Long expected =
+        i + static_cast<CORBA::Long> (ACE_OS::strlen (text))
+          + static_cast<CORBA::Long> (ACE_OS::strlen (rec.name.in ()));
+
+      for (CORBA::ULong j = 0; j != rec.values.length (); ++j)
+        {
+          rec.values[j] = static_cast<CORBA::Long> (i * j);
+          expected += rec.values[j];
+        }
+
+      for (CORBA::ULong j = 0; j != values.length (); ++j)
+        {
+          values[j] = static_cast<CORBA::Long> (i + j);
+          expected += values[j];
+        }
+
+      CORBA::Long const result =
+        arena_test->process (text, rec, values, nested);
+
+      if (result != expected)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: request %d with %u nested "
+                      "returned %d, expected %d\n",
+                      i, nested, result, expected));
+          ++errors;
+        }
+    }
+
+  return errors;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var tmp = orb->string_to_object(ior);
+
+      Test::Arena_Test_var arena_test =
+        Test::Arena_Test::_narrow(tmp.in ());
+
+      if (CORBA::is_nil (arena_test.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_DEBUG,
+                             "Nil Test::Arena_Test reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      // First the nested requests, each of them gets an arena of its
+      // own, then the plain ones, which reuse the arena of the
+      // server thread.
+      status += run_requests (arena_test.in (), depth);
+      status += run_requests (arena_test.in (), 0);
+
+      CORBA::ULong const failures = arena_test->failures ();
+      if (failures != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %u arena checks failed "
+                      "in the server\n",
+                      failures));
+          ++status;
+        }
+
+      CORBA::ULong const moves = arena_test->moves ();
+      if (moves != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: arguments moved %u times in "
+                      "%d requests, the arena is not reused\n",
+                      moves, iterations));
+          ++status;
+        }
+
+      arena_test->shutdown ();
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return status;
+}
@@ -0,0 +1,429 @@
+/**
+ * @file
+ *
+ * @brief Unit test for the one copy marshaling of sequences of structs
+ * that are laid out like their CDR encoding.
+ */
+#include "tao/Sequence_T.h"
+#include "tao/CDR.h"
+
+#include "ace/OS_NS_string.h"
+
+#include "test_macros.h"
+
+struct Sample
+{
+  CORBA::Double x;
+  CORBA::Double y;
+  CORBA::Long id;
+  CORBA::Long pad;
+};
+
+CORBA::Boolean operator<< (TAO_OutputCDR &strm, const Sample &s)
+{
+  return (strm << s.x) && (strm << s.y) && (strm << s.id) && (strm << s.pad);
+}
+
+CORBA::Boolean operator>> (TAO_InputCDR &strm, Sample &s)
+{
+  return (strm >> s.x) && (strm >> s.y) && (strm >> s.id) && (strm >> s.pad);
+}
+
+/// Laid out like its CDR encoding too, but starts with a member of a
+/// smaller alignment than the struct, so tao_idl doesn't marshal its
+/// sequences with one copy.
+struct Mixed
+{
+  CORBA::Long a;
+  CORBA::Long b;
+  CORBA::Double c;
+};
+
+CORBA::Boolean operator<< (TAO_OutputCDR &strm, const Mixed &m)
+{
+  return (strm << m.a) && (strm << m.b) && (strm << m.c);
+}
+
+CORBA::Boolean operator>> (TAO_InputCDR &strm, Mixed &m)
+{
+  return (strm >> m.a) && (strm >> m.b) && (strm >> m.c);
+}
+
+/// Laid out like its CDR encoding, with char members the char
+/// translator of the stream has to see.
+struct Letters
+{
+  CORBA::Char first;
+  CORBA::Char second;
+  CORBA::Octet count;
+  CORBA::Octet flags;
+};
+
+CORBA::Boolean operator<< (TAO_OutputCDR &strm, const Letters &l)
+{
+  return (strm << ACE_OutputCDR::from_char (l.first))
+    && (strm << ACE_OutputCDR::from_char (l.second))
+    && (strm << ACE_OutputCDR::from_octet (l.count))
+    && (strm << ACE_OutputCDR::from_octet (l.flags));
+}
+
+CORBA::Boolean operator>> (TAO_InputCDR &strm, Letters &l)
+{
+  return (strm >> ACE_InputCDR::to_char (l.first))
+    && (strm >> ACE_InputCDR::to_char (l.second))
+    && (strm >> ACE_InputCDR::to_octet (l.count))
+    && (strm >> ACE_InputCDR::to_octet (l.flags));
+}
+
+/// Transmits each char as the next one.
+class Shift_Translator : public ACE_Char_Codeset_Translator
+{
+public:
+  virtual ACE_CDR::Boolean read_char (ACE_InputCDR &in, ACE_CDR::Char &x)
+  {
+    ACE_CDR::Octet o = 0;
+    if (!this->read_1 (in, &o))
+      return false;
+    x = static_cast<ACE_CDR::Char> (o - 1);
+    return true;
+  }
+
+  virtual ACE_CDR::Boolean read_string (ACE_InputCDR &, ACE_CDR::Char *&)
+  {
+    return false;
+  }
+
+  virtual ACE_CDR::Boolean read_char_array (ACE_InputCDR &in,
+                                            ACE_CDR::Char *x,
+                                            ACE_CDR::ULong length)
+  {
+    for (ACE_CDR::ULong i = 0; i != length; ++i)
+      if (!this->read_char (in, x[i]))
+        return false;
+    return true;
+  }
+
+  virtual ACE_CDR::Boolean write_char (ACE_OutputCDR &out, ACE_CDR::Char x)
+  {
+    ACE_CDR::Octet const o = static_cast<ACE_CDR::Octet> (x + 1);
+    return this->write_1 (out, &o);
+  }
+
+  virtual ACE_CDR::Boolean write_string (ACE_OutputCDR &,
+                                         ACE_CDR::ULong,
+                                         const ACE_CDR::Char *)
+  {
+    return false;
+  }
+
+  virtual ACE_CDR::Boolean write_char_array (ACE_OutputCDR &out,
+                                             const ACE_CDR::Char *x,
+                                             ACE_CDR::ULong length)
+  {
+    for (ACE_CDR::ULong i = 0; i != length; ++i)
+      if (!this->write_char (out, x[i]))
+        return false;
+    return true;
+  }
+
+  virtual ACE_CDR::ULong ncs () { return 0; }
+  virtual ACE_CDR::ULong tcs () { return 0; }
+};
+
+typedef TAO::unbounded_value_sequence<Sample> tested_sequence;
+typedef TAO::unbounded_value_sequence<Mixed> mixed_sequence;
+typedef TAO::unbounded_value_sequence<Letters> letters_sequence;
+typedef TAO::bounded_value_sequence<Sample, 8> tested_bounded_sequence;
+
+struct Tester
+{
+  void init (Sample *buffer, CORBA::ULong length)
+  {
+    for (CORBA::ULong i = 0; i != length; ++i)
+      {
+        buffer[i].x = 1.5 * i;
+        buffer[i].y = -0.25 * i;
+        buffer[i].id = static_cast<CORBA::Long> (i * 1000003);
+        buffer[i].pad = -static_cast<CORBA::Long> (i);
+      }
+  }
+
+  int check_values (const Sample *buffer, CORBA::ULong length)
+  {
+    for (CORBA::ULong i = 0; i != length; ++i)
+      {
+        CHECK_EQUAL (1.5 * i, buffer[i].x);
+        CHECK_EQUAL (-0.25 * i, buffer[i].y);
+        CHECK_EQUAL (static_cast<CORBA::Long> (i * 1000003), buffer[i].id);
+        CHECK_EQUAL (-static_cast<CORBA::Long> (i), buffer[i].pad);
+      }
+    return 0;
+  }
+
+  /// The one copy encoding has to be the elementwise one.  The
+  /// elements start at offset 8 in both tests, the padding before
+  /// them is not initialized.
+  int check_same_encoding (TAO_OutputCDR &a, TAO_OutputCDR &b)
+  {
+    a.consolidate ();
+    b.consolidate ();
+    CHECK_EQUAL (a.total_length (), b.total_length ());
+    CHECK (ACE_OS::memcmp (a.buffer () + 8,
+                           b.buffer () + 8,
+                           a.total_length () - 8) == 0);
+    return 0;
+  }
+
+  int test_unbounded ()
+  {
+    CORBA::ULong const length = 1000;
+    tested_sequence a (length);
+    a.length (length);
+    init (a.get_buffer (), length);
+
+    // Start on an odd offset, the elements have to be realigned.
+    TAO_OutputCDR pod;
+    TAO_OutputCDR elementwise;
+    CHECK (pod << ACE_OutputCDR::from_octet (7));
+    CHECK (elementwise << ACE_OutputCDR::from_octet (7));
+    CHECK (TAO::marshal_pod_sequence (pod, a, 24, 8));
+    CHECK (TAO::marshal_sequence (elementwise, a));
+    FAIL_RETURN_IF (check_same_encoding (pod, elementwise));
+
+    TAO_InputCDR in (pod);
+    CORBA::Octet o = 0;
+    CHECK (in >> ACE_InputCDR::to_octet (o));
+    CHECK_EQUAL (7, o);
+    tested_sequence b;
+    CHECK (TAO::demarshal_pod_sequence (in, b, 24, 8));
+    CHECK_EQUAL (length, b.length ());
+    FAIL_RETURN_IF (check_values (b.get_buffer (), length));
+    CHECK_EQUAL (0u, in.length ());
+    return 0;
+  }
+
+  /// Read the encoding of the other byte order, which has to go
+  /// through the elementwise path.
+  int test_swapped ()
+  {
+    CORBA::ULong const length = 100;
+    tested_sequence a (length);
+    a.length (length);
+    init (a.get_buffer (), length);
+
+    tested_sequence swapped (length);
+    swapped.length (length);
+    for (CORBA::ULong i = 0; i != length; ++i)
+      {
+        ACE_CDR::swap_8 (reinterpret_cast<const char *> (&a[i].x),
+                         reinterpret_cast<char *> (&swapped[i].x));
+        ACE_CDR::swap_8 (reinterpret_cast<const char *> (&a[i].y),
+                         reinterpret_cast<char *> (&swapped[i].y));
+        ACE_CDR::swap_4 (reinterpret_cast<const char *> (&a[i].id),
+                         reinterpret_cast<char *> (&swapped[i].id));
+        ACE_CDR::swap_4 (reinterpret_cast<const char *> (&a[i].pad),
+                         reinterpret_cast<char *> (&swapped[i].pad));
+      }
+    CORBA::ULong swapped_length = 0;
+    ACE_CDR::swap_4 (reinterpret_cast<const char *> (&length),
+                     reinterpret_cast<char *> (&swapped_length));
+
+    TAO_OutputCDR out;
+    CHECK (out << swapped_length);
+    CHECK_EQUAL (0, out.align_write_ptr (8));
+    CHECK (out.write_octet_array (
+             reinterpret_cast<const CORBA::Octet *> (swapped.get_buffer ()),
+             length * sizeof (Sample)));
+    out.consolidate ();
+
+    TAO_InputCDR in (out.buffer (), out.total_length (), !ACE_CDR_BYTE_ORDER);
+    tested_sequence b;
+    CHECK (TAO::demarshal_pod_sequence (in, b, 24, 8));
+    CHECK_EQUAL (length, b.length ());
+    FAIL_RETURN_IF (check_values (b.get_buffer (), length));
+    return 0;
+  }
+
+  /// CDR aligns a struct only for its first member.  When the length
+  /// ends at 4 mod 8 a struct that starts with a double is aligned to
+  /// 8 by both paths, one that starts with a long is not.
+  int test_lead_alignment ()
+  {
+    CORBA::ULong const length = 10;
+    tested_sequence a (length);
+    a.length (length);
+    init (a.get_buffer (), length);
+
+    TAO_OutputCDR pod;
+    TAO_OutputCDR elementwise;
+    CHECK (TAO::marshal_pod_sequence (pod, a, 24, 8));
+    CHECK (TAO::marshal_sequence (elementwise, a));
+    FAIL_RETURN_IF (check_same_encoding (pod, elementwise));
+
+    TAO_InputCDR in (elementwise);
+    tested_sequence b;
+    CHECK (TAO::demarshal_pod_sequence (in, b, 24, 8));
+    CHECK_EQUAL (length, b.length ());
+    FAIL_RETURN_IF (check_values (b.get_buffer (), length));
+
+    mixed_sequence m (length);
+    m.length (length);
+    for (CORBA::ULong i = 0; i != length; ++i)
+      {
+        m[i].a = static_cast<CORBA::Long> (i);
+        m[i].b = -static_cast<CORBA::Long> (i);
+        m[i].c = 0.5 * i;
+      }
+
+    // The first element starts right after the length and is padded
+    // before its double, the others follow without padding.  A block
+    // aligned on 8 would be another encoding.
+    TAO_OutputCDR mixed;
+    CHECK (TAO::marshal_sequence (mixed, m));
+    mixed.consolidate ();
+    CHECK_EQUAL (static_cast<size_t> (24 + 16 * (length - 1)),
+                 mixed.total_length ());
+    CHECK (ACE_OS::memcmp (mixed.buffer () + 4,
+                           &m[0].a,
+                           2 * sizeof (CORBA::Long)) == 0);
+    CHECK (ACE_OS::memcmp (mixed.buffer () + 16, &m[0].c, 8) == 0);
+    CHECK (ACE_OS::memcmp (mixed.buffer () + 24,
+                           &m[1],
+                           (length - 1) * sizeof (Mixed)) == 0);
+
+    TAO_InputCDR mixed_in (mixed);
+    mixed_sequence n;
+    CHECK (TAO::demarshal_sequence (mixed_in, n));
+    CHECK_EQUAL (length, n.length ());
+    for (CORBA::ULong i = 0; i != length; ++i)
+      {
+        CHECK_EQUAL (m[i].a, n[i].a);
+        CHECK_EQUAL (m[i].b, n[i].b);
+        CHECK_EQUAL (m[i].c, n[i].c);
+      }
+    return 0;
+  }
+
+  /// With a char translator installed the chars have to be
+  /// translated one by one, on both sides.
+  int test_char_translator ()
+  {
+    CORBA::ULong const length = 10;
+    letters_sequence a (length);
+    a.length (length);
+    for (CORBA::ULong i = 0; i != length; ++i)
+      {
+        a[i].first = static_cast<CORBA::Char> ('a' + i);
+        a[i].second = static_cast<CORBA::Char> ('A' + i);
+        a[i].count = static_cast<CORBA::Octet> (i);
+        a[i].flags = 0x80;
+      }
+
+    Shift_Translator translator;
+    TAO_OutputCDR out;
+    out.char_translator (&translator);
+    CHECK (TAO::marshal_pod_sequence (out, a, 4, 1));
+    out.consolidate ();
+    CHECK_EQUAL (static_cast<size_t> (4 + 4 * length), out.total_length ());
+    CHECK_EQUAL ('b', out.buffer ()[4]);
+    CHECK_EQUAL ('B', out.buffer ()[5]);
+    CHECK_EQUAL (0, out.buffer ()[6]);
+
+    TAO_InputCDR in (out);
+    in.char_translator (&translator);
+    letters_sequence b;
+    CHECK (TAO::demarshal_pod_sequence (in, b, 4, 1));
+    CHECK_EQUAL (length, b.length ());
+    for (CORBA::ULong i = 0; i != length; ++i)
+      {
+        CHECK_EQUAL (a[i].first, b[i].first);
+        CHECK_EQUAL (a[i].second, b[i].second);
+        CHECK_EQUAL (a[i].count, b[i].count);
+        CHECK_EQUAL (a[i].flags, b[i].flags);
+      }
+    return 0;
+  }
+
+  int test_empty ()
+  {
+    tested_sequence a;
+    TAO_OutputCDR out;
+    CHECK (TAO::marshal_pod_sequence (out, a, 24, 8));
+    CHECK_EQUAL (4u, out.total_length ());
+
+    TAO_InputCDR in (out);
+    tested_sequence b (4);
+    b.length (4);
+    CHECK (TAO::demarshal_pod_sequence (in, b, 24, 8));
+    CHECK_EQUAL (0u, b.length ());
+    return 0;
+  }
+
+  int test_truncated ()
+  {
+    tested_sequence a (16);
+    a.length (16);
+    init (a.get_buffer (), 16);
+    TAO_OutputCDR out;
+    CHECK (TAO::marshal_pod_sequence (out, a, 24, 8));
+    out.consolidate ();
+
+    // Drop the last element, the length now promises too much.
+    TAO_InputCDR in (out.buffer (), out.total_length () - sizeof (Sample));
+    tested_sequence b;
+    CHECK (!TAO::demarshal_pod_sequence (in, b, 24, 8));
+    return 0;
+  }
+
+  int test_bounded ()
+  {
+    tested_bounded_sequence a;
+    a.length (5);
+    init (a.get_buffer (), 5);
+
+    TAO_OutputCDR pod;
+    TAO_OutputCDR elementwise;
+    CHECK (TAO::marshal_pod_sequence (pod, a, 24, 8));
+    CHECK (TAO::marshal_sequence (elementwise, a));
+    FAIL_RETURN_IF (check_same_encoding (pod, elementwise));
+
+    TAO_InputCDR in (pod);
+    tested_bounded_sequence b;
+    CHECK (TAO::demarshal_pod_sequence (in, b, 24, 8));
+    CHECK_EQUAL (5u, b.length ());
+    FAIL_RETURN_IF (check_values (b.get_buffer (), 5));
+
+    // More elements than the bound.
+    tested_sequence c (9);
+    c.length (9);
+    init (c.get_buffer (), 9);
+    TAO_OutputCDR out;
+    CHECK (TAO::marshal_pod_sequence (out, c, 24, 8));
+    TAO_InputCDR too_long (out);
+    CHECK (!TAO::demarshal_pod_sequence (too_long, b, 24, 8));
+    return 0;
+  }
+};
+
+int ACE_TMAIN(int,ACE_TCHAR*[])
+{
+  int status = 0;
+
+  try
+    {
+      Tester x;
+      status += x.test_unbounded ();
+      status += x.test_swapped ();
+      status += x.test_lead_alignment ();
+      status += x.test_char_translator ();
+      status += x.test_empty ();
+      status += x.test_truncated ();
+      status += x.test_bounded ();
+    }
+  catch (const ::CORBA::Exception &ex)
+    {
+      ex._tao_print_exception("ERROR : unexpected CORBA exception caught :");
+      ++status;
+    }
+  return status;
+}